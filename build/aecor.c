@@ -0,0 +1,19450 @@
+#include "stdio.h"
+#include "stdlib.h"
+#include "stdbool.h"
+#include "stdint.h"
+#include "string.h"
+#include "errno.h"
+#include "ctype.h"
+#include "math.h"
+#include "libgen.h"
+
+/***************** embed './lib/prelude.h' *****************/
+#include "stdarg.h"
+
+typedef int8_t i8;
+typedef int16_t i16;
+typedef int32_t i32;
+typedef int64_t i64;
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+
+typedef float f32;
+typedef double f64;
+
+// SIMD vector types, such as `f32x4`, using GCC's vector extensions
+#define AECOR_SIMD_TYPE(T, lanes) \
+  typedef T aecor_##T##x##lanes __attribute__((vector_size(sizeof(T) * lanes)));
+#define AECOR_SIMD_TYPES(T) \
+  AECOR_SIMD_TYPE(T, 2) AECOR_SIMD_TYPE(T, 4) AECOR_SIMD_TYPE(T, 8) \
+  AECOR_SIMD_TYPE(T, 16) AECOR_SIMD_TYPE(T, 32) AECOR_SIMD_TYPE(T, 64)
+
+AECOR_SIMD_TYPES(i8) AECOR_SIMD_TYPES(i16) AECOR_SIMD_TYPES(i32) AECOR_SIMD_TYPES(i64)
+AECOR_SIMD_TYPES(u8) AECOR_SIMD_TYPES(u16) AECOR_SIMD_TYPES(u32) AECOR_SIMD_TYPES(u64)
+AECOR_SIMD_TYPES(f32) AECOR_SIMD_TYPES(f64)
+
+#ifdef AECOR_TRACK_ALLOC
+// Allocation tracking for `--track-alloc`. Calls to `malloc`, `calloc`,
+// `realloc`, `free` and `strdup` in aecor code go through the functions
+// below, each with a static `aecor_alloc_site` for the call site. Live
+// blocks are kept in a side table keyed by pointer, so `free` still works
+// on memory allocated by C code, which is just not counted.
+//
+// Like `--instrument`, this is not synchronized between threads.
+typedef struct aecor_alloc_site {
+  const char* location;
+  u64 allocs;
+  u64 bytes;
+  u64 live;
+  u64 live_bytes;
+  struct aecor_alloc_site* next;
+} aecor_alloc_site;
+
+typedef struct {
+  void* ptr;
+  size_t size;
+  aecor_alloc_site* site;
+} aecor_alloc_block;
+
+static aecor_alloc_site* aecor_alloc_sites = NULL;
+static aecor_alloc_block* aecor_alloc_blocks = NULL;
+static size_t aecor_alloc_capacity = 0;  // Always a power of two
+static size_t aecor_alloc_count = 0;
+static u64 aecor_alloc_live_bytes = 0;
+static u64 aecor_alloc_peak_bytes = 0;
+
+// Site of the format string being built, set by the generated code
+static aecor_alloc_site aecor_alloc_unknown_format = {"<format string>"};
+static aecor_alloc_site* aecor_alloc_format_site = &aecor_alloc_unknown_format;
+
+static inline size_t aecor_alloc_slot(void* ptr) {
+  return ((uintptr_t)ptr >> 4) * 0x9e3779b97f4a7c15ull & (aecor_alloc_capacity - 1);
+}
+
+static void aecor_alloc_insert(aecor_alloc_block block) {
+  if ((aecor_alloc_count + 1) * 2 > aecor_alloc_capacity) {
+    aecor_alloc_block* old = aecor_alloc_blocks;
+    size_t old_capacity = aecor_alloc_capacity;
+    aecor_alloc_capacity = old_capacity ? old_capacity * 2 : 1024;
+    aecor_alloc_blocks = calloc(aecor_alloc_capacity, sizeof(aecor_alloc_block));
+    aecor_alloc_count = 0;
+    for (size_t i = 0; i < old_capacity; i++) {
+      if (old[i].ptr) aecor_alloc_insert(old[i]);
+    }
+    free(old);
+  }
+  size_t i = aecor_alloc_slot(block.ptr);
+  while (aecor_alloc_blocks[i].ptr) i = (i + 1) & (aecor_alloc_capacity - 1);
+  aecor_alloc_blocks[i] = block;
+  aecor_alloc_count++;
+}
+
+// Removes the block for `ptr` using backward-shift deletion, returning
+// false if it wasn't allocated by tracked code.
+static bool aecor_alloc_remove(void* ptr, aecor_alloc_block* out) {
+  if (!aecor_alloc_capacity) return false;
+  size_t mask = aecor_alloc_capacity - 1;
+  size_t i = aecor_alloc_slot(ptr);
+  while (aecor_alloc_blocks[i].ptr != ptr) {
+    if (!aecor_alloc_blocks[i].ptr) return false;
+    i = (i + 1) & mask;
+  }
+  *out = aecor_alloc_blocks[i];
+  for (size_t j = (i + 1) & mask; aecor_alloc_blocks[j].ptr; j = (j + 1) & mask) {
+    size_t home = aecor_alloc_slot(aecor_alloc_blocks[j].ptr);
+    // Move the entry into the hole unless its home slot is after the hole
+    if (((j - home) & mask) >= ((j - i) & mask)) {
+      aecor_alloc_blocks[i] = aecor_alloc_blocks[j];
+      i = j;
+    }
+  }
+  aecor_alloc_blocks[i].ptr = NULL;
+  aecor_alloc_count--;
+  return true;
+}
+
+static void aecor_alloc_record(void* ptr, size_t size, aecor_alloc_site* site) {
+  if (!ptr) return;
+  if (!site->allocs) {
+    site->next = aecor_alloc_sites;
+    aecor_alloc_sites = site;
+  }
+  site->allocs++;
+  site->bytes += size;
+  site->live++;
+  site->live_bytes += size;
+  aecor_alloc_live_bytes += size;
+  if (aecor_alloc_live_bytes > aecor_alloc_peak_bytes) {
+    aecor_alloc_peak_bytes = aecor_alloc_live_bytes;
+  }
+  aecor_alloc_insert((aecor_alloc_block){ptr, size, site});
+}
+
+static void aecor_alloc_forget(void* ptr) {
+  aecor_alloc_block block;
+  if (!ptr || !aecor_alloc_remove(ptr, &block)) return;
+  block.site->live--;
+  block.site->live_bytes -= block.size;
+  aecor_alloc_live_bytes -= block.size;
+}
+
+void* aecor_track_malloc(size_t size, aecor_alloc_site* site) {
+  void* ptr = malloc(size);
+  aecor_alloc_record(ptr, size, site);
+  return ptr;
+}
+
+void* aecor_track_calloc(size_t count, size_t size, aecor_alloc_site* site) {
+  void* ptr = calloc(count, size);
+  aecor_alloc_record(ptr, count * size, site);
+  return ptr;
+}
+
+void* aecor_track_realloc(void* old, size_t size, aecor_alloc_site* site) {
+  void* ptr = realloc(old, size);
+  if (!ptr && size) return ptr;
+  aecor_alloc_forget(old);
+  aecor_alloc_record(ptr, size, site);
+  return ptr;
+}
+
+char* aecor_track_strdup(const char* s, aecor_alloc_site* site) {
+  char* copy = strdup(s);
+  aecor_alloc_record(copy, strlen(s) + 1, site);
+  return copy;
+}
+
+void aecor_track_free(void* ptr) {
+  aecor_alloc_forget(ptr);
+  free(ptr);
+}
+
+static void* aecor_track_format_alloc(size_t size) {
+  aecor_alloc_site* site = aecor_alloc_format_site;
+  aecor_alloc_format_site = &aecor_alloc_unknown_format;
+  return aecor_track_malloc(size, site);
+}
+
+// Ties are broken by location, so reports from different runs can be diffed
+static int aecor_alloc_compare_bytes(const void* a, const void* b) {
+  aecor_alloc_site* sa = *(aecor_alloc_site**)a;
+  aecor_alloc_site* sb = *(aecor_alloc_site**)b;
+  if (sa->bytes != sb->bytes) return sa->bytes < sb->bytes ? 1 : -1;
+  return strcmp(sa->location, sb->location);
+}
+
+static int aecor_alloc_compare_live(const void* a, const void* b) {
+  aecor_alloc_site* sa = *(aecor_alloc_site**)a;
+  aecor_alloc_site* sb = *(aecor_alloc_site**)b;
+  if (sa->live_bytes != sb->live_bytes) return sa->live_bytes < sb->live_bytes ? 1 : -1;
+  return strcmp(sa->location, sb->location);
+}
+
+// Writes the sites that allocated the most bytes, followed by the ones
+// with memory that was never freed.
+static void aecor_alloc_report(void) {
+  const char* path = getenv("AECOR_ALLOC_REPORT");
+  if (!path) path = "aecor_alloc.txt";
+  FILE* file = fopen(path, "w");
+  if (!file) {
+    fprintf(stderr, "Could not write allocation report to %s\n", path);
+    return;
+  }
+
+  size_t count = 0;
+  u64 allocs = 0, bytes = 0, live = 0;
+  for (aecor_alloc_site* site = aecor_alloc_sites; site; site = site->next) {
+    count++;
+    allocs += site->allocs;
+    bytes += site->bytes;
+    live += site->live;
+  }
+  aecor_alloc_site** sites = malloc((count + 1) * sizeof(aecor_alloc_site*));
+  size_t n = 0;
+  for (aecor_alloc_site* site = aecor_alloc_sites; site; site = site->next) sites[n++] = site;
+
+  fprintf(file, "# %llu allocations, %llu bytes, peak %llu bytes live\n",
+          (unsigned long long)allocs, (unsigned long long)bytes,
+          (unsigned long long)aecor_alloc_peak_bytes);
+  fprintf(file, "# %llu blocks, %llu bytes never freed\n",
+          (unsigned long long)live, (unsigned long long)aecor_alloc_live_bytes);
+
+  const char* header = "# %12s %14s %12s %14s  %s\n";
+  const char* row = "%14llu %14llu %12llu %14llu  %s\n";
+  fprintf(file, "\n# Top allocators\n");
+  fprintf(file, header, "allocs", "bytes", "live", "live_bytes", "site");
+  qsort(sites, n, sizeof(aecor_alloc_site*), aecor_alloc_compare_bytes);
+  for (size_t i = 0; i < n; i++) {
+    aecor_alloc_site* site = sites[i];
+    fprintf(file, row, (unsigned long long)site->allocs, (unsigned long long)site->bytes,
+            (unsigned long long)site->live, (unsigned long long)site->live_bytes, site->location);
+  }
+
+  fprintf(file, "\n# Leaks\n");
+  fprintf(file, header, "allocs", "bytes", "live", "live_bytes", "site");
+  qsort(sites, n, sizeof(aecor_alloc_site*), aecor_alloc_compare_live);
+  for (size_t i = 0; i < n && sites[i]->live; i++) {
+    aecor_alloc_site* site = sites[i];
+    fprintf(file, row, (unsigned long long)site->allocs, (unsigned long long)site->bytes,
+            (unsigned long long)site->live, (unsigned long long)site->live_bytes, site->location);
+  }
+  free(sites);
+  fclose(file);
+}
+
+__attribute__((constructor)) static void aecor_alloc_init(void) {
+  atexit(aecor_alloc_report);
+}
+
+#define AECOR_FORMAT_ALLOC aecor_track_format_alloc
+#else
+#define AECOR_FORMAT_ALLOC malloc
+#endif
+
+// Formats into `stack` if the result fits in `capacity` bytes, otherwise
+// returns a new heap-allocated string that the caller needs to free.
+char* format_string_into(char* stack, int capacity, const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  int size = vsnprintf(stack, capacity, format, args);
+  va_end(args);
+  if (size < capacity) return stack;
+  char* s = malloc(size + 1);
+  va_start(args, format);
+  vsnprintf(s, size + 1, format, args);
+  va_end(args);
+  return s;
+}
+
+// Formats into a stack buffer first since most formatted strings are short,
+// which saves a separate pass just to compute the size.
+static char* aecor_vformat(void* (*alloc)(size_t), const char* format, va_list args) {
+  char stack[256];
+  va_list copy;
+  va_copy(copy, args);
+  int size = vsnprintf(stack, sizeof(stack), format, copy);
+  va_end(copy);
+  char* s = alloc(size + 1);
+  if (size < (int)sizeof(stack)) {
+    memcpy(s, stack, size + 1);
+  } else {
+    vsnprintf(s, size + 1, format, args);
+  }
+  return s;
+}
+
+char* format_string(const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  char* s = aecor_vformat(AECOR_FORMAT_ALLOC, format, args);
+  va_end(args);
+  return s;
+}
+
+// Scratch arena backing `scratch { ... }` blocks. Memory is handed out from a
+// list of chunks with a bump pointer, and everything allocated inside a block
+// is released at once when it ends by restoring the position saved on entry.
+// Chunks past the current one are kept around to be reused. Each thread has
+// its own arena.
+//
+// Format strings built inside a block come from the arena as well, so they
+// must not be passed to `free` or to anything that frees them, such as
+// `Buffer::putsf`, and must be copied to outlive the block.
+#define AECOR_SCRATCH_CHUNK_SIZE (64 * 1024)
+
+typedef struct aecor_scratch_chunk {
+  struct aecor_scratch_chunk* next;
+  size_t capacity;
+  size_t used;
+  char data[];
+} aecor_scratch_chunk;
+
+typedef struct {
+  aecor_scratch_chunk* chunk;
+  size_t used;
+} aecor_scratch_mark;
+
+static __thread aecor_scratch_chunk* aecor_scratch_first = NULL;
+static __thread aecor_scratch_chunk* aecor_scratch_current = NULL;
+
+void* scratch_alloc(size_t size) {
+  size = (size + 15) & ~(size_t)15;
+  aecor_scratch_chunk* chunk = aecor_scratch_current;
+  if (!chunk || chunk->used + size > chunk->capacity) {
+    aecor_scratch_chunk** link = chunk ? &chunk->next : &aecor_scratch_first;
+    if (!*link || (*link)->capacity < size) {
+      size_t capacity = size > AECOR_SCRATCH_CHUNK_SIZE ? size : AECOR_SCRATCH_CHUNK_SIZE;
+      aecor_scratch_chunk* fresh = malloc(sizeof(aecor_scratch_chunk) + capacity);
+      if (!fresh) {
+        printf("Out of memory!\n");
+        exit(1);
+      }
+      fresh->capacity = capacity;
+      fresh->next = *link;
+      *link = fresh;
+    }
+    chunk = *link;
+    chunk->used = 0;
+    aecor_scratch_current = chunk;
+  }
+  void* ptr = chunk->data + chunk->used;
+  chunk->used += size;
+  return ptr;
+}
+
+aecor_scratch_mark aecor_scratch_save() {
+  aecor_scratch_chunk* chunk = aecor_scratch_current;
+  return (aecor_scratch_mark){chunk, chunk ? chunk->used : 0};
+}
+
+void aecor_scratch_restore(aecor_scratch_mark* mark) {
+  aecor_scratch_current = mark->chunk;
+  if (mark->chunk) mark->chunk->used = mark->used;
+}
+
+char* format_string_scratch(const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  char* s = aecor_vformat(scratch_alloc, format, args);
+  va_end(args);
+  return s;
+}
+
+// Output buffer for `print` / `println` when compiling with `-b`. Writes are
+// collected here and handed to stdio in large chunks, which avoids paying
+// for `printf`'s locking and format parsing on every call.
+//
+// Once a second thread has been started (see `Thread::spawn`), the buffer is
+// guarded by a spinlock. It is only held for a `memcpy` or a flush, once per
+// `print`, and single-threaded programs don't pay for it at all.
+#define AECOR_STDOUT_BUFFER_SIZE (64 * 1024)
+
+static char aecor_stdout_buffer[AECOR_STDOUT_BUFFER_SIZE];
+static size_t aecor_stdout_size = 0;
+static char aecor_stdout_locked = 0;
+
+// Set before the first thread is created, so that thread sees it too
+bool aecor_multithreaded = false;
+
+static inline void aecor_stdout_lock(void) {
+  if (!aecor_multithreaded) return;
+  while (__atomic_test_and_set(&aecor_stdout_locked, __ATOMIC_ACQUIRE)) {
+    while (__atomic_load_n(&aecor_stdout_locked, __ATOMIC_RELAXED)) {}
+  }
+}
+
+static inline void aecor_stdout_unlock(void) {
+  if (!aecor_multithreaded) return;
+  __atomic_clear(&aecor_stdout_locked, __ATOMIC_RELEASE);
+}
+
+// Must be called with the lock held
+static void aecor_stdout_flush_locked(void) {
+  fwrite(aecor_stdout_buffer, 1, aecor_stdout_size, stdout);
+  fflush(stdout);
+  aecor_stdout_size = 0;
+}
+
+void aecor_stdout_flush(void) {
+  aecor_stdout_lock();
+  aecor_stdout_flush_locked();
+  aecor_stdout_unlock();
+}
+
+__attribute__((constructor)) static void aecor_stdout_init(void) {
+  atexit(aecor_stdout_flush);
+}
+
+static inline void aecor_stdout_write(const char* s, size_t len) {
+  aecor_stdout_lock();
+  if (aecor_stdout_size + len > AECOR_STDOUT_BUFFER_SIZE) {
+    aecor_stdout_flush_locked();
+    if (len > AECOR_STDOUT_BUFFER_SIZE) {
+      fwrite(s, 1, len, stdout);
+      aecor_stdout_unlock();
+      return;
+    }
+  }
+  memcpy(aecor_stdout_buffer + aecor_stdout_size, s, len);
+  aecor_stdout_size += len;
+  aecor_stdout_unlock();
+}
+
+// The pieces of one `print` with a format string are collected in a line on
+// the stack and added to the buffer at once, so lines printed by different
+// threads never interleave. Arguments are evaluated outside the lock, so
+// they can print too.
+typedef struct {
+  char* data;
+  size_t size;
+  size_t capacity;
+  char stack[256];
+} aecor_stdout_line;
+
+static inline void aecor_stdout_line_init(aecor_stdout_line* line) {
+  line->data = line->stack;
+  line->size = 0;
+  line->capacity = sizeof(line->stack);
+}
+
+static void aecor_stdout_line_grow(aecor_stdout_line* line, size_t min_capacity) {
+  size_t capacity = line->capacity * 2;
+  if (capacity < min_capacity) capacity = min_capacity;
+  if (line->data == line->stack) {
+    line->data = malloc(capacity);
+    memcpy(line->data, line->stack, line->size);
+  } else {
+    line->data = realloc(line->data, capacity);
+  }
+  line->capacity = capacity;
+}
+
+static inline void aecor_stdout_write_line(aecor_stdout_line* line, const char* s, size_t len) {
+  if (line->size + len > line->capacity) aecor_stdout_line_grow(line, line->size + len);
+  memcpy(line->data + line->size, s, len);
+  line->size += len;
+}
+
+void aecor_stdout_line_finish(aecor_stdout_line* line) {
+  aecor_stdout_write(line->data, line->size);
+  if (line->data != line->stack) free(line->data);
+}
+
+void aecor_stdout_puts(aecor_stdout_line* line, const char* s) {
+  aecor_stdout_write_line(line, s, strlen(s));
+}
+
+// Prints "(null)" for a null string, like `printf` does
+void aecor_stdout_put_str(aecor_stdout_line* line, const char* s) {
+  aecor_stdout_puts(line, s ? s : "(null)");
+}
+
+static inline void aecor_stdout_putc(aecor_stdout_line* line, char c) {
+  if (line->size == line->capacity) aecor_stdout_line_grow(line, line->size + 1);
+  line->data[line->size++] = c;
+}
+
+void aecor_stdout_put_u64(aecor_stdout_line* line, u64 value) {
+  char digits[20];
+  int len = 0;
+  do {
+    digits[sizeof(digits) - ++len] = '0' + value % 10;
+    value /= 10;
+  } while (value);
+  aecor_stdout_write_line(line, digits + sizeof(digits) - len, len);
+}
+
+void aecor_stdout_put_i64(aecor_stdout_line* line, i64 value) {
+  if (value < 0) {
+    aecor_stdout_putc(line, '-');
+    aecor_stdout_put_u64(line, -(u64)value);
+  } else {
+    aecor_stdout_put_u64(line, value);
+  }
+}
+
+void aecor_stdout_put_f64(aecor_stdout_line* line, f64 value) {
+  char stack[64];
+  char* s = format_string_into(stack, sizeof(stack), "%f", value);
+  aecor_stdout_puts(line, s);
+  if (s != stack) free(s);
+}
+
+void aecor_stdout_put_ptr(aecor_stdout_line* line, void* value) {
+  char stack[32];
+  aecor_stdout_puts(line, format_string_into(stack, sizeof(stack), "%p", value));
+}
+
+// Used for anything that isn't a format string literal, which is printed
+// with a single write.
+int aecor_stdout_printf(const char* format, ...) {
+  char stack[256];
+  va_list args;
+  va_start(args, format);
+  int size = vsnprintf(stack, sizeof(stack), format, args);
+  va_end(args);
+  if (size < (int)sizeof(stack)) {
+    aecor_stdout_write(stack, size);
+  } else {
+    char* s = malloc(size + 1);
+    va_start(args, format);
+    vsnprintf(s, size + 1, format, args);
+    va_end(args);
+    aecor_stdout_write(s, size);
+    free(s);
+  }
+  return size;
+}
+
+// FNV-1a with a murmur3 finalizer, used for hashed dispatch on strings.
+// Must be kept in sync with `hash_string` in `compiler/utils.ae`.
+u32 aecor_hash_str(const char* s, u32 seed) {
+  u32 hash = seed;
+  for (; *s; s++) {
+    hash = (hash ^ (u8)*s) * 16777619u;
+  }
+  hash = (hash ^ (hash >> 16)) * 0x85ebca6bu;
+  hash = (hash ^ (hash >> 13)) * 0xc2b2ae35u;
+  return hash ^ (hash >> 16);
+}
+
+#ifdef AECOR_INSTRUMENT
+#include <time.h>
+
+// Per-function profiling for `--instrument`. Every instrumented function
+// pushes a frame on entry, which is popped by a `cleanup` handler whenever
+// the function returns. Time spent in instrumented callees is subtracted
+// from the caller's exclusive time. Recursive calls only count towards
+// inclusive time once, for the outermost call.
+//
+// Counters are not synchronized, so this is only accurate for programs
+// that call instrumented functions from a single thread.
+typedef struct {
+  const char* name;
+  const char* location;
+  u64 calls;
+  u64 inclusive_ns;
+  u64 exclusive_ns;
+  u32 active;
+} aecor_prof_entry;
+
+typedef struct aecor_prof_frame {
+  aecor_prof_entry* entry;
+  struct aecor_prof_frame* parent;
+  u64 start;
+  u64 children;
+} aecor_prof_frame;
+
+// Defined at the end of the generated code, one entry per function
+extern aecor_prof_entry aecor_prof_table[];
+extern u32 aecor_prof_count;
+
+static __thread aecor_prof_frame* aecor_prof_current = NULL;
+
+static inline u64 aecor_prof_now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (u64)ts.tv_sec * 1000000000ull + (u64)ts.tv_nsec;
+}
+
+static inline void aecor_prof_enter(aecor_prof_frame* frame, u32 id) {
+  frame->entry = &aecor_prof_table[id];
+  frame->entry->calls++;
+  frame->entry->active++;
+  frame->parent = aecor_prof_current;
+  frame->children = 0;
+  aecor_prof_current = frame;
+  frame->start = aecor_prof_now();
+}
+
+static inline void aecor_prof_exit(aecor_prof_frame* frame) {
+  u64 elapsed = aecor_prof_now() - frame->start;
+  aecor_prof_entry* entry = frame->entry;
+  entry->active--;
+  if (entry->active == 0) entry->inclusive_ns += elapsed;
+  entry->exclusive_ns += elapsed - frame->children;
+  if (frame->parent) frame->parent->children += elapsed;
+  aecor_prof_current = frame->parent;
+}
+
+// Writes one line per function that was called, in declaration order so
+// that reports from different runs can be diffed directly. The output is
+// whitespace separated for `sort -k`, e.g. `sort -k3 -n -r` for the
+// functions with the most exclusive time.
+static void aecor_prof_report(void) {
+  // Functions still running when `exit()` was called end here
+  while (aecor_prof_current) aecor_prof_exit(aecor_prof_current);
+
+  const char* path = getenv("AECOR_PROFILE");
+  if (!path) path = "aecor_profile.txt";
+  FILE* file = fopen(path, "w");
+  if (!file) {
+    fprintf(stderr, "Could not write profile to %s\n", path);
+    return;
+  }
+  fprintf(file, "# %12s %16s %16s  %s  %s\n",
+          "calls", "inclusive_ns", "exclusive_ns", "function", "location");
+  for (u32 i = 0; i < aecor_prof_count; i++) {
+    aecor_prof_entry* entry = &aecor_prof_table[i];
+    if (entry->calls == 0) continue;
+    fprintf(file, "%14llu %16llu %16llu  %s  %s\n",
+            (unsigned long long)entry->calls,
+            (unsigned long long)entry->inclusive_ns,
+            (unsigned long long)entry->exclusive_ns,
+            entry->name, entry->location);
+  }
+  fclose(file);
+}
+
+__attribute__((constructor)) static void aecor_prof_init(void) {
+  atexit(aecor_prof_report);
+}
+#endif
+
+
+/* constants */
+const i32 VECTOR_INLINE_CAPACITY = 4;
+const i32 VECTOR_MAX_INLINE_CAPACITY = 8;
+const i32 AST_CHUNK_SIZE = 4096;
+const i32 REF_PARAM_THRESHOLD = 16;
+const i32 MATCH_HASH_THRESHOLD = 4;
+
+/* struct declarations */
+typedef struct Vector Vector;
+typedef struct Location Location;
+typedef struct Span Span;
+typedef enum TokenType TokenType;
+typedef struct Token Token;
+typedef enum ErrorType ErrorType;
+typedef struct Error Error;
+typedef enum MessageType MessageType;
+typedef struct Lexer Lexer;
+typedef struct Buffer Buffer;
+typedef struct MapNode MapNode;
+typedef struct Map Map;
+typedef struct MapIterator MapIterator;
+typedef enum BaseType BaseType;
+typedef struct Type Type;
+typedef enum ASTType ASTType;
+typedef struct Variable Variable;
+typedef struct Function Function;
+typedef struct Structure Structure;
+typedef struct Program Program;
+typedef struct Block Block;
+typedef struct Binary Binary;
+typedef struct Identifier Identifier;
+typedef struct FormatString FormatString;
+typedef struct Argument Argument;
+typedef struct FuncCall FuncCall;
+typedef struct Constructor Constructor;
+typedef struct Member Member;
+typedef struct EnumValue EnumValue;
+typedef struct VarDeclaration VarDeclaration;
+typedef struct IfStatement IfStatement;
+typedef struct Loop Loop;
+typedef enum IterKind IterKind;
+typedef struct ForIn ForIn;
+typedef struct Cast Cast;
+typedef struct MatchCase MatchCase;
+typedef struct Match Match;
+typedef struct NumLiteral NumLiteral;
+typedef union ASTUnion ASTUnion;
+typedef struct AST AST;
+typedef struct ParserContext ParserContext;
+typedef struct Template Template;
+typedef struct Instance Instance;
+typedef struct Parser Parser;
+typedef struct Bitset Bitset;
+typedef struct TypeChecker TypeChecker;
+typedef struct BodyEffects BodyEffects;
+typedef struct CodeGenerator CodeGenerator;
+
+struct Vector {
+  i32 size;
+  i32 capacity;
+  void **data;
+  bool is_inline;
+};
+
+struct Location {
+  char *filename;
+  i32 line;
+  i32 col;
+};
+
+struct Span {
+  Location start;
+  Location end;
+};
+
+enum TokenType {
+  TokenType__And,
+  TokenType__As,
+  TokenType__Bool,
+  TokenType__Break,
+  TokenType__Char,
+  TokenType__Const,
+  TokenType__Continue,
+  TokenType__Def,
+  TokenType__Defer,
+  TokenType__Else,
+  TokenType__Enum,
+  TokenType__Extern,
+  TokenType__False,
+  TokenType__F32,
+  TokenType__F64,
+  TokenType__For,
+  TokenType__Fn,
+  TokenType__I8,
+  TokenType__I16,
+  TokenType__I32,
+  TokenType__I64,
+  TokenType__If,
+  TokenType__Let,
+  TokenType__Match,
+  TokenType__Null,
+  TokenType__Not,
+  TokenType__Or,
+  TokenType__Return,
+  TokenType__Scratch,
+  TokenType__SizeOf,
+  TokenType__String,
+  TokenType__Struct,
+  TokenType__True,
+  TokenType__Then,
+  TokenType__U8,
+  TokenType__U16,
+  TokenType__U32,
+  TokenType__U64,
+  TokenType__UntypedPtr,
+  TokenType__Union,
+  TokenType__Use,
+  TokenType__Void,
+  TokenType__Yield,
+  TokenType__While,
+  TokenType__AtSign,
+  TokenType__Ampersand,
+  TokenType__Backtick,
+  TokenType__Caret,
+  TokenType__CharLiteral,
+  TokenType__CloseCurly,
+  TokenType__CloseParen,
+  TokenType__CloseSquare,
+  TokenType__Colon,
+  TokenType__ColonColon,
+  TokenType__Comma,
+  TokenType__Dot,
+  TokenType__DotDot,
+  TokenType__EOF,
+  TokenType__Equals,
+  TokenType__EqualEquals,
+  TokenType__Exclamation,
+  TokenType__FatArrow,
+  TokenType__FloatLiteral,
+  TokenType__FormatStringLiteral,
+  TokenType__GreaterThan,
+  TokenType__GreaterThanGreaterThan,
+  TokenType__GreaterThanEquals,
+  TokenType__Identifier,
+  TokenType__IntLiteral,
+  TokenType__LessThan,
+  TokenType__LessThanLessThan,
+  TokenType__LessThanEquals,
+  TokenType__Line,
+  TokenType__Minus,
+  TokenType__MinusEquals,
+  TokenType__NotEquals,
+  TokenType__Newline,
+  TokenType__OpenCurly,
+  TokenType__OpenParen,
+  TokenType__OpenSquare,
+  TokenType__Percent,
+  TokenType__Plus,
+  TokenType__PlusEquals,
+  TokenType__Question,
+  TokenType__Semicolon,
+  TokenType__Slash,
+  TokenType__SlashEquals,
+  TokenType__Star,
+  TokenType__StarEquals,
+  TokenType__StringLiteral,
+  TokenType__Tilde,
+};
+
+static char *__TokenType_names[] = {"And", "As", "Bool", "Break", "Char", "Const", "Continue", "Def", "Defer", "Else", "Enum", "Extern", "False", "F32", "F64", "For", "Fn", "I8", "I16", "I32", "I64", "If", "Let", "Match", "Null", "Not", "Or", "Return", "Scratch", "SizeOf", "String", "Struct", "True", "Then", "U8", "U16", "U32", "U64", "UntypedPtr", "Union", "Use", "Void", "Yield", "While", "AtSign", "Ampersand", "Backtick", "Caret", "CharLiteral", "CloseCurly", "CloseParen", "CloseSquare", "Colon", "ColonColon", "Comma", "Dot", "DotDot", "EOF", "Equals", "EqualEquals", "Exclamation", "FatArrow", "FloatLiteral", "FormatStringLiteral", "GreaterThan", "GreaterThanGreaterThan", "GreaterThanEquals", "Identifier", "IntLiteral", "LessThan", "LessThanLessThan", "LessThanEquals", "Line", "Minus", "MinusEquals", "NotEquals", "Newline", "OpenCurly", "OpenParen", "OpenSquare", "Percent", "Plus", "PlusEquals", "Question", "Semicolon", "Slash", "SlashEquals", "Star", "StarEquals", "StringLiteral", "Tilde"};
+static TokenType __TokenType_values[] = {TokenType__And, TokenType__As, TokenType__Bool, TokenType__Break, TokenType__Char, TokenType__Const, TokenType__Continue, TokenType__Def, TokenType__Defer, TokenType__Else, TokenType__Enum, TokenType__Extern, TokenType__False, TokenType__F32, TokenType__F64, TokenType__For, TokenType__Fn, TokenType__I8, TokenType__I16, TokenType__I32, TokenType__I64, TokenType__If, TokenType__Let, TokenType__Match, TokenType__Null, TokenType__Not, TokenType__Or, TokenType__Return, TokenType__Scratch, TokenType__SizeOf, TokenType__String, TokenType__Struct, TokenType__True, TokenType__Then, TokenType__U8, TokenType__U16, TokenType__U32, TokenType__U64, TokenType__UntypedPtr, TokenType__Union, TokenType__Use, TokenType__Void, TokenType__Yield, TokenType__While, TokenType__AtSign, TokenType__Ampersand, TokenType__Backtick, TokenType__Caret, TokenType__CharLiteral, TokenType__CloseCurly, TokenType__CloseParen, TokenType__CloseSquare, TokenType__Colon, TokenType__ColonColon, TokenType__Comma, TokenType__Dot, TokenType__DotDot, TokenType__EOF, TokenType__Equals, TokenType__EqualEquals, TokenType__Exclamation, TokenType__FatArrow, TokenType__FloatLiteral, TokenType__FormatStringLiteral, TokenType__GreaterThan, TokenType__GreaterThanGreaterThan, TokenType__GreaterThanEquals, TokenType__Identifier, TokenType__IntLiteral, TokenType__LessThan, TokenType__LessThanLessThan, TokenType__LessThanEquals, TokenType__Line, TokenType__Minus, TokenType__MinusEquals, TokenType__NotEquals, TokenType__Newline, TokenType__OpenCurly, TokenType__OpenParen, TokenType__OpenSquare, TokenType__Percent, TokenType__Plus, TokenType__PlusEquals, TokenType__Question, TokenType__Semicolon, TokenType__Slash, TokenType__SlashEquals, TokenType__Star, TokenType__StarEquals, TokenType__StringLiteral, TokenType__Tilde};
+
+static __attribute__((unused)) char *TokenType__dbg(TokenType this) {
+  if ((u32)this < 91u) return __TokenType_names[this];
+  return "<unknown>";
+}
+
+static i32 __TokenType_displace[] = {-28, -66, 0, -32, 1, 0, 0, -29, -60, 0, -15, 0, -18, 0, 0, 1, 0, -52, 0, -54, -48, 2, 1, -2, 0, 1, -24, -19, -9, 0, 0, -12, 0, -34, 0, -62, 0, -51, 0, 0, 0, -50, 0, 0, 0, 0, -17, 0, -5, 0, 1, 0, 1, 0, 0, 0, 1, 0, 0, -31, 2, -38, 3, 0, -8, 0, -10, -64, -61, -30, -3, -58, -40, 0, -44, 0, -63, 6, 0, 0, -42, 0, -1, -57, 0, 0, 0, 0, -49, 0, 0, -41, 0, 0, -11, 0, -47, -20, -59, 1, 0, 1, 0, 0, 0, -7, 0, 1, 0, 1, -23, 0, -43, 0, 0, 0, -53, -6, 0, 2, 1, -26, -21, 1, 0, -37, 0, 0};
+static i32 __TokenType_slots[] = {1, 2, 5, 21, 7, 8, 12, 14, 16, 19, 20, 24, 35, 15, 25, 11, 30, 32, 33, 36, 37, 75, 38, 39, 23, 42, 41, 43, 44, 48, 49, 51, 18, 53, 31, 29, 54, 55, 84, 58, 59, 60, 64, 66, 28, 22, 67, 68, 69, 71, 72, 73, 74, 76, 4, 63, 78, 79, 81, 85, 86, 87, 88, 89, 9, 90, 34, 46, -1, -1, 77, -1, -1, 61, -1, 17, -1, -1, 83, 52, 10, 70, -1, 57, 27, -1, 13, -1, -1, 50, -1, -1, -1, -1, -1, 47, 3, -1, 82, 56, 80, -1, -1, -1, -1, -1, 26, -1, -1, -1, 65, 45, -1, -1, -1, -1, 6, -1, -1, -1, -1, 62, -1, 0, 40, -1, -1, -1};
+
+static __attribute__((unused)) TokenType *TokenType__from_str(char *s) {
+  i32 d = __TokenType_displace[aecor_hash_str(s, 0) & 127u];
+  i32 i = __TokenType_slots[d < 0 ? -d - 1 : aecor_hash_str(s, d) & 127u];
+  if (i < 0 || strcmp(s, __TokenType_names[i])) return NULL;
+  return &__TokenType_values[i];
+}
+
+struct Token {
+  Span span;
+  char *text;
+  Token *suffix;
+  TokenType type;
+  bool seen_newline;
+};
+
+enum ErrorType {
+  ErrorType__Standard,
+  ErrorType__WithNote,
+  ErrorType__WithHint,
+};
+
+static char *__ErrorType_names[] = {"Standard", "WithNote", "WithHint"};
+static ErrorType __ErrorType_values[] = {ErrorType__Standard, ErrorType__WithNote, ErrorType__WithHint};
+
+static __attribute__((unused)) char *ErrorType__dbg(ErrorType this) {
+  if ((u32)this < 3u) return __ErrorType_names[this];
+  return "<unknown>";
+}
+
+static i32 __ErrorType_displace[] = {-1, 0, 0, 2};
+static i32 __ErrorType_slots[] = {0, -1, 2, 1};
+
+static __attribute__((unused)) ErrorType *ErrorType__from_str(char *s) {
+  i32 d = __ErrorType_displace[aecor_hash_str(s, 0) & 3u];
+  i32 i = __ErrorType_slots[d < 0 ? -d - 1 : aecor_hash_str(s, d) & 3u];
+  if (i < 0 || strcmp(s, __ErrorType_names[i])) return NULL;
+  return &__ErrorType_values[i];
+}
+
+struct Error {
+  ErrorType type;
+  char *msg1;
+  Span span1;
+  char *msg2;
+  Span span2;
+};
+
+enum MessageType {
+  MessageType__Error,
+  MessageType__Warning,
+  MessageType__Note,
+};
+
+static char *__MessageType_names[] = {"Error", "Warning", "Note"};
+static MessageType __MessageType_values[] = {MessageType__Error, MessageType__Warning, MessageType__Note};
+
+static __attribute__((unused)) char *MessageType__dbg(MessageType this) {
+  if ((u32)this < 3u) return __MessageType_names[this];
+  return "<unknown>";
+}
+
+static i32 __MessageType_displace[] = {0, 0, 0, 1};
+static i32 __MessageType_slots[] = {0, 2, -1, 1};
+
+static __attribute__((unused)) MessageType *MessageType__from_str(char *s) {
+  i32 d = __MessageType_displace[aecor_hash_str(s, 0) & 3u];
+  i32 i = __MessageType_slots[d < 0 ? -d - 1 : aecor_hash_str(s, d) & 3u];
+  if (i < 0 || strcmp(s, __MessageType_names[i])) return NULL;
+  return &__MessageType_values[i];
+}
+
+struct Lexer {
+  char *source;
+  i32 source_len;
+  i32 i;
+  Location loc;
+  bool seen_newline;
+  Vector *tokens;
+  Vector *errors;
+};
+
+struct Buffer {
+  u8 *data;
+  i32 size;
+  i32 capacity;
+};
+
+struct MapNode {
+  char *key;
+  void *value;
+  MapNode *next;
+};
+
+struct Map {
+  MapNode **buckets;
+  i32 num_items;
+  i32 num_buckets;
+  i32 num_collisions;
+};
+
+struct MapIterator {
+  i32 idx;
+  MapNode *cur;
+  Map *map;
+};
+
+enum BaseType {
+  BaseType__Char,
+  BaseType__Bool,
+  BaseType__Void,
+  BaseType__I8,
+  BaseType__I16,
+  BaseType__I32,
+  BaseType__I64,
+  BaseType__U8,
+  BaseType__U16,
+  BaseType__U32,
+  BaseType__U64,
+  BaseType__F32,
+  BaseType__F64,
+  BaseType__Pointer,
+  BaseType__Structure,
+  BaseType__Function,
+  BaseType__Method,
+  BaseType__Array,
+  BaseType__Simd,
+  BaseType__Error,
+};
+
+static char *__BaseType_names[] = {"Char", "Bool", "Void", "I8", "I16", "I32", "I64", "U8", "U16", "U32", "U64", "F32", "F64", "Pointer", "Structure", "Function", "Method", "Array", "Simd", "Error"};
+static BaseType __BaseType_values[] = {BaseType__Char, BaseType__Bool, BaseType__Void, BaseType__I8, BaseType__I16, BaseType__I32, BaseType__I64, BaseType__U8, BaseType__U16, BaseType__U32, BaseType__U64, BaseType__F32, BaseType__F64, BaseType__Pointer, BaseType__Structure, BaseType__Function, BaseType__Method, BaseType__Array, BaseType__Simd, BaseType__Error};
+
+static __attribute__((unused)) char *BaseType__dbg(BaseType this) {
+  if ((u32)this < 20u) return __BaseType_names[this];
+  return "<unknown>";
+}
+
+static i32 __BaseType_displace[] = {-14, -8, -4, 0, -11, -3, 0, 0, 0, 0, 0, -17, 0, 1, 0, 1, 0, 0, -16, 0, 0, 0, 1, -2, 0, 0, -9, -15, -7, 0, -5, 0};
+static i32 __BaseType_slots[] = {4, 1, 2, 5, 6, 0, 7, 9, 10, 15, 11, 3, 8, 12, 13, 17, 19, -1, -1, 18, -1, -1, -1, -1, 16, -1, -1, -1, 14, -1, -1, -1};
+
+static __attribute__((unused)) BaseType *BaseType__from_str(char *s) {
+  i32 d = __BaseType_displace[aecor_hash_str(s, 0) & 31u];
+  i32 i = __BaseType_slots[d < 0 ? -d - 1 : aecor_hash_str(s, d) & 31u];
+  if (i < 0 || strcmp(s, __BaseType_names[i])) return NULL;
+  return &__BaseType_values[i];
+}
+
+struct Type {
+  Type *ptr;
+  char *name;
+  Span span;
+  AST *size_expr;
+  Structure *struct_def;
+  Function *func_def;
+  Type *return_type;
+  Vector *params;
+  BaseType base;
+  i32 lanes;
+};
+
+enum ASTType {
+  ASTType__Assignment,
+  ASTType__Address,
+  ASTType__And,
+  ASTType__Block,
+  ASTType__BoolLiteral,
+  ASTType__BitwiseAnd,
+  ASTType__BitwiseNot,
+  ASTType__BitwiseOr,
+  ASTType__BitwiseXor,
+  ASTType__Break,
+  ASTType__Call,
+  ASTType__Cast,
+  ASTType__CharLiteral,
+  ASTType__Constant,
+  ASTType__Constructor,
+  ASTType__Continue,
+  ASTType__Defer,
+  ASTType__Dereference,
+  ASTType__Divide,
+  ASTType__DivideEquals,
+  ASTType__EnumValue,
+  ASTType__Equals,
+  ASTType__Error,
+  ASTType__FloatLiteral,
+  ASTType__FormatStringLiteral,
+  ASTType__For,
+  ASTType__ForIn,
+  ASTType__GeneratorYield,
+  ASTType__GreaterThan,
+  ASTType__GreaterThanEquals,
+  ASTType__If,
+  ASTType__Identifier,
+  ASTType__Index,
+  ASTType__IntLiteral,
+  ASTType__IsNotNull,
+  ASTType__LeftShift,
+  ASTType__LessThan,
+  ASTType__LessThanEquals,
+  ASTType__Match,
+  ASTType__Member,
+  ASTType__Minus,
+  ASTType__MinusEquals,
+  ASTType__Modulus,
+  ASTType__Multiply,
+  ASTType__MultiplyEquals,
+  ASTType__Not,
+  ASTType__NotEquals,
+  ASTType__Null,
+  ASTType__Or,
+  ASTType__Plus,
+  ASTType__PlusEquals,
+  ASTType__Return,
+  ASTType__RightShift,
+  ASTType__SizeOf,
+  ASTType__ScopeLookup,
+  ASTType__Scratch,
+  ASTType__StringLiteral,
+  ASTType__UnaryMinus,
+  ASTType__VarDeclaration,
+  ASTType__Yield,
+  ASTType__While,
+};
+
+static char *__ASTType_names[] = {"Assignment", "Address", "And", "Block", "BoolLiteral", "BitwiseAnd", "BitwiseNot", "BitwiseOr", "BitwiseXor", "Break", "Call", "Cast", "CharLiteral", "Constant", "Constructor", "Continue", "Defer", "Dereference", "Divide", "DivideEquals", "EnumValue", "Equals", "Error", "FloatLiteral", "FormatStringLiteral", "For", "ForIn", "GeneratorYield", "GreaterThan", "GreaterThanEquals", "If", "Identifier", "Index", "IntLiteral", "IsNotNull", "LeftShift", "LessThan", "LessThanEquals", "Match", "Member", "Minus", "MinusEquals", "Modulus", "Multiply", "MultiplyEquals", "Not", "NotEquals", "Null", "Or", "Plus", "PlusEquals", "Return", "RightShift", "SizeOf", "ScopeLookup", "Scratch", "StringLiteral", "UnaryMinus", "VarDeclaration", "Yield", "While"};
+static ASTType __ASTType_values[] = {ASTType__Assignment, ASTType__Address, ASTType__And, ASTType__Block, ASTType__BoolLiteral, ASTType__BitwiseAnd, ASTType__BitwiseNot, ASTType__BitwiseOr, ASTType__BitwiseXor, ASTType__Break, ASTType__Call, ASTType__Cast, ASTType__CharLiteral, ASTType__Constant, ASTType__Constructor, ASTType__Continue, ASTType__Defer, ASTType__Dereference, ASTType__Divide, ASTType__DivideEquals, ASTType__EnumValue, ASTType__Equals, ASTType__Error, ASTType__FloatLiteral, ASTType__FormatStringLiteral, ASTType__For, ASTType__ForIn, ASTType__GeneratorYield, ASTType__GreaterThan, ASTType__GreaterThanEquals, ASTType__If, ASTType__Identifier, ASTType__Index, ASTType__IntLiteral, ASTType__IsNotNull, ASTType__LeftShift, ASTType__LessThan, ASTType__LessThanEquals, ASTType__Match, ASTType__Member, ASTType__Minus, ASTType__MinusEquals, ASTType__Modulus, ASTType__Multiply, ASTType__MultiplyEquals, ASTType__Not, ASTType__NotEquals, ASTType__Null, ASTType__Or, ASTType__Plus, ASTType__PlusEquals, ASTType__Return, ASTType__RightShift, ASTType__SizeOf, ASTType__ScopeLookup, ASTType__Scratch, ASTType__StringLiteral, ASTType__UnaryMinus, ASTType__VarDeclaration, ASTType__Yield, ASTType__While};
+
+static __attribute__((unused)) char *ASTType__dbg(ASTType this) {
+  if ((u32)this < 61u) return __ASTType_names[this];
+  return "<unknown>";
+}
+
+static i32 __ASTType_displace[] = {-58, 0, 0, 2, -10, -13, 1, 0, -25, 0, 1, 3, -16, 1, 0, -46, 0, 1, -1, 0, -34, 2, -17, 5, -42, -26, -2, -48, 0, 0, 0, -49, -33, -37, -52, 0, -53, 0, 0, -31, 0, -44, 0, -54, 0, -8, 0, 0, -32, 0, 1, 1, 1, -18, 0, 0, 3, -56, -47, -22, -28, -12, 3, 0};
+static i32 __ASTType_slots[] = {0, 1, 54, 30, 57, 40, 56, 7, 8, 9, 44, 10, 12, 25, 42, 14, 15, 16, 11, 46, 51, 20, 27, 29, 21, 23, 2, 24, 45, 4, 26, 28, 31, 33, 50, 58, 34, 18, 3, 6, 19, 36, 48, 37, 55, 38, 39, 43, 47, 22, 41, 49, 52, 53, 5, 59, 32, 60, -1, 13, 35, 17, -1, -1};
+
+static __attribute__((unused)) ASTType *ASTType__from_str(char *s) {
+  i32 d = __ASTType_displace[aecor_hash_str(s, 0) & 63u];
+  i32 i = __ASTType_slots[d < 0 ? -d - 1 : aecor_hash_str(s, d) & 63u];
+  if (i < 0 || strcmp(s, __ASTType_names[i])) return NULL;
+  return &__ASTType_values[i];
+}
+
+struct Variable {
+  char *name;
+  Type *type;
+  Span span;
+  char *extern_name;
+  char *frame_name;
+  bool is_extern;
+  bool by_ref;
+};
+
+struct Function {
+  char *name;
+  Vector *params;
+  Type *return_type;
+  AST *body;
+  Type *type;
+  Span span;
+  char *extern_name;
+  char *method_struct_name;
+  Type *yield_type;
+  Vector *frame_vars;
+  Function *generator;
+  bool exits;
+  bool is_arrow;
+  bool is_address_taken;
+  bool is_extern;
+  bool is_static;
+  bool is_method;
+  bool is_inline;
+  bool is_noinline;
+  bool is_hot;
+  bool is_cold;
+  bool is_pure;
+  bool is_export;
+  bool writes_memory;
+};
+
+struct Structure {
+  Type *type;
+  char *name;
+  Vector *fields;
+  Span span;
+  char *extern_name;
+  Function *generator;
+  Vector *layout_fields;
+  i32 index;
+  bool is_extern;
+  bool is_enum;
+  bool is_union;
+  bool is_reorder;
+  bool is_packed;
+};
+
+struct Program {
+  Vector *functions;
+  Vector *structures;
+  Vector *constants;
+  Vector *global_vars;
+  Span span;
+  Map *included_files;
+  Vector *errors;
+  Vector *c_flags;
+  Vector *c_includes;
+  Vector *c_embed_headers;
+  Map *methods;
+};
+
+struct Block {
+  Vector *statements;
+};
+
+struct Binary {
+  AST *lhs;
+  AST *rhs;
+};
+
+struct Identifier {
+  char *name;
+  Variable *var;
+  Function *func;
+};
+
+struct FormatString {
+  Vector *parts;
+  Vector *specs;
+  Vector *exprs;
+};
+
+struct Argument {
+  AST *expr;
+  AST *label;
+};
+
+struct FuncCall {
+  AST *callee;
+  Vector *args;
+  Function *func;
+};
+
+struct Constructor {
+  AST *callee;
+  Structure *struc;
+  Vector *args;
+};
+
+struct Member {
+  AST *lhs;
+  AST *rhs;
+  bool is_method;
+  bool is_pointer;
+};
+
+struct EnumValue {
+  AST *lhs;
+  AST *rhs;
+  Structure *struct_def;
+  Variable *var;
+};
+
+struct VarDeclaration {
+  Variable *var;
+  AST *init;
+};
+
+struct IfStatement {
+  AST *cond;
+  AST *body;
+  AST *els;
+};
+
+struct Loop {
+  AST *init;
+  AST *cond;
+  AST *incr;
+  AST *body;
+};
+
+enum IterKind {
+  IterKind__Range,
+  IterKind__Elements,
+  IterKind__Buckets,
+  IterKind__Generator,
+};
+
+static char *__IterKind_names[] = {"Range", "Elements", "Buckets", "Generator"};
+static IterKind __IterKind_values[] = {IterKind__Range, IterKind__Elements, IterKind__Buckets, IterKind__Generator};
+
+static __attribute__((unused)) char *IterKind__dbg(IterKind this) {
+  if ((u32)this < 4u) return __IterKind_names[this];
+  return "<unknown>";
+}
+
+static i32 __IterKind_displace[] = {0, 0, -3, 1};
+static i32 __IterKind_slots[] = {0, 1, 2, 3};
+
+static __attribute__((unused)) IterKind *IterKind__from_str(char *s) {
+  i32 d = __IterKind_displace[aecor_hash_str(s, 0) & 3u];
+  i32 i = __IterKind_slots[d < 0 ? -d - 1 : aecor_hash_str(s, d) & 3u];
+  if (i < 0 || strcmp(s, __IterKind_names[i])) return NULL;
+  return &__IterKind_values[i];
+}
+
+struct ForIn {
+  Variable *var;
+  AST *expr;
+  AST *end;
+  AST *body;
+  IterKind kind;
+  Variable *source;
+  Variable *cursor;
+  Variable *limit;
+};
+
+struct Cast {
+  AST *lhs;
+  Type *to;
+};
+
+struct MatchCase {
+  AST *cond;
+  AST *body;
+};
+
+struct Match {
+  AST *expr;
+  Vector *cases;
+  AST *defolt;
+  Span defolt_span;
+};
+
+struct NumLiteral {
+  char *text;
+  Type *suffix;
+};
+
+union ASTUnion {
+  Block block;
+  Binary binary;
+  Identifier ident;
+  FormatString fmt_str;
+  FuncCall call;
+  Member member;
+  EnumValue *enum_val;
+  VarDeclaration var_decl;
+  IfStatement if_stmt;
+  Loop *loop;
+  ForIn *for_in;
+  Cast cast;
+  AST *unary;
+  Match *match_stmt;
+  NumLiteral num_literal;
+  bool bool_literal;
+  char *string_literal;
+  char *char_literal;
+  Constructor constructor;
+  Type *size_of_type;
+};
+
+struct AST {
+  ASTType type;
+  bool returns;
+  Span span;
+  Type *etype;
+  ASTUnion u;
+};
+
+struct ParserContext {
+  Vector *tokens;
+  i32 offset;
+};
+
+struct Template {
+  char *name;
+  Vector *params;
+  Vector *tokens;
+  i32 start;
+  bool is_struct;
+};
+
+struct Instance {
+  char *template_name;
+  Vector *args;
+  char *name;
+  Span span;
+};
+
+struct Parser {
+  Vector *tokens;
+  i32 curr;
+  Vector *context_stack;
+  char *project_root;
+  Vector *include_dirs;
+  Program *program;
+  Map *templates;
+  Map *method_templates;
+  Map *instances;
+  Vector *pending_instances;
+  Map *type_params;
+  char *instance_name;
+  bool defining_template;
+  bool pending_greater;
+};
+
+struct Bitset {
+  u64 *words;
+  i32 num_words;
+  i32 size;
+};
+
+struct TypeChecker {
+  Vector *scopes;
+  Map *functions;
+  Map *structures;
+  Map *constants;
+  Map *methods;
+  Function *cur_func;
+  AST *callee;
+  bool in_loop;
+  bool can_yield;
+  i32 expr_block_depth;
+  Program *program;
+};
+
+struct BodyEffects {
+  Vector *globals;
+  Vector *mutated;
+  Vector *calls;
+  bool writes_memory;
+};
+
+struct CodeGenerator {
+  Program *program;
+  Buffer out;
+  Vector *scopes;
+  Vector *yield_vars;
+  i32 yield_count;
+  i32 label_count;
+  i32 scratch_depth;
+  i32 match_hash_threshold;
+  bool debug;
+  bool buffer_stdout;
+  bool release;
+  bool instrument;
+  Vector *instrumented;
+  bool track_alloc;
+  Function *generator;
+  i32 resume_points;
+};
+
+/* function declarations */
+static __attribute__((unused)) FILE *File__open(char *path, char *mode);
+static __attribute__((unused)) bool File__exists(char *path);
+static __attribute__((unused)) i32 File__size(FILE *this);
+static __attribute__((unused)) char *File__slurp(FILE *this);
+static __attribute__((unused)) i32 File__read(FILE *this, void *buf, i32 size);
+static __attribute__((unused)) i32 File__write(FILE *this, void *buf, i32 size);
+static __attribute__((unused)) void File__puts(FILE *this, char *str);
+static __attribute__((unused)) __attribute__((noreturn)) __attribute__((cold)) void panic(char *msg);
+static __attribute__((unused)) bool string__starts_with(char *this, char *prefix);
+static __attribute__((unused)) bool string__ends_with(char *this, char *suffix);
+static __attribute__((unused)) void string__remove_last_n(char *this, i32 n);
+static __attribute__((unused)) bool string__eq(char *this, char *str2);
+static __attribute__((unused)) char *string__substring(char *this, i32 start, i32 len);
+static __attribute__((unused)) void string__strip_trailing_whitespace(char *this);
+static __attribute__((unused)) i32 min(i32 a, i32 b);
+static __attribute__((unused)) i32 max(i32 a, i32 b);
+static inline __attribute__((unused)) __attribute__((always_inline)) void **Vector__inline_data(Vector *this);
+static __attribute__((unused)) Vector *Vector__new_sized(i32 capacity);
+static __attribute__((unused)) Vector *Vector__new(void);
+static __attribute__((unused)) void Vector__resize(Vector *this, i32 new_capacity);
+static inline __attribute__((unused)) __attribute__((always_inline)) i32 Vector__next_capacity(Vector *this);
+static inline __attribute__((unused)) __attribute__((always_inline)) void Vector__push(Vector *this, void *val);
+static __attribute__((unused)) void Vector__push_front(Vector *this, void *val);
+static __attribute__((unused)) void *Vector__pop(Vector *this);
+static inline __attribute__((unused)) __attribute__((always_inline)) void *Vector__back(Vector *this);
+static inline __attribute__((unused)) __attribute__((always_inline)) void *Vector__at(Vector *this, i32 i);
+static inline __attribute__((unused)) __attribute__((always_inline)) bool Vector__empty(Vector *this);
+static __attribute__((unused)) void Vector__free(Vector *this);
+static __attribute__((unused)) char *Location__str(Location this);
+static __attribute__((unused)) bool Location__is_before(Location *this, Location other);
+static __attribute__((unused)) char *Span__str(const Span *this);
+static __attribute__((unused)) Span Span__default(void);
+static __attribute__((unused)) Span Span__join(const Span *this, const Span *other);
+static __attribute__((unused)) bool Span__contains_loc(Span this, Location loc);
+static __attribute__((unused)) Token *Token__new(TokenType type, Span span, char *text);
+static __attribute__((unused)) Token *Token__from_type(TokenType type, Span span);
+static __attribute__((unused)) Token *Token__from_ident(char *text, Span span);
+static __attribute__((unused)) char *Token__str(Token *this);
+static __attribute__((unused)) TokenType TokenType__from_text(char *text);
+static __attribute__((unused)) char *TokenType__str(TokenType this);
+static __attribute__((unused)) f32 minf(f32 a, f32 b);
+static __attribute__((unused)) f32 maxf(f32 a, f32 b);
+static __attribute__((unused)) f32 clampf(f32 x, f32 min, f32 max);
+static __attribute__((unused)) f32 clamp01(f32 x);
+static __attribute__((unused)) f32 degrees(f32 radians);
+static __attribute__((unused)) f32 radians(f32 degrees);
+static __attribute__((unused)) i32 edit_distance(char *str1, char *str2);
+static __attribute__((unused)) char *find_word_suggestion(char *s, Vector *options);
+static __attribute__((unused)) u32 hash_string(char *s, u32 seed);
+static __attribute__((unused)) char *ErrorType__str(ErrorType this);
+static __attribute__((unused)) char *MessageType__to_color(MessageType this);
+static __attribute__((unused)) char *MessageType__str(MessageType this);
+static __attribute__((unused)) void display_line(void);
+static __attribute__((unused)) void display_message(MessageType type, const Span *span, char *msg);
+static __attribute__((unused)) void display_message_span(MessageType type, Span span, char *msg);
+static __attribute__((unused)) void Error__display(Error *this);
+static __attribute__((unused)) __attribute__((noreturn)) void Error__panic(Error *this);
+static __attribute__((unused)) Error *Error__new(Span span, char *msg);
+static __attribute__((unused)) Error *Error__new_note(Span span, char *msg, char *note);
+static __attribute__((unused)) Error *Error__new_hint(Span span, char *msg, Span span2, char *hint);
+static __attribute__((unused)) void display_error_messages(Vector *errors, i32 detail_level);
+static __attribute__((unused)) bool is_hex_digit(char c);
+static __attribute__((unused)) Lexer Lexer__make(char *source, char *filename);
+static __attribute__((unused)) void Lexer__push(Lexer *this, Token *token);
+static __attribute__((unused)) void Lexer__push_type(Lexer *this, TokenType type, i32 len);
+static inline __attribute__((unused)) __attribute__((always_inline)) char Lexer__cur(Lexer *this);
+static __attribute__((unused)) void Lexer__inc(Lexer *this);
+static __attribute__((unused)) char Lexer__peek(Lexer *this, i32 offset);
+static __attribute__((unused)) void Lexer__lex_char_literal(Lexer *this);
+static __attribute__((unused)) void Lexer__lex_string_literal(Lexer *this);
+static __attribute__((unused)) Token *Lexer__lex_int_literal_different_base(Lexer *this);
+static __attribute__((unused)) Token *Lexer__lex_numeric_literal_helper(Lexer *this);
+static __attribute__((unused)) void Lexer__lex_numeric_literal(Lexer *this);
+static __attribute__((unused)) Vector *Lexer__lex(Lexer *this);
+static __attribute__((unused)) Buffer Buffer__make(void);
+static __attribute__((unused)) Buffer Buffer__from_string(char *s);
+static __attribute__((unused)) Buffer Buffer__from_sized_string(char *s, i32 size);
+static __attribute__((unused)) void Buffer__resize_if_necessary(Buffer *this, i32 new_size);
+static __attribute__((unused)) void Buffer__hex_dump(Buffer *this);
+static __attribute__((unused)) void Buffer__putb(Buffer *this, Buffer *buf);
+static __attribute__((unused)) void Buffer__putbf(Buffer *this, Buffer *buf);
+static __attribute__((unused)) void Buffer__puts(Buffer *this, char *s);
+static __attribute__((unused)) void Buffer__put_str(Buffer *this, char *s);
+static inline __attribute__((unused)) __attribute__((always_inline)) void Buffer__putc(Buffer *this, char c);
+static __attribute__((unused)) void Buffer__put_u64(Buffer *this, u64 value);
+static __attribute__((unused)) void Buffer__put_i64(Buffer *this, i64 value);
+static __attribute__((unused)) void Buffer__put_f64(Buffer *this, f64 value);
+static __attribute__((unused)) void Buffer__put_ptr(Buffer *this, void *value);
+static __attribute__((unused)) void Buffer__putsf(Buffer *this, char *s);
+static __attribute__((unused)) char *Buffer__str(Buffer *this);
+static __attribute__((unused)) char *Buffer__new_str(Buffer *this);
+static __attribute__((unused)) void Buffer__free(Buffer *this);
+static __attribute__((unused)) MapNode *MapNode__new(char *key, void *value, MapNode *next);
+static __attribute__((unused)) void MapNode__free_list(MapNode *node);
+static __attribute__((unused)) Map *Map__new(void);
+static __attribute__((unused)) i32 Map__hash(Map *this, char *s);
+static __attribute__((unused)) MapNode *Map__get_node(Map *this, char *key);
+static __attribute__((unused)) void *Map__get(Map *this, char *key);
+static __attribute__((unused)) bool Map__exists(Map *this, char *key);
+static __attribute__((unused)) void Map__insert(Map *this, char *key, void *value);
+static __attribute__((unused)) void Map__resize(Map *this);
+static __attribute__((unused)) void Map__print_keys(Map *this);
+static __attribute__((unused)) void Map__push_keys(Map *this, Vector *vec);
+static __attribute__((unused)) void Map__free(Map *this);
+static __attribute__((unused)) MapIterator Map__iter(Map *this);
+static __attribute__((unused)) char *MapIterator__key(MapIterator *this);
+static __attribute__((unused)) void *MapIterator__value(MapIterator *this);
+static __attribute__((unused)) MapIterator MapIterator__make(Map *map);
+static __attribute__((unused)) void MapIterator__next(MapIterator *this);
+static __attribute__((unused)) char *BaseType__str(BaseType this);
+static __attribute__((unused)) i32 BaseType__scalar_size(BaseType this);
+static __attribute__((unused)) Type *Type__new(BaseType base, Span span);
+static __attribute__((unused)) Type *Type__new_link(BaseType base, Type *next, Span span);
+static __attribute__((unused)) Type *Type__ptr_to(BaseType base, Span span);
+static __attribute__((unused)) Type *Type__simd_from_name(char *name, Span span);
+static __attribute__((unused)) bool Type__is_struct_or_ptr(Type *this);
+static __attribute__((unused)) bool Type__is_integer(Type *this);
+static __attribute__((unused)) bool Type__is_float(Type *this);
+static __attribute__((unused)) bool Type__is_numeric(Type *this);
+static __attribute__((unused)) bool Type__is_numeric_or_char(Type *this);
+static __attribute__((unused)) bool Type__eq(Type *this, Type *other);
+static __attribute__((unused)) char *Type__str(Type *this);
+static __attribute__((unused)) bool Type__is_string(Type *this);
+static __attribute__((unused)) Type *Type__decay_array(Type *this);
+static __attribute__((unused)) bool Type__is_enum(Type *this);
+static __attribute__((unused)) bool Type__is_struct(Type *this);
+static __attribute__((unused)) bool Type__is_array(Type *this);
+static __attribute__((unused)) bool Type__is_simd(Type *this);
+static __attribute__((unused)) ASTType ASTType__from_token(TokenType type);
+static __attribute__((unused)) Variable *Variable__new(char *name, Type *type, Span span);
+static __attribute__((unused)) Function *Function__new(Span span);
+static __attribute__((unused)) Structure *Structure__new(Span span);
+static __attribute__((unused)) Variable *Structure__find_field(Structure *this, char *name);
+static __attribute__((unused)) Program *Program__new(void);
+static __attribute__((unused)) bool Program__is_file_included(Program *this, char *filename);
+static __attribute__((unused)) void Program__add_included_file(Program *this, char *filename);
+static __attribute__((unused)) Argument *Argument__new(AST *label, AST *expr);
+static __attribute__((unused)) MatchCase *MatchCase__new(AST *cond, AST *body);
+static __attribute__((unused)) AST *AST__alloc(void);
+static __attribute__((unused)) AST *AST__new(ASTType type, Span span);
+static __attribute__((unused)) AST *AST__new_unop(ASTType type, Span span, AST *expr);
+static __attribute__((unused)) AST *AST__new_binop(ASTType type, AST *lhs, AST *rhs);
+static __attribute__((unused)) bool AST__callee_is(AST *this, char *expected);
+static __attribute__((unused)) bool AST__is_lvalue(AST *this);
+static __attribute__((unused)) ParserContext *ParserContext__new(Vector *tokens, i32 offset);
+static __attribute__((unused)) Template *Template__new(char *name, Vector *params, Vector *tokens, i32 start);
+static __attribute__((unused)) Parser *Parser__new(char *filename);
+static __attribute__((unused)) void Parser__push_context(Parser *this, Vector *tokens);
+static __attribute__((unused)) void Parser__pop_context(Parser *this);
+static __attribute__((unused)) void Parser__add_include_dir(Parser *this, char *dir);
+static __attribute__((unused)) Error *Parser__error_msg(Parser *this, char *msg);
+static __attribute__((unused)) void Parser__error(Parser *this, Error *err);
+static __attribute__((unused)) void Parser__unhandled_type(Parser *this, char *func);
+static inline __attribute__((unused)) __attribute__((always_inline)) Token *Parser__token(Parser *this);
+static inline __attribute__((unused)) __attribute__((always_inline)) bool Parser__token_is(Parser *this, TokenType type);
+static __attribute__((unused)) bool Parser__consume_if(Parser *this, TokenType type);
+static __attribute__((unused)) void Parser__consume_newline_or(Parser *this, TokenType type);
+static __attribute__((unused)) Token *Parser__consume(Parser *this, TokenType type);
+static __attribute__((unused)) Type *Parser__parse_type_with_parent(Parser *this, Type *parent);
+static __attribute__((unused)) Type *Parser__parse_type(Parser *this);
+static __attribute__((unused)) i32 Parser__skip_type_args(Parser *this, i32 start);
+static __attribute__((unused)) void Parser__consume_closing_angle(Parser *this);
+static __attribute__((unused)) Vector *Parser__parse_type_args(Parser *this);
+static __attribute__((unused)) Vector *Parser__parse_type_params(Parser *this);
+static __attribute__((unused)) char *Parser__mangle_type(Parser *this, Type *type);
+static __attribute__((unused)) char *Parser__instantiate(Parser *this, char *name, Vector *args, Span span);
+static __attribute__((unused)) void Parser__begin_template_definition(Parser *this, Vector *params);
+static __attribute__((unused)) void Parser__end_template_definition(Parser *this);
+static __attribute__((unused)) Template *Parser__register_template(Parser *this, char *name, Vector *params, i32 start, bool is_struct);
+static __attribute__((unused)) void Parser__find_templates(Parser *this);
+static __attribute__((unused)) Map *Parser__bind_type_params(Parser *this, Vector *params, Vector *args);
+static __attribute__((unused)) void Parser__instantiate_templates(Parser *this, Program *program);
+static __attribute__((unused)) AST *Parser__parse_format_string(Parser *this);
+static __attribute__((unused)) Type *Parser__parse_literal_suffix_type(Parser *this, Token *suffix);
+static __attribute__((unused)) AST *Parser__parse_factor(Parser *this, TokenType end_type);
+static __attribute__((unused)) AST *Parser__parse_term(Parser *this, TokenType end_type);
+static __attribute__((unused)) AST *Parser__parse_additive(Parser *this, TokenType end_type);
+static __attribute__((unused)) AST *Parser__parse_shift(Parser *this, TokenType end_type);
+static __attribute__((unused)) AST *Parser__parse_bw_and(Parser *this, TokenType end_type);
+static __attribute__((unused)) AST *Parser__parse_bw_xor(Parser *this, TokenType end_type);
+static __attribute__((unused)) AST *Parser__parse_bw_or(Parser *this, TokenType end_type);
+static __attribute__((unused)) AST *Parser__parse_relational(Parser *this, TokenType end_type);
+static __attribute__((unused)) AST *Parser__parse_logical_and(Parser *this, TokenType end_type);
+static __attribute__((unused)) AST *Parser__parse_logical_or(Parser *this, TokenType end_type);
+static __attribute__((unused)) AST *Parser__parse_expression(Parser *this, TokenType end_type);
+static __attribute__((unused)) AST *Parser__parse_match(Parser *this);
+static __attribute__((unused)) AST *Parser__parse_if(Parser *this);
+static __attribute__((unused)) void Parser__consume_end_of_statement(Parser *this);
+static __attribute__((unused)) AST *Parser__parse_statement(Parser *this);
+static __attribute__((unused)) AST *Parser__parse_block(Parser *this);
+static __attribute__((unused)) AST *Parser__parse_for_in(Parser *this);
+static __attribute__((unused)) void Parser__parse_function_attribute(Parser *this, Function *func, Token *attr);
+static __attribute__((unused)) Function *Parser__parse_function(Parser *this);
+static __attribute__((unused)) Structure *Parser__parse_enum(Parser *this);
+static __attribute__((unused)) void Parser__parse_struct_attribute(Parser *this, Structure *struc, Token *attr);
+static __attribute__((unused)) Structure *Parser__parse_struct(Parser *this);
+static __attribute__((unused)) AST *Parser__parse_global_value(Parser *this, bool is_constant);
+static __attribute__((unused)) char *Parser__find_file_path(Parser *this, char *filename);
+static __attribute__((unused)) char *Parser__include_file(Parser *this, Program *program, char *filename);
+static __attribute__((unused)) void Parser__parse_use(Parser *this, Program *program);
+static __attribute__((unused)) void Parser__parse_compiler_option(Parser *this, Program *program);
+static __attribute__((unused)) void Parser__parse_into_program(Parser *this, Program *program);
+static __attribute__((unused)) void Parser__include_prelude(Parser *this, Program *program);
+static __attribute__((unused)) Bitset *Bitset__new(i32 size);
+static inline __attribute__((unused)) __attribute__((always_inline)) u64 Bitset__mask(i32 i);
+static inline __attribute__((unused)) __attribute__((always_inline)) bool Bitset__test(Bitset *this, i32 i);
+static inline __attribute__((unused)) __attribute__((always_inline)) void Bitset__set(Bitset *this, i32 i);
+static inline __attribute__((unused)) __attribute__((always_inline)) void Bitset__clear(Bitset *this, i32 i);
+static __attribute__((unused)) void Bitset__assign(Bitset *this, i32 i, bool value);
+static __attribute__((unused)) void Bitset__set_all(Bitset *this);
+static __attribute__((unused)) void Bitset__clear_all(Bitset *this);
+static __attribute__((unused)) i32 Bitset__count(Bitset *this);
+static __attribute__((unused)) i32 Bitset__rank(Bitset *this, i32 i);
+static __attribute__((unused)) i32 Bitset__select(Bitset *this, i32 rank);
+static __attribute__((unused)) i32 Bitset__next_set(Bitset *this, i32 start);
+static __attribute__((unused)) i32 Bitset__next_clear(Bitset *this, i32 start);
+static __attribute__((unused)) void Bitset__and_with(Bitset *this, Bitset *other);
+static __attribute__((unused)) void Bitset__or_with(Bitset *this, Bitset *other);
+static __attribute__((unused)) void Bitset__xor_with(Bitset *this, Bitset *other);
+static __attribute__((unused)) void Bitset__and_not_with(Bitset *this, Bitset *other);
+static __attribute__((unused)) void Bitset__free(Bitset *this);
+static __attribute__((unused)) void TypeChecker__error(TypeChecker *this, Error *err);
+static __attribute__((unused)) TypeChecker *TypeChecker__new(void);
+static __attribute__((unused)) void TypeChecker__push_scope(TypeChecker *this);
+static __attribute__((unused)) Map *TypeChecker__scope(TypeChecker *this);
+static __attribute__((unused)) void TypeChecker__pop_scope(TypeChecker *this);
+static __attribute__((unused)) Variable *TypeChecker__find_constant(TypeChecker *this, char *name);
+static __attribute__((unused)) void TypeChecker__push_var(TypeChecker *this, Variable *var);
+static __attribute__((unused)) Variable *TypeChecker__find_var(TypeChecker *this, char *name);
+static __attribute__((unused)) Variable *TypeChecker__get_struct_member(TypeChecker *this, char *lhs, char *rhs);
+static __attribute__((unused)) bool TypeChecker__type_is_valid(TypeChecker *this, Type *type);
+static __attribute__((unused)) void TypeChecker__check_method_call(TypeChecker *this, Type *method_type, AST *node);
+static __attribute__((unused)) Type *TypeChecker__check_constructor(TypeChecker *this, Structure *struc, AST *node);
+static __attribute__((unused)) Type *TypeChecker__check_simd_constructor(TypeChecker *this, Type *type, AST *node);
+static __attribute__((unused)) Type *TypeChecker__check_shuffle(TypeChecker *this, AST *node);
+static __attribute__((unused)) Type *TypeChecker__check_simd_arith(TypeChecker *this, AST *node, Type *lhs, Type *rhs);
+static __attribute__((unused)) bool TypeChecker__simd_lane_to_index(TypeChecker *this, AST *node, Type *type);
+static __attribute__((unused)) void TypeChecker__call_dbg_on_enum_value(TypeChecker *this, AST *node);
+static __attribute__((unused)) Type *TypeChecker__check_debug_assert(TypeChecker *this, AST *node);
+static __attribute__((unused)) Type *TypeChecker__check_call(TypeChecker *this, AST *node);
+static __attribute__((unused)) Type *TypeChecker__check_format_string(TypeChecker *this, AST *node);
+static __attribute__((unused)) Type *TypeChecker__check_pointer_arith(TypeChecker *this, AST *node, Type *lhs, Type *rhs);
+static __attribute__((unused)) Type *TypeChecker__check_binary_op(TypeChecker *this, AST *node, AST *_lhs, AST *_rhs);
+static __attribute__((unused)) void TypeChecker__error_unknown_identifier(TypeChecker *this, Span span, char *name);
+static __attribute__((unused)) void TypeChecker__error_unknown_member(TypeChecker *this, AST *node, Type *struct_type, char *field_name, bool is_static);
+static __attribute__((unused)) bool TypeChecker__try_infer_enum(TypeChecker *this, AST *node, Type *type);
+static __attribute__((unused)) Type *TypeChecker__check_expression(TypeChecker *this, AST *node, Type *hint);
+static __attribute__((unused)) void TypeChecker__check_expression_statement(TypeChecker *this, AST *node, AST *body, bool is_expr, Type *hint);
+static __attribute__((unused)) void TypeChecker__check_match_for_enum(TypeChecker *this, Structure *struc, AST *node, bool is_expr, Type *hint);
+static __attribute__((unused)) void TypeChecker__check_match(TypeChecker *this, AST *node, bool is_expr, Type *hint);
+static __attribute__((unused)) void TypeChecker__check_if(TypeChecker *this, AST *node, bool is_expr, Type *hint);
+static __attribute__((unused)) Type *TypeChecker__check_constant_expression(TypeChecker *this, AST *node);
+static __attribute__((unused)) void TypeChecker__check_var_declaration(TypeChecker *this, AST *node, bool is_constant);
+static __attribute__((unused)) void TypeChecker__add_frame_var(TypeChecker *this, Function *func, Variable *var);
+static __attribute__((unused)) void TypeChecker__check_statement(TypeChecker *this, AST *node);
+static __attribute__((unused)) Variable *TypeChecker__add_loop_state(TypeChecker *this, char *name, Type *type, Span span);
+static __attribute__((unused)) void TypeChecker__check_for_in(TypeChecker *this, AST *node);
+static __attribute__((unused)) void TypeChecker__check_block(TypeChecker *this, AST *node, bool can_yield);
+static __attribute__((unused)) void TypeChecker__check_function(TypeChecker *this, Function *func);
+static __attribute__((unused)) void TypeChecker__declare_generator(TypeChecker *this, Program *program, Function *func);
+static __attribute__((unused)) void TypeChecker__check_all_functions(TypeChecker *this, Program *program);
+static __attribute__((unused)) void TypeChecker__dfs_structs(TypeChecker *this, Structure *struc, Vector *results, Bitset *done);
+static __attribute__((unused)) Function *TypeChecker__add_builtin_method(TypeChecker *this, Map *s_methods, Structure *struc, char *name, Variable *param, Type *return_type);
+static __attribute__((unused)) void TypeChecker__check_all_structs(TypeChecker *this, Program *program);
+static __attribute__((unused)) void TypeChecker__check_program(TypeChecker *this, Program *program);
+static __attribute__((unused)) i32 align_to(i32 offset, i32 align);
+static __attribute__((unused)) i32 type_size(Type *type);
+static __attribute__((unused)) i32 type_align(Type *type);
+static __attribute__((unused)) i32 fields_size(Structure *struc, Vector *fields);
+static __attribute__((unused)) Vector *sort_fields_by_align(Vector *fields);
+static __attribute__((unused)) Vector *layout_fields(Structure *struc);
+static __attribute__((unused)) i32 struct_padding(Structure *struc);
+static __attribute__((unused)) void print_layout_report(Program *program);
+static __attribute__((unused)) AST *lvalue_root(AST *node);
+static __attribute__((unused)) BodyEffects *BodyEffects__new(Vector *globals);
+static __attribute__((unused)) bool BodyEffects__is_local(BodyEffects *this, AST *node);
+static __attribute__((unused)) void BodyEffects__add_call(BodyEffects *this, AST *node);
+static __attribute__((unused)) void BodyEffects__free(BodyEffects *this);
+static __attribute__((unused)) void find_effects(AST *node, BodyEffects *effects);
+static __attribute__((unused)) void mark_ref_params(Program *program);
+static __attribute__((unused)) CodeGenerator CodeGenerator__make(bool debug, bool buffer_stdout, bool release, bool instrument, bool track_alloc);
+static __attribute__((unused)) void CodeGenerator__error(CodeGenerator *this, Error *err);
+static __attribute__((unused)) void CodeGenerator__gen_debug_info(CodeGenerator *this, Span span);
+static __attribute__((unused)) void CodeGenerator__indent(CodeGenerator *this, i32 num);
+static __attribute__((unused)) void CodeGenerator__push_scope(CodeGenerator *this);
+static __attribute__((unused)) Vector *CodeGenerator__scope(CodeGenerator *this);
+static __attribute__((unused)) void CodeGenerator__pop_scope(CodeGenerator *this);
+static __attribute__((unused)) void CodeGenerator__gen_control_body(CodeGenerator *this, AST *node, AST *body, i32 indent);
+static __attribute__((unused)) void CodeGenerator__gen_enum_value(CodeGenerator *this, char *enum_name, Variable *var);
+static __attribute__((unused)) void CodeGenerator__gen_enum(CodeGenerator *this, Structure *struc);
+static __attribute__((unused)) void CodeGenerator__gen_enum_from_str(CodeGenerator *this, Structure *struc, Function *func);
+static __attribute__((unused)) void CodeGenerator__gen_struct(CodeGenerator *this, Structure *struc);
+static __attribute__((unused)) void CodeGenerator__gen_generator_frame(CodeGenerator *this, Structure *struc, Map *done);
+static __attribute__((unused)) void CodeGenerator__gen_format_string_part(CodeGenerator *this, char *part, bool for_printf);
+static __attribute__((unused)) void CodeGenerator__gen_format_string_variadic(CodeGenerator *this, AST *node, bool newline_after);
+static __attribute__((unused)) void CodeGenerator__gen_format_string_appends(CodeGenerator *this, AST *node, char *prefix, char *target);
+static __attribute__((unused)) bool CodeGenerator__is_specialized_putsf(CodeGenerator *this, AST *node);
+static __attribute__((unused)) void CodeGenerator__gen_specialized_putsf(CodeGenerator *this, AST *node);
+static __attribute__((unused)) void CodeGenerator__gen_format_string(CodeGenerator *this, AST *node);
+static __attribute__((unused)) char *CodeGenerator__get_op(ASTType type);
+static __attribute__((unused)) void CodeGenerator__gen_in_yield_context(CodeGenerator *this, AST *node);
+static __attribute__((unused)) void CodeGenerator__gen_internal_print(CodeGenerator *this, AST *node);
+static __attribute__((unused)) void CodeGenerator__gen_debug_assert(CodeGenerator *this, AST *node);
+static __attribute__((unused)) void CodeGenerator__gen_simd_operand(CodeGenerator *this, AST *node, Type *type);
+static __attribute__((unused)) void CodeGenerator__gen_simd_constructor(CodeGenerator *this, AST *node);
+static __attribute__((unused)) bool CodeGenerator__is_tracked_alloc(CodeGenerator *this, Function *func);
+static __attribute__((unused)) void CodeGenerator__gen_alloc_site(CodeGenerator *this, Span span);
+static __attribute__((unused)) void CodeGenerator__gen_tracked_alloc(CodeGenerator *this, AST *node);
+static __attribute__((unused)) void CodeGenerator__gen_ref_argument(CodeGenerator *this, AST *node);
+static __attribute__((unused)) void CodeGenerator__gen_expression(CodeGenerator *this, AST *node);
+static __attribute__((unused)) void CodeGenerator__gen_var_decl(CodeGenerator *this, AST *node, bool is_constant);
+static __attribute__((unused)) void CodeGenerator__gen_var_ref(CodeGenerator *this, Variable *var);
+static __attribute__((unused)) void CodeGenerator__gen_loop_var(CodeGenerator *this, Variable *var, i32 indent);
+static __attribute__((unused)) void CodeGenerator__gen_source_field(CodeGenerator *this, ForIn *for_in, char *field);
+static __attribute__((unused)) void CodeGenerator__gen_for_in(CodeGenerator *this, AST *node, i32 indent);
+static __attribute__((unused)) void CodeGenerator__gen_match_case_body(CodeGenerator *this, AST *node, AST *body, i32 indent);
+static __attribute__((unused)) void CodeGenerator__gen_match_string_linear(CodeGenerator *this, AST *node, i32 indent);
+static __attribute__((unused)) void CodeGenerator__gen_match_string_hashed(CodeGenerator *this, AST *node, i32 indent);
+static __attribute__((unused)) bool CodeGenerator__can_hash_match_string(CodeGenerator *this, AST *node);
+static __attribute__((unused)) void CodeGenerator__gen_match_string(CodeGenerator *this, AST *node, i32 indent);
+static __attribute__((unused)) void CodeGenerator__gen_match(CodeGenerator *this, AST *node, i32 indent);
+static __attribute__((unused)) void CodeGenerator__gen_yield_expression(CodeGenerator *this, AST *expr, i32 indent);
+static __attribute__((unused)) void CodeGenerator__gen_statement(CodeGenerator *this, AST *node, i32 indent);
+static __attribute__((unused)) void CodeGenerator__gen_block(CodeGenerator *this, AST *node, i32 indent);
+static __attribute__((unused)) void CodeGenerator__gen_struct_decls(CodeGenerator *this, Program *program);
+static __attribute__((unused)) void string__replace(char **this, char *other);
+static __attribute__((unused)) char *CodeGenerator__get_type_name_string(CodeGenerator *this, Type *type, char *name, bool is_func_def);
+static __attribute__((unused)) void CodeGenerator__gen_type_and_name(CodeGenerator *this, Type *type, char *name);
+static __attribute__((unused)) void CodeGenerator__gen_type(CodeGenerator *this, Type *type);
+static __attribute__((unused)) char *CodeGenerator__get_function_name(CodeGenerator *this, Function *func);
+static __attribute__((unused)) void CodeGenerator__gen_function_decl(CodeGenerator *this, Function *func);
+static __attribute__((unused)) void CodeGenerator__gen_function_decls(CodeGenerator *this, Program *program);
+static __attribute__((unused)) void CodeGenerator__gen_generator_start(CodeGenerator *this, Function *func, i32 indent);
+static __attribute__((unused)) void CodeGenerator__gen_generator_next(CodeGenerator *this, Function *func, i32 indent);
+static __attribute__((unused)) void CodeGenerator__gen_function_body(CodeGenerator *this, Function *func, i32 indent);
+static __attribute__((unused)) void CodeGenerator__gen_function(CodeGenerator *this, Function *func);
+static __attribute__((unused)) void CodeGenerator__gen_profiling_table(CodeGenerator *this);
+static __attribute__((unused)) void CodeGenerator__gen_global_vars(CodeGenerator *this, Program *program);
+static __attribute__((unused)) void CodeGenerator__gen_constants(CodeGenerator *this, Program *program);
+static __attribute__((unused)) void CodeGenerator__gen_embed_headers(CodeGenerator *this, Program *program);
+static __attribute__((unused)) char *CodeGenerator__gen_program(CodeGenerator *this, Program *program);
+static __attribute__((unused)) void usage(i32 code);
+i32 main(i32 argc, char **argv);
+
+/* global variables */
+
+#line 421 "./compiler/ast.ae"
+AST *ast_chunk = NULL;
+
+#line 422 "./compiler/ast.ae"
+i32 ast_chunk_used = 0;
+
+
+#line 35 "./lib/prelude.ae"
+static __attribute__((unused)) FILE *File__open(char *path, char *mode) {
+
+#line 36 "./lib/prelude.ae"
+  FILE *file = fopen(path, mode);
+
+#line 37 "./lib/prelude.ae"
+  if ((!((bool)file))) {
+
+#line 38 "./lib/prelude.ae"
+    printf("Error opening file '%s': %s""\n", path, strerror(errno));
+
+#line 39 "./lib/prelude.ae"
+    exit(1);
+  } 
+
+#line 41 "./lib/prelude.ae"
+  return file;
+}
+
+
+#line 44 "./lib/prelude.ae"
+static __attribute__((unused)) bool File__exists(char *path) {
+
+#line 45 "./lib/prelude.ae"
+  FILE *file = fopen(path, "r");
+
+#line 46 "./lib/prelude.ae"
+  if ((!((bool)file))) {
+
+#line 47 "./lib/prelude.ae"
+    return false;
+  } 
+
+#line 49 "./lib/prelude.ae"
+  fclose(file);
+
+#line 50 "./lib/prelude.ae"
+  return true;
+}
+
+
+#line 53 "./lib/prelude.ae"
+static __attribute__((unused)) i32 File__size(FILE *this) {
+
+#line 54 "./lib/prelude.ae"
+  i32 pos = ftell(this);
+
+#line 55 "./lib/prelude.ae"
+  fseek(this, 0, SEEK_END);
+
+#line 56 "./lib/prelude.ae"
+  i32 size = ftell(this);
+
+#line 57 "./lib/prelude.ae"
+  fseek(this, pos, SEEK_SET);
+
+#line 58 "./lib/prelude.ae"
+  return size;
+}
+
+
+#line 61 "./lib/prelude.ae"
+static __attribute__((unused)) char *File__slurp(FILE *this) {
+
+#line 62 "./lib/prelude.ae"
+  i32 pos = ftell(this);
+
+#line 63 "./lib/prelude.ae"
+  fseek(this, 0, SEEK_END);
+
+#line 64 "./lib/prelude.ae"
+  i32 size = ftell(this);
+
+#line 65 "./lib/prelude.ae"
+  fseek(this, pos, SEEK_SET);
+
+#line 66 "./lib/prelude.ae"
+  void *buf = calloc((size + 1), sizeof(char));
+
+#line 67 "./lib/prelude.ae"
+  fread(buf, 1, size, this);
+
+#line 68 "./lib/prelude.ae"
+  fseek(this, pos, SEEK_SET);
+
+#line 69 "./lib/prelude.ae"
+  return ((char *)buf);
+}
+
+
+#line 72 "./lib/prelude.ae"
+static __attribute__((unused)) i32 File__read(FILE *this, void *buf, i32 size) {
+
+#line 73 "./lib/prelude.ae"
+  return fread(buf, 1, size, this);
+}
+
+
+#line 76 "./lib/prelude.ae"
+static __attribute__((unused)) i32 File__write(FILE *this, void *buf, i32 size) {
+
+#line 77 "./lib/prelude.ae"
+  return fwrite(buf, 1, size, this);
+}
+
+
+#line 80 "./lib/prelude.ae"
+static __attribute__((unused)) void File__puts(FILE *this, char *str) {
+
+#line 81 "./lib/prelude.ae"
+  fwrite(str, 1, strlen(str), this);
+}
+
+
+#line 88 "./lib/prelude.ae"
+static __attribute__((unused)) __attribute__((noreturn)) __attribute__((cold)) void panic(char *msg) {
+
+#line 89 "./lib/prelude.ae"
+  printf("%s""\n", msg);
+
+#line 90 "./lib/prelude.ae"
+  aecor_stdout_flush();
+
+#line 91 "./lib/prelude.ae"
+  exit(1);
+}
+
+
+#line 106 "./lib/prelude.ae"
+static __attribute__((unused)) bool string__starts_with(char *this, char *prefix) {
+
+#line 107 "./lib/prelude.ae"
+  i32 prefix_len = strlen(prefix);
+
+#line 108 "./lib/prelude.ae"
+  if ((strlen(this) < prefix_len)) {
+
+#line 109 "./lib/prelude.ae"
+    return false;
+  } 
+
+#line 111 "./lib/prelude.ae"
+  return strncmp(this, prefix, prefix_len) == 0;
+}
+
+
+#line 114 "./lib/prelude.ae"
+static __attribute__((unused)) bool string__ends_with(char *this, char *suffix) {
+
+#line 115 "./lib/prelude.ae"
+  i32 suffix_len = strlen(suffix);
+
+#line 116 "./lib/prelude.ae"
+  if ((strlen(this) < suffix_len)) {
+
+#line 117 "./lib/prelude.ae"
+    return false;
+  } 
+
+#line 119 "./lib/prelude.ae"
+  return strncmp(this, suffix, suffix_len) == 0;
+}
+
+
+#line 122 "./lib/prelude.ae"
+static __attribute__((unused)) void string__remove_last_n(char *this, i32 n) {
+
+#line 123 "./lib/prelude.ae"
+  this[(strlen(this) - n)] = '\0';
+}
+
+
+#line 126 "./lib/prelude.ae"
+static __attribute__((unused)) bool string__eq(char *this, char *str2) {
+
+#line 126 "./lib/prelude.ae"
+  return strcmp(this, str2) == 0;
+}
+
+
+#line 128 "./lib/prelude.ae"
+static __attribute__((unused)) char *string__substring(char *this, i32 start, i32 len) {
+
+#line 129 "./lib/prelude.ae"
+  char *new_str = ((char *)calloc((len + 1), sizeof(char)));
+
+#line 130 "./lib/prelude.ae"
+  memcpy(new_str, (this + start), len);
+
+#line 131 "./lib/prelude.ae"
+  return new_str;
+}
+
+
+#line 134 "./lib/prelude.ae"
+static __attribute__((unused)) void string__strip_trailing_whitespace(char *this) {
+
+#line 135 "./lib/prelude.ae"
+  for (i32 i = (strlen(this) - 1); (i >= 0); i -= 1) {
+
+#line 136 "./lib/prelude.ae"
+    if ((this[i] != ' ')) 
+
+#line 136 "./lib/prelude.ae"
+    break;
+    
+
+#line 137 "./lib/prelude.ae"
+    this[i] = '\0';
+  } 
+}
+
+
+#line 150 "./lib/prelude.ae"
+static __attribute__((unused)) i32 min(i32 a, i32 b) {
+
+#line 150 "./lib/prelude.ae"
+  return ((a < b) ? a : b);
+}
+
+
+#line 151 "./lib/prelude.ae"
+static __attribute__((unused)) i32 max(i32 a, i32 b) {
+
+#line 151 "./lib/prelude.ae"
+  return ((a > b) ? a : b);
+}
+
+
+#line 24 "./lib/vector.ae"
+static inline __attribute__((unused)) __attribute__((always_inline)) void **Vector__inline_data(Vector *this) {
+
+#line 25 "./lib/vector.ae"
+  return ((void **)(((u8 *)this) + sizeof(Vector)));
+}
+
+
+#line 28 "./lib/vector.ae"
+static __attribute__((unused)) Vector *Vector__new_sized(i32 capacity) {
+
+#line 29 "./lib/vector.ae"
+  if ((capacity <= VECTOR_MAX_INLINE_CAPACITY)) {
+
+#line 30 "./lib/vector.ae"
+    Vector *vec = ((Vector *)calloc(1, (sizeof(Vector) + (capacity * sizeof(void *)))));
+
+#line 31 "./lib/vector.ae"
+    vec->capacity = capacity;
+
+#line 33 "./lib/vector.ae"
+    if ((capacity > 0)) {
+
+#line 34 "./lib/vector.ae"
+      vec->data = Vector__inline_data(vec);
+
+#line 35 "./lib/vector.ae"
+      vec->is_inline = true;
+    } 
+
+#line 37 "./lib/vector.ae"
+    return vec;
+  } 
+
+#line 39 "./lib/vector.ae"
+  Vector *vec = ((Vector *)calloc(1, sizeof(Vector)));
+
+#line 40 "./lib/vector.ae"
+  vec->size = 0;
+
+#line 41 "./lib/vector.ae"
+  vec->capacity = capacity;
+
+#line 42 "./lib/vector.ae"
+  vec->data = ((void **)calloc(vec->capacity, sizeof(void *)));
+
+#line 43 "./lib/vector.ae"
+  return vec;
+}
+
+
+#line 46 "./lib/vector.ae"
+static __attribute__((unused)) Vector *Vector__new(void) {
+
+#line 46 "./lib/vector.ae"
+  return Vector__new_sized(VECTOR_INLINE_CAPACITY);
+}
+
+
+#line 48 "./lib/vector.ae"
+static __attribute__((unused)) void Vector__resize(Vector *this, i32 new_capacity) {
+
+#line 49 "./lib/vector.ae"
+  if (this->is_inline) {
+
+#line 50 "./lib/vector.ae"
+    void **data = ((void **)malloc((new_capacity * sizeof(void *))));
+
+#line 51 "./lib/vector.ae"
+    memcpy(data, this->data, (this->size * sizeof(void *)));
+
+#line 52 "./lib/vector.ae"
+    this->data = data;
+
+#line 53 "./lib/vector.ae"
+    this->is_inline = false;
+  }  else {
+
+#line 55 "./lib/vector.ae"
+    this->data = ((void **)realloc(this->data, (new_capacity * sizeof(void *))));
+  } 
+
+#line 57 "./lib/vector.ae"
+  this->capacity = new_capacity;
+}
+
+
+#line 61 "./lib/vector.ae"
+static inline __attribute__((unused)) __attribute__((always_inline)) i32 Vector__next_capacity(Vector *this) {
+
+#line 61 "./lib/vector.ae"
+  return max((this->capacity * 2), VECTOR_INLINE_CAPACITY);
+}
+
+
+#line 63 "./lib/vector.ae"
+static inline __attribute__((unused)) __attribute__((always_inline)) void Vector__push(Vector *this, void *val) {
+
+#line 64 "./lib/vector.ae"
+  if (this->size == this->capacity) {
+
+#line 65 "./lib/vector.ae"
+    Vector__resize(this, Vector__next_capacity(this));
+  } 
+
+#line 67 "./lib/vector.ae"
+  this->data[this->size] = val;
+
+#line 68 "./lib/vector.ae"
+  this->size += 1;
+}
+
+
+#line 72 "./lib/vector.ae"
+static __attribute__((unused)) void Vector__push_front(Vector *this, void *val) {
+
+#line 73 "./lib/vector.ae"
+  if (this->size == this->capacity) {
+
+#line 74 "./lib/vector.ae"
+    Vector__resize(this, Vector__next_capacity(this));
+  } 
+
+#line 76 "./lib/vector.ae"
+  memmove((this->data + 1), this->data, (this->size * sizeof(void *)));
+
+#line 77 "./lib/vector.ae"
+  this->data[0] = val;
+
+#line 78 "./lib/vector.ae"
+  this->size += 1;
+}
+
+
+#line 81 "./lib/vector.ae"
+static __attribute__((unused)) void *Vector__pop(Vector *this) {
+
+#line 82 "./lib/vector.ae"
+  (__builtin_expect(!!((this->size > 0)), 1) ? (void)0 : panic("pop on empty vector"));
+
+#line 83 "./lib/vector.ae"
+  this->size -= 1;
+
+#line 84 "./lib/vector.ae"
+  return this->data[this->size];
+}
+
+
+#line 87 "./lib/vector.ae"
+static inline __attribute__((unused)) __attribute__((always_inline)) void *Vector__back(Vector *this) {
+
+#line 88 "./lib/vector.ae"
+  (__builtin_expect(!!((this->size > 0)), 1) ? (void)0 : panic("back on empty vector"));
+
+#line 89 "./lib/vector.ae"
+  return this->data[(this->size - 1)];
+}
+
+
+#line 92 "./lib/vector.ae"
+static inline __attribute__((unused)) __attribute__((always_inline)) void *Vector__at(Vector *this, i32 i) {
+
+#line 93 "./lib/vector.ae"
+  (__builtin_expect(!!(((i >= 0) && (i < this->size))), 1) ? (void)0 : panic("at out of bounds in vector"));
+
+#line 94 "./lib/vector.ae"
+  return this->data[i];
+}
+
+
+#line 97 "./lib/vector.ae"
+static inline __attribute__((unused)) __attribute__((always_inline)) bool Vector__empty(Vector *this) {
+
+#line 97 "./lib/vector.ae"
+  return this->size == 0;
+}
+
+
+#line 99 "./lib/vector.ae"
+static __attribute__((unused)) void Vector__free(Vector *this) {
+
+#line 100 "./lib/vector.ae"
+  if ((!this->is_inline)) 
+
+#line 100 "./lib/vector.ae"
+  free(this->data);
+  
+
+#line 101 "./lib/vector.ae"
+  free(this);
+}
+
+
+#line 9 "./lib/span.ae"
+static __attribute__((unused)) char *Location__str(Location this) {
+
+#line 9 "./lib/span.ae"
+  return format_string("%s:%d:%d", this.filename, this.line, this.col);
+}
+
+
+#line 11 "./lib/span.ae"
+static __attribute__((unused)) bool Location__is_before(Location *this, Location other) {
+
+#line 12 "./lib/span.ae"
+  if ((this->line > other.line)) 
+
+#line 12 "./lib/span.ae"
+  return false;
+  
+
+#line 13 "./lib/span.ae"
+  if ((this->line < other.line)) 
+
+#line 13 "./lib/span.ae"
+  return true;
+  
+
+#line 14 "./lib/span.ae"
+  return (this->col <= other.col);
+}
+
+
+#line 22 "./lib/span.ae"
+static __attribute__((unused)) char *Span__str(const Span *this) {
+
+#line 22 "./lib/span.ae"
+  return format_string("%s => %s", Location__str((*this).start), Location__str((*this).end));
+}
+
+
+#line 24 "./lib/span.ae"
+static __attribute__((unused)) Span Span__default(void) {
+
+#line 25 "./lib/span.ae"
+  Span span = {0};
+
+#line 26 "./lib/span.ae"
+  span.start = (Location){.filename = "<default>", .line = 0, .col = 0};
+
+#line 27 "./lib/span.ae"
+  span.end = (Location){.filename = "<default>", .line = 0, .col = 0};
+
+#line 28 "./lib/span.ae"
+  return span;
+}
+
+
+#line 32 "./lib/span.ae"
+static __attribute__((unused)) Span Span__join(const Span *this, const Span *other) {
+
+#line 33 "./lib/span.ae"
+  Span span = {0};
+
+#line 34 "./lib/span.ae"
+  span.start = (*this).start;
+
+#line 35 "./lib/span.ae"
+  span.end = (*other).end;
+
+#line 36 "./lib/span.ae"
+  return span;
+}
+
+
+#line 39 "./lib/span.ae"
+static __attribute__((unused)) bool Span__contains_loc(Span this, Location loc) {
+
+#line 40 "./lib/span.ae"
+  if ((!string__eq(this.start.filename, loc.filename))) 
+
+#line 40 "./lib/span.ae"
+  return false;
+  
+
+#line 41 "./lib/span.ae"
+  return (Location__is_before((&this.start), loc) && Location__is_before((&loc), this.end));
+}
+
+
+#line 12 "./compiler/tokens.ae"
+static __attribute__((unused)) Token *Token__new(TokenType type, Span span, char *text) {
+
+#line 13 "./compiler/tokens.ae"
+  Token *tok = ((Token *)calloc(1, sizeof(Token)));
+
+#line 14 "./compiler/tokens.ae"
+  (*tok) = (Token){.type = type, .span = span, .text = text, .suffix = NULL, .seen_newline = false};
+
+#line 15 "./compiler/tokens.ae"
+  return tok;
+}
+
+
+#line 18 "./compiler/tokens.ae"
+static __attribute__((unused)) Token *Token__from_type(TokenType type, Span span) {
+
+#line 18 "./compiler/tokens.ae"
+  return Token__new(type, span, "");
+}
+
+
+#line 20 "./compiler/tokens.ae"
+static __attribute__((unused)) Token *Token__from_ident(char *text, Span span) {
+
+#line 21 "./compiler/tokens.ae"
+  TokenType type = TokenType__from_text(text);
+
+#line 22 "./compiler/tokens.ae"
+  return Token__new(type, span, text);
+}
+
+
+#line 25 "./compiler/tokens.ae"
+static __attribute__((unused)) char *Token__str(Token *this) {
+
+#line 25 "./compiler/tokens.ae"
+  return format_string("%s: %s", Span__str(&this->span), TokenType__str(this->type));
+}
+
+
+#line 124 "./compiler/tokens.ae"
+static __attribute__((unused)) TokenType TokenType__from_text(char *text) {
+
+#line 124 "./compiler/tokens.ae"
+  return ({ TokenType __yield_0;
+
+#line 124 "./compiler/tokens.ae"
+  {
+    char *__match_str = text;
+    switch (aecor_hash_str(__match_str, 2166136261u)) {
+      case 1305964296u:
+        if (!strcmp(__match_str, "and")) goto __match_0_0;
+        break;
+      case 106731536u:
+        if (!strcmp(__match_str, "as")) goto __match_0_1;
+        break;
+      case 2869110635u:
+        if (!strcmp(__match_str, "bool")) goto __match_0_2;
+        break;
+      case 1349183411u:
+        if (!strcmp(__match_str, "break")) goto __match_0_3;
+        break;
+      case 3477080843u:
+        if (!strcmp(__match_str, "char")) goto __match_0_4;
+        break;
+      case 2245205078u:
+        if (!strcmp(__match_str, "const")) goto __match_0_5;
+        break;
+      case 3663126513u:
+        if (!strcmp(__match_str, "continue")) goto __match_0_6;
+        break;
+      case 832636142u:
+        if (!strcmp(__match_str, "def")) goto __match_0_7;
+        break;
+      case 2838665391u:
+        if (!strcmp(__match_str, "defer")) goto __match_0_8;
+        break;
+      case 642373404u:
+        if (!strcmp(__match_str, "else")) goto __match_0_9;
+        break;
+      case 1633607337u:
+        if (!strcmp(__match_str, "enum")) goto __match_0_10;
+        break;
+      case 594816953u:
+        if (!strcmp(__match_str, "extern")) goto __match_0_11;
+        break;
+      case 4275523303u:
+        if (!strcmp(__match_str, "false")) goto __match_0_12;
+        break;
+      case 859369167u:
+        if (!strcmp(__match_str, "f32")) goto __match_0_13;
+        break;
+      case 861975295u:
+        if (!strcmp(__match_str, "f64")) goto __match_0_14;
+        break;
+      case 3121374858u:
+        if (!strcmp(__match_str, "for")) goto __match_0_15;
+        break;
+      case 283012692u:
+        if (!strcmp(__match_str, "fn")) goto __match_0_16;
+        break;
+      case 1074601716u:
+        if (!strcmp(__match_str, "i8")) goto __match_0_17;
+        break;
+      case 833762287u:
+        if (!strcmp(__match_str, "i16")) goto __match_0_18;
+        break;
+      case 918736459u:
+        if (!strcmp(__match_str, "i32")) goto __match_0_19;
+        break;
+      case 3966529125u:
+        if (!strcmp(__match_str, "i64")) goto __match_0_20;
+        break;
+      case 2551052472u:
+        if (!strcmp(__match_str, "if")) goto __match_0_21;
+        break;
+      case 950579197u:
+        if (!strcmp(__match_str, "let")) goto __match_0_22;
+        break;
+      case 2717393236u:
+        if (!strcmp(__match_str, "match")) goto __match_0_23;
+        break;
+      case 1957039169u:
+        if (!strcmp(__match_str, "not")) goto __match_0_24;
+        break;
+      case 2827039351u:
+        if (!strcmp(__match_str, "null")) goto __match_0_25;
+        break;
+      case 2654982702u:
+        if (!strcmp(__match_str, "or")) goto __match_0_26;
+        break;
+      case 4108485794u:
+        if (!strcmp(__match_str, "return")) goto __match_0_27;
+        break;
+      case 3474485403u:
+        if (!strcmp(__match_str, "scratch")) goto __match_0_28;
+        break;
+      case 2850059673u:
+        if (!strcmp(__match_str, "sizeof")) goto __match_0_29;
+        break;
+      case 930201698u:
+        if (!strcmp(__match_str, "string")) goto __match_0_30;
+        break;
+      case 289050604u:
+        if (!strcmp(__match_str, "struct")) goto __match_0_31;
+        break;
+      case 1715307617u:
+        if (!strcmp(__match_str, "true")) goto __match_0_32;
+        break;
+      case 3201516176u:
+        if (!strcmp(__match_str, "then")) goto __match_0_33;
+        break;
+      case 3926084466u:
+        if (!strcmp(__match_str, "u8")) goto __match_0_34;
+        break;
+      case 4148185419u:
+        if (!strcmp(__match_str, "u16")) goto __match_0_35;
+        break;
+      case 1849896378u:
+        if (!strcmp(__match_str, "u32")) goto __match_0_36;
+        break;
+      case 2500781617u:
+        if (!strcmp(__match_str, "u64")) goto __match_0_37;
+        break;
+      case 4025494924u:
+        if (!strcmp(__match_str, "untyped_ptr")) goto __match_0_38;
+        break;
+      case 3495413904u:
+        if (!strcmp(__match_str, "union")) goto __match_0_39;
+        break;
+      case 621625292u:
+        if (!strcmp(__match_str, "use")) goto __match_0_40;
+        break;
+      case 2454924575u:
+        if (!strcmp(__match_str, "void")) goto __match_0_41;
+        break;
+      case 317341496u:
+        if (!strcmp(__match_str, "yield")) goto __match_0_42;
+        break;
+      case 4040919573u:
+        if (!strcmp(__match_str, "while")) goto __match_0_43;
+        break;
+    }
+    goto __match_0_default;
+    __match_0_0: {
+      __yield_0 = TokenType__And;
+} goto __match_0_end;
+    __match_0_1: {
+      __yield_0 = TokenType__As;
+} goto __match_0_end;
+    __match_0_2: {
+      __yield_0 = TokenType__Bool;
+} goto __match_0_end;
+    __match_0_3: {
+      __yield_0 = TokenType__Break;
+} goto __match_0_end;
+    __match_0_4: {
+      __yield_0 = TokenType__Char;
+} goto __match_0_end;
+    __match_0_5: {
+      __yield_0 = TokenType__Const;
+} goto __match_0_end;
+    __match_0_6: {
+      __yield_0 = TokenType__Continue;
+} goto __match_0_end;
+    __match_0_7: {
+      __yield_0 = TokenType__Def;
+} goto __match_0_end;
+    __match_0_8: {
+      __yield_0 = TokenType__Defer;
+} goto __match_0_end;
+    __match_0_9: {
+      __yield_0 = TokenType__Else;
+} goto __match_0_end;
+    __match_0_10: {
+      __yield_0 = TokenType__Enum;
+} goto __match_0_end;
+    __match_0_11: {
+      __yield_0 = TokenType__Extern;
+} goto __match_0_end;
+    __match_0_12: {
+      __yield_0 = TokenType__False;
+} goto __match_0_end;
+    __match_0_13: {
+      __yield_0 = TokenType__F32;
+} goto __match_0_end;
+    __match_0_14: {
+      __yield_0 = TokenType__F64;
+} goto __match_0_end;
+    __match_0_15: {
+      __yield_0 = TokenType__For;
+} goto __match_0_end;
+    __match_0_16: {
+      __yield_0 = TokenType__Fn;
+} goto __match_0_end;
+    __match_0_17: {
+      __yield_0 = TokenType__I8;
+} goto __match_0_end;
+    __match_0_18: {
+      __yield_0 = TokenType__I16;
+} goto __match_0_end;
+    __match_0_19: {
+      __yield_0 = TokenType__I32;
+} goto __match_0_end;
+    __match_0_20: {
+      __yield_0 = TokenType__I64;
+} goto __match_0_end;
+    __match_0_21: {
+      __yield_0 = TokenType__If;
+} goto __match_0_end;
+    __match_0_22: {
+      __yield_0 = TokenType__Let;
+} goto __match_0_end;
+    __match_0_23: {
+      __yield_0 = TokenType__Match;
+} goto __match_0_end;
+    __match_0_24: {
+      __yield_0 = TokenType__Not;
+} goto __match_0_end;
+    __match_0_25: {
+      __yield_0 = TokenType__Null;
+} goto __match_0_end;
+    __match_0_26: {
+      __yield_0 = TokenType__Or;
+} goto __match_0_end;
+    __match_0_27: {
+      __yield_0 = TokenType__Return;
+} goto __match_0_end;
+    __match_0_28: {
+      __yield_0 = TokenType__Scratch;
+} goto __match_0_end;
+    __match_0_29: {
+      __yield_0 = TokenType__SizeOf;
+} goto __match_0_end;
+    __match_0_30: {
+      __yield_0 = TokenType__String;
+} goto __match_0_end;
+    __match_0_31: {
+      __yield_0 = TokenType__Struct;
+} goto __match_0_end;
+    __match_0_32: {
+      __yield_0 = TokenType__True;
+} goto __match_0_end;
+    __match_0_33: {
+      __yield_0 = TokenType__Then;
+} goto __match_0_end;
+    __match_0_34: {
+      __yield_0 = TokenType__U8;
+} goto __match_0_end;
+    __match_0_35: {
+      __yield_0 = TokenType__U16;
+} goto __match_0_end;
+    __match_0_36: {
+      __yield_0 = TokenType__U32;
+} goto __match_0_end;
+    __match_0_37: {
+      __yield_0 = TokenType__U64;
+} goto __match_0_end;
+    __match_0_38: {
+      __yield_0 = TokenType__UntypedPtr;
+} goto __match_0_end;
+    __match_0_39: {
+      __yield_0 = TokenType__Union;
+} goto __match_0_end;
+    __match_0_40: {
+      __yield_0 = TokenType__Use;
+} goto __match_0_end;
+    __match_0_41: {
+      __yield_0 = TokenType__Void;
+} goto __match_0_end;
+    __match_0_42: {
+      __yield_0 = TokenType__Yield;
+} goto __match_0_end;
+    __match_0_43: {
+      __yield_0 = TokenType__While;
+} goto __match_0_end;
+    __match_0_default: {
+      __yield_0 = TokenType__Identifier;
+}
+    __match_0_end:;
+  }
+;__yield_0; });
+}
+
+
+#line 172 "./compiler/tokens.ae"
+static __attribute__((unused)) char *TokenType__str(TokenType this) {
+
+#line 172 "./compiler/tokens.ae"
+  return ({ char *__yield_0;
+
+#line 172 "./compiler/tokens.ae"
+  switch (this) {
+    case TokenType__And: {
+      __yield_0 = "and";
+} break;
+    case TokenType__As: {
+      __yield_0 = "as";
+} break;
+    case TokenType__Bool: {
+      __yield_0 = "bool";
+} break;
+    case TokenType__Break: {
+      __yield_0 = "break";
+} break;
+    case TokenType__Char: {
+      __yield_0 = "char";
+} break;
+    case TokenType__Const: {
+      __yield_0 = "const";
+} break;
+    case TokenType__Continue: {
+      __yield_0 = "continue";
+} break;
+    case TokenType__Def: {
+      __yield_0 = "def";
+} break;
+    case TokenType__Defer: {
+      __yield_0 = "defer";
+} break;
+    case TokenType__Else: {
+      __yield_0 = "else";
+} break;
+    case TokenType__Enum: {
+      __yield_0 = "enum";
+} break;
+    case TokenType__Extern: {
+      __yield_0 = "extern";
+} break;
+    case TokenType__False: {
+      __yield_0 = "false";
+} break;
+    case TokenType__F32: {
+      __yield_0 = "f32";
+} break;
+    case TokenType__F64: {
+      __yield_0 = "f64";
+} break;
+    case TokenType__For: {
+      __yield_0 = "for";
+} break;
+    case TokenType__Fn: {
+      __yield_0 = "fn";
+} break;
+    case TokenType__I8: {
+      __yield_0 = "i8";
+} break;
+    case TokenType__I16: {
+      __yield_0 = "i16";
+} break;
+    case TokenType__I32: {
+      __yield_0 = "i32";
+} break;
+    case TokenType__I64: {
+      __yield_0 = "i64";
+} break;
+    case TokenType__If: {
+      __yield_0 = "if";
+} break;
+    case TokenType__Let: {
+      __yield_0 = "let";
+} break;
+    case TokenType__Match: {
+      __yield_0 = "match";
+} break;
+    case TokenType__Not: {
+      __yield_0 = "not";
+} break;
+    case TokenType__Null: {
+      __yield_0 = "null";
+} break;
+    case TokenType__Or: {
+      __yield_0 = "or";
+} break;
+    case TokenType__Return: {
+      __yield_0 = "return";
+} break;
+    case TokenType__Scratch: {
+      __yield_0 = "scratch";
+} break;
+    case TokenType__SizeOf: {
+      __yield_0 = "sizeof";
+} break;
+    case TokenType__String: {
+      __yield_0 = "string";
+} break;
+    case TokenType__Struct: {
+      __yield_0 = "struct";
+} break;
+    case TokenType__True: {
+      __yield_0 = "true";
+} break;
+    case TokenType__Then: {
+      __yield_0 = "then";
+} break;
+    case TokenType__U8: {
+      __yield_0 = "u8";
+} break;
+    case TokenType__U16: {
+      __yield_0 = "u16";
+} break;
+    case TokenType__U32: {
+      __yield_0 = "u32";
+} break;
+    case TokenType__U64: {
+      __yield_0 = "u64";
+} break;
+    case TokenType__UntypedPtr: {
+      __yield_0 = "untyped_ptr";
+} break;
+    case TokenType__Union: {
+      __yield_0 = "union";
+} break;
+    case TokenType__Use: {
+      __yield_0 = "use";
+} break;
+    case TokenType__Void: {
+      __yield_0 = "void";
+} break;
+    case TokenType__Yield: {
+      __yield_0 = "yield";
+} break;
+    case TokenType__While: {
+      __yield_0 = "while";
+} break;
+    default: {
+      __yield_0 = TokenType__dbg(this);
+} break;
+  }
+;__yield_0; });
+}
+
+
+#line 12 "./lib/math.ae"
+static __attribute__((unused)) f32 minf(f32 a, f32 b) {
+
+#line 12 "./lib/math.ae"
+  if ((a < b)) 
+
+#line 12 "./lib/math.ae"
+  return a;
+   else 
+
+#line 12 "./lib/math.ae"
+  return b;
+  
+}
+
+
+#line 13 "./lib/math.ae"
+static __attribute__((unused)) f32 maxf(f32 a, f32 b) {
+
+#line 13 "./lib/math.ae"
+  if ((a > b)) 
+
+#line 13 "./lib/math.ae"
+  return a;
+   else 
+
+#line 13 "./lib/math.ae"
+  return b;
+  
+}
+
+
+#line 15 "./lib/math.ae"
+static __attribute__((unused)) f32 clampf(f32 x, f32 min, f32 max) {
+
+#line 15 "./lib/math.ae"
+  return maxf(minf(x, max), min);
+}
+
+
+#line 16 "./lib/math.ae"
+static __attribute__((unused)) f32 clamp01(f32 x) {
+
+#line 16 "./lib/math.ae"
+  return clampf(x, 0.0, 1.0);
+}
+
+
+#line 19 "./lib/math.ae"
+static __attribute__((unused)) f32 degrees(f32 radians) {
+
+#line 19 "./lib/math.ae"
+  return ((radians * 180.0) / M_PI);
+}
+
+
+#line 20 "./lib/math.ae"
+static __attribute__((unused)) f32 radians(f32 degrees) {
+
+#line 20 "./lib/math.ae"
+  return ((degrees * M_PI) / 180.0);
+}
+
+
+#line 7 "./compiler/utils.ae"
+static __attribute__((unused)) i32 edit_distance(char *str1, char *str2) {
+
+#line 8 "./compiler/utils.ae"
+  i32 n = strlen(str1);
+
+#line 9 "./compiler/utils.ae"
+  i32 m = strlen(str2);
+
+#line 10 "./compiler/utils.ae"
+  i32 stride = (m + 1);
+
+#line 13 "./compiler/utils.ae"
+  i32 d[(n + 1)][(m + 1)];
+
+#line 15 "./compiler/utils.ae"
+  for (i32 i = 0; (i <= n); i += 1) {
+
+#line 16 "./compiler/utils.ae"
+    d[i][0] = i;
+  } 
+
+#line 18 "./compiler/utils.ae"
+  for (i32 j = 0; (j <= m); j += 1) {
+
+#line 19 "./compiler/utils.ae"
+    d[0][j] = j;
+  } 
+
+#line 21 "./compiler/utils.ae"
+  for (i32 i = 1; (i <= n); i += 1) {
+
+#line 22 "./compiler/utils.ae"
+    for (i32 j = 1; (j <= m); j += 1) {
+
+#line 23 "./compiler/utils.ae"
+      i32 x = (d[(i - 1)][j] + 1);
+
+#line 24 "./compiler/utils.ae"
+      i32 y = (d[i][(j - 1)] + 1);
+
+#line 25 "./compiler/utils.ae"
+      i32 z;
+
+#line 26 "./compiler/utils.ae"
+      if (str1[(i - 1)] == str2[(j - 1)]) {
+
+#line 27 "./compiler/utils.ae"
+        z = d[(i - 1)][(j - 1)];
+      }  else {
+
+#line 29 "./compiler/utils.ae"
+        z = (d[(i - 1)][(j - 1)] + 1);
+      } 
+
+#line 31 "./compiler/utils.ae"
+      d[i][j] = min(x, min(y, z));
+    } 
+  } 
+
+#line 34 "./compiler/utils.ae"
+  i32 result = d[n][m];
+
+#line 35 "./compiler/utils.ae"
+  return result;
+}
+
+
+#line 38 "./compiler/utils.ae"
+static __attribute__((unused)) char *find_word_suggestion(char *s, Vector *options) {
+
+#line 39 "./compiler/utils.ae"
+  i32 threshold = 5;
+
+#line 41 "./compiler/utils.ae"
+  if (options->size == 0) 
+
+#line 41 "./compiler/utils.ae"
+  return NULL;
+  
+
+#line 43 "./compiler/utils.ae"
+  char *closest = ((char *)Vector__at(options, 0));
+
+#line 44 "./compiler/utils.ae"
+  i32 closest_distance = edit_distance(s, closest);
+
+#line 46 "./compiler/utils.ae"
+  for (i32 i = 1; (i < options->size); i += 1) {
+
+#line 47 "./compiler/utils.ae"
+    char *option = ((char *)Vector__at(options, i));
+
+#line 48 "./compiler/utils.ae"
+    i32 distance = edit_distance(s, option);
+
+#line 49 "./compiler/utils.ae"
+    if ((distance < closest_distance)) {
+
+#line 50 "./compiler/utils.ae"
+      closest = option;
+
+#line 51 "./compiler/utils.ae"
+      closest_distance = distance;
+    } 
+  } 
+
+#line 54 "./compiler/utils.ae"
+  if ((closest_distance > threshold)) 
+
+#line 54 "./compiler/utils.ae"
+  return NULL;
+  
+
+#line 55 "./compiler/utils.ae"
+  return closest;
+}
+
+
+#line 60 "./compiler/utils.ae"
+static __attribute__((unused)) u32 hash_string(char *s, u32 seed) {
+
+#line 61 "./compiler/utils.ae"
+  u32 hash = seed;
+
+#line 62 "./compiler/utils.ae"
+  i32 len = strlen(s);
+
+#line 63 "./compiler/utils.ae"
+  for (i32 i = 0; (i < len); i += 1) {
+
+#line 64 "./compiler/utils.ae"
+    hash = ((hash ^ ((u32)((u8)s[i]))) * 16777619);
+  } 
+
+#line 66 "./compiler/utils.ae"
+  hash = ((hash ^ (hash >> 16)) * 0x85ebca6b);
+
+#line 67 "./compiler/utils.ae"
+  hash = ((hash ^ (hash >> 13)) * 0xc2b2ae35);
+
+#line 68 "./compiler/utils.ae"
+  return (hash ^ (hash >> 16));
+}
+
+
+#line 11 "./compiler/errors.ae"
+static __attribute__((unused)) char *ErrorType__str(ErrorType this) {
+
+#line 11 "./compiler/errors.ae"
+  return ({ char *__yield_0;
+
+#line 11 "./compiler/errors.ae"
+  switch (this) {
+    case ErrorType__Standard: {
+      __yield_0 = "Standard";
+} break;
+    case ErrorType__WithNote: {
+      __yield_0 = "WithNote";
+} break;
+    case ErrorType__WithHint: {
+      __yield_0 = "WithHint";
+} break;
+  }
+;__yield_0; });
+}
+
+
+#line 31 "./compiler/errors.ae"
+static __attribute__((unused)) char *MessageType__to_color(MessageType this) {
+
+#line 31 "./compiler/errors.ae"
+  return ({ char *__yield_0;
+
+#line 31 "./compiler/errors.ae"
+  switch (this) {
+    case MessageType__Error: {
+      __yield_0 = "\x1b[31m";
+} break;
+    case MessageType__Warning: {
+      __yield_0 = "\x1b[33m";
+} break;
+    case MessageType__Note: {
+      __yield_0 = "\x1b[32m";
+} break;
+  }
+;__yield_0; });
+}
+
+
+#line 37 "./compiler/errors.ae"
+static __attribute__((unused)) char *MessageType__str(MessageType this) {
+
+#line 37 "./compiler/errors.ae"
+  return ({ char *__yield_0;
+
+#line 37 "./compiler/errors.ae"
+  switch (this) {
+    case MessageType__Error: {
+      __yield_0 = "Error";
+} break;
+    case MessageType__Warning: {
+      __yield_0 = "Warning";
+} break;
+    case MessageType__Note: {
+      __yield_0 = "Note";
+} break;
+  }
+;__yield_0; });
+}
+
+
+#line 43 "./compiler/errors.ae"
+static __attribute__((unused)) void display_line(void) {
+
+#line 44 "./compiler/errors.ae"
+  printf("--------------------------------------------------------------------------------""\n");
+}
+
+
+#line 47 "./compiler/errors.ae"
+static __attribute__((unused)) void display_message(MessageType type, const Span *span, char *msg) {
+
+#line 48 "./compiler/errors.ae"
+  display_line();
+
+#line 49 "./compiler/errors.ae"
+  printf("%s: %s: %s""\n", Location__str((*span).start), MessageType__str(type), msg);
+
+#line 50 "./compiler/errors.ae"
+  display_line();
+}
+
+
+#line 53 "./compiler/errors.ae"
+static __attribute__((unused)) void display_message_span(MessageType type, Span span, char *msg) {
+
+#line 54 "./compiler/errors.ae"
+  char *color = MessageType__to_color(type);
+
+#line 55 "./compiler/errors.ae"
+  char *reset = "\x1b[0m";
+
+#line 57 "./compiler/errors.ae"
+  char *filename = span.start.filename;
+
+#line 58 "./compiler/errors.ae"
+  FILE *file = File__open(filename, "r");
+
+#line 59 "./compiler/errors.ae"
+  ;
+
+#line 61 "./compiler/errors.ae"
+  char *contents = File__slurp(file);
+
+#line 62 "./compiler/errors.ae"
+  ;
+
+#line 64 "./compiler/errors.ae"
+  i32 around_offset = 1;
+
+#line 65 "./compiler/errors.ae"
+  i32 min_line = max((span.start.line - around_offset), 1);
+
+#line 66 "./compiler/errors.ae"
+  i32 max_line = (span.end.line + around_offset);
+
+#line 68 "./compiler/errors.ae"
+  display_message(type, &span, msg);
+
+#line 69 "./compiler/errors.ae"
+  char *lines = contents;
+
+#line 70 "./compiler/errors.ae"
+  char *cur = strsep((&lines), "\n");
+
+#line 71 "./compiler/errors.ae"
+  i32 line_no = 1;
+
+#line 72 "./compiler/errors.ae"
+  while ((((bool)cur) && (line_no <= max_line))) {
+
+#line 73 "./compiler/errors.ae"
+    if (((line_no >= min_line) && (line_no <= max_line))) {
+
+#line 74 "./compiler/errors.ae"
+      printf("%4d | ", line_no);
+
+#line 75 "./compiler/errors.ae"
+      if (line_no == span.start.line) {
+
+#line 76 "./compiler/errors.ae"
+        i32 start_col = (span.start.col - 1);
+
+#line 77 "./compiler/errors.ae"
+        i32 end_col = (span.end.col - 1);
+
+#line 78 "./compiler/errors.ae"
+        if ((span.end.line != span.start.line)) {
+
+#line 79 "./compiler/errors.ae"
+          end_col = strlen(cur);
+        } 
+
+#line 81 "./compiler/errors.ae"
+        for (i32 i = 0; (i < start_col); i += 1) {
+
+#line 82 "./compiler/errors.ae"
+          printf("%c", cur[i]);
+        } 
+
+#line 84 "./compiler/errors.ae"
+        printf("%s", color);
+
+#line 85 "./compiler/errors.ae"
+        for (i32 i = start_col; (i < end_col); i += 1) {
+
+#line 86 "./compiler/errors.ae"
+          printf("%c", cur[i]);
+        } 
+
+#line 88 "./compiler/errors.ae"
+        printf("%s%s""\n", reset, (cur + end_col));
+
+#line 89 "./compiler/errors.ae"
+        printf("%*s%s^ %s%s""\n", (start_col + 7), "", color, msg, reset);
+      }  else {
+
+#line 91 "./compiler/errors.ae"
+        printf("%s""\n", cur);
+      } 
+    } 
+
+#line 94 "./compiler/errors.ae"
+    line_no += 1;
+
+#line 95 "./compiler/errors.ae"
+    cur = strsep((&lines), "\n");
+  } 
+
+  /* defers */
+
+#line 62 "./compiler/errors.ae"
+  free(contents);
+
+#line 59 "./compiler/errors.ae"
+  fclose(file);
+}
+
+
+#line 99 "./compiler/errors.ae"
+static __attribute__((unused)) void Error__display(Error *this) {
+
+#line 100 "./compiler/errors.ae"
+  switch (this->type) {
+    case ErrorType__Standard: {
+
+#line 102 "./compiler/errors.ae"
+      display_message_span(MessageType__Error, this->span1, this->msg1);
+
+#line 103 "./compiler/errors.ae"
+      display_line();
+    } break;
+    case ErrorType__WithNote: {
+
+#line 106 "./compiler/errors.ae"
+      display_message_span(MessageType__Error, this->span1, this->msg1);
+
+#line 107 "./compiler/errors.ae"
+      display_message(MessageType__Note, &this->span1, this->msg2);
+    } break;
+    case ErrorType__WithHint: {
+
+#line 110 "./compiler/errors.ae"
+      display_message_span(MessageType__Error, this->span1, this->msg1);
+
+#line 111 "./compiler/errors.ae"
+      display_message_span(MessageType__Note, this->span2, this->msg2);
+
+#line 112 "./compiler/errors.ae"
+      display_line();
+    } break;
+  }
+}
+
+
+#line 117 "./compiler/errors.ae"
+static __attribute__((unused)) __attribute__((noreturn)) void Error__panic(Error *this) {
+
+#line 118 "./compiler/errors.ae"
+  Error__display(this);
+
+#line 119 "./compiler/errors.ae"
+  exit(1);
+}
+
+
+#line 122 "./compiler/errors.ae"
+static __attribute__((unused)) Error *Error__new(Span span, char *msg) {
+
+#line 123 "./compiler/errors.ae"
+  Error *err = ((Error *)calloc(1, sizeof(Error)));
+
+#line 124 "./compiler/errors.ae"
+  err->type = ErrorType__Standard;
+
+#line 125 "./compiler/errors.ae"
+  err->msg1 = msg;
+
+#line 126 "./compiler/errors.ae"
+  err->span1 = span;
+
+#line 127 "./compiler/errors.ae"
+  return err;
+}
+
+
+#line 130 "./compiler/errors.ae"
+static __attribute__((unused)) Error *Error__new_note(Span span, char *msg, char *note) {
+
+#line 131 "./compiler/errors.ae"
+  Error *err = ((Error *)calloc(1, sizeof(Error)));
+
+#line 132 "./compiler/errors.ae"
+  err->type = ErrorType__WithNote;
+
+#line 133 "./compiler/errors.ae"
+  err->msg1 = msg;
+
+#line 134 "./compiler/errors.ae"
+  err->span1 = span;
+
+#line 135 "./compiler/errors.ae"
+  err->msg2 = note;
+
+#line 136 "./compiler/errors.ae"
+  return err;
+}
+
+
+#line 139 "./compiler/errors.ae"
+static __attribute__((unused)) Error *Error__new_hint(Span span, char *msg, Span span2, char *hint) {
+
+#line 140 "./compiler/errors.ae"
+  Error *err = ((Error *)calloc(1, sizeof(Error)));
+
+#line 141 "./compiler/errors.ae"
+  err->type = ErrorType__WithHint;
+
+#line 142 "./compiler/errors.ae"
+  err->msg1 = msg;
+
+#line 143 "./compiler/errors.ae"
+  err->span1 = span;
+
+#line 144 "./compiler/errors.ae"
+  err->msg2 = hint;
+
+#line 145 "./compiler/errors.ae"
+  err->span2 = span2;
+
+#line 146 "./compiler/errors.ae"
+  return err;
+}
+
+
+#line 149 "./compiler/errors.ae"
+static __attribute__((unused)) void display_error_messages(Vector *errors, i32 detail_level) {
+
+#line 150 "./compiler/errors.ae"
+  char *num_errors_env = getenv("AECOR_NUM_ERRORS");
+
+#line 151 "./compiler/errors.ae"
+  i32 max_num_errors = (((bool)num_errors_env) ? atoi(num_errors_env) : 10);
+
+#line 153 "./compiler/errors.ae"
+  i32 num_errors = min(errors->size, max_num_errors);
+
+#line 154 "./compiler/errors.ae"
+  bool first = true;
+
+#line 155 "./compiler/errors.ae"
+  for (i32 i = (num_errors - 1); (i >= 0); i -= 1) {
+
+#line 156 "./compiler/errors.ae"
+    Error *err = ((Error *)Vector__at(errors, i));
+
+#line 158 "./compiler/errors.ae"
+    switch (detail_level) {
+      case 0: {
+
+#line 159 "./compiler/errors.ae"
+        printf("%s: %s""\n", Location__str(err->span1.start), err->msg1);
+      } break;
+      case 1: {
+
+#line 160 "./compiler/errors.ae"
+        display_message_span(MessageType__Error, err->span1, err->msg1);
+      } break;
+      case 2: {
+
+#line 162 "./compiler/errors.ae"
+        if (first) 
+
+#line 162 "./compiler/errors.ae"
+        printf("""\n");
+        
+
+#line 163 "./compiler/errors.ae"
+        first = false;
+
+#line 164 "./compiler/errors.ae"
+        Error__display(err);
+      } break;
+      default: panic("invalid detail level"); break;
+    }
+  } 
+}
+
+
+#line 6 "./compiler/lexer.ae"
+static __attribute__((unused)) bool is_hex_digit(char c) {
+
+#line 7 "./compiler/lexer.ae"
+  if (isdigit(c)) 
+
+#line 7 "./compiler/lexer.ae"
+  return true;
+  
+
+#line 8 "./compiler/lexer.ae"
+  if ((('a' <= c) && (c <= 'f'))) 
+
+#line 8 "./compiler/lexer.ae"
+  return true;
+  
+
+#line 9 "./compiler/lexer.ae"
+  if ((('A' <= c) && (c <= 'F'))) 
+
+#line 9 "./compiler/lexer.ae"
+  return true;
+  
+
+#line 10 "./compiler/lexer.ae"
+  return false;
+}
+
+
+#line 24 "./compiler/lexer.ae"
+static __attribute__((unused)) Lexer Lexer__make(char *source, char *filename) {
+
+#line 25 "./compiler/lexer.ae"
+  return (Lexer){source, .source_len = strlen(source), .i = 0, .loc = (Location){filename, 1, 1}, .seen_newline = false, .tokens = Vector__new(), .errors = Vector__new()};
+}
+
+
+#line 36 "./compiler/lexer.ae"
+static __attribute__((unused)) void Lexer__push(Lexer *this, Token *token) {
+
+#line 37 "./compiler/lexer.ae"
+  token->seen_newline = this->seen_newline;
+
+#line 38 "./compiler/lexer.ae"
+  Vector__push(this->tokens, token);
+
+#line 39 "./compiler/lexer.ae"
+  this->seen_newline = false;
+}
+
+
+#line 42 "./compiler/lexer.ae"
+static __attribute__((unused)) void Lexer__push_type(Lexer *this, TokenType type, i32 len) {
+
+#line 43 "./compiler/lexer.ae"
+  Location start_loc = this->loc;
+
+#line 44 "./compiler/lexer.ae"
+  for (i32 i = 0; (i < len); i += 1) {
+
+#line 45 "./compiler/lexer.ae"
+    Lexer__inc(this);
+  } 
+
+#line 47 "./compiler/lexer.ae"
+  Lexer__push(this, Token__from_type(type, (Span){start_loc, this->loc}));
+}
+
+
+#line 50 "./compiler/lexer.ae"
+static inline __attribute__((unused)) __attribute__((always_inline)) char Lexer__cur(Lexer *this) {
+
+#line 50 "./compiler/lexer.ae"
+  return this->source[this->i];
+}
+
+
+#line 52 "./compiler/lexer.ae"
+static __attribute__((unused)) void Lexer__inc(Lexer *this) {
+
+#line 53 "./compiler/lexer.ae"
+  switch (Lexer__cur(this)) {
+    case '\n': {
+
+#line 55 "./compiler/lexer.ae"
+      this->loc.line += 1;
+
+#line 56 "./compiler/lexer.ae"
+      this->loc.col = 1;
+
+#line 57 "./compiler/lexer.ae"
+      this->seen_newline = true;
+    } break;
+    default: {
+
+#line 59 "./compiler/lexer.ae"
+      this->loc.col += 1;
+    } break;
+  }
+
+#line 61 "./compiler/lexer.ae"
+  this->i += 1;
+}
+
+
+#line 64 "./compiler/lexer.ae"
+static __attribute__((unused)) char Lexer__peek(Lexer *this, i32 offset) {
+
+#line 65 "./compiler/lexer.ae"
+  if (Lexer__cur(this) == '\0') {
+
+#line 66 "./compiler/lexer.ae"
+    return Lexer__cur(this);
+  } 
+
+#line 68 "./compiler/lexer.ae"
+  return this->source[(this->i + 1)];
+}
+
+
+#line 71 "./compiler/lexer.ae"
+static __attribute__((unused)) void Lexer__lex_char_literal(Lexer *this) {
+
+#line 72 "./compiler/lexer.ae"
+  Location start_loc = this->loc;
+
+#line 73 "./compiler/lexer.ae"
+  i32 start = (this->i + 1);
+
+#line 74 "./compiler/lexer.ae"
+  Lexer__inc(this);
+
+#line 76 "./compiler/lexer.ae"
+  if (Lexer__cur(this) == '\\') {
+
+#line 77 "./compiler/lexer.ae"
+    Lexer__inc(this);
+  } 
+
+#line 79 "./compiler/lexer.ae"
+  Lexer__inc(this);
+
+#line 80 "./compiler/lexer.ae"
+  if ((Lexer__cur(this) != '\'')) {
+
+#line 81 "./compiler/lexer.ae"
+    Vector__push(this->errors, Error__new((Span){this->loc, this->loc}, "Expected ' after character literal"));
+  } 
+
+#line 84 "./compiler/lexer.ae"
+  i32 len = (this->i - start);
+
+#line 85 "./compiler/lexer.ae"
+  char *text = string__substring(this->source, start, len);
+
+#line 87 "./compiler/lexer.ae"
+  Lexer__inc(this);
+
+#line 88 "./compiler/lexer.ae"
+  Lexer__push(this, Token__new(TokenType__CharLiteral, (Span){start_loc, this->loc}, text));
+}
+
+
+#line 91 "./compiler/lexer.ae"
+static __attribute__((unused)) void Lexer__lex_string_literal(Lexer *this) {
+
+#line 92 "./compiler/lexer.ae"
+  Location start_loc = this->loc;
+
+#line 93 "./compiler/lexer.ae"
+  char end_char = Lexer__cur(this);
+
+#line 94 "./compiler/lexer.ae"
+  i32 start = (this->i + 1);
+
+#line 95 "./compiler/lexer.ae"
+  Lexer__inc(this);
+
+#line 96 "./compiler/lexer.ae"
+  while (((this->i < this->source_len) && (Lexer__cur(this) != end_char))) {
+
+#line 97 "./compiler/lexer.ae"
+    if (Lexer__cur(this) == '\\') {
+
+#line 98 "./compiler/lexer.ae"
+      Lexer__inc(this);
+    } 
+
+#line 100 "./compiler/lexer.ae"
+    Lexer__inc(this);
+  } 
+
+#line 103 "./compiler/lexer.ae"
+  i32 len = (this->i - start);
+
+#line 104 "./compiler/lexer.ae"
+  char *text = string__substring(this->source, start, len);
+
+#line 105 "./compiler/lexer.ae"
+  Lexer__inc(this);
+
+#line 107 "./compiler/lexer.ae"
+  if ((this->i >= this->source_len)) {
+
+#line 108 "./compiler/lexer.ae"
+    Vector__push(this->errors, Error__new((Span){this->loc, this->loc}, "Unterminated string literal"));
+  } 
+
+#line 111 "./compiler/lexer.ae"
+  if (end_char == '`') {
+
+#line 112 "./compiler/lexer.ae"
+    Lexer__push(this, Token__new(TokenType__FormatStringLiteral, (Span){start_loc, this->loc}, text));
+  }  else {
+
+#line 114 "./compiler/lexer.ae"
+    Lexer__push(this, Token__new(TokenType__StringLiteral, (Span){start_loc, this->loc}, text));
+  } 
+}
+
+
+#line 118 "./compiler/lexer.ae"
+static __attribute__((unused)) Token *Lexer__lex_int_literal_different_base(Lexer *this) {
+
+#line 119 "./compiler/lexer.ae"
+  Location start_loc = this->loc;
+
+#line 120 "./compiler/lexer.ae"
+  i32 start = this->i;
+
+#line 121 "./compiler/lexer.ae"
+  Lexer__inc(this);
+
+#line 122 "./compiler/lexer.ae"
+  switch (Lexer__cur(this)) {
+    case 'x': {
+
+#line 124 "./compiler/lexer.ae"
+      Lexer__inc(this);
+
+#line 125 "./compiler/lexer.ae"
+      while (((this->i < this->source_len) && is_hex_digit(Lexer__cur(this)))) {
+
+#line 126 "./compiler/lexer.ae"
+        Lexer__inc(this);
+      } 
+    } break;
+    case 'b': {
+
+#line 130 "./compiler/lexer.ae"
+      Lexer__inc(this);
+
+#line 131 "./compiler/lexer.ae"
+      while ((((this->i < this->source_len) && Lexer__cur(this) == '0') || Lexer__cur(this) == '1')) {
+
+#line 132 "./compiler/lexer.ae"
+        Lexer__inc(this);
+      } 
+    } break;
+    default: {
+    } break;
+  }
+
+#line 139 "./compiler/lexer.ae"
+  i32 len = (this->i - start);
+
+#line 140 "./compiler/lexer.ae"
+  char *text = string__substring(this->source, start, len);
+
+#line 141 "./compiler/lexer.ae"
+  return Token__new(TokenType__IntLiteral, (Span){start_loc, this->loc}, text);
+}
+
+
+#line 144 "./compiler/lexer.ae"
+static __attribute__((unused)) Token *Lexer__lex_numeric_literal_helper(Lexer *this) {
+
+#line 145 "./compiler/lexer.ae"
+  Location start_loc = this->loc;
+
+#line 146 "./compiler/lexer.ae"
+  if (Lexer__cur(this) == '0') {
+
+#line 147 "./compiler/lexer.ae"
+    switch (Lexer__peek(this, 1)) {
+      case 'x':
+      case 'b': {
+
+#line 149 "./compiler/lexer.ae"
+        return Lexer__lex_int_literal_different_base(this);
+      } break;
+      default: {
+      } break;
+    }
+  } 
+
+#line 156 "./compiler/lexer.ae"
+  i32 start = this->i;
+
+#line 157 "./compiler/lexer.ae"
+  TokenType token_type;
+
+#line 158 "./compiler/lexer.ae"
+  while (isdigit(Lexer__cur(this))) {
+
+#line 159 "./compiler/lexer.ae"
+    Lexer__inc(this);
+  } 
+
+#line 162 "./compiler/lexer.ae"
+  if ((Lexer__cur(this) == '.' && (Lexer__peek(this, 1) != '.'))) {
+
+#line 163 "./compiler/lexer.ae"
+    Lexer__inc(this);
+
+#line 164 "./compiler/lexer.ae"
+    while (isdigit(Lexer__cur(this))) {
+
+#line 165 "./compiler/lexer.ae"
+      Lexer__inc(this);
+    } 
+
+#line 167 "./compiler/lexer.ae"
+    token_type = TokenType__FloatLiteral;
+  }  else {
+
+#line 169 "./compiler/lexer.ae"
+    token_type = TokenType__IntLiteral;
+  } 
+
+#line 171 "./compiler/lexer.ae"
+  i32 len = (this->i - start);
+
+#line 172 "./compiler/lexer.ae"
+  char *text = string__substring(this->source, start, len);
+
+#line 174 "./compiler/lexer.ae"
+  return Token__new(token_type, (Span){start_loc, this->loc}, text);
+}
+
+
+#line 177 "./compiler/lexer.ae"
+static __attribute__((unused)) void Lexer__lex_numeric_literal(Lexer *this) {
+
+#line 178 "./compiler/lexer.ae"
+  Token *token = Lexer__lex_numeric_literal_helper(this);
+
+#line 181 "./compiler/lexer.ae"
+  if (((Lexer__cur(this) == 'u' || Lexer__cur(this) == 'i') || Lexer__cur(this) == 'f')) {
+
+#line 182 "./compiler/lexer.ae"
+    Location start_loc = this->loc;
+
+#line 183 "./compiler/lexer.ae"
+    i32 start = this->i;
+
+#line 184 "./compiler/lexer.ae"
+    Lexer__inc(this);
+
+#line 185 "./compiler/lexer.ae"
+    while (((this->i < this->source_len) && isdigit(Lexer__cur(this)))) {
+
+#line 186 "./compiler/lexer.ae"
+      Lexer__inc(this);
+    } 
+
+#line 188 "./compiler/lexer.ae"
+    i32 len = (this->i - start);
+
+#line 189 "./compiler/lexer.ae"
+    char *suffix = string__substring(this->source, start, len);
+
+#line 190 "./compiler/lexer.ae"
+    token->suffix = Token__from_ident(suffix, (Span){start_loc, this->loc});
+  } 
+
+#line 193 "./compiler/lexer.ae"
+  Lexer__push(this, token);
+}
+
+
+#line 196 "./compiler/lexer.ae"
+static __attribute__((unused)) Vector *Lexer__lex(Lexer *this) {
+
+#line 197 "./compiler/lexer.ae"
+  while ((this->i < this->source_len)) {
+
+#line 198 "./compiler/lexer.ae"
+    char c = Lexer__cur(this);
+
+#line 199 "./compiler/lexer.ae"
+    switch (c) {
+      case ' ':
+      case '\t':
+      case '\v':
+      case '\r':
+      case '\b':
+      case '\n': {
+
+#line 201 "./compiler/lexer.ae"
+        Lexer__inc(this);
+      } break;
+      case ';': {
+
+#line 203 "./compiler/lexer.ae"
+        Lexer__push_type(this, TokenType__Semicolon, 1);
+      } break;
+      case ',': {
+
+#line 204 "./compiler/lexer.ae"
+        Lexer__push_type(this, TokenType__Comma, 1);
+      } break;
+      case '.': {
+
+#line 206 "./compiler/lexer.ae"
+        if (Lexer__peek(this, 1) == '.') {
+
+#line 207 "./compiler/lexer.ae"
+          Lexer__push_type(this, TokenType__DotDot, 2);
+        }  else {
+
+#line 209 "./compiler/lexer.ae"
+          Lexer__push_type(this, TokenType__Dot, 1);
+        } 
+      } break;
+      case '(': {
+
+#line 212 "./compiler/lexer.ae"
+        Lexer__push_type(this, TokenType__OpenParen, 1);
+      } break;
+      case ')': {
+
+#line 213 "./compiler/lexer.ae"
+        Lexer__push_type(this, TokenType__CloseParen, 1);
+      } break;
+      case '[': {
+
+#line 214 "./compiler/lexer.ae"
+        Lexer__push_type(this, TokenType__OpenSquare, 1);
+      } break;
+      case ']': {
+
+#line 215 "./compiler/lexer.ae"
+        Lexer__push_type(this, TokenType__CloseSquare, 1);
+      } break;
+      case '{': {
+
+#line 216 "./compiler/lexer.ae"
+        Lexer__push_type(this, TokenType__OpenCurly, 1);
+      } break;
+      case '}': {
+
+#line 217 "./compiler/lexer.ae"
+        Lexer__push_type(this, TokenType__CloseCurly, 1);
+      } break;
+      case '@': {
+
+#line 218 "./compiler/lexer.ae"
+        Lexer__push_type(this, TokenType__AtSign, 1);
+      } break;
+      case '%': {
+
+#line 219 "./compiler/lexer.ae"
+        Lexer__push_type(this, TokenType__Percent, 1);
+      } break;
+      case '^': {
+
+#line 220 "./compiler/lexer.ae"
+        Lexer__push_type(this, TokenType__Caret, 1);
+      } break;
+      case '&': {
+
+#line 221 "./compiler/lexer.ae"
+        Lexer__push_type(this, TokenType__Ampersand, 1);
+      } break;
+      case '|': {
+
+#line 222 "./compiler/lexer.ae"
+        Lexer__push_type(this, TokenType__Line, 1);
+      } break;
+      case '?': {
+
+#line 223 "./compiler/lexer.ae"
+        Lexer__push_type(this, TokenType__Question, 1);
+      } break;
+      case '~': {
+
+#line 224 "./compiler/lexer.ae"
+        Lexer__push_type(this, TokenType__Tilde, 1);
+      } break;
+      case '!': {
+
+#line 225 "./compiler/lexer.ae"
+        switch (Lexer__peek(this, 1)) {
+          case '=': {
+
+#line 226 "./compiler/lexer.ae"
+            Lexer__push_type(this, TokenType__NotEquals, 2);
+          } break;
+          default: {
+
+#line 227 "./compiler/lexer.ae"
+            Lexer__push_type(this, TokenType__Exclamation, 1);
+          } break;
+        }
+      } break;
+      case ':': {
+
+#line 229 "./compiler/lexer.ae"
+        switch (Lexer__peek(this, 1)) {
+          case ':': {
+
+#line 230 "./compiler/lexer.ae"
+            Lexer__push_type(this, TokenType__ColonColon, 2);
+          } break;
+          default: {
+
+#line 231 "./compiler/lexer.ae"
+            Lexer__push_type(this, TokenType__Colon, 1);
+          } break;
+        }
+      } break;
+      case '=': {
+
+#line 233 "./compiler/lexer.ae"
+        switch (Lexer__peek(this, 1)) {
+          case '=': {
+
+#line 234 "./compiler/lexer.ae"
+            Lexer__push_type(this, TokenType__EqualEquals, 2);
+          } break;
+          case '>': {
+
+#line 235 "./compiler/lexer.ae"
+            Lexer__push_type(this, TokenType__FatArrow, 2);
+          } break;
+          default: {
+
+#line 236 "./compiler/lexer.ae"
+            Lexer__push_type(this, TokenType__Equals, 1);
+          } break;
+        }
+      } break;
+      case '*': {
+
+#line 238 "./compiler/lexer.ae"
+        switch (Lexer__peek(this, 1)) {
+          case '=': {
+
+#line 239 "./compiler/lexer.ae"
+            Lexer__push_type(this, TokenType__StarEquals, 2);
+          } break;
+          default: {
+
+#line 240 "./compiler/lexer.ae"
+            Lexer__push_type(this, TokenType__Star, 1);
+          } break;
+        }
+      } break;
+      case '+': {
+
+#line 242 "./compiler/lexer.ae"
+        switch (Lexer__peek(this, 1)) {
+          case '=': {
+
+#line 243 "./compiler/lexer.ae"
+            Lexer__push_type(this, TokenType__PlusEquals, 2);
+          } break;
+          default: {
+
+#line 244 "./compiler/lexer.ae"
+            Lexer__push_type(this, TokenType__Plus, 1);
+          } break;
+        }
+      } break;
+      case '-': {
+
+#line 246 "./compiler/lexer.ae"
+        switch (Lexer__peek(this, 1)) {
+          case '=': {
+
+#line 247 "./compiler/lexer.ae"
+            Lexer__push_type(this, TokenType__MinusEquals, 2);
+          } break;
+          default: {
+
+#line 248 "./compiler/lexer.ae"
+            Lexer__push_type(this, TokenType__Minus, 1);
+          } break;
+        }
+      } break;
+      case '<': {
+
+#line 250 "./compiler/lexer.ae"
+        switch (Lexer__peek(this, 1)) {
+          case '=': {
+
+#line 251 "./compiler/lexer.ae"
+            Lexer__push_type(this, TokenType__LessThanEquals, 2);
+          } break;
+          case '<': {
+
+#line 252 "./compiler/lexer.ae"
+            Lexer__push_type(this, TokenType__LessThanLessThan, 2);
+          } break;
+          default: {
+
+#line 253 "./compiler/lexer.ae"
+            Lexer__push_type(this, TokenType__LessThan, 1);
+          } break;
+        }
+      } break;
+      case '>': {
+
+#line 255 "./compiler/lexer.ae"
+        switch (Lexer__peek(this, 1)) {
+          case '=': {
+
+#line 256 "./compiler/lexer.ae"
+            Lexer__push_type(this, TokenType__GreaterThanEquals, 2);
+          } break;
+          case '>': {
+
+#line 257 "./compiler/lexer.ae"
+            Lexer__push_type(this, TokenType__GreaterThanGreaterThan, 2);
+          } break;
+          default: {
+
+#line 258 "./compiler/lexer.ae"
+            Lexer__push_type(this, TokenType__GreaterThan, 1);
+          } break;
+        }
+      } break;
+      case '/': {
+
+#line 260 "./compiler/lexer.ae"
+        switch (Lexer__peek(this, 1)) {
+          case '/': {
+
+#line 262 "./compiler/lexer.ae"
+            Lexer__inc(this);
+
+#line 263 "./compiler/lexer.ae"
+            while (((this->i < this->source_len) && (Lexer__cur(this) != '\n'))) {
+
+#line 264 "./compiler/lexer.ae"
+              Lexer__inc(this);
+            } 
+          } break;
+          case '=': {
+
+#line 267 "./compiler/lexer.ae"
+            Lexer__push_type(this, TokenType__SlashEquals, 2);
+          } break;
+          default: {
+
+#line 268 "./compiler/lexer.ae"
+            Lexer__push_type(this, TokenType__Slash, 1);
+          } break;
+        }
+      } break;
+      case '\'': {
+
+#line 270 "./compiler/lexer.ae"
+        Lexer__lex_char_literal(this);
+      } break;
+      case '"':
+      case '`': {
+
+#line 271 "./compiler/lexer.ae"
+        Lexer__lex_string_literal(this);
+      } break;
+      default: {
+
+#line 273 "./compiler/lexer.ae"
+        Location start_loc = this->loc;
+
+#line 275 "./compiler/lexer.ae"
+        if (isdigit(c)) {
+
+#line 276 "./compiler/lexer.ae"
+          Lexer__lex_numeric_literal(this);
+        }  else 
+#line 278 "./compiler/lexer.ae"
+        if ((isalpha(c) || c == '_')) {
+
+#line 279 "./compiler/lexer.ae"
+          i32 start = this->i;
+
+#line 280 "./compiler/lexer.ae"
+          while ((isalnum(Lexer__cur(this)) || Lexer__cur(this) == '_')) {
+
+#line 281 "./compiler/lexer.ae"
+            Lexer__inc(this);
+          } 
+
+#line 283 "./compiler/lexer.ae"
+          i32 len = (this->i - start);
+
+#line 284 "./compiler/lexer.ae"
+          char *text = string__substring(this->source, start, len);
+
+#line 286 "./compiler/lexer.ae"
+          Lexer__push(this, Token__from_ident(text, (Span){start_loc, this->loc}));
+        }  else {
+
+#line 289 "./compiler/lexer.ae"
+          Vector__push(this->errors, Error__new((Span){this->loc, this->loc}, format_string("Unrecognized char in lexer: '%c'", c)));
+
+#line 290 "./compiler/lexer.ae"
+          Lexer__inc(this);
+        } 
+        
+      } break;
+    }
+  } 
+
+#line 297 "./compiler/lexer.ae"
+  this->seen_newline = true;
+
+#line 298 "./compiler/lexer.ae"
+  Lexer__push_type(this, TokenType__EOF, 0);
+
+#line 299 "./compiler/lexer.ae"
+  return this->tokens;
+}
+
+
+#line 10 "./lib/buffer.ae"
+static __attribute__((unused)) Buffer Buffer__make(void) {
+
+#line 11 "./lib/buffer.ae"
+  i32 initial_capacity = 16;
+
+#line 12 "./lib/buffer.ae"
+  return (Buffer){.data = calloc(initial_capacity, 1), .size = 0, .capacity = initial_capacity};
+}
+
+
+#line 19 "./lib/buffer.ae"
+static __attribute__((unused)) Buffer Buffer__from_string(char *s) {
+
+#line 20 "./lib/buffer.ae"
+  return (Buffer){.data = ((u8 *)s), .size = strlen(s), .capacity = strlen(s)};
+}
+
+
+#line 27 "./lib/buffer.ae"
+static __attribute__((unused)) Buffer Buffer__from_sized_string(char *s, i32 size) {
+
+#line 28 "./lib/buffer.ae"
+  return (Buffer){.data = ((u8 *)s), .size = ((i32)size), .capacity = strlen(s)};
+}
+
+
+#line 35 "./lib/buffer.ae"
+static __attribute__((unused)) void Buffer__resize_if_necessary(Buffer *this, i32 new_size) {
+
+#line 36 "./lib/buffer.ae"
+  if ((new_size >= this->capacity)) {
+
+#line 37 "./lib/buffer.ae"
+    i32 new_capacity = max((this->capacity * 2), new_size);
+
+#line 38 "./lib/buffer.ae"
+    this->data = ((u8 *)realloc(this->data, new_capacity));
+
+#line 39 "./lib/buffer.ae"
+    if (this->data == NULL) {
+
+#line 40 "./lib/buffer.ae"
+      printf("Out of memory!""\n");
+
+#line 41 "./lib/buffer.ae"
+      exit(1);
+    } 
+
+#line 43 "./lib/buffer.ae"
+    this->capacity = new_capacity;
+  } 
+}
+
+
+#line 47 "./lib/buffer.ae"
+static __attribute__((unused)) void Buffer__hex_dump(Buffer *this) {
+
+#line 48 "./lib/buffer.ae"
+  printf("(%d bytes): ", this->size);
+
+#line 49 "./lib/buffer.ae"
+  for (i32 i = 0; (i < this->size); i += 1) {
+
+#line 50 "./lib/buffer.ae"
+    if (((i % 4) == 0 && (i > 0))) 
+
+#line 50 "./lib/buffer.ae"
+    printf("_");
+    
+
+#line 51 "./lib/buffer.ae"
+    printf("%02x", this->data[i]);
+  } 
+
+#line 53 "./lib/buffer.ae"
+  printf("""\n");
+}
+
+
+#line 56 "./lib/buffer.ae"
+static __attribute__((unused)) void Buffer__putb(Buffer *this, Buffer *buf) {
+
+#line 57 "./lib/buffer.ae"
+  Buffer__resize_if_necessary(this, ((this->size + buf->size) + 1));
+
+#line 58 "./lib/buffer.ae"
+  memcpy((this->data + this->size), buf->data, buf->size);
+
+#line 59 "./lib/buffer.ae"
+  this->data[(this->size + buf->size)] = ((u8)'\0');
+
+#line 60 "./lib/buffer.ae"
+  this->size += buf->size;
+}
+
+
+#line 63 "./lib/buffer.ae"
+static __attribute__((unused)) void Buffer__putbf(Buffer *this, Buffer *buf) {
+
+#line 64 "./lib/buffer.ae"
+  Buffer__putb(this, buf);
+
+#line 65 "./lib/buffer.ae"
+  Buffer__free(buf);
+}
+
+
+#line 68 "./lib/buffer.ae"
+static __attribute__((unused)) void Buffer__puts(Buffer *this, char *s) {
+
+#line 69 "./lib/buffer.ae"
+  i32 len = strlen(s);
+
+#line 70 "./lib/buffer.ae"
+  Buffer__resize_if_necessary(this, ((this->size + len) + 1));
+
+#line 71 "./lib/buffer.ae"
+  memcpy((this->data + this->size), s, (len + 1));
+
+#line 72 "./lib/buffer.ae"
+  this->size += len;
+}
+
+
+#line 77 "./lib/buffer.ae"
+static __attribute__((unused)) void Buffer__put_str(Buffer *this, char *s) {
+
+#line 78 "./lib/buffer.ae"
+  Buffer__puts(this, (((bool)s) ? s : "(null)"));
+}
+
+
+#line 81 "./lib/buffer.ae"
+static inline __attribute__((unused)) __attribute__((always_inline)) void Buffer__putc(Buffer *this, char c) {
+
+#line 82 "./lib/buffer.ae"
+  Buffer__resize_if_necessary(this, (this->size + 2));
+
+#line 83 "./lib/buffer.ae"
+  this->data[this->size] = ((u8)c);
+
+#line 84 "./lib/buffer.ae"
+  this->size += 1;
+
+#line 85 "./lib/buffer.ae"
+  this->data[this->size] = ((u8)'\0');
+}
+
+
+#line 88 "./lib/buffer.ae"
+static __attribute__((unused)) void Buffer__put_u64(Buffer *this, u64 value) {
+
+#line 90 "./lib/buffer.ae"
+  u8 digits[20];
+
+#line 91 "./lib/buffer.ae"
+  i32 len = 0;
+
+#line 92 "./lib/buffer.ae"
+  while (true) {
+
+#line 93 "./lib/buffer.ae"
+    digits[len] = (((u8)(value % 10)) + ((u8)'0'));
+
+#line 94 "./lib/buffer.ae"
+    len += 1;
+
+#line 95 "./lib/buffer.ae"
+    value = (value / 10);
+
+#line 96 "./lib/buffer.ae"
+    if (value == 0) 
+
+#line 96 "./lib/buffer.ae"
+    break;
+    
+  } 
+
+#line 98 "./lib/buffer.ae"
+  Buffer__resize_if_necessary(this, ((this->size + len) + 1));
+
+#line 99 "./lib/buffer.ae"
+  for (i32 i = 0; (i < len); i += 1) {
+
+#line 100 "./lib/buffer.ae"
+    this->data[(this->size + i)] = digits[((len - i) - 1)];
+  } 
+
+#line 102 "./lib/buffer.ae"
+  this->size += len;
+
+#line 103 "./lib/buffer.ae"
+  this->data[this->size] = ((u8)'\0');
+}
+
+
+#line 106 "./lib/buffer.ae"
+static __attribute__((unused)) void Buffer__put_i64(Buffer *this, i64 value) {
+
+#line 107 "./lib/buffer.ae"
+  if ((value < 0)) {
+
+#line 108 "./lib/buffer.ae"
+    Buffer__putc(this, '-');
+
+#line 110 "./lib/buffer.ae"
+    Buffer__put_u64(this, (-((u64)value)));
+  }  else {
+
+#line 112 "./lib/buffer.ae"
+    Buffer__put_u64(this, ((u64)value));
+  } 
+}
+
+
+#line 119 "./lib/buffer.ae"
+static __attribute__((unused)) void Buffer__put_f64(Buffer *this, f64 value) {
+
+#line 120 "./lib/buffer.ae"
+  char stack[64];
+
+#line 121 "./lib/buffer.ae"
+  char *s = format_string_into(stack, 64, "%f", value);
+
+#line 122 "./lib/buffer.ae"
+  Buffer__puts(this, s);
+
+#line 123 "./lib/buffer.ae"
+  if ((s != ((char *)stack))) 
+
+#line 123 "./lib/buffer.ae"
+  free(s);
+  
+}
+
+
+#line 126 "./lib/buffer.ae"
+static __attribute__((unused)) void Buffer__put_ptr(Buffer *this, void *value) {
+
+#line 127 "./lib/buffer.ae"
+  char stack[32];
+
+#line 128 "./lib/buffer.ae"
+  Buffer__puts(this, format_string_into(stack, 32, "%p", value));
+}
+
+
+#line 132 "./lib/buffer.ae"
+static __attribute__((unused)) void Buffer__putsf(Buffer *this, char *s) {
+
+#line 133 "./lib/buffer.ae"
+  Buffer__puts(this, s);
+
+#line 134 "./lib/buffer.ae"
+  free(s);
+}
+
+
+#line 137 "./lib/buffer.ae"
+static __attribute__((unused)) char *Buffer__str(Buffer *this) {
+
+#line 137 "./lib/buffer.ae"
+  return ((char *)this->data);
+}
+
+
+#line 138 "./lib/buffer.ae"
+static __attribute__((unused)) char *Buffer__new_str(Buffer *this) {
+
+#line 138 "./lib/buffer.ae"
+  return strdup(((char *)this->data));
+}
+
+
+#line 140 "./lib/buffer.ae"
+static __attribute__((unused)) void Buffer__free(Buffer *this) {
+
+#line 141 "./lib/buffer.ae"
+  free(this->data);
+}
+
+
+#line 12 "./lib/map.ae"
+static __attribute__((unused)) MapNode *MapNode__new(char *key, void *value, MapNode *next) {
+
+#line 13 "./lib/map.ae"
+  MapNode *node = ((MapNode *)calloc(1, sizeof(MapNode)));
+
+#line 14 "./lib/map.ae"
+  node->key = key;
+
+#line 15 "./lib/map.ae"
+  node->value = value;
+
+#line 16 "./lib/map.ae"
+  node->next = next;
+
+#line 17 "./lib/map.ae"
+  return node;
+}
+
+
+#line 20 "./lib/map.ae"
+static __attribute__((unused)) void MapNode__free_list(MapNode *node) {
+
+#line 21 "./lib/map.ae"
+  MapNode *cur = node;
+
+#line 22 "./lib/map.ae"
+  while (((bool)cur)) {
+
+#line 23 "./lib/map.ae"
+    MapNode *next = cur->next;
+
+#line 24 "./lib/map.ae"
+    free(cur);
+
+#line 25 "./lib/map.ae"
+    cur = next;
+  } 
+}
+
+
+#line 36 "./lib/map.ae"
+static __attribute__((unused)) Map *Map__new(void) {
+
+#line 37 "./lib/map.ae"
+  Map *map = ((Map *)calloc(1, sizeof(Map)));
+
+#line 38 "./lib/map.ae"
+  map->num_buckets = 4;
+
+#line 39 "./lib/map.ae"
+  map->buckets = ((MapNode **)calloc(map->num_buckets, sizeof(MapNode *)));
+
+#line 40 "./lib/map.ae"
+  return map;
+}
+
+
+#line 45 "./lib/map.ae"
+static __attribute__((unused)) i32 Map__hash(Map *this, char *s) {
+
+#line 46 "./lib/map.ae"
+  u32 hash = 5381U;
+
+#line 47 "./lib/map.ae"
+  for (i32 i = 0; (s[i] != '\0'); i += 1) {
+
+#line 48 "./lib/map.ae"
+    hash = ((hash * 33) ^ ((u32)((u8)s[i])));
+  } 
+
+#line 50 "./lib/map.ae"
+  hash = (hash ^ (hash >> 16U));
+
+#line 51 "./lib/map.ae"
+  return ((i32)(hash % ((u32)this->num_buckets)));
+}
+
+
+#line 54 "./lib/map.ae"
+static __attribute__((unused)) MapNode *Map__get_node(Map *this, char *key) {
+
+#line 55 "./lib/map.ae"
+  i32 hash = Map__hash(this, key);
+
+#line 56 "./lib/map.ae"
+  MapNode *node = this->buckets[hash];
+
+#line 57 "./lib/map.ae"
+  while (((bool)node)) {
+
+#line 58 "./lib/map.ae"
+    if (string__eq(node->key, key)) {
+
+#line 59 "./lib/map.ae"
+      return node;
+    } 
+
+#line 61 "./lib/map.ae"
+    node = node->next;
+  } 
+
+#line 63 "./lib/map.ae"
+  return NULL;
+}
+
+
+#line 66 "./lib/map.ae"
+static __attribute__((unused)) void *Map__get(Map *this, char *key) {
+
+#line 67 "./lib/map.ae"
+  MapNode *node = Map__get_node(this, key);
+
+#line 68 "./lib/map.ae"
+  if (((bool)node)) {
+
+#line 69 "./lib/map.ae"
+    return node->value;
+  } 
+
+#line 71 "./lib/map.ae"
+  return NULL;
+}
+
+
+#line 74 "./lib/map.ae"
+static __attribute__((unused)) bool Map__exists(Map *this, char *key) {
+
+#line 75 "./lib/map.ae"
+  return ((bool)Map__get_node(this, key));
+}
+
+
+#line 78 "./lib/map.ae"
+static __attribute__((unused)) void Map__insert(Map *this, char *key, void *value) {
+
+#line 79 "./lib/map.ae"
+  MapNode *node = Map__get_node(this, key);
+
+#line 80 "./lib/map.ae"
+  if (((bool)node)) {
+
+#line 81 "./lib/map.ae"
+    node->value = value;
+  }  else {
+
+#line 83 "./lib/map.ae"
+    i32 hash = Map__hash(this, key);
+
+#line 84 "./lib/map.ae"
+    MapNode *new_node = MapNode__new(key, value, this->buckets[hash]);
+
+#line 85 "./lib/map.ae"
+    if (((bool)this->buckets[hash])) {
+
+#line 86 "./lib/map.ae"
+      this->num_collisions += 1;
+    } 
+
+#line 88 "./lib/map.ae"
+    this->buckets[hash] = new_node;
+
+#line 89 "./lib/map.ae"
+    this->num_items += 1;
+
+#line 90 "./lib/map.ae"
+    if ((this->num_items > this->num_buckets)) {
+
+#line 91 "./lib/map.ae"
+      Map__resize(this);
+    } 
+  } 
+}
+
+
+#line 96 "./lib/map.ae"
+static __attribute__((unused)) void Map__resize(Map *this) {
+
+#line 97 "./lib/map.ae"
+  MapNode **old_buckets = this->buckets;
+
+#line 98 "./lib/map.ae"
+  i32 old_num_buckets = this->num_buckets;
+
+#line 99 "./lib/map.ae"
+  i32 old_num_items = this->num_items;
+
+#line 100 "./lib/map.ae"
+  this->num_collisions = 0;
+
+#line 101 "./lib/map.ae"
+  this->num_buckets *= 2;
+
+#line 102 "./lib/map.ae"
+  this->buckets = ((MapNode **)calloc(this->num_buckets, sizeof(MapNode *)));
+
+#line 103 "./lib/map.ae"
+  for (i32 i = 0; (i < old_num_buckets); i += 1) {
+
+#line 104 "./lib/map.ae"
+    MapNode *node = old_buckets[i];
+
+#line 105 "./lib/map.ae"
+    while (((bool)node)) {
+
+#line 106 "./lib/map.ae"
+      i32 new_hash = Map__hash(this, node->key);
+
+#line 107 "./lib/map.ae"
+      MapNode *new_node = MapNode__new(node->key, node->value, this->buckets[new_hash]);
+
+#line 108 "./lib/map.ae"
+      if (((bool)this->buckets[new_hash])) {
+
+#line 109 "./lib/map.ae"
+        this->num_collisions += 1;
+      } 
+
+#line 111 "./lib/map.ae"
+      this->buckets[new_hash] = new_node;
+
+#line 112 "./lib/map.ae"
+      node = node->next;
+    } 
+  } 
+
+#line 115 "./lib/map.ae"
+  for (i32 i = 0; (i < old_num_buckets); i += 1) {
+
+#line 116 "./lib/map.ae"
+    MapNode__free_list(old_buckets[i]);
+  } 
+
+#line 118 "./lib/map.ae"
+  free(old_buckets);
+}
+
+
+#line 121 "./lib/map.ae"
+static __attribute__((unused)) void Map__print_keys(Map *this) {
+
+#line 122 "./lib/map.ae"
+  for (i32 i = 0; (i < this->num_buckets); i += 1) {
+
+#line 123 "./lib/map.ae"
+    MapNode *node = this->buckets[i];
+
+#line 124 "./lib/map.ae"
+    while (((bool)node)) {
+
+#line 125 "./lib/map.ae"
+      printf("- '%s'\n""\n", node->key);
+
+#line 126 "./lib/map.ae"
+      node = node->next;
+    } 
+  } 
+}
+
+
+#line 131 "./lib/map.ae"
+static __attribute__((unused)) void Map__push_keys(Map *this, Vector *vec) {
+
+#line 132 "./lib/map.ae"
+  for (i32 i = 0; (i < this->num_buckets); i += 1) {
+
+#line 133 "./lib/map.ae"
+    MapNode *node = this->buckets[i];
+
+#line 134 "./lib/map.ae"
+    while (((bool)node)) {
+
+#line 135 "./lib/map.ae"
+      Vector__push(vec, node->key);
+
+#line 136 "./lib/map.ae"
+      node = node->next;
+    } 
+  } 
+}
+
+
+#line 141 "./lib/map.ae"
+static __attribute__((unused)) void Map__free(Map *this) {
+
+#line 142 "./lib/map.ae"
+  for (i32 i = 0; (i < this->num_buckets); i += 1) {
+
+#line 143 "./lib/map.ae"
+    MapNode__free_list(this->buckets[i]);
+  } 
+
+#line 145 "./lib/map.ae"
+  free(this->buckets);
+}
+
+
+#line 148 "./lib/map.ae"
+static __attribute__((unused)) MapIterator Map__iter(Map *this) {
+
+#line 149 "./lib/map.ae"
+  return MapIterator__make(this);
+}
+
+
+#line 158 "./lib/map.ae"
+static __attribute__((unused)) char *MapIterator__key(MapIterator *this) {
+
+#line 159 "./lib/map.ae"
+  return this->cur->key;
+}
+
+
+#line 162 "./lib/map.ae"
+static __attribute__((unused)) void *MapIterator__value(MapIterator *this) {
+
+#line 163 "./lib/map.ae"
+  return this->cur->value;
+}
+
+
+#line 166 "./lib/map.ae"
+static __attribute__((unused)) MapIterator MapIterator__make(Map *map) {
+
+#line 167 "./lib/map.ae"
+  MapIterator it = (MapIterator){.idx = (-1), .cur = NULL, map};
+
+#line 168 "./lib/map.ae"
+  MapIterator__next((&it));
+
+#line 169 "./lib/map.ae"
+  return it;
+}
+
+
+#line 172 "./lib/map.ae"
+static __attribute__((unused)) void MapIterator__next(MapIterator *this) {
+
+#line 173 "./lib/map.ae"
+  while ((this->idx < this->map->num_buckets)) {
+
+#line 174 "./lib/map.ae"
+    while (((bool)this->cur)) {
+
+#line 175 "./lib/map.ae"
+      this->cur = this->cur->next;
+
+#line 176 "./lib/map.ae"
+      if (((bool)this->cur)) 
+
+#line 176 "./lib/map.ae"
+      return;
+      
+    } 
+
+#line 178 "./lib/map.ae"
+    this->idx += 1;
+
+#line 179 "./lib/map.ae"
+    this->cur = ({ MapNode *__yield_0;
+
+#line 179 "./lib/map.ae"
+  if ((this->idx < this->map->num_buckets)) {
+
+#line 180 "./lib/map.ae"
+    __yield_0 = this->map->buckets[this->idx];
+  }  else {
+
+#line 182 "./lib/map.ae"
+    __yield_0 = NULL;
+  } 
+;__yield_0; });
+
+#line 184 "./lib/map.ae"
+    if (((bool)this->cur)) 
+
+#line 184 "./lib/map.ae"
+    return;
+    
+  } 
+}
+
+
+#line 29 "./compiler/types.ae"
+static __attribute__((unused)) char *BaseType__str(BaseType this) {
+
+#line 29 "./compiler/types.ae"
+  return ({ char *__yield_0;
+
+#line 29 "./compiler/types.ae"
+  switch (this) {
+    case BaseType__Char: {
+      __yield_0 = "char";
+} break;
+    case BaseType__Bool: {
+      __yield_0 = "bool";
+} break;
+    case BaseType__Void: {
+      __yield_0 = "void";
+} break;
+    case BaseType__I8: {
+      __yield_0 = "i8";
+} break;
+    case BaseType__I16: {
+      __yield_0 = "i16";
+} break;
+    case BaseType__I32: {
+      __yield_0 = "i32";
+} break;
+    case BaseType__I64: {
+      __yield_0 = "i64";
+} break;
+    case BaseType__U8: {
+      __yield_0 = "u8";
+} break;
+    case BaseType__U16: {
+      __yield_0 = "u16";
+} break;
+    case BaseType__U32: {
+      __yield_0 = "u32";
+} break;
+    case BaseType__U64: {
+      __yield_0 = "u64";
+} break;
+    case BaseType__F32: {
+      __yield_0 = "f32";
+} break;
+    case BaseType__F64: {
+      __yield_0 = "f64";
+} break;
+    default: {
+      __yield_0 = BaseType__dbg(this);
+} break;
+  }
+;__yield_0; });
+}
+
+
+#line 47 "./compiler/types.ae"
+static __attribute__((unused)) i32 BaseType__scalar_size(BaseType this) {
+
+#line 47 "./compiler/types.ae"
+  return ({ i32 __yield_0;
+
+#line 47 "./compiler/types.ae"
+  switch (this) {
+    case BaseType__Char:
+    case BaseType__Bool:
+    case BaseType__I8:
+    case BaseType__U8: {
+      __yield_0 = 1;
+} break;
+    case BaseType__I16:
+    case BaseType__U16: {
+      __yield_0 = 2;
+} break;
+    case BaseType__I32:
+    case BaseType__U32:
+    case BaseType__F32: {
+      __yield_0 = 4;
+} break;
+    case BaseType__I64:
+    case BaseType__U64:
+    case BaseType__F64: {
+      __yield_0 = 8;
+} break;
+    default: {
+      __yield_0 = 0;
+} break;
+  }
+;__yield_0; });
+}
+
+
+#line 72 "./compiler/types.ae"
+static __attribute__((unused)) Type *Type__new(BaseType base, Span span) {
+
+#line 73 "./compiler/types.ae"
+  Type *type = ((Type *)calloc(1, sizeof(Type)));
+
+#line 74 "./compiler/types.ae"
+  type->base = base;
+
+#line 75 "./compiler/types.ae"
+  type->span = span;
+
+#line 76 "./compiler/types.ae"
+  return type;
+}
+
+
+#line 79 "./compiler/types.ae"
+static __attribute__((unused)) Type *Type__new_link(BaseType base, Type *next, Span span) {
+
+#line 80 "./compiler/types.ae"
+  Type *type = Type__new(base, span);
+
+#line 81 "./compiler/types.ae"
+  type->ptr = next;
+
+#line 84 "./compiler/types.ae"
+  if (((base == BaseType__Pointer && ((bool)next)) && next->base == BaseType__Char)) {
+
+#line 85 "./compiler/types.ae"
+    type->name = "string";
+  } 
+
+#line 87 "./compiler/types.ae"
+  return type;
+}
+
+
+#line 90 "./compiler/types.ae"
+static __attribute__((unused)) Type *Type__ptr_to(BaseType base, Span span) {
+
+#line 91 "./compiler/types.ae"
+  Type *next = Type__new(base, span);
+
+#line 92 "./compiler/types.ae"
+  return Type__new_link(BaseType__Pointer, next, span);
+}
+
+
+#line 97 "./compiler/types.ae"
+static __attribute__((unused)) Type *Type__simd_from_name(char *name, Span span) {
+
+#line 98 "./compiler/types.ae"
+  i32 len = strlen(name);
+
+#line 99 "./compiler/types.ae"
+  i32 sep = 0;
+
+#line 100 "./compiler/types.ae"
+  while (((sep < len) && (name[sep] != 'x'))) {
+
+#line 101 "./compiler/types.ae"
+    sep += 1;
+  } 
+
+#line 103 "./compiler/types.ae"
+  if ((sep == 0 || ((sep + 1) >= len))) 
+
+#line 103 "./compiler/types.ae"
+  return NULL;
+  
+
+#line 104 "./compiler/types.ae"
+  for (i32 i = (sep + 1); (i < len); i += 1) {
+
+#line 105 "./compiler/types.ae"
+    if ((!isdigit(name[i]))) 
+
+#line 105 "./compiler/types.ae"
+    return NULL;
+    
+  } 
+
+#line 108 "./compiler/types.ae"
+  char *elem = string__substring(name, 0, sep);
+
+#line 109 "./compiler/types.ae"
+  BaseType base = ({ BaseType __yield_0;
+
+#line 109 "./compiler/types.ae"
+  {
+    char *__match_str = elem;
+    switch (aecor_hash_str(__match_str, 2166136261u)) {
+      case 1074601716u:
+        if (!strcmp(__match_str, "i8")) goto __match_1_0;
+        break;
+      case 833762287u:
+        if (!strcmp(__match_str, "i16")) goto __match_1_1;
+        break;
+      case 918736459u:
+        if (!strcmp(__match_str, "i32")) goto __match_1_2;
+        break;
+      case 3966529125u:
+        if (!strcmp(__match_str, "i64")) goto __match_1_3;
+        break;
+      case 3926084466u:
+        if (!strcmp(__match_str, "u8")) goto __match_1_4;
+        break;
+      case 4148185419u:
+        if (!strcmp(__match_str, "u16")) goto __match_1_5;
+        break;
+      case 1849896378u:
+        if (!strcmp(__match_str, "u32")) goto __match_1_6;
+        break;
+      case 2500781617u:
+        if (!strcmp(__match_str, "u64")) goto __match_1_7;
+        break;
+      case 859369167u:
+        if (!strcmp(__match_str, "f32")) goto __match_1_8;
+        break;
+      case 861975295u:
+        if (!strcmp(__match_str, "f64")) goto __match_1_9;
+        break;
+    }
+    goto __match_1_default;
+    __match_1_0: {
+      __yield_0 = BaseType__I8;
+} goto __match_1_end;
+    __match_1_1: {
+      __yield_0 = BaseType__I16;
+} goto __match_1_end;
+    __match_1_2: {
+      __yield_0 = BaseType__I32;
+} goto __match_1_end;
+    __match_1_3: {
+      __yield_0 = BaseType__I64;
+} goto __match_1_end;
+    __match_1_4: {
+      __yield_0 = BaseType__U8;
+} goto __match_1_end;
+    __match_1_5: {
+      __yield_0 = BaseType__U16;
+} goto __match_1_end;
+    __match_1_6: {
+      __yield_0 = BaseType__U32;
+} goto __match_1_end;
+    __match_1_7: {
+      __yield_0 = BaseType__U64;
+} goto __match_1_end;
+    __match_1_8: {
+      __yield_0 = BaseType__F32;
+} goto __match_1_end;
+    __match_1_9: {
+      __yield_0 = BaseType__F64;
+} goto __match_1_end;
+    __match_1_default: {
+      __yield_0 = BaseType__Error;
+}
+    __match_1_end:;
+  }
+;__yield_0; });
+
+#line 122 "./compiler/types.ae"
+  free(elem);
+
+#line 123 "./compiler/types.ae"
+  if (base == BaseType__Error) 
+
+#line 123 "./compiler/types.ae"
+  return NULL;
+  
+
+#line 126 "./compiler/types.ae"
+  char *digits = (&name[(sep + 1)]);
+
+#line 127 "./compiler/types.ae"
+  i32 lanes = atoi(digits);
+
+#line 128 "./compiler/types.ae"
+  if ((((lanes < 2) || (lanes > 64)) || ((lanes & (lanes - 1)) != 0))) 
+
+#line 128 "./compiler/types.ae"
+  return NULL;
+  
+
+#line 130 "./compiler/types.ae"
+  Type *type = Type__new_link(BaseType__Simd, Type__new(base, span), span);
+
+#line 131 "./compiler/types.ae"
+  type->lanes = lanes;
+
+#line 132 "./compiler/types.ae"
+  return type;
+}
+
+
+#line 135 "./compiler/types.ae"
+static __attribute__((unused)) bool Type__is_struct_or_ptr(Type *this) {
+
+#line 136 "./compiler/types.ae"
+  if (this->base == BaseType__Structure) 
+
+#line 136 "./compiler/types.ae"
+  return true;
+  
+
+#line 137 "./compiler/types.ae"
+  if ((this->base != BaseType__Pointer)) 
+
+#line 137 "./compiler/types.ae"
+  return false;
+  
+
+#line 138 "./compiler/types.ae"
+  return this->ptr->base == BaseType__Structure;
+}
+
+
+#line 141 "./compiler/types.ae"
+static __attribute__((unused)) bool Type__is_integer(Type *this) {
+
+#line 141 "./compiler/types.ae"
+  return ({ bool __yield_0;
+
+#line 141 "./compiler/types.ae"
+  switch (this->base) {
+    case BaseType__I8:
+    case BaseType__I16:
+    case BaseType__I32:
+    case BaseType__I64:
+    case BaseType__U8:
+    case BaseType__U16:
+    case BaseType__U32:
+    case BaseType__U64: {
+      __yield_0 = true;
+} break;
+    default: {
+      __yield_0 = false;
+} break;
+  }
+;__yield_0; });
+}
+
+
+#line 147 "./compiler/types.ae"
+static __attribute__((unused)) bool Type__is_float(Type *this) {
+
+#line 147 "./compiler/types.ae"
+  return (this->base == BaseType__F32 || this->base == BaseType__F64);
+}
+
+
+#line 149 "./compiler/types.ae"
+static __attribute__((unused)) bool Type__is_numeric(Type *this) {
+
+#line 149 "./compiler/types.ae"
+  return ({ bool __yield_0;
+
+#line 149 "./compiler/types.ae"
+  switch (this->base) {
+    case BaseType__I8:
+    case BaseType__I16:
+    case BaseType__I32:
+    case BaseType__I64:
+    case BaseType__U8:
+    case BaseType__U16:
+    case BaseType__U32:
+    case BaseType__U64:
+    case BaseType__F32:
+    case BaseType__F64: {
+      __yield_0 = true;
+} break;
+    default: {
+      __yield_0 = false;
+} break;
+  }
+;__yield_0; });
+}
+
+
+#line 156 "./compiler/types.ae"
+static __attribute__((unused)) bool Type__is_numeric_or_char(Type *this) {
+
+#line 156 "./compiler/types.ae"
+  return (Type__is_numeric(this) || this->base == BaseType__Char);
+}
+
+
+#line 158 "./compiler/types.ae"
+static __attribute__((unused)) bool Type__eq(Type *this, Type *other) {
+
+#line 159 "./compiler/types.ae"
+  if ((this == NULL && other == NULL)) 
+
+#line 159 "./compiler/types.ae"
+  return true;
+  
+
+#line 160 "./compiler/types.ae"
+  if ((this == NULL || other == NULL)) 
+
+#line 160 "./compiler/types.ae"
+  return false;
+  
+
+#line 161 "./compiler/types.ae"
+  if ((this->base != other->base)) 
+
+#line 161 "./compiler/types.ae"
+  return false;
+  
+
+#line 163 "./compiler/types.ae"
+  switch (this->base) {
+    case BaseType__Method:
+    case BaseType__Error: {
+
+#line 165 "./compiler/types.ae"
+      return false;
+    } break;
+    case BaseType__Array: {
+
+#line 167 "./compiler/types.ae"
+      return Type__eq(this->ptr, other->ptr);
+    } break;
+    case BaseType__Function: {
+
+#line 169 "./compiler/types.ae"
+      if ((!Type__eq(this->return_type, other->return_type))) 
+
+#line 169 "./compiler/types.ae"
+      return false;
+      
+
+#line 170 "./compiler/types.ae"
+      if ((this->params->size != other->params->size)) 
+
+#line 170 "./compiler/types.ae"
+      return false;
+      
+
+#line 171 "./compiler/types.ae"
+      for (i32 i = 0; (i < this->params->size); i += 1) {
+
+#line 172 "./compiler/types.ae"
+        Variable *a = ((Variable *)Vector__at(this->params, i));
+
+#line 173 "./compiler/types.ae"
+        Variable *b = ((Variable *)Vector__at(other->params, i));
+
+#line 174 "./compiler/types.ae"
+        if ((!Type__eq(a->type, b->type))) 
+
+#line 174 "./compiler/types.ae"
+        return false;
+        
+      } 
+
+#line 176 "./compiler/types.ae"
+      return true;
+    } break;
+    case BaseType__Structure: {
+
+#line 178 "./compiler/types.ae"
+      return string__eq(this->name, other->name);
+    } break;
+    case BaseType__Simd: {
+
+#line 179 "./compiler/types.ae"
+      return (this->lanes == other->lanes && Type__eq(this->ptr, other->ptr));
+    } break;
+    case BaseType__Pointer: {
+
+#line 182 "./compiler/types.ae"
+      if ((this->ptr->base == BaseType__Void || other->ptr->base == BaseType__Void)) {
+
+#line 183 "./compiler/types.ae"
+        return true;
+      } 
+
+#line 185 "./compiler/types.ae"
+      return Type__eq(this->ptr, other->ptr);
+    } break;
+    default: {
+
+#line 187 "./compiler/types.ae"
+      return true;
+    } break;
+  }
+}
+
+
+#line 191 "./compiler/types.ae"
+static __attribute__((unused)) char *Type__str(Type *this) {
+
+#line 191 "./compiler/types.ae"
+  return ({ char *__yield_0;
+
+#line 191 "./compiler/types.ae"
+  switch (this->base) {
+    case BaseType__Pointer: {
+      __yield_0 = format_string("&%s", Type__str(this->ptr));
+} break;
+    case BaseType__Array: {
+      __yield_0 = format_string("[%s]", Type__str(this->ptr));
+} break;
+    case BaseType__Simd: {
+      __yield_0 = format_string("%sx%d", Type__str(this->ptr), this->lanes);
+} break;
+    case BaseType__Structure: {
+      __yield_0 = this->name;
+} break;
+    case BaseType__Function: {
+      __yield_0 = "<function>";
+} break;
+    case BaseType__Method: {
+      __yield_0 = "<method>";
+} break;
+    default: {
+      __yield_0 = BaseType__str(this->base);
+} break;
+  }
+;__yield_0; });
+}
+
+
+#line 201 "./compiler/types.ae"
+static __attribute__((unused)) bool Type__is_string(Type *this) {
+
+#line 201 "./compiler/types.ae"
+  return (this->base == BaseType__Pointer && this->ptr->base == BaseType__Char);
+}
+
+
+#line 203 "./compiler/types.ae"
+static __attribute__((unused)) Type *Type__decay_array(Type *this) {
+
+#line 204 "./compiler/types.ae"
+  if ((this->base != BaseType__Array)) 
+
+#line 204 "./compiler/types.ae"
+  return this;
+  
+
+#line 205 "./compiler/types.ae"
+  return Type__new_link(BaseType__Pointer, this->ptr, this->span);
+}
+
+
+#line 208 "./compiler/types.ae"
+static __attribute__((unused)) bool Type__is_enum(Type *this) {
+
+#line 208 "./compiler/types.ae"
+  return ((this->base == BaseType__Structure && ((bool)this->struct_def)) && this->struct_def->is_enum);
+}
+
+
+#line 209 "./compiler/types.ae"
+static __attribute__((unused)) bool Type__is_struct(Type *this) {
+
+#line 209 "./compiler/types.ae"
+  return (this->base == BaseType__Structure && (!Type__is_enum(this)));
+}
+
+
+#line 210 "./compiler/types.ae"
+static __attribute__((unused)) bool Type__is_array(Type *this) {
+
+#line 210 "./compiler/types.ae"
+  return this->base == BaseType__Array;
+}
+
+
+#line 211 "./compiler/types.ae"
+static __attribute__((unused)) bool Type__is_simd(Type *this) {
+
+#line 211 "./compiler/types.ae"
+  return this->base == BaseType__Simd;
+}
+
+
+#line 71 "./compiler/ast.ae"
+static __attribute__((unused)) ASTType ASTType__from_token(TokenType type) {
+
+#line 71 "./compiler/ast.ae"
+  return ({ ASTType __yield_0;
+
+#line 71 "./compiler/ast.ae"
+  switch (type) {
+    case TokenType__Ampersand: {
+      __yield_0 = ASTType__BitwiseAnd;
+} break;
+    case TokenType__And: {
+      __yield_0 = ASTType__And;
+} break;
+    case TokenType__Caret: {
+      __yield_0 = ASTType__BitwiseXor;
+} break;
+    case TokenType__EqualEquals: {
+      __yield_0 = ASTType__Equals;
+} break;
+    case TokenType__Equals: {
+      __yield_0 = ASTType__Assignment;
+} break;
+    case TokenType__GreaterThan: {
+      __yield_0 = ASTType__GreaterThan;
+} break;
+    case TokenType__GreaterThanEquals: {
+      __yield_0 = ASTType__GreaterThanEquals;
+} break;
+    case TokenType__GreaterThanGreaterThan: {
+      __yield_0 = ASTType__RightShift;
+} break;
+    case TokenType__LessThan: {
+      __yield_0 = ASTType__LessThan;
+} break;
+    case TokenType__LessThanEquals: {
+      __yield_0 = ASTType__LessThanEquals;
+} break;
+    case TokenType__LessThanLessThan: {
+      __yield_0 = ASTType__LeftShift;
+} break;
+    case TokenType__Line: {
+      __yield_0 = ASTType__BitwiseOr;
+} break;
+    case TokenType__Minus: {
+      __yield_0 = ASTType__Minus;
+} break;
+    case TokenType__MinusEquals: {
+      __yield_0 = ASTType__MinusEquals;
+} break;
+    case TokenType__NotEquals: {
+      __yield_0 = ASTType__NotEquals;
+} break;
+    case TokenType__Or: {
+      __yield_0 = ASTType__Or;
+} break;
+    case TokenType__Percent: {
+      __yield_0 = ASTType__Modulus;
+} break;
+    case TokenType__Plus: {
+      __yield_0 = ASTType__Plus;
+} break;
+    case TokenType__PlusEquals: {
+      __yield_0 = ASTType__PlusEquals;
+} break;
+    case TokenType__Slash: {
+      __yield_0 = ASTType__Divide;
+} break;
+    case TokenType__SlashEquals: {
+      __yield_0 = ASTType__DivideEquals;
+} break;
+    case TokenType__Star: {
+      __yield_0 = ASTType__Multiply;
+} break;
+    case TokenType__StarEquals: {
+      __yield_0 = ASTType__MultiplyEquals;
+} break;
+    case TokenType__Tilde: {
+      __yield_0 = ASTType__BitwiseNot;
+} break;
+    default: panic(format_string("Unhandled token type in ASTType::from_token: %s", TokenType__str(type))); break;
+  }
+;__yield_0; });
+}
+
+
+#line 115 "./compiler/ast.ae"
+static __attribute__((unused)) Variable *Variable__new(char *name, Type *type, Span span) {
+
+#line 116 "./compiler/ast.ae"
+  Variable *var = ((Variable *)calloc(1, sizeof(Variable)));
+
+#line 117 "./compiler/ast.ae"
+  var->name = name;
+
+#line 118 "./compiler/ast.ae"
+  var->type = type;
+
+#line 119 "./compiler/ast.ae"
+  var->span = span;
+
+#line 120 "./compiler/ast.ae"
+  return var;
+}
+
+
+#line 162 "./compiler/ast.ae"
+static __attribute__((unused)) Function *Function__new(Span span) {
+
+#line 163 "./compiler/ast.ae"
+  Function *func = ((Function *)calloc(1, sizeof(Function)));
+
+#line 164 "./compiler/ast.ae"
+  func->params = Vector__new();
+
+#line 165 "./compiler/ast.ae"
+  func->span = span;
+
+#line 166 "./compiler/ast.ae"
+  return func;
+}
+
+
+#line 190 "./compiler/ast.ae"
+static __attribute__((unused)) Structure *Structure__new(Span span) {
+
+#line 191 "./compiler/ast.ae"
+  Structure *struc = ((Structure *)calloc(1, sizeof(Structure)));
+
+#line 192 "./compiler/ast.ae"
+  struc->fields = Vector__new();
+
+#line 193 "./compiler/ast.ae"
+  struc->span = span;
+
+#line 194 "./compiler/ast.ae"
+  return struc;
+}
+
+
+#line 197 "./compiler/ast.ae"
+static __attribute__((unused)) Variable *Structure__find_field(Structure *this, char *name) {
+
+#line 198 "./compiler/ast.ae"
+  for (i32 i = 0; (i < this->fields->size); i += 1) {
+
+#line 199 "./compiler/ast.ae"
+    Variable *field = ((Variable *)Vector__at(this->fields, i));
+
+#line 200 "./compiler/ast.ae"
+    if (string__eq(field->name, name)) {
+
+#line 201 "./compiler/ast.ae"
+      return field;
+    } 
+  } 
+
+#line 204 "./compiler/ast.ae"
+  return NULL;
+}
+
+
+#line 224 "./compiler/ast.ae"
+static __attribute__((unused)) Program *Program__new(void) {
+
+#line 225 "./compiler/ast.ae"
+  Program *prog = ((Program *)calloc(1, sizeof(Program)));
+
+#line 226 "./compiler/ast.ae"
+  prog->functions = Vector__new();
+
+#line 227 "./compiler/ast.ae"
+  prog->structures = Vector__new();
+
+#line 228 "./compiler/ast.ae"
+  prog->global_vars = Vector__new();
+
+#line 229 "./compiler/ast.ae"
+  prog->constants = Vector__new();
+
+#line 231 "./compiler/ast.ae"
+  prog->included_files = Map__new();
+
+#line 232 "./compiler/ast.ae"
+  prog->errors = Vector__new();
+
+#line 234 "./compiler/ast.ae"
+  prog->c_flags = Vector__new();
+
+#line 235 "./compiler/ast.ae"
+  prog->c_includes = Vector__new();
+
+#line 236 "./compiler/ast.ae"
+  prog->c_embed_headers = Vector__new();
+
+#line 237 "./compiler/ast.ae"
+  return prog;
+}
+
+
+#line 240 "./compiler/ast.ae"
+static __attribute__((unused)) bool Program__is_file_included(Program *this, char *filename) {
+
+#line 241 "./compiler/ast.ae"
+  i32 len = strlen(filename);
+
+#line 242 "./compiler/ast.ae"
+  if ((((len > 2) && filename[0] == '.') && filename[1] == '/')) {
+
+#line 243 "./compiler/ast.ae"
+    filename = (&filename[2]);
+  } 
+
+#line 245 "./compiler/ast.ae"
+  return Map__exists(this->included_files, filename);
+}
+
+
+#line 248 "./compiler/ast.ae"
+static __attribute__((unused)) void Program__add_included_file(Program *this, char *filename) {
+
+#line 249 "./compiler/ast.ae"
+  i32 len = strlen(filename);
+
+#line 250 "./compiler/ast.ae"
+  if ((((len > 2) && filename[0] == '.') && filename[1] == '/')) {
+
+#line 251 "./compiler/ast.ae"
+    filename = (&filename[2]);
+  } 
+
+#line 253 "./compiler/ast.ae"
+  Map__insert(this->included_files, filename, filename);
+}
+
+
+#line 282 "./compiler/ast.ae"
+static __attribute__((unused)) Argument *Argument__new(AST *label, AST *expr) {
+
+#line 283 "./compiler/ast.ae"
+  Argument *arg = ((Argument *)calloc(1, sizeof(Argument)));
+
+#line 284 "./compiler/ast.ae"
+  arg->expr = expr;
+
+#line 285 "./compiler/ast.ae"
+  arg->label = label;
+
+#line 286 "./compiler/ast.ae"
+  return arg;
+}
+
+
+#line 365 "./compiler/ast.ae"
+static __attribute__((unused)) MatchCase *MatchCase__new(AST *cond, AST *body) {
+
+#line 366 "./compiler/ast.ae"
+  MatchCase *_case = ((MatchCase *)calloc(1, sizeof(MatchCase)));
+
+#line 367 "./compiler/ast.ae"
+  _case->cond = cond;
+
+#line 368 "./compiler/ast.ae"
+  _case->body = body;
+
+#line 369 "./compiler/ast.ae"
+  return _case;
+}
+
+
+#line 424 "./compiler/ast.ae"
+static __attribute__((unused)) AST *AST__alloc(void) {
+
+#line 425 "./compiler/ast.ae"
+  if (((!((bool)ast_chunk)) || ast_chunk_used == AST_CHUNK_SIZE)) {
+
+#line 426 "./compiler/ast.ae"
+    ast_chunk = ((AST *)calloc(AST_CHUNK_SIZE, sizeof(AST)));
+
+#line 427 "./compiler/ast.ae"
+    ast_chunk_used = 0;
+  } 
+
+#line 429 "./compiler/ast.ae"
+  AST *ast = (&ast_chunk[ast_chunk_used]);
+
+#line 430 "./compiler/ast.ae"
+  ast_chunk_used += 1;
+
+#line 431 "./compiler/ast.ae"
+  return ast;
+}
+
+
+#line 434 "./compiler/ast.ae"
+static __attribute__((unused)) AST *AST__new(ASTType type, Span span) {
+
+#line 435 "./compiler/ast.ae"
+  AST *ast = AST__alloc();
+
+#line 436 "./compiler/ast.ae"
+  ast->type = type;
+
+#line 437 "./compiler/ast.ae"
+  ast->span = span;
+
+#line 438 "./compiler/ast.ae"
+  switch (type) {
+    case ASTType__Match: {
+
+#line 439 "./compiler/ast.ae"
+      ast->u.match_stmt = ((Match *)calloc(1, sizeof(Match)));
+    } break;
+    case ASTType__While:
+    case ASTType__For: {
+
+#line 440 "./compiler/ast.ae"
+      ast->u.loop = ((Loop *)calloc(1, sizeof(Loop)));
+    } break;
+    case ASTType__ForIn: {
+
+#line 441 "./compiler/ast.ae"
+      ast->u.for_in = ((ForIn *)calloc(1, sizeof(ForIn)));
+    } break;
+    default: {
+    } break;
+  }
+
+#line 444 "./compiler/ast.ae"
+  return ast;
+}
+
+
+#line 447 "./compiler/ast.ae"
+static __attribute__((unused)) AST *AST__new_unop(ASTType type, Span span, AST *expr) {
+
+#line 448 "./compiler/ast.ae"
+  AST *ast = AST__new(type, span);
+
+#line 449 "./compiler/ast.ae"
+  ast->u.unary = expr;
+
+#line 450 "./compiler/ast.ae"
+  return ast;
+}
+
+
+#line 453 "./compiler/ast.ae"
+static __attribute__((unused)) AST *AST__new_binop(ASTType type, AST *lhs, AST *rhs) {
+
+#line 454 "./compiler/ast.ae"
+  AST *ast = AST__new(type, Span__join(&lhs->span, &rhs->span));
+
+#line 455 "./compiler/ast.ae"
+  ast->u.binary.lhs = lhs;
+
+#line 456 "./compiler/ast.ae"
+  ast->u.binary.rhs = rhs;
+
+#line 457 "./compiler/ast.ae"
+  return ast;
+}
+
+
+#line 460 "./compiler/ast.ae"
+static __attribute__((unused)) bool AST__callee_is(AST *this, char *expected) {
+
+#line 461 "./compiler/ast.ae"
+  if ((!((bool)this))) 
+
+#line 461 "./compiler/ast.ae"
+  return false;
+  
+
+#line 462 "./compiler/ast.ae"
+  if ((this->type != ASTType__Call)) 
+
+#line 462 "./compiler/ast.ae"
+  return false;
+  
+
+#line 463 "./compiler/ast.ae"
+  if ((this->u.call.callee->type != ASTType__Identifier)) 
+
+#line 463 "./compiler/ast.ae"
+  return false;
+  
+
+#line 464 "./compiler/ast.ae"
+  char *name = this->u.call.callee->u.ident.name;
+
+#line 465 "./compiler/ast.ae"
+  return string__eq(name, expected);
+}
+
+
+#line 468 "./compiler/ast.ae"
+static __attribute__((unused)) bool AST__is_lvalue(AST *this) {
+
+#line 468 "./compiler/ast.ae"
+  return ({ bool __yield_0;
+
+#line 468 "./compiler/ast.ae"
+  switch (this->type) {
+    case ASTType__Dereference: {
+      __yield_0 = true;
+} break;
+    case ASTType__Index: {
+      __yield_0 = true;
+} break;
+    case ASTType__Member: {
+      __yield_0 = (!this->u.member.is_method);
+} break;
+    case ASTType__Identifier: {
+      __yield_0 = (!((bool)this->u.ident.func));
+} break;
+    default: {
+      __yield_0 = false;
+} break;
+  }
+;__yield_0; });
+}
+
+
+#line 15 "./compiler/parser.ae"
+static __attribute__((unused)) ParserContext *ParserContext__new(Vector *tokens, i32 offset) {
+
+#line 16 "./compiler/parser.ae"
+  ParserContext *context = ((ParserContext *)calloc(1, sizeof(ParserContext)));
+
+#line 17 "./compiler/parser.ae"
+  (*context) = (ParserContext){tokens, offset};
+
+#line 18 "./compiler/parser.ae"
+  return context;
+}
+
+
+#line 31 "./compiler/parser.ae"
+static __attribute__((unused)) Template *Template__new(char *name, Vector *params, Vector *tokens, i32 start) {
+
+#line 32 "./compiler/parser.ae"
+  Template *template = ((Template *)calloc(1, sizeof(Template)));
+
+#line 33 "./compiler/parser.ae"
+  (*template) = (Template){name, params, tokens, start, .is_struct = false};
+
+#line 34 "./compiler/parser.ae"
+  return template;
+}
+
+
+#line 68 "./compiler/parser.ae"
+static __attribute__((unused)) Parser *Parser__new(char *filename) {
+
+#line 69 "./compiler/parser.ae"
+  Parser *parser = ((Parser *)calloc(1, sizeof(Parser)));
+
+#line 71 "./compiler/parser.ae"
+  parser->include_dirs = Vector__new();
+
+#line 72 "./compiler/parser.ae"
+  Parser__add_include_dir(parser, ".");
+
+#line 76 "./compiler/parser.ae"
+  char *tmp_filename = strdup(filename);
+
+#line 77 "./compiler/parser.ae"
+  parser->project_root = strdup(dirname(tmp_filename));
+
+#line 78 "./compiler/parser.ae"
+  free(tmp_filename);
+
+#line 80 "./compiler/parser.ae"
+  char *aecor_root = getenv("AECOR_ROOT");
+
+#line 81 "./compiler/parser.ae"
+  if (((bool)aecor_root)) {
+
+#line 82 "./compiler/parser.ae"
+    Parser__add_include_dir(parser, aecor_root);
+  } 
+
+#line 85 "./compiler/parser.ae"
+  parser->context_stack = Vector__new();
+
+#line 86 "./compiler/parser.ae"
+  parser->templates = Map__new();
+
+#line 87 "./compiler/parser.ae"
+  parser->method_templates = Map__new();
+
+#line 88 "./compiler/parser.ae"
+  parser->instances = Map__new();
+
+#line 89 "./compiler/parser.ae"
+  parser->pending_instances = Vector__new();
+
+#line 90 "./compiler/parser.ae"
+  return parser;
+}
+
+
+#line 93 "./compiler/parser.ae"
+static __attribute__((unused)) void Parser__push_context(Parser *this, Vector *tokens) {
+
+#line 94 "./compiler/parser.ae"
+  ParserContext *cur_context = ParserContext__new(this->tokens, this->curr);
+
+#line 95 "./compiler/parser.ae"
+  Vector__push(this->context_stack, cur_context);
+
+#line 97 "./compiler/parser.ae"
+  this->tokens = tokens;
+
+#line 98 "./compiler/parser.ae"
+  this->curr = 0;
+}
+
+
+#line 101 "./compiler/parser.ae"
+static __attribute__((unused)) void Parser__pop_context(Parser *this) {
+
+#line 102 "./compiler/parser.ae"
+  ParserContext *cur_context = ((ParserContext *)Vector__pop(this->context_stack));
+
+#line 103 "./compiler/parser.ae"
+  this->tokens = cur_context->tokens;
+
+#line 104 "./compiler/parser.ae"
+  this->curr = cur_context->offset;
+
+#line 105 "./compiler/parser.ae"
+  free(cur_context);
+}
+
+
+#line 108 "./compiler/parser.ae"
+static __attribute__((unused)) void Parser__add_include_dir(Parser *this, char *dir) {
+
+#line 109 "./compiler/parser.ae"
+  Vector__push(this->include_dirs, dir);
+}
+
+
+#line 112 "./compiler/parser.ae"
+static __attribute__((unused)) Error *Parser__error_msg(Parser *this, char *msg) {
+
+#line 113 "./compiler/parser.ae"
+  Error *err = Error__new(Parser__token(this)->span, msg);
+
+#line 114 "./compiler/parser.ae"
+  Vector__push(this->program->errors, err);
+
+#line 115 "./compiler/parser.ae"
+  return err;
+}
+
+
+#line 118 "./compiler/parser.ae"
+static __attribute__((unused)) void Parser__error(Parser *this, Error *err) {
+
+#line 119 "./compiler/parser.ae"
+  Vector__push(this->program->errors, err);
+}
+
+
+#line 122 "./compiler/parser.ae"
+static __attribute__((unused)) void Parser__unhandled_type(Parser *this, char *func) {
+
+#line 123 "./compiler/parser.ae"
+  Parser__error_msg(this, format_string("Unexpected token in %s: %s", func, TokenType__str(Parser__token(this)->type)));
+}
+
+
+#line 126 "./compiler/parser.ae"
+static inline __attribute__((unused)) __attribute__((always_inline)) Token *Parser__token(Parser *this) {
+
+#line 126 "./compiler/parser.ae"
+  return Vector__at(this->tokens, this->curr);
+}
+
+
+#line 128 "./compiler/parser.ae"
+static inline __attribute__((unused)) __attribute__((always_inline)) bool Parser__token_is(Parser *this, TokenType type) {
+
+#line 129 "./compiler/parser.ae"
+  if (type == TokenType__Newline) {
+
+#line 130 "./compiler/parser.ae"
+    return Parser__token(this)->seen_newline;
+  } 
+
+#line 132 "./compiler/parser.ae"
+  return Parser__token(this)->type == type;
+}
+
+
+#line 135 "./compiler/parser.ae"
+static __attribute__((unused)) bool Parser__consume_if(Parser *this, TokenType type) {
+
+#line 136 "./compiler/parser.ae"
+  if (Parser__token_is(this, type)) {
+
+#line 138 "./compiler/parser.ae"
+    if ((type != TokenType__Newline)) {
+
+#line 139 "./compiler/parser.ae"
+      this->curr += 1;
+    } 
+
+#line 141 "./compiler/parser.ae"
+    return true;
+  } 
+
+#line 143 "./compiler/parser.ae"
+  return false;
+}
+
+
+#line 146 "./compiler/parser.ae"
+static __attribute__((unused)) void Parser__consume_newline_or(Parser *this, TokenType type) {
+
+#line 147 "./compiler/parser.ae"
+  if (Parser__token_is(this, type)) {
+
+#line 148 "./compiler/parser.ae"
+    this->curr += 1;
+  }  else 
+#line 149 "./compiler/parser.ae"
+  if ((!Parser__token(this)->seen_newline)) {
+
+#line 150 "./compiler/parser.ae"
+    Error__panic(Parser__error_msg(this, format_string("Expected %s or newline", TokenType__str(type))));
+  } 
+  
+}
+
+
+#line 154 "./compiler/parser.ae"
+static __attribute__((unused)) Token *Parser__consume(Parser *this, TokenType type) {
+
+#line 155 "./compiler/parser.ae"
+  Token *tok = Parser__token(this);
+
+#line 156 "./compiler/parser.ae"
+  if ((!Parser__consume_if(this, type))) {
+
+#line 157 "./compiler/parser.ae"
+    Error__panic(Parser__error_msg(this, format_string("Expected TokenType::%s", TokenType__str(type))));
+  } 
+
+#line 159 "./compiler/parser.ae"
+  return tok;
+}
+
+
+#line 162 "./compiler/parser.ae"
+static __attribute__((unused)) Type *Parser__parse_type_with_parent(Parser *this, Type *parent) {
+
+#line 163 "./compiler/parser.ae"
+  Type *type = ((Type *)NULL);
+
+#line 164 "./compiler/parser.ae"
+  Span span = Parser__token(this)->span;
+
+#line 166 "./compiler/parser.ae"
+  switch (Parser__token(this)->type) {
+    case TokenType__Ampersand: {
+
+#line 168 "./compiler/parser.ae"
+      type = Type__new(BaseType__Pointer, Parser__consume(this, TokenType__Ampersand)->span);
+
+#line 169 "./compiler/parser.ae"
+      Parser__parse_type_with_parent(this, type);
+    } break;
+    case TokenType__Bool: {
+
+#line 171 "./compiler/parser.ae"
+      type = Type__new(BaseType__Bool, Parser__consume(this, TokenType__Bool)->span);
+    } break;
+    case TokenType__Char: {
+
+#line 172 "./compiler/parser.ae"
+      type = Type__new(BaseType__Char, Parser__consume(this, TokenType__Char)->span);
+    } break;
+    case TokenType__I8: {
+
+#line 174 "./compiler/parser.ae"
+      type = Type__new(BaseType__I8, Parser__consume(this, TokenType__I8)->span);
+    } break;
+    case TokenType__I16: {
+
+#line 175 "./compiler/parser.ae"
+      type = Type__new(BaseType__I16, Parser__consume(this, TokenType__I16)->span);
+    } break;
+    case TokenType__I32: {
+
+#line 176 "./compiler/parser.ae"
+      type = Type__new(BaseType__I32, Parser__consume(this, TokenType__I32)->span);
+    } break;
+    case TokenType__I64: {
+
+#line 177 "./compiler/parser.ae"
+      type = Type__new(BaseType__I64, Parser__consume(this, TokenType__I64)->span);
+    } break;
+    case TokenType__U8: {
+
+#line 179 "./compiler/parser.ae"
+      type = Type__new(BaseType__U8, Parser__consume(this, TokenType__U8)->span);
+    } break;
+    case TokenType__U16: {
+
+#line 180 "./compiler/parser.ae"
+      type = Type__new(BaseType__U16, Parser__consume(this, TokenType__U16)->span);
+    } break;
+    case TokenType__U32: {
+
+#line 181 "./compiler/parser.ae"
+      type = Type__new(BaseType__U32, Parser__consume(this, TokenType__U32)->span);
+    } break;
+    case TokenType__U64: {
+
+#line 182 "./compiler/parser.ae"
+      type = Type__new(BaseType__U64, Parser__consume(this, TokenType__U64)->span);
+    } break;
+    case TokenType__F32: {
+
+#line 184 "./compiler/parser.ae"
+      type = Type__new(BaseType__F32, Parser__consume(this, TokenType__F32)->span);
+    } break;
+    case TokenType__F64: {
+
+#line 185 "./compiler/parser.ae"
+      type = Type__new(BaseType__F64, Parser__consume(this, TokenType__F64)->span);
+    } break;
+    case TokenType__UntypedPtr: {
+
+#line 187 "./compiler/parser.ae"
+      type = Type__ptr_to(BaseType__Void, Parser__consume(this, TokenType__UntypedPtr)->span);
+    } break;
+    case TokenType__String: {
+
+#line 189 "./compiler/parser.ae"
+      type = Type__ptr_to(BaseType__Char, Parser__consume(this, TokenType__String)->span);
+
+#line 190 "./compiler/parser.ae"
+      type->ptr->name = "string";
+    } break;
+    case TokenType__Identifier: {
+
+#line 193 "./compiler/parser.ae"
+      Token *name = Parser__consume(this, TokenType__Identifier);
+
+#line 194 "./compiler/parser.ae"
+      if ((((bool)this->type_params) && Map__exists(this->type_params, name->text))) {
+
+#line 195 "./compiler/parser.ae"
+        type = ((Type *)Map__get(this->type_params, name->text));
+      }  else 
+#line 196 "./compiler/parser.ae"
+      if ((Parser__token_is(this, TokenType__LessThan) && Map__exists(this->templates, name->text))) {
+
+#line 197 "./compiler/parser.ae"
+        Vector *args = Parser__parse_type_args(this);
+
+#line 198 "./compiler/parser.ae"
+        type = Type__new(BaseType__Structure, span);
+
+#line 199 "./compiler/parser.ae"
+        type->name = Parser__instantiate(this, name->text, args, span);
+      }  else {
+
+#line 201 "./compiler/parser.ae"
+        type = Type__simd_from_name(name->text, span);
+
+#line 202 "./compiler/parser.ae"
+        if ((!((bool)type))) {
+
+#line 203 "./compiler/parser.ae"
+          type = Type__new(BaseType__Structure, span);
+
+#line 204 "./compiler/parser.ae"
+          type->name = name->text;
+        } 
+      } 
+      
+    } break;
+    case TokenType__Fn: {
+
+#line 209 "./compiler/parser.ae"
+      Parser__consume(this, TokenType__Fn);
+
+#line 210 "./compiler/parser.ae"
+      Parser__consume(this, TokenType__OpenParen);
+
+#line 211 "./compiler/parser.ae"
+      Vector *params = Vector__new();
+
+#line 212 "./compiler/parser.ae"
+      while ((!Parser__token_is(this, TokenType__CloseParen))) {
+
+#line 213 "./compiler/parser.ae"
+        Type *param_type = Parser__parse_type(this);
+
+#line 215 "./compiler/parser.ae"
+        Vector__push(params, Variable__new("", param_type, param_type->span));
+
+#line 216 "./compiler/parser.ae"
+        if ((!Parser__token_is(this, TokenType__CloseParen))) {
+
+#line 217 "./compiler/parser.ae"
+          Parser__consume(this, TokenType__Comma);
+        } 
+      } 
+
+#line 220 "./compiler/parser.ae"
+      Parser__consume(this, TokenType__CloseParen);
+
+#line 221 "./compiler/parser.ae"
+      Type *return_type;
+
+#line 222 "./compiler/parser.ae"
+      if (Parser__consume_if(this, TokenType__Colon)) {
+
+#line 223 "./compiler/parser.ae"
+        return_type = Parser__parse_type(this);
+      }  else {
+
+#line 225 "./compiler/parser.ae"
+        return_type = Type__new(BaseType__Void, Parser__token(this)->span);
+      } 
+
+#line 227 "./compiler/parser.ae"
+      type = Type__new(BaseType__Function, Span__join(&span, &Parser__token(this)->span));
+
+#line 228 "./compiler/parser.ae"
+      type->params = params;
+
+#line 229 "./compiler/parser.ae"
+      type->return_type = return_type;
+    } break;
+    case TokenType__OpenSquare: {
+
+#line 232 "./compiler/parser.ae"
+      Parser__consume(this, TokenType__OpenSquare);
+
+#line 234 "./compiler/parser.ae"
+      type = Type__new(BaseType__Array, span);
+
+#line 235 "./compiler/parser.ae"
+      Parser__parse_type_with_parent(this, type);
+
+#line 237 "./compiler/parser.ae"
+      Parser__consume(this, TokenType__Semicolon);
+
+#line 238 "./compiler/parser.ae"
+      type->size_expr = Parser__parse_expression(this, TokenType__CloseSquare);
+
+#line 240 "./compiler/parser.ae"
+      type->span = Span__join(&type->span, &Parser__token(this)->span);
+
+#line 241 "./compiler/parser.ae"
+      Parser__consume(this, TokenType__CloseSquare);
+    } break;
+    default: {
+
+#line 244 "./compiler/parser.ae"
+      Parser__unhandled_type(this, "parse_type");
+
+#line 245 "./compiler/parser.ae"
+      type = Type__new(BaseType__Error, Parser__token(this)->span);
+    } break;
+  }
+
+#line 249 "./compiler/parser.ae"
+  if (((bool)parent)) {
+
+#line 250 "./compiler/parser.ae"
+    parent->ptr = type;
+
+#line 251 "./compiler/parser.ae"
+    parent->span = Span__join(&parent->span, &type->span);
+  } 
+
+#line 253 "./compiler/parser.ae"
+  return type;
+}
+
+
+#line 256 "./compiler/parser.ae"
+static __attribute__((unused)) Type *Parser__parse_type(Parser *this) {
+
+#line 256 "./compiler/parser.ae"
+  return Parser__parse_type_with_parent(this, NULL);
+}
+
+
+#line 261 "./compiler/parser.ae"
+static __attribute__((unused)) i32 Parser__skip_type_args(Parser *this, i32 start) {
+
+#line 262 "./compiler/parser.ae"
+  i32 depth = 0;
+
+#line 263 "./compiler/parser.ae"
+  for (i32 i = start; (i < this->tokens->size); i += 1) {
+
+#line 264 "./compiler/parser.ae"
+    Token *tok = ((Token *)Vector__at(this->tokens, i));
+
+#line 265 "./compiler/parser.ae"
+    switch (tok->type) {
+      case TokenType__LessThan: {
+
+#line 266 "./compiler/parser.ae"
+        depth += 1;
+      } break;
+      case TokenType__GreaterThan: {
+
+#line 267 "./compiler/parser.ae"
+        depth -= 1;
+      } break;
+      case TokenType__GreaterThanGreaterThan: {
+
+#line 268 "./compiler/parser.ae"
+        depth -= 2;
+      } break;
+      case TokenType__Identifier:
+      case TokenType__Ampersand:
+      case TokenType__Comma:
+      case TokenType__Bool:
+      case TokenType__Char:
+      case TokenType__String:
+      case TokenType__UntypedPtr:
+      case TokenType__I8:
+      case TokenType__I16:
+      case TokenType__I32:
+      case TokenType__I64:
+      case TokenType__U8:
+      case TokenType__U16:
+      case TokenType__U32:
+      case TokenType__U64:
+      case TokenType__F32:
+      case TokenType__F64: {
+      } break;
+      default: {
+
+#line 271 "./compiler/parser.ae"
+        return (-1);
+      } break;
+    }
+
+#line 273 "./compiler/parser.ae"
+    if (depth == 0) 
+
+#line 273 "./compiler/parser.ae"
+    return (i + 1);
+    
+
+#line 274 "./compiler/parser.ae"
+    if ((depth < 0)) 
+
+#line 274 "./compiler/parser.ae"
+    return (-1);
+    
+  } 
+
+#line 276 "./compiler/parser.ae"
+  return (-1);
+}
+
+
+#line 280 "./compiler/parser.ae"
+static __attribute__((unused)) void Parser__consume_closing_angle(Parser *this) {
+
+#line 281 "./compiler/parser.ae"
+  if (this->pending_greater) {
+
+#line 282 "./compiler/parser.ae"
+    this->pending_greater = false;
+  }  else 
+#line 283 "./compiler/parser.ae"
+  if (Parser__consume_if(this, TokenType__GreaterThanGreaterThan)) {
+
+#line 284 "./compiler/parser.ae"
+    this->pending_greater = true;
+  }  else {
+
+#line 286 "./compiler/parser.ae"
+    Parser__consume(this, TokenType__GreaterThan);
+  } 
+  
+}
+
+
+#line 290 "./compiler/parser.ae"
+static __attribute__((unused)) Vector *Parser__parse_type_args(Parser *this) {
+
+#line 291 "./compiler/parser.ae"
+  Vector *args = Vector__new();
+
+#line 292 "./compiler/parser.ae"
+  Parser__consume(this, TokenType__LessThan);
+
+#line 293 "./compiler/parser.ae"
+  while (true) {
+
+#line 294 "./compiler/parser.ae"
+    Vector__push(args, Parser__parse_type(this));
+
+#line 295 "./compiler/parser.ae"
+    if ((this->pending_greater || (!Parser__consume_if(this, TokenType__Comma)))) 
+
+#line 295 "./compiler/parser.ae"
+    break;
+    
+  } 
+
+#line 297 "./compiler/parser.ae"
+  Parser__consume_closing_angle(this);
+
+#line 298 "./compiler/parser.ae"
+  return args;
+}
+
+
+#line 301 "./compiler/parser.ae"
+static __attribute__((unused)) Vector *Parser__parse_type_params(Parser *this) {
+
+#line 302 "./compiler/parser.ae"
+  Vector *params = Vector__new();
+
+#line 303 "./compiler/parser.ae"
+  Parser__consume(this, TokenType__LessThan);
+
+#line 304 "./compiler/parser.ae"
+  while ((!Parser__token_is(this, TokenType__GreaterThan))) {
+
+#line 305 "./compiler/parser.ae"
+    Vector__push(params, Parser__consume(this, TokenType__Identifier)->text);
+
+#line 306 "./compiler/parser.ae"
+    if ((!Parser__token_is(this, TokenType__GreaterThan))) {
+
+#line 307 "./compiler/parser.ae"
+      Parser__consume(this, TokenType__Comma);
+    } 
+  } 
+
+#line 310 "./compiler/parser.ae"
+  Parser__consume(this, TokenType__GreaterThan);
+
+#line 311 "./compiler/parser.ae"
+  return params;
+}
+
+
+#line 314 "./compiler/parser.ae"
+static __attribute__((unused)) char *Parser__mangle_type(Parser *this, Type *type) {
+
+#line 314 "./compiler/parser.ae"
+  return ({ char *__yield_0;
+
+#line 314 "./compiler/parser.ae"
+  switch (type->base) {
+    case BaseType__Pointer: {
+      __yield_0 = format_string("ptr_%s", Parser__mangle_type(this, type->ptr));
+} break;
+    case BaseType__Structure: {
+      __yield_0 = type->name;
+} break;
+    case BaseType__Simd: {
+      __yield_0 = Type__str(type);
+} break;
+    case BaseType__Function:
+    case BaseType__Method:
+    case BaseType__Array:
+    case BaseType__Error: {
+
+#line 319 "./compiler/parser.ae"
+      Parser__error(this, Error__new(type->span, "Unsupported type argument for generic"));
+
+#line 320 "./compiler/parser.ae"
+      __yield_0 = "error";
+    } break;
+    default: {
+      __yield_0 = BaseType__str(type->base);
+} break;
+  }
+;__yield_0; });
+}
+
+
+#line 326 "./compiler/parser.ae"
+static __attribute__((unused)) char *Parser__instantiate(Parser *this, char *name, Vector *args, Span span) {
+
+#line 328 "./compiler/parser.ae"
+  if (this->defining_template) 
+
+#line 328 "./compiler/parser.ae"
+  return name;
+  
+
+#line 330 "./compiler/parser.ae"
+  Buffer mangled = Buffer__make();
+
+#line 331 "./compiler/parser.ae"
+  Buffer__puts((&mangled), name);
+
+#line 332 "./compiler/parser.ae"
+  Buffer__puts((&mangled), "_");
+
+#line 333 "./compiler/parser.ae"
+  for (i32 i = 0; (i < args->size); i += 1) {
+
+#line 334 "./compiler/parser.ae"
+    ({ Buffer *__fmt_buf = (&mangled); Buffer__puts(__fmt_buf, "_"); Buffer__put_str(__fmt_buf, Parser__mangle_type(this, ((Type *)Vector__at(args, i)))); });
+  } 
+
+#line 336 "./compiler/parser.ae"
+  char *instance_name = Buffer__str((&mangled));
+
+#line 337 "./compiler/parser.ae"
+  if ((!Map__exists(this->instances, instance_name))) {
+
+#line 338 "./compiler/parser.ae"
+    Instance *instance = ((Instance *)calloc(1, sizeof(Instance)));
+
+#line 339 "./compiler/parser.ae"
+    (*instance) = (Instance){name, args, instance_name, span};
+
+#line 340 "./compiler/parser.ae"
+    Map__insert(this->instances, instance_name, instance);
+
+#line 341 "./compiler/parser.ae"
+    Vector__push(this->pending_instances, instance);
+  } 
+
+#line 343 "./compiler/parser.ae"
+  return instance_name;
+}
+
+
+#line 348 "./compiler/parser.ae"
+static __attribute__((unused)) void Parser__begin_template_definition(Parser *this, Vector *params) {
+
+#line 349 "./compiler/parser.ae"
+  this->defining_template = true;
+
+#line 350 "./compiler/parser.ae"
+  this->type_params = Map__new();
+
+#line 351 "./compiler/parser.ae"
+  for (i32 i = 0; (i < params->size); i += 1) {
+
+#line 352 "./compiler/parser.ae"
+    char *param = ((char *)Vector__at(params, i));
+
+#line 353 "./compiler/parser.ae"
+    Type *placeholder = Type__new(BaseType__Structure, Parser__token(this)->span);
+
+#line 354 "./compiler/parser.ae"
+    placeholder->name = param;
+
+#line 355 "./compiler/parser.ae"
+    Map__insert(this->type_params, param, placeholder);
+  } 
+}
+
+
+#line 359 "./compiler/parser.ae"
+static __attribute__((unused)) void Parser__end_template_definition(Parser *this) {
+
+#line 360 "./compiler/parser.ae"
+  Map__free(this->type_params);
+
+#line 361 "./compiler/parser.ae"
+  this->type_params = NULL;
+
+#line 362 "./compiler/parser.ae"
+  this->defining_template = false;
+}
+
+
+#line 365 "./compiler/parser.ae"
+static __attribute__((unused)) Template *Parser__register_template(Parser *this, char *name, Vector *params, i32 start, bool is_struct) {
+
+#line 366 "./compiler/parser.ae"
+  Template *template = ((Template *)Map__get(this->templates, name));
+
+#line 367 "./compiler/parser.ae"
+  if ((!((bool)template))) {
+
+#line 368 "./compiler/parser.ae"
+    template = Template__new(name, params, this->tokens, start);
+
+#line 369 "./compiler/parser.ae"
+    Map__insert(this->templates, name, template);
+  } 
+
+#line 371 "./compiler/parser.ae"
+  template->params = params;
+
+#line 372 "./compiler/parser.ae"
+  template->tokens = this->tokens;
+
+#line 373 "./compiler/parser.ae"
+  template->start = start;
+
+#line 374 "./compiler/parser.ae"
+  template->is_struct = is_struct;
+
+#line 375 "./compiler/parser.ae"
+  return template;
+}
+
+
+#line 380 "./compiler/parser.ae"
+static __attribute__((unused)) void Parser__find_templates(Parser *this) {
+
+#line 381 "./compiler/parser.ae"
+  for (i32 i = 0; ((i + 2) < this->tokens->size); i += 1) {
+
+#line 382 "./compiler/parser.ae"
+    Token *tok = ((Token *)Vector__at(this->tokens, i));
+
+#line 383 "./compiler/parser.ae"
+    Token *name = ((Token *)Vector__at(this->tokens, (i + 1)));
+
+#line 384 "./compiler/parser.ae"
+    Token *next = ((Token *)Vector__at(this->tokens, (i + 2)));
+
+#line 385 "./compiler/parser.ae"
+    if (((name->type != TokenType__Identifier) || (next->type != TokenType__LessThan))) 
+
+#line 385 "./compiler/parser.ae"
+    continue;
+    
+
+#line 387 "./compiler/parser.ae"
+    bool is_struct = (tok->type == TokenType__Struct || tok->type == TokenType__Union);
+
+#line 388 "./compiler/parser.ae"
+    if ((!is_struct)) {
+
+#line 389 "./compiler/parser.ae"
+      if ((tok->type != TokenType__Def)) 
+
+#line 389 "./compiler/parser.ae"
+      continue;
+      
+
+#line 391 "./compiler/parser.ae"
+      i32 end = Parser__skip_type_args(this, (i + 2));
+
+#line 392 "./compiler/parser.ae"
+      if ((end < 0)) 
+
+#line 392 "./compiler/parser.ae"
+      continue;
+      
+
+#line 393 "./compiler/parser.ae"
+      Token *after = ((Token *)Vector__at(this->tokens, end));
+
+#line 394 "./compiler/parser.ae"
+      if ((after->type != TokenType__OpenParen)) 
+
+#line 394 "./compiler/parser.ae"
+      continue;
+      
+    } 
+
+#line 396 "./compiler/parser.ae"
+    Parser__register_template(this, name->text, NULL, 0, is_struct);
+  } 
+}
+
+
+#line 400 "./compiler/parser.ae"
+static __attribute__((unused)) Map *Parser__bind_type_params(Parser *this, Vector *params, Vector *args) {
+
+#line 401 "./compiler/parser.ae"
+  Map *bindings = Map__new();
+
+#line 402 "./compiler/parser.ae"
+  for (i32 i = 0; (i < params->size); i += 1) {
+
+#line 403 "./compiler/parser.ae"
+    Map__insert(bindings, ((char *)Vector__at(params, i)), Vector__at(args, i));
+  } 
+
+#line 405 "./compiler/parser.ae"
+  return bindings;
+}
+
+
+#line 408 "./compiler/parser.ae"
+static __attribute__((unused)) void Parser__instantiate_templates(Parser *this, Program *program) {
+
+#line 409 "./compiler/parser.ae"
+  while ((!Vector__empty(this->pending_instances))) {
+
+#line 410 "./compiler/parser.ae"
+    Instance *instance = ((Instance *)Vector__pop(this->pending_instances));
+
+#line 411 "./compiler/parser.ae"
+    Template *template = ((Template *)Map__get(this->templates, instance->template_name));
+
+#line 412 "./compiler/parser.ae"
+    if ((!((bool)template))) {
+
+#line 413 "./compiler/parser.ae"
+      Parser__error(this, Error__new(instance->span, "Unknown generic with this name"));
+
+#line 414 "./compiler/parser.ae"
+      continue;
+    } 
+
+#line 416 "./compiler/parser.ae"
+    if ((template->params->size != instance->args->size)) {
+
+#line 417 "./compiler/parser.ae"
+      Parser__error(this, Error__new_note(instance->span, "Incorrect number of type arguments", format_string("Expected %d, got %d", template->params->size, instance->args->size)));
+
+#line 421 "./compiler/parser.ae"
+      continue;
+    } 
+
+#line 424 "./compiler/parser.ae"
+    Parser__push_context(this, template->tokens);
+
+#line 425 "./compiler/parser.ae"
+    this->curr = template->start;
+
+#line 426 "./compiler/parser.ae"
+    this->type_params = Parser__bind_type_params(this, template->params, instance->args);
+
+#line 427 "./compiler/parser.ae"
+    this->instance_name = instance->name;
+
+#line 428 "./compiler/parser.ae"
+    if (template->is_struct) {
+
+#line 429 "./compiler/parser.ae"
+      Vector__push(program->structures, Parser__parse_struct(this));
+
+#line 431 "./compiler/parser.ae"
+      Vector *methods = ((Vector *)Map__get(this->method_templates, template->name));
+
+#line 432 "./compiler/parser.ae"
+      for (i32 i = 0; (((bool)methods) && (i < methods->size)); i += 1) {
+
+#line 433 "./compiler/parser.ae"
+        Template *method = ((Template *)Vector__at(methods, i));
+
+#line 434 "./compiler/parser.ae"
+        Map__free(this->type_params);
+
+#line 435 "./compiler/parser.ae"
+        this->type_params = Parser__bind_type_params(this, method->params, instance->args);
+
+#line 436 "./compiler/parser.ae"
+        this->curr = method->start;
+
+#line 437 "./compiler/parser.ae"
+        Vector__push(program->functions, Parser__parse_function(this));
+      } 
+    }  else {
+
+#line 440 "./compiler/parser.ae"
+      Vector__push(program->functions, Parser__parse_function(this));
+    } 
+
+#line 442 "./compiler/parser.ae"
+    Map__free(this->type_params);
+
+#line 443 "./compiler/parser.ae"
+    this->type_params = NULL;
+
+#line 444 "./compiler/parser.ae"
+    Parser__pop_context(this);
+  } 
+}
+
+
+#line 448 "./compiler/parser.ae"
+static __attribute__((unused)) AST *Parser__parse_format_string(Parser *this) {
+
+#line 449 "./compiler/parser.ae"
+  Token *fstr = Parser__consume(this, TokenType__FormatStringLiteral);
+
+#line 450 "./compiler/parser.ae"
+  i32 fstr_len = strlen(fstr->text);
+
+#line 452 "./compiler/parser.ae"
+  Vector *expr_parts = Vector__new();
+
+#line 453 "./compiler/parser.ae"
+  Vector *expr_start = Vector__new();
+
+#line 455 "./compiler/parser.ae"
+  Vector *format_parts = Vector__new();
+
+#line 456 "./compiler/parser.ae"
+  Vector *specifiers = Vector__new();
+
+#line 458 "./compiler/parser.ae"
+  i32 count = 0;
+
+#line 459 "./compiler/parser.ae"
+  i32 cur_start = 0;
+
+#line 460 "./compiler/parser.ae"
+  i32 specifier_loc = (-1);
+
+#line 462 "./compiler/parser.ae"
+  for (i32 i = 0; (i < fstr_len); i += 1) {
+
+#line 463 "./compiler/parser.ae"
+    if (fstr->text[i] == '\\') {
+
+#line 464 "./compiler/parser.ae"
+      i += 1;
+    }  else 
+#line 465 "./compiler/parser.ae"
+    if (fstr->text[i] == '{') {
+
+#line 466 "./compiler/parser.ae"
+      if (count == 0) {
+
+#line 467 "./compiler/parser.ae"
+        char *part = string__substring(fstr->text, cur_start, (i - cur_start));
+
+#line 468 "./compiler/parser.ae"
+        Vector__push(format_parts, part);
+
+#line 469 "./compiler/parser.ae"
+        cur_start = (i + 1);
+      } 
+
+#line 471 "./compiler/parser.ae"
+      count += 1;
+    }  else 
+#line 472 "./compiler/parser.ae"
+    if (fstr->text[i] == '}') {
+
+#line 473 "./compiler/parser.ae"
+      count -= 1;
+
+#line 474 "./compiler/parser.ae"
+      if (count == 0) {
+
+#line 475 "./compiler/parser.ae"
+        if ((specifier_loc > 0)) {
+
+#line 476 "./compiler/parser.ae"
+          char *part = string__substring(fstr->text, cur_start, (specifier_loc - cur_start));
+
+#line 477 "./compiler/parser.ae"
+          Vector__push(expr_parts, part);
+
+#line 478 "./compiler/parser.ae"
+          Vector__push(expr_start, (fstr->text + cur_start));
+
+#line 480 "./compiler/parser.ae"
+          specifier_loc += 1;
+
+#line 481 "./compiler/parser.ae"
+          while (((specifier_loc < i) && fstr->text[specifier_loc] == ' ')) {
+
+#line 482 "./compiler/parser.ae"
+            specifier_loc += 1;
+          } 
+
+#line 485 "./compiler/parser.ae"
+          if (specifier_loc == i) {
+
+#line 486 "./compiler/parser.ae"
+            Location loc = fstr->span.start;
+
+#line 487 "./compiler/parser.ae"
+            loc.col += (specifier_loc + 1);
+
+#line 488 "./compiler/parser.ae"
+            Span span = (Span){loc, loc};
+
+#line 489 "./compiler/parser.ae"
+            Parser__error(this, Error__new(span, "Expected format specifier"));
+
+#line 490 "./compiler/parser.ae"
+            return NULL;
+          } 
+
+#line 493 "./compiler/parser.ae"
+          char *spec = string__substring(fstr->text, specifier_loc, (i - specifier_loc));
+
+#line 494 "./compiler/parser.ae"
+          Vector__push(specifiers, spec);
+        }  else {
+
+#line 496 "./compiler/parser.ae"
+          char *part = string__substring(fstr->text, cur_start, (i - cur_start));
+
+#line 497 "./compiler/parser.ae"
+          Vector__push(expr_parts, part);
+
+#line 498 "./compiler/parser.ae"
+          Vector__push(expr_start, (fstr->text + cur_start));
+
+#line 499 "./compiler/parser.ae"
+          Vector__push(specifiers, NULL);
+        } 
+
+#line 501 "./compiler/parser.ae"
+        cur_start = (i + 1);
+
+#line 502 "./compiler/parser.ae"
+        specifier_loc = (-1);
+      }  else 
+#line 504 "./compiler/parser.ae"
+      if ((count < 0)) {
+
+#line 505 "./compiler/parser.ae"
+        Parser__error(this, Error__new(fstr->span, "Unmatched '}' in format string"));
+
+#line 506 "./compiler/parser.ae"
+        return NULL;
+      } 
+      
+    }  else 
+#line 510 "./compiler/parser.ae"
+    if ((fstr->text[i] == ':' && (fstr->text[(i - 1)] != '\\'))) {
+
+#line 512 "./compiler/parser.ae"
+      if (((count == 1 && (fstr->text[(i - 1)] != ':')) && (fstr->text[(i + 1)] != ':'))) {
+
+#line 513 "./compiler/parser.ae"
+        specifier_loc = i;
+      } 
+    } 
+    
+    
+    
+  } 
+
+#line 517 "./compiler/parser.ae"
+  if ((count != 0)) {
+
+#line 518 "./compiler/parser.ae"
+    Parser__error(this, Error__new(fstr->span, "Unmatched '{' in format string"));
+
+#line 519 "./compiler/parser.ae"
+    return NULL;
+  } 
+
+#line 521 "./compiler/parser.ae"
+  char *part = string__substring(fstr->text, cur_start, (fstr_len - cur_start));
+
+#line 522 "./compiler/parser.ae"
+  Vector__push(format_parts, part);
+
+#line 524 "./compiler/parser.ae"
+  AST *node = AST__new(ASTType__FormatStringLiteral, fstr->span);
+
+#line 525 "./compiler/parser.ae"
+  node->u.fmt_str.parts = format_parts;
+
+#line 527 "./compiler/parser.ae"
+  Location fstr_start = fstr->span.start;
+
+#line 528 "./compiler/parser.ae"
+  Vector *expr_nodes = Vector__new_sized(expr_parts->size);
+
+#line 529 "./compiler/parser.ae"
+  for (i32 i = 0; (i < expr_parts->size); i += 1) {
+
+#line 530 "./compiler/parser.ae"
+    char *part = ((char *)Vector__at(expr_parts, i));
+
+#line 531 "./compiler/parser.ae"
+    i32 start = (((char *)Vector__at(expr_start, i)) - fstr->text);
+
+#line 533 "./compiler/parser.ae"
+    Lexer lexer = Lexer__make(part, fstr_start.filename);
+
+#line 534 "./compiler/parser.ae"
+    lexer.loc = fstr_start;
+
+#line 535 "./compiler/parser.ae"
+    lexer.loc.col += (start + 1);
+
+#line 537 "./compiler/parser.ae"
+    Vector *tokens = Lexer__lex((&lexer));
+
+#line 538 "./compiler/parser.ae"
+    for (i32 i = 0; (i < lexer.errors->size); i += 1) {
+
+#line 539 "./compiler/parser.ae"
+      Parser__error(this, Vector__at(lexer.errors, i));
+    } 
+
+#line 541 "./compiler/parser.ae"
+    Vector__free(lexer.errors);
+
+#line 543 "./compiler/parser.ae"
+    Parser__push_context(this, tokens);
+
+#line 544 "./compiler/parser.ae"
+    AST *expr = Parser__parse_expression(this, TokenType__CloseCurly);
+
+#line 545 "./compiler/parser.ae"
+    if ((!Parser__token_is(this, TokenType__EOF))) {
+
+#line 546 "./compiler/parser.ae"
+      Parser__error(this, Error__new(expr->span, "Invalid expression in format string"));
+    } 
+
+#line 548 "./compiler/parser.ae"
+    Parser__pop_context(this);
+
+#line 550 "./compiler/parser.ae"
+    Vector__push(expr_nodes, expr);
+  } 
+
+#line 552 "./compiler/parser.ae"
+  node->u.fmt_str.exprs = expr_nodes;
+
+#line 553 "./compiler/parser.ae"
+  node->u.fmt_str.specs = specifiers;
+
+#line 554 "./compiler/parser.ae"
+  Vector__free(expr_parts);
+
+#line 555 "./compiler/parser.ae"
+  Vector__free(expr_start);
+
+#line 556 "./compiler/parser.ae"
+  return node;
+}
+
+
+#line 559 "./compiler/parser.ae"
+static __attribute__((unused)) Type *Parser__parse_literal_suffix_type(Parser *this, Token *suffix) {
+
+#line 560 "./compiler/parser.ae"
+  if ((!((bool)suffix))) 
+
+#line 560 "./compiler/parser.ae"
+  return NULL;
+  
+
+#line 564 "./compiler/parser.ae"
+  Vector *tokens = Vector__new();
+
+#line 565 "./compiler/parser.ae"
+  Vector__push(tokens, suffix);
+
+#line 566 "./compiler/parser.ae"
+  Vector__push(tokens, Vector__back(this->tokens));
+
+#line 568 "./compiler/parser.ae"
+  Parser__push_context(this, tokens);
+
+#line 569 "./compiler/parser.ae"
+  Type *type = Parser__parse_type(this);
+
+#line 571 "./compiler/parser.ae"
+  if ((!Parser__token_is(this, TokenType__EOF))) {
+
+#line 572 "./compiler/parser.ae"
+    Location loc = Parser__token(this)->span.start;
+
+#line 573 "./compiler/parser.ae"
+    Span span = (Span){loc, loc};
+
+#line 574 "./compiler/parser.ae"
+    Parser__error(this, Error__new(span, "Invalid type suffix"));
+  } 
+
+#line 577 "./compiler/parser.ae"
+  Parser__pop_context(this);
+
+#line 578 "./compiler/parser.ae"
+  Vector__free(tokens);
+
+#line 580 "./compiler/parser.ae"
+  return type;
+}
+
+
+#line 583 "./compiler/parser.ae"
+static __attribute__((unused)) AST *Parser__parse_factor(Parser *this, TokenType end_type) {
+
+#line 584 "./compiler/parser.ae"
+  AST *node = ((AST *)NULL);
+
+#line 586 "./compiler/parser.ae"
+  switch (Parser__token(this)->type) {
+    case TokenType__FormatStringLiteral: {
+
+#line 587 "./compiler/parser.ae"
+      node = Parser__parse_format_string(this);
+    } break;
+    case TokenType__IntLiteral: {
+
+#line 589 "./compiler/parser.ae"
+      node = AST__new(ASTType__IntLiteral, Parser__token(this)->span);
+
+#line 590 "./compiler/parser.ae"
+      Token *tok = Parser__consume(this, TokenType__IntLiteral);
+
+#line 591 "./compiler/parser.ae"
+      node->u.num_literal = (NumLiteral){.text = tok->text, .suffix = Parser__parse_literal_suffix_type(this, tok->suffix)};
+    } break;
+    case TokenType__FloatLiteral: {
+
+#line 597 "./compiler/parser.ae"
+      node = AST__new(ASTType__FloatLiteral, Parser__token(this)->span);
+
+#line 598 "./compiler/parser.ae"
+      Token *tok = Parser__consume(this, TokenType__FloatLiteral);
+
+#line 599 "./compiler/parser.ae"
+      node->u.num_literal = (NumLiteral){.text = tok->text, .suffix = Parser__parse_literal_suffix_type(this, tok->suffix)};
+    } break;
+    case TokenType__StringLiteral: {
+
+#line 605 "./compiler/parser.ae"
+      node = AST__new(ASTType__StringLiteral, Parser__token(this)->span);
+
+#line 606 "./compiler/parser.ae"
+      Token *tok = Parser__consume(this, TokenType__StringLiteral);
+
+#line 607 "./compiler/parser.ae"
+      node->u.string_literal = tok->text;
+    } break;
+    case TokenType__CharLiteral: {
+
+#line 610 "./compiler/parser.ae"
+      node = AST__new(ASTType__CharLiteral, Parser__token(this)->span);
+
+#line 611 "./compiler/parser.ae"
+      Token *tok = Parser__consume(this, TokenType__CharLiteral);
+
+#line 612 "./compiler/parser.ae"
+      node->u.char_literal = tok->text;
+    } break;
+    case TokenType__True:
+    case TokenType__False: {
+
+#line 615 "./compiler/parser.ae"
+      Token *tok = Parser__consume(this, Parser__token(this)->type);
+
+#line 616 "./compiler/parser.ae"
+      node = AST__new(ASTType__BoolLiteral, tok->span);
+
+#line 617 "./compiler/parser.ae"
+      node->u.bool_literal = tok->type == TokenType__True;
+    } break;
+    case TokenType__Null: {
+
+#line 620 "./compiler/parser.ae"
+      node = AST__new(ASTType__Null, Parser__token(this)->span);
+
+#line 621 "./compiler/parser.ae"
+      Parser__consume(this, TokenType__Null);
+    } break;
+    case TokenType__Dot: {
+
+#line 624 "./compiler/parser.ae"
+      Token *op = Parser__consume(this, TokenType__Dot);
+
+#line 626 "./compiler/parser.ae"
+      AST *lhs = AST__new(ASTType__Identifier, op->span);
+
+#line 627 "./compiler/parser.ae"
+      lhs->u.ident.name = "this";
+
+#line 629 "./compiler/parser.ae"
+      AST *rhs = ({ AST *__yield_0;
+
+#line 629 "./compiler/parser.ae"
+  if (Parser__token_is(this, TokenType__Identifier)) {
+
+#line 630 "./compiler/parser.ae"
+    Token *name = Parser__consume(this, TokenType__Identifier);
+
+#line 631 "./compiler/parser.ae"
+    AST *tmp = AST__new(ASTType__Identifier, name->span);
+
+#line 632 "./compiler/parser.ae"
+    tmp->u.ident.name = name->text;
+
+#line 633 "./compiler/parser.ae"
+    __yield_0 = tmp;
+  }  else {
+
+#line 635 "./compiler/parser.ae"
+    Parser__error(this, Error__new(op->span, "Expected identifier after '.'"));
+
+#line 636 "./compiler/parser.ae"
+    __yield_0 = AST__new(ASTType__Error, op->span);
+  } 
+;__yield_0; });
+
+#line 639 "./compiler/parser.ae"
+      node = AST__new(ASTType__Member, Span__join(&lhs->span, &rhs->span));
+
+#line 640 "./compiler/parser.ae"
+      node->u.member.lhs = lhs;
+
+#line 641 "./compiler/parser.ae"
+      node->u.member.rhs = rhs;
+    } break;
+    case TokenType__Minus: {
+
+#line 644 "./compiler/parser.ae"
+      Token *op = Parser__consume(this, TokenType__Minus);
+
+#line 645 "./compiler/parser.ae"
+      AST *expr = Parser__parse_factor(this, end_type);
+
+#line 646 "./compiler/parser.ae"
+      node = AST__new_unop(ASTType__UnaryMinus, Span__join(&op->span, &expr->span), expr);
+    } break;
+    case TokenType__Not: {
+
+#line 649 "./compiler/parser.ae"
+      Token *op = Parser__consume(this, TokenType__Not);
+
+#line 650 "./compiler/parser.ae"
+      AST *expr = Parser__parse_factor(this, end_type);
+
+#line 651 "./compiler/parser.ae"
+      node = AST__new_unop(ASTType__Not, Span__join(&op->span, &expr->span), expr);
+    } break;
+    case TokenType__Tilde: {
+
+#line 654 "./compiler/parser.ae"
+      Token *op = Parser__consume(this, TokenType__Tilde);
+
+#line 655 "./compiler/parser.ae"
+      AST *expr = Parser__parse_factor(this, end_type);
+
+#line 656 "./compiler/parser.ae"
+      node = AST__new_unop(ASTType__BitwiseNot, Span__join(&op->span, &expr->span), expr);
+    } break;
+    case TokenType__Ampersand: {
+
+#line 659 "./compiler/parser.ae"
+      Token *op = Parser__consume(this, TokenType__Ampersand);
+
+#line 660 "./compiler/parser.ae"
+      AST *expr = Parser__parse_factor(this, end_type);
+
+#line 661 "./compiler/parser.ae"
+      node = AST__new_unop(ASTType__Address, Span__join(&op->span, &expr->span), expr);
+    } break;
+    case TokenType__Star: {
+
+#line 664 "./compiler/parser.ae"
+      Token *op = Parser__consume(this, TokenType__Star);
+
+#line 665 "./compiler/parser.ae"
+      AST *expr = Parser__parse_factor(this, end_type);
+
+#line 666 "./compiler/parser.ae"
+      node = AST__new_unop(ASTType__Dereference, Span__join(&op->span, &expr->span), expr);
+    } break;
+    case TokenType__Identifier: {
+
+#line 669 "./compiler/parser.ae"
+      Token *op = Parser__consume(this, TokenType__Identifier);
+
+#line 670 "./compiler/parser.ae"
+      node = AST__new(ASTType__Identifier, op->span);
+
+#line 671 "./compiler/parser.ae"
+      node->u.ident.name = op->text;
+
+#line 673 "./compiler/parser.ae"
+      if ((((bool)this->type_params) && Map__exists(this->type_params, op->text))) {
+
+#line 675 "./compiler/parser.ae"
+        Type *type = ((Type *)Map__get(this->type_params, op->text));
+
+#line 676 "./compiler/parser.ae"
+        if (type->base == BaseType__Structure) 
+
+#line 676 "./compiler/parser.ae"
+        node->u.ident.name = type->name;
+        
+      }  else 
+#line 678 "./compiler/parser.ae"
+      if ((Parser__token_is(this, TokenType__LessThan) && Map__exists(this->templates, op->text))) {
+
+#line 679 "./compiler/parser.ae"
+        i32 end = Parser__skip_type_args(this, this->curr);
+
+#line 680 "./compiler/parser.ae"
+        if ((end >= 0)) {
+
+#line 681 "./compiler/parser.ae"
+          Token *next = ((Token *)Vector__at(this->tokens, end));
+
+#line 682 "./compiler/parser.ae"
+          Template *template = ((Template *)Map__get(this->templates, op->text));
+
+#line 685 "./compiler/parser.ae"
+          if ((((!template->is_struct) || next->type == TokenType__ColonColon) || next->type == TokenType__OpenParen)) {
+
+#line 686 "./compiler/parser.ae"
+            Vector *args = Parser__parse_type_args(this);
+
+#line 687 "./compiler/parser.ae"
+            node->u.ident.name = Parser__instantiate(this, op->text, args, op->span);
+          } 
+        } 
+      } 
+      
+    } break;
+    case TokenType__OpenParen: {
+
+#line 693 "./compiler/parser.ae"
+      Token *open = Parser__consume(this, TokenType__OpenParen);
+
+#line 694 "./compiler/parser.ae"
+      node = Parser__parse_expression(this, TokenType__CloseParen);
+
+#line 695 "./compiler/parser.ae"
+      Token *close = Parser__consume(this, TokenType__CloseParen);
+
+#line 696 "./compiler/parser.ae"
+      node->span = Span__join(&open->span, &close->span);
+    } break;
+    case TokenType__SizeOf: {
+
+#line 699 "./compiler/parser.ae"
+      Token *start = Parser__consume(this, TokenType__SizeOf);
+
+#line 700 "./compiler/parser.ae"
+      Parser__consume(this, TokenType__OpenParen);
+
+#line 701 "./compiler/parser.ae"
+      Type *type = Parser__parse_type(this);
+
+#line 702 "./compiler/parser.ae"
+      Token *close = Parser__consume(this, TokenType__CloseParen);
+
+#line 703 "./compiler/parser.ae"
+      node = AST__new(ASTType__SizeOf, Span__join(&start->span, &close->span));
+
+#line 704 "./compiler/parser.ae"
+      node->u.size_of_type = type;
+    } break;
+    case TokenType__Match: {
+
+#line 708 "./compiler/parser.ae"
+      node = Parser__parse_match(this);
+    } break;
+    case TokenType__If: {
+
+#line 709 "./compiler/parser.ae"
+      node = Parser__parse_if(this);
+    } break;
+    default: {
+
+#line 712 "./compiler/parser.ae"
+      Parser__unhandled_type(this, "parse_expression");
+
+#line 713 "./compiler/parser.ae"
+      node = AST__new(ASTType__Error, Parser__token(this)->span);
+
+#line 714 "./compiler/parser.ae"
+      this->curr += 1;
+    } break;
+  }
+
+#line 718 "./compiler/parser.ae"
+  bool running = true;
+
+#line 719 "./compiler/parser.ae"
+  while (running) {
+
+#line 720 "./compiler/parser.ae"
+    if (Parser__token_is(this, end_type)) 
+
+#line 720 "./compiler/parser.ae"
+    break;
+    
+
+#line 721 "./compiler/parser.ae"
+    switch (Parser__token(this)->type) {
+      case TokenType__OpenParen: {
+
+#line 723 "./compiler/parser.ae"
+        Parser__consume(this, TokenType__OpenParen);
+
+#line 724 "./compiler/parser.ae"
+        Vector *args = Vector__new();
+
+#line 725 "./compiler/parser.ae"
+        while ((!Parser__token_is(this, TokenType__CloseParen))) {
+
+#line 726 "./compiler/parser.ae"
+          AST *label = ((AST *)NULL);
+
+#line 727 "./compiler/parser.ae"
+          AST *expr = Parser__parse_expression(this, TokenType__Comma);
+
+#line 728 "./compiler/parser.ae"
+          if ((expr->type == ASTType__Identifier && Parser__token_is(this, TokenType__Colon))) {
+
+#line 729 "./compiler/parser.ae"
+            Parser__consume(this, TokenType__Colon);
+
+#line 730 "./compiler/parser.ae"
+            label = expr;
+
+#line 731 "./compiler/parser.ae"
+            expr = Parser__parse_expression(this, TokenType__Comma);
+          } 
+
+#line 734 "./compiler/parser.ae"
+          Vector__push(args, Argument__new(label, expr));
+
+#line 735 "./compiler/parser.ae"
+          if ((!Parser__token_is(this, TokenType__CloseParen))) {
+
+#line 736 "./compiler/parser.ae"
+            Parser__consume(this, TokenType__Comma);
+          } 
+        } 
+
+#line 740 "./compiler/parser.ae"
+        Token *end = Parser__consume(this, TokenType__CloseParen);
+
+#line 741 "./compiler/parser.ae"
+        ASTType call_type = ASTType__Call;
+
+#line 742 "./compiler/parser.ae"
+        AST *call = AST__new(call_type, Span__join(&node->span, &end->span));
+
+#line 743 "./compiler/parser.ae"
+        call->u.call.callee = node;
+
+#line 744 "./compiler/parser.ae"
+        call->u.call.args = args;
+
+#line 745 "./compiler/parser.ae"
+        node = call;
+      } break;
+      case TokenType__OpenSquare: {
+
+#line 748 "./compiler/parser.ae"
+        Parser__consume(this, TokenType__OpenSquare);
+
+#line 749 "./compiler/parser.ae"
+        AST *index = Parser__parse_expression(this, TokenType__CloseSquare);
+
+#line 750 "./compiler/parser.ae"
+        Parser__consume(this, TokenType__CloseSquare);
+
+#line 751 "./compiler/parser.ae"
+        node = AST__new_binop(ASTType__Index, node, index);
+      } break;
+      case TokenType__Dot: {
+
+#line 754 "./compiler/parser.ae"
+        Token *dot = Parser__consume(this, TokenType__Dot);
+
+#line 755 "./compiler/parser.ae"
+        AST *rhs = ({ AST *__yield_0;
+
+#line 755 "./compiler/parser.ae"
+  if (Parser__token_is(this, TokenType__Identifier)) {
+
+#line 756 "./compiler/parser.ae"
+    Token *name = Parser__consume(this, TokenType__Identifier);
+
+#line 757 "./compiler/parser.ae"
+    AST *tmp = AST__new(ASTType__Identifier, name->span);
+
+#line 758 "./compiler/parser.ae"
+    tmp->u.ident.name = name->text;
+
+#line 759 "./compiler/parser.ae"
+    __yield_0 = tmp;
+  }  else {
+
+#line 761 "./compiler/parser.ae"
+    Parser__error(this, Error__new(Parser__token(this)->span, "Expected identifier after '.'"));
+
+#line 762 "./compiler/parser.ae"
+    __yield_0 = AST__new(ASTType__Error, dot->span);
+  } 
+;__yield_0; });
+
+#line 765 "./compiler/parser.ae"
+        AST *member = AST__new(ASTType__Member, Span__join(&node->span, &rhs->span));
+
+#line 766 "./compiler/parser.ae"
+        member->u.member.lhs = node;
+
+#line 767 "./compiler/parser.ae"
+        member->u.member.rhs = rhs;
+
+#line 768 "./compiler/parser.ae"
+        node = member;
+      } break;
+      case TokenType__ColonColon: {
+
+#line 771 "./compiler/parser.ae"
+        Parser__consume(this, TokenType__ColonColon);
+
+#line 772 "./compiler/parser.ae"
+        Token *name = Parser__consume(this, TokenType__Identifier);
+
+#line 773 "./compiler/parser.ae"
+        AST *member = AST__new(ASTType__ScopeLookup, Span__join(&node->span, &name->span));
+
+#line 775 "./compiler/parser.ae"
+        AST *rhs = AST__new(ASTType__Identifier, name->span);
+
+#line 776 "./compiler/parser.ae"
+        rhs->u.ident.name = name->text;
+
+#line 778 "./compiler/parser.ae"
+        member->u.member.lhs = node;
+
+#line 779 "./compiler/parser.ae"
+        member->u.member.rhs = rhs;
+
+#line 780 "./compiler/parser.ae"
+        node = member;
+      } break;
+      case TokenType__As: {
+
+#line 783 "./compiler/parser.ae"
+        Parser__consume(this, TokenType__As);
+
+#line 784 "./compiler/parser.ae"
+        Type *type = Parser__parse_type(this);
+
+#line 785 "./compiler/parser.ae"
+        AST *cast = AST__new(ASTType__Cast, Span__join(&node->span, &type->span));
+
+#line 786 "./compiler/parser.ae"
+        cast->u.cast.lhs = node;
+
+#line 787 "./compiler/parser.ae"
+        cast->u.cast.to = type;
+
+#line 788 "./compiler/parser.ae"
+        node = cast;
+      } break;
+      case TokenType__Question: {
+
+#line 791 "./compiler/parser.ae"
+        Parser__consume(this, TokenType__Question);
+
+#line 792 "./compiler/parser.ae"
+        node = AST__new_unop(ASTType__IsNotNull, Span__join(&node->span, &Parser__token(this)->span), node);
+      } break;
+      default: {
+
+#line 795 "./compiler/parser.ae"
+        running = false;
+      } break;
+    }
+  } 
+
+#line 799 "./compiler/parser.ae"
+  return node;
+}
+
+
+#line 802 "./compiler/parser.ae"
+static __attribute__((unused)) AST *Parser__parse_term(Parser *this, TokenType end_type) {
+
+#line 803 "./compiler/parser.ae"
+  AST *lhs = Parser__parse_factor(this, end_type);
+
+#line 804 "./compiler/parser.ae"
+  while (((Parser__token_is(this, TokenType__Star) || Parser__token_is(this, TokenType__Slash)) || Parser__token_is(this, TokenType__Percent))) {
+
+#line 807 "./compiler/parser.ae"
+    if (Parser__token_is(this, end_type)) 
+
+#line 807 "./compiler/parser.ae"
+    break;
+    
+
+#line 808 "./compiler/parser.ae"
+    ASTType op = ASTType__from_token(Parser__token(this)->type);
+
+#line 809 "./compiler/parser.ae"
+    this->curr += 1;
+
+#line 810 "./compiler/parser.ae"
+    AST *rhs = Parser__parse_factor(this, end_type);
+
+#line 811 "./compiler/parser.ae"
+    lhs = AST__new_binop(op, lhs, rhs);
+  } 
+
+#line 813 "./compiler/parser.ae"
+  return lhs;
+}
+
+
+#line 816 "./compiler/parser.ae"
+static __attribute__((unused)) AST *Parser__parse_additive(Parser *this, TokenType end_type) {
+
+#line 817 "./compiler/parser.ae"
+  AST *lhs = Parser__parse_term(this, end_type);
+
+#line 818 "./compiler/parser.ae"
+  while ((Parser__token_is(this, TokenType__Plus) || Parser__token_is(this, TokenType__Minus))) {
+
+#line 819 "./compiler/parser.ae"
+    if (Parser__token_is(this, end_type)) 
+
+#line 819 "./compiler/parser.ae"
+    break;
+    
+
+#line 820 "./compiler/parser.ae"
+    ASTType op = ASTType__from_token(Parser__token(this)->type);
+
+#line 821 "./compiler/parser.ae"
+    this->curr += 1;
+
+#line 822 "./compiler/parser.ae"
+    AST *rhs = Parser__parse_term(this, end_type);
+
+#line 823 "./compiler/parser.ae"
+    lhs = AST__new_binop(op, lhs, rhs);
+  } 
+
+#line 825 "./compiler/parser.ae"
+  return lhs;
+}
+
+
+#line 828 "./compiler/parser.ae"
+static __attribute__((unused)) AST *Parser__parse_shift(Parser *this, TokenType end_type) {
+
+#line 829 "./compiler/parser.ae"
+  AST *lhs = Parser__parse_additive(this, end_type);
+
+#line 830 "./compiler/parser.ae"
+  while ((Parser__token_is(this, TokenType__LessThanLessThan) || Parser__token_is(this, TokenType__GreaterThanGreaterThan))) {
+
+#line 832 "./compiler/parser.ae"
+    if (Parser__token_is(this, end_type)) 
+
+#line 832 "./compiler/parser.ae"
+    break;
+    
+
+#line 833 "./compiler/parser.ae"
+    ASTType op = ASTType__from_token(Parser__token(this)->type);
+
+#line 834 "./compiler/parser.ae"
+    this->curr += 1;
+
+#line 835 "./compiler/parser.ae"
+    AST *rhs = Parser__parse_additive(this, end_type);
+
+#line 836 "./compiler/parser.ae"
+    lhs = AST__new_binop(op, lhs, rhs);
+  } 
+
+#line 838 "./compiler/parser.ae"
+  return lhs;
+}
+
+
+#line 841 "./compiler/parser.ae"
+static __attribute__((unused)) AST *Parser__parse_bw_and(Parser *this, TokenType end_type) {
+
+#line 842 "./compiler/parser.ae"
+  AST *lhs = Parser__parse_shift(this, end_type);
+
+#line 843 "./compiler/parser.ae"
+  while (Parser__token_is(this, TokenType__Ampersand)) {
+
+#line 844 "./compiler/parser.ae"
+    if (Parser__token_is(this, end_type)) 
+
+#line 844 "./compiler/parser.ae"
+    break;
+    
+
+#line 845 "./compiler/parser.ae"
+    ASTType op = ASTType__from_token(Parser__token(this)->type);
+
+#line 846 "./compiler/parser.ae"
+    this->curr += 1;
+
+#line 847 "./compiler/parser.ae"
+    AST *rhs = Parser__parse_shift(this, end_type);
+
+#line 848 "./compiler/parser.ae"
+    lhs = AST__new_binop(op, lhs, rhs);
+  } 
+
+#line 850 "./compiler/parser.ae"
+  return lhs;
+}
+
+
+#line 853 "./compiler/parser.ae"
+static __attribute__((unused)) AST *Parser__parse_bw_xor(Parser *this, TokenType end_type) {
+
+#line 854 "./compiler/parser.ae"
+  AST *lhs = Parser__parse_bw_and(this, end_type);
+
+#line 855 "./compiler/parser.ae"
+  while (Parser__token_is(this, TokenType__Caret)) {
+
+#line 856 "./compiler/parser.ae"
+    if (Parser__token_is(this, end_type)) 
+
+#line 856 "./compiler/parser.ae"
+    break;
+    
+
+#line 857 "./compiler/parser.ae"
+    ASTType op = ASTType__from_token(Parser__token(this)->type);
+
+#line 858 "./compiler/parser.ae"
+    this->curr += 1;
+
+#line 859 "./compiler/parser.ae"
+    AST *rhs = Parser__parse_bw_and(this, end_type);
+
+#line 860 "./compiler/parser.ae"
+    lhs = AST__new_binop(op, lhs, rhs);
+  } 
+
+#line 862 "./compiler/parser.ae"
+  return lhs;
+}
+
+
+#line 865 "./compiler/parser.ae"
+static __attribute__((unused)) AST *Parser__parse_bw_or(Parser *this, TokenType end_type) {
+
+#line 866 "./compiler/parser.ae"
+  AST *lhs = Parser__parse_bw_xor(this, end_type);
+
+#line 867 "./compiler/parser.ae"
+  while (Parser__token_is(this, TokenType__Line)) {
+
+#line 868 "./compiler/parser.ae"
+    if (Parser__token_is(this, end_type)) 
+
+#line 868 "./compiler/parser.ae"
+    break;
+    
+
+#line 869 "./compiler/parser.ae"
+    ASTType op = ASTType__from_token(Parser__token(this)->type);
+
+#line 870 "./compiler/parser.ae"
+    this->curr += 1;
+
+#line 871 "./compiler/parser.ae"
+    AST *rhs = Parser__parse_bw_xor(this, end_type);
+
+#line 872 "./compiler/parser.ae"
+    lhs = AST__new_binop(op, lhs, rhs);
+  } 
+
+#line 874 "./compiler/parser.ae"
+  return lhs;
+}
+
+
+#line 877 "./compiler/parser.ae"
+static __attribute__((unused)) AST *Parser__parse_relational(Parser *this, TokenType end_type) {
+
+#line 878 "./compiler/parser.ae"
+  Vector *operands = Vector__new();
+
+#line 879 "./compiler/parser.ae"
+  Vector *operators = Vector__new();
+
+#line 881 "./compiler/parser.ae"
+  Vector__push(operands, Parser__parse_bw_or(this, end_type));
+
+#line 882 "./compiler/parser.ae"
+  while ((((((Parser__token_is(this, TokenType__LessThan) || Parser__token_is(this, TokenType__GreaterThan)) || Parser__token_is(this, TokenType__LessThanEquals)) || Parser__token_is(this, TokenType__GreaterThanEquals)) || Parser__token_is(this, TokenType__EqualEquals)) || Parser__token_is(this, TokenType__NotEquals))) {
+
+#line 888 "./compiler/parser.ae"
+    if (Parser__token_is(this, end_type)) 
+
+#line 888 "./compiler/parser.ae"
+    break;
+    
+
+#line 889 "./compiler/parser.ae"
+    Vector__push(operators, Parser__token(this));
+
+#line 890 "./compiler/parser.ae"
+    this->curr += 1;
+
+#line 891 "./compiler/parser.ae"
+    AST *term = Parser__parse_bw_or(this, end_type);
+
+#line 892 "./compiler/parser.ae"
+    Vector__push(operands, term);
+  } 
+
+#line 895 "./compiler/parser.ae"
+  if (operators->size == 0) 
+
+#line 895 "./compiler/parser.ae"
+  return Vector__at(operands, 0);
+  
+
+#line 897 "./compiler/parser.ae"
+  AST *root = ((AST *)NULL);
+
+#line 898 "./compiler/parser.ae"
+  for (i32 i = 0; (i < operators->size); i += 1) {
+
+#line 899 "./compiler/parser.ae"
+    Token *tok = ((Token *)Vector__at(operators, i));
+
+#line 900 "./compiler/parser.ae"
+    AST *lhs = ((AST *)Vector__at(operands, i));
+
+#line 901 "./compiler/parser.ae"
+    AST *rhs = ((AST *)Vector__at(operands, (i + 1)));
+
+#line 902 "./compiler/parser.ae"
+    AST *op = AST__new_binop(ASTType__from_token(tok->type), lhs, rhs);
+
+#line 903 "./compiler/parser.ae"
+    if (((bool)root)) {
+
+#line 904 "./compiler/parser.ae"
+      root = AST__new_binop(ASTType__And, root, op);
+    }  else {
+
+#line 906 "./compiler/parser.ae"
+      root = op;
+    } 
+  } 
+
+#line 910 "./compiler/parser.ae"
+  Vector__free(operands);
+
+#line 911 "./compiler/parser.ae"
+  Vector__free(operators);
+
+#line 913 "./compiler/parser.ae"
+  return root;
+}
+
+
+#line 916 "./compiler/parser.ae"
+static __attribute__((unused)) AST *Parser__parse_logical_and(Parser *this, TokenType end_type) {
+
+#line 917 "./compiler/parser.ae"
+  AST *lhs = Parser__parse_relational(this, end_type);
+
+#line 918 "./compiler/parser.ae"
+  while (Parser__token_is(this, TokenType__And)) {
+
+#line 919 "./compiler/parser.ae"
+    if (Parser__token_is(this, end_type)) 
+
+#line 919 "./compiler/parser.ae"
+    break;
+    
+
+#line 920 "./compiler/parser.ae"
+    ASTType op = ASTType__from_token(Parser__token(this)->type);
+
+#line 921 "./compiler/parser.ae"
+    this->curr += 1;
+
+#line 922 "./compiler/parser.ae"
+    AST *rhs = Parser__parse_relational(this, end_type);
+
+#line 923 "./compiler/parser.ae"
+    lhs = AST__new_binop(op, lhs, rhs);
+  } 
+
+#line 925 "./compiler/parser.ae"
+  return lhs;
+}
+
+
+#line 928 "./compiler/parser.ae"
+static __attribute__((unused)) AST *Parser__parse_logical_or(Parser *this, TokenType end_type) {
+
+#line 929 "./compiler/parser.ae"
+  AST *lhs = Parser__parse_logical_and(this, end_type);
+
+#line 930 "./compiler/parser.ae"
+  while (Parser__token_is(this, TokenType__Or)) {
+
+#line 931 "./compiler/parser.ae"
+    if (Parser__token_is(this, end_type)) 
+
+#line 931 "./compiler/parser.ae"
+    break;
+    
+
+#line 932 "./compiler/parser.ae"
+    ASTType op = ASTType__from_token(Parser__token(this)->type);
+
+#line 933 "./compiler/parser.ae"
+    this->curr += 1;
+
+#line 934 "./compiler/parser.ae"
+    AST *rhs = Parser__parse_logical_and(this, end_type);
+
+#line 935 "./compiler/parser.ae"
+    lhs = AST__new_binop(op, lhs, rhs);
+  } 
+
+#line 937 "./compiler/parser.ae"
+  return lhs;
+}
+
+
+#line 940 "./compiler/parser.ae"
+static __attribute__((unused)) AST *Parser__parse_expression(Parser *this, TokenType end_type) {
+
+#line 941 "./compiler/parser.ae"
+  AST *lhs = Parser__parse_logical_or(this, end_type);
+
+#line 942 "./compiler/parser.ae"
+  while (((((Parser__token_is(this, TokenType__Equals) || Parser__token_is(this, TokenType__PlusEquals)) || Parser__token_is(this, TokenType__MinusEquals)) || Parser__token_is(this, TokenType__StarEquals)) || Parser__token_is(this, TokenType__SlashEquals))) {
+
+#line 947 "./compiler/parser.ae"
+    if (Parser__token_is(this, end_type)) 
+
+#line 947 "./compiler/parser.ae"
+    break;
+    
+
+#line 948 "./compiler/parser.ae"
+    ASTType op = ASTType__from_token(Parser__token(this)->type);
+
+#line 949 "./compiler/parser.ae"
+    this->curr += 1;
+
+#line 950 "./compiler/parser.ae"
+    AST *rhs = Parser__parse_expression(this, end_type);
+
+#line 951 "./compiler/parser.ae"
+    lhs = AST__new_binop(op, lhs, rhs);
+  } 
+
+#line 953 "./compiler/parser.ae"
+  return lhs;
+}
+
+
+#line 956 "./compiler/parser.ae"
+static __attribute__((unused)) AST *Parser__parse_match(Parser *this) {
+
+#line 957 "./compiler/parser.ae"
+  Token *op = Parser__consume(this, TokenType__Match);
+
+#line 958 "./compiler/parser.ae"
+  AST *expr = Parser__parse_expression(this, TokenType__OpenCurly);
+
+#line 959 "./compiler/parser.ae"
+  AST *node = AST__new(ASTType__Match, Span__join(&op->span, &expr->span));
+
+#line 960 "./compiler/parser.ae"
+  node->u.match_stmt->expr = expr;
+
+#line 962 "./compiler/parser.ae"
+  Vector *cases = Vector__new();
+
+#line 963 "./compiler/parser.ae"
+  Parser__consume(this, TokenType__OpenCurly);
+
+#line 964 "./compiler/parser.ae"
+  while ((!Parser__token_is(this, TokenType__CloseCurly))) {
+
+#line 965 "./compiler/parser.ae"
+    if (Parser__token_is(this, TokenType__Else)) {
+
+#line 966 "./compiler/parser.ae"
+      node->u.match_stmt->defolt_span = Parser__token(this)->span;
+
+#line 967 "./compiler/parser.ae"
+      Parser__consume(this, TokenType__Else);
+
+#line 968 "./compiler/parser.ae"
+      Parser__consume(this, TokenType__FatArrow);
+
+#line 969 "./compiler/parser.ae"
+      node->u.match_stmt->defolt = Parser__parse_statement(this);
+    }  else {
+
+#line 972 "./compiler/parser.ae"
+      AST *cond = Parser__parse_factor(this, TokenType__Line);
+
+#line 973 "./compiler/parser.ae"
+      AST *body = ((AST *)NULL);
+
+#line 974 "./compiler/parser.ae"
+      if ((!Parser__consume_if(this, TokenType__Line))) {
+
+#line 975 "./compiler/parser.ae"
+        Parser__consume(this, TokenType__FatArrow);
+
+#line 976 "./compiler/parser.ae"
+        body = Parser__parse_statement(this);
+
+#line 977 "./compiler/parser.ae"
+        if ((!Parser__token_is(this, TokenType__CloseCurly))) {
+
+#line 978 "./compiler/parser.ae"
+          Parser__consume_newline_or(this, TokenType__Comma);
+        } 
+      } 
+
+#line 981 "./compiler/parser.ae"
+      MatchCase *_case = MatchCase__new(cond, body);
+
+#line 982 "./compiler/parser.ae"
+      Vector__push(cases, _case);
+    } 
+  } 
+
+#line 985 "./compiler/parser.ae"
+  node->span = Span__join(&op->span, &Parser__token(this)->span);
+
+#line 986 "./compiler/parser.ae"
+  Parser__consume(this, TokenType__CloseCurly);
+
+#line 987 "./compiler/parser.ae"
+  node->u.match_stmt->cases = cases;
+
+#line 989 "./compiler/parser.ae"
+  return node;
+}
+
+
+#line 992 "./compiler/parser.ae"
+static __attribute__((unused)) AST *Parser__parse_if(Parser *this) {
+
+#line 993 "./compiler/parser.ae"
+  Span start_span = Parser__token(this)->span;
+
+#line 994 "./compiler/parser.ae"
+  Parser__consume(this, TokenType__If);
+
+#line 995 "./compiler/parser.ae"
+  AST *cond = Parser__parse_expression(this, TokenType__Newline);
+
+#line 996 "./compiler/parser.ae"
+  Parser__consume_if(this, TokenType__Then);
+
+#line 997 "./compiler/parser.ae"
+  AST *body = Parser__parse_statement(this);
+
+#line 999 "./compiler/parser.ae"
+  Span end_span = body->span;
+
+#line 1000 "./compiler/parser.ae"
+  AST *els = ((AST *)NULL);
+
+#line 1001 "./compiler/parser.ae"
+  if (Parser__consume_if(this, TokenType__Else)) {
+
+#line 1002 "./compiler/parser.ae"
+    els = Parser__parse_statement(this);
+
+#line 1003 "./compiler/parser.ae"
+    end_span = els->span;
+  } 
+
+#line 1005 "./compiler/parser.ae"
+  AST *node = AST__new(ASTType__If, Span__join(&start_span, &end_span));
+
+#line 1006 "./compiler/parser.ae"
+  node->u.if_stmt.cond = cond;
+
+#line 1007 "./compiler/parser.ae"
+  node->u.if_stmt.body = body;
+
+#line 1008 "./compiler/parser.ae"
+  node->u.if_stmt.els = els;
+
+#line 1009 "./compiler/parser.ae"
+  return node;
+}
+
+
+#line 1012 "./compiler/parser.ae"
+static __attribute__((unused)) void Parser__consume_end_of_statement(Parser *this) {
+
+#line 1013 "./compiler/parser.ae"
+  if (Parser__token_is(this, TokenType__CloseCurly)) 
+
+#line 1013 "./compiler/parser.ae"
+  return;
+  
+
+#line 1014 "./compiler/parser.ae"
+  Parser__consume_newline_or(this, TokenType__Semicolon);
+}
+
+
+#line 1017 "./compiler/parser.ae"
+static __attribute__((unused)) AST *Parser__parse_statement(Parser *this) {
+
+#line 1018 "./compiler/parser.ae"
+  AST *node = ((AST *)NULL);
+
+#line 1019 "./compiler/parser.ae"
+  Span start_span = Parser__token(this)->span;
+
+#line 1021 "./compiler/parser.ae"
+  if (Parser__token_is(this, TokenType__For)) {
+
+#line 1022 "./compiler/parser.ae"
+    Token *next = ((Token *)Vector__at(this->tokens, (this->curr + 1)));
+
+#line 1023 "./compiler/parser.ae"
+    Token *after = ((Token *)Vector__at(this->tokens, (this->curr + 2)));
+
+#line 1024 "./compiler/parser.ae"
+    bool is_in = (after->type == TokenType__Identifier && string__eq(after->text, "in"));
+
+#line 1025 "./compiler/parser.ae"
+    if ((next->type == TokenType__Identifier && (is_in || after->type == TokenType__Colon))) {
+
+#line 1026 "./compiler/parser.ae"
+      return Parser__parse_for_in(this);
+    } 
+  } 
+
+#line 1030 "./compiler/parser.ae"
+  switch (Parser__token(this)->type) {
+    case TokenType__Match: {
+
+#line 1031 "./compiler/parser.ae"
+      node = Parser__parse_match(this);
+    } break;
+    case TokenType__If: {
+
+#line 1032 "./compiler/parser.ae"
+      node = Parser__parse_if(this);
+    } break;
+    case TokenType__OpenCurly: {
+
+#line 1033 "./compiler/parser.ae"
+      node = Parser__parse_block(this);
+    } break;
+    case TokenType__Return: {
+
+#line 1035 "./compiler/parser.ae"
+      Parser__consume(this, TokenType__Return);
+
+#line 1036 "./compiler/parser.ae"
+      AST *expr = ((AST *)NULL);
+
+#line 1037 "./compiler/parser.ae"
+      if ((!Parser__token(this)->seen_newline)) {
+
+#line 1038 "./compiler/parser.ae"
+        expr = Parser__parse_expression(this, TokenType__Newline);
+      } 
+
+#line 1040 "./compiler/parser.ae"
+      node = AST__new_unop(ASTType__Return, Span__join(&start_span, &Parser__token(this)->span), expr);
+
+#line 1041 "./compiler/parser.ae"
+      Parser__consume_end_of_statement(this);
+    } break;
+    case TokenType__Break: {
+
+#line 1044 "./compiler/parser.ae"
+      node = AST__new(ASTType__Break, start_span);
+
+#line 1045 "./compiler/parser.ae"
+      Parser__consume(this, TokenType__Break);
+
+#line 1046 "./compiler/parser.ae"
+      Parser__consume_end_of_statement(this);
+    } break;
+    case TokenType__Continue: {
+
+#line 1049 "./compiler/parser.ae"
+      Parser__consume(this, TokenType__Continue);
+
+#line 1050 "./compiler/parser.ae"
+      node = AST__new(ASTType__Continue, start_span);
+
+#line 1051 "./compiler/parser.ae"
+      Parser__consume_end_of_statement(this);
+    } break;
+    case TokenType__Defer: {
+
+#line 1054 "./compiler/parser.ae"
+      Parser__consume(this, TokenType__Defer);
+
+#line 1055 "./compiler/parser.ae"
+      AST *expr = Parser__parse_statement(this);
+
+#line 1056 "./compiler/parser.ae"
+      node = AST__new_unop(ASTType__Defer, Span__join(&start_span, &expr->span), expr);
+    } break;
+    case TokenType__Scratch: {
+
+#line 1059 "./compiler/parser.ae"
+      Parser__consume(this, TokenType__Scratch);
+
+#line 1060 "./compiler/parser.ae"
+      AST *body = Parser__parse_block(this);
+
+#line 1061 "./compiler/parser.ae"
+      node = AST__new_unop(ASTType__Scratch, Span__join(&start_span, &body->span), body);
+    } break;
+    case TokenType__Yield: {
+
+#line 1064 "./compiler/parser.ae"
+      Parser__consume(this, TokenType__Yield);
+
+#line 1065 "./compiler/parser.ae"
+      AST *expr = Parser__parse_expression(this, TokenType__Newline);
+
+#line 1066 "./compiler/parser.ae"
+      node = AST__new_unop(ASTType__Yield, Span__join(&start_span, &expr->span), expr);
+
+#line 1067 "./compiler/parser.ae"
+      Parser__consume_end_of_statement(this);
+    } break;
+    case TokenType__While: {
+
+#line 1070 "./compiler/parser.ae"
+      Parser__consume(this, TokenType__While);
+
+#line 1071 "./compiler/parser.ae"
+      AST *cond = Parser__parse_expression(this, TokenType__Newline);
+
+#line 1072 "./compiler/parser.ae"
+      AST *body = Parser__parse_statement(this);
+
+#line 1073 "./compiler/parser.ae"
+      node = AST__new(ASTType__While, Span__join(&start_span, &body->span));
+
+#line 1074 "./compiler/parser.ae"
+      node->u.loop->cond = cond;
+
+#line 1075 "./compiler/parser.ae"
+      node->u.loop->body = body;
+    } break;
+    case TokenType__For: {
+
+#line 1078 "./compiler/parser.ae"
+      node = AST__new(ASTType__For, Parser__token(this)->span);
+
+#line 1079 "./compiler/parser.ae"
+      Parser__consume(this, TokenType__For);
+
+#line 1081 "./compiler/parser.ae"
+      if ((!Parser__token_is(this, TokenType__Semicolon))) {
+
+#line 1082 "./compiler/parser.ae"
+        AST *init = Parser__parse_statement(this);
+
+#line 1084 "./compiler/parser.ae"
+        if (((init->type != ASTType__Assignment) && (init->type != ASTType__VarDeclaration))) {
+
+#line 1086 "./compiler/parser.ae"
+          Parser__error(this, Error__new(init->span, "Invalid for loop initializer"));
+        } 
+
+#line 1088 "./compiler/parser.ae"
+        node->u.loop->init = init;
+
+#line 1091 "./compiler/parser.ae"
+        Token *prev = ((Token *)Vector__at(this->tokens, (this->curr - 1)));
+
+#line 1092 "./compiler/parser.ae"
+        if (prev->type == TokenType__Semicolon) {
+
+#line 1092 "./compiler/parser.ae"
+          this->curr -= 1;
+        } 
+      } 
+
+#line 1094 "./compiler/parser.ae"
+      Parser__consume(this, TokenType__Semicolon);
+
+#line 1095 "./compiler/parser.ae"
+      if ((!Parser__token_is(this, TokenType__Semicolon))) 
+
+#line 1096 "./compiler/parser.ae"
+      node->u.loop->cond = Parser__parse_expression(this, TokenType__Semicolon);
+      
+
+#line 1097 "./compiler/parser.ae"
+      Parser__consume(this, TokenType__Semicolon);
+
+#line 1100 "./compiler/parser.ae"
+      if ((!Parser__token_is(this, TokenType__CloseCurly))) 
+
+#line 1101 "./compiler/parser.ae"
+      node->u.loop->incr = Parser__parse_expression(this, TokenType__Newline);
+      
+
+#line 1103 "./compiler/parser.ae"
+      node->u.loop->body = Parser__parse_statement(this);
+
+#line 1104 "./compiler/parser.ae"
+      node->span = Span__join(&node->span, &node->u.loop->body->span);
+    } break;
+    case TokenType__Let: {
+
+#line 1107 "./compiler/parser.ae"
+      Parser__consume(this, TokenType__Let);
+
+#line 1108 "./compiler/parser.ae"
+      Token *name = Parser__consume(this, TokenType__Identifier);
+
+#line 1109 "./compiler/parser.ae"
+      Span end_span = name->span;
+
+#line 1111 "./compiler/parser.ae"
+      Type *type = ((Type *)NULL);
+
+#line 1112 "./compiler/parser.ae"
+      if (Parser__consume_if(this, TokenType__Colon)) {
+
+#line 1113 "./compiler/parser.ae"
+        type = Parser__parse_type(this);
+
+#line 1114 "./compiler/parser.ae"
+        end_span = type->span;
+      } 
+
+#line 1116 "./compiler/parser.ae"
+      AST *init = ((AST *)NULL);
+
+#line 1117 "./compiler/parser.ae"
+      if (Parser__consume_if(this, TokenType__Equals)) {
+
+#line 1118 "./compiler/parser.ae"
+        init = Parser__parse_expression(this, TokenType__Newline);
+
+#line 1119 "./compiler/parser.ae"
+        end_span = init->span;
+      } 
+
+#line 1121 "./compiler/parser.ae"
+      Parser__consume_end_of_statement(this);
+
+#line 1123 "./compiler/parser.ae"
+      node = AST__new(ASTType__VarDeclaration, Span__join(&start_span, &end_span));
+
+#line 1124 "./compiler/parser.ae"
+      node->u.var_decl.var = Variable__new(name->text, type, name->span);
+
+#line 1125 "./compiler/parser.ae"
+      node->u.var_decl.init = init;
+    } break;
+    case TokenType__Const: {
+
+#line 1128 "./compiler/parser.ae"
+      Parser__error(this, Error__new(Parser__token(this)->span, "Const declarations are only allowed in the global scope"));
+    } break;
+    default: {
+
+#line 1131 "./compiler/parser.ae"
+      node = Parser__parse_expression(this, TokenType__Newline);
+
+#line 1132 "./compiler/parser.ae"
+      Parser__consume_if(this, TokenType__Semicolon);
+    } break;
+  }
+
+#line 1136 "./compiler/parser.ae"
+  return node;
+}
+
+
+#line 1139 "./compiler/parser.ae"
+static __attribute__((unused)) AST *Parser__parse_block(Parser *this) {
+
+#line 1140 "./compiler/parser.ae"
+  AST *node = AST__new(ASTType__Block, Parser__token(this)->span);
+
+#line 1141 "./compiler/parser.ae"
+  Parser__consume(this, TokenType__OpenCurly);
+
+#line 1143 "./compiler/parser.ae"
+  Vector *statements = Vector__new();
+
+#line 1144 "./compiler/parser.ae"
+  while ((!Parser__token_is(this, TokenType__CloseCurly))) {
+
+#line 1145 "./compiler/parser.ae"
+    AST *statement = Parser__parse_statement(this);
+
+#line 1146 "./compiler/parser.ae"
+    Vector__push(statements, statement);
+  } 
+
+#line 1148 "./compiler/parser.ae"
+  node->u.block.statements = statements;
+
+#line 1150 "./compiler/parser.ae"
+  Parser__consume(this, TokenType__CloseCurly);
+
+#line 1151 "./compiler/parser.ae"
+  return node;
+}
+
+
+#line 1155 "./compiler/parser.ae"
+static __attribute__((unused)) AST *Parser__parse_for_in(Parser *this) {
+
+#line 1156 "./compiler/parser.ae"
+  AST *node = AST__new(ASTType__ForIn, Parser__consume(this, TokenType__For)->span);
+
+#line 1157 "./compiler/parser.ae"
+  ForIn *for_in = node->u.for_in;
+
+#line 1159 "./compiler/parser.ae"
+  Token *name = Parser__consume(this, TokenType__Identifier);
+
+#line 1160 "./compiler/parser.ae"
+  Type *type = ((Type *)NULL);
+
+#line 1161 "./compiler/parser.ae"
+  if (Parser__consume_if(this, TokenType__Colon)) {
+
+#line 1162 "./compiler/parser.ae"
+    type = Parser__parse_type(this);
+  } 
+
+#line 1164 "./compiler/parser.ae"
+  for_in->var = Variable__new(name->text, type, name->span);
+
+#line 1166 "./compiler/parser.ae"
+  Token *in_token = Parser__consume(this, TokenType__Identifier);
+
+#line 1167 "./compiler/parser.ae"
+  if ((!string__eq(in_token->text, "in"))) {
+
+#line 1168 "./compiler/parser.ae"
+    Parser__error(this, Error__new(in_token->span, "Expected 'in'"));
+  } 
+
+#line 1170 "./compiler/parser.ae"
+  for_in->expr = Parser__parse_expression(this, TokenType__OpenCurly);
+
+#line 1171 "./compiler/parser.ae"
+  if (Parser__consume_if(this, TokenType__DotDot)) {
+
+#line 1172 "./compiler/parser.ae"
+    for_in->end = Parser__parse_expression(this, TokenType__OpenCurly);
+  } 
+
+#line 1175 "./compiler/parser.ae"
+  for_in->body = Parser__parse_statement(this);
+
+#line 1176 "./compiler/parser.ae"
+  node->span = Span__join(&node->span, &for_in->body->span);
+
+#line 1177 "./compiler/parser.ae"
+  return node;
+}
+
+
+#line 1180 "./compiler/parser.ae"
+static __attribute__((unused)) void Parser__parse_function_attribute(Parser *this, Function *func, Token *attr) {
+
+#line 1181 "./compiler/parser.ae"
+  {
+    char *__match_str = attr->text;
+    switch (aecor_hash_str(__match_str, 2166136261u)) {
+      case 808185403u:
+        if (!strcmp(__match_str, "inline")) goto __match_2_0;
+        break;
+      case 3723689721u:
+        if (!strcmp(__match_str, "noinline")) goto __match_2_1;
+        break;
+      case 1858890578u:
+        if (!strcmp(__match_str, "hot")) goto __match_2_2;
+        break;
+      case 4289777599u:
+        if (!strcmp(__match_str, "cold")) goto __match_2_3;
+        break;
+      case 45253003u:
+        if (!strcmp(__match_str, "pure")) goto __match_2_4;
+        break;
+      case 2848935426u:
+        if (!strcmp(__match_str, "export")) goto __match_2_5;
+        break;
+    }
+    goto __match_2_default;
+    __match_2_0: {
+
+#line 1182 "./compiler/parser.ae"
+      func->is_inline = true;
+    } goto __match_2_end;
+    __match_2_1: {
+
+#line 1183 "./compiler/parser.ae"
+      func->is_noinline = true;
+    } goto __match_2_end;
+    __match_2_2: {
+
+#line 1184 "./compiler/parser.ae"
+      func->is_hot = true;
+    } goto __match_2_end;
+    __match_2_3: {
+
+#line 1185 "./compiler/parser.ae"
+      func->is_cold = true;
+    } goto __match_2_end;
+    __match_2_4: {
+
+#line 1186 "./compiler/parser.ae"
+      func->is_pure = true;
+    } goto __match_2_end;
+    __match_2_5: {
+
+#line 1187 "./compiler/parser.ae"
+      func->is_export = true;
+    } goto __match_2_end;
+    __match_2_default: {
+
+#line 1188 "./compiler/parser.ae"
+      Parser__error(this, Error__new(attr->span, "Unknown function attribute"));
+    }
+    __match_2_end:;
+  }
+}
+
+
+#line 1194 "./compiler/parser.ae"
+static __attribute__((unused)) Function *Parser__parse_function(Parser *this) {
+
+#line 1195 "./compiler/parser.ae"
+  i32 start = this->curr;
+
+#line 1196 "./compiler/parser.ae"
+  Vector *attributes = Vector__new();
+
+#line 1197 "./compiler/parser.ae"
+  while (Parser__consume_if(this, TokenType__AtSign)) {
+
+#line 1198 "./compiler/parser.ae"
+    Vector__push(attributes, Parser__consume(this, TokenType__Identifier));
+  } 
+
+#line 1200 "./compiler/parser.ae"
+  Parser__consume(this, TokenType__Def);
+
+#line 1202 "./compiler/parser.ae"
+  Type *struct_type = ((Type *)NULL);
+
+#line 1203 "./compiler/parser.ae"
+  char *struct_name = ((char *)NULL);
+
+#line 1204 "./compiler/parser.ae"
+  bool is_method = false;
+
+#line 1205 "./compiler/parser.ae"
+  bool is_static = false;
+
+#line 1208 "./compiler/parser.ae"
+  Token *next_token = ((Token *)Vector__at(this->tokens, (this->curr + 1)));
+
+#line 1209 "./compiler/parser.ae"
+  bool is_generic_method = false;
+
+#line 1210 "./compiler/parser.ae"
+  if (next_token->type == TokenType__LessThan) {
+
+#line 1211 "./compiler/parser.ae"
+    i32 end = Parser__skip_type_args(this, (this->curr + 1));
+
+#line 1212 "./compiler/parser.ae"
+    if ((end >= 0)) {
+
+#line 1213 "./compiler/parser.ae"
+      Token *after = ((Token *)Vector__at(this->tokens, end));
+
+#line 1214 "./compiler/parser.ae"
+      is_generic_method = after->type == TokenType__ColonColon;
+    } 
+  } 
+
+#line 1218 "./compiler/parser.ae"
+  bool is_template = false;
+
+#line 1219 "./compiler/parser.ae"
+  if ((is_generic_method && (!((bool)this->type_params)))) {
+
+#line 1221 "./compiler/parser.ae"
+    Token *name = Parser__consume(this, TokenType__Identifier);
+
+#line 1222 "./compiler/parser.ae"
+    Vector *params = Parser__parse_type_params(this);
+
+#line 1223 "./compiler/parser.ae"
+    if ((!Map__exists(this->method_templates, name->text))) {
+
+#line 1224 "./compiler/parser.ae"
+      Map__insert(this->method_templates, name->text, Vector__new());
+    } 
+
+#line 1226 "./compiler/parser.ae"
+    Vector *methods = ((Vector *)Map__get(this->method_templates, name->text));
+
+#line 1227 "./compiler/parser.ae"
+    Vector__push(methods, Template__new(name->text, params, this->tokens, start));
+
+#line 1229 "./compiler/parser.ae"
+    Parser__begin_template_definition(this, params);
+
+#line 1230 "./compiler/parser.ae"
+    is_template = true;
+
+#line 1231 "./compiler/parser.ae"
+    struct_type = Type__new(BaseType__Structure, name->span);
+
+#line 1232 "./compiler/parser.ae"
+    struct_type->name = name->text;
+
+#line 1233 "./compiler/parser.ae"
+    struct_name = name->text;
+
+#line 1234 "./compiler/parser.ae"
+    is_method = true;
+
+#line 1235 "./compiler/parser.ae"
+    Parser__consume(this, TokenType__ColonColon);
+  }  else 
+#line 1237 "./compiler/parser.ae"
+  if ((next_token->type == TokenType__ColonColon || is_generic_method)) {
+
+#line 1238 "./compiler/parser.ae"
+    struct_type = Parser__parse_type(this);
+
+#line 1239 "./compiler/parser.ae"
+    if ((!((bool)struct_type->name))) {
+
+#line 1240 "./compiler/parser.ae"
+      Parser__error(this, Error__new(struct_type->span, "Invalid type in method declaration"));
+    } 
+
+#line 1242 "./compiler/parser.ae"
+    struct_name = struct_type->name;
+
+#line 1243 "./compiler/parser.ae"
+    is_method = true;
+
+#line 1244 "./compiler/parser.ae"
+    Parser__consume(this, TokenType__ColonColon);
+  } 
+  
+
+#line 1247 "./compiler/parser.ae"
+  Token *name = Parser__consume(this, TokenType__Identifier);
+
+#line 1249 "./compiler/parser.ae"
+  Function *func = Function__new(name->span);
+
+#line 1250 "./compiler/parser.ae"
+  func->name = name->text;
+
+#line 1251 "./compiler/parser.ae"
+  func->is_method = is_method;
+
+#line 1254 "./compiler/parser.ae"
+  if (Parser__token_is(this, TokenType__LessThan)) {
+
+#line 1255 "./compiler/parser.ae"
+    if (((bool)this->instance_name)) {
+
+#line 1256 "./compiler/parser.ae"
+      Parser__parse_type_params(this);
+
+#line 1257 "./compiler/parser.ae"
+      func->name = this->instance_name;
+
+#line 1258 "./compiler/parser.ae"
+      this->instance_name = NULL;
+    }  else {
+
+#line 1260 "./compiler/parser.ae"
+      Vector *params = Parser__parse_type_params(this);
+
+#line 1261 "./compiler/parser.ae"
+      Parser__register_template(this, name->text, params, start, false);
+
+#line 1262 "./compiler/parser.ae"
+      Parser__begin_template_definition(this, params);
+
+#line 1263 "./compiler/parser.ae"
+      is_template = true;
+    } 
+  } 
+
+#line 1266 "./compiler/parser.ae"
+  func->method_struct_name = struct_name;
+
+#line 1268 "./compiler/parser.ae"
+  for (i32 i = 0; (i < attributes->size); i += 1) {
+
+#line 1269 "./compiler/parser.ae"
+    Parser__parse_function_attribute(this, func, ((Token *)Vector__at(attributes, i)));
+  } 
+
+#line 1271 "./compiler/parser.ae"
+  if ((func->is_inline && func->is_noinline)) {
+
+#line 1272 "./compiler/parser.ae"
+    Parser__error(this, Error__new(name->span, "Function cannot be both @inline and @noinline"));
+  } 
+
+#line 1274 "./compiler/parser.ae"
+  if ((func->is_hot && func->is_cold)) {
+
+#line 1275 "./compiler/parser.ae"
+    Parser__error(this, Error__new(name->span, "Function cannot be both @hot and @cold"));
+  } 
+
+#line 1278 "./compiler/parser.ae"
+  Parser__consume(this, TokenType__OpenParen);
+
+#line 1279 "./compiler/parser.ae"
+  while ((!Parser__token_is(this, TokenType__CloseParen))) {
+
+#line 1280 "./compiler/parser.ae"
+    bool found_amp = Parser__consume_if(this, TokenType__Ampersand);
+
+#line 1281 "./compiler/parser.ae"
+    Token *var_name = Parser__consume(this, TokenType__Identifier);
+
+#line 1282 "./compiler/parser.ae"
+    Type *type = ((Type *)NULL);
+
+#line 1283 "./compiler/parser.ae"
+    if ((Vector__empty(func->params) && is_method)) {
+
+#line 1284 "./compiler/parser.ae"
+      if (string__eq(var_name->text, "this")) {
+
+#line 1285 "./compiler/parser.ae"
+        type = struct_type;
+
+#line 1286 "./compiler/parser.ae"
+        if (found_amp) {
+
+#line 1287 "./compiler/parser.ae"
+          type = Type__new_link(BaseType__Pointer, type, name->span);
+        } 
+      }  else 
+#line 1289 "./compiler/parser.ae"
+      if (found_amp) {
+
+#line 1290 "./compiler/parser.ae"
+        Parser__error(this, Error__new(var_name->span, "Expected 'this' over here"));
+      }  else {
+
+#line 1292 "./compiler/parser.ae"
+        is_static = true;
+      } 
+      
+    } 
+
+#line 1295 "./compiler/parser.ae"
+    if ((!((bool)type))) {
+
+#line 1296 "./compiler/parser.ae"
+      Parser__consume(this, TokenType__Colon);
+
+#line 1297 "./compiler/parser.ae"
+      type = Parser__parse_type(this);
+    } 
+
+#line 1299 "./compiler/parser.ae"
+    Variable *var = Variable__new(var_name->text, type, var_name->span);
+
+#line 1300 "./compiler/parser.ae"
+    Vector__push(func->params, var);
+
+#line 1302 "./compiler/parser.ae"
+    if ((!Parser__token_is(this, TokenType__CloseParen))) {
+
+#line 1303 "./compiler/parser.ae"
+      Parser__consume(this, TokenType__Comma);
+    } 
+  } 
+
+#line 1306 "./compiler/parser.ae"
+  Parser__consume(this, TokenType__CloseParen);
+
+#line 1307 "./compiler/parser.ae"
+  if ((is_method && func->params->size == 0)) {
+
+#line 1308 "./compiler/parser.ae"
+    is_static = true;
+  } 
+
+#line 1310 "./compiler/parser.ae"
+  func->is_static = is_static;
+
+#line 1312 "./compiler/parser.ae"
+  if (Parser__consume_if(this, TokenType__Colon)) {
+
+#line 1313 "./compiler/parser.ae"
+    func->return_type = Parser__parse_type(this);
+  }  else 
+#line 1314 "./compiler/parser.ae"
+  if (string__eq(name->text, "main")) {
+
+#line 1315 "./compiler/parser.ae"
+    func->return_type = Type__new(BaseType__I32, name->span);
+  }  else {
+
+#line 1317 "./compiler/parser.ae"
+    func->return_type = Type__new(BaseType__Void, name->span);
+
+#line 1318 "./compiler/parser.ae"
+    if ((Parser__token_is(this, TokenType__Identifier) && string__eq(Parser__token(this)->text, "exits"))) {
+
+#line 1319 "./compiler/parser.ae"
+      Parser__consume(this, TokenType__Identifier);
+
+#line 1320 "./compiler/parser.ae"
+      func->exits = true;
+    }  else 
+#line 1321 "./compiler/parser.ae"
+    if ((Parser__token_is(this, TokenType__Identifier) && string__eq(Parser__token(this)->text, "yields"))) {
+
+#line 1322 "./compiler/parser.ae"
+      Parser__consume(this, TokenType__Identifier);
+
+#line 1323 "./compiler/parser.ae"
+      func->yield_type = Parser__parse_type(this);
+
+#line 1324 "./compiler/parser.ae"
+      func->frame_vars = Vector__new();
+    } 
+    
+  } 
+  
+
+#line 1328 "./compiler/parser.ae"
+  if (Parser__consume_if(this, TokenType__Extern)) {
+
+#line 1329 "./compiler/parser.ae"
+    func->is_extern = true;
+
+#line 1330 "./compiler/parser.ae"
+    func->extern_name = func->name;
+
+#line 1331 "./compiler/parser.ae"
+    if (Parser__consume_if(this, TokenType__OpenParen)) {
+
+#line 1332 "./compiler/parser.ae"
+      Token *name = Parser__consume(this, TokenType__StringLiteral);
+
+#line 1333 "./compiler/parser.ae"
+      func->extern_name = name->text;
+
+#line 1334 "./compiler/parser.ae"
+      Parser__consume(this, TokenType__CloseParen);
+    } 
+  }  else 
+#line 1336 "./compiler/parser.ae"
+  if (Parser__consume_if(this, TokenType__FatArrow)) {
+
+#line 1337 "./compiler/parser.ae"
+    if (((bool)func->yield_type)) {
+
+#line 1338 "./compiler/parser.ae"
+      Parser__error(this, Error__new(func->span, "Generators cannot be arrow functions"));
+    } 
+
+#line 1340 "./compiler/parser.ae"
+    func->is_arrow = true;
+
+#line 1341 "./compiler/parser.ae"
+    AST *expr = Parser__parse_expression(this, TokenType__Newline);
+
+#line 1342 "./compiler/parser.ae"
+    if ((!Parser__token(this)->seen_newline)) {
+
+#line 1343 "./compiler/parser.ae"
+      Span end_loc = (Span){expr->span.end, expr->span.end};
+
+#line 1344 "./compiler/parser.ae"
+      Parser__error(this, Error__new(end_loc, "Expected newline after arrow function"));
+    } 
+
+#line 1346 "./compiler/parser.ae"
+    AST *ret_stmt = AST__new_unop(ASTType__Return, expr->span, expr);
+
+#line 1347 "./compiler/parser.ae"
+    func->body = ret_stmt;
+  }  else {
+
+#line 1350 "./compiler/parser.ae"
+    func->is_extern = false;
+
+#line 1351 "./compiler/parser.ae"
+    func->body = Parser__parse_block(this);
+  } 
+  
+
+#line 1354 "./compiler/parser.ae"
+  if (is_template) {
+
+#line 1355 "./compiler/parser.ae"
+    Parser__end_template_definition(this);
+
+#line 1356 "./compiler/parser.ae"
+    return NULL;
+  } 
+
+#line 1358 "./compiler/parser.ae"
+  return func;
+}
+
+
+#line 1361 "./compiler/parser.ae"
+static __attribute__((unused)) Structure *Parser__parse_enum(Parser *this) {
+
+#line 1362 "./compiler/parser.ae"
+  Span start_span = Parser__consume(this, TokenType__Enum)->span;
+
+#line 1363 "./compiler/parser.ae"
+  Token *name = Parser__consume(this, TokenType__Identifier);
+
+#line 1365 "./compiler/parser.ae"
+  Structure *enum_def = Structure__new(Span__join(&start_span, &name->span));
+
+#line 1366 "./compiler/parser.ae"
+  enum_def->name = name->text;
+
+#line 1367 "./compiler/parser.ae"
+  enum_def->is_enum = true;
+
+#line 1369 "./compiler/parser.ae"
+  Type *type = Type__new(BaseType__Structure, name->span);
+
+#line 1370 "./compiler/parser.ae"
+  enum_def->type = type;
+
+#line 1371 "./compiler/parser.ae"
+  type->name = name->text;
+
+#line 1372 "./compiler/parser.ae"
+  type->struct_def = enum_def;
+
+#line 1374 "./compiler/parser.ae"
+  if (Parser__consume_if(this, TokenType__Extern)) {
+
+#line 1375 "./compiler/parser.ae"
+    enum_def->is_extern = true;
+
+#line 1376 "./compiler/parser.ae"
+    enum_def->extern_name = enum_def->name;
+
+#line 1377 "./compiler/parser.ae"
+    if (Parser__consume_if(this, TokenType__OpenParen)) {
+
+#line 1378 "./compiler/parser.ae"
+      Token *name = Parser__consume(this, TokenType__StringLiteral);
+
+#line 1379 "./compiler/parser.ae"
+      enum_def->extern_name = name->text;
+
+#line 1380 "./compiler/parser.ae"
+      Parser__consume(this, TokenType__CloseParen);
+    } 
+  } 
+
+#line 1384 "./compiler/parser.ae"
+  Parser__consume(this, TokenType__OpenCurly);
+
+#line 1385 "./compiler/parser.ae"
+  while ((!Parser__token_is(this, TokenType__CloseCurly))) {
+
+#line 1386 "./compiler/parser.ae"
+    Token *name = Parser__consume(this, TokenType__Identifier);
+
+#line 1387 "./compiler/parser.ae"
+    Type *type = Type__new(BaseType__I32, name->span);
+
+#line 1389 "./compiler/parser.ae"
+    Variable *var = Variable__new(name->text, type, name->span);
+
+#line 1392 "./compiler/parser.ae"
+    if (enum_def->is_extern) {
+
+#line 1393 "./compiler/parser.ae"
+      Parser__consume(this, TokenType__Equals);
+
+#line 1394 "./compiler/parser.ae"
+      Parser__consume(this, TokenType__Extern);
+
+#line 1395 "./compiler/parser.ae"
+      Parser__consume(this, TokenType__OpenParen);
+
+#line 1396 "./compiler/parser.ae"
+      Token *name = Parser__consume(this, TokenType__StringLiteral);
+
+#line 1397 "./compiler/parser.ae"
+      Parser__consume(this, TokenType__CloseParen);
+
+#line 1398 "./compiler/parser.ae"
+      var->extern_name = name->text;
+
+#line 1399 "./compiler/parser.ae"
+      var->is_extern = true;
+    } 
+
+#line 1402 "./compiler/parser.ae"
+    Vector__push(enum_def->fields, var);
+
+#line 1403 "./compiler/parser.ae"
+    if ((!Parser__token_is(this, TokenType__CloseCurly))) {
+
+#line 1404 "./compiler/parser.ae"
+      Parser__consume_newline_or(this, TokenType__Comma);
+    } 
+  } 
+
+#line 1407 "./compiler/parser.ae"
+  Parser__consume(this, TokenType__CloseCurly);
+
+#line 1409 "./compiler/parser.ae"
+  return enum_def;
+}
+
+
+#line 1412 "./compiler/parser.ae"
+static __attribute__((unused)) void Parser__parse_struct_attribute(Parser *this, Structure *struc, Token *attr) {
+
+#line 1413 "./compiler/parser.ae"
+  {
+    char *__match_str = attr->text;
+    if (!strcmp(__match_str, "reorder")) {
+
+#line 1414 "./compiler/parser.ae"
+      struc->is_reorder = true;
+    } else if (!strcmp(__match_str, "packed")) {
+
+#line 1415 "./compiler/parser.ae"
+      struc->is_packed = true;
+    } else  {
+
+#line 1416 "./compiler/parser.ae"
+      Parser__error(this, Error__new(attr->span, "Unknown struct attribute"));
+    }
+  }
+}
+
+
+#line 1421 "./compiler/parser.ae"
+static __attribute__((unused)) Structure *Parser__parse_struct(Parser *this) {
+
+#line 1422 "./compiler/parser.ae"
+  i32 start = this->curr;
+
+#line 1423 "./compiler/parser.ae"
+  Vector *attributes = Vector__new();
+
+#line 1424 "./compiler/parser.ae"
+  while (Parser__consume_if(this, TokenType__AtSign)) {
+
+#line 1425 "./compiler/parser.ae"
+    Vector__push(attributes, Parser__consume(this, TokenType__Identifier));
+  } 
+
+#line 1428 "./compiler/parser.ae"
+  bool is_union = false;
+
+#line 1429 "./compiler/parser.ae"
+  Span start_span = Parser__token(this)->span;
+
+#line 1430 "./compiler/parser.ae"
+  if (Parser__consume_if(this, TokenType__Union)) {
+
+#line 1431 "./compiler/parser.ae"
+    is_union = true;
+  }  else {
+
+#line 1433 "./compiler/parser.ae"
+    Parser__consume(this, TokenType__Struct);
+  } 
+
+#line 1436 "./compiler/parser.ae"
+  Token *name = Parser__consume(this, TokenType__Identifier);
+
+#line 1438 "./compiler/parser.ae"
+  Structure *struc = Structure__new(Span__join(&start_span, &name->span));
+
+#line 1439 "./compiler/parser.ae"
+  struc->name = name->text;
+
+#line 1442 "./compiler/parser.ae"
+  bool is_template = false;
+
+#line 1443 "./compiler/parser.ae"
+  if (Parser__token_is(this, TokenType__LessThan)) {
+
+#line 1444 "./compiler/parser.ae"
+    if (((bool)this->instance_name)) {
+
+#line 1445 "./compiler/parser.ae"
+      Parser__parse_type_params(this);
+
+#line 1446 "./compiler/parser.ae"
+      struc->name = this->instance_name;
+
+#line 1447 "./compiler/parser.ae"
+      this->instance_name = NULL;
+    }  else {
+
+#line 1449 "./compiler/parser.ae"
+      Vector *params = Parser__parse_type_params(this);
+
+#line 1450 "./compiler/parser.ae"
+      Parser__register_template(this, name->text, params, start, true);
+
+#line 1451 "./compiler/parser.ae"
+      Parser__begin_template_definition(this, params);
+
+#line 1452 "./compiler/parser.ae"
+      is_template = true;
+    } 
+  } 
+
+#line 1456 "./compiler/parser.ae"
+  if (Parser__consume_if(this, TokenType__Extern)) {
+
+#line 1457 "./compiler/parser.ae"
+    struc->is_extern = true;
+
+#line 1458 "./compiler/parser.ae"
+    struc->extern_name = struc->name;
+
+#line 1459 "./compiler/parser.ae"
+    if (Parser__consume_if(this, TokenType__OpenParen)) {
+
+#line 1460 "./compiler/parser.ae"
+      Token *name = Parser__consume(this, TokenType__StringLiteral);
+
+#line 1461 "./compiler/parser.ae"
+      struc->extern_name = name->text;
+
+#line 1462 "./compiler/parser.ae"
+      Parser__consume(this, TokenType__CloseParen);
+    } 
+  } 
+
+#line 1467 "./compiler/parser.ae"
+  if (((!struc->is_extern) || Parser__token_is(this, TokenType__OpenCurly))) {
+
+#line 1468 "./compiler/parser.ae"
+    Parser__consume(this, TokenType__OpenCurly);
+
+#line 1469 "./compiler/parser.ae"
+    while ((!Parser__token_is(this, TokenType__CloseCurly))) {
+
+#line 1470 "./compiler/parser.ae"
+      Token *name = Parser__consume(this, TokenType__Identifier);
+
+#line 1471 "./compiler/parser.ae"
+      Parser__consume(this, TokenType__Colon);
+
+#line 1472 "./compiler/parser.ae"
+      Type *type = Parser__parse_type(this);
+
+#line 1474 "./compiler/parser.ae"
+      Variable *var = Variable__new(name->text, type, name->span);
+
+#line 1475 "./compiler/parser.ae"
+      Vector__push(struc->fields, var);
+
+#line 1476 "./compiler/parser.ae"
+      if ((!Parser__token_is(this, TokenType__CloseCurly))) {
+
+#line 1477 "./compiler/parser.ae"
+        Parser__consume_newline_or(this, TokenType__Comma);
+      } 
+    } 
+
+#line 1480 "./compiler/parser.ae"
+    Parser__consume(this, TokenType__CloseCurly);
+  } 
+
+#line 1483 "./compiler/parser.ae"
+  if (is_template) {
+
+#line 1484 "./compiler/parser.ae"
+    Parser__end_template_definition(this);
+
+#line 1485 "./compiler/parser.ae"
+    return NULL;
+  } 
+
+#line 1488 "./compiler/parser.ae"
+  Type *type = Type__new(BaseType__Structure, name->span);
+
+#line 1489 "./compiler/parser.ae"
+  type->name = struc->name;
+
+#line 1490 "./compiler/parser.ae"
+  struc->type = type;
+
+#line 1491 "./compiler/parser.ae"
+  type->struct_def = struc;
+
+#line 1492 "./compiler/parser.ae"
+  struc->is_union = is_union;
+
+#line 1494 "./compiler/parser.ae"
+  for (i32 i = 0; (i < attributes->size); i += 1) {
+
+#line 1495 "./compiler/parser.ae"
+    Parser__parse_struct_attribute(this, struc, ((Token *)Vector__at(attributes, i)));
+  } 
+
+#line 1497 "./compiler/parser.ae"
+  if ((struc->is_extern && (attributes->size > 0))) {
+
+#line 1498 "./compiler/parser.ae"
+    Parser__error(this, Error__new(struc->span, "Extern structs cannot have attributes"));
+  }  else 
+#line 1499 "./compiler/parser.ae"
+  if ((struc->is_union && struc->is_reorder)) {
+
+#line 1500 "./compiler/parser.ae"
+    Parser__error(this, Error__new(struc->span, "Union fields cannot be reordered"));
+  } 
+  
+
+#line 1503 "./compiler/parser.ae"
+  return struc;
+}
+
+
+#line 1506 "./compiler/parser.ae"
+static __attribute__((unused)) AST *Parser__parse_global_value(Parser *this, bool is_constant) {
+
+#line 1507 "./compiler/parser.ae"
+  Token *start_token = ({ Token *__yield_0;
+
+#line 1507 "./compiler/parser.ae"
+  if (is_constant) {
+
+#line 1508 "./compiler/parser.ae"
+    __yield_0 = Parser__consume(this, TokenType__Const);
+  }  else {
+
+#line 1510 "./compiler/parser.ae"
+    __yield_0 = Parser__consume(this, TokenType__Let);
+  } 
+;__yield_0; });
+
+#line 1513 "./compiler/parser.ae"
+  AST *node = AST__new(ASTType__VarDeclaration, Parser__token(this)->span);
+
+#line 1514 "./compiler/parser.ae"
+  Token *name = ({ Token *__yield_0;
+
+#line 1514 "./compiler/parser.ae"
+  if (Parser__token_is(this, TokenType__Identifier)) {
+
+#line 1515 "./compiler/parser.ae"
+    __yield_0 = Parser__consume(this, TokenType__Identifier);
+  }  else {
+
+#line 1517 "./compiler/parser.ae"
+    Parser__error(this, Error__new(Parser__token(this)->span, "Expected identifier"));
+
+#line 1518 "./compiler/parser.ae"
+    return node;
+  } 
+;__yield_0; });
+
+#line 1521 "./compiler/parser.ae"
+  Type *type = ((Type *)NULL);
+
+#line 1522 "./compiler/parser.ae"
+  if (Parser__consume_if(this, TokenType__Colon)) {
+
+#line 1522 "./compiler/parser.ae"
+    type = Parser__parse_type(this);
+  } 
+
+#line 1524 "./compiler/parser.ae"
+  Variable *var = Variable__new(name->text, type, name->span);
+
+#line 1525 "./compiler/parser.ae"
+  node->u.var_decl.var = var;
+
+#line 1527 "./compiler/parser.ae"
+  if (Parser__consume_if(this, TokenType__Extern)) {
+
+#line 1528 "./compiler/parser.ae"
+    var->is_extern = true;
+
+#line 1529 "./compiler/parser.ae"
+    if (Parser__consume_if(this, TokenType__OpenParen)) {
+
+#line 1530 "./compiler/parser.ae"
+      Token *name = Parser__consume(this, TokenType__StringLiteral);
+
+#line 1531 "./compiler/parser.ae"
+      var->extern_name = name->text;
+
+#line 1532 "./compiler/parser.ae"
+      Parser__consume(this, TokenType__CloseParen);
+    }  else {
+
+#line 1534 "./compiler/parser.ae"
+      var->extern_name = var->name;
+    } 
+
+#line 1537 "./compiler/parser.ae"
+    if ((!((bool)type))) {
+
+#line 1538 "./compiler/parser.ae"
+      Parser__error(this, Error__new(name->span, "Extern values must have a type specified"));
+    } 
+  }  else {
+
+#line 1541 "./compiler/parser.ae"
+    var->is_extern = false;
+
+#line 1542 "./compiler/parser.ae"
+    if (Parser__consume_if(this, TokenType__Equals)) {
+
+#line 1543 "./compiler/parser.ae"
+      node->u.var_decl.init = Parser__parse_expression(this, TokenType__Newline);
+    } 
+  } 
+
+#line 1546 "./compiler/parser.ae"
+  Parser__consume_newline_or(this, TokenType__Semicolon);
+
+#line 1547 "./compiler/parser.ae"
+  return node;
+}
+
+
+#line 1550 "./compiler/parser.ae"
+static __attribute__((unused)) char *Parser__find_file_path(Parser *this, char *filename) {
+
+#line 1552 "./compiler/parser.ae"
+  if (string__starts_with(filename, "/")) 
+
+#line 1552 "./compiler/parser.ae"
+  return filename;
+  
+
+#line 1555 "./compiler/parser.ae"
+  if (string__starts_with(filename, "@/")) {
+
+#line 1556 "./compiler/parser.ae"
+    char *file_path = format_string("%s/%s", this->project_root, (filename + 2));
+
+#line 1557 "./compiler/parser.ae"
+    if (File__exists(file_path)) 
+
+#line 1558 "./compiler/parser.ae"
+    return file_path;
+    
+
+#line 1559 "./compiler/parser.ae"
+    free(file_path);
+  }  else {
+
+#line 1563 "./compiler/parser.ae"
+    for (i32 i = 0; (i < this->include_dirs->size); i += 1) {
+
+#line 1564 "./compiler/parser.ae"
+      char *dir = ((char *)Vector__at(this->include_dirs, i));
+
+#line 1566 "./compiler/parser.ae"
+      char *file_path = format_string("%s/%s", dir, filename);
+
+#line 1567 "./compiler/parser.ae"
+      if (File__exists(file_path)) 
+
+#line 1568 "./compiler/parser.ae"
+      return file_path;
+      
+
+#line 1569 "./compiler/parser.ae"
+      free(file_path);
+    } 
+  } 
+
+#line 1574 "./compiler/parser.ae"
+  if (this->curr == 0) {
+
+#line 1575 "./compiler/parser.ae"
+    printf("---------------------------------------------------------------""\n");
+
+#line 1576 "./compiler/parser.ae"
+    printf("[-] Error: Could not find file '%s'""\n", filename);
+
+#line 1577 "./compiler/parser.ae"
+    printf("[+] Hint: Specify the aecor root directory with the -l option""\n");
+
+#line 1578 "./compiler/parser.ae"
+    printf("---------------------------------------------------------------""\n");
+
+#line 1579 "./compiler/parser.ae"
+    printf("burhhhh0""\n");
+
+#line 1579 "./compiler/parser.ae"
+    exit(1);
+  } 
+
+#line 1582 "./compiler/parser.ae"
+  this->curr -= 1;
+
+#line 1583 "./compiler/parser.ae"
+  Parser__error(this, Error__new(Parser__token(this)->span, format_string("Could not find file: %s", filename)));
+
+#line 1584 "./compiler/parser.ae"
+  this->curr += 1;
+
+#line 1586 "./compiler/parser.ae"
+  return NULL;
+}
+
+
+#line 1589 "./compiler/parser.ae"
+static __attribute__((unused)) char *Parser__include_file(Parser *this, Program *program, char *filename) {
+
+#line 1590 "./compiler/parser.ae"
+  filename = Parser__find_file_path(this, filename);
+
+#line 1591 "./compiler/parser.ae"
+  if ((!((bool)filename))) 
+
+#line 1591 "./compiler/parser.ae"
+  return NULL;
+  
+
+#line 1593 "./compiler/parser.ae"
+  if (Program__is_file_included(program, filename)) 
+
+#line 1594 "./compiler/parser.ae"
+  return filename;
+  
+
+#line 1595 "./compiler/parser.ae"
+  Program__add_included_file(program, filename);
+
+#line 1597 "./compiler/parser.ae"
+  FILE *file = File__open(filename, "r");
+
+#line 1598 "./compiler/parser.ae"
+  char *contents = File__slurp(file);
+
+#line 1600 "./compiler/parser.ae"
+  Lexer lexer = Lexer__make(contents, filename);
+
+#line 1601 "./compiler/parser.ae"
+  Vector *tokens = Lexer__lex((&lexer));
+
+#line 1603 "./compiler/parser.ae"
+  for (i32 i = 0; (i < lexer.errors->size); i += 1) {
+
+#line 1604 "./compiler/parser.ae"
+    Parser__error(this, Vector__at(lexer.errors, i));
+  } 
+
+#line 1606 "./compiler/parser.ae"
+  Vector__free(lexer.errors);
+
+#line 1608 "./compiler/parser.ae"
+  Parser__push_context(this, tokens);
+
+#line 1609 "./compiler/parser.ae"
+  Parser__find_templates(this);
+
+#line 1610 "./compiler/parser.ae"
+  Parser__parse_into_program(this, program);
+
+#line 1611 "./compiler/parser.ae"
+  Parser__pop_context(this);
+
+#line 1614 "./compiler/parser.ae"
+  if (Vector__empty(this->context_stack)) {
+
+#line 1615 "./compiler/parser.ae"
+    Parser__instantiate_templates(this, program);
+  } 
+
+#line 1617 "./compiler/parser.ae"
+  return filename;
+}
+
+
+#line 1620 "./compiler/parser.ae"
+static __attribute__((unused)) void Parser__parse_use(Parser *this, Program *program) {
+
+#line 1621 "./compiler/parser.ae"
+  Parser__consume(this, TokenType__Use);
+
+#line 1622 "./compiler/parser.ae"
+  Token *name = Parser__consume(this, TokenType__StringLiteral);
+
+#line 1623 "./compiler/parser.ae"
+  Parser__consume_newline_or(this, TokenType__Semicolon);
+
+#line 1624 "./compiler/parser.ae"
+  Parser__include_file(this, program, name->text);
+}
+
+
+#line 1628 "./compiler/parser.ae"
+static __attribute__((unused)) void Parser__parse_compiler_option(Parser *this, Program *program) {
+
+#line 1629 "./compiler/parser.ae"
+  Parser__consume(this, TokenType__AtSign);
+
+#line 1630 "./compiler/parser.ae"
+  Token *compiler = Parser__consume(this, TokenType__Identifier);
+
+#line 1631 "./compiler/parser.ae"
+  if ((!string__eq(compiler->text, "compiler"))) {
+
+#line 1632 "./compiler/parser.ae"
+    Parser__error(this, Error__new(compiler->span, "Expected 'compiler'"));
+  } 
+
+#line 1635 "./compiler/parser.ae"
+  Token *name = Parser__consume(this, TokenType__Identifier);
+
+#line 1636 "./compiler/parser.ae"
+  {
+    char *__match_str = name->text;
+    if (!strcmp(__match_str, "c_include")) {
+
+#line 1638 "./compiler/parser.ae"
+      Token *filename = Parser__consume(this, TokenType__StringLiteral);
+
+#line 1639 "./compiler/parser.ae"
+      Vector__push(program->c_includes, filename->text);
+    } else if (!strcmp(__match_str, "c_flag")) {
+
+#line 1642 "./compiler/parser.ae"
+      Token *flag = Parser__consume(this, TokenType__StringLiteral);
+
+#line 1643 "./compiler/parser.ae"
+      Vector__push(program->c_flags, flag->text);
+    } else if (!strcmp(__match_str, "c_embed_header")) {
+
+#line 1646 "./compiler/parser.ae"
+      Token *filename = Parser__consume(this, TokenType__StringLiteral);
+
+#line 1647 "./compiler/parser.ae"
+      char *resolved = Parser__find_file_path(this, filename->text);
+
+#line 1648 "./compiler/parser.ae"
+      Vector__push(program->c_embed_headers, resolved);
+    } else  {
+
+#line 1650 "./compiler/parser.ae"
+      Parser__error(this, Error__new(name->span, "Unknown compiler option"));
+    }
+  }
+}
+
+
+#line 1654 "./compiler/parser.ae"
+static __attribute__((unused)) void Parser__parse_into_program(Parser *this, Program *program) {
+
+#line 1655 "./compiler/parser.ae"
+  while ((!Parser__token_is(this, TokenType__EOF))) {
+
+#line 1656 "./compiler/parser.ae"
+    switch (Parser__token(this)->type) {
+      case TokenType__Use: {
+
+#line 1657 "./compiler/parser.ae"
+        Parser__parse_use(this, program);
+      } break;
+      case TokenType__AtSign: {
+
+#line 1661 "./compiler/parser.ae"
+        Token *next = ((Token *)Vector__at(this->tokens, (this->curr + 1)));
+
+#line 1662 "./compiler/parser.ae"
+        i32 after = this->curr;
+
+#line 1663 "./compiler/parser.ae"
+        while ((((after + 2) < this->tokens->size) && ((Token *)Vector__at(this->tokens, after))->type == TokenType__AtSign)) {
+
+#line 1664 "./compiler/parser.ae"
+          after += 2;
+        } 
+
+#line 1666 "./compiler/parser.ae"
+        Token *decl = ((Token *)Vector__at(this->tokens, after));
+
+#line 1667 "./compiler/parser.ae"
+        if (string__eq(next->text, "compiler")) {
+
+#line 1668 "./compiler/parser.ae"
+          Parser__parse_compiler_option(this, program);
+        }  else 
+#line 1669 "./compiler/parser.ae"
+        if ((decl->type == TokenType__Struct || decl->type == TokenType__Union)) {
+
+#line 1670 "./compiler/parser.ae"
+          Structure *structure = Parser__parse_struct(this);
+
+#line 1671 "./compiler/parser.ae"
+          if (((bool)structure)) 
+
+#line 1671 "./compiler/parser.ae"
+          Vector__push(program->structures, structure);
+          
+        }  else {
+
+#line 1673 "./compiler/parser.ae"
+          Function *func = Parser__parse_function(this);
+
+#line 1674 "./compiler/parser.ae"
+          if (((bool)func)) 
+
+#line 1674 "./compiler/parser.ae"
+          Vector__push(program->functions, func);
+          
+        } 
+        
+      } break;
+      case TokenType__Def: {
+
+#line 1678 "./compiler/parser.ae"
+        Function *func = Parser__parse_function(this);
+
+#line 1679 "./compiler/parser.ae"
+        if (((bool)func)) 
+
+#line 1679 "./compiler/parser.ae"
+        Vector__push(program->functions, func);
+        
+      } break;
+      case TokenType__Let: {
+
+#line 1682 "./compiler/parser.ae"
+        AST *node = Parser__parse_global_value(this, false);
+
+#line 1683 "./compiler/parser.ae"
+        Vector__push(program->global_vars, node);
+      } break;
+      case TokenType__Const: {
+
+#line 1686 "./compiler/parser.ae"
+        AST *node = Parser__parse_global_value(this, true);
+
+#line 1687 "./compiler/parser.ae"
+        Vector__push(program->constants, node);
+      } break;
+      case TokenType__Struct:
+      case TokenType__Union: {
+
+#line 1690 "./compiler/parser.ae"
+        Structure *structure = Parser__parse_struct(this);
+
+#line 1691 "./compiler/parser.ae"
+        if (((bool)structure)) 
+
+#line 1691 "./compiler/parser.ae"
+        Vector__push(program->structures, structure);
+        
+      } break;
+      case TokenType__Enum: {
+
+#line 1694 "./compiler/parser.ae"
+        Structure *structure = Parser__parse_enum(this);
+
+#line 1695 "./compiler/parser.ae"
+        Vector__push(program->structures, structure);
+      } break;
+      default: {
+
+#line 1697 "./compiler/parser.ae"
+        Parser__unhandled_type(this, "parse_program");
+      } break;
+    }
+  } 
+}
+
+
+#line 1702 "./compiler/parser.ae"
+static __attribute__((unused)) void Parser__include_prelude(Parser *this, Program *program) {
+
+#line 1703 "./compiler/parser.ae"
+  this->program = program;
+
+#line 1704 "./compiler/parser.ae"
+  Parser__include_file(this, program, "lib/prelude.ae");
+}
+
+
+#line 23 "./lib/bitset.ae"
+static __attribute__((unused)) Bitset *Bitset__new(i32 size) {
+
+#line 24 "./lib/bitset.ae"
+  Bitset *bits = ((Bitset *)calloc(1, sizeof(Bitset)));
+
+#line 25 "./lib/bitset.ae"
+  bits->size = size;
+
+#line 26 "./lib/bitset.ae"
+  bits->num_words = ((size + 63) / 64);
+
+#line 27 "./lib/bitset.ae"
+  bits->words = ((u64 *)calloc(max(bits->num_words, 1), sizeof(u64)));
+
+#line 28 "./lib/bitset.ae"
+  return bits;
+}
+
+
+#line 31 "./lib/bitset.ae"
+static inline __attribute__((unused)) __attribute__((always_inline)) u64 Bitset__mask(i32 i) {
+
+#line 31 "./lib/bitset.ae"
+  return (1ULL << ((u64)(i & 63)));
+}
+
+
+#line 33 "./lib/bitset.ae"
+static inline __attribute__((unused)) __attribute__((always_inline)) bool Bitset__test(Bitset *this, i32 i) {
+
+#line 34 "./lib/bitset.ae"
+  (__builtin_expect(!!(((i >= 0) && (i < this->size))), 1) ? (void)0 : panic("test out of bounds in bitset"));
+
+#line 35 "./lib/bitset.ae"
+  return ((this->words[(i / 64)] & Bitset__mask(i)) != 0);
+}
+
+
+#line 38 "./lib/bitset.ae"
+static inline __attribute__((unused)) __attribute__((always_inline)) void Bitset__set(Bitset *this, i32 i) {
+
+#line 39 "./lib/bitset.ae"
+  (__builtin_expect(!!(((i >= 0) && (i < this->size))), 1) ? (void)0 : panic("set out of bounds in bitset"));
+
+#line 40 "./lib/bitset.ae"
+  this->words[(i / 64)] = (this->words[(i / 64)] | Bitset__mask(i));
+}
+
+
+#line 43 "./lib/bitset.ae"
+static inline __attribute__((unused)) __attribute__((always_inline)) void Bitset__clear(Bitset *this, i32 i) {
+
+#line 44 "./lib/bitset.ae"
+  (__builtin_expect(!!(((i >= 0) && (i < this->size))), 1) ? (void)0 : panic("clear out of bounds in bitset"));
+
+#line 45 "./lib/bitset.ae"
+  this->words[(i / 64)] = (this->words[(i / 64)] & (~Bitset__mask(i)));
+}
+
+
+#line 48 "./lib/bitset.ae"
+static __attribute__((unused)) void Bitset__assign(Bitset *this, i32 i, bool value) {
+
+#line 49 "./lib/bitset.ae"
+  if (value) 
+
+#line 49 "./lib/bitset.ae"
+  Bitset__set(this, i);
+   else 
+
+#line 49 "./lib/bitset.ae"
+  Bitset__clear(this, i);
+  
+}
+
+
+#line 52 "./lib/bitset.ae"
+static __attribute__((unused)) void Bitset__set_all(Bitset *this) {
+
+#line 53 "./lib/bitset.ae"
+  memset(this->words, 0xFF, (this->num_words * sizeof(u64)));
+
+#line 54 "./lib/bitset.ae"
+  i32 extra = (this->size & 63);
+
+#line 55 "./lib/bitset.ae"
+  if ((extra != 0)) {
+
+#line 56 "./lib/bitset.ae"
+    this->words[(this->num_words - 1)] = ((1ULL << ((u64)extra)) - 1ULL);
+  } 
+}
+
+
+#line 60 "./lib/bitset.ae"
+static __attribute__((unused)) void Bitset__clear_all(Bitset *this) {
+
+#line 61 "./lib/bitset.ae"
+  memset(this->words, 0, (this->num_words * sizeof(u64)));
+}
+
+
+#line 65 "./lib/bitset.ae"
+static __attribute__((unused)) i32 Bitset__count(Bitset *this) {
+
+#line 66 "./lib/bitset.ae"
+  i32 total = 0;
+
+#line 67 "./lib/bitset.ae"
+  for (i32 w = 0; (w < this->num_words); w += 1) {
+
+#line 68 "./lib/bitset.ae"
+    total += __builtin_popcountll(this->words[w]);
+  } 
+
+#line 70 "./lib/bitset.ae"
+  return total;
+}
+
+
+#line 74 "./lib/bitset.ae"
+static __attribute__((unused)) i32 Bitset__rank(Bitset *this, i32 i) {
+
+#line 75 "./lib/bitset.ae"
+  (__builtin_expect(!!(((i >= 0) && (i <= this->size))), 1) ? (void)0 : panic("rank out of bounds in bitset"));
+
+#line 76 "./lib/bitset.ae"
+  i32 total = 0;
+
+#line 77 "./lib/bitset.ae"
+  for (i32 w = 0; (w < (i / 64)); w += 1) {
+
+#line 78 "./lib/bitset.ae"
+    total += __builtin_popcountll(this->words[w]);
+  } 
+
+#line 80 "./lib/bitset.ae"
+  if (((i & 63) != 0)) {
+
+#line 81 "./lib/bitset.ae"
+    total += __builtin_popcountll((this->words[(i / 64)] & (Bitset__mask(i) - 1ULL)));
+  } 
+
+#line 83 "./lib/bitset.ae"
+  return total;
+}
+
+
+#line 88 "./lib/bitset.ae"
+static __attribute__((unused)) i32 Bitset__select(Bitset *this, i32 rank) {
+
+#line 89 "./lib/bitset.ae"
+  for (i32 w = 0; (w < this->num_words); w += 1) {
+
+#line 90 "./lib/bitset.ae"
+    u64 word = this->words[w];
+
+#line 91 "./lib/bitset.ae"
+    i32 count = __builtin_popcountll(word);
+
+#line 92 "./lib/bitset.ae"
+    if ((rank < count)) {
+
+#line 93 "./lib/bitset.ae"
+      for (i32 k = 0; (k < rank); k += 1) {
+
+#line 94 "./lib/bitset.ae"
+        word = (word & (word - 1ULL));
+      } 
+
+#line 96 "./lib/bitset.ae"
+      return ((w * 64) + __builtin_ctzll(word));
+    } 
+
+#line 98 "./lib/bitset.ae"
+    rank -= count;
+  } 
+
+#line 100 "./lib/bitset.ae"
+  return (-1);
+}
+
+
+#line 104 "./lib/bitset.ae"
+static __attribute__((unused)) i32 Bitset__next_set(Bitset *this, i32 start) {
+
+#line 105 "./lib/bitset.ae"
+  if ((start >= this->size)) 
+
+#line 105 "./lib/bitset.ae"
+  return (-1);
+  
+
+#line 106 "./lib/bitset.ae"
+  i32 w = (start / 64);
+
+#line 107 "./lib/bitset.ae"
+  u64 word = (this->words[w] & (~(Bitset__mask(start) - 1ULL)));
+
+#line 108 "./lib/bitset.ae"
+  while (true) {
+
+#line 109 "./lib/bitset.ae"
+    if ((word != 0)) 
+
+#line 109 "./lib/bitset.ae"
+    return ((w * 64) + __builtin_ctzll(word));
+    
+
+#line 110 "./lib/bitset.ae"
+    w += 1;
+
+#line 111 "./lib/bitset.ae"
+    if ((w >= this->num_words)) 
+
+#line 111 "./lib/bitset.ae"
+    return (-1);
+    
+
+#line 112 "./lib/bitset.ae"
+    word = this->words[w];
+  } 
+
+#line 114 "./lib/bitset.ae"
+  return (-1);
+}
+
+
+#line 118 "./lib/bitset.ae"
+static __attribute__((unused)) i32 Bitset__next_clear(Bitset *this, i32 start) {
+
+#line 119 "./lib/bitset.ae"
+  if ((start >= this->size)) 
+
+#line 119 "./lib/bitset.ae"
+  return (-1);
+  
+
+#line 120 "./lib/bitset.ae"
+  i32 w = (start / 64);
+
+#line 121 "./lib/bitset.ae"
+  u64 word = ((~this->words[w]) & (~(Bitset__mask(start) - 1ULL)));
+
+#line 122 "./lib/bitset.ae"
+  while (true) {
+
+#line 123 "./lib/bitset.ae"
+    if ((word != 0)) {
+
+#line 124 "./lib/bitset.ae"
+      i32 i = ((w * 64) + __builtin_ctzll(word));
+
+#line 125 "./lib/bitset.ae"
+      return ((i < this->size) ? i : (-1));
+    } 
+
+#line 127 "./lib/bitset.ae"
+    w += 1;
+
+#line 128 "./lib/bitset.ae"
+    if ((w >= this->num_words)) 
+
+#line 128 "./lib/bitset.ae"
+    return (-1);
+    
+
+#line 129 "./lib/bitset.ae"
+    word = (~this->words[w]);
+  } 
+
+#line 131 "./lib/bitset.ae"
+  return (-1);
+}
+
+
+#line 136 "./lib/bitset.ae"
+static __attribute__((unused)) void Bitset__and_with(Bitset *this, Bitset *other) {
+
+#line 137 "./lib/bitset.ae"
+  (__builtin_expect(!!(this->size == other->size), 1) ? (void)0 : panic("and_with on bitsets of different sizes"));
+
+#line 138 "./lib/bitset.ae"
+  for (i32 w = 0; (w < this->num_words); w += 1) {
+
+#line 139 "./lib/bitset.ae"
+    this->words[w] = (this->words[w] & other->words[w]);
+  } 
+}
+
+
+#line 143 "./lib/bitset.ae"
+static __attribute__((unused)) void Bitset__or_with(Bitset *this, Bitset *other) {
+
+#line 144 "./lib/bitset.ae"
+  (__builtin_expect(!!(this->size == other->size), 1) ? (void)0 : panic("or_with on bitsets of different sizes"));
+
+#line 145 "./lib/bitset.ae"
+  for (i32 w = 0; (w < this->num_words); w += 1) {
+
+#line 146 "./lib/bitset.ae"
+    this->words[w] = (this->words[w] | other->words[w]);
+  } 
+}
+
+
+#line 150 "./lib/bitset.ae"
+static __attribute__((unused)) void Bitset__xor_with(Bitset *this, Bitset *other) {
+
+#line 151 "./lib/bitset.ae"
+  (__builtin_expect(!!(this->size == other->size), 1) ? (void)0 : panic("xor_with on bitsets of different sizes"));
+
+#line 152 "./lib/bitset.ae"
+  for (i32 w = 0; (w < this->num_words); w += 1) {
+
+#line 153 "./lib/bitset.ae"
+    this->words[w] = (this->words[w] ^ other->words[w]);
+  } 
+}
+
+
+#line 158 "./lib/bitset.ae"
+static __attribute__((unused)) void Bitset__and_not_with(Bitset *this, Bitset *other) {
+
+#line 159 "./lib/bitset.ae"
+  (__builtin_expect(!!(this->size == other->size), 1) ? (void)0 : panic("and_not_with on bitsets of different sizes"));
+
+#line 160 "./lib/bitset.ae"
+  for (i32 w = 0; (w < this->num_words); w += 1) {
+
+#line 161 "./lib/bitset.ae"
+    this->words[w] = (this->words[w] & (~other->words[w]));
+  } 
+}
+
+
+#line 165 "./lib/bitset.ae"
+static __attribute__((unused)) void Bitset__free(Bitset *this) {
+
+#line 166 "./lib/bitset.ae"
+  free(this->words);
+
+#line 167 "./lib/bitset.ae"
+  free(this);
+}
+
+
+#line 21 "./compiler/typecheck.ae"
+static __attribute__((unused)) void TypeChecker__error(TypeChecker *this, Error *err) {
+
+#line 22 "./compiler/typecheck.ae"
+  Vector__push(this->program->errors, err);
+}
+
+
+#line 25 "./compiler/typecheck.ae"
+static __attribute__((unused)) TypeChecker *TypeChecker__new(void) {
+
+#line 26 "./compiler/typecheck.ae"
+  TypeChecker *checker = ((TypeChecker *)calloc(1, sizeof(TypeChecker)));
+
+#line 27 "./compiler/typecheck.ae"
+  checker->scopes = Vector__new();
+
+#line 28 "./compiler/typecheck.ae"
+  checker->functions = Map__new();
+
+#line 29 "./compiler/typecheck.ae"
+  checker->structures = Map__new();
+
+#line 30 "./compiler/typecheck.ae"
+  checker->methods = Map__new();
+
+#line 31 "./compiler/typecheck.ae"
+  checker->constants = Map__new();
+
+#line 34 "./compiler/typecheck.ae"
+  Map__insert(checker->methods, "string", Map__new());
+
+#line 36 "./compiler/typecheck.ae"
+  return checker;
+}
+
+
+#line 39 "./compiler/typecheck.ae"
+static __attribute__((unused)) void TypeChecker__push_scope(TypeChecker *this) {
+
+#line 40 "./compiler/typecheck.ae"
+  Map *scope = Map__new();
+
+#line 41 "./compiler/typecheck.ae"
+  Vector__push(this->scopes, scope);
+}
+
+
+#line 44 "./compiler/typecheck.ae"
+static __attribute__((unused)) Map *TypeChecker__scope(TypeChecker *this) {
+
+#line 44 "./compiler/typecheck.ae"
+  return Vector__back(this->scopes);
+}
+
+
+#line 46 "./compiler/typecheck.ae"
+static __attribute__((unused)) void TypeChecker__pop_scope(TypeChecker *this) {
+
+#line 47 "./compiler/typecheck.ae"
+  Map *scope = ((Map *)Vector__pop(this->scopes));
+
+#line 48 "./compiler/typecheck.ae"
+  Map__free(scope);
+}
+
+
+#line 51 "./compiler/typecheck.ae"
+static __attribute__((unused)) Variable *TypeChecker__find_constant(TypeChecker *this, char *name) {
+
+#line 51 "./compiler/typecheck.ae"
+  return Map__get(this->constants, name);
+}
+
+
+#line 53 "./compiler/typecheck.ae"
+static __attribute__((unused)) void TypeChecker__push_var(TypeChecker *this, Variable *var) {
+
+#line 54 "./compiler/typecheck.ae"
+  Map *scope = TypeChecker__scope(this);
+
+#line 55 "./compiler/typecheck.ae"
+  Variable *existing = ((Variable *)Map__get(scope, var->name));
+
+#line 56 "./compiler/typecheck.ae"
+  if (((bool)existing)) {
+
+#line 57 "./compiler/typecheck.ae"
+    TypeChecker__error(this, Error__new_hint(var->span, "Variable is already defined in scope", existing->span, "Previous definition here"));
+
+#line 61 "./compiler/typecheck.ae"
+    return;
+  } 
+
+#line 63 "./compiler/typecheck.ae"
+  AST *constant = ((AST *)TypeChecker__find_constant(this, var->name));
+
+#line 64 "./compiler/typecheck.ae"
+  if (((bool)constant)) {
+
+#line 65 "./compiler/typecheck.ae"
+    TypeChecker__error(this, Error__new_hint(var->span, "Variable is already defined as a constant", constant->span, "Previous definition here"));
+  } 
+
+#line 70 "./compiler/typecheck.ae"
+  Map__insert(TypeChecker__scope(this), var->name, var);
+}
+
+
+#line 73 "./compiler/typecheck.ae"
+static __attribute__((unused)) Variable *TypeChecker__find_var(TypeChecker *this, char *name) {
+
+#line 74 "./compiler/typecheck.ae"
+  for (i32 i = (this->scopes->size - 1); (i >= 0); i -= 1) {
+
+#line 75 "./compiler/typecheck.ae"
+    Map *scope = ((Map *)Vector__at(this->scopes, i));
+
+#line 76 "./compiler/typecheck.ae"
+    Variable *var = ((Variable *)Map__get(scope, name));
+
+#line 77 "./compiler/typecheck.ae"
+    if (((bool)var)) 
+
+#line 77 "./compiler/typecheck.ae"
+    return var;
+    
+  } 
+
+#line 79 "./compiler/typecheck.ae"
+  return TypeChecker__find_constant(this, name);
+}
+
+
+#line 82 "./compiler/typecheck.ae"
+static __attribute__((unused)) Variable *TypeChecker__get_struct_member(TypeChecker *this, char *lhs, char *rhs) {
+
+#line 83 "./compiler/typecheck.ae"
+  Structure *struc = ((Structure *)Map__get(this->structures, lhs));
+
+#line 84 "./compiler/typecheck.ae"
+  return (((bool)struc) ? Structure__find_field(struc, rhs) : NULL);
+}
+
+
+#line 87 "./compiler/typecheck.ae"
+static __attribute__((unused)) bool TypeChecker__type_is_valid(TypeChecker *this, Type *type) {
+
+#line 88 "./compiler/typecheck.ae"
+  if ((!((bool)type))) 
+
+#line 88 "./compiler/typecheck.ae"
+  return false;
+  
+
+#line 90 "./compiler/typecheck.ae"
+  switch (type->base) {
+    case BaseType__Pointer: {
+
+#line 91 "./compiler/typecheck.ae"
+      return TypeChecker__type_is_valid(this, type->ptr);
+    } break;
+    case BaseType__Function:
+    case BaseType__Method: {
+
+#line 93 "./compiler/typecheck.ae"
+      for (i32 i = 0; (i < type->params->size); i += 1) {
+
+#line 94 "./compiler/typecheck.ae"
+        Variable *var = ((Variable *)Vector__at(type->params, i));
+
+#line 95 "./compiler/typecheck.ae"
+        if ((!TypeChecker__type_is_valid(this, var->type))) {
+
+#line 96 "./compiler/typecheck.ae"
+          return false;
+        } 
+      } 
+
+#line 99 "./compiler/typecheck.ae"
+      return TypeChecker__type_is_valid(this, type->return_type);
+    } break;
+    case BaseType__Structure: {
+
+#line 102 "./compiler/typecheck.ae"
+      Structure *struc = ((Structure *)Map__get(this->structures, type->name));
+
+#line 103 "./compiler/typecheck.ae"
+      if (((bool)struc)) {
+
+#line 104 "./compiler/typecheck.ae"
+        type->struct_def = struc;
+
+#line 105 "./compiler/typecheck.ae"
+        return true;
+      } 
+
+#line 107 "./compiler/typecheck.ae"
+      return false;
+    } break;
+    case BaseType__Array: {
+
+#line 110 "./compiler/typecheck.ae"
+      Type *expr_type = TypeChecker__check_expression(this, type->size_expr, NULL);
+
+#line 111 "./compiler/typecheck.ae"
+      return (TypeChecker__type_is_valid(this, type->ptr) && TypeChecker__type_is_valid(this, expr_type));
+    } break;
+    default: {
+
+#line 113 "./compiler/typecheck.ae"
+      return true;
+    } break;
+  }
+}
+
+
+#line 117 "./compiler/typecheck.ae"
+static __attribute__((unused)) void TypeChecker__check_method_call(TypeChecker *this, Type *method_type, AST *node) {
+
+#line 118 "./compiler/typecheck.ae"
+  AST *callee = node->u.call.callee;
+
+#line 119 "./compiler/typecheck.ae"
+  if (((callee->type != ASTType__Member) && (callee->type != ASTType__ScopeLookup))) {
+
+#line 120 "./compiler/typecheck.ae"
+    TypeChecker__error(this, Error__new(callee->span, "Method call is not to a member, internal compiler error"));
+
+#line 121 "./compiler/typecheck.ae"
+    return;
+  } 
+
+#line 124 "./compiler/typecheck.ae"
+  Map *s_methods = ((Map *)Map__get(this->methods, method_type->name));
+
+#line 126 "./compiler/typecheck.ae"
+  AST *rhs = callee->u.member.rhs;
+
+#line 127 "./compiler/typecheck.ae"
+  Function *method = ((Function *)Map__get(s_methods, rhs->u.ident.name));
+
+#line 128 "./compiler/typecheck.ae"
+  node->u.call.func = method;
+
+#line 130 "./compiler/typecheck.ae"
+  if ((callee->type != ASTType__Member)) 
+
+#line 130 "./compiler/typecheck.ae"
+  return;
+  
+
+#line 135 "./compiler/typecheck.ae"
+  if (callee->u.member.is_method) 
+
+#line 135 "./compiler/typecheck.ae"
+  return;
+  
+
+#line 136 "./compiler/typecheck.ae"
+  callee->u.member.is_method = true;
+
+#line 138 "./compiler/typecheck.ae"
+  if (method->params->size == 0) {
+
+#line 140 "./compiler/typecheck.ae"
+    TypeChecker__error(this, Error__new(callee->span, "Instance method should have `this` argument, internal error"));
+
+#line 141 "./compiler/typecheck.ae"
+    return;
+  } 
+
+#line 143 "./compiler/typecheck.ae"
+  Type *method_param = ((Variable *)Vector__at(method->params, 0))->type;
+
+#line 145 "./compiler/typecheck.ae"
+  Member member = callee->u.member;
+
+#line 146 "./compiler/typecheck.ae"
+  AST *first_arg = member.lhs;
+
+#line 147 "./compiler/typecheck.ae"
+  if ((member.is_pointer && ((bool)method_param->name))) {
+
+#line 148 "./compiler/typecheck.ae"
+    first_arg = AST__new_unop(ASTType__Dereference, first_arg->span, first_arg);
+  }  else 
+#line 149 "./compiler/typecheck.ae"
+  if (((!member.is_pointer) && (!((bool)method_param->name)))) {
+
+#line 150 "./compiler/typecheck.ae"
+    first_arg = AST__new_unop(ASTType__Address, first_arg->span, first_arg);
+  } 
+  
+
+#line 152 "./compiler/typecheck.ae"
+  Vector__push_front(node->u.call.args, Argument__new(NULL, first_arg));
+}
+
+
+#line 155 "./compiler/typecheck.ae"
+static __attribute__((unused)) Type *TypeChecker__check_constructor(TypeChecker *this, Structure *struc, AST *node) {
+
+#line 156 "./compiler/typecheck.ae"
+  if ((struc->is_enum || struc->is_union)) {
+
+#line 157 "./compiler/typecheck.ae"
+    TypeChecker__error(this, Error__new(node->span, "Cannot use constructor for enum or union"));
+
+#line 158 "./compiler/typecheck.ae"
+    return NULL;
+  } 
+
+#line 161 "./compiler/typecheck.ae"
+  Vector *args = node->u.call.args;
+
+#line 162 "./compiler/typecheck.ae"
+  AST *callee = node->u.call.callee;
+
+#line 166 "./compiler/typecheck.ae"
+  node->type = ASTType__Constructor;
+
+#line 167 "./compiler/typecheck.ae"
+  node->u.constructor.struc = struc;
+
+#line 168 "./compiler/typecheck.ae"
+  node->u.constructor.args = args;
+
+#line 169 "./compiler/typecheck.ae"
+  node->u.constructor.callee = callee;
+
+#line 171 "./compiler/typecheck.ae"
+  Vector *fields = struc->fields;
+
+#line 172 "./compiler/typecheck.ae"
+  if ((fields->size != args->size)) {
+
+#line 173 "./compiler/typecheck.ae"
+    TypeChecker__error(this, Error__new_hint(node->span, "Constructor has wrong number of arguments", struc->span, format_string("Struct has %d fields, but got %d arguments", fields->size, args->size)));
+
+#line 177 "./compiler/typecheck.ae"
+    return struc->type;
+  } 
+
+#line 182 "./compiler/typecheck.ae"
+  for (i32 i = 0; (i < fields->size); i += 1) {
+
+#line 183 "./compiler/typecheck.ae"
+    Variable *field = ((Variable *)Vector__at(fields, i));
+
+#line 184 "./compiler/typecheck.ae"
+    Argument *arg = ((Argument *)Vector__at(args, i));
+
+#line 185 "./compiler/typecheck.ae"
+    Type *arg_type = TypeChecker__check_expression(this, arg->expr, field->type);
+
+#line 187 "./compiler/typecheck.ae"
+    if (((bool)arg->label)) {
+
+#line 188 "./compiler/typecheck.ae"
+      char *label = arg->label->u.ident.name;
+
+#line 189 "./compiler/typecheck.ae"
+      if ((!string__eq(label, field->name))) {
+
+#line 190 "./compiler/typecheck.ae"
+        TypeChecker__error(this, Error__new_hint(arg->label->span, "Label on parameter does not match struct field", field->span, format_string("Expected '%s', got '%s'", field->name, label)));
+      } 
+    } 
+
+#line 197 "./compiler/typecheck.ae"
+    if ((((bool)arg_type) && (!Type__eq(field->type, arg_type)))) {
+
+#line 198 "./compiler/typecheck.ae"
+      TypeChecker__error(this, Error__new_hint(arg->expr->span, "Argument type does not match struct field", field->span, format_string("Expected '%s', got '%s'", Type__str(field->type), Type__str(arg_type))));
+    } 
+  } 
+
+#line 206 "./compiler/typecheck.ae"
+  return struc->type;
+}
+
+
+#line 210 "./compiler/typecheck.ae"
+static __attribute__((unused)) Type *TypeChecker__check_simd_constructor(TypeChecker *this, Type *type, AST *node) {
+
+#line 211 "./compiler/typecheck.ae"
+  Vector *args = node->u.call.args;
+
+#line 212 "./compiler/typecheck.ae"
+  AST *callee = node->u.call.callee;
+
+#line 214 "./compiler/typecheck.ae"
+  node->type = ASTType__Constructor;
+
+#line 215 "./compiler/typecheck.ae"
+  node->u.constructor.struc = NULL;
+
+#line 216 "./compiler/typecheck.ae"
+  node->u.constructor.args = args;
+
+#line 217 "./compiler/typecheck.ae"
+  node->u.constructor.callee = callee;
+
+#line 219 "./compiler/typecheck.ae"
+  if (((args->size != type->lanes) && (args->size != 1))) {
+
+#line 220 "./compiler/typecheck.ae"
+    TypeChecker__error(this, Error__new_note(node->span, "Constructor has wrong number of arguments", format_string("Expected 1 or %d values for '%s', got %d", type->lanes, Type__str(type), args->size)));
+
+#line 224 "./compiler/typecheck.ae"
+    return type;
+  } 
+
+#line 226 "./compiler/typecheck.ae"
+  for (i32 i = 0; (i < args->size); i += 1) {
+
+#line 227 "./compiler/typecheck.ae"
+    Argument *arg = ((Argument *)Vector__at(args, i));
+
+#line 228 "./compiler/typecheck.ae"
+    Type *arg_type = TypeChecker__check_expression(this, arg->expr, type->ptr);
+
+#line 229 "./compiler/typecheck.ae"
+    if ((((bool)arg_type) && (!Type__eq(arg_type, type->ptr)))) {
+
+#line 230 "./compiler/typecheck.ae"
+      TypeChecker__error(this, Error__new_note(arg->expr->span, "Argument type does not match vector element type", format_string("Expected '%s', got '%s'", Type__str(type->ptr), Type__str(arg_type))));
+    } 
+  } 
+
+#line 236 "./compiler/typecheck.ae"
+  return type;
+}
+
+
+#line 241 "./compiler/typecheck.ae"
+static __attribute__((unused)) Type *TypeChecker__check_shuffle(TypeChecker *this, AST *node) {
+
+#line 242 "./compiler/typecheck.ae"
+  Vector *args = node->u.call.args;
+
+#line 243 "./compiler/typecheck.ae"
+  if (((args->size != 2) && (args->size != 3))) {
+
+#line 244 "./compiler/typecheck.ae"
+    TypeChecker__error(this, Error__new_note(node->span, "Incorrect arguments to shuffle", "Expected one or two vectors and a mask"));
+
+#line 248 "./compiler/typecheck.ae"
+    return NULL;
+  } 
+
+#line 251 "./compiler/typecheck.ae"
+  Argument *first = ((Argument *)Vector__at(args, 0));
+
+#line 252 "./compiler/typecheck.ae"
+  Type *type = TypeChecker__check_expression(this, first->expr, NULL);
+
+#line 253 "./compiler/typecheck.ae"
+  if ((!((bool)type))) 
+
+#line 253 "./compiler/typecheck.ae"
+  return NULL;
+  
+
+#line 254 "./compiler/typecheck.ae"
+  if ((!Type__is_simd(type))) {
+
+#line 255 "./compiler/typecheck.ae"
+    TypeChecker__error(this, Error__new_note(first->expr->span, "Expression must be a SIMD vector", format_string("Got type '%s'", Type__str(type))));
+
+#line 259 "./compiler/typecheck.ae"
+    return NULL;
+  } 
+
+#line 262 "./compiler/typecheck.ae"
+  if (args->size == 3) {
+
+#line 263 "./compiler/typecheck.ae"
+    Argument *second = ((Argument *)Vector__at(args, 1));
+
+#line 264 "./compiler/typecheck.ae"
+    Type *second_type = TypeChecker__check_expression(this, second->expr, type);
+
+#line 265 "./compiler/typecheck.ae"
+    if ((((bool)second_type) && (!Type__eq(second_type, type)))) {
+
+#line 266 "./compiler/typecheck.ae"
+      TypeChecker__error(this, Error__new_note(second->expr->span, "Vectors to shuffle must be of the same type", format_string("Expected '%s', got '%s'", Type__str(type), Type__str(second_type))));
+    } 
+  } 
+
+#line 273 "./compiler/typecheck.ae"
+  Argument *mask = ((Argument *)Vector__back(args));
+
+#line 274 "./compiler/typecheck.ae"
+  Type *mask_type = TypeChecker__check_expression(this, mask->expr, NULL);
+
+#line 275 "./compiler/typecheck.ae"
+  if ((!((bool)mask_type))) 
+
+#line 275 "./compiler/typecheck.ae"
+  return type;
+  
+
+#line 277 "./compiler/typecheck.ae"
+  bool valid_mask = (((Type__is_simd(mask_type) && Type__is_integer(mask_type->ptr)) && mask_type->lanes == type->lanes) && BaseType__scalar_size(mask_type->ptr->base) == BaseType__scalar_size(type->ptr->base));
+
+#line 281 "./compiler/typecheck.ae"
+  if ((!valid_mask)) {
+
+#line 282 "./compiler/typecheck.ae"
+    TypeChecker__error(this, Error__new_note(mask->expr->span, "Invalid shuffle mask", format_string("Expected %d integer lanes of the same size as '%s', got '%s'", type->lanes, Type__str(type->ptr), Type__str(mask_type))));
+  } 
+
+#line 287 "./compiler/typecheck.ae"
+  return type;
+}
+
+
+#line 292 "./compiler/typecheck.ae"
+static __attribute__((unused)) Type *TypeChecker__check_simd_arith(TypeChecker *this, AST *node, Type *lhs, Type *rhs) {
+
+#line 293 "./compiler/typecheck.ae"
+  Type *simd = (Type__is_simd(lhs) ? lhs : rhs);
+
+#line 294 "./compiler/typecheck.ae"
+  Type *other = (Type__is_simd(lhs) ? rhs : lhs);
+
+#line 295 "./compiler/typecheck.ae"
+  if (((!Type__eq(other, simd)) && (!Type__eq(other, simd->ptr)))) {
+
+#line 296 "./compiler/typecheck.ae"
+    TypeChecker__error(this, Error__new_note(node->span, "Operands must be the same vector type, or its element type", format_string("Got types '%s' and '%s'", Type__str(lhs), Type__str(rhs))));
+
+#line 300 "./compiler/typecheck.ae"
+    return NULL;
+  } 
+
+#line 303 "./compiler/typecheck.ae"
+  bool needs_integer = ({ bool __yield_0;
+
+#line 303 "./compiler/typecheck.ae"
+  switch (node->type) {
+    case ASTType__Modulus:
+    case ASTType__BitwiseOr:
+    case ASTType__BitwiseAnd:
+    case ASTType__BitwiseXor:
+    case ASTType__LeftShift:
+    case ASTType__RightShift: {
+      __yield_0 = true;
+} break;
+    default: {
+      __yield_0 = false;
+} break;
+  }
+;__yield_0; });
+
+#line 307 "./compiler/typecheck.ae"
+  if ((needs_integer && (!Type__is_integer(simd->ptr)))) {
+
+#line 308 "./compiler/typecheck.ae"
+    TypeChecker__error(this, Error__new_note(node->span, "Operator requires integer types", format_string("Got types '%s' and '%s'", Type__str(lhs), Type__str(rhs))));
+  } 
+
+#line 313 "./compiler/typecheck.ae"
+  return simd;
+}
+
+
+#line 318 "./compiler/typecheck.ae"
+static __attribute__((unused)) bool TypeChecker__simd_lane_to_index(TypeChecker *this, AST *node, Type *type) {
+
+#line 319 "./compiler/typecheck.ae"
+  AST *rhs = node->u.member.rhs;
+
+#line 320 "./compiler/typecheck.ae"
+  i32 lane = ({ i32 __yield_0;
+
+#line 320 "./compiler/typecheck.ae"
+  {
+    char *__match_str = rhs->u.ident.name;
+    switch (aecor_hash_str(__match_str, 2166136261u)) {
+      case 794621484u:
+        if (!strcmp(__match_str, "x")) goto __match_3_0;
+        break;
+      case 804166841u:
+        if (!strcmp(__match_str, "y")) goto __match_3_1;
+        break;
+      case 228143771u:
+        if (!strcmp(__match_str, "z")) goto __match_3_2;
+        break;
+      case 1701362178u:
+        if (!strcmp(__match_str, "w")) goto __match_3_3;
+        break;
+    }
+    goto __match_3_default;
+    __match_3_0: {
+      __yield_0 = 0;
+} goto __match_3_end;
+    __match_3_1: {
+      __yield_0 = 1;
+} goto __match_3_end;
+    __match_3_2: {
+      __yield_0 = 2;
+} goto __match_3_end;
+    __match_3_3: {
+      __yield_0 = 3;
+} goto __match_3_end;
+    __match_3_default: {
+      __yield_0 = (-1);
+}
+    __match_3_end:;
+  }
+;__yield_0; });
+
+#line 327 "./compiler/typecheck.ae"
+  if (((lane < 0) || (lane >= type->lanes))) {
+
+#line 328 "./compiler/typecheck.ae"
+    TypeChecker__error(this, Error__new_note(rhs->span, format_string("Type '%s' has no member with this name", Type__str(type)), "Use an index to access lanes"));
+
+#line 332 "./compiler/typecheck.ae"
+    return false;
+  } 
+
+#line 335 "./compiler/typecheck.ae"
+  AST *index = AST__new(ASTType__IntLiteral, rhs->span);
+
+#line 336 "./compiler/typecheck.ae"
+  index->u.num_literal.text = format_string("%d", lane);
+
+#line 339 "./compiler/typecheck.ae"
+  AST *lhs = node->u.member.lhs;
+
+#line 340 "./compiler/typecheck.ae"
+  node->type = ASTType__Index;
+
+#line 341 "./compiler/typecheck.ae"
+  node->u.binary.lhs = lhs;
+
+#line 342 "./compiler/typecheck.ae"
+  node->u.binary.rhs = index;
+
+#line 343 "./compiler/typecheck.ae"
+  return true;
+}
+
+
+#line 346 "./compiler/typecheck.ae"
+static __attribute__((unused)) void TypeChecker__call_dbg_on_enum_value(TypeChecker *this, AST *node) {
+
+#line 347 "./compiler/typecheck.ae"
+  if ((!((bool)node->etype))) 
+
+#line 347 "./compiler/typecheck.ae"
+  return;
+  
+
+#line 348 "./compiler/typecheck.ae"
+  if ((!Type__is_enum(node->etype))) 
+
+#line 348 "./compiler/typecheck.ae"
+  return;
+  
+
+#line 351 "./compiler/typecheck.ae"
+  AST *lhs = AST__alloc();
+
+#line 352 "./compiler/typecheck.ae"
+  (*lhs) = (*node);
+
+#line 354 "./compiler/typecheck.ae"
+  AST *rhs = AST__new(ASTType__Identifier, node->span);
+
+#line 355 "./compiler/typecheck.ae"
+  rhs->u.ident.name = "dbg";
+
+#line 357 "./compiler/typecheck.ae"
+  AST *method = AST__new(ASTType__Member, node->span);
+
+#line 358 "./compiler/typecheck.ae"
+  method->u.member.lhs = lhs;
+
+#line 359 "./compiler/typecheck.ae"
+  method->u.member.rhs = rhs;
+
+#line 361 "./compiler/typecheck.ae"
+  node->type = ASTType__Call;
+
+#line 362 "./compiler/typecheck.ae"
+  node->u.call.callee = method;
+
+#line 363 "./compiler/typecheck.ae"
+  node->u.call.args = Vector__new_sized(1);
+
+#line 365 "./compiler/typecheck.ae"
+  TypeChecker__check_expression(this, node, NULL);
+}
+
+
+#line 370 "./compiler/typecheck.ae"
+static __attribute__((unused)) Type *TypeChecker__check_debug_assert(TypeChecker *this, AST *node) {
+
+#line 371 "./compiler/typecheck.ae"
+  Vector *args = node->u.call.args;
+
+#line 372 "./compiler/typecheck.ae"
+  if ((args->size != 2)) {
+
+#line 373 "./compiler/typecheck.ae"
+    TypeChecker__error(this, Error__new_note(node->span, "Incorrect arguments to debug_assert", "Expected a condition and a message"));
+
+#line 377 "./compiler/typecheck.ae"
+    return Type__new(BaseType__Void, node->span);
+  } 
+
+#line 380 "./compiler/typecheck.ae"
+  Argument *cond = ((Argument *)Vector__at(args, 0));
+
+#line 381 "./compiler/typecheck.ae"
+  Type *cond_type = TypeChecker__check_expression(this, cond->expr, NULL);
+
+#line 382 "./compiler/typecheck.ae"
+  if ((((bool)cond_type) && (cond_type->base != BaseType__Bool))) {
+
+#line 383 "./compiler/typecheck.ae"
+    TypeChecker__error(this, Error__new_note(cond->expr->span, "Condition must be a boolean", format_string("Got type '%s'", Type__str(cond_type))));
+  } 
+
+#line 389 "./compiler/typecheck.ae"
+  Argument *msg = ((Argument *)Vector__at(args, 1));
+
+#line 390 "./compiler/typecheck.ae"
+  Type *msg_type = TypeChecker__check_expression(this, msg->expr, NULL);
+
+#line 391 "./compiler/typecheck.ae"
+  if ((((bool)msg_type) && (!Type__is_string(msg_type)))) {
+
+#line 392 "./compiler/typecheck.ae"
+    TypeChecker__error(this, Error__new_note(msg->expr->span, "Message must be a string", format_string("Got type '%s'", Type__str(msg_type))));
+  } 
+
+#line 397 "./compiler/typecheck.ae"
+  return Type__new(BaseType__Void, node->span);
+}
+
+
+#line 400 "./compiler/typecheck.ae"
+static __attribute__((unused)) Type *TypeChecker__check_call(TypeChecker *this, AST *node) {
+
+#line 402 "./compiler/typecheck.ae"
+  AST *callee = node->u.call.callee;
+
+#line 403 "./compiler/typecheck.ae"
+  if (callee->type == ASTType__Identifier) {
+
+#line 404 "./compiler/typecheck.ae"
+    callee->u.ident.func = NULL;
+
+#line 405 "./compiler/typecheck.ae"
+    char *name = callee->u.ident.name;
+
+#line 406 "./compiler/typecheck.ae"
+    if ((string__eq(name, "print") || string__eq(name, "println"))) {
+
+#line 407 "./compiler/typecheck.ae"
+      for (i32 i = 0; (i < node->u.call.args->size); i += 1) {
+
+#line 408 "./compiler/typecheck.ae"
+        Argument *arg = ((Argument *)Vector__at(node->u.call.args, i));
+
+#line 409 "./compiler/typecheck.ae"
+        TypeChecker__check_expression(this, arg->expr, NULL);
+
+#line 410 "./compiler/typecheck.ae"
+        TypeChecker__call_dbg_on_enum_value(this, arg->expr);
+      } 
+
+#line 412 "./compiler/typecheck.ae"
+      return Type__new(BaseType__Void, node->span);
+    } 
+
+#line 414 "./compiler/typecheck.ae"
+    if (string__eq(name, "debug_assert")) {
+
+#line 415 "./compiler/typecheck.ae"
+      return TypeChecker__check_debug_assert(this, node);
+    } 
+
+#line 417 "./compiler/typecheck.ae"
+    if ((string__eq(name, "shuffle") && (!Map__exists(this->functions, name)))) {
+
+#line 418 "./compiler/typecheck.ae"
+      return TypeChecker__check_shuffle(this, node);
+    } 
+
+#line 422 "./compiler/typecheck.ae"
+    Structure *struc = ((Structure *)Map__get(this->structures, name));
+
+#line 423 "./compiler/typecheck.ae"
+    if (((bool)struc)) {
+
+#line 424 "./compiler/typecheck.ae"
+      return TypeChecker__check_constructor(this, struc, node);
+    } 
+
+#line 426 "./compiler/typecheck.ae"
+    Type *simd = Type__simd_from_name(name, callee->span);
+
+#line 427 "./compiler/typecheck.ae"
+    if (((bool)simd)) {
+
+#line 428 "./compiler/typecheck.ae"
+      return TypeChecker__check_simd_constructor(this, simd, node);
+    } 
+  } 
+
+#line 432 "./compiler/typecheck.ae"
+  this->callee = callee;
+
+#line 433 "./compiler/typecheck.ae"
+  Type *func_type = TypeChecker__check_expression(this, callee, NULL);
+
+#line 434 "./compiler/typecheck.ae"
+  if ((!((bool)func_type))) 
+
+#line 434 "./compiler/typecheck.ae"
+  return NULL;
+  
+
+#line 436 "./compiler/typecheck.ae"
+  Function *func_def = func_type->func_def;
+
+#line 437 "./compiler/typecheck.ae"
+  node->u.call.func = func_def;
+
+#line 439 "./compiler/typecheck.ae"
+  if ((((bool)func_def) && func_def->exits)) {
+
+#line 440 "./compiler/typecheck.ae"
+    node->returns = true;
+  } 
+
+#line 443 "./compiler/typecheck.ae"
+  if (((func_type->base != BaseType__Function) && (func_type->base != BaseType__Method))) {
+
+#line 444 "./compiler/typecheck.ae"
+    TypeChecker__error(this, Error__new_note(callee->span, "Cannot call a non-function type", format_string("Type for expression is '%s'", Type__str(func_type))));
+
+#line 448 "./compiler/typecheck.ae"
+    return NULL;
+  } 
+
+#line 451 "./compiler/typecheck.ae"
+  if (func_type->base == BaseType__Method) {
+
+#line 452 "./compiler/typecheck.ae"
+    TypeChecker__check_method_call(this, func_type, node);
+  } 
+
+#line 455 "./compiler/typecheck.ae"
+  Vector *params = func_type->params;
+
+#line 456 "./compiler/typecheck.ae"
+  if ((params->size != node->u.call.args->size)) {
+
+#line 457 "./compiler/typecheck.ae"
+    TypeChecker__error(this, Error__new_hint(node->span, "Number of arguments does not match function signature", func_type->span, format_string("This function expects %d arguments, got %d", params->size, node->u.call.args->size)));
+
+#line 461 "./compiler/typecheck.ae"
+    return func_type->return_type;
+  } 
+
+#line 464 "./compiler/typecheck.ae"
+  for (i32 i = 0; (i < params->size); i += 1) {
+
+#line 465 "./compiler/typecheck.ae"
+    Variable *param = ((Variable *)Vector__at(params, i));
+
+#line 466 "./compiler/typecheck.ae"
+    Argument *arg = ((Argument *)Vector__at(node->u.call.args, i));
+
+#line 467 "./compiler/typecheck.ae"
+    Type *arg_type = TypeChecker__check_expression(this, arg->expr, param->type);
+
+#line 468 "./compiler/typecheck.ae"
+    if ((((bool)arg_type) && (!Type__eq(param->type, arg_type)))) {
+
+#line 469 "./compiler/typecheck.ae"
+      TypeChecker__error(this, Error__new_hint(arg->expr->span, "Argument type does not match function parameter type", param->span, format_string("Expected '%s', got '%s'", Type__str(param->type), Type__str(arg_type))));
+    } 
+
+#line 475 "./compiler/typecheck.ae"
+    if ((!((bool)arg->label))) 
+
+#line 475 "./compiler/typecheck.ae"
+    continue;
+    
+
+#line 476 "./compiler/typecheck.ae"
+    if (string__eq(param->name, "")) {
+
+#line 477 "./compiler/typecheck.ae"
+      TypeChecker__error(this, Error__new_hint(arg->label->span, "Label on non-labeled parameter", param->span, "This parameter does not have a name"));
+    } 
+
+#line 482 "./compiler/typecheck.ae"
+    char *label = arg->label->u.ident.name;
+
+#line 483 "./compiler/typecheck.ae"
+    if ((!string__eq(label, param->name))) {
+
+#line 484 "./compiler/typecheck.ae"
+      TypeChecker__error(this, Error__new_hint(arg->label->span, "Label on parameter does not match parameter name", param->span, format_string("Expected '%s', got '%s'", param->name, label)));
+    } 
+  } 
+
+#line 491 "./compiler/typecheck.ae"
+  return func_type->return_type;
+}
+
+
+#line 494 "./compiler/typecheck.ae"
+static __attribute__((unused)) Type *TypeChecker__check_format_string(TypeChecker *this, AST *node) {
+
+#line 495 "./compiler/typecheck.ae"
+  Vector *parts = node->u.fmt_str.parts;
+
+#line 496 "./compiler/typecheck.ae"
+  Vector *exprs = node->u.fmt_str.exprs;
+
+#line 498 "./compiler/typecheck.ae"
+  if ((parts->size != (exprs->size + 1))) {
+
+#line 499 "./compiler/typecheck.ae"
+    TypeChecker__error(this, Error__new(node->span, "Number of format string parts does not match number of expressions"));
+  } 
+
+#line 502 "./compiler/typecheck.ae"
+  for (i32 i = 0; (i < exprs->size); i += 1) {
+
+#line 503 "./compiler/typecheck.ae"
+    AST *expr = ((AST *)Vector__at(exprs, i));
+
+#line 504 "./compiler/typecheck.ae"
+    TypeChecker__check_expression(this, expr, NULL);
+
+#line 505 "./compiler/typecheck.ae"
+    TypeChecker__call_dbg_on_enum_value(this, expr);
+  } 
+
+#line 508 "./compiler/typecheck.ae"
+  return Type__ptr_to(BaseType__Char, node->span);
+}
+
+
+#line 511 "./compiler/typecheck.ae"
+static __attribute__((unused)) Type *TypeChecker__check_pointer_arith(TypeChecker *this, AST *node, Type *lhs, Type *rhs) {
+
+#line 512 "./compiler/typecheck.ae"
+  if ((node->type == ASTType__Plus || node->type == ASTType__Minus)) {
+
+#line 513 "./compiler/typecheck.ae"
+    if ((lhs->base == BaseType__Pointer && Type__is_integer(rhs))) {
+
+#line 514 "./compiler/typecheck.ae"
+      return lhs;
+    } 
+
+#line 516 "./compiler/typecheck.ae"
+    if ((Type__is_integer(lhs) && rhs->base == BaseType__Pointer)) {
+
+#line 517 "./compiler/typecheck.ae"
+      return rhs;
+    } 
+
+#line 519 "./compiler/typecheck.ae"
+    if ((Type__eq(lhs, rhs) && lhs->base == BaseType__Pointer)) {
+
+#line 520 "./compiler/typecheck.ae"
+      if (node->type == ASTType__Minus) {
+
+#line 521 "./compiler/typecheck.ae"
+        return Type__new(BaseType__I32, node->span);
+      } 
+    } 
+  } 
+
+#line 525 "./compiler/typecheck.ae"
+  TypeChecker__error(this, Error__new(node->span, "Invalid pointer arithmetic"));
+
+#line 526 "./compiler/typecheck.ae"
+  return NULL;
+}
+
+
+#line 529 "./compiler/typecheck.ae"
+static __attribute__((unused)) Type *TypeChecker__check_binary_op(TypeChecker *this, AST *node, AST *_lhs, AST *_rhs) {
+
+#line 530 "./compiler/typecheck.ae"
+  if (((!((bool)_lhs->etype)) || (!((bool)_rhs->etype)))) {
+
+#line 531 "./compiler/typecheck.ae"
+    panic("Expressions not checked in check_binary_op");
+  } 
+
+#line 533 "./compiler/typecheck.ae"
+  Type *lhs = _lhs->etype;
+
+#line 534 "./compiler/typecheck.ae"
+  Type *rhs = _rhs->etype;
+
+#line 535 "./compiler/typecheck.ae"
+  switch (node->type) {
+    case ASTType__Plus:
+    case ASTType__Minus:
+    case ASTType__Multiply:
+    case ASTType__Divide: {
+
+#line 537 "./compiler/typecheck.ae"
+      if ((Type__is_simd(lhs) || Type__is_simd(rhs))) {
+
+#line 538 "./compiler/typecheck.ae"
+        return TypeChecker__check_simd_arith(this, node, lhs, rhs);
+      }  else 
+#line 539 "./compiler/typecheck.ae"
+      if ((lhs->base == BaseType__Pointer || rhs->base == BaseType__Pointer)) {
+
+#line 540 "./compiler/typecheck.ae"
+        return TypeChecker__check_pointer_arith(this, node, lhs, rhs);
+      }  else 
+#line 541 "./compiler/typecheck.ae"
+      if (((!Type__is_numeric(lhs)) || (!Type__is_numeric(rhs)))) {
+
+#line 542 "./compiler/typecheck.ae"
+        TypeChecker__error(this, Error__new_note(node->span, "Operator requires numeric types", format_string("Got types '%s' and '%s'", Type__str(lhs), Type__str(rhs))));
+
+#line 546 "./compiler/typecheck.ae"
+        return NULL;
+      }  else 
+#line 547 "./compiler/typecheck.ae"
+      if ((!Type__eq(lhs, rhs))) {
+
+#line 548 "./compiler/typecheck.ae"
+        TypeChecker__error(this, Error__new_note(node->span, "Operands must be of the same type", format_string("Got types '%s' and '%s'", Type__str(lhs), Type__str(rhs))));
+
+#line 552 "./compiler/typecheck.ae"
+        return NULL;
+      }  else {
+
+#line 554 "./compiler/typecheck.ae"
+        return lhs;
+      } 
+      
+      
+      
+    } break;
+    case ASTType__LessThan:
+    case ASTType__LessThanEquals:
+    case ASTType__GreaterThan:
+    case ASTType__GreaterThanEquals: {
+
+#line 558 "./compiler/typecheck.ae"
+      if (((!Type__is_numeric_or_char(lhs)) || (!Type__is_numeric_or_char(rhs)))) {
+
+#line 559 "./compiler/typecheck.ae"
+        TypeChecker__error(this, Error__new_note(node->span, "Operator requires numeric or char types", format_string("Got types '%s' and '%s'", Type__str(lhs), Type__str(rhs))));
+      } 
+
+#line 564 "./compiler/typecheck.ae"
+      if ((!Type__eq(lhs, rhs))) {
+
+#line 565 "./compiler/typecheck.ae"
+        TypeChecker__error(this, Error__new_note(node->span, "Operands must be of the same type", format_string("Got types '%s' and '%s'", Type__str(lhs), Type__str(rhs))));
+      } 
+
+#line 570 "./compiler/typecheck.ae"
+      return Type__new(BaseType__Bool, node->span);
+    } break;
+    case ASTType__Equals:
+    case ASTType__NotEquals: {
+
+#line 573 "./compiler/typecheck.ae"
+      if ((!Type__eq(lhs, rhs))) {
+
+#line 574 "./compiler/typecheck.ae"
+        TypeChecker__error(this, Error__new_note(node->span, "Operands must be of the same type", format_string("Got types '%s' and '%s'", Type__str(lhs), Type__str(rhs))));
+      } 
+
+#line 579 "./compiler/typecheck.ae"
+      if (lhs->base == BaseType__Structure) {
+
+#line 580 "./compiler/typecheck.ae"
+        Structure *struc = ((Structure *)Map__get(this->structures, lhs->name));
+
+#line 581 "./compiler/typecheck.ae"
+        if ((!struc->is_enum)) {
+
+#line 582 "./compiler/typecheck.ae"
+          TypeChecker__error(this, Error__new(node->span, "Cannot compare structs directly"));
+        } 
+      } 
+
+#line 585 "./compiler/typecheck.ae"
+      if (Type__is_simd(lhs)) {
+
+#line 586 "./compiler/typecheck.ae"
+        TypeChecker__error(this, Error__new(node->span, "Cannot compare vectors directly"));
+      } 
+
+#line 588 "./compiler/typecheck.ae"
+      return Type__new(BaseType__Bool, node->span);
+    } break;
+    case ASTType__And:
+    case ASTType__Or: {
+
+#line 591 "./compiler/typecheck.ae"
+      if (((!Type__eq(lhs, rhs)) || (lhs->base != BaseType__Bool))) {
+
+#line 592 "./compiler/typecheck.ae"
+        TypeChecker__error(this, Error__new_note(node->span, "Operands must be boolean", format_string("Got types '%s' and '%s'", Type__str(lhs), Type__str(rhs))));
+      } 
+
+#line 597 "./compiler/typecheck.ae"
+      return Type__new(BaseType__Bool, node->span);
+    } break;
+    case ASTType__Modulus:
+    case ASTType__BitwiseOr:
+    case ASTType__BitwiseAnd:
+    case ASTType__BitwiseXor:
+    case ASTType__LeftShift:
+    case ASTType__RightShift: {
+
+#line 600 "./compiler/typecheck.ae"
+      if ((Type__is_simd(lhs) || Type__is_simd(rhs))) {
+
+#line 601 "./compiler/typecheck.ae"
+        return TypeChecker__check_simd_arith(this, node, lhs, rhs);
+      } 
+
+#line 603 "./compiler/typecheck.ae"
+      if (((!Type__is_integer(lhs)) || (!Type__is_integer(rhs)))) {
+
+#line 604 "./compiler/typecheck.ae"
+        TypeChecker__error(this, Error__new_note(node->span, "Operator requires integer types", format_string("Got types '%s' and '%s'", Type__str(lhs), Type__str(rhs))));
+      } 
+
+#line 609 "./compiler/typecheck.ae"
+      if ((!Type__eq(lhs, rhs))) {
+
+#line 610 "./compiler/typecheck.ae"
+        TypeChecker__error(this, Error__new_note(node->span, "Operands must be of the same type", format_string("Got types '%s' and '%s'", Type__str(lhs), Type__str(rhs))));
+      } 
+
+#line 615 "./compiler/typecheck.ae"
+      return lhs;
+    } break;
+    default: panic(format_string("Internal error: unhandled op in check_binary_op: %s", ASTType__dbg(node->type))); break;
+  }
+}
+
+
+#line 621 "./compiler/typecheck.ae"
+static __attribute__((unused)) void TypeChecker__error_unknown_identifier(TypeChecker *this, Span span, char *name) {
+
+#line 622 "./compiler/typecheck.ae"
+  Vector *options = Vector__new();
+
+#line 623 "./compiler/typecheck.ae"
+  for (i32 i = 0; (i < this->scopes->size); i += 1) {
+
+#line 624 "./compiler/typecheck.ae"
+    Map *scope = ((Map *)Vector__at(this->scopes, i));
+
+#line 625 "./compiler/typecheck.ae"
+    Map__push_keys(scope, options);
+  } 
+
+#line 627 "./compiler/typecheck.ae"
+  for (MapIterator iter = Map__iter(this->functions); ((bool)iter.cur); MapIterator__next((&iter))) {
+
+#line 628 "./compiler/typecheck.ae"
+    Function *func = ((Function *)MapIterator__value((&iter)));
+
+#line 629 "./compiler/typecheck.ae"
+    if ((!func->is_method)) {
+
+#line 630 "./compiler/typecheck.ae"
+      Vector__push(options, MapIterator__key((&iter)));
+    } 
+  } 
+
+#line 634 "./compiler/typecheck.ae"
+  char *suggestion = find_word_suggestion(name, options);
+
+#line 635 "./compiler/typecheck.ae"
+  if (((bool)suggestion)) {
+
+#line 636 "./compiler/typecheck.ae"
+    TypeChecker__error(this, Error__new_note(span, "Unknown Identifier", format_string("Possible alternative: \x1b[32m%s\x1b[0m", suggestion)));
+  }  else {
+
+#line 641 "./compiler/typecheck.ae"
+    TypeChecker__error(this, Error__new(span, "Unknown Identifier"));
+  } 
+}
+
+
+#line 645 "./compiler/typecheck.ae"
+static __attribute__((unused)) void TypeChecker__error_unknown_member(TypeChecker *this, AST *node, Type *struct_type, char *field_name, bool is_static) {
+
+#line 646 "./compiler/typecheck.ae"
+  char *suggestion = ((char *)NULL);
+
+#line 648 "./compiler/typecheck.ae"
+  if (((bool)struct_type->struct_def)) {
+
+#line 649 "./compiler/typecheck.ae"
+    Vector *options = Vector__new();
+
+#line 651 "./compiler/typecheck.ae"
+    if (struct_type->struct_def->is_enum == is_static) {
+
+#line 652 "./compiler/typecheck.ae"
+      Vector *fields = struct_type->struct_def->fields;
+
+#line 653 "./compiler/typecheck.ae"
+      for (i32 i = 0; (i < fields->size); i += 1) {
+
+#line 654 "./compiler/typecheck.ae"
+        Variable *field = ((Variable *)Vector__at(fields, i));
+
+#line 655 "./compiler/typecheck.ae"
+        Vector__push(options, field->name);
+      } 
+    } 
+
+#line 659 "./compiler/typecheck.ae"
+    Map *s_methods = ((Map *)Map__get(this->methods, struct_type->name));
+
+#line 660 "./compiler/typecheck.ae"
+    if (((bool)s_methods)) {
+
+#line 661 "./compiler/typecheck.ae"
+      for (MapIterator iter = Map__iter(s_methods); ((bool)iter.cur); MapIterator__next((&iter))) {
+
+#line 662 "./compiler/typecheck.ae"
+        Function *method = ((Function *)MapIterator__value((&iter)));
+
+#line 663 "./compiler/typecheck.ae"
+        if (method->is_static == is_static) {
+
+#line 664 "./compiler/typecheck.ae"
+          Vector__push(options, method->name);
+        } 
+      } 
+    } 
+
+#line 668 "./compiler/typecheck.ae"
+    suggestion = find_word_suggestion(field_name, options);
+  } 
+
+#line 671 "./compiler/typecheck.ae"
+  if (((bool)suggestion)) {
+
+#line 672 "./compiler/typecheck.ae"
+    TypeChecker__error(this, Error__new_note(node->u.member.rhs->span, format_string("Type '%s' has no member with this name", Type__str(struct_type)), format_string("Possible alternative: \x1b[32m%s\x1b[0m", suggestion)));
+  }  else {
+
+#line 677 "./compiler/typecheck.ae"
+    TypeChecker__error(this, Error__new(node->u.member.rhs->span, format_string("Type '%s' has no member with this name", Type__str(struct_type))));
+  } 
+}
+
+
+#line 683 "./compiler/typecheck.ae"
+static __attribute__((unused)) bool TypeChecker__try_infer_enum(TypeChecker *this, AST *node, Type *type) {
+
+#line 684 "./compiler/typecheck.ae"
+  if ((node->type != ASTType__Identifier)) 
+
+#line 684 "./compiler/typecheck.ae"
+  return false;
+  
+
+#line 685 "./compiler/typecheck.ae"
+  char *name = node->u.ident.name;
+
+#line 687 "./compiler/typecheck.ae"
+  if ((!((bool)type))) 
+
+#line 687 "./compiler/typecheck.ae"
+  return false;
+  
+
+#line 688 "./compiler/typecheck.ae"
+  if ((!Type__is_enum(type))) 
+
+#line 688 "./compiler/typecheck.ae"
+  return false;
+  
+
+#line 689 "./compiler/typecheck.ae"
+  Structure *struc = type->struct_def;
+
+#line 690 "./compiler/typecheck.ae"
+  if ((!((bool)struc))) 
+
+#line 690 "./compiler/typecheck.ae"
+  return false;
+  
+
+#line 692 "./compiler/typecheck.ae"
+  Variable *var = Structure__find_field(struc, name);
+
+#line 693 "./compiler/typecheck.ae"
+  if ((!((bool)var))) 
+
+#line 693 "./compiler/typecheck.ae"
+  return false;
+  
+
+#line 696 "./compiler/typecheck.ae"
+  AST *rhs = AST__new(ASTType__Identifier, node->span);
+
+#line 697 "./compiler/typecheck.ae"
+  (*rhs) = (*node);
+
+#line 700 "./compiler/typecheck.ae"
+  node->type = ASTType__EnumValue;
+
+#line 701 "./compiler/typecheck.ae"
+  node->u.enum_val = ((EnumValue *)calloc(1, sizeof(EnumValue)));
+
+#line 702 "./compiler/typecheck.ae"
+  node->u.enum_val->struct_def = struc;
+
+#line 703 "./compiler/typecheck.ae"
+  node->u.enum_val->var = var;
+
+#line 704 "./compiler/typecheck.ae"
+  node->u.enum_val->lhs = NULL;
+
+#line 705 "./compiler/typecheck.ae"
+  node->u.enum_val->rhs = rhs;
+
+#line 706 "./compiler/typecheck.ae"
+  node->etype = struc->type;
+
+#line 707 "./compiler/typecheck.ae"
+  return true;
+}
+
+
+#line 710 "./compiler/typecheck.ae"
+static __attribute__((unused)) Type *TypeChecker__check_expression(TypeChecker *this, AST *node, Type *hint) {
+
+#line 711 "./compiler/typecheck.ae"
+  Type *etype = ((Type *)NULL);
+
+#line 712 "./compiler/typecheck.ae"
+  switch (node->type) {
+    case ASTType__Call: {
+
+#line 713 "./compiler/typecheck.ae"
+      etype = TypeChecker__check_call(this, node);
+    } break;
+    case ASTType__BoolLiteral: {
+
+#line 714 "./compiler/typecheck.ae"
+      etype = Type__new(BaseType__Bool, node->span);
+    } break;
+    case ASTType__CharLiteral: {
+
+#line 715 "./compiler/typecheck.ae"
+      etype = Type__new(BaseType__Char, node->span);
+    } break;
+    case ASTType__StringLiteral: {
+
+#line 716 "./compiler/typecheck.ae"
+      etype = Type__ptr_to(BaseType__Char, node->span);
+    } break;
+    case ASTType__Null: {
+
+#line 717 "./compiler/typecheck.ae"
+      etype = Type__ptr_to(BaseType__Void, node->span);
+    } break;
+    case ASTType__FormatStringLiteral: {
+
+#line 718 "./compiler/typecheck.ae"
+      etype = TypeChecker__check_format_string(this, node);
+    } break;
+    case ASTType__IntLiteral:
+    case ASTType__FloatLiteral: {
+
+#line 723 "./compiler/typecheck.ae"
+      NumLiteral *num_lit = (&node->u.num_literal);
+
+#line 724 "./compiler/typecheck.ae"
+      if ((((bool)hint) && Type__is_simd(hint))) {
+
+#line 725 "./compiler/typecheck.ae"
+        hint = hint->ptr;
+      } 
+
+#line 727 "./compiler/typecheck.ae"
+      if (((bool)num_lit->suffix)) {
+
+#line 728 "./compiler/typecheck.ae"
+        etype = num_lit->suffix;
+
+#line 729 "./compiler/typecheck.ae"
+        if ((!TypeChecker__type_is_valid(this, etype))) {
+
+#line 730 "./compiler/typecheck.ae"
+          TypeChecker__error(this, Error__new(etype->span, "Invalid type"));
+        } 
+      }  else 
+#line 732 "./compiler/typecheck.ae"
+      if (node->type == ASTType__IntLiteral) {
+
+#line 733 "./compiler/typecheck.ae"
+        etype = ({ Type *__yield_0;
+
+#line 733 "./compiler/typecheck.ae"
+  if ((((bool)hint) && Type__is_integer(hint))) {
+
+#line 734 "./compiler/typecheck.ae"
+    __yield_0 = hint;
+  }  else {
+
+#line 736 "./compiler/typecheck.ae"
+    __yield_0 = Type__new(BaseType__I32, node->span);
+  } 
+;__yield_0; });
+      }  else {
+
+#line 739 "./compiler/typecheck.ae"
+        etype = ({ Type *__yield_0;
+
+#line 739 "./compiler/typecheck.ae"
+  if ((((bool)hint) && Type__is_float(hint))) {
+
+#line 740 "./compiler/typecheck.ae"
+    __yield_0 = hint;
+  }  else {
+
+#line 742 "./compiler/typecheck.ae"
+    __yield_0 = Type__new(BaseType__F32, node->span);
+  } 
+;__yield_0; });
+      } 
+      
+    } break;
+    case ASTType__Error: {
+
+#line 747 "./compiler/typecheck.ae"
+      return NULL;
+    } break;
+    case ASTType__Constructor: {
+
+#line 750 "./compiler/typecheck.ae"
+      etype = node->etype;
+    } break;
+    case ASTType__SizeOf: {
+
+#line 753 "./compiler/typecheck.ae"
+      if ((!TypeChecker__type_is_valid(this, node->u.size_of_type))) {
+
+#line 754 "./compiler/typecheck.ae"
+        TypeChecker__error(this, Error__new(node->u.size_of_type->span, "Invalid type"));
+      } 
+
+#line 756 "./compiler/typecheck.ae"
+      etype = ({ Type *__yield_0;
+
+#line 756 "./compiler/typecheck.ae"
+  if ((((bool)hint) && Type__is_integer(hint))) {
+
+#line 757 "./compiler/typecheck.ae"
+    __yield_0 = hint;
+  }  else {
+
+#line 759 "./compiler/typecheck.ae"
+    __yield_0 = Type__new(BaseType__I32, node->span);
+  } 
+;__yield_0; });
+    } break;
+    case ASTType__Identifier: {
+
+#line 763 "./compiler/typecheck.ae"
+      Identifier *ident = (&node->u.ident);
+
+#line 764 "./compiler/typecheck.ae"
+      Variable *var = TypeChecker__find_var(this, ident->name);
+
+#line 765 "./compiler/typecheck.ae"
+      Function *func = ((Function *)Map__get(this->functions, ident->name));
+
+#line 767 "./compiler/typecheck.ae"
+      if ((((bool)hint) && TypeChecker__try_infer_enum(this, node, hint))) {
+
+#line 768 "./compiler/typecheck.ae"
+        etype = node->etype;
+      }  else 
+#line 769 "./compiler/typecheck.ae"
+      if (((bool)ident->func)) {
+
+#line 770 "./compiler/typecheck.ae"
+        etype = ident->func->type;
+      }  else 
+#line 771 "./compiler/typecheck.ae"
+      if (((bool)var)) {
+
+#line 772 "./compiler/typecheck.ae"
+        ident->var = var;
+
+#line 773 "./compiler/typecheck.ae"
+        etype = var->type;
+      }  else 
+#line 774 "./compiler/typecheck.ae"
+      if (((bool)func)) {
+
+#line 775 "./compiler/typecheck.ae"
+        ident->func = func;
+
+#line 776 "./compiler/typecheck.ae"
+        etype = func->type;
+
+#line 777 "./compiler/typecheck.ae"
+        if ((node != this->callee)) 
+
+#line 777 "./compiler/typecheck.ae"
+        func->is_address_taken = true;
+        
+      }  else {
+
+#line 779 "./compiler/typecheck.ae"
+        TypeChecker__error_unknown_identifier(this, node->span, ident->name);
+
+#line 780 "./compiler/typecheck.ae"
+        return NULL;
+      } 
+      
+      
+      
+    } break;
+    case ASTType__Plus:
+    case ASTType__Minus:
+    case ASTType__Multiply:
+    case ASTType__Divide:
+    case ASTType__LessThan:
+    case ASTType__LessThanEquals:
+    case ASTType__GreaterThan:
+    case ASTType__GreaterThanEquals:
+    case ASTType__Equals:
+    case ASTType__NotEquals:
+    case ASTType__And:
+    case ASTType__Or:
+    case ASTType__Modulus:
+    case ASTType__BitwiseOr:
+    case ASTType__BitwiseAnd:
+    case ASTType__BitwiseXor:
+    case ASTType__LeftShift:
+    case ASTType__RightShift: {
+
+#line 801 "./compiler/typecheck.ae"
+      Type *lhs_type = TypeChecker__check_expression(this, node->u.binary.lhs, hint);
+
+#line 802 "./compiler/typecheck.ae"
+      Type *rhs_type = TypeChecker__check_expression(this, node->u.binary.rhs, lhs_type);
+
+#line 803 "./compiler/typecheck.ae"
+      if (((!((bool)lhs_type)) || (!((bool)rhs_type)))) 
+
+#line 803 "./compiler/typecheck.ae"
+      return NULL;
+      
+
+#line 804 "./compiler/typecheck.ae"
+      etype = TypeChecker__check_binary_op(this, node, node->u.binary.lhs, node->u.binary.rhs);
+    } break;
+    case ASTType__Not: {
+
+#line 807 "./compiler/typecheck.ae"
+      Type *rhs = TypeChecker__check_expression(this, node->u.unary, NULL);
+
+#line 808 "./compiler/typecheck.ae"
+      if ((((bool)rhs) && (rhs->base != BaseType__Bool))) {
+
+#line 809 "./compiler/typecheck.ae"
+        TypeChecker__error(this, Error__new_note(node->u.unary->span, "Expression must be boolean", format_string("Got type '%s'", Type__str(rhs))));
+      } 
+
+#line 814 "./compiler/typecheck.ae"
+      etype = Type__new(BaseType__Bool, node->span);
+    } break;
+    case ASTType__BitwiseNot: {
+
+#line 817 "./compiler/typecheck.ae"
+      etype = TypeChecker__check_expression(this, node->u.unary, hint);
+
+#line 818 "./compiler/typecheck.ae"
+      bool is_integer = (((bool)etype) && (Type__is_integer(etype) || (Type__is_simd(etype) && Type__is_integer(etype->ptr))));
+
+#line 820 "./compiler/typecheck.ae"
+      if ((((bool)etype) && (!is_integer))) {
+
+#line 821 "./compiler/typecheck.ae"
+        TypeChecker__error(this, Error__new_note(node->u.unary->span, "Expression must be an integer", format_string("Got type '%s'", Type__str(etype))));
+      } 
+    } break;
+    case ASTType__UnaryMinus: {
+
+#line 828 "./compiler/typecheck.ae"
+      etype = TypeChecker__check_expression(this, node->u.unary, hint);
+
+#line 829 "./compiler/typecheck.ae"
+      if ((!((bool)etype))) 
+
+#line 829 "./compiler/typecheck.ae"
+      return NULL;
+      
+
+#line 831 "./compiler/typecheck.ae"
+      if (((!Type__is_numeric(etype)) && (!Type__is_simd(etype)))) {
+
+#line 832 "./compiler/typecheck.ae"
+        TypeChecker__error(this, Error__new_note(node->u.unary->span, "Expression must be a number", format_string("Got type '%s'", Type__str(etype))));
+      } 
+    } break;
+    case ASTType__Address: {
+
+#line 839 "./compiler/typecheck.ae"
+      etype = TypeChecker__check_expression(this, node->u.unary, NULL);
+
+#line 840 "./compiler/typecheck.ae"
+      if ((!((bool)etype))) 
+
+#line 840 "./compiler/typecheck.ae"
+      return NULL;
+      
+
+#line 841 "./compiler/typecheck.ae"
+      etype = Type__new_link(BaseType__Pointer, etype, node->span);
+    } break;
+    case ASTType__Dereference: {
+
+#line 844 "./compiler/typecheck.ae"
+      Type *expr_type = TypeChecker__check_expression(this, node->u.unary, NULL);
+
+#line 845 "./compiler/typecheck.ae"
+      if ((!((bool)expr_type))) 
+
+#line 845 "./compiler/typecheck.ae"
+      return NULL;
+      
+
+#line 847 "./compiler/typecheck.ae"
+      if ((expr_type->base != BaseType__Pointer)) {
+
+#line 848 "./compiler/typecheck.ae"
+        TypeChecker__error(this, Error__new_note(node->u.unary->span, "Expression must be a pointer-type", format_string("Got type '%s'", Type__str(expr_type))));
+      } 
+
+#line 853 "./compiler/typecheck.ae"
+      etype = expr_type->ptr;
+    } break;
+    case ASTType__Index: {
+
+#line 856 "./compiler/typecheck.ae"
+      Type *expr_type = TypeChecker__check_expression(this, node->u.binary.lhs, NULL);
+
+#line 857 "./compiler/typecheck.ae"
+      if ((!((bool)expr_type))) 
+
+#line 857 "./compiler/typecheck.ae"
+      return NULL;
+      
+
+#line 860 "./compiler/typecheck.ae"
+      if (((expr_type->base != BaseType__Pointer) && (!Type__is_simd(expr_type)))) {
+
+#line 861 "./compiler/typecheck.ae"
+        TypeChecker__error(this, Error__new_note(node->u.binary.lhs->span, "Expression must be a pointer-type", format_string("Got type '%s'", Type__str(expr_type))));
+      } 
+
+#line 866 "./compiler/typecheck.ae"
+      Type *index_type = TypeChecker__check_expression(this, node->u.binary.rhs, NULL);
+
+#line 867 "./compiler/typecheck.ae"
+      if ((((bool)index_type) && (!Type__is_integer(index_type)))) {
+
+#line 868 "./compiler/typecheck.ae"
+        TypeChecker__error(this, Error__new_note(node->u.binary.rhs->span, "Index must be an integer", format_string("Got type '%s'", Type__str(index_type))));
+      } 
+
+#line 873 "./compiler/typecheck.ae"
+      etype = expr_type->ptr;
+    } break;
+    case ASTType__PlusEquals:
+    case ASTType__MinusEquals:
+    case ASTType__DivideEquals:
+    case ASTType__MultiplyEquals: {
+
+#line 876 "./compiler/typecheck.ae"
+      Type *lhs = TypeChecker__check_expression(this, node->u.binary.lhs, NULL);
+
+#line 877 "./compiler/typecheck.ae"
+      Type *rhs = TypeChecker__check_expression(this, node->u.binary.rhs, lhs);
+
+#line 878 "./compiler/typecheck.ae"
+      if (((!((bool)lhs)) || (!((bool)rhs)))) 
+
+#line 878 "./compiler/typecheck.ae"
+      return NULL;
+      
+
+#line 880 "./compiler/typecheck.ae"
+      if ((!AST__is_lvalue(node->u.binary.lhs))) {
+
+#line 881 "./compiler/typecheck.ae"
+        TypeChecker__error(this, Error__new(node->u.binary.lhs->span, "Must be an l-value"));
+      } 
+
+#line 883 "./compiler/typecheck.ae"
+      if (Type__is_simd(lhs)) {
+
+#line 884 "./compiler/typecheck.ae"
+        TypeChecker__check_simd_arith(this, node, lhs, rhs);
+      }  else {
+
+#line 886 "./compiler/typecheck.ae"
+        if (((!Type__is_numeric(lhs)) || (!Type__is_numeric(rhs)))) {
+
+#line 887 "./compiler/typecheck.ae"
+          TypeChecker__error(this, Error__new_note(node->span, "Operator requires numeric types", format_string("Got types '%s' and '%s'", Type__str(lhs), Type__str(rhs))));
+        } 
+
+#line 892 "./compiler/typecheck.ae"
+        if ((!Type__eq(lhs, rhs))) {
+
+#line 893 "./compiler/typecheck.ae"
+          TypeChecker__error(this, Error__new_note(node->span, "Operands must be of the same type", format_string("Got types '%s' and '%s'", Type__str(lhs), Type__str(rhs))));
+        } 
+      } 
+
+#line 899 "./compiler/typecheck.ae"
+      etype = lhs;
+    } break;
+    case ASTType__Assignment: {
+
+#line 902 "./compiler/typecheck.ae"
+      Type *lhs = TypeChecker__check_expression(this, node->u.binary.lhs, NULL);
+
+#line 903 "./compiler/typecheck.ae"
+      Type *rhs = TypeChecker__check_expression(this, node->u.binary.rhs, lhs);
+
+#line 904 "./compiler/typecheck.ae"
+      if (((!((bool)lhs)) || (!((bool)rhs)))) 
+
+#line 904 "./compiler/typecheck.ae"
+      return NULL;
+      
+
+#line 906 "./compiler/typecheck.ae"
+      if ((!AST__is_lvalue(node->u.binary.lhs))) {
+
+#line 907 "./compiler/typecheck.ae"
+        TypeChecker__error(this, Error__new(node->u.binary.lhs->span, "Must be an l-value"));
+      } 
+
+#line 909 "./compiler/typecheck.ae"
+      if ((!Type__eq(lhs, rhs))) {
+
+#line 910 "./compiler/typecheck.ae"
+        TypeChecker__error(this, Error__new_note(node->span, "Variable type does not match assignment type", format_string("Expected type '%s', got '%s'", Type__str(lhs), Type__str(rhs))));
+      } 
+
+#line 915 "./compiler/typecheck.ae"
+      etype = lhs;
+    } break;
+    case ASTType__ScopeLookup: {
+
+#line 918 "./compiler/typecheck.ae"
+      if ((node->u.member.lhs->type != ASTType__Identifier)) {
+
+#line 919 "./compiler/typecheck.ae"
+        TypeChecker__error(this, Error__new(node->u.member.lhs->span, "Left hand side of `::` must be a struct name"));
+
+#line 920 "./compiler/typecheck.ae"
+        return NULL;
+      } 
+
+#line 923 "./compiler/typecheck.ae"
+      char *struct_name = node->u.member.lhs->u.ident.name;
+
+#line 924 "./compiler/typecheck.ae"
+      Structure *struc = ((Structure *)Map__get(this->structures, struct_name));
+
+#line 925 "./compiler/typecheck.ae"
+      if ((!((bool)struc))) {
+
+#line 926 "./compiler/typecheck.ae"
+        TypeChecker__error(this, Error__new(node->u.member.lhs->span, "Unknown struct with this name"));
+
+#line 927 "./compiler/typecheck.ae"
+        return NULL;
+      } 
+
+#line 930 "./compiler/typecheck.ae"
+      AST *lhs = node->u.member.lhs;
+
+#line 931 "./compiler/typecheck.ae"
+      lhs->etype = struc->type;
+
+#line 933 "./compiler/typecheck.ae"
+      AST *rhs = node->u.member.rhs;
+
+#line 934 "./compiler/typecheck.ae"
+      char *field_name = rhs->u.ident.name;
+
+#line 935 "./compiler/typecheck.ae"
+      Variable *var = TypeChecker__get_struct_member(this, struct_name, field_name);
+
+#line 937 "./compiler/typecheck.ae"
+      Map *s_methods = ((Map *)Map__get(this->methods, struct_name));
+
+#line 938 "./compiler/typecheck.ae"
+      Function *method = ((Function *)Map__get(s_methods, field_name));
+
+#line 939 "./compiler/typecheck.ae"
+      if ((struc->is_enum && ((bool)var))) {
+
+#line 940 "./compiler/typecheck.ae"
+        rhs->u.ident.var = var;
+
+#line 943 "./compiler/typecheck.ae"
+        node->type = ASTType__EnumValue;
+
+#line 944 "./compiler/typecheck.ae"
+        node->u.enum_val = ((EnumValue *)calloc(1, sizeof(EnumValue)));
+
+#line 945 "./compiler/typecheck.ae"
+        node->u.enum_val->struct_def = struc;
+
+#line 946 "./compiler/typecheck.ae"
+        node->u.enum_val->var = var;
+
+#line 947 "./compiler/typecheck.ae"
+        node->u.enum_val->lhs = lhs;
+
+#line 948 "./compiler/typecheck.ae"
+        node->u.enum_val->rhs = rhs;
+
+#line 949 "./compiler/typecheck.ae"
+        etype = struc->type;
+      }  else 
+#line 951 "./compiler/typecheck.ae"
+      if (((bool)method)) {
+
+#line 952 "./compiler/typecheck.ae"
+        rhs->u.ident.func = method;
+
+#line 953 "./compiler/typecheck.ae"
+        etype = method->type;
+
+#line 954 "./compiler/typecheck.ae"
+        if ((node != this->callee)) 
+
+#line 954 "./compiler/typecheck.ae"
+        method->is_address_taken = true;
+        
+      }  else {
+
+#line 956 "./compiler/typecheck.ae"
+        TypeChecker__error_unknown_member(this, node, struc->type, field_name, true);
+
+#line 957 "./compiler/typecheck.ae"
+        return NULL;
+      } 
+      
+    } break;
+    case ASTType__Member: {
+
+#line 961 "./compiler/typecheck.ae"
+      Type *lhs_type = TypeChecker__check_expression(this, node->u.member.lhs, NULL);
+
+#line 962 "./compiler/typecheck.ae"
+      if ((!((bool)lhs_type))) 
+
+#line 962 "./compiler/typecheck.ae"
+      return NULL;
+      
+
+#line 964 "./compiler/typecheck.ae"
+      if (Type__is_simd(lhs_type)) {
+
+#line 965 "./compiler/typecheck.ae"
+        if ((!TypeChecker__simd_lane_to_index(this, node, lhs_type))) 
+
+#line 965 "./compiler/typecheck.ae"
+        return NULL;
+        
+
+#line 966 "./compiler/typecheck.ae"
+        return TypeChecker__check_expression(this, node, hint);
+      } 
+
+#line 969 "./compiler/typecheck.ae"
+      if (((!Type__is_struct_or_ptr(lhs_type)) && (!Type__is_string(lhs_type)))) {
+
+#line 970 "./compiler/typecheck.ae"
+        TypeChecker__error(this, Error__new_note(node->u.member.lhs->span, "LHS of member access must be a struct / string", format_string("Got type '%s'", Type__str(lhs_type))));
+
+#line 974 "./compiler/typecheck.ae"
+        return NULL;
+      } 
+
+#line 976 "./compiler/typecheck.ae"
+      node->u.member.is_pointer = lhs_type->name == NULL;
+
+#line 977 "./compiler/typecheck.ae"
+      Type *struct_type = (((bool)lhs_type->name) ? lhs_type : lhs_type->ptr);
+
+#line 979 "./compiler/typecheck.ae"
+      AST *rhs = node->u.member.rhs;
+
+#line 980 "./compiler/typecheck.ae"
+      if ((rhs->type != ASTType__Identifier)) 
+
+#line 980 "./compiler/typecheck.ae"
+      return NULL;
+      
+
+#line 982 "./compiler/typecheck.ae"
+      char *struct_name = struct_type->name;
+
+#line 983 "./compiler/typecheck.ae"
+      char *field_name = rhs->u.ident.name;
+
+#line 985 "./compiler/typecheck.ae"
+      Structure *struc = ((Structure *)Map__get(this->structures, struct_name));
+
+#line 986 "./compiler/typecheck.ae"
+      Variable *field = TypeChecker__get_struct_member(this, struct_name, field_name);
+
+#line 988 "./compiler/typecheck.ae"
+      Map *s_methods = ((Map *)Map__get(this->methods, struct_name));
+
+#line 989 "./compiler/typecheck.ae"
+      if ((!((bool)s_methods))) {
+
+#line 990 "./compiler/typecheck.ae"
+        TypeChecker__error(this, Error__new(node->span, "Unknown struct with this name"));
+
+#line 991 "./compiler/typecheck.ae"
+        return NULL;
+      } 
+
+#line 993 "./compiler/typecheck.ae"
+      Function *method = ((Function *)Map__get(s_methods, field_name));
+
+#line 995 "./compiler/typecheck.ae"
+      if (((((bool)struc) && ((bool)field)) && (!struc->is_enum))) {
+
+#line 996 "./compiler/typecheck.ae"
+        etype = field->type;
+
+#line 997 "./compiler/typecheck.ae"
+        rhs->u.ident.var = field;
+      }  else 
+#line 998 "./compiler/typecheck.ae"
+      if (((bool)method)) {
+
+#line 999 "./compiler/typecheck.ae"
+        if (method->is_static) {
+
+#line 1000 "./compiler/typecheck.ae"
+          TypeChecker__error(this, Error__new_hint(node->span, "Member access requires a non-static method", method->span, "This is a static method"));
+        } 
+
+#line 1005 "./compiler/typecheck.ae"
+        rhs->u.ident.func = method;
+
+#line 1006 "./compiler/typecheck.ae"
+        etype = method->type;
+      }  else {
+
+#line 1008 "./compiler/typecheck.ae"
+        TypeChecker__error_unknown_member(this, node, struct_type, field_name, false);
+
+#line 1009 "./compiler/typecheck.ae"
+        return NULL;
+      } 
+      
+    } break;
+    case ASTType__Cast: {
+
+#line 1013 "./compiler/typecheck.ae"
+      Type *lhs_type = TypeChecker__check_expression(this, node->u.cast.lhs, NULL);
+
+#line 1014 "./compiler/typecheck.ae"
+      if ((!TypeChecker__type_is_valid(this, node->u.cast.to))) {
+
+#line 1015 "./compiler/typecheck.ae"
+        TypeChecker__error(this, Error__new(node->u.cast.to->span, "Type does not exist"));
+
+#line 1016 "./compiler/typecheck.ae"
+        return NULL;
+      } 
+
+#line 1018 "./compiler/typecheck.ae"
+      etype = node->u.cast.to;
+    } break;
+    case ASTType__IsNotNull: {
+
+#line 1021 "./compiler/typecheck.ae"
+      Type *lhs_type = TypeChecker__check_expression(this, node->u.unary, NULL);
+
+#line 1022 "./compiler/typecheck.ae"
+      if ((!((bool)lhs_type))) 
+
+#line 1022 "./compiler/typecheck.ae"
+      return NULL;
+      
+
+#line 1023 "./compiler/typecheck.ae"
+      if ((lhs_type->base != BaseType__Pointer)) {
+
+#line 1024 "./compiler/typecheck.ae"
+        TypeChecker__error(this, Error__new_note(node->span, "Can only use ? on pointer types", format_string("Type of expression is '%s'", Type__str(lhs_type))));
+      } 
+
+#line 1029 "./compiler/typecheck.ae"
+      etype = Type__new(BaseType__Bool, node->span);
+    } break;
+    case ASTType__Match: {
+
+#line 1032 "./compiler/typecheck.ae"
+      TypeChecker__check_match(this, node, true, hint);
+
+#line 1033 "./compiler/typecheck.ae"
+      etype = node->etype;
+    } break;
+    case ASTType__If: {
+
+#line 1036 "./compiler/typecheck.ae"
+      TypeChecker__check_if(this, node, true, hint);
+
+#line 1037 "./compiler/typecheck.ae"
+      etype = node->etype;
+    } break;
+    default: {
+
+#line 1039 "./compiler/typecheck.ae"
+      TypeChecker__error(this, Error__new(node->span, "Expected an expression statement"));
+    } break;
+  }
+
+#line 1041 "./compiler/typecheck.ae"
+  if ((!((bool)etype))) 
+
+#line 1041 "./compiler/typecheck.ae"
+  return NULL;
+  
+
+#line 1042 "./compiler/typecheck.ae"
+  etype = Type__decay_array(etype);
+
+#line 1043 "./compiler/typecheck.ae"
+  node->etype = etype;
+
+#line 1044 "./compiler/typecheck.ae"
+  return etype;
+}
+
+
+#line 1047 "./compiler/typecheck.ae"
+static __attribute__((unused)) void TypeChecker__check_expression_statement(TypeChecker *this, AST *node, AST *body, bool is_expr, Type *hint) {
+
+#line 1048 "./compiler/typecheck.ae"
+  switch (body->type) {
+    case ASTType__Match: {
+
+#line 1050 "./compiler/typecheck.ae"
+      TypeChecker__check_match(this, body, is_expr, hint);
+    } break;
+    case ASTType__If: {
+
+#line 1051 "./compiler/typecheck.ae"
+      TypeChecker__check_if(this, body, is_expr, hint);
+    } break;
+    case ASTType__Block: {
+
+#line 1053 "./compiler/typecheck.ae"
+      TypeChecker__check_block(this, body, is_expr);
+    } break;
+    default: {
+
+#line 1055 "./compiler/typecheck.ae"
+      if (is_expr) {
+
+#line 1056 "./compiler/typecheck.ae"
+        TypeChecker__check_expression(this, body, hint);
+      }  else {
+
+#line 1058 "./compiler/typecheck.ae"
+        TypeChecker__check_statement(this, body);
+      } 
+    } break;
+  }
+
+#line 1063 "./compiler/typecheck.ae"
+  node->returns = (node->returns && body->returns);
+
+#line 1064 "./compiler/typecheck.ae"
+  if ((!is_expr)) 
+
+#line 1064 "./compiler/typecheck.ae"
+  return;
+  
+
+#line 1068 "./compiler/typecheck.ae"
+  Type *ret = body->etype;
+
+#line 1069 "./compiler/typecheck.ae"
+  if (body->returns) {
+  }  else 
+#line 1071 "./compiler/typecheck.ae"
+  if ((!((bool)ret))) {
+
+#line 1072 "./compiler/typecheck.ae"
+    TypeChecker__error(this, Error__new(body->span, "Must yield a value in this branch"));
+  }  else 
+#line 1073 "./compiler/typecheck.ae"
+  if ((!((bool)node->etype))) {
+
+#line 1074 "./compiler/typecheck.ae"
+    node->etype = ret;
+  }  else 
+#line 1075 "./compiler/typecheck.ae"
+  if ((!Type__eq(node->etype, ret))) {
+
+#line 1076 "./compiler/typecheck.ae"
+    TypeChecker__error(this, Error__new_note(body->span, "Yield type doesn't match previous branches", format_string("Expected type '%s', got '%s'", Type__str(node->etype), Type__str(ret))));
+  } 
+  
+  
+  
+}
+
+
+#line 1083 "./compiler/typecheck.ae"
+static __attribute__((unused)) void TypeChecker__check_match_for_enum(TypeChecker *this, Structure *struc, AST *node, bool is_expr, Type *hint) {
+
+#line 1084 "./compiler/typecheck.ae"
+  Map *mapping = Map__new();
+
+#line 1085 "./compiler/typecheck.ae"
+  ;
+
+#line 1087 "./compiler/typecheck.ae"
+  Vector *cases = node->u.match_stmt->cases;
+
+#line 1088 "./compiler/typecheck.ae"
+  node->returns = (cases->size > 0);
+
+#line 1090 "./compiler/typecheck.ae"
+  for (i32 i = 0; (i < cases->size); i += 1) {
+
+#line 1091 "./compiler/typecheck.ae"
+    MatchCase *_case = ((MatchCase *)Vector__at(cases, i));
+
+#line 1092 "./compiler/typecheck.ae"
+    AST *cond = _case->cond;
+
+#line 1093 "./compiler/typecheck.ae"
+    char *name;
+
+#line 1095 "./compiler/typecheck.ae"
+    Type *cond_type = TypeChecker__check_expression(this, cond, struc->type);
+
+#line 1096 "./compiler/typecheck.ae"
+    if ((!Type__eq(cond_type, struc->type))) {
+
+#line 1097 "./compiler/typecheck.ae"
+      TypeChecker__error(this, Error__new_hint(cond->span, "Condition does not match expression type", node->u.match_stmt->expr->span, format_string("Match expression is of type '%s'", Type__str(struc->type))));
+    } 
+
+#line 1102 "./compiler/typecheck.ae"
+    if ((cond->type != ASTType__EnumValue)) {
+
+#line 1103 "./compiler/typecheck.ae"
+      TypeChecker__error(this, Error__new(cond->span, "Expected an enum value"));
+
+#line 1104 "./compiler/typecheck.ae"
+      continue;
+    } 
+
+#line 1107 "./compiler/typecheck.ae"
+    name = cond->u.enum_val->var->name;
+
+#line 1109 "./compiler/typecheck.ae"
+    MatchCase *prev = ((MatchCase *)Map__get(mapping, name));
+
+#line 1110 "./compiler/typecheck.ae"
+    if (((bool)prev)) {
+
+#line 1111 "./compiler/typecheck.ae"
+      TypeChecker__error(this, Error__new_hint(cond->span, "Duplicate condition name in match", prev->cond->span, "This condition was previously used here"));
+    } 
+
+#line 1116 "./compiler/typecheck.ae"
+    Map__insert(mapping, name, _case);
+
+#line 1117 "./compiler/typecheck.ae"
+    if (((bool)_case->body)) {
+
+#line 1118 "./compiler/typecheck.ae"
+      TypeChecker__check_expression_statement(this, node, _case->body, is_expr, hint);
+    } 
+  } 
+
+#line 1122 "./compiler/typecheck.ae"
+  AST *defolt = node->u.match_stmt->defolt;
+
+#line 1123 "./compiler/typecheck.ae"
+  if ((mapping->num_items != struc->fields->size)) {
+
+#line 1124 "./compiler/typecheck.ae"
+    if ((!((bool)defolt))) {
+
+#line 1125 "./compiler/typecheck.ae"
+      TypeChecker__error(this, Error__new_note(node->span, "Match does not cover all cases", format_string("Only %d of %d cases are covered", mapping->num_items, struc->fields->size)));
+    }  else {
+
+#line 1130 "./compiler/typecheck.ae"
+      TypeChecker__check_expression_statement(this, node, defolt, is_expr, hint);
+    } 
+  }  else {
+
+#line 1133 "./compiler/typecheck.ae"
+    if (((bool)defolt)) {
+
+#line 1134 "./compiler/typecheck.ae"
+      TypeChecker__error(this, Error__new(node->u.match_stmt->defolt_span, "`else` case is not needed for this match"));
+    } 
+  } 
+
+#line 1138 "./compiler/typecheck.ae"
+  if (((is_expr && (!((bool)node->etype))) && (!node->returns))) {
+
+#line 1139 "./compiler/typecheck.ae"
+    TypeChecker__error(this, Error__new(node->span, "Expression-match must yield a value"));
+  } 
+
+  /* defers */
+
+#line 1085 "./compiler/typecheck.ae"
+  Map__free(mapping);
+}
+
+
+#line 1144 "./compiler/typecheck.ae"
+static __attribute__((unused)) void TypeChecker__check_match(TypeChecker *this, AST *node, bool is_expr, Type *hint) {
+
+#line 1145 "./compiler/typecheck.ae"
+  AST *expr = node->u.match_stmt->expr;
+
+#line 1146 "./compiler/typecheck.ae"
+  Type *expr_type = TypeChecker__check_expression(this, expr, NULL);
+
+#line 1147 "./compiler/typecheck.ae"
+  if ((!((bool)expr_type))) {
+
+#line 1148 "./compiler/typecheck.ae"
+    TypeChecker__error(this, Error__new(node->span, "Match statement must have a valid expression"));
+
+#line 1149 "./compiler/typecheck.ae"
+    return;
+  } 
+
+#line 1152 "./compiler/typecheck.ae"
+  Structure *struc;
+
+#line 1153 "./compiler/typecheck.ae"
+  if (expr_type->base == BaseType__Structure) {
+
+#line 1154 "./compiler/typecheck.ae"
+    struc = ((Structure *)Map__get(this->structures, expr_type->name));
+
+#line 1155 "./compiler/typecheck.ae"
+    if (struc->is_enum) {
+
+#line 1156 "./compiler/typecheck.ae"
+      TypeChecker__check_match_for_enum(this, struc, node, is_expr, hint);
+
+#line 1157 "./compiler/typecheck.ae"
+      return;
+    } 
+  } 
+
+#line 1160 "./compiler/typecheck.ae"
+  if ((((!Type__is_integer(expr_type)) && (expr_type->base != BaseType__Char)) && (!Type__is_string(expr_type)))) {
+
+#line 1163 "./compiler/typecheck.ae"
+    TypeChecker__error(this, Error__new_note(expr->span, "This type cannot be matched on", format_string("Expression type is '%s'", Type__str(expr_type))));
+  } 
+
+#line 1169 "./compiler/typecheck.ae"
+  Vector *cases = node->u.match_stmt->cases;
+
+#line 1170 "./compiler/typecheck.ae"
+  node->returns = (cases->size > 0);
+
+#line 1172 "./compiler/typecheck.ae"
+  for (i32 i = 0; (i < cases->size); i += 1) {
+
+#line 1173 "./compiler/typecheck.ae"
+    MatchCase *_case = ((MatchCase *)Vector__at(cases, i));
+
+#line 1174 "./compiler/typecheck.ae"
+    Type *cond_type = TypeChecker__check_expression(this, _case->cond, expr_type);
+
+#line 1175 "./compiler/typecheck.ae"
+    if ((!((bool)cond_type))) 
+
+#line 1175 "./compiler/typecheck.ae"
+    continue;
+    
+
+#line 1176 "./compiler/typecheck.ae"
+    if ((!Type__eq(cond_type, expr_type))) {
+
+#line 1177 "./compiler/typecheck.ae"
+      TypeChecker__error(this, Error__new_hint(cond_type->span, "Condition does not match expression type", node->u.match_stmt->expr->span, format_string("Match expression is of type '%s'", Type__str(cond_type))));
+    } 
+
+#line 1182 "./compiler/typecheck.ae"
+    if ((((_case->cond->type != ASTType__IntLiteral) && (_case->cond->type != ASTType__CharLiteral)) && (_case->cond->type != ASTType__StringLiteral))) {
+
+#line 1185 "./compiler/typecheck.ae"
+      TypeChecker__error(this, Error__new(_case->cond->span, "Match condition must use only literals"));
+    } 
+
+#line 1187 "./compiler/typecheck.ae"
+    if (((bool)_case->body)) {
+
+#line 1188 "./compiler/typecheck.ae"
+      TypeChecker__check_expression_statement(this, node, _case->body, is_expr, hint);
+    } 
+  } 
+
+#line 1192 "./compiler/typecheck.ae"
+  AST *defolt = node->u.match_stmt->defolt;
+
+#line 1194 "./compiler/typecheck.ae"
+  if ((!((bool)defolt))) {
+
+#line 1195 "./compiler/typecheck.ae"
+    TypeChecker__error(this, Error__new(node->span, "`else` case is missing"));
+  }  else {
+
+#line 1197 "./compiler/typecheck.ae"
+    TypeChecker__check_expression_statement(this, node, defolt, is_expr, hint);
+  } 
+
+#line 1200 "./compiler/typecheck.ae"
+  if (((is_expr && (!((bool)node->etype))) && (!node->returns))) {
+
+#line 1201 "./compiler/typecheck.ae"
+    TypeChecker__error(this, Error__new(node->span, "Expression-match must yield a value"));
+  } 
+}
+
+
+#line 1205 "./compiler/typecheck.ae"
+static __attribute__((unused)) void TypeChecker__check_if(TypeChecker *this, AST *node, bool is_expr, Type *hint) {
+
+#line 1206 "./compiler/typecheck.ae"
+  Type *cond_type = TypeChecker__check_expression(this, node->u.if_stmt.cond, NULL);
+
+#line 1207 "./compiler/typecheck.ae"
+  if ((((bool)cond_type) && (cond_type->base != BaseType__Bool))) {
+
+#line 1208 "./compiler/typecheck.ae"
+    TypeChecker__error(this, Error__new_note(node->u.if_stmt.cond->span, "Condition must be a boolean", format_string("Got type '%s'", Type__str(cond_type))));
+  } 
+
+#line 1213 "./compiler/typecheck.ae"
+  TypeChecker__check_expression_statement(this, node, node->u.if_stmt.body, is_expr, hint);
+
+#line 1214 "./compiler/typecheck.ae"
+  if (((bool)node->u.if_stmt.els)) {
+
+#line 1215 "./compiler/typecheck.ae"
+    AST *else_stmt = node->u.if_stmt.els;
+
+#line 1216 "./compiler/typecheck.ae"
+    TypeChecker__check_expression_statement(this, node, else_stmt, is_expr, hint);
+
+#line 1218 "./compiler/typecheck.ae"
+    if ((node->u.if_stmt.body->returns && else_stmt->returns)) {
+
+#line 1219 "./compiler/typecheck.ae"
+      node->returns = true;
+    } 
+  }  else 
+#line 1221 "./compiler/typecheck.ae"
+  if (is_expr) {
+
+#line 1222 "./compiler/typecheck.ae"
+    TypeChecker__error(this, Error__new(node->span, "Expression-if must have an 'else' branch"));
+  } 
+  
+
+#line 1224 "./compiler/typecheck.ae"
+  if (((is_expr && (!((bool)node->etype))) && (!node->returns))) {
+
+#line 1225 "./compiler/typecheck.ae"
+    TypeChecker__error(this, Error__new(node->span, "Expression-if must yield a value"));
+  } 
+}
+
+
+#line 1229 "./compiler/typecheck.ae"
+static __attribute__((unused)) Type *TypeChecker__check_constant_expression(TypeChecker *this, AST *node) {
+
+#line 1230 "./compiler/typecheck.ae"
+  Type *etype = ({ Type *__yield_0;
+
+#line 1230 "./compiler/typecheck.ae"
+  switch (node->type) {
+    case ASTType__Identifier: {
+
+#line 1232 "./compiler/typecheck.ae"
+      Variable *constant = TypeChecker__find_constant(this, node->u.ident.name);
+
+#line 1233 "./compiler/typecheck.ae"
+      if ((!((bool)constant))) {
+
+#line 1234 "./compiler/typecheck.ae"
+        TypeChecker__error(this, Error__new(node->span, "No constant value found with this name"));
+
+#line 1235 "./compiler/typecheck.ae"
+        return NULL;
+      } 
+
+#line 1237 "./compiler/typecheck.ae"
+      node->u.ident.var = constant;
+
+#line 1238 "./compiler/typecheck.ae"
+      __yield_0 = constant->type;
+    } break;
+    case ASTType__IntLiteral:
+    case ASTType__FloatLiteral: {
+
+#line 1241 "./compiler/typecheck.ae"
+      Type *suffix = node->u.num_literal.suffix;
+
+#line 1242 "./compiler/typecheck.ae"
+      if ((((bool)suffix) && (!TypeChecker__type_is_valid(this, suffix)))) {
+
+#line 1243 "./compiler/typecheck.ae"
+        TypeChecker__error(this, Error__new(suffix->span, "Invalid type"));
+      } 
+
+#line 1245 "./compiler/typecheck.ae"
+      __yield_0 = ({ Type *__yield_1;
+
+#line 1245 "./compiler/typecheck.ae"
+  if (((bool)suffix)) {
+
+#line 1246 "./compiler/typecheck.ae"
+    __yield_1 = suffix;
+  }  else     __yield_1 = ({ Type *__yield_2;
+
+#line 1247 "./compiler/typecheck.ae"
+  if (node->type == ASTType__IntLiteral) {
+
+#line 1248 "./compiler/typecheck.ae"
+    __yield_2 = Type__new(BaseType__I32, node->span);
+  }  else {
+
+#line 1250 "./compiler/typecheck.ae"
+    __yield_2 = Type__new(BaseType__F32, node->span);
+  } 
+;__yield_2; });
+  
+;__yield_1; });
+    } break;
+    case ASTType__BoolLiteral: {
+      __yield_0 = Type__new(BaseType__Bool, node->span);
+} break;
+    case ASTType__CharLiteral: {
+      __yield_0 = Type__new(BaseType__Char, node->span);
+} break;
+    case ASTType__StringLiteral: {
+      __yield_0 = Type__ptr_to(BaseType__Char, node->span);
+} break;
+    case ASTType__Plus:
+    case ASTType__Minus:
+    case ASTType__Multiply:
+    case ASTType__Divide:
+    case ASTType__LessThan:
+    case ASTType__LessThanEquals:
+    case ASTType__GreaterThan:
+    case ASTType__GreaterThanEquals:
+    case ASTType__Equals:
+    case ASTType__NotEquals:
+    case ASTType__And:
+    case ASTType__Or:
+    case ASTType__Modulus:
+    case ASTType__BitwiseNot:
+    case ASTType__BitwiseOr:
+    case ASTType__BitwiseAnd:
+    case ASTType__BitwiseXor:
+    case ASTType__LeftShift:
+    case ASTType__RightShift: {
+
+#line 1275 "./compiler/typecheck.ae"
+      Type *lhs = TypeChecker__check_constant_expression(this, node->u.binary.lhs);
+
+#line 1276 "./compiler/typecheck.ae"
+      Type *rhs = TypeChecker__check_constant_expression(this, node->u.binary.rhs);
+
+#line 1277 "./compiler/typecheck.ae"
+      if (((!((bool)lhs)) || (!((bool)rhs)))) 
+
+#line 1277 "./compiler/typecheck.ae"
+      return NULL;
+      
+
+#line 1279 "./compiler/typecheck.ae"
+      if ((lhs->base == BaseType__Pointer || rhs->base == BaseType__Pointer)) {
+
+#line 1280 "./compiler/typecheck.ae"
+        TypeChecker__error(this, Error__new(node->span, "Cannot do pointer arithmetic in constant expressions"));
+      } 
+
+#line 1282 "./compiler/typecheck.ae"
+      __yield_0 = TypeChecker__check_binary_op(this, node, node->u.binary.lhs, node->u.binary.rhs);
+    } break;
+    default: {
+
+#line 1285 "./compiler/typecheck.ae"
+      TypeChecker__error(this, Error__new(node->span, "Unsupported operator in constant expression"));
+
+#line 1286 "./compiler/typecheck.ae"
+      return NULL;
+    } break;
+  }
+;__yield_0; });
+
+#line 1289 "./compiler/typecheck.ae"
+  node->etype = etype;
+
+#line 1290 "./compiler/typecheck.ae"
+  return etype;
+}
+
+
+#line 1293 "./compiler/typecheck.ae"
+static __attribute__((unused)) void TypeChecker__check_var_declaration(TypeChecker *this, AST *node, bool is_constant) {
+
+#line 1294 "./compiler/typecheck.ae"
+  VarDeclaration *var_decl = (&node->u.var_decl);
+
+#line 1295 "./compiler/typecheck.ae"
+  Type *declared_type = var_decl->var->type;
+
+#line 1296 "./compiler/typecheck.ae"
+  if ((((bool)declared_type) && (!TypeChecker__type_is_valid(this, declared_type)))) {
+
+#line 1297 "./compiler/typecheck.ae"
+    TypeChecker__error(this, Error__new(declared_type->span, "Invalid variable type"));
+  } 
+
+#line 1299 "./compiler/typecheck.ae"
+  if (((bool)var_decl->init)) {
+
+#line 1301 "./compiler/typecheck.ae"
+    Type *init_type = ({ Type *__yield_0;
+
+#line 1301 "./compiler/typecheck.ae"
+  if (is_constant) {
+
+#line 1302 "./compiler/typecheck.ae"
+    __yield_0 = TypeChecker__check_constant_expression(this, var_decl->init);
+  }  else {
+
+#line 1304 "./compiler/typecheck.ae"
+    __yield_0 = TypeChecker__check_expression(this, var_decl->init, declared_type);
+  } 
+;__yield_0; });
+
+#line 1307 "./compiler/typecheck.ae"
+    if ((((bool)init_type) && init_type->base == BaseType__Method)) {
+
+#line 1308 "./compiler/typecheck.ae"
+      TypeChecker__error(this, Error__new(var_decl->init->span, "Cannot assign methods to variables"));
+    } 
+
+#line 1310 "./compiler/typecheck.ae"
+    if ((!((bool)var_decl->var->type))) {
+
+#line 1311 "./compiler/typecheck.ae"
+      var_decl->var->type = init_type;
+    }  else 
+#line 1312 "./compiler/typecheck.ae"
+    if (((bool)init_type)) {
+
+#line 1313 "./compiler/typecheck.ae"
+      if ((!Type__eq(declared_type, init_type))) {
+
+#line 1314 "./compiler/typecheck.ae"
+        TypeChecker__error(this, Error__new_note(var_decl->init->span, "Variable type does not match initializer type", format_string("Expected '%s' but got '%s'", Type__str(declared_type), Type__str(init_type))));
+      } 
+    } 
+    
+  }  else {
+
+#line 1321 "./compiler/typecheck.ae"
+    if ((!((bool)declared_type))) {
+
+#line 1322 "./compiler/typecheck.ae"
+      TypeChecker__error(this, Error__new(var_decl->var->span, "Variable type cannot be inferred, specify explicitly"));
+
+#line 1323 "./compiler/typecheck.ae"
+      var_decl->var->type = Type__new(BaseType__Void, node->span);
+    } 
+  } 
+
+#line 1327 "./compiler/typecheck.ae"
+  Variable *var = var_decl->var;
+
+#line 1328 "./compiler/typecheck.ae"
+  if (is_constant) {
+
+#line 1329 "./compiler/typecheck.ae"
+    Map__insert(this->constants, var->name, var);
+  }  else {
+
+#line 1331 "./compiler/typecheck.ae"
+    TypeChecker__push_var(this, var);
+
+#line 1332 "./compiler/typecheck.ae"
+    if (((((bool)this->cur_func) && ((bool)this->cur_func->yield_type)) && (!((bool)var->frame_name)))) {
+
+#line 1333 "./compiler/typecheck.ae"
+      TypeChecker__add_frame_var(this, this->cur_func, var);
+    } 
+  } 
+}
+
+
+#line 1340 "./compiler/typecheck.ae"
+static __attribute__((unused)) void TypeChecker__add_frame_var(TypeChecker *this, Function *func, Variable *var) {
+
+#line 1341 "./compiler/typecheck.ae"
+  char *name = var->name;
+
+#line 1342 "./compiler/typecheck.ae"
+  bool taken = string__eq(name, "value");
+
+#line 1343 "./compiler/typecheck.ae"
+  for (i32 i = 0; (i < func->frame_vars->size); i += 1) {
+
+#line 1344 "./compiler/typecheck.ae"
+    Variable *other = ((Variable *)Vector__at(func->frame_vars, i));
+
+#line 1345 "./compiler/typecheck.ae"
+    if (string__eq(other->frame_name, name)) 
+
+#line 1345 "./compiler/typecheck.ae"
+    taken = true;
+    
+  } 
+
+#line 1347 "./compiler/typecheck.ae"
+  var->frame_name = (taken ? format_string("%s__%d", name, func->frame_vars->size) : name);
+
+#line 1348 "./compiler/typecheck.ae"
+  Vector__push(func->frame_vars, var);
+}
+
+
+#line 1351 "./compiler/typecheck.ae"
+static __attribute__((unused)) void TypeChecker__check_statement(TypeChecker *this, AST *node) {
+
+#line 1352 "./compiler/typecheck.ae"
+  switch (node->type) {
+    case ASTType__Block: {
+
+#line 1353 "./compiler/typecheck.ae"
+      TypeChecker__check_block(this, node, false);
+    } break;
+    case ASTType__Defer: {
+
+#line 1354 "./compiler/typecheck.ae"
+      TypeChecker__check_expression(this, node->u.unary, NULL);
+    } break;
+    case ASTType__Scratch: {
+
+#line 1356 "./compiler/typecheck.ae"
+      TypeChecker__check_block(this, node->u.unary, false);
+
+#line 1357 "./compiler/typecheck.ae"
+      node->returns = node->u.unary->returns;
+    } break;
+    case ASTType__Match: {
+
+#line 1359 "./compiler/typecheck.ae"
+      TypeChecker__check_match(this, node, false, NULL);
+    } break;
+    case ASTType__Yield: {
+
+#line 1361 "./compiler/typecheck.ae"
+      if ((((!this->can_yield) && ((bool)this->cur_func)) && ((bool)this->cur_func->yield_type))) {
+
+#line 1362 "./compiler/typecheck.ae"
+        node->type = ASTType__GeneratorYield;
+
+#line 1363 "./compiler/typecheck.ae"
+        TypeChecker__check_statement(this, node);
+
+#line 1364 "./compiler/typecheck.ae"
+        return;
+      } 
+
+#line 1366 "./compiler/typecheck.ae"
+      if ((!this->can_yield)) {
+
+#line 1367 "./compiler/typecheck.ae"
+        TypeChecker__error(this, Error__new(node->span, "Cannot yield in this context"));
+      } 
+
+#line 1369 "./compiler/typecheck.ae"
+      node->etype = TypeChecker__check_expression(this, node->u.unary, NULL);
+    } break;
+    case ASTType__GeneratorYield: {
+
+#line 1373 "./compiler/typecheck.ae"
+      if ((this->expr_block_depth > 0)) {
+
+#line 1374 "./compiler/typecheck.ae"
+        TypeChecker__error(this, Error__new(node->span, "Cannot yield from a generator inside an expression"));
+      } 
+
+#line 1376 "./compiler/typecheck.ae"
+      Type *yield_type = this->cur_func->yield_type;
+
+#line 1377 "./compiler/typecheck.ae"
+      Type *expr_type = TypeChecker__check_expression(this, node->u.unary, yield_type);
+
+#line 1378 "./compiler/typecheck.ae"
+      if ((((bool)expr_type) && (!Type__eq(expr_type, yield_type)))) {
+
+#line 1379 "./compiler/typecheck.ae"
+        TypeChecker__error(this, Error__new_hint(node->u.unary->span, format_string("Yielded type '%s' is incorrect", Type__str(expr_type)), yield_type->span, format_string("This generator yields '%s'", Type__str(yield_type))));
+      } 
+    } break;
+    case ASTType__Return: {
+
+#line 1386 "./compiler/typecheck.ae"
+      if ((!((bool)this->cur_func))) {
+
+#line 1387 "./compiler/typecheck.ae"
+        TypeChecker__error(this, Error__new(node->span, "Return statement outside of function"));
+      } 
+
+#line 1389 "./compiler/typecheck.ae"
+      if ((((bool)this->cur_func) && ((bool)this->cur_func->yield_type))) {
+
+#line 1390 "./compiler/typecheck.ae"
+        if (((bool)node->u.unary)) {
+
+#line 1391 "./compiler/typecheck.ae"
+          TypeChecker__error(this, Error__new(node->span, "Cannot return a value from a generator"));
+        } 
+      }  else 
+#line 1393 "./compiler/typecheck.ae"
+      if ((!((bool)node->u.unary))) {
+
+#line 1394 "./compiler/typecheck.ae"
+        if ((this->cur_func->return_type->base != BaseType__Void)) {
+
+#line 1395 "./compiler/typecheck.ae"
+          TypeChecker__error(this, Error__new_hint(node->span, "Cannot have empty return in non-void function", this->cur_func->return_type->span, format_string("This function returns '%s'", Type__str(this->cur_func->return_type))));
+        } 
+      }  else {
+
+#line 1401 "./compiler/typecheck.ae"
+        Type *ret_type = TypeChecker__check_expression(this, node->u.unary, this->cur_func->return_type);
+
+#line 1402 "./compiler/typecheck.ae"
+        if ((((bool)ret_type) && this->cur_func->return_type->base == BaseType__Void)) {
+
+#line 1404 "./compiler/typecheck.ae"
+          if ((ret_type->base != BaseType__Void)) {
+
+#line 1405 "./compiler/typecheck.ae"
+            TypeChecker__error(this, Error__new_hint(node->u.unary->span, format_string("Cannot return '%s' in void function", Type__str(ret_type)), this->cur_func->span, "This function does not return a value"));
+          } 
+        } 
+
+#line 1411 "./compiler/typecheck.ae"
+        if ((((bool)ret_type) && (!Type__eq(ret_type, this->cur_func->return_type)))) {
+
+#line 1412 "./compiler/typecheck.ae"
+          TypeChecker__error(this, Error__new_hint(node->u.unary->span, format_string("Return type '%s' is incorrect", Type__str(ret_type)), this->cur_func->return_type->span, format_string("This function returns '%s'", Type__str(this->cur_func->return_type))));
+        } 
+      } 
+      
+
+#line 1418 "./compiler/typecheck.ae"
+      node->returns = true;
+    } break;
+    case ASTType__Break:
+    case ASTType__Continue: {
+
+#line 1421 "./compiler/typecheck.ae"
+      if ((!this->in_loop)) {
+
+#line 1422 "./compiler/typecheck.ae"
+        TypeChecker__error(this, Error__new(node->span, format_string("%s statement outside of loop", ASTType__dbg(node->type))));
+      } 
+    } break;
+    case ASTType__VarDeclaration: {
+
+#line 1426 "./compiler/typecheck.ae"
+      TypeChecker__check_var_declaration(this, node, false);
+    } break;
+    case ASTType__While: {
+
+#line 1429 "./compiler/typecheck.ae"
+      bool was_in_loop = this->in_loop;
+
+#line 1430 "./compiler/typecheck.ae"
+      this->in_loop = true;
+
+#line 1431 "./compiler/typecheck.ae"
+      Type *cond_type = TypeChecker__check_expression(this, node->u.loop->cond, NULL);
+
+#line 1432 "./compiler/typecheck.ae"
+      if ((((bool)cond_type) && (cond_type->base != BaseType__Bool))) {
+
+#line 1433 "./compiler/typecheck.ae"
+        TypeChecker__error(this, Error__new_note(node->u.loop->cond->span, "Condition must be boolean", format_string("Got type '%s'", Type__str(cond_type))));
+      } 
+
+#line 1438 "./compiler/typecheck.ae"
+      TypeChecker__check_statement(this, node->u.loop->body);
+
+#line 1439 "./compiler/typecheck.ae"
+      this->in_loop = was_in_loop;
+    } break;
+    case ASTType__For: {
+
+#line 1442 "./compiler/typecheck.ae"
+      bool was_in_loop = this->in_loop;
+
+#line 1443 "./compiler/typecheck.ae"
+      this->in_loop = true;
+
+#line 1444 "./compiler/typecheck.ae"
+      TypeChecker__push_scope(this);
+
+#line 1445 "./compiler/typecheck.ae"
+      if (((bool)node->u.loop->init)) {
+
+#line 1446 "./compiler/typecheck.ae"
+        TypeChecker__check_statement(this, node->u.loop->init);
+      } 
+
+#line 1448 "./compiler/typecheck.ae"
+      if (((bool)node->u.loop->cond)) {
+
+#line 1449 "./compiler/typecheck.ae"
+        Type *cond_type = TypeChecker__check_expression(this, node->u.loop->cond, NULL);
+
+#line 1450 "./compiler/typecheck.ae"
+        if ((((bool)cond_type) && (cond_type->base != BaseType__Bool))) {
+
+#line 1451 "./compiler/typecheck.ae"
+          TypeChecker__error(this, Error__new_note(node->u.loop->cond->span, "Condition must be boolean", format_string("Got type '%s'", Type__str(cond_type))));
+        } 
+      } 
+
+#line 1457 "./compiler/typecheck.ae"
+      if (((bool)node->u.loop->incr)) {
+
+#line 1458 "./compiler/typecheck.ae"
+        TypeChecker__check_statement(this, node->u.loop->incr);
+      } 
+
+#line 1460 "./compiler/typecheck.ae"
+      TypeChecker__check_statement(this, node->u.loop->body);
+
+#line 1461 "./compiler/typecheck.ae"
+      TypeChecker__pop_scope(this);
+
+#line 1462 "./compiler/typecheck.ae"
+      this->in_loop = was_in_loop;
+    } break;
+    case ASTType__ForIn: {
+
+#line 1464 "./compiler/typecheck.ae"
+      TypeChecker__check_for_in(this, node);
+    } break;
+    case ASTType__If: {
+
+#line 1465 "./compiler/typecheck.ae"
+      TypeChecker__check_if(this, node, false, NULL);
+    } break;
+    default: {
+
+#line 1466 "./compiler/typecheck.ae"
+      TypeChecker__check_expression(this, node, NULL);
+    } break;
+  }
+}
+
+
+#line 1470 "./compiler/typecheck.ae"
+static __attribute__((unused)) Variable *TypeChecker__add_loop_state(TypeChecker *this, char *name, Type *type, Span span) {
+
+#line 1471 "./compiler/typecheck.ae"
+  Variable *var = Variable__new(name, type, span);
+
+#line 1472 "./compiler/typecheck.ae"
+  if ((((bool)this->cur_func) && ((bool)this->cur_func->yield_type))) {
+
+#line 1473 "./compiler/typecheck.ae"
+    TypeChecker__add_frame_var(this, this->cur_func, var);
+  } 
+
+#line 1475 "./compiler/typecheck.ae"
+  return var;
+}
+
+
+#line 1486 "./compiler/typecheck.ae"
+static __attribute__((unused)) void TypeChecker__check_for_in(TypeChecker *this, AST *node) {
+
+#line 1487 "./compiler/typecheck.ae"
+  ForIn *for_in = node->u.for_in;
+
+#line 1488 "./compiler/typecheck.ae"
+  Span span = for_in->expr->span;
+
+#line 1489 "./compiler/typecheck.ae"
+  Type *int_type = Type__new(BaseType__I32, span);
+
+#line 1490 "./compiler/typecheck.ae"
+  Type *elem_type = ((Type *)NULL);
+
+#line 1492 "./compiler/typecheck.ae"
+  TypeChecker__push_scope(this);
+
+#line 1493 "./compiler/typecheck.ae"
+  if ((((bool)for_in->var->type) && (!TypeChecker__type_is_valid(this, for_in->var->type)))) {
+
+#line 1494 "./compiler/typecheck.ae"
+    TypeChecker__error(this, Error__new(for_in->var->type->span, "Invalid variable type"));
+  } 
+
+#line 1496 "./compiler/typecheck.ae"
+  Type *hint = (((bool)for_in->end) ? for_in->var->type : NULL);
+
+#line 1497 "./compiler/typecheck.ae"
+  Type *expr_type = TypeChecker__check_expression(this, for_in->expr, hint);
+
+#line 1498 "./compiler/typecheck.ae"
+  if (((bool)for_in->end)) {
+
+#line 1499 "./compiler/typecheck.ae"
+    Type *end_type = TypeChecker__check_expression(this, for_in->end, expr_type);
+
+#line 1501 "./compiler/typecheck.ae"
+    AST *start = for_in->expr;
+
+#line 1502 "./compiler/typecheck.ae"
+    if (((((!((bool)hint)) && ((bool)end_type)) && start->type == ASTType__IntLiteral) && (!((bool)start->u.num_literal.suffix)))) {
+
+#line 1503 "./compiler/typecheck.ae"
+      expr_type = TypeChecker__check_expression(this, start, end_type);
+    } 
+
+#line 1505 "./compiler/typecheck.ae"
+    if ((((bool)expr_type) && ((bool)end_type))) {
+
+#line 1506 "./compiler/typecheck.ae"
+      if (((!Type__is_integer(expr_type)) || (!Type__eq(expr_type, end_type)))) {
+
+#line 1507 "./compiler/typecheck.ae"
+        TypeChecker__error(this, Error__new_note(Span__join(&span, &for_in->end->span), "Range bounds must be integers of the same type", format_string("Got '%s' and '%s'", Type__str(expr_type), Type__str(end_type))));
+      } 
+    } 
+
+#line 1513 "./compiler/typecheck.ae"
+    for_in->kind = IterKind__Range;
+
+#line 1514 "./compiler/typecheck.ae"
+    elem_type = expr_type;
+
+#line 1515 "./compiler/typecheck.ae"
+    for_in->cursor = TypeChecker__add_loop_state(this, "__it_cursor", expr_type, span);
+
+#line 1516 "./compiler/typecheck.ae"
+    for_in->limit = TypeChecker__add_loop_state(this, "__it_limit", expr_type, span);
+  }  else 
+#line 1518 "./compiler/typecheck.ae"
+  if (((bool)expr_type)) {
+
+#line 1519 "./compiler/typecheck.ae"
+    Type *type = expr_type;
+
+#line 1521 "./compiler/typecheck.ae"
+    Variable *ident_var = (for_in->expr->type == ASTType__Identifier ? for_in->expr->u.ident.var : NULL);
+
+#line 1522 "./compiler/typecheck.ae"
+    if ((((bool)ident_var) && Type__is_array(ident_var->type))) 
+
+#line 1522 "./compiler/typecheck.ae"
+    type = ident_var->type;
+    
+
+#line 1523 "./compiler/typecheck.ae"
+    if ((type->base == BaseType__Pointer && Type__is_struct(type->ptr))) 
+
+#line 1523 "./compiler/typecheck.ae"
+    type = type->ptr;
+    
+
+#line 1524 "./compiler/typecheck.ae"
+    Structure *struc = (Type__is_struct(type) ? type->struct_def : NULL);
+
+#line 1526 "./compiler/typecheck.ae"
+    Variable *data = (((bool)struc) ? Structure__find_field(struc, "data") : NULL);
+
+#line 1527 "./compiler/typecheck.ae"
+    Variable *size = (((bool)struc) ? Structure__find_field(struc, "size") : NULL);
+
+#line 1528 "./compiler/typecheck.ae"
+    Variable *buckets = (((bool)struc) ? Structure__find_field(struc, "buckets") : NULL);
+
+#line 1529 "./compiler/typecheck.ae"
+    Variable *num_buckets = (((bool)struc) ? Structure__find_field(struc, "num_buckets") : NULL);
+
+#line 1531 "./compiler/typecheck.ae"
+    if (Type__is_array(type)) {
+
+#line 1532 "./compiler/typecheck.ae"
+      for_in->kind = IterKind__Elements;
+
+#line 1533 "./compiler/typecheck.ae"
+      elem_type = type->ptr;
+
+#line 1534 "./compiler/typecheck.ae"
+      for_in->end = type->size_expr;
+    }  else 
+#line 1535 "./compiler/typecheck.ae"
+    if ((((bool)struc) && ((bool)struc->generator))) {
+
+#line 1536 "./compiler/typecheck.ae"
+      for_in->kind = IterKind__Generator;
+
+#line 1537 "./compiler/typecheck.ae"
+      elem_type = struc->generator->yield_type;
+    }  else 
+#line 1538 "./compiler/typecheck.ae"
+    if (((((bool)data) && ((bool)size)) && data->type->base == BaseType__Pointer)) {
+
+#line 1539 "./compiler/typecheck.ae"
+      for_in->kind = IterKind__Elements;
+
+#line 1540 "./compiler/typecheck.ae"
+      elem_type = data->type->ptr;
+    }  else 
+#line 1541 "./compiler/typecheck.ae"
+    if (((((bool)buckets) && ((bool)num_buckets)) && buckets->type->base == BaseType__Pointer)) {
+
+#line 1543 "./compiler/typecheck.ae"
+      Type *node_type = buckets->type->ptr;
+
+#line 1544 "./compiler/typecheck.ae"
+      bool is_node = (node_type->base == BaseType__Pointer && Type__is_struct(node_type->ptr));
+
+#line 1545 "./compiler/typecheck.ae"
+      Variable *next = (is_node ? Structure__find_field(node_type->ptr->struct_def, "next") : NULL);
+
+#line 1546 "./compiler/typecheck.ae"
+      if (((((bool)next) && Type__eq(next->type, node_type)) && Type__is_integer(num_buckets->type))) {
+
+#line 1547 "./compiler/typecheck.ae"
+        for_in->kind = IterKind__Buckets;
+
+#line 1548 "./compiler/typecheck.ae"
+        elem_type = node_type;
+      }  else {
+
+#line 1550 "./compiler/typecheck.ae"
+        TypeChecker__error(this, Error__new_note(span, "Cannot iterate over the buckets of this type", format_string("Buckets must point to structs with a 'next' field of type '%s'", Type__str(node_type))));
+      } 
+    }  else {
+
+#line 1556 "./compiler/typecheck.ae"
+      TypeChecker__error(this, Error__new_note(span, "Cannot iterate over this type", format_string("Got '%s'", Type__str(expr_type))));
+    } 
+    
+    
+    
+
+#line 1562 "./compiler/typecheck.ae"
+    if (((bool)elem_type)) {
+
+#line 1563 "./compiler/typecheck.ae"
+      if ((!Type__is_array(type))) {
+
+#line 1564 "./compiler/typecheck.ae"
+        for_in->source = TypeChecker__add_loop_state(this, "__it_source", expr_type, span);
+      } 
+
+#line 1566 "./compiler/typecheck.ae"
+      switch (for_in->kind) {
+        case IterKind__Elements: {
+
+#line 1568 "./compiler/typecheck.ae"
+          Type *ptr_type = Type__new_link(BaseType__Pointer, elem_type, span);
+
+#line 1569 "./compiler/typecheck.ae"
+          for_in->cursor = TypeChecker__add_loop_state(this, "__it_cursor", ptr_type, span);
+
+#line 1570 "./compiler/typecheck.ae"
+          for_in->limit = TypeChecker__add_loop_state(this, "__it_limit", ptr_type, span);
+        } break;
+        case IterKind__Buckets: {
+
+#line 1573 "./compiler/typecheck.ae"
+          for_in->cursor = TypeChecker__add_loop_state(this, "__it_cursor", elem_type, span);
+
+#line 1574 "./compiler/typecheck.ae"
+          for_in->limit = TypeChecker__add_loop_state(this, "__it_limit", int_type, span);
+        } break;
+        default: {
+        } break;
+      }
+    } 
+  } 
+  
+
+#line 1581 "./compiler/typecheck.ae"
+  Variable *var = for_in->var;
+
+#line 1582 "./compiler/typecheck.ae"
+  if ((!((bool)var->type))) {
+
+#line 1583 "./compiler/typecheck.ae"
+    var->type = elem_type;
+  }  else 
+#line 1584 "./compiler/typecheck.ae"
+  if ((((bool)elem_type) && (!Type__eq(var->type, elem_type)))) {
+
+#line 1585 "./compiler/typecheck.ae"
+    TypeChecker__error(this, Error__new_note(var->type->span, "Loop variable type does not match the elements", format_string("Expected '%s' but got '%s'", Type__str(elem_type), Type__str(var->type))));
+  } 
+  
+
+#line 1590 "./compiler/typecheck.ae"
+  if ((!((bool)var->type))) {
+
+#line 1591 "./compiler/typecheck.ae"
+    var->type = Type__new(BaseType__Error, var->span);
+  } 
+
+#line 1593 "./compiler/typecheck.ae"
+  TypeChecker__push_var(this, var);
+
+#line 1594 "./compiler/typecheck.ae"
+  if (((((bool)this->cur_func) && ((bool)this->cur_func->yield_type)) && (!((bool)var->frame_name)))) {
+
+#line 1595 "./compiler/typecheck.ae"
+    TypeChecker__add_frame_var(this, this->cur_func, var);
+  } 
+
+#line 1598 "./compiler/typecheck.ae"
+  bool was_in_loop = this->in_loop;
+
+#line 1599 "./compiler/typecheck.ae"
+  this->in_loop = true;
+
+#line 1600 "./compiler/typecheck.ae"
+  TypeChecker__check_statement(this, for_in->body);
+
+#line 1601 "./compiler/typecheck.ae"
+  this->in_loop = was_in_loop;
+
+#line 1602 "./compiler/typecheck.ae"
+  TypeChecker__pop_scope(this);
+}
+
+
+#line 1605 "./compiler/typecheck.ae"
+static __attribute__((unused)) void TypeChecker__check_block(TypeChecker *this, AST *node, bool can_yield) {
+
+#line 1606 "./compiler/typecheck.ae"
+  bool could_yield = this->can_yield;
+
+#line 1607 "./compiler/typecheck.ae"
+  this->can_yield = can_yield;
+
+#line 1608 "./compiler/typecheck.ae"
+  if (can_yield) 
+
+#line 1608 "./compiler/typecheck.ae"
+  this->expr_block_depth += 1;
+  
+
+#line 1610 "./compiler/typecheck.ae"
+  Span yield_span = {0};
+
+#line 1612 "./compiler/typecheck.ae"
+  TypeChecker__push_scope(this);
+
+#line 1613 "./compiler/typecheck.ae"
+  Vector *statements = node->u.block.statements;
+
+#line 1614 "./compiler/typecheck.ae"
+  for (i32 i = 0; (i < statements->size); i += 1) {
+
+#line 1615 "./compiler/typecheck.ae"
+    AST *statement = ((AST *)Vector__at(statements, i));
+
+#line 1616 "./compiler/typecheck.ae"
+    TypeChecker__check_statement(this, statement);
+
+#line 1617 "./compiler/typecheck.ae"
+    if (statement->returns) {
+
+#line 1618 "./compiler/typecheck.ae"
+      node->returns = true;
+    } 
+
+#line 1620 "./compiler/typecheck.ae"
+    if ((statement->type != ASTType__Yield)) 
+
+#line 1620 "./compiler/typecheck.ae"
+    continue;
+    
+
+#line 1621 "./compiler/typecheck.ae"
+    if (((bool)node->etype)) {
+
+#line 1622 "./compiler/typecheck.ae"
+      TypeChecker__error(this, Error__new_hint(statement->span, "Cannot yield multiple times in a block", yield_span, "Previously yield here is here"));
+    } 
+
+#line 1627 "./compiler/typecheck.ae"
+    node->etype = statement->etype;
+
+#line 1628 "./compiler/typecheck.ae"
+    yield_span = statement->span;
+  } 
+
+#line 1631 "./compiler/typecheck.ae"
+  TypeChecker__pop_scope(this);
+
+#line 1632 "./compiler/typecheck.ae"
+  if (can_yield) 
+
+#line 1632 "./compiler/typecheck.ae"
+  this->expr_block_depth -= 1;
+  
+
+#line 1633 "./compiler/typecheck.ae"
+  this->can_yield = could_yield;
+}
+
+
+#line 1636 "./compiler/typecheck.ae"
+static __attribute__((unused)) void TypeChecker__check_function(TypeChecker *this, Function *func) {
+
+#line 1637 "./compiler/typecheck.ae"
+  Function *prev_func = this->cur_func;
+
+#line 1638 "./compiler/typecheck.ae"
+  this->cur_func = func;
+
+#line 1639 "./compiler/typecheck.ae"
+  TypeChecker__push_scope(this);
+
+#line 1642 "./compiler/typecheck.ae"
+  for (i32 i = 0; (i < func->params->size); i += 1) {
+
+#line 1643 "./compiler/typecheck.ae"
+    Variable *var = ((Variable *)Vector__at(func->params, i));
+
+#line 1644 "./compiler/typecheck.ae"
+    TypeChecker__push_var(this, var);
+  } 
+
+#line 1647 "./compiler/typecheck.ae"
+  if (((bool)func->body)) {
+
+#line 1648 "./compiler/typecheck.ae"
+    if (func->is_arrow) {
+
+#line 1649 "./compiler/typecheck.ae"
+      TypeChecker__check_statement(this, func->body);
+    }  else {
+
+#line 1651 "./compiler/typecheck.ae"
+      TypeChecker__check_block(this, func->body, false);
+    } 
+
+#line 1653 "./compiler/typecheck.ae"
+    if (((!func->body->returns) && (func->return_type->base != BaseType__Void))) {
+
+#line 1654 "./compiler/typecheck.ae"
+      if (((!string__eq(func->name, "main")) && (!((bool)func->yield_type)))) {
+
+#line 1655 "./compiler/typecheck.ae"
+        TypeChecker__error(this, Error__new(func->span, "Function does not always return"));
+      } 
+    } 
+  } 
+
+#line 1660 "./compiler/typecheck.ae"
+  TypeChecker__pop_scope(this);
+
+#line 1661 "./compiler/typecheck.ae"
+  this->cur_func = prev_func;
+}
+
+
+#line 1667 "./compiler/typecheck.ae"
+static __attribute__((unused)) void TypeChecker__declare_generator(TypeChecker *this, Program *program, Function *func) {
+
+#line 1668 "./compiler/typecheck.ae"
+  if ((!TypeChecker__type_is_valid(this, func->yield_type))) {
+
+#line 1669 "./compiler/typecheck.ae"
+    TypeChecker__error(this, Error__new(func->yield_type->span, "Invalid yield type"));
+  } 
+
+#line 1672 "./compiler/typecheck.ae"
+  char *name = ({ char *__yield_0;
+
+#line 1672 "./compiler/typecheck.ae"
+  if (func->is_method) {
+
+#line 1673 "./compiler/typecheck.ae"
+    __yield_0 = format_string("%s__%s__Generator", func->method_struct_name, func->name);
+  }  else {
+
+#line 1675 "./compiler/typecheck.ae"
+    __yield_0 = format_string("%s__Generator", func->name);
+  } 
+;__yield_0; });
+
+#line 1677 "./compiler/typecheck.ae"
+  Structure *struc = Structure__new(func->span);
+
+#line 1678 "./compiler/typecheck.ae"
+  struc->name = name;
+
+#line 1679 "./compiler/typecheck.ae"
+  struc->generator = func;
+
+#line 1680 "./compiler/typecheck.ae"
+  struc->type = Type__new(BaseType__Structure, func->span);
+
+#line 1681 "./compiler/typecheck.ae"
+  struc->type->name = name;
+
+#line 1682 "./compiler/typecheck.ae"
+  struc->type->struct_def = struc;
+
+#line 1683 "./compiler/typecheck.ae"
+  Vector__push(struc->fields, Variable__new("value", func->yield_type, func->span));
+
+#line 1684 "./compiler/typecheck.ae"
+  func->return_type = struc->type;
+
+#line 1686 "./compiler/typecheck.ae"
+  Map__insert(this->structures, name, struc);
+
+#line 1687 "./compiler/typecheck.ae"
+  Map__insert(this->methods, name, Map__new());
+
+#line 1688 "./compiler/typecheck.ae"
+  Vector__push(program->structures, struc);
+
+#line 1690 "./compiler/typecheck.ae"
+  for (i32 i = 0; (i < func->params->size); i += 1) {
+
+#line 1691 "./compiler/typecheck.ae"
+    Variable *param = ((Variable *)Vector__at(func->params, i));
+
+#line 1692 "./compiler/typecheck.ae"
+    TypeChecker__add_frame_var(this, func, param);
+  } 
+
+#line 1695 "./compiler/typecheck.ae"
+  Function *next = Function__new(func->span);
+
+#line 1696 "./compiler/typecheck.ae"
+  next->name = "next";
+
+#line 1697 "./compiler/typecheck.ae"
+  next->is_method = true;
+
+#line 1698 "./compiler/typecheck.ae"
+  next->method_struct_name = name;
+
+#line 1699 "./compiler/typecheck.ae"
+  next->generator = func;
+
+#line 1700 "./compiler/typecheck.ae"
+  next->return_type = Type__new(BaseType__Bool, func->span);
+
+#line 1701 "./compiler/typecheck.ae"
+  Type *frame_ptr = Type__new_link(BaseType__Pointer, struc->type, func->span);
+
+#line 1702 "./compiler/typecheck.ae"
+  Vector__push(next->params, Variable__new("__gen", frame_ptr, func->span));
+
+#line 1703 "./compiler/typecheck.ae"
+  Vector__push(program->functions, next);
+}
+
+
+#line 1706 "./compiler/typecheck.ae"
+static __attribute__((unused)) void TypeChecker__check_all_functions(TypeChecker *this, Program *program) {
+
+#line 1707 "./compiler/typecheck.ae"
+  i32 num_functions = program->functions->size;
+
+#line 1708 "./compiler/typecheck.ae"
+  for (i32 i = 0; (i < num_functions); i += 1) {
+
+#line 1709 "./compiler/typecheck.ae"
+    Function *func = ((Function *)Vector__at(program->functions, i));
+
+#line 1710 "./compiler/typecheck.ae"
+    if (((bool)func->yield_type)) 
+
+#line 1710 "./compiler/typecheck.ae"
+    TypeChecker__declare_generator(this, program, func);
+    
+  } 
+
+#line 1713 "./compiler/typecheck.ae"
+  for (i32 i = 0; (i < program->functions->size); i += 1) {
+
+#line 1714 "./compiler/typecheck.ae"
+    Function *func = ((Function *)Vector__at(program->functions, i));
+
+#line 1715 "./compiler/typecheck.ae"
+    char *name = func->name;
+
+#line 1716 "./compiler/typecheck.ae"
+    char *struct_name = func->method_struct_name;
+
+#line 1717 "./compiler/typecheck.ae"
+    Type *func_type = ((Type *)NULL);
+
+#line 1719 "./compiler/typecheck.ae"
+    if (func->is_method) {
+
+#line 1720 "./compiler/typecheck.ae"
+      Map *s_methods = ((Map *)Map__get(this->methods, struct_name));
+
+#line 1721 "./compiler/typecheck.ae"
+      if ((!((bool)s_methods))) {
+
+#line 1722 "./compiler/typecheck.ae"
+        TypeChecker__error(this, Error__new(func->span, "Type for method does not exist"));
+      } 
+
+#line 1724 "./compiler/typecheck.ae"
+      if ((((bool)s_methods) && Map__exists(s_methods, name))) {
+
+#line 1725 "./compiler/typecheck.ae"
+        Function *method = ((Function *)Map__get(s_methods, name));
+
+#line 1726 "./compiler/typecheck.ae"
+        TypeChecker__error(this, Error__new_hint(func->span, "Method is already defined for this type", method->span, "Previous definition here"));
+      } 
+
+#line 1731 "./compiler/typecheck.ae"
+      Variable *var = TypeChecker__get_struct_member(this, struct_name, name);
+
+#line 1732 "./compiler/typecheck.ae"
+      if (((bool)var)) {
+
+#line 1733 "./compiler/typecheck.ae"
+        TypeChecker__error(this, Error__new_hint(func->span, "Type already has a field with this name", var->span, "Previous definition here"));
+      } 
+
+#line 1739 "./compiler/typecheck.ae"
+      func_type = Type__new(BaseType__Method, func->span);
+
+#line 1740 "./compiler/typecheck.ae"
+      func_type->name = struct_name;
+    }  else {
+
+#line 1742 "./compiler/typecheck.ae"
+      func_type = Type__new(BaseType__Function, func->span);
+
+#line 1744 "./compiler/typecheck.ae"
+      if (Map__exists(this->functions, name)) {
+
+#line 1745 "./compiler/typecheck.ae"
+        Function *prev = ((Function *)Map__get(this->functions, name));
+
+#line 1746 "./compiler/typecheck.ae"
+        TypeChecker__error(this, Error__new_hint(func->span, "Function is already defined", prev->span, "Previous definition here"));
+      } 
+    } 
+
+#line 1752 "./compiler/typecheck.ae"
+    func_type->func_def = func;
+
+#line 1754 "./compiler/typecheck.ae"
+    for (i32 j = 0; (j < func->params->size); j += 1) {
+
+#line 1755 "./compiler/typecheck.ae"
+      Variable *param = ((Variable *)Vector__at(func->params, j));
+
+#line 1756 "./compiler/typecheck.ae"
+      if ((!TypeChecker__type_is_valid(this, param->type))) {
+
+#line 1757 "./compiler/typecheck.ae"
+        TypeChecker__error(this, Error__new(param->type->span, "Invalid parameter type"));
+      } 
+    } 
+
+#line 1760 "./compiler/typecheck.ae"
+    func_type->params = func->params;
+
+#line 1762 "./compiler/typecheck.ae"
+    if ((!TypeChecker__type_is_valid(this, func->return_type))) {
+
+#line 1763 "./compiler/typecheck.ae"
+      TypeChecker__error(this, Error__new(func->return_type->span, "Invalid return type"));
+    } 
+
+#line 1765 "./compiler/typecheck.ae"
+    func_type->return_type = func->return_type;
+
+#line 1766 "./compiler/typecheck.ae"
+    func->type = func_type;
+
+#line 1768 "./compiler/typecheck.ae"
+    if (func->is_method) {
+
+#line 1769 "./compiler/typecheck.ae"
+      Map *s_methods = ((Map *)Map__get(this->methods, struct_name));
+
+#line 1770 "./compiler/typecheck.ae"
+      if (((bool)s_methods)) 
+
+#line 1770 "./compiler/typecheck.ae"
+      Map__insert(s_methods, name, func);
+      
+    }  else {
+
+#line 1772 "./compiler/typecheck.ae"
+      Map__insert(this->functions, name, func);
+    } 
+  } 
+
+#line 1776 "./compiler/typecheck.ae"
+  for (i32 i = 0; (i < program->functions->size); i += 1) {
+
+#line 1777 "./compiler/typecheck.ae"
+    TypeChecker__check_function(this, ((Function *)Vector__at(program->functions, i)));
+  } 
+}
+
+
+#line 1781 "./compiler/typecheck.ae"
+static __attribute__((unused)) void TypeChecker__dfs_structs(TypeChecker *this, Structure *struc, Vector *results, Bitset *done) {
+
+#line 1782 "./compiler/typecheck.ae"
+  Bitset__set(done, struc->index);
+
+#line 1784 "./compiler/typecheck.ae"
+  for (i32 i = 0; (i < struc->fields->size); i += 1) {
+
+#line 1785 "./compiler/typecheck.ae"
+    Variable *field = ((Variable *)Vector__at(struc->fields, i));
+
+#line 1786 "./compiler/typecheck.ae"
+    if ((!TypeChecker__type_is_valid(this, field->type))) {
+
+#line 1787 "./compiler/typecheck.ae"
+      TypeChecker__error(this, Error__new(field->type->span, "Type of field is undefined"));
+
+#line 1788 "./compiler/typecheck.ae"
+      continue;
+    } 
+
+#line 1792 "./compiler/typecheck.ae"
+    if (((!struc->is_extern) && field->type->base == BaseType__Structure)) {
+
+#line 1793 "./compiler/typecheck.ae"
+      char *neib_name = field->type->name;
+
+#line 1794 "./compiler/typecheck.ae"
+      Structure *neib_struc = ((Structure *)Map__get(this->structures, neib_name));
+
+#line 1795 "./compiler/typecheck.ae"
+      if ((((bool)neib_struc) && (!Bitset__test(done, neib_struc->index)))) {
+
+#line 1796 "./compiler/typecheck.ae"
+        TypeChecker__dfs_structs(this, neib_struc, results, done);
+      } 
+    } 
+  } 
+
+#line 1800 "./compiler/typecheck.ae"
+  Vector__push(results, struc);
+}
+
+
+#line 1803 "./compiler/typecheck.ae"
+static __attribute__((unused)) Function *TypeChecker__add_builtin_method(TypeChecker *this, Map *s_methods, Structure *struc, char *name, Variable *param, Type *return_type) {
+
+#line 1804 "./compiler/typecheck.ae"
+  Function *func = Function__new(struc->span);
+
+#line 1805 "./compiler/typecheck.ae"
+  func->name = name;
+
+#line 1806 "./compiler/typecheck.ae"
+  func->return_type = return_type;
+
+#line 1807 "./compiler/typecheck.ae"
+  func->is_method = true;
+
+#line 1808 "./compiler/typecheck.ae"
+  func->method_struct_name = struc->name;
+
+#line 1809 "./compiler/typecheck.ae"
+  Vector__push(func->params, param);
+
+#line 1810 "./compiler/typecheck.ae"
+  Map__insert(s_methods, name, func);
+
+#line 1814 "./compiler/typecheck.ae"
+  func->type = Type__new(BaseType__Method, func->span);
+
+#line 1815 "./compiler/typecheck.ae"
+  func->type->name = struc->name;
+
+#line 1816 "./compiler/typecheck.ae"
+  func->type->func_def = func;
+
+#line 1817 "./compiler/typecheck.ae"
+  func->type->params = func->params;
+
+#line 1818 "./compiler/typecheck.ae"
+  func->type->return_type = func->return_type;
+
+#line 1819 "./compiler/typecheck.ae"
+  return func;
+}
+
+
+#line 1822 "./compiler/typecheck.ae"
+static __attribute__((unused)) void TypeChecker__check_all_structs(TypeChecker *this, Program *program) {
+
+#line 1823 "./compiler/typecheck.ae"
+  for (i32 i = 0; (i < program->structures->size); i += 1) {
+
+#line 1824 "./compiler/typecheck.ae"
+    Structure *struc = ((Structure *)Vector__at(program->structures, i));
+
+#line 1825 "./compiler/typecheck.ae"
+    char *name = struc->name;
+
+#line 1826 "./compiler/typecheck.ae"
+    struc->index = i;
+
+#line 1828 "./compiler/typecheck.ae"
+    if (Map__exists(this->structures, name)) {
+
+#line 1829 "./compiler/typecheck.ae"
+      Structure *prev = ((Structure *)Map__get(this->structures, name));
+
+#line 1830 "./compiler/typecheck.ae"
+      TypeChecker__error(this, Error__new_hint(struc->span, "Struct has already been defined", prev->span, "Previous definition here"));
+    } 
+
+#line 1836 "./compiler/typecheck.ae"
+    Map__insert(this->structures, name, struc);
+
+#line 1837 "./compiler/typecheck.ae"
+    Map *s_methods = Map__new();
+
+#line 1841 "./compiler/typecheck.ae"
+    if (struc->is_enum) {
+
+#line 1842 "./compiler/typecheck.ae"
+      Variable *this_param = Variable__new("this", struc->type, struc->span);
+
+#line 1843 "./compiler/typecheck.ae"
+      Type *str_type = Type__ptr_to(BaseType__Char, struc->span);
+
+#line 1844 "./compiler/typecheck.ae"
+      TypeChecker__add_builtin_method(this, s_methods, struc, "dbg", this_param, str_type);
+
+#line 1846 "./compiler/typecheck.ae"
+      Variable *str_param = Variable__new("s", str_type, struc->span);
+
+#line 1847 "./compiler/typecheck.ae"
+      Type *ptr_type = Type__new_link(BaseType__Pointer, struc->type, struc->span);
+
+#line 1848 "./compiler/typecheck.ae"
+      Function *from_str = TypeChecker__add_builtin_method(this, s_methods, struc, "from_str", str_param, ptr_type);
+
+#line 1849 "./compiler/typecheck.ae"
+      from_str->is_static = true;
+    } 
+
+#line 1852 "./compiler/typecheck.ae"
+    Map__insert(this->methods, name, s_methods);
+  } 
+
+#line 1856 "./compiler/typecheck.ae"
+  Bitset *done = Bitset__new(program->structures->size);
+
+#line 1857 "./compiler/typecheck.ae"
+  Vector *results = Vector__new_sized(program->structures->size);
+
+#line 1858 "./compiler/typecheck.ae"
+  for (i32 i = 0; (i < program->structures->size); i += 1) {
+
+#line 1859 "./compiler/typecheck.ae"
+    Structure *struc = ((Structure *)Vector__at(program->structures, i));
+
+#line 1860 "./compiler/typecheck.ae"
+    if ((!Bitset__test(done, struc->index))) {
+
+#line 1861 "./compiler/typecheck.ae"
+      TypeChecker__dfs_structs(this, struc, results, done);
+    } 
+  } 
+
+#line 1865 "./compiler/typecheck.ae"
+  Bitset__free(done);
+
+#line 1866 "./compiler/typecheck.ae"
+  Vector__free(program->structures);
+
+#line 1867 "./compiler/typecheck.ae"
+  program->structures = results;
+}
+
+
+#line 1870 "./compiler/typecheck.ae"
+static __attribute__((unused)) void TypeChecker__check_program(TypeChecker *this, Program *program) {
+
+#line 1871 "./compiler/typecheck.ae"
+  this->program = program;
+
+#line 1872 "./compiler/typecheck.ae"
+  for (i32 i = 0; (i < program->constants->size); i += 1) {
+
+#line 1873 "./compiler/typecheck.ae"
+    AST *node = ((AST *)Vector__at(program->constants, i));
+
+#line 1874 "./compiler/typecheck.ae"
+    TypeChecker__check_var_declaration(this, node, true);
+  } 
+
+#line 1877 "./compiler/typecheck.ae"
+  TypeChecker__check_all_structs(this, program);
+
+#line 1879 "./compiler/typecheck.ae"
+  TypeChecker__push_scope(this);
+
+#line 1880 "./compiler/typecheck.ae"
+  for (i32 i = 0; (i < program->global_vars->size); i += 1) {
+
+#line 1881 "./compiler/typecheck.ae"
+    AST *var = ((AST *)Vector__at(program->global_vars, i));
+
+#line 1882 "./compiler/typecheck.ae"
+    TypeChecker__check_var_declaration(this, var, false);
+  } 
+
+#line 1885 "./compiler/typecheck.ae"
+  TypeChecker__check_all_functions(this, program);
+
+#line 1886 "./compiler/typecheck.ae"
+  TypeChecker__pop_scope(this);
+
+#line 1887 "./compiler/typecheck.ae"
+  program->methods = this->methods;
+}
+
+
+#line 9 "./compiler/layout.ae"
+static __attribute__((unused)) i32 align_to(i32 offset, i32 align) {
+
+#line 9 "./compiler/layout.ae"
+  return ((((offset + align) - 1) / align) * align);
+}
+
+
+#line 12 "./compiler/layout.ae"
+static __attribute__((unused)) i32 type_size(Type *type) {
+
+#line 13 "./compiler/layout.ae"
+  if ((!((bool)type))) 
+
+#line 13 "./compiler/layout.ae"
+  return (-1);
+  
+
+#line 14 "./compiler/layout.ae"
+  switch (type->base) {
+    case BaseType__Pointer:
+    case BaseType__Function: {
+
+#line 15 "./compiler/layout.ae"
+      return 8;
+    } break;
+    case BaseType__Simd: {
+
+#line 16 "./compiler/layout.ae"
+      return (BaseType__scalar_size(type->ptr->base) * type->lanes);
+    } break;
+    case BaseType__Array: {
+
+#line 18 "./compiler/layout.ae"
+      AST *count = type->size_expr;
+
+#line 19 "./compiler/layout.ae"
+      if (((!((bool)count)) || (count->type != ASTType__IntLiteral))) 
+
+#line 19 "./compiler/layout.ae"
+      return (-1);
+      
+
+#line 20 "./compiler/layout.ae"
+      i32 elem = type_size(type->ptr);
+
+#line 21 "./compiler/layout.ae"
+      if ((elem < 0)) 
+
+#line 21 "./compiler/layout.ae"
+      return (-1);
+      
+
+#line 22 "./compiler/layout.ae"
+      return (elem * atoi(count->u.num_literal.text));
+    } break;
+    case BaseType__Structure: {
+
+#line 25 "./compiler/layout.ae"
+      Structure *struc = type->struct_def;
+
+#line 26 "./compiler/layout.ae"
+      if ((((!((bool)struc)) || struc->is_extern) || ((bool)struc->generator))) 
+
+#line 26 "./compiler/layout.ae"
+      return (-1);
+      
+
+#line 27 "./compiler/layout.ae"
+      if (struc->is_enum) 
+
+#line 27 "./compiler/layout.ae"
+      return 4;
+      
+
+#line 28 "./compiler/layout.ae"
+      return fields_size(struc, layout_fields(struc));
+    } break;
+    case BaseType__Method:
+    case BaseType__Error: {
+
+#line 30 "./compiler/layout.ae"
+      return (-1);
+    } break;
+    default: {
+
+#line 31 "./compiler/layout.ae"
+      return BaseType__scalar_size(type->base);
+    } break;
+  }
+}
+
+
+#line 35 "./compiler/layout.ae"
+static __attribute__((unused)) i32 type_align(Type *type) {
+
+#line 36 "./compiler/layout.ae"
+  switch (type->base) {
+    case BaseType__Pointer:
+    case BaseType__Function: {
+
+#line 37 "./compiler/layout.ae"
+      return 8;
+    } break;
+    case BaseType__Simd: {
+
+#line 38 "./compiler/layout.ae"
+      return type_size(type);
+    } break;
+    case BaseType__Array: {
+
+#line 39 "./compiler/layout.ae"
+      return type_align(type->ptr);
+    } break;
+    case BaseType__Structure: {
+
+#line 41 "./compiler/layout.ae"
+      Structure *struc = type->struct_def;
+
+#line 42 "./compiler/layout.ae"
+      if (((!((bool)struc)) || struc->is_extern)) 
+
+#line 42 "./compiler/layout.ae"
+      return 8;
+      
+
+#line 43 "./compiler/layout.ae"
+      if (struc->is_enum) 
+
+#line 43 "./compiler/layout.ae"
+      return 4;
+      
+
+#line 44 "./compiler/layout.ae"
+      if (struc->is_packed) 
+
+#line 44 "./compiler/layout.ae"
+      return 1;
+      
+
+#line 46 "./compiler/layout.ae"
+      i32 align = 1;
+
+#line 47 "./compiler/layout.ae"
+      for (i32 i = 0; (i < struc->fields->size); i += 1) {
+
+#line 48 "./compiler/layout.ae"
+        Variable *field = ((Variable *)Vector__at(struc->fields, i));
+
+#line 49 "./compiler/layout.ae"
+        align = max(align, type_align(field->type));
+      } 
+
+#line 51 "./compiler/layout.ae"
+      return align;
+    } break;
+    default: {
+
+#line 53 "./compiler/layout.ae"
+      return max(BaseType__scalar_size(type->base), 1);
+    } break;
+  }
+}
+
+
+#line 58 "./compiler/layout.ae"
+static __attribute__((unused)) i32 fields_size(Structure *struc, Vector *fields) {
+
+#line 59 "./compiler/layout.ae"
+  i32 size = 0;
+
+#line 60 "./compiler/layout.ae"
+  for (i32 i = 0; (i < fields->size); i += 1) {
+
+#line 61 "./compiler/layout.ae"
+    Variable *field = ((Variable *)Vector__at(fields, i));
+
+#line 62 "./compiler/layout.ae"
+    i32 field_size = type_size(field->type);
+
+#line 63 "./compiler/layout.ae"
+    if ((field_size < 0)) 
+
+#line 63 "./compiler/layout.ae"
+    return (-1);
+    
+
+#line 64 "./compiler/layout.ae"
+    if (struc->is_union) {
+
+#line 65 "./compiler/layout.ae"
+      size = max(size, field_size);
+    }  else 
+#line 66 "./compiler/layout.ae"
+    if (struc->is_packed) {
+
+#line 67 "./compiler/layout.ae"
+      size += field_size;
+    }  else {
+
+#line 69 "./compiler/layout.ae"
+      size = (align_to(size, type_align(field->type)) + field_size);
+    } 
+    
+  } 
+
+#line 72 "./compiler/layout.ae"
+  return align_to(size, type_align(struc->type));
+}
+
+
+#line 78 "./compiler/layout.ae"
+static __attribute__((unused)) Vector *sort_fields_by_align(Vector *fields) {
+
+#line 79 "./compiler/layout.ae"
+  Vector *sorted = Vector__new_sized(fields->size);
+
+#line 80 "./compiler/layout.ae"
+  for (i32 i = 0; (i < fields->size); i += 1) {
+
+#line 81 "./compiler/layout.ae"
+    Variable *field = ((Variable *)Vector__at(fields, i));
+
+#line 82 "./compiler/layout.ae"
+    i32 align = type_align(field->type);
+
+#line 83 "./compiler/layout.ae"
+    Vector__push(sorted, field);
+
+#line 84 "./compiler/layout.ae"
+    i32 j = (sorted->size - 1);
+
+#line 85 "./compiler/layout.ae"
+    while (((j > 0) && (type_align(((Variable *)Vector__at(sorted, (j - 1)))->type) < align))) {
+
+#line 86 "./compiler/layout.ae"
+      sorted->data[j] = sorted->data[(j - 1)];
+
+#line 87 "./compiler/layout.ae"
+      j -= 1;
+    } 
+
+#line 89 "./compiler/layout.ae"
+    sorted->data[j] = field;
+  } 
+
+#line 91 "./compiler/layout.ae"
+  return sorted;
+}
+
+
+#line 97 "./compiler/layout.ae"
+static __attribute__((unused)) Vector *layout_fields(Structure *struc) {
+
+#line 98 "./compiler/layout.ae"
+  if ((!struc->is_reorder)) 
+
+#line 98 "./compiler/layout.ae"
+  return struc->fields;
+  
+
+#line 99 "./compiler/layout.ae"
+  if ((!((bool)struc->layout_fields))) {
+
+#line 100 "./compiler/layout.ae"
+    struc->layout_fields = sort_fields_by_align(struc->fields);
+  } 
+
+#line 102 "./compiler/layout.ae"
+  return struc->layout_fields;
+}
+
+
+#line 106 "./compiler/layout.ae"
+static __attribute__((unused)) i32 struct_padding(Structure *struc) {
+
+#line 107 "./compiler/layout.ae"
+  i32 used = 0;
+
+#line 108 "./compiler/layout.ae"
+  for (i32 i = 0; (i < struc->fields->size); i += 1) {
+
+#line 109 "./compiler/layout.ae"
+    i32 field_size = type_size(((Variable *)Vector__at(struc->fields, i))->type);
+
+#line 110 "./compiler/layout.ae"
+    if (struc->is_union) {
+
+#line 111 "./compiler/layout.ae"
+      used = max(used, field_size);
+    }  else {
+
+#line 113 "./compiler/layout.ae"
+      used += field_size;
+    } 
+  } 
+
+#line 116 "./compiler/layout.ae"
+  return (type_size(struc->type) - used);
+}
+
+
+#line 122 "./compiler/layout.ae"
+static __attribute__((unused)) void print_layout_report(Program *program) {
+
+#line 123 "./compiler/layout.ae"
+  Vector *structs = Vector__new_sized(program->structures->size);
+
+#line 124 "./compiler/layout.ae"
+  for (i32 i = 0; (i < program->structures->size); i += 1) {
+
+#line 125 "./compiler/layout.ae"
+    Structure *struc = ((Structure *)Vector__at(program->structures, i));
+
+#line 126 "./compiler/layout.ae"
+    if ((struc->is_extern || struc->is_enum)) 
+
+#line 126 "./compiler/layout.ae"
+    continue;
+    
+
+#line 127 "./compiler/layout.ae"
+    if ((type_size(struc->type) < 0)) 
+
+#line 127 "./compiler/layout.ae"
+    continue;
+    
+
+#line 129 "./compiler/layout.ae"
+    i32 padding = struct_padding(struc);
+
+#line 130 "./compiler/layout.ae"
+    Vector__push(structs, struc);
+
+#line 131 "./compiler/layout.ae"
+    i32 j = (structs->size - 1);
+
+#line 132 "./compiler/layout.ae"
+    while (((j > 0) && (struct_padding(((Structure *)Vector__at(structs, (j - 1)))) < padding))) {
+
+#line 133 "./compiler/layout.ae"
+      structs->data[j] = structs->data[(j - 1)];
+
+#line 134 "./compiler/layout.ae"
+      j -= 1;
+    } 
+
+#line 136 "./compiler/layout.ae"
+    structs->data[j] = struc;
+  } 
+
+#line 139 "./compiler/layout.ae"
+  printf("%-24s %6s %6s %8s %10s""\n", "struct", "size", "align", "padding", "reordered");
+
+#line 140 "./compiler/layout.ae"
+  for (i32 i = 0; (i < structs->size); i += 1) {
+
+#line 141 "./compiler/layout.ae"
+    Structure *struc = ((Structure *)Vector__at(structs, i));
+
+#line 142 "./compiler/layout.ae"
+    i32 size = type_size(struc->type);
+
+#line 143 "./compiler/layout.ae"
+    i32 reordered = size;
+
+#line 144 "./compiler/layout.ae"
+    if (((!struc->is_union) && (!struc->is_packed))) {
+
+#line 145 "./compiler/layout.ae"
+      reordered = fields_size(struc, sort_fields_by_align(struc->fields));
+    } 
+
+#line 147 "./compiler/layout.ae"
+    char *note = ((size > 64) ? "  (> cache line)" : "");
+
+#line 148 "./compiler/layout.ae"
+    printf("%-24s %6d %6d %8d %10d%s""\n", struc->name, size, type_align(struc->type), struct_padding(struc), reordered, note);
+  } 
+
+#line 151 "./compiler/layout.ae"
+  Vector__free(structs);
+}
+
+
+#line 156 "./compiler/layout.ae"
+static __attribute__((unused)) AST *lvalue_root(AST *node) {
+
+#line 156 "./compiler/layout.ae"
+  return ({ AST *__yield_0;
+
+#line 156 "./compiler/layout.ae"
+  switch (node->type) {
+    case ASTType__Identifier: {
+      __yield_0 = node;
+} break;
+    case ASTType__Member: {
+      __yield_0 = (node->u.member.is_pointer ? NULL : lvalue_root(node->u.member.lhs));
+} break;
+    case ASTType__Index: {
+      __yield_0 = lvalue_root(node->u.binary.lhs);
+} break;
+    default: {
+      __yield_0 = NULL;
+} break;
+  }
+;__yield_0; });
+}
+
+
+#line 173 "./compiler/layout.ae"
+static __attribute__((unused)) BodyEffects *BodyEffects__new(Vector *globals) {
+
+#line 174 "./compiler/layout.ae"
+  BodyEffects *effects = ((BodyEffects *)calloc(1, sizeof(BodyEffects)));
+
+#line 175 "./compiler/layout.ae"
+  effects->globals = globals;
+
+#line 176 "./compiler/layout.ae"
+  effects->mutated = Vector__new();
+
+#line 177 "./compiler/layout.ae"
+  effects->calls = Vector__new();
+
+#line 178 "./compiler/layout.ae"
+  return effects;
+}
+
+
+#line 183 "./compiler/layout.ae"
+static __attribute__((unused)) bool BodyEffects__is_local(BodyEffects *this, AST *node) {
+
+#line 183 "./compiler/layout.ae"
+  return ({ bool __yield_0;
+
+#line 183 "./compiler/layout.ae"
+  switch (node->type) {
+    case ASTType__Identifier: {
+
+#line 185 "./compiler/layout.ae"
+      Variable *var = node->u.ident.var;
+
+#line 186 "./compiler/layout.ae"
+      for (i32 i = 0; (i < this->globals->size); i += 1) {
+
+#line 187 "./compiler/layout.ae"
+        if (Vector__at(this->globals, i) == var) 
+
+#line 187 "./compiler/layout.ae"
+        return false;
+        
+      } 
+
+#line 189 "./compiler/layout.ae"
+      __yield_0 = true;
+    } break;
+    case ASTType__Member: {
+      __yield_0 = ((!node->u.member.is_pointer) && BodyEffects__is_local(this, node->u.member.lhs));
+} break;
+    case ASTType__Index: {
+
+#line 193 "./compiler/layout.ae"
+      AST *lhs = node->u.binary.lhs;
+
+#line 194 "./compiler/layout.ae"
+      __yield_0 = ((lhs->type == ASTType__Identifier && Type__is_array(lhs->u.ident.var->type)) && BodyEffects__is_local(this, lhs));
+    } break;
+    default: {
+      __yield_0 = false;
+} break;
+  }
+;__yield_0; });
+}
+
+
+#line 199 "./compiler/layout.ae"
+static __attribute__((unused)) void BodyEffects__add_call(BodyEffects *this, AST *node) {
+
+#line 200 "./compiler/layout.ae"
+  Function *func = node->u.call.func;
+
+#line 201 "./compiler/layout.ae"
+  if ((!((bool)func))) {
+
+#line 204 "./compiler/layout.ae"
+    if (((!AST__callee_is(node, "print")) && (!AST__callee_is(node, "println")))) {
+
+#line 205 "./compiler/layout.ae"
+      this->writes_memory = true;
+    } 
+  }  else 
+#line 207 "./compiler/layout.ae"
+  if (((bool)func->yield_type)) {
+
+#line 209 "./compiler/layout.ae"
+    this->writes_memory = true;
+  }  else 
+#line 210 "./compiler/layout.ae"
+  if (func->is_extern) {
+
+#line 211 "./compiler/layout.ae"
+    if ((!func->is_pure)) 
+
+#line 211 "./compiler/layout.ae"
+    this->writes_memory = true;
+    
+  }  else {
+
+#line 213 "./compiler/layout.ae"
+    Vector__push(this->calls, func);
+  } 
+  
+  
+}
+
+
+#line 217 "./compiler/layout.ae"
+static __attribute__((unused)) void BodyEffects__free(BodyEffects *this) {
+
+#line 218 "./compiler/layout.ae"
+  Vector__free(this->mutated);
+
+#line 219 "./compiler/layout.ae"
+  Vector__free(this->calls);
+
+#line 220 "./compiler/layout.ae"
+  free(this);
+}
+
+
+#line 225 "./compiler/layout.ae"
+static __attribute__((unused)) void find_effects(AST *node, BodyEffects *effects) {
+
+#line 226 "./compiler/layout.ae"
+  if ((!((bool)node))) 
+
+#line 226 "./compiler/layout.ae"
+  return;
+  
+
+#line 228 "./compiler/layout.ae"
+  AST *written = ((AST *)NULL);
+
+#line 229 "./compiler/layout.ae"
+  switch (node->type) {
+    case ASTType__Block: {
+
+#line 231 "./compiler/layout.ae"
+      Vector *statements = node->u.block.statements;
+
+#line 232 "./compiler/layout.ae"
+      for (i32 i = 0; (i < statements->size); i += 1) {
+
+#line 233 "./compiler/layout.ae"
+        find_effects(Vector__at(statements, i), effects);
+      } 
+    } break;
+    case ASTType__Assignment:
+    case ASTType__PlusEquals:
+    case ASTType__MinusEquals:
+    case ASTType__MultiplyEquals:
+    case ASTType__DivideEquals: {
+
+#line 237 "./compiler/layout.ae"
+      written = node->u.binary.lhs;
+
+#line 238 "./compiler/layout.ae"
+      find_effects(node->u.binary.lhs, effects);
+
+#line 239 "./compiler/layout.ae"
+      find_effects(node->u.binary.rhs, effects);
+    } break;
+    case ASTType__Address: {
+
+#line 242 "./compiler/layout.ae"
+      written = node->u.unary;
+
+#line 243 "./compiler/layout.ae"
+      find_effects(node->u.unary, effects);
+    } break;
+    case ASTType__And:
+    case ASTType__BitwiseAnd:
+    case ASTType__BitwiseOr:
+    case ASTType__BitwiseXor:
+    case ASTType__Divide:
+    case ASTType__Equals:
+    case ASTType__GreaterThan:
+    case ASTType__GreaterThanEquals:
+    case ASTType__Index:
+    case ASTType__LeftShift:
+    case ASTType__LessThan:
+    case ASTType__LessThanEquals:
+    case ASTType__Minus:
+    case ASTType__Modulus:
+    case ASTType__Multiply:
+    case ASTType__NotEquals:
+    case ASTType__Or:
+    case ASTType__Plus:
+    case ASTType__RightShift: {
+
+#line 248 "./compiler/layout.ae"
+      find_effects(node->u.binary.lhs, effects);
+
+#line 249 "./compiler/layout.ae"
+      find_effects(node->u.binary.rhs, effects);
+    } break;
+    case ASTType__Dereference:
+    case ASTType__Not:
+    case ASTType__UnaryMinus:
+    case ASTType__BitwiseNot:
+    case ASTType__IsNotNull:
+    case ASTType__Return:
+    case ASTType__Yield:
+    case ASTType__GeneratorYield:
+    case ASTType__Defer:
+    case ASTType__Scratch: {
+
+#line 252 "./compiler/layout.ae"
+      find_effects(node->u.unary, effects);
+    } break;
+    case ASTType__Call: {
+
+#line 255 "./compiler/layout.ae"
+      BodyEffects__add_call(effects, node);
+
+#line 256 "./compiler/layout.ae"
+      find_effects(node->u.call.callee, effects);
+
+#line 257 "./compiler/layout.ae"
+      Vector *args = node->u.call.args;
+
+#line 258 "./compiler/layout.ae"
+      for (i32 i = 0; (i < args->size); i += 1) {
+
+#line 259 "./compiler/layout.ae"
+        find_effects(((Argument *)Vector__at(args, i))->expr, effects);
+      } 
+    } break;
+    case ASTType__Constructor: {
+
+#line 263 "./compiler/layout.ae"
+      Vector *args = node->u.constructor.args;
+
+#line 264 "./compiler/layout.ae"
+      for (i32 i = 0; (i < args->size); i += 1) {
+
+#line 265 "./compiler/layout.ae"
+        find_effects(((Argument *)Vector__at(args, i))->expr, effects);
+      } 
+    } break;
+    case ASTType__Member: {
+
+#line 268 "./compiler/layout.ae"
+      find_effects(node->u.member.lhs, effects);
+    } break;
+    case ASTType__Cast: {
+
+#line 269 "./compiler/layout.ae"
+      find_effects(node->u.cast.lhs, effects);
+    } break;
+    case ASTType__VarDeclaration: {
+
+#line 270 "./compiler/layout.ae"
+      find_effects(node->u.var_decl.init, effects);
+    } break;
+    case ASTType__FormatStringLiteral: {
+
+#line 272 "./compiler/layout.ae"
+      Vector *exprs = node->u.fmt_str.exprs;
+
+#line 273 "./compiler/layout.ae"
+      for (i32 i = 0; (i < exprs->size); i += 1) {
+
+#line 274 "./compiler/layout.ae"
+        find_effects(Vector__at(exprs, i), effects);
+      } 
+    } break;
+    case ASTType__If: {
+
+#line 278 "./compiler/layout.ae"
+      find_effects(node->u.if_stmt.cond, effects);
+
+#line 279 "./compiler/layout.ae"
+      find_effects(node->u.if_stmt.body, effects);
+
+#line 280 "./compiler/layout.ae"
+      find_effects(node->u.if_stmt.els, effects);
+    } break;
+    case ASTType__While:
+    case ASTType__For: {
+
+#line 283 "./compiler/layout.ae"
+      find_effects(node->u.loop->init, effects);
+
+#line 284 "./compiler/layout.ae"
+      find_effects(node->u.loop->cond, effects);
+
+#line 285 "./compiler/layout.ae"
+      find_effects(node->u.loop->incr, effects);
+
+#line 286 "./compiler/layout.ae"
+      find_effects(node->u.loop->body, effects);
+    } break;
+    case ASTType__ForIn: {
+
+#line 289 "./compiler/layout.ae"
+      find_effects(node->u.for_in->expr, effects);
+
+#line 290 "./compiler/layout.ae"
+      find_effects(node->u.for_in->end, effects);
+
+#line 291 "./compiler/layout.ae"
+      find_effects(node->u.for_in->body, effects);
+    } break;
+    case ASTType__Match: {
+
+#line 294 "./compiler/layout.ae"
+      find_effects(node->u.match_stmt->expr, effects);
+
+#line 295 "./compiler/layout.ae"
+      Vector *cases = node->u.match_stmt->cases;
+
+#line 296 "./compiler/layout.ae"
+      for (i32 i = 0; (i < cases->size); i += 1) {
+
+#line 297 "./compiler/layout.ae"
+        MatchCase *_case = ((MatchCase *)Vector__at(cases, i));
+
+#line 298 "./compiler/layout.ae"
+        find_effects(_case->body, effects);
+      } 
+
+#line 300 "./compiler/layout.ae"
+      find_effects(node->u.match_stmt->defolt, effects);
+    } break;
+    default: {
+    } break;
+  }
+
+#line 305 "./compiler/layout.ae"
+  if ((!((bool)written))) 
+
+#line 305 "./compiler/layout.ae"
+  return;
+  
+
+#line 306 "./compiler/layout.ae"
+  AST *root = lvalue_root(written);
+
+#line 307 "./compiler/layout.ae"
+  if (((bool)root)) 
+
+#line 307 "./compiler/layout.ae"
+  Vector__push(effects->mutated, root->u.ident.var);
+  
+
+#line 308 "./compiler/layout.ae"
+  if (((node->type != ASTType__Address) && (!BodyEffects__is_local(effects, written)))) {
+
+#line 309 "./compiler/layout.ae"
+    effects->writes_memory = true;
+  } 
+}
+
+
+#line 324 "./compiler/layout.ae"
+static __attribute__((unused)) void mark_ref_params(Program *program) {
+
+#line 325 "./compiler/layout.ae"
+  Vector *globals = Vector__new();
+
+#line 326 "./compiler/layout.ae"
+  for (i32 i = 0; (i < program->global_vars->size); i += 1) {
+
+#line 327 "./compiler/layout.ae"
+    AST *decl = ((AST *)Vector__at(program->global_vars, i));
+
+#line 328 "./compiler/layout.ae"
+    Vector__push(globals, decl->u.var_decl.var);
+  } 
+
+#line 331 "./compiler/layout.ae"
+  Vector *all_effects = Vector__new();
+
+#line 332 "./compiler/layout.ae"
+  for (i32 i = 0; (i < program->functions->size); i += 1) {
+
+#line 333 "./compiler/layout.ae"
+    Function *func = ((Function *)Vector__at(program->functions, i));
+
+#line 334 "./compiler/layout.ae"
+    BodyEffects *effects = BodyEffects__new(globals);
+
+#line 335 "./compiler/layout.ae"
+    if (((bool)func->body)) {
+
+#line 336 "./compiler/layout.ae"
+      find_effects(func->body, effects);
+    }  else 
+#line 337 "./compiler/layout.ae"
+    if ((!func->is_pure)) {
+
+#line 338 "./compiler/layout.ae"
+      effects->writes_memory = true;
+    } 
+    
+
+#line 340 "./compiler/layout.ae"
+    func->writes_memory = effects->writes_memory;
+
+#line 341 "./compiler/layout.ae"
+    Vector__push(all_effects, effects);
+  } 
+
+#line 345 "./compiler/layout.ae"
+  bool changed = true;
+
+#line 346 "./compiler/layout.ae"
+  while (changed) {
+
+#line 347 "./compiler/layout.ae"
+    changed = false;
+
+#line 348 "./compiler/layout.ae"
+    for (i32 i = 0; (i < program->functions->size); i += 1) {
+
+#line 349 "./compiler/layout.ae"
+      Function *func = ((Function *)Vector__at(program->functions, i));
+
+#line 350 "./compiler/layout.ae"
+      if (func->writes_memory) 
+
+#line 350 "./compiler/layout.ae"
+      continue;
+      
+
+#line 351 "./compiler/layout.ae"
+      Vector *calls = ((BodyEffects *)Vector__at(all_effects, i))->calls;
+
+#line 352 "./compiler/layout.ae"
+      for (i32 j = 0; (j < calls->size); j += 1) {
+
+#line 353 "./compiler/layout.ae"
+        if (((Function *)Vector__at(calls, j))->writes_memory) {
+
+#line 354 "./compiler/layout.ae"
+          func->writes_memory = true;
+
+#line 355 "./compiler/layout.ae"
+          changed = true;
+
+#line 356 "./compiler/layout.ae"
+          break;
+        } 
+      } 
+    } 
+  } 
+
+#line 362 "./compiler/layout.ae"
+  for (i32 i = 0; (i < program->functions->size); i += 1) {
+
+#line 363 "./compiler/layout.ae"
+    Function *func = ((Function *)Vector__at(program->functions, i));
+
+#line 364 "./compiler/layout.ae"
+    Vector *mutated = ((BodyEffects *)Vector__at(all_effects, i))->mutated;
+
+#line 365 "./compiler/layout.ae"
+    if ((((func->is_extern || func->is_export) || func->is_address_taken) || (!((bool)func->body)))) 
+
+#line 365 "./compiler/layout.ae"
+    continue;
+    
+
+#line 366 "./compiler/layout.ae"
+    if (func->writes_memory) 
+
+#line 366 "./compiler/layout.ae"
+    continue;
+    
+
+#line 368 "./compiler/layout.ae"
+    if (((bool)func->yield_type)) 
+
+#line 368 "./compiler/layout.ae"
+    continue;
+    
+
+#line 369 "./compiler/layout.ae"
+    if (((!func->is_method) && string__eq(func->name, "main"))) 
+
+#line 369 "./compiler/layout.ae"
+    continue;
+    
+
+#line 371 "./compiler/layout.ae"
+    for (i32 j = 0; (j < func->params->size); j += 1) {
+
+#line 372 "./compiler/layout.ae"
+      Variable *param = ((Variable *)Vector__at(func->params, j));
+
+#line 373 "./compiler/layout.ae"
+      if ((!Type__is_struct(param->type))) 
+
+#line 373 "./compiler/layout.ae"
+      continue;
+      
+
+#line 374 "./compiler/layout.ae"
+      if ((type_size(param->type) <= REF_PARAM_THRESHOLD)) 
+
+#line 374 "./compiler/layout.ae"
+      continue;
+      
+
+#line 375 "./compiler/layout.ae"
+      param->by_ref = true;
+
+#line 376 "./compiler/layout.ae"
+      for (i32 k = 0; (k < mutated->size); k += 1) {
+
+#line 377 "./compiler/layout.ae"
+        if (Vector__at(mutated, k) == param) 
+
+#line 377 "./compiler/layout.ae"
+        param->by_ref = false;
+        
+      } 
+    } 
+  } 
+
+#line 382 "./compiler/layout.ae"
+  for (i32 i = 0; (i < all_effects->size); i += 1) {
+
+#line 383 "./compiler/layout.ae"
+    BodyEffects__free(((BodyEffects *)Vector__at(all_effects, i)));
+  } 
+
+#line 385 "./compiler/layout.ae"
+  Vector__free(all_effects);
+
+#line 386 "./compiler/layout.ae"
+  Vector__free(globals);
+}
+
+
+#line 30 "./compiler/codegen.ae"
+static __attribute__((unused)) CodeGenerator CodeGenerator__make(bool debug, bool buffer_stdout, bool release, bool instrument, bool track_alloc) {
+
+#line 33 "./compiler/codegen.ae"
+  return (CodeGenerator){.program = NULL, .out = Buffer__make(), .scopes = Vector__new(), .yield_vars = Vector__new(), .yield_count = 0, .label_count = 0, .scratch_depth = 0, .match_hash_threshold = MATCH_HASH_THRESHOLD, .debug = debug, .buffer_stdout = buffer_stdout, .release = release, .instrument = instrument, .instrumented = Vector__new(), .track_alloc = track_alloc, .generator = NULL, .resume_points = 0};
+}
+
+
+#line 53 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__error(CodeGenerator *this, Error *err) {
+
+#line 54 "./compiler/codegen.ae"
+  Vector__push(this->program->errors, err);
+}
+
+
+#line 57 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_debug_info(CodeGenerator *this, Span span) {
+
+#line 58 "./compiler/codegen.ae"
+  if ((!this->debug)) 
+
+#line 58 "./compiler/codegen.ae"
+  return;
+  
+
+#line 59 "./compiler/codegen.ae"
+  Location loc = span.start;
+
+#line 60 "./compiler/codegen.ae"
+  ({ Buffer *__fmt_buf = (&this->out); Buffer__puts(__fmt_buf, "\n#line "); Buffer__put_i64(__fmt_buf, loc.line); Buffer__puts(__fmt_buf, " \""); Buffer__put_str(__fmt_buf, loc.filename); Buffer__puts(__fmt_buf, "\"\n"); });
+}
+
+
+#line 63 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__indent(CodeGenerator *this, i32 num) {
+
+#line 64 "./compiler/codegen.ae"
+  for (i32 i = 0; (i < num); i += 1) {
+
+#line 65 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), "  ");
+  } 
+}
+
+
+#line 69 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__push_scope(CodeGenerator *this) {
+
+#line 70 "./compiler/codegen.ae"
+  Vector__push(this->scopes, Vector__new());
+}
+
+
+#line 73 "./compiler/codegen.ae"
+static __attribute__((unused)) Vector *CodeGenerator__scope(CodeGenerator *this) {
+
+#line 73 "./compiler/codegen.ae"
+  return Vector__back(this->scopes);
+}
+
+
+#line 75 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__pop_scope(CodeGenerator *this) {
+
+#line 76 "./compiler/codegen.ae"
+  Vector *scope = ((Vector *)Vector__pop(this->scopes));
+
+#line 77 "./compiler/codegen.ae"
+  Vector__free(scope);
+}
+
+
+#line 80 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_control_body(CodeGenerator *this, AST *node, AST *body, i32 indent) {
+
+#line 81 "./compiler/codegen.ae"
+  if (body->type == ASTType__Block) {
+
+#line 82 "./compiler/codegen.ae"
+    CodeGenerator__gen_block(this, body, indent);
+
+#line 83 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), " ");
+  }  else {
+
+#line 86 "./compiler/codegen.ae"
+    if ((body->type != ASTType__If)) {
+
+#line 87 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "\n");
+    } 
+
+#line 90 "./compiler/codegen.ae"
+    if ((((bool)node->etype) && (body->type != ASTType__Yield))) {
+
+#line 91 "./compiler/codegen.ae"
+      CodeGenerator__gen_yield_expression(this, body, (indent + 1));
+    }  else {
+
+#line 93 "./compiler/codegen.ae"
+      CodeGenerator__gen_statement(this, body, indent);
+    } 
+
+#line 95 "./compiler/codegen.ae"
+    CodeGenerator__indent(this, indent);
+  } 
+}
+
+
+#line 99 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_enum_value(CodeGenerator *this, char *enum_name, Variable *var) {
+
+#line 100 "./compiler/codegen.ae"
+  if (var->is_extern) {
+
+#line 101 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), var->extern_name);
+  }  else {
+
+#line 103 "./compiler/codegen.ae"
+    ({ Buffer *__fmt_buf = (&this->out); Buffer__put_str(__fmt_buf, enum_name); Buffer__puts(__fmt_buf, "__"); Buffer__put_str(__fmt_buf, var->name); });
+  } 
+}
+
+
+#line 107 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_enum(CodeGenerator *this, Structure *struc) {
+
+#line 108 "./compiler/codegen.ae"
+  if ((!struc->is_extern)) {
+
+#line 109 "./compiler/codegen.ae"
+    ({ Buffer *__fmt_buf = (&this->out); Buffer__puts(__fmt_buf, "enum "); Buffer__put_str(__fmt_buf, struc->name); Buffer__puts(__fmt_buf, " {\n"); });
+
+#line 110 "./compiler/codegen.ae"
+    for (i32 i = 0; (i < struc->fields->size); i += 1) {
+
+#line 111 "./compiler/codegen.ae"
+      Variable *field = ((Variable *)Vector__at(struc->fields, i));
+
+#line 112 "./compiler/codegen.ae"
+      CodeGenerator__indent(this, 1);
+
+#line 113 "./compiler/codegen.ae"
+      CodeGenerator__gen_enum_value(this, struc->name, field);
+
+#line 114 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), ",\n");
+    } 
+
+#line 116 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), "};\n\n");
+  } 
+
+#line 119 "./compiler/codegen.ae"
+  i32 n = struc->fields->size;
+
+#line 120 "./compiler/codegen.ae"
+  Map *s_methods = ((Map *)Map__get(this->program->methods, struc->name));
+
+#line 123 "./compiler/codegen.ae"
+  ({ Buffer *__fmt_buf = (&this->out); Buffer__puts(__fmt_buf, "static char *__"); Buffer__put_str(__fmt_buf, struc->name); Buffer__puts(__fmt_buf, "_names[] = {"); });
+
+#line 124 "./compiler/codegen.ae"
+  for (i32 i = 0; (i < n); i += 1) {
+
+#line 125 "./compiler/codegen.ae"
+    Variable *field = ((Variable *)Vector__at(struc->fields, i));
+
+#line 126 "./compiler/codegen.ae"
+    if ((i > 0)) 
+
+#line 126 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), ", ");
+    
+
+#line 127 "./compiler/codegen.ae"
+    ({ Buffer *__fmt_buf = (&this->out); Buffer__puts(__fmt_buf, "\""); Buffer__put_str(__fmt_buf, field->name); Buffer__puts(__fmt_buf, "\""); });
+  } 
+
+#line 129 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "};\nstatic ");
+
+#line 130 "./compiler/codegen.ae"
+  CodeGenerator__gen_type(this, struc->type);
+
+#line 131 "./compiler/codegen.ae"
+  ({ Buffer *__fmt_buf = (&this->out); Buffer__puts(__fmt_buf, " __"); Buffer__put_str(__fmt_buf, struc->name); Buffer__puts(__fmt_buf, "_values[] = {"); });
+
+#line 132 "./compiler/codegen.ae"
+  for (i32 i = 0; (i < n); i += 1) {
+
+#line 133 "./compiler/codegen.ae"
+    Variable *field = ((Variable *)Vector__at(struc->fields, i));
+
+#line 134 "./compiler/codegen.ae"
+    if ((i > 0)) 
+
+#line 134 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), ", ");
+    
+
+#line 135 "./compiler/codegen.ae"
+    CodeGenerator__gen_enum_value(this, struc->name, field);
+  } 
+
+#line 137 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "};\n\n");
+
+#line 139 "./compiler/codegen.ae"
+  Function *dbg = ((Function *)Map__get(s_methods, "dbg"));
+
+#line 140 "./compiler/codegen.ae"
+  CodeGenerator__gen_function_decl(this, dbg);
+
+#line 141 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), " {\n");
+
+#line 142 "./compiler/codegen.ae"
+  if (struc->is_extern) {
+
+#line 144 "./compiler/codegen.ae"
+    CodeGenerator__indent(this, 1);
+
+#line 145 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), "switch (this) {\n");
+
+#line 146 "./compiler/codegen.ae"
+    for (i32 i = 0; (i < n); i += 1) {
+
+#line 147 "./compiler/codegen.ae"
+      Variable *field = ((Variable *)Vector__at(struc->fields, i));
+
+#line 148 "./compiler/codegen.ae"
+      CodeGenerator__indent(this, 2);
+
+#line 149 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "case ");
+
+#line 150 "./compiler/codegen.ae"
+      CodeGenerator__gen_enum_value(this, struc->name, field);
+
+#line 151 "./compiler/codegen.ae"
+      ({ Buffer *__fmt_buf = (&this->out); Buffer__puts(__fmt_buf, ": return __"); Buffer__put_str(__fmt_buf, struc->name); Buffer__puts(__fmt_buf, "_names["); Buffer__put_i64(__fmt_buf, i); Buffer__puts(__fmt_buf, "];\n"); });
+    } 
+
+#line 153 "./compiler/codegen.ae"
+    CodeGenerator__indent(this, 1);
+
+#line 154 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), "}\n");
+  }  else {
+
+#line 156 "./compiler/codegen.ae"
+    CodeGenerator__indent(this, 1);
+
+#line 157 "./compiler/codegen.ae"
+    ({ Buffer *__fmt_buf = (&this->out); Buffer__puts(__fmt_buf, "if ((u32)this < "); Buffer__put_i64(__fmt_buf, n); Buffer__puts(__fmt_buf, "u) return __"); Buffer__put_str(__fmt_buf, struc->name); Buffer__puts(__fmt_buf, "_names[this];\n"); });
+  } 
+
+#line 161 "./compiler/codegen.ae"
+  CodeGenerator__indent(this, 1);
+
+#line 162 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "return \"<unknown>\";\n}\n\n");
+
+#line 164 "./compiler/codegen.ae"
+  CodeGenerator__gen_enum_from_str(this, struc, ((Function *)Map__get(s_methods, "from_str")));
+}
+
+
+#line 173 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_enum_from_str(CodeGenerator *this, Structure *struc, Function *func) {
+
+#line 174 "./compiler/codegen.ae"
+  i32 n = struc->fields->size;
+
+#line 175 "./compiler/codegen.ae"
+  i32 size = 1;
+
+#line 176 "./compiler/codegen.ae"
+  while ((size < n)) {
+
+#line 176 "./compiler/codegen.ae"
+    size *= 2;
+  } 
+
+#line 177 "./compiler/codegen.ae"
+  i32 mask = (size - 1);
+
+#line 179 "./compiler/codegen.ae"
+  i32 buckets[n];
+
+#line 180 "./compiler/codegen.ae"
+  i32 bucket_sizes[size];
+
+#line 181 "./compiler/codegen.ae"
+  i32 displace[size];
+
+#line 182 "./compiler/codegen.ae"
+  i32 slots[size];
+
+#line 183 "./compiler/codegen.ae"
+  for (i32 i = 0; (i < size); i += 1) {
+
+#line 184 "./compiler/codegen.ae"
+    bucket_sizes[i] = 0;
+
+#line 185 "./compiler/codegen.ae"
+    displace[i] = 0;
+
+#line 186 "./compiler/codegen.ae"
+    slots[i] = (-1);
+  } 
+
+#line 188 "./compiler/codegen.ae"
+  i32 max_bucket_size = 0;
+
+#line 189 "./compiler/codegen.ae"
+  for (i32 i = 0; (i < n); i += 1) {
+
+#line 190 "./compiler/codegen.ae"
+    Variable *field = ((Variable *)Vector__at(struc->fields, i));
+
+#line 191 "./compiler/codegen.ae"
+    i32 bucket = ((i32)(hash_string(field->name, 0) & ((u32)mask)));
+
+#line 192 "./compiler/codegen.ae"
+    buckets[i] = bucket;
+
+#line 193 "./compiler/codegen.ae"
+    bucket_sizes[bucket] += 1;
+
+#line 194 "./compiler/codegen.ae"
+    max_bucket_size = max(max_bucket_size, bucket_sizes[bucket]);
+  } 
+
+#line 198 "./compiler/codegen.ae"
+  i32 positions[max_bucket_size];
+
+#line 199 "./compiler/codegen.ae"
+  i32 members[max_bucket_size];
+
+#line 200 "./compiler/codegen.ae"
+  for (i32 bucket_size = max_bucket_size; (bucket_size > 1); bucket_size -= 1) {
+
+#line 201 "./compiler/codegen.ae"
+    for (i32 b = 0; (b < size); b += 1) {
+
+#line 202 "./compiler/codegen.ae"
+      if ((bucket_sizes[b] != bucket_size)) 
+
+#line 202 "./compiler/codegen.ae"
+      continue;
+      
+
+#line 204 "./compiler/codegen.ae"
+      i32 count = 0;
+
+#line 205 "./compiler/codegen.ae"
+      for (i32 i = 0; (i < n); i += 1) {
+
+#line 206 "./compiler/codegen.ae"
+        if (buckets[i] == b) {
+
+#line 207 "./compiler/codegen.ae"
+          members[count] = i;
+
+#line 208 "./compiler/codegen.ae"
+          count += 1;
+        } 
+      } 
+
+#line 212 "./compiler/codegen.ae"
+      i32 seed = 1;
+
+#line 213 "./compiler/codegen.ae"
+      while (true) {
+
+#line 214 "./compiler/codegen.ae"
+        bool ok = true;
+
+#line 215 "./compiler/codegen.ae"
+        for (i32 j = 0; ((j < count) && ok); j += 1) {
+
+#line 216 "./compiler/codegen.ae"
+          Variable *field = ((Variable *)Vector__at(struc->fields, members[j]));
+
+#line 217 "./compiler/codegen.ae"
+          i32 pos = ((i32)(hash_string(field->name, ((u32)seed)) & ((u32)mask)));
+
+#line 218 "./compiler/codegen.ae"
+          if ((slots[pos] >= 0)) 
+
+#line 218 "./compiler/codegen.ae"
+          ok = false;
+          
+
+#line 219 "./compiler/codegen.ae"
+          for (i32 k = 0; ((k < j) && ok); k += 1) {
+
+#line 220 "./compiler/codegen.ae"
+            if (positions[k] == pos) 
+
+#line 220 "./compiler/codegen.ae"
+            ok = false;
+            
+          } 
+
+#line 222 "./compiler/codegen.ae"
+          positions[j] = pos;
+        } 
+
+#line 224 "./compiler/codegen.ae"
+        if (ok) 
+
+#line 224 "./compiler/codegen.ae"
+        break;
+        
+
+#line 225 "./compiler/codegen.ae"
+        seed += 1;
+      } 
+
+#line 228 "./compiler/codegen.ae"
+      displace[b] = seed;
+
+#line 229 "./compiler/codegen.ae"
+      for (i32 j = 0; (j < count); j += 1) {
+
+#line 230 "./compiler/codegen.ae"
+        slots[positions[j]] = members[j];
+      } 
+    } 
+  } 
+
+#line 235 "./compiler/codegen.ae"
+  i32 free_slot = 0;
+
+#line 236 "./compiler/codegen.ae"
+  for (i32 i = 0; (i < n); i += 1) {
+
+#line 237 "./compiler/codegen.ae"
+    if ((bucket_sizes[buckets[i]] != 1)) 
+
+#line 237 "./compiler/codegen.ae"
+    continue;
+    
+
+#line 238 "./compiler/codegen.ae"
+    while ((slots[free_slot] >= 0)) {
+
+#line 238 "./compiler/codegen.ae"
+      free_slot += 1;
+    } 
+
+#line 239 "./compiler/codegen.ae"
+    slots[free_slot] = i;
+
+#line 240 "./compiler/codegen.ae"
+    displace[buckets[i]] = ((-free_slot) - 1);
+  } 
+
+#line 243 "./compiler/codegen.ae"
+  ({ Buffer *__fmt_buf = (&this->out); Buffer__puts(__fmt_buf, "static i32 __"); Buffer__put_str(__fmt_buf, struc->name); Buffer__puts(__fmt_buf, "_displace[] = {"); });
+
+#line 244 "./compiler/codegen.ae"
+  for (i32 i = 0; (i < size); i += 1) {
+
+#line 245 "./compiler/codegen.ae"
+    if ((i > 0)) 
+
+#line 245 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), ", ");
+    
+
+#line 246 "./compiler/codegen.ae"
+    ({ Buffer *__fmt_buf = (&this->out); Buffer__put_i64(__fmt_buf, displace[i]); });
+  } 
+
+#line 248 "./compiler/codegen.ae"
+  ({ Buffer *__fmt_buf = (&this->out); Buffer__puts(__fmt_buf, "};\nstatic i32 __"); Buffer__put_str(__fmt_buf, struc->name); Buffer__puts(__fmt_buf, "_slots[] = {"); });
+
+#line 249 "./compiler/codegen.ae"
+  for (i32 i = 0; (i < size); i += 1) {
+
+#line 250 "./compiler/codegen.ae"
+    if ((i > 0)) 
+
+#line 250 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), ", ");
+    
+
+#line 251 "./compiler/codegen.ae"
+    ({ Buffer *__fmt_buf = (&this->out); Buffer__put_i64(__fmt_buf, slots[i]); });
+  } 
+
+#line 253 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "};\n\n");
+
+#line 255 "./compiler/codegen.ae"
+  CodeGenerator__gen_function_decl(this, func);
+
+#line 256 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), " {\n");
+
+#line 257 "./compiler/codegen.ae"
+  if (n == 0) {
+
+#line 258 "./compiler/codegen.ae"
+    CodeGenerator__indent(this, 1);
+
+#line 259 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), "return NULL;\n}\n\n");
+
+#line 260 "./compiler/codegen.ae"
+    return;
+  } 
+
+#line 262 "./compiler/codegen.ae"
+  char *prefix = format_string("__%s", struc->name);
+
+#line 263 "./compiler/codegen.ae"
+  CodeGenerator__indent(this, 1);
+
+#line 264 "./compiler/codegen.ae"
+  ({ Buffer *__fmt_buf = (&this->out); Buffer__puts(__fmt_buf, "i32 d = "); Buffer__put_str(__fmt_buf, prefix); Buffer__puts(__fmt_buf, "_displace[aecor_hash_str(s, 0) & "); Buffer__put_i64(__fmt_buf, mask); Buffer__puts(__fmt_buf, "u];\n"); });
+
+#line 265 "./compiler/codegen.ae"
+  CodeGenerator__indent(this, 1);
+
+#line 266 "./compiler/codegen.ae"
+  ({ Buffer *__fmt_buf = (&this->out); Buffer__puts(__fmt_buf, "i32 i = "); Buffer__put_str(__fmt_buf, prefix); Buffer__puts(__fmt_buf, "_slots[d < 0 ? -d - 1 : aecor_hash_str(s, d) & "); Buffer__put_i64(__fmt_buf, mask); Buffer__puts(__fmt_buf, "u];\n"); });
+
+#line 267 "./compiler/codegen.ae"
+  CodeGenerator__indent(this, 1);
+
+#line 268 "./compiler/codegen.ae"
+  ({ Buffer *__fmt_buf = (&this->out); Buffer__puts(__fmt_buf, "if (i < 0 || strcmp(s, "); Buffer__put_str(__fmt_buf, prefix); Buffer__puts(__fmt_buf, "_names[i])) return NULL;\n"); });
+
+#line 269 "./compiler/codegen.ae"
+  CodeGenerator__indent(this, 1);
+
+#line 270 "./compiler/codegen.ae"
+  ({ Buffer *__fmt_buf = (&this->out); Buffer__puts(__fmt_buf, "return &"); Buffer__put_str(__fmt_buf, prefix); Buffer__puts(__fmt_buf, "_values[i];\n}\n\n"); });
+}
+
+
+#line 273 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_struct(CodeGenerator *this, Structure *struc) {
+
+#line 274 "./compiler/codegen.ae"
+  if ((!struc->is_extern)) {
+
+#line 275 "./compiler/codegen.ae"
+    char *name = struc->type->name;
+
+#line 276 "./compiler/codegen.ae"
+    if (struc->is_union) {
+
+#line 277 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "union ");
+    }  else {
+
+#line 279 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "struct ");
+    } 
+
+#line 281 "./compiler/codegen.ae"
+    if (struc->is_packed) {
+
+#line 282 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "__attribute__((packed)) ");
+    } 
+
+#line 284 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), name);
+
+#line 285 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), " {\n");
+
+#line 286 "./compiler/codegen.ae"
+    Vector *fields = layout_fields(struc);
+
+#line 287 "./compiler/codegen.ae"
+    for (i32 i = 0; (i < fields->size); i += 1) {
+
+#line 288 "./compiler/codegen.ae"
+      Variable *field = ((Variable *)Vector__at(fields, i));
+
+#line 289 "./compiler/codegen.ae"
+      CodeGenerator__indent(this, 1);
+
+#line 290 "./compiler/codegen.ae"
+      CodeGenerator__gen_type_and_name(this, field->type, field->name);
+
+#line 291 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), ";\n");
+    } 
+
+#line 293 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), "};\n\n");
+  } 
+}
+
+
+#line 300 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_generator_frame(CodeGenerator *this, Structure *struc, Map *done) {
+
+#line 301 "./compiler/codegen.ae"
+  if (Map__exists(done, struc->name)) 
+
+#line 301 "./compiler/codegen.ae"
+  return;
+  
+
+#line 302 "./compiler/codegen.ae"
+  Map__insert(done, struc->name, struc);
+
+#line 304 "./compiler/codegen.ae"
+  Function *func = struc->generator;
+
+#line 305 "./compiler/codegen.ae"
+  for (i32 i = 0; (i < func->frame_vars->size); i += 1) {
+
+#line 306 "./compiler/codegen.ae"
+    Variable *var = ((Variable *)Vector__at(func->frame_vars, i));
+
+#line 307 "./compiler/codegen.ae"
+    Structure *dep = var->type->struct_def;
+
+#line 308 "./compiler/codegen.ae"
+    if (((var->type->base == BaseType__Structure && ((bool)dep)) && ((bool)dep->generator))) {
+
+#line 309 "./compiler/codegen.ae"
+      CodeGenerator__gen_generator_frame(this, dep, done);
+    } 
+  } 
+
+#line 313 "./compiler/codegen.ae"
+  ({ Buffer *__fmt_buf = (&this->out); Buffer__puts(__fmt_buf, "struct "); Buffer__put_str(__fmt_buf, struc->name); Buffer__puts(__fmt_buf, " {\n"); });
+
+#line 314 "./compiler/codegen.ae"
+  CodeGenerator__indent(this, 1);
+
+#line 315 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "i32 __state;\n");
+
+#line 316 "./compiler/codegen.ae"
+  CodeGenerator__indent(this, 1);
+
+#line 317 "./compiler/codegen.ae"
+  CodeGenerator__gen_type_and_name(this, func->yield_type, "value");
+
+#line 318 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), ";\n");
+
+#line 319 "./compiler/codegen.ae"
+  for (i32 i = 0; (i < func->frame_vars->size); i += 1) {
+
+#line 320 "./compiler/codegen.ae"
+    Variable *var = ((Variable *)Vector__at(func->frame_vars, i));
+
+#line 321 "./compiler/codegen.ae"
+    CodeGenerator__indent(this, 1);
+
+#line 322 "./compiler/codegen.ae"
+    CodeGenerator__gen_type_and_name(this, var->type, var->frame_name);
+
+#line 323 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), ";\n");
+  } 
+
+#line 325 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "};\n\n");
+}
+
+
+#line 329 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_format_string_part(CodeGenerator *this, char *part, bool for_printf) {
+
+#line 330 "./compiler/codegen.ae"
+  i32 len = strlen(part);
+
+#line 331 "./compiler/codegen.ae"
+  for (i32 i = 0; (i < len); i += 1) {
+
+#line 332 "./compiler/codegen.ae"
+    if (part[i] == '\\') {
+
+#line 334 "./compiler/codegen.ae"
+      i += 1;
+
+#line 335 "./compiler/codegen.ae"
+      switch (part[i]) {
+        case '`':
+        case '{':
+        case '}': {
+        } break;
+        default: {
+
+#line 339 "./compiler/codegen.ae"
+          Buffer__putc((&this->out), '\\');
+        } break;
+      }
+    }  else 
+#line 341 "./compiler/codegen.ae"
+    if (part[i] == '"') {
+
+#line 343 "./compiler/codegen.ae"
+      Buffer__putc((&this->out), '\\');
+    }  else 
+#line 344 "./compiler/codegen.ae"
+    if ((for_printf && part[i] == '%')) {
+
+#line 346 "./compiler/codegen.ae"
+      Buffer__putc((&this->out), '%');
+    } 
+    
+    
+
+#line 348 "./compiler/codegen.ae"
+    Buffer__putc((&this->out), part[i]);
+  } 
+}
+
+
+#line 352 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_format_string_variadic(CodeGenerator *this, AST *node, bool newline_after) {
+
+#line 353 "./compiler/codegen.ae"
+  Vector *parts = node->u.fmt_str.parts;
+
+#line 354 "./compiler/codegen.ae"
+  Vector *exprs = node->u.fmt_str.exprs;
+
+#line 355 "./compiler/codegen.ae"
+  Vector *specs = node->u.fmt_str.specs;
+
+#line 357 "./compiler/codegen.ae"
+  Buffer__putc((&this->out), '"');
+
+#line 358 "./compiler/codegen.ae"
+  for (i32 i = 0; (i < exprs->size); i += 1) {
+
+#line 359 "./compiler/codegen.ae"
+    char *part = ((char *)Vector__at(parts, i));
+
+#line 360 "./compiler/codegen.ae"
+    CodeGenerator__gen_format_string_part(this, part, true);
+
+#line 362 "./compiler/codegen.ae"
+    char *spec = ((char *)Vector__at(specs, i));
+
+#line 363 "./compiler/codegen.ae"
+    if (((bool)spec)) {
+
+#line 364 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "%");
+
+#line 365 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), spec);
+
+#line 366 "./compiler/codegen.ae"
+      continue;
+    } 
+
+#line 369 "./compiler/codegen.ae"
+    AST *expr = ((AST *)Vector__at(exprs, i));
+
+#line 370 "./compiler/codegen.ae"
+    Type *expr_type = expr->etype;
+
+#line 371 "./compiler/codegen.ae"
+    switch (expr_type->base) {
+      case BaseType__I8:
+      case BaseType__I16:
+      case BaseType__I32: {
+
+#line 372 "./compiler/codegen.ae"
+        Buffer__puts((&this->out), "%d");
+      } break;
+      case BaseType__U8:
+      case BaseType__U16:
+      case BaseType__U32: {
+
+#line 373 "./compiler/codegen.ae"
+        Buffer__puts((&this->out), "%u");
+      } break;
+      case BaseType__I64: {
+
+#line 374 "./compiler/codegen.ae"
+        Buffer__puts((&this->out), "%lld");
+      } break;
+      case BaseType__U64: {
+
+#line 375 "./compiler/codegen.ae"
+        Buffer__puts((&this->out), "%llu");
+      } break;
+      case BaseType__Bool: {
+
+#line 376 "./compiler/codegen.ae"
+        Buffer__puts((&this->out), "%s");
+      } break;
+      case BaseType__F32:
+      case BaseType__F64: {
+
+#line 377 "./compiler/codegen.ae"
+        Buffer__puts((&this->out), "%f");
+      } break;
+      case BaseType__Char: {
+
+#line 378 "./compiler/codegen.ae"
+        Buffer__puts((&this->out), "%c");
+      } break;
+      case BaseType__Pointer: {
+
+#line 379 "./compiler/codegen.ae"
+        switch (expr_type->ptr->base) {
+          case BaseType__Char: {
+
+#line 380 "./compiler/codegen.ae"
+            Buffer__puts((&this->out), "%s");
+          } break;
+          default: {
+
+#line 381 "./compiler/codegen.ae"
+            Buffer__puts((&this->out), "%p");
+          } break;
+        }
+      } break;
+      default: {
+
+#line 385 "./compiler/codegen.ae"
+        panic("Unsupported format string expression type");
+
+#line 386 "./compiler/codegen.ae"
+        Buffer__puts((&this->out), "%s");
+      } break;
+    }
+  } 
+
+#line 391 "./compiler/codegen.ae"
+  char *part = ((char *)Vector__back(parts));
+
+#line 392 "./compiler/codegen.ae"
+  CodeGenerator__gen_format_string_part(this, part, true);
+
+#line 393 "./compiler/codegen.ae"
+  if (newline_after) 
+
+#line 393 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "\\n");
+  
+
+#line 394 "./compiler/codegen.ae"
+  Buffer__putc((&this->out), '"');
+
+#line 396 "./compiler/codegen.ae"
+  for (i32 i = 0; (i < exprs->size); i += 1) {
+
+#line 397 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), ", ");
+
+#line 398 "./compiler/codegen.ae"
+    AST *expr = ((AST *)Vector__at(exprs, i));
+
+#line 399 "./compiler/codegen.ae"
+    char *spec = ((char *)Vector__at(specs, i));
+
+#line 400 "./compiler/codegen.ae"
+    if (((!((bool)spec)) && expr->etype->base == BaseType__Bool)) {
+
+#line 401 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "((");
+
+#line 402 "./compiler/codegen.ae"
+      CodeGenerator__gen_expression(this, expr);
+
+#line 403 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), ") ? \"true\" : \"false\")");
+    }  else {
+
+#line 405 "./compiler/codegen.ae"
+      CodeGenerator__gen_expression(this, expr);
+    } 
+  } 
+}
+
+
+#line 415 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_format_string_appends(CodeGenerator *this, AST *node, char *prefix, char *target) {
+
+#line 416 "./compiler/codegen.ae"
+  Vector *parts = node->u.fmt_str.parts;
+
+#line 417 "./compiler/codegen.ae"
+  Vector *exprs = node->u.fmt_str.exprs;
+
+#line 418 "./compiler/codegen.ae"
+  Vector *specs = node->u.fmt_str.specs;
+
+#line 420 "./compiler/codegen.ae"
+  for (i32 i = 0; (i < parts->size); i += 1) {
+
+#line 421 "./compiler/codegen.ae"
+    char *part = ((char *)Vector__at(parts, i));
+
+#line 422 "./compiler/codegen.ae"
+    if ((strlen(part) > 0)) {
+
+#line 423 "./compiler/codegen.ae"
+      ({ Buffer *__fmt_buf = (&this->out); Buffer__put_str(__fmt_buf, prefix); Buffer__puts(__fmt_buf, "puts("); });
+
+#line 424 "./compiler/codegen.ae"
+      if (((bool)target)) 
+
+#line 424 "./compiler/codegen.ae"
+      ({ Buffer *__fmt_buf = (&this->out); Buffer__put_str(__fmt_buf, target); Buffer__puts(__fmt_buf, ", "); });
+      
+
+#line 425 "./compiler/codegen.ae"
+      Buffer__putc((&this->out), '"');
+
+#line 426 "./compiler/codegen.ae"
+      CodeGenerator__gen_format_string_part(this, part, false);
+
+#line 427 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "\"); ");
+    } 
+
+#line 429 "./compiler/codegen.ae"
+    if (i == exprs->size) 
+
+#line 429 "./compiler/codegen.ae"
+    break;
+    
+
+#line 431 "./compiler/codegen.ae"
+    AST *expr = ((AST *)Vector__at(exprs, i));
+
+#line 432 "./compiler/codegen.ae"
+    char *spec = ((char *)Vector__at(specs, i));
+
+#line 433 "./compiler/codegen.ae"
+    if (((bool)spec)) {
+
+#line 436 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "{ char __fmt_stack[64]; char *__fmt_str = format_string_into(__fmt_stack, 64, \"%");
+
+#line 437 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), spec);
+
+#line 438 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "\", ");
+
+#line 439 "./compiler/codegen.ae"
+      CodeGenerator__gen_expression(this, expr);
+
+#line 440 "./compiler/codegen.ae"
+      ({ Buffer *__fmt_buf = (&this->out); Buffer__puts(__fmt_buf, "); "); Buffer__put_str(__fmt_buf, prefix); Buffer__puts(__fmt_buf, "puts("); });
+
+#line 441 "./compiler/codegen.ae"
+      if (((bool)target)) 
+
+#line 441 "./compiler/codegen.ae"
+      ({ Buffer *__fmt_buf = (&this->out); Buffer__put_str(__fmt_buf, target); Buffer__puts(__fmt_buf, ", "); });
+      
+
+#line 442 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "__fmt_str); if (__fmt_str != __fmt_stack) free(__fmt_str); } ");
+
+#line 443 "./compiler/codegen.ae"
+      continue;
+    } 
+
+#line 446 "./compiler/codegen.ae"
+    Type *expr_type = expr->etype;
+
+#line 447 "./compiler/codegen.ae"
+    char *method = ({ char *__yield_0;
+
+#line 447 "./compiler/codegen.ae"
+  switch (expr_type->base) {
+    case BaseType__I8:
+    case BaseType__I16:
+    case BaseType__I32:
+    case BaseType__I64: {
+      __yield_0 = "put_i64";
+} break;
+    case BaseType__U8:
+    case BaseType__U16:
+    case BaseType__U32:
+    case BaseType__U64: {
+      __yield_0 = "put_u64";
+} break;
+    case BaseType__F32:
+    case BaseType__F64: {
+      __yield_0 = "put_f64";
+} break;
+    case BaseType__Bool: {
+      __yield_0 = "puts";
+} break;
+    case BaseType__Char: {
+      __yield_0 = "putc";
+} break;
+    case BaseType__Pointer: {
+      __yield_0 = ({ char *__yield_1;
+
+#line 453 "./compiler/codegen.ae"
+  switch (expr_type->ptr->base) {
+    case BaseType__Char: {
+      __yield_1 = "put_str";
+} break;
+    default: {
+      __yield_1 = "put_ptr";
+} break;
+  }
+;__yield_1; });
+} break;
+    default: panic("Unsupported format string expression type"); break;
+  }
+;__yield_0; });
+
+#line 459 "./compiler/codegen.ae"
+    ({ Buffer *__fmt_buf = (&this->out); Buffer__put_str(__fmt_buf, prefix); Buffer__put_str(__fmt_buf, method); Buffer__puts(__fmt_buf, "("); });
+
+#line 460 "./compiler/codegen.ae"
+    if (((bool)target)) 
+
+#line 460 "./compiler/codegen.ae"
+    ({ Buffer *__fmt_buf = (&this->out); Buffer__put_str(__fmt_buf, target); Buffer__puts(__fmt_buf, ", "); });
+    
+
+#line 461 "./compiler/codegen.ae"
+    if (expr_type->base == BaseType__Bool) {
+
+#line 462 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "(");
+
+#line 463 "./compiler/codegen.ae"
+      CodeGenerator__gen_expression(this, expr);
+
+#line 464 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), ") ? \"true\" : \"false\"");
+    }  else {
+
+#line 466 "./compiler/codegen.ae"
+      CodeGenerator__gen_expression(this, expr);
+    } 
+
+#line 468 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), "); ");
+  } 
+}
+
+
+#line 475 "./compiler/codegen.ae"
+static __attribute__((unused)) bool CodeGenerator__is_specialized_putsf(CodeGenerator *this, AST *node) {
+
+#line 476 "./compiler/codegen.ae"
+  Function *func = node->u.call.func;
+
+#line 477 "./compiler/codegen.ae"
+  if (((!((bool)func)) || (!func->is_method))) 
+
+#line 477 "./compiler/codegen.ae"
+  return false;
+  
+
+#line 478 "./compiler/codegen.ae"
+  if (((!string__eq(func->method_struct_name, "Buffer")) || (!string__eq(func->name, "putsf")))) 
+
+#line 478 "./compiler/codegen.ae"
+  return false;
+  
+
+#line 480 "./compiler/codegen.ae"
+  Vector *args = node->u.call.args;
+
+#line 481 "./compiler/codegen.ae"
+  if ((args->size != 2)) 
+
+#line 481 "./compiler/codegen.ae"
+  return false;
+  
+
+#line 482 "./compiler/codegen.ae"
+  Argument *arg = ((Argument *)Vector__at(args, 1));
+
+#line 483 "./compiler/codegen.ae"
+  return arg->expr->type == ASTType__FormatStringLiteral;
+}
+
+
+#line 486 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_specialized_putsf(CodeGenerator *this, AST *node) {
+
+#line 487 "./compiler/codegen.ae"
+  Vector *args = node->u.call.args;
+
+#line 488 "./compiler/codegen.ae"
+  Argument *buf = ((Argument *)Vector__at(args, 0));
+
+#line 489 "./compiler/codegen.ae"
+  Argument *str = ((Argument *)Vector__at(args, 1));
+
+#line 491 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "({ ");
+
+#line 492 "./compiler/codegen.ae"
+  CodeGenerator__gen_type_and_name(this, buf->expr->etype, "__fmt_buf");
+
+#line 493 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), " = ");
+
+#line 494 "./compiler/codegen.ae"
+  CodeGenerator__gen_expression(this, buf->expr);
+
+#line 495 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "; ");
+
+#line 496 "./compiler/codegen.ae"
+  CodeGenerator__gen_format_string_appends(this, str->expr, "Buffer__", "__fmt_buf");
+
+#line 497 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "})");
+}
+
+
+#line 500 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_format_string(CodeGenerator *this, AST *node) {
+
+#line 502 "./compiler/codegen.ae"
+  if ((this->scratch_depth > 0)) {
+
+#line 503 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), "format_string_scratch(");
+  }  else 
+#line 504 "./compiler/codegen.ae"
+  if (this->track_alloc) {
+
+#line 505 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), "({ ");
+
+#line 506 "./compiler/codegen.ae"
+    CodeGenerator__gen_alloc_site(this, node->span);
+
+#line 507 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), "aecor_alloc_format_site = &__aecor_site; format_string(");
+
+#line 508 "./compiler/codegen.ae"
+    CodeGenerator__gen_format_string_variadic(this, node, false);
+
+#line 509 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), "); })");
+
+#line 510 "./compiler/codegen.ae"
+    return;
+  }  else {
+
+#line 512 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), "format_string(");
+  } 
+  
+
+#line 514 "./compiler/codegen.ae"
+  CodeGenerator__gen_format_string_variadic(this, node, false);
+
+#line 515 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), ")");
+}
+
+
+#line 518 "./compiler/codegen.ae"
+static __attribute__((unused)) char *CodeGenerator__get_op(ASTType type) {
+
+#line 518 "./compiler/codegen.ae"
+  return ({ char *__yield_0;
+
+#line 518 "./compiler/codegen.ae"
+  switch (type) {
+    case ASTType__Address: {
+      __yield_0 = "&";
+} break;
+    case ASTType__And: {
+      __yield_0 = " && ";
+} break;
+    case ASTType__Assignment: {
+      __yield_0 = " = ";
+} break;
+    case ASTType__BitwiseAnd: {
+      __yield_0 = " & ";
+} break;
+    case ASTType__BitwiseNot: {
+      __yield_0 = "~";
+} break;
+    case ASTType__BitwiseOr: {
+      __yield_0 = " | ";
+} break;
+    case ASTType__BitwiseXor: {
+      __yield_0 = " ^ ";
+} break;
+    case ASTType__Dereference: {
+      __yield_0 = "*";
+} break;
+    case ASTType__Divide: {
+      __yield_0 = " / ";
+} break;
+    case ASTType__DivideEquals: {
+      __yield_0 = " /= ";
+} break;
+    case ASTType__Equals: {
+      __yield_0 = " == ";
+} break;
+    case ASTType__GreaterThan: {
+      __yield_0 = " > ";
+} break;
+    case ASTType__GreaterThanEquals: {
+      __yield_0 = " >= ";
+} break;
+    case ASTType__LeftShift: {
+      __yield_0 = " << ";
+} break;
+    case ASTType__LessThan: {
+      __yield_0 = " < ";
+} break;
+    case ASTType__LessThanEquals: {
+      __yield_0 = " <= ";
+} break;
+    case ASTType__Minus: {
+      __yield_0 = " - ";
+} break;
+    case ASTType__MinusEquals: {
+      __yield_0 = " -= ";
+} break;
+    case ASTType__Modulus: {
+      __yield_0 = " % ";
+} break;
+    case ASTType__Multiply: {
+      __yield_0 = " * ";
+} break;
+    case ASTType__MultiplyEquals: {
+      __yield_0 = " *= ";
+} break;
+    case ASTType__Not: {
+      __yield_0 = "!";
+} break;
+    case ASTType__NotEquals: {
+      __yield_0 = " != ";
+} break;
+    case ASTType__Or: {
+      __yield_0 = " || ";
+} break;
+    case ASTType__Plus: {
+      __yield_0 = " + ";
+} break;
+    case ASTType__PlusEquals: {
+      __yield_0 = " += ";
+} break;
+    case ASTType__RightShift: {
+      __yield_0 = " >> ";
+} break;
+    case ASTType__UnaryMinus: {
+      __yield_0 = "-";
+} break;
+    default: panic(format_string("Unknown op type in get_op: %s", ASTType__dbg(type))); break;
+  }
+;__yield_0; });
+}
+
+
+#line 550 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_in_yield_context(CodeGenerator *this, AST *node) {
+
+#line 552 "./compiler/codegen.ae"
+  char *yield_var = format_string("__yield_%d", this->yield_count);
+
+#line 553 "./compiler/codegen.ae"
+  this->yield_count += 1;
+
+#line 554 "./compiler/codegen.ae"
+  Vector__push(this->yield_vars, yield_var);
+
+#line 556 "./compiler/codegen.ae"
+  Type *ret_type = node->etype;
+
+#line 558 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "({ ");
+
+#line 559 "./compiler/codegen.ae"
+  CodeGenerator__gen_type_and_name(this, ret_type, yield_var);
+
+#line 560 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), ";\n");
+
+#line 565 "./compiler/codegen.ae"
+  CodeGenerator__gen_statement(this, node, 1);
+
+#line 567 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), ";");
+
+#line 568 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), yield_var);
+
+#line 569 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "; })");
+
+#line 571 "./compiler/codegen.ae"
+  this->yield_count -= 1;
+
+#line 572 "./compiler/codegen.ae"
+  Vector__pop(this->yield_vars);
+}
+
+
+#line 575 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_internal_print(CodeGenerator *this, AST *node) {
+
+#line 576 "./compiler/codegen.ae"
+  bool newline_after = AST__callee_is(node, "println");
+
+#line 578 "./compiler/codegen.ae"
+  Vector *args = node->u.call.args;
+
+#line 579 "./compiler/codegen.ae"
+  if ((args->size < 1)) {
+
+#line 580 "./compiler/codegen.ae"
+    CodeGenerator__error(this, Error__new(node->span, "Function requires at least one argument"));
+  } 
+
+#line 584 "./compiler/codegen.ae"
+  Argument *first = ((Argument *)Vector__at(args, 0));
+
+#line 586 "./compiler/codegen.ae"
+  if (this->buffer_stdout) {
+
+#line 587 "./compiler/codegen.ae"
+    if ((args->size == 1 && first->expr->type == ASTType__FormatStringLiteral)) {
+
+#line 589 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "({ aecor_stdout_line __line; aecor_stdout_line_init(&__line); ");
+
+#line 590 "./compiler/codegen.ae"
+      CodeGenerator__gen_format_string_appends(this, first->expr, "aecor_stdout_", "&__line");
+
+#line 591 "./compiler/codegen.ae"
+      if (newline_after) 
+
+#line 591 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "aecor_stdout_putc(&__line, '\\n'); ");
+      
+
+#line 592 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "aecor_stdout_line_finish(&__line); })");
+
+#line 593 "./compiler/codegen.ae"
+      return;
+    } 
+
+#line 595 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), "aecor_stdout_printf(");
+  }  else {
+
+#line 597 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), "printf(");
+  } 
+
+#line 600 "./compiler/codegen.ae"
+  if ((args->size == 1 && first->expr->type == ASTType__FormatStringLiteral)) {
+
+#line 601 "./compiler/codegen.ae"
+    CodeGenerator__gen_format_string_variadic(this, first->expr, newline_after);
+  }  else {
+
+#line 603 "./compiler/codegen.ae"
+    for (i32 i = 0; (i < args->size); i += 1) {
+
+#line 604 "./compiler/codegen.ae"
+      if ((i > 0)) 
+
+#line 604 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), ", ");
+      
+
+#line 605 "./compiler/codegen.ae"
+      Argument *arg = ((Argument *)Vector__at(args, i));
+
+#line 606 "./compiler/codegen.ae"
+      CodeGenerator__gen_expression(this, arg->expr);
+
+#line 607 "./compiler/codegen.ae"
+      if ((i == 0 && newline_after)) 
+
+#line 607 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "\"\\n\"");
+      
+    } 
+  } 
+
+#line 611 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), ")");
+}
+
+
+#line 614 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_debug_assert(CodeGenerator *this, AST *node) {
+
+#line 616 "./compiler/codegen.ae"
+  if (this->release) {
+
+#line 617 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), "((void)0)");
+
+#line 618 "./compiler/codegen.ae"
+    return;
+  } 
+
+#line 620 "./compiler/codegen.ae"
+  Vector *args = node->u.call.args;
+
+#line 621 "./compiler/codegen.ae"
+  Argument *cond = ((Argument *)Vector__at(args, 0));
+
+#line 622 "./compiler/codegen.ae"
+  Argument *msg = ((Argument *)Vector__at(args, 1));
+
+#line 623 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "(__builtin_expect(!!(");
+
+#line 624 "./compiler/codegen.ae"
+  CodeGenerator__gen_expression(this, cond->expr);
+
+#line 625 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "), 1) ? (void)0 : panic(");
+
+#line 626 "./compiler/codegen.ae"
+  CodeGenerator__gen_expression(this, msg->expr);
+
+#line 627 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "))");
+}
+
+
+#line 632 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_simd_operand(CodeGenerator *this, AST *node, Type *type) {
+
+#line 633 "./compiler/codegen.ae"
+  if ((((!((bool)type)) || (!Type__is_simd(type))) || Type__is_simd(node->etype))) {
+
+#line 634 "./compiler/codegen.ae"
+    CodeGenerator__gen_expression(this, node);
+
+#line 635 "./compiler/codegen.ae"
+    return;
+  } 
+
+#line 637 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "((");
+
+#line 638 "./compiler/codegen.ae"
+  CodeGenerator__gen_type(this, type->ptr);
+
+#line 639 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), ")");
+
+#line 640 "./compiler/codegen.ae"
+  CodeGenerator__gen_expression(this, node);
+
+#line 641 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), ")");
+}
+
+
+#line 644 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_simd_constructor(CodeGenerator *this, AST *node) {
+
+#line 645 "./compiler/codegen.ae"
+  Type *type = node->etype;
+
+#line 646 "./compiler/codegen.ae"
+  Vector *args = node->u.constructor.args;
+
+#line 647 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "((");
+
+#line 648 "./compiler/codegen.ae"
+  CodeGenerator__gen_type(this, type);
+
+#line 649 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), ")");
+
+#line 652 "./compiler/codegen.ae"
+  if (args->size == 1) {
+
+#line 653 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), "{0} + ");
+
+#line 654 "./compiler/codegen.ae"
+    CodeGenerator__gen_simd_operand(this, ((Argument *)Vector__at(args, 0))->expr, type);
+
+#line 655 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), ")");
+
+#line 656 "./compiler/codegen.ae"
+    return;
+  } 
+
+#line 658 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "{");
+
+#line 659 "./compiler/codegen.ae"
+  for (i32 i = 0; (i < args->size); i += 1) {
+
+#line 660 "./compiler/codegen.ae"
+    if ((i > 0)) {
+
+#line 660 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), ", ");
+    } 
+
+#line 661 "./compiler/codegen.ae"
+    Argument *arg = ((Argument *)Vector__at(args, i));
+
+#line 662 "./compiler/codegen.ae"
+    CodeGenerator__gen_expression(this, arg->expr);
+  } 
+
+#line 664 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "})");
+}
+
+
+#line 669 "./compiler/codegen.ae"
+static __attribute__((unused)) bool CodeGenerator__is_tracked_alloc(CodeGenerator *this, Function *func) {
+
+#line 670 "./compiler/codegen.ae"
+  if ((((!this->track_alloc) || (!((bool)func))) || (!func->is_extern))) 
+
+#line 670 "./compiler/codegen.ae"
+  return false;
+  
+
+#line 671 "./compiler/codegen.ae"
+  return ({ bool __yield_0;
+
+#line 671 "./compiler/codegen.ae"
+  {
+    char *__match_str = func->extern_name;
+    switch (aecor_hash_str(__match_str, 2166136261u)) {
+      case 1994008639u:
+        if (!strcmp(__match_str, "malloc")) goto __match_4_4;
+        break;
+      case 3476869070u:
+        if (!strcmp(__match_str, "calloc")) goto __match_4_4;
+        break;
+      case 4049172918u:
+        if (!strcmp(__match_str, "realloc")) goto __match_4_4;
+        break;
+      case 1615737909u:
+        if (!strcmp(__match_str, "free")) goto __match_4_4;
+        break;
+      case 1902903448u:
+        if (!strcmp(__match_str, "strdup")) goto __match_4_4;
+        break;
+    }
+    goto __match_4_default;
+    __match_4_4: {
+      __yield_0 = true;
+} goto __match_4_end;
+    __match_4_default: {
+      __yield_0 = false;
+}
+    __match_4_end:;
+  }
+;__yield_0; });
+}
+
+
+#line 677 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_alloc_site(CodeGenerator *this, Span span) {
+
+#line 678 "./compiler/codegen.ae"
+  ({ Buffer *__fmt_buf = (&this->out); Buffer__puts(__fmt_buf, "static aecor_alloc_site __aecor_site = {\""); Buffer__put_str(__fmt_buf, Location__str(span.start)); Buffer__puts(__fmt_buf, "\"}; "); });
+}
+
+
+#line 681 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_tracked_alloc(CodeGenerator *this, AST *node) {
+
+#line 682 "./compiler/codegen.ae"
+  Function *func = node->u.call.func;
+
+#line 683 "./compiler/codegen.ae"
+  Vector *args = node->u.call.args;
+
+#line 684 "./compiler/codegen.ae"
+  bool is_free = string__eq(func->extern_name, "free");
+
+#line 685 "./compiler/codegen.ae"
+  if ((!is_free)) {
+
+#line 686 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), "({ ");
+
+#line 687 "./compiler/codegen.ae"
+    CodeGenerator__gen_alloc_site(this, node->span);
+  } 
+
+#line 689 "./compiler/codegen.ae"
+  ({ Buffer *__fmt_buf = (&this->out); Buffer__puts(__fmt_buf, "aecor_track_"); Buffer__put_str(__fmt_buf, func->extern_name); Buffer__puts(__fmt_buf, "("); });
+
+#line 690 "./compiler/codegen.ae"
+  for (i32 i = 0; (i < args->size); i += 1) {
+
+#line 691 "./compiler/codegen.ae"
+    if ((i > 0)) {
+
+#line 691 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), ", ");
+    } 
+
+#line 692 "./compiler/codegen.ae"
+    CodeGenerator__gen_expression(this, ((Argument *)Vector__at(args, i))->expr);
+  } 
+
+#line 694 "./compiler/codegen.ae"
+  if (is_free) {
+
+#line 695 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), ")");
+  }  else {
+
+#line 697 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), ", &__aecor_site); })");
+  } 
+}
+
+
+#line 703 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_ref_argument(CodeGenerator *this, AST *node) {
+
+#line 704 "./compiler/codegen.ae"
+  if (AST__is_lvalue(node)) {
+
+#line 705 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), "&");
+
+#line 706 "./compiler/codegen.ae"
+    CodeGenerator__gen_expression(this, node);
+
+#line 707 "./compiler/codegen.ae"
+    return;
+  } 
+
+#line 709 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "(");
+
+#line 710 "./compiler/codegen.ae"
+  CodeGenerator__gen_type(this, node->etype);
+
+#line 711 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "[]){");
+
+#line 712 "./compiler/codegen.ae"
+  CodeGenerator__gen_expression(this, node);
+
+#line 713 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "}");
+}
+
+
+#line 716 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_expression(CodeGenerator *this, AST *node) {
+
+#line 717 "./compiler/codegen.ae"
+  switch (node->type) {
+    case ASTType__IntLiteral:
+    case ASTType__FloatLiteral: {
+
+#line 722 "./compiler/codegen.ae"
+      NumLiteral *num_lit = (&node->u.num_literal);
+
+#line 723 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), num_lit->text);
+
+#line 724 "./compiler/codegen.ae"
+      if ((node->type == ASTType__IntLiteral && ((bool)num_lit->suffix))) {
+
+#line 725 "./compiler/codegen.ae"
+        switch (num_lit->suffix->base) {
+          case BaseType__U64: {
+
+#line 726 "./compiler/codegen.ae"
+            Buffer__puts((&this->out), "ULL");
+          } break;
+          case BaseType__I64: {
+
+#line 727 "./compiler/codegen.ae"
+            Buffer__puts((&this->out), "LL");
+          } break;
+          case BaseType__U32: {
+
+#line 728 "./compiler/codegen.ae"
+            Buffer__puts((&this->out), "U");
+          } break;
+          default: {
+          } break;
+        }
+      } 
+    } break;
+    case ASTType__StringLiteral: {
+
+#line 733 "./compiler/codegen.ae"
+      ({ Buffer *__fmt_buf = (&this->out); Buffer__puts(__fmt_buf, "\""); Buffer__put_str(__fmt_buf, node->u.string_literal); Buffer__puts(__fmt_buf, "\""); });
+    } break;
+    case ASTType__CharLiteral: {
+
+#line 734 "./compiler/codegen.ae"
+      ({ Buffer *__fmt_buf = (&this->out); Buffer__puts(__fmt_buf, "'"); Buffer__put_str(__fmt_buf, node->u.char_literal); Buffer__puts(__fmt_buf, "'"); });
+    } break;
+    case ASTType__Null: {
+
+#line 735 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "NULL");
+    } break;
+    case ASTType__Match: {
+
+#line 736 "./compiler/codegen.ae"
+      CodeGenerator__gen_in_yield_context(this, node);
+    } break;
+    case ASTType__FormatStringLiteral: {
+
+#line 737 "./compiler/codegen.ae"
+      CodeGenerator__gen_format_string(this, node);
+    } break;
+    case ASTType__If: {
+
+#line 741 "./compiler/codegen.ae"
+      AST *a = node->u.if_stmt.body;
+
+#line 742 "./compiler/codegen.ae"
+      AST *b = node->u.if_stmt.els;
+
+#line 745 "./compiler/codegen.ae"
+      if (((a->type != ASTType__Block) && (b->type != ASTType__Block))) {
+
+#line 746 "./compiler/codegen.ae"
+        Buffer__puts((&this->out), "(");
+
+#line 747 "./compiler/codegen.ae"
+        CodeGenerator__gen_expression(this, node->u.if_stmt.cond);
+
+#line 748 "./compiler/codegen.ae"
+        Buffer__puts((&this->out), " ? ");
+
+#line 749 "./compiler/codegen.ae"
+        CodeGenerator__gen_expression(this, a);
+
+#line 750 "./compiler/codegen.ae"
+        Buffer__puts((&this->out), " : ");
+
+#line 751 "./compiler/codegen.ae"
+        CodeGenerator__gen_expression(this, b);
+
+#line 752 "./compiler/codegen.ae"
+        Buffer__puts((&this->out), ")");
+      }  else {
+
+#line 756 "./compiler/codegen.ae"
+        CodeGenerator__gen_in_yield_context(this, node);
+      } 
+    } break;
+    case ASTType__BoolLiteral: {
+
+#line 760 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), (node->u.bool_literal ? "true" : "false"));
+    } break;
+    case ASTType__Identifier: {
+
+#line 763 "./compiler/codegen.ae"
+      Identifier ident = node->u.ident;
+
+#line 764 "./compiler/codegen.ae"
+      if (((bool)ident.func)) {
+
+#line 765 "./compiler/codegen.ae"
+        Buffer__puts((&this->out), CodeGenerator__get_function_name(this, ident.func));
+      }  else 
+#line 766 "./compiler/codegen.ae"
+      if (ident.var->is_extern) {
+
+#line 767 "./compiler/codegen.ae"
+        Buffer__puts((&this->out), ident.var->extern_name);
+      }  else 
+#line 768 "./compiler/codegen.ae"
+      if (((bool)ident.var->frame_name)) {
+
+#line 769 "./compiler/codegen.ae"
+        ({ Buffer *__fmt_buf = (&this->out); Buffer__puts(__fmt_buf, "__gen->"); Buffer__put_str(__fmt_buf, ident.var->frame_name); });
+      }  else 
+#line 770 "./compiler/codegen.ae"
+      if (ident.var->by_ref) {
+
+#line 771 "./compiler/codegen.ae"
+        ({ Buffer *__fmt_buf = (&this->out); Buffer__puts(__fmt_buf, "(*"); Buffer__put_str(__fmt_buf, ident.var->name); Buffer__puts(__fmt_buf, ")"); });
+      }  else {
+
+#line 773 "./compiler/codegen.ae"
+        Buffer__puts((&this->out), ident.var->name);
+      } 
+      
+      
+      
+    } break;
+    case ASTType__Call: {
+
+#line 777 "./compiler/codegen.ae"
+      if ((AST__callee_is(node, "print") || AST__callee_is(node, "println"))) {
+
+#line 778 "./compiler/codegen.ae"
+        CodeGenerator__gen_internal_print(this, node);
+
+#line 779 "./compiler/codegen.ae"
+        return;
+      } 
+
+#line 781 "./compiler/codegen.ae"
+      if (AST__callee_is(node, "debug_assert")) {
+
+#line 782 "./compiler/codegen.ae"
+        CodeGenerator__gen_debug_assert(this, node);
+
+#line 783 "./compiler/codegen.ae"
+        return;
+      } 
+
+#line 785 "./compiler/codegen.ae"
+      if ((AST__callee_is(node, "shuffle") && (!((bool)node->u.call.func)))) {
+
+#line 786 "./compiler/codegen.ae"
+        Buffer__puts((&this->out), "__builtin_shuffle");
+      }  else 
+#line 787 "./compiler/codegen.ae"
+      if (CodeGenerator__is_specialized_putsf(this, node)) {
+
+#line 788 "./compiler/codegen.ae"
+        CodeGenerator__gen_specialized_putsf(this, node);
+
+#line 789 "./compiler/codegen.ae"
+        return;
+      }  else 
+#line 790 "./compiler/codegen.ae"
+      if (CodeGenerator__is_tracked_alloc(this, node->u.call.func)) {
+
+#line 791 "./compiler/codegen.ae"
+        CodeGenerator__gen_tracked_alloc(this, node);
+
+#line 792 "./compiler/codegen.ae"
+        return;
+      }  else 
+#line 793 "./compiler/codegen.ae"
+      if ((!((bool)node->u.call.func))) {
+
+#line 794 "./compiler/codegen.ae"
+        CodeGenerator__gen_expression(this, node->u.call.callee);
+      }  else {
+
+#line 796 "./compiler/codegen.ae"
+        Buffer__puts((&this->out), CodeGenerator__get_function_name(this, node->u.call.func));
+      } 
+      
+      
+      
+
+#line 798 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "(");
+
+#line 799 "./compiler/codegen.ae"
+      Function *func = node->u.call.func;
+
+#line 800 "./compiler/codegen.ae"
+      Vector *args = node->u.call.args;
+
+#line 801 "./compiler/codegen.ae"
+      for (i32 i = 0; (i < args->size); i += 1) {
+
+#line 802 "./compiler/codegen.ae"
+        if ((i > 0)) {
+
+#line 802 "./compiler/codegen.ae"
+          Buffer__puts((&this->out), ", ");
+        } 
+
+#line 803 "./compiler/codegen.ae"
+        Argument *arg = ((Argument *)Vector__at(args, i));
+
+#line 804 "./compiler/codegen.ae"
+        bool by_ref = ((((bool)func) && (i < func->params->size)) && ((Variable *)Vector__at(func->params, i))->by_ref);
+
+#line 805 "./compiler/codegen.ae"
+        if (by_ref) {
+
+#line 806 "./compiler/codegen.ae"
+          CodeGenerator__gen_ref_argument(this, arg->expr);
+        }  else {
+
+#line 808 "./compiler/codegen.ae"
+          CodeGenerator__gen_expression(this, arg->expr);
+        } 
+      } 
+
+#line 811 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), ")");
+    } break;
+    case ASTType__Constructor: {
+
+#line 814 "./compiler/codegen.ae"
+      if (Type__is_simd(node->etype)) {
+
+#line 815 "./compiler/codegen.ae"
+        CodeGenerator__gen_simd_constructor(this, node);
+
+#line 816 "./compiler/codegen.ae"
+        return;
+      } 
+
+#line 818 "./compiler/codegen.ae"
+      Structure *struc = node->u.constructor.struc;
+
+#line 819 "./compiler/codegen.ae"
+      Vector *args = node->u.constructor.args;
+
+#line 821 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "(");
+
+#line 822 "./compiler/codegen.ae"
+      CodeGenerator__gen_type(this, struc->type);
+
+#line 823 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "){");
+
+#line 824 "./compiler/codegen.ae"
+      for (i32 i = 0; (i < args->size); i += 1) {
+
+#line 825 "./compiler/codegen.ae"
+        if ((i > 0)) {
+
+#line 825 "./compiler/codegen.ae"
+          Buffer__puts((&this->out), ", ");
+        } 
+
+#line 826 "./compiler/codegen.ae"
+        Argument *arg = ((Argument *)Vector__at(args, i));
+
+#line 827 "./compiler/codegen.ae"
+        if (((bool)arg->label)) {
+
+#line 828 "./compiler/codegen.ae"
+          char *label = arg->label->u.ident.name;
+
+#line 829 "./compiler/codegen.ae"
+          ({ Buffer *__fmt_buf = (&this->out); Buffer__puts(__fmt_buf, "."); Buffer__put_str(__fmt_buf, label); Buffer__puts(__fmt_buf, " = "); });
+        }  else 
+#line 830 "./compiler/codegen.ae"
+        if (struc->is_reorder) {
+
+#line 832 "./compiler/codegen.ae"
+          Variable *field = ((Variable *)Vector__at(struc->fields, i));
+
+#line 833 "./compiler/codegen.ae"
+          ({ Buffer *__fmt_buf = (&this->out); Buffer__puts(__fmt_buf, "."); Buffer__put_str(__fmt_buf, field->name); Buffer__puts(__fmt_buf, " = "); });
+        } 
+        
+
+#line 835 "./compiler/codegen.ae"
+        CodeGenerator__gen_expression(this, arg->expr);
+      } 
+
+#line 837 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "}");
+    } break;
+    case ASTType__And:
+    case ASTType__BitwiseAnd:
+    case ASTType__BitwiseOr:
+    case ASTType__BitwiseXor:
+    case ASTType__Divide:
+    case ASTType__GreaterThan:
+    case ASTType__GreaterThanEquals:
+    case ASTType__LeftShift:
+    case ASTType__LessThan:
+    case ASTType__LessThanEquals:
+    case ASTType__Minus:
+    case ASTType__Modulus:
+    case ASTType__Multiply:
+    case ASTType__NotEquals:
+    case ASTType__Or:
+    case ASTType__Plus:
+    case ASTType__RightShift: {
+
+#line 856 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "(");
+
+#line 857 "./compiler/codegen.ae"
+      CodeGenerator__gen_simd_operand(this, node->u.binary.lhs, node->etype);
+
+#line 858 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), CodeGenerator__get_op(node->type));
+
+#line 859 "./compiler/codegen.ae"
+      CodeGenerator__gen_simd_operand(this, node->u.binary.rhs, node->etype);
+
+#line 860 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), ")");
+    } break;
+    case ASTType__Address:
+    case ASTType__Dereference:
+    case ASTType__Not:
+    case ASTType__UnaryMinus:
+    case ASTType__BitwiseNot: {
+
+#line 863 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "(");
+
+#line 864 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), CodeGenerator__get_op(node->type));
+
+#line 865 "./compiler/codegen.ae"
+      CodeGenerator__gen_expression(this, node->u.unary);
+
+#line 866 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), ")");
+    } break;
+    case ASTType__Index: {
+
+#line 869 "./compiler/codegen.ae"
+      CodeGenerator__gen_expression(this, node->u.binary.lhs);
+
+#line 870 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "[");
+
+#line 871 "./compiler/codegen.ae"
+      CodeGenerator__gen_expression(this, node->u.binary.rhs);
+
+#line 872 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "]");
+    } break;
+    case ASTType__Member: {
+
+#line 875 "./compiler/codegen.ae"
+      CodeGenerator__gen_expression(this, node->u.member.lhs);
+
+#line 876 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), (node->u.member.is_pointer ? "->" : "."));
+
+#line 878 "./compiler/codegen.ae"
+      AST *rhs = node->u.member.rhs;
+
+#line 879 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), rhs->u.ident.name);
+    } break;
+    case ASTType__EnumValue: {
+
+#line 882 "./compiler/codegen.ae"
+      EnumValue *enum_value = node->u.enum_val;
+
+#line 883 "./compiler/codegen.ae"
+      CodeGenerator__gen_enum_value(this, enum_value->struct_def->name, enum_value->var);
+    } break;
+    case ASTType__IsNotNull: {
+
+#line 887 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "((bool)");
+
+#line 888 "./compiler/codegen.ae"
+      CodeGenerator__gen_expression(this, node->u.unary);
+
+#line 889 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), ")");
+    } break;
+    case ASTType__Cast: {
+
+#line 892 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "((");
+
+#line 893 "./compiler/codegen.ae"
+      CodeGenerator__gen_type(this, node->u.cast.to);
+
+#line 894 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), ")");
+
+#line 895 "./compiler/codegen.ae"
+      CodeGenerator__gen_expression(this, node->u.cast.lhs);
+
+#line 896 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), ")");
+    } break;
+    case ASTType__Defer: {
+
+#line 898 "./compiler/codegen.ae"
+      Vector__push(CodeGenerator__scope(this), node->u.unary);
+    } break;
+    case ASTType__SizeOf: {
+
+#line 900 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "sizeof(");
+
+#line 901 "./compiler/codegen.ae"
+      CodeGenerator__gen_type(this, node->u.size_of_type);
+
+#line 902 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), ")");
+    } break;
+    case ASTType__Equals:
+    case ASTType__Assignment:
+    case ASTType__PlusEquals:
+    case ASTType__MinusEquals:
+    case ASTType__DivideEquals:
+    case ASTType__MultiplyEquals: {
+
+#line 910 "./compiler/codegen.ae"
+      CodeGenerator__gen_expression(this, node->u.binary.lhs);
+
+#line 911 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), CodeGenerator__get_op(node->type));
+
+#line 912 "./compiler/codegen.ae"
+      CodeGenerator__gen_simd_operand(this, node->u.binary.rhs, node->etype);
+    } break;
+    default: panic(format_string("Unhandled expression type: %s", ASTType__dbg(node->type))); break;
+  }
+}
+
+
+#line 918 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_var_decl(CodeGenerator *this, AST *node, bool is_constant) {
+
+#line 919 "./compiler/codegen.ae"
+  Variable *var = node->u.var_decl.var;
+
+#line 920 "./compiler/codegen.ae"
+  if (var->is_extern) 
+
+#line 920 "./compiler/codegen.ae"
+  return;
+  
+
+#line 923 "./compiler/codegen.ae"
+  if (((bool)var->frame_name)) {
+
+#line 924 "./compiler/codegen.ae"
+    if (((bool)node->u.var_decl.init)) {
+
+#line 925 "./compiler/codegen.ae"
+      ({ Buffer *__fmt_buf = (&this->out); Buffer__puts(__fmt_buf, "__gen->"); Buffer__put_str(__fmt_buf, var->frame_name); Buffer__puts(__fmt_buf, " = "); });
+
+#line 926 "./compiler/codegen.ae"
+      CodeGenerator__gen_expression(this, node->u.var_decl.init);
+    }  else 
+#line 927 "./compiler/codegen.ae"
+    if ((Type__is_struct(var->type) || Type__is_simd(var->type))) {
+
+#line 928 "./compiler/codegen.ae"
+      ({ Buffer *__fmt_buf = (&this->out); Buffer__puts(__fmt_buf, "__gen->"); Buffer__put_str(__fmt_buf, var->frame_name); Buffer__puts(__fmt_buf, " = ("); });
+
+#line 929 "./compiler/codegen.ae"
+      CodeGenerator__gen_type(this, var->type);
+
+#line 930 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "){0}");
+    } 
+    
+
+#line 932 "./compiler/codegen.ae"
+    return;
+  } 
+
+#line 935 "./compiler/codegen.ae"
+  if (is_constant) {
+
+#line 936 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), "const ");
+  } 
+
+#line 939 "./compiler/codegen.ae"
+  CodeGenerator__gen_type_and_name(this, var->type, var->name);
+
+#line 940 "./compiler/codegen.ae"
+  if (((bool)node->u.var_decl.init)) {
+
+#line 941 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), " = ");
+
+#line 942 "./compiler/codegen.ae"
+    CodeGenerator__gen_expression(this, node->u.var_decl.init);
+  }  else 
+#line 945 "./compiler/codegen.ae"
+  if ((Type__is_struct(var->type) || Type__is_simd(var->type))) {
+
+#line 946 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), " = {0}");
+  } 
+  
+}
+
+
+#line 950 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_var_ref(CodeGenerator *this, Variable *var) {
+
+#line 951 "./compiler/codegen.ae"
+  if (((bool)var->frame_name)) {
+
+#line 952 "./compiler/codegen.ae"
+    ({ Buffer *__fmt_buf = (&this->out); Buffer__puts(__fmt_buf, "__gen->"); Buffer__put_str(__fmt_buf, var->frame_name); });
+  }  else {
+
+#line 954 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), var->name);
+  } 
+}
+
+
+#line 959 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_loop_var(CodeGenerator *this, Variable *var, i32 indent) {
+
+#line 960 "./compiler/codegen.ae"
+  CodeGenerator__indent(this, indent);
+
+#line 961 "./compiler/codegen.ae"
+  if (((bool)var->frame_name)) {
+
+#line 962 "./compiler/codegen.ae"
+    CodeGenerator__gen_var_ref(this, var);
+  }  else {
+
+#line 964 "./compiler/codegen.ae"
+    CodeGenerator__gen_type_and_name(this, var->type, var->name);
+  } 
+
+#line 966 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), " = ");
+}
+
+
+#line 970 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_source_field(CodeGenerator *this, ForIn *for_in, char *field) {
+
+#line 971 "./compiler/codegen.ae"
+  CodeGenerator__gen_var_ref(this, for_in->source);
+
+#line 972 "./compiler/codegen.ae"
+  char *op = (for_in->source->type->base == BaseType__Pointer ? "->" : ".");
+
+#line 973 "./compiler/codegen.ae"
+  ({ Buffer *__fmt_buf = (&this->out); Buffer__put_str(__fmt_buf, op); Buffer__put_str(__fmt_buf, field); });
+}
+
+
+#line 978 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_for_in(CodeGenerator *this, AST *node, i32 indent) {
+
+#line 979 "./compiler/codegen.ae"
+  ForIn *for_in = node->u.for_in;
+
+#line 980 "./compiler/codegen.ae"
+  Variable *cursor = for_in->cursor;
+
+#line 981 "./compiler/codegen.ae"
+  Variable *limit = for_in->limit;
+
+#line 982 "./compiler/codegen.ae"
+  Variable *source = for_in->source;
+
+#line 984 "./compiler/codegen.ae"
+  CodeGenerator__indent(this, indent);
+
+#line 985 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "{\n");
+
+#line 986 "./compiler/codegen.ae"
+  if (((bool)source)) {
+
+#line 987 "./compiler/codegen.ae"
+    CodeGenerator__gen_loop_var(this, source, (indent + 1));
+
+#line 988 "./compiler/codegen.ae"
+    CodeGenerator__gen_expression(this, for_in->expr);
+
+#line 989 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), ";\n");
+  } 
+
+#line 992 "./compiler/codegen.ae"
+  switch (for_in->kind) {
+    case IterKind__Range: {
+
+#line 994 "./compiler/codegen.ae"
+      CodeGenerator__gen_loop_var(this, cursor, (indent + 1));
+
+#line 995 "./compiler/codegen.ae"
+      CodeGenerator__gen_expression(this, for_in->expr);
+
+#line 996 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), ";\n");
+
+#line 997 "./compiler/codegen.ae"
+      CodeGenerator__gen_loop_var(this, limit, (indent + 1));
+
+#line 998 "./compiler/codegen.ae"
+      CodeGenerator__gen_expression(this, for_in->end);
+
+#line 999 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), ";\n");
+
+#line 1000 "./compiler/codegen.ae"
+      CodeGenerator__indent(this, (indent + 1));
+
+#line 1001 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "for (; ");
+
+#line 1002 "./compiler/codegen.ae"
+      CodeGenerator__gen_var_ref(this, cursor);
+
+#line 1003 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), " < ");
+
+#line 1004 "./compiler/codegen.ae"
+      CodeGenerator__gen_var_ref(this, limit);
+
+#line 1005 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "; ");
+
+#line 1006 "./compiler/codegen.ae"
+      CodeGenerator__gen_var_ref(this, cursor);
+
+#line 1007 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "++) {\n");
+
+#line 1008 "./compiler/codegen.ae"
+      CodeGenerator__gen_loop_var(this, for_in->var, (indent + 2));
+
+#line 1009 "./compiler/codegen.ae"
+      CodeGenerator__gen_var_ref(this, cursor);
+    } break;
+    case IterKind__Elements: {
+
+#line 1012 "./compiler/codegen.ae"
+      CodeGenerator__gen_loop_var(this, cursor, (indent + 1));
+
+#line 1013 "./compiler/codegen.ae"
+      if (((bool)source)) {
+
+#line 1014 "./compiler/codegen.ae"
+        CodeGenerator__gen_source_field(this, for_in, "data");
+      }  else {
+
+#line 1016 "./compiler/codegen.ae"
+        CodeGenerator__gen_expression(this, for_in->expr);
+      } 
+
+#line 1018 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), ";\n");
+
+#line 1019 "./compiler/codegen.ae"
+      CodeGenerator__gen_loop_var(this, limit, (indent + 1));
+
+#line 1020 "./compiler/codegen.ae"
+      CodeGenerator__gen_var_ref(this, cursor);
+
+#line 1021 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), " + ");
+
+#line 1022 "./compiler/codegen.ae"
+      if (((bool)source)) {
+
+#line 1023 "./compiler/codegen.ae"
+        CodeGenerator__gen_source_field(this, for_in, "size");
+      }  else {
+
+#line 1025 "./compiler/codegen.ae"
+        Buffer__puts((&this->out), "(");
+
+#line 1026 "./compiler/codegen.ae"
+        CodeGenerator__gen_expression(this, for_in->end);
+
+#line 1027 "./compiler/codegen.ae"
+        Buffer__puts((&this->out), ")");
+      } 
+
+#line 1029 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), ";\n");
+
+#line 1030 "./compiler/codegen.ae"
+      CodeGenerator__indent(this, (indent + 1));
+
+#line 1031 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "for (; ");
+
+#line 1032 "./compiler/codegen.ae"
+      CodeGenerator__gen_var_ref(this, cursor);
+
+#line 1033 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), " != ");
+
+#line 1034 "./compiler/codegen.ae"
+      CodeGenerator__gen_var_ref(this, limit);
+
+#line 1035 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "; ");
+
+#line 1036 "./compiler/codegen.ae"
+      CodeGenerator__gen_var_ref(this, cursor);
+
+#line 1037 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "++) {\n");
+
+#line 1038 "./compiler/codegen.ae"
+      CodeGenerator__gen_loop_var(this, for_in->var, (indent + 2));
+
+#line 1039 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "*");
+
+#line 1040 "./compiler/codegen.ae"
+      CodeGenerator__gen_var_ref(this, cursor);
+    } break;
+    case IterKind__Buckets: {
+
+#line 1044 "./compiler/codegen.ae"
+      CodeGenerator__gen_loop_var(this, cursor, (indent + 1));
+
+#line 1045 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "NULL;\n");
+
+#line 1046 "./compiler/codegen.ae"
+      CodeGenerator__gen_loop_var(this, limit, (indent + 1));
+
+#line 1047 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "-1;\n");
+
+#line 1048 "./compiler/codegen.ae"
+      CodeGenerator__indent(this, (indent + 1));
+
+#line 1049 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "while (true) {\n");
+
+#line 1050 "./compiler/codegen.ae"
+      CodeGenerator__indent(this, (indent + 2));
+
+#line 1051 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "while (!");
+
+#line 1052 "./compiler/codegen.ae"
+      CodeGenerator__gen_var_ref(this, cursor);
+
+#line 1053 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), " && ++");
+
+#line 1054 "./compiler/codegen.ae"
+      CodeGenerator__gen_var_ref(this, limit);
+
+#line 1055 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), " < ");
+
+#line 1056 "./compiler/codegen.ae"
+      CodeGenerator__gen_source_field(this, for_in, "num_buckets");
+
+#line 1057 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), ") ");
+
+#line 1058 "./compiler/codegen.ae"
+      CodeGenerator__gen_var_ref(this, cursor);
+
+#line 1059 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), " = ");
+
+#line 1060 "./compiler/codegen.ae"
+      CodeGenerator__gen_source_field(this, for_in, "buckets");
+
+#line 1061 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "[");
+
+#line 1062 "./compiler/codegen.ae"
+      CodeGenerator__gen_var_ref(this, limit);
+
+#line 1063 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "];\n");
+
+#line 1064 "./compiler/codegen.ae"
+      CodeGenerator__indent(this, (indent + 2));
+
+#line 1065 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "if (!");
+
+#line 1066 "./compiler/codegen.ae"
+      CodeGenerator__gen_var_ref(this, cursor);
+
+#line 1067 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), ") break;\n");
+
+#line 1068 "./compiler/codegen.ae"
+      CodeGenerator__gen_loop_var(this, for_in->var, (indent + 2));
+
+#line 1069 "./compiler/codegen.ae"
+      CodeGenerator__gen_var_ref(this, cursor);
+
+#line 1070 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), ";\n");
+
+#line 1071 "./compiler/codegen.ae"
+      CodeGenerator__indent(this, (indent + 2));
+
+#line 1072 "./compiler/codegen.ae"
+      CodeGenerator__gen_var_ref(this, cursor);
+
+#line 1073 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), " = ");
+
+#line 1074 "./compiler/codegen.ae"
+      CodeGenerator__gen_var_ref(this, cursor);
+
+#line 1075 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "->next");
+    } break;
+    case IterKind__Generator: {
+
+#line 1078 "./compiler/codegen.ae"
+      Structure *struc = source->type->struct_def;
+
+#line 1079 "./compiler/codegen.ae"
+      if (source->type->base == BaseType__Pointer) 
+
+#line 1079 "./compiler/codegen.ae"
+      struc = source->type->ptr->struct_def;
+      
+
+#line 1080 "./compiler/codegen.ae"
+      CodeGenerator__indent(this, (indent + 1));
+
+#line 1081 "./compiler/codegen.ae"
+      ({ Buffer *__fmt_buf = (&this->out); Buffer__puts(__fmt_buf, "while ("); Buffer__put_str(__fmt_buf, struc->name); Buffer__puts(__fmt_buf, "__next("); });
+
+#line 1082 "./compiler/codegen.ae"
+      if ((source->type->base != BaseType__Pointer)) 
+
+#line 1082 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "&");
+      
+
+#line 1083 "./compiler/codegen.ae"
+      CodeGenerator__gen_var_ref(this, source);
+
+#line 1084 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), ")) {\n");
+
+#line 1085 "./compiler/codegen.ae"
+      CodeGenerator__gen_loop_var(this, for_in->var, (indent + 2));
+
+#line 1086 "./compiler/codegen.ae"
+      CodeGenerator__gen_source_field(this, for_in, "value");
+    } break;
+  }
+
+#line 1089 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), ";\n");
+
+#line 1090 "./compiler/codegen.ae"
+  CodeGenerator__gen_statement(this, for_in->body, (indent + 2));
+
+#line 1091 "./compiler/codegen.ae"
+  CodeGenerator__indent(this, (indent + 1));
+
+#line 1092 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "}\n");
+
+#line 1093 "./compiler/codegen.ae"
+  CodeGenerator__indent(this, indent);
+
+#line 1094 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "}\n");
+}
+
+
+#line 1097 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_match_case_body(CodeGenerator *this, AST *node, AST *body, i32 indent) {
+
+#line 1098 "./compiler/codegen.ae"
+  if (body->type == ASTType__Block) {
+
+#line 1099 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), " ");
+
+#line 1100 "./compiler/codegen.ae"
+    CodeGenerator__gen_block(this, body, (indent + 1));
+  }  else 
+#line 1103 "./compiler/codegen.ae"
+  if ((body->type == ASTType__Call && body->returns)) {
+
+#line 1104 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), " ");
+
+#line 1105 "./compiler/codegen.ae"
+    CodeGenerator__gen_expression(this, body);
+
+#line 1106 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), ";");
+  }  else 
+#line 1109 "./compiler/codegen.ae"
+  if ((((bool)node->etype) && (body->type != ASTType__Yield))) {
+
+#line 1110 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), " {\n");
+
+#line 1111 "./compiler/codegen.ae"
+    CodeGenerator__gen_yield_expression(this, body, (indent + 2));
+
+#line 1112 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), "}");
+  }  else {
+
+#line 1115 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), " {\n");
+
+#line 1116 "./compiler/codegen.ae"
+    CodeGenerator__gen_statement(this, body, (indent + 2));
+
+#line 1117 "./compiler/codegen.ae"
+    CodeGenerator__indent(this, (indent + 1));
+
+#line 1118 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), "}");
+  } 
+  
+  
+}
+
+
+#line 1122 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_match_string_linear(CodeGenerator *this, AST *node, i32 indent) {
+
+#line 1123 "./compiler/codegen.ae"
+  Match *stmt = node->u.match_stmt;
+
+#line 1124 "./compiler/codegen.ae"
+  Vector *cases = stmt->cases;
+
+#line 1125 "./compiler/codegen.ae"
+  CodeGenerator__indent(this, (indent + 1));
+
+#line 1126 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "if (");
+
+#line 1127 "./compiler/codegen.ae"
+  for (i32 i = 0; (i < cases->size); i += 1) {
+
+#line 1128 "./compiler/codegen.ae"
+    MatchCase *_case = ((MatchCase *)Vector__at(cases, i));
+
+#line 1129 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), "!strcmp(__match_str, ");
+
+#line 1130 "./compiler/codegen.ae"
+    CodeGenerator__gen_expression(this, _case->cond);
+
+#line 1131 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), ")");
+
+#line 1133 "./compiler/codegen.ae"
+    if (((bool)_case->body)) {
+
+#line 1134 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), ")");
+
+#line 1135 "./compiler/codegen.ae"
+      CodeGenerator__gen_match_case_body(this, node, _case->body, indent);
+
+#line 1136 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), " else ");
+
+#line 1137 "./compiler/codegen.ae"
+      if ((i != (cases->size - 1))) {
+
+#line 1138 "./compiler/codegen.ae"
+        Buffer__puts((&this->out), "if (");
+      } 
+    }  else {
+
+#line 1141 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), " || ");
+    } 
+  } 
+
+#line 1144 "./compiler/codegen.ae"
+  if (((bool)stmt->defolt)) {
+
+#line 1145 "./compiler/codegen.ae"
+    CodeGenerator__gen_match_case_body(this, node, stmt->defolt, indent);
+  } 
+
+#line 1147 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "\n");
+}
+
+
+#line 1153 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_match_string_hashed(CodeGenerator *this, AST *node, i32 indent) {
+
+#line 1154 "./compiler/codegen.ae"
+  Match *stmt = node->u.match_stmt;
+
+#line 1155 "./compiler/codegen.ae"
+  Vector *cases = stmt->cases;
+
+#line 1156 "./compiler/codegen.ae"
+  char *label = format_string("__match_%d", this->label_count);
+
+#line 1157 "./compiler/codegen.ae"
+  this->label_count += 1;
+
+#line 1160 "./compiler/codegen.ae"
+  i32 targets[cases->size];
+
+#line 1161 "./compiler/codegen.ae"
+  i32 target = cases->size;
+
+#line 1162 "./compiler/codegen.ae"
+  for (i32 i = (cases->size - 1); (i >= 0); i -= 1) {
+
+#line 1163 "./compiler/codegen.ae"
+    MatchCase *_case = ((MatchCase *)Vector__at(cases, i));
+
+#line 1164 "./compiler/codegen.ae"
+    if (((bool)_case->body)) 
+
+#line 1164 "./compiler/codegen.ae"
+    target = i;
+    
+
+#line 1165 "./compiler/codegen.ae"
+    targets[i] = target;
+  } 
+
+#line 1168 "./compiler/codegen.ae"
+  u32 hashes[cases->size];
+
+#line 1169 "./compiler/codegen.ae"
+  for (i32 i = 0; (i < cases->size); i += 1) {
+
+#line 1170 "./compiler/codegen.ae"
+    MatchCase *_case = ((MatchCase *)Vector__at(cases, i));
+
+#line 1171 "./compiler/codegen.ae"
+    hashes[i] = hash_string(_case->cond->u.string_literal, 2166136261);
+  } 
+
+#line 1174 "./compiler/codegen.ae"
+  CodeGenerator__indent(this, (indent + 1));
+
+#line 1175 "./compiler/codegen.ae"
+  ({ Buffer *__fmt_buf = (&this->out); Buffer__puts(__fmt_buf, "switch (aecor_hash_str(__match_str, 2166136261u)) {\n"); });
+
+#line 1176 "./compiler/codegen.ae"
+  for (i32 i = 0; (i < cases->size); i += 1) {
+
+#line 1178 "./compiler/codegen.ae"
+    bool seen = false;
+
+#line 1179 "./compiler/codegen.ae"
+    for (i32 j = 0; (j < i); j += 1) {
+
+#line 1180 "./compiler/codegen.ae"
+      if (hashes[j] == hashes[i]) 
+
+#line 1180 "./compiler/codegen.ae"
+      seen = true;
+      
+    } 
+
+#line 1182 "./compiler/codegen.ae"
+    if (seen) 
+
+#line 1182 "./compiler/codegen.ae"
+    continue;
+    
+
+#line 1184 "./compiler/codegen.ae"
+    CodeGenerator__indent(this, (indent + 2));
+
+#line 1185 "./compiler/codegen.ae"
+    ({ Buffer *__fmt_buf = (&this->out); Buffer__puts(__fmt_buf, "case "); Buffer__put_u64(__fmt_buf, hashes[i]); Buffer__puts(__fmt_buf, "u:\n"); });
+
+#line 1186 "./compiler/codegen.ae"
+    for (i32 j = i; (j < cases->size); j += 1) {
+
+#line 1187 "./compiler/codegen.ae"
+      if ((hashes[j] != hashes[i])) 
+
+#line 1187 "./compiler/codegen.ae"
+      continue;
+      
+
+#line 1188 "./compiler/codegen.ae"
+      MatchCase *_case = ((MatchCase *)Vector__at(cases, j));
+
+#line 1189 "./compiler/codegen.ae"
+      CodeGenerator__indent(this, (indent + 3));
+
+#line 1190 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "if (!strcmp(__match_str, ");
+
+#line 1191 "./compiler/codegen.ae"
+      CodeGenerator__gen_expression(this, _case->cond);
+
+#line 1192 "./compiler/codegen.ae"
+      ({ Buffer *__fmt_buf = (&this->out); Buffer__puts(__fmt_buf, ")) goto "); Buffer__put_str(__fmt_buf, label); Buffer__puts(__fmt_buf, "_"); Buffer__put_i64(__fmt_buf, targets[j]); Buffer__puts(__fmt_buf, ";\n"); });
+    } 
+
+#line 1194 "./compiler/codegen.ae"
+    CodeGenerator__indent(this, (indent + 3));
+
+#line 1195 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), "break;\n");
+  } 
+
+#line 1197 "./compiler/codegen.ae"
+  CodeGenerator__indent(this, (indent + 1));
+
+#line 1198 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "}\n");
+
+#line 1199 "./compiler/codegen.ae"
+  CodeGenerator__indent(this, (indent + 1));
+
+#line 1200 "./compiler/codegen.ae"
+  ({ Buffer *__fmt_buf = (&this->out); Buffer__puts(__fmt_buf, "goto "); Buffer__put_str(__fmt_buf, label); Buffer__puts(__fmt_buf, "_default;\n"); });
+
+#line 1202 "./compiler/codegen.ae"
+  for (i32 i = 0; (i < cases->size); i += 1) {
+
+#line 1203 "./compiler/codegen.ae"
+    MatchCase *_case = ((MatchCase *)Vector__at(cases, i));
+
+#line 1204 "./compiler/codegen.ae"
+    if ((!((bool)_case->body))) 
+
+#line 1204 "./compiler/codegen.ae"
+    continue;
+    
+
+#line 1205 "./compiler/codegen.ae"
+    CodeGenerator__indent(this, (indent + 1));
+
+#line 1206 "./compiler/codegen.ae"
+    ({ Buffer *__fmt_buf = (&this->out); Buffer__put_str(__fmt_buf, label); Buffer__puts(__fmt_buf, "_"); Buffer__put_i64(__fmt_buf, i); Buffer__puts(__fmt_buf, ":"); });
+
+#line 1207 "./compiler/codegen.ae"
+    CodeGenerator__gen_match_case_body(this, node, _case->body, indent);
+
+#line 1208 "./compiler/codegen.ae"
+    ({ Buffer *__fmt_buf = (&this->out); Buffer__puts(__fmt_buf, " goto "); Buffer__put_str(__fmt_buf, label); Buffer__puts(__fmt_buf, "_end;\n"); });
+  } 
+
+#line 1210 "./compiler/codegen.ae"
+  CodeGenerator__indent(this, (indent + 1));
+
+#line 1211 "./compiler/codegen.ae"
+  ({ Buffer *__fmt_buf = (&this->out); Buffer__put_str(__fmt_buf, label); Buffer__puts(__fmt_buf, "_default:"); });
+
+#line 1212 "./compiler/codegen.ae"
+  if (((bool)stmt->defolt)) {
+
+#line 1213 "./compiler/codegen.ae"
+    CodeGenerator__gen_match_case_body(this, node, stmt->defolt, indent);
+  } 
+
+#line 1215 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "\n");
+
+#line 1216 "./compiler/codegen.ae"
+  CodeGenerator__indent(this, (indent + 1));
+
+#line 1217 "./compiler/codegen.ae"
+  ({ Buffer *__fmt_buf = (&this->out); Buffer__put_str(__fmt_buf, label); Buffer__puts(__fmt_buf, "_end:;\n"); });
+
+#line 1218 "./compiler/codegen.ae"
+  free(label);
+}
+
+
+#line 1221 "./compiler/codegen.ae"
+static __attribute__((unused)) bool CodeGenerator__can_hash_match_string(CodeGenerator *this, AST *node) {
+
+#line 1222 "./compiler/codegen.ae"
+  Vector *cases = node->u.match_stmt->cases;
+
+#line 1223 "./compiler/codegen.ae"
+  if ((cases->size < this->match_hash_threshold)) 
+
+#line 1223 "./compiler/codegen.ae"
+  return false;
+  
+
+#line 1226 "./compiler/codegen.ae"
+  for (i32 i = 0; (i < cases->size); i += 1) {
+
+#line 1227 "./compiler/codegen.ae"
+    MatchCase *_case = ((MatchCase *)Vector__at(cases, i));
+
+#line 1228 "./compiler/codegen.ae"
+    char *text = _case->cond->u.string_literal;
+
+#line 1229 "./compiler/codegen.ae"
+    i32 len = strlen(text);
+
+#line 1230 "./compiler/codegen.ae"
+    for (i32 j = 0; (j < len); j += 1) {
+
+#line 1231 "./compiler/codegen.ae"
+      if (text[j] == '\\') 
+
+#line 1231 "./compiler/codegen.ae"
+      return false;
+      
+    } 
+  } 
+
+#line 1234 "./compiler/codegen.ae"
+  return true;
+}
+
+
+#line 1237 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_match_string(CodeGenerator *this, AST *node, i32 indent) {
+
+#line 1238 "./compiler/codegen.ae"
+  Match *stmt = node->u.match_stmt;
+
+#line 1239 "./compiler/codegen.ae"
+  CodeGenerator__indent(this, indent);
+
+#line 1240 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "{\n");
+
+#line 1241 "./compiler/codegen.ae"
+  CodeGenerator__indent(this, (indent + 1));
+
+#line 1242 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "char *__match_str = ");
+
+#line 1243 "./compiler/codegen.ae"
+  CodeGenerator__gen_expression(this, stmt->expr);
+
+#line 1244 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), ";\n");
+
+#line 1246 "./compiler/codegen.ae"
+  if (CodeGenerator__can_hash_match_string(this, node)) {
+
+#line 1247 "./compiler/codegen.ae"
+    CodeGenerator__gen_match_string_hashed(this, node, indent);
+  }  else {
+
+#line 1249 "./compiler/codegen.ae"
+    CodeGenerator__gen_match_string_linear(this, node, indent);
+  } 
+
+#line 1251 "./compiler/codegen.ae"
+  CodeGenerator__indent(this, indent);
+
+#line 1252 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "}\n");
+}
+
+
+#line 1255 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_match(CodeGenerator *this, AST *node, i32 indent) {
+
+#line 1256 "./compiler/codegen.ae"
+  Match *stmt = node->u.match_stmt;
+
+#line 1257 "./compiler/codegen.ae"
+  if (Type__is_string(stmt->expr->etype)) {
+
+#line 1258 "./compiler/codegen.ae"
+    CodeGenerator__gen_match_string(this, node, indent);
+
+#line 1259 "./compiler/codegen.ae"
+    return;
+  } 
+
+#line 1262 "./compiler/codegen.ae"
+  CodeGenerator__indent(this, indent);
+
+#line 1263 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "switch (");
+
+#line 1264 "./compiler/codegen.ae"
+  CodeGenerator__gen_expression(this, stmt->expr);
+
+#line 1265 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), ") {\n");
+
+#line 1267 "./compiler/codegen.ae"
+  Vector *cases = stmt->cases;
+
+#line 1268 "./compiler/codegen.ae"
+  for (i32 i = 0; (i < cases->size); i += 1) {
+
+#line 1269 "./compiler/codegen.ae"
+    MatchCase *_case = ((MatchCase *)Vector__at(cases, i));
+
+#line 1270 "./compiler/codegen.ae"
+    CodeGenerator__indent(this, (indent + 1));
+
+#line 1271 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), "case ");
+
+#line 1272 "./compiler/codegen.ae"
+    CodeGenerator__gen_expression(this, _case->cond);
+
+#line 1273 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), ":");
+
+#line 1274 "./compiler/codegen.ae"
+    if (((bool)_case->body)) {
+
+#line 1275 "./compiler/codegen.ae"
+      CodeGenerator__gen_match_case_body(this, node, _case->body, indent);
+
+#line 1276 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), " break;\n");
+    }  else {
+
+#line 1279 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "\n");
+    } 
+  } 
+
+#line 1282 "./compiler/codegen.ae"
+  if (((bool)stmt->defolt)) {
+
+#line 1283 "./compiler/codegen.ae"
+    CodeGenerator__indent(this, (indent + 1));
+
+#line 1284 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), "default:");
+
+#line 1285 "./compiler/codegen.ae"
+    CodeGenerator__gen_match_case_body(this, node, stmt->defolt, indent);
+
+#line 1286 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), " break;\n");
+  } 
+
+#line 1288 "./compiler/codegen.ae"
+  CodeGenerator__indent(this, indent);
+
+#line 1289 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "}\n");
+}
+
+
+#line 1292 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_yield_expression(CodeGenerator *this, AST *expr, i32 indent) {
+
+#line 1293 "./compiler/codegen.ae"
+  void *yield_var = Vector__back(this->yield_vars);
+
+#line 1294 "./compiler/codegen.ae"
+  CodeGenerator__indent(this, indent);
+
+#line 1295 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), yield_var);
+
+#line 1296 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), " = ");
+
+#line 1297 "./compiler/codegen.ae"
+  CodeGenerator__gen_expression(this, expr);
+
+#line 1298 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), ";\n");
+}
+
+
+#line 1301 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_statement(CodeGenerator *this, AST *node, i32 indent) {
+
+#line 1302 "./compiler/codegen.ae"
+  CodeGenerator__gen_debug_info(this, node->span);
+
+#line 1303 "./compiler/codegen.ae"
+  switch (node->type) {
+    case ASTType__Match: {
+
+#line 1304 "./compiler/codegen.ae"
+      CodeGenerator__gen_match(this, node, indent);
+    } break;
+    case ASTType__Yield: {
+
+#line 1305 "./compiler/codegen.ae"
+      CodeGenerator__gen_yield_expression(this, node->u.unary, indent);
+    } break;
+    case ASTType__Return: {
+
+#line 1307 "./compiler/codegen.ae"
+      CodeGenerator__indent(this, indent);
+
+#line 1308 "./compiler/codegen.ae"
+      if (((bool)this->generator)) {
+
+#line 1309 "./compiler/codegen.ae"
+        Buffer__puts((&this->out), "{ __gen->__state = -1; return false; }\n");
+
+#line 1310 "./compiler/codegen.ae"
+        return;
+      } 
+
+#line 1312 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "return");
+
+#line 1313 "./compiler/codegen.ae"
+      if (((bool)node->u.unary)) {
+
+#line 1314 "./compiler/codegen.ae"
+        Buffer__puts((&this->out), " ");
+
+#line 1315 "./compiler/codegen.ae"
+        CodeGenerator__gen_expression(this, node->u.unary);
+      } 
+
+#line 1317 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), ";\n");
+    } break;
+    case ASTType__GeneratorYield: {
+
+#line 1320 "./compiler/codegen.ae"
+      if ((this->scratch_depth > 0)) {
+
+#line 1321 "./compiler/codegen.ae"
+        CodeGenerator__error(this, Error__new(node->span, "Cannot yield from a generator inside a scratch block"));
+      } 
+
+#line 1324 "./compiler/codegen.ae"
+      this->resume_points += 1;
+
+#line 1325 "./compiler/codegen.ae"
+      CodeGenerator__indent(this, indent);
+
+#line 1326 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "{\n");
+
+#line 1327 "./compiler/codegen.ae"
+      CodeGenerator__indent(this, (indent + 1));
+
+#line 1328 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "__gen->value = ");
+
+#line 1329 "./compiler/codegen.ae"
+      CodeGenerator__gen_expression(this, node->u.unary);
+
+#line 1330 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), ";\n");
+
+#line 1331 "./compiler/codegen.ae"
+      CodeGenerator__indent(this, (indent + 1));
+
+#line 1332 "./compiler/codegen.ae"
+      ({ Buffer *__fmt_buf = (&this->out); Buffer__puts(__fmt_buf, "__gen->__state = "); Buffer__put_i64(__fmt_buf, this->resume_points); Buffer__puts(__fmt_buf, ";\n"); });
+
+#line 1333 "./compiler/codegen.ae"
+      CodeGenerator__indent(this, (indent + 1));
+
+#line 1334 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "return true;\n");
+
+#line 1335 "./compiler/codegen.ae"
+      CodeGenerator__indent(this, indent);
+
+#line 1336 "./compiler/codegen.ae"
+      ({ Buffer *__fmt_buf = (&this->out); Buffer__puts(__fmt_buf, "__resume_"); Buffer__put_i64(__fmt_buf, this->resume_points); Buffer__puts(__fmt_buf, ":;\n"); });
+
+#line 1337 "./compiler/codegen.ae"
+      CodeGenerator__indent(this, indent);
+
+#line 1338 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "}\n");
+    } break;
+    case ASTType__Break: {
+
+#line 1341 "./compiler/codegen.ae"
+      CodeGenerator__indent(this, indent);
+
+#line 1342 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "break;\n");
+    } break;
+    case ASTType__Continue: {
+
+#line 1345 "./compiler/codegen.ae"
+      CodeGenerator__indent(this, indent);
+
+#line 1346 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "continue;\n");
+    } break;
+    case ASTType__VarDeclaration: {
+
+#line 1349 "./compiler/codegen.ae"
+      CodeGenerator__indent(this, indent);
+
+#line 1350 "./compiler/codegen.ae"
+      CodeGenerator__gen_var_decl(this, node, false);
+
+#line 1351 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), ";\n");
+    } break;
+    case ASTType__If: {
+
+#line 1354 "./compiler/codegen.ae"
+      CodeGenerator__indent(this, indent);
+
+#line 1355 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "if (");
+
+#line 1356 "./compiler/codegen.ae"
+      CodeGenerator__gen_expression(this, node->u.if_stmt.cond);
+
+#line 1357 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), ") ");
+
+#line 1358 "./compiler/codegen.ae"
+      CodeGenerator__gen_control_body(this, node, node->u.if_stmt.body, indent);
+
+#line 1359 "./compiler/codegen.ae"
+      if (((bool)node->u.if_stmt.els)) {
+
+#line 1360 "./compiler/codegen.ae"
+        Buffer__puts((&this->out), " else ");
+
+#line 1361 "./compiler/codegen.ae"
+        CodeGenerator__gen_control_body(this, node, node->u.if_stmt.els, indent);
+      } 
+
+#line 1363 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "\n");
+    } break;
+    case ASTType__While: {
+
+#line 1366 "./compiler/codegen.ae"
+      CodeGenerator__indent(this, indent);
+
+#line 1367 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "while (");
+
+#line 1368 "./compiler/codegen.ae"
+      CodeGenerator__gen_expression(this, node->u.loop->cond);
+
+#line 1369 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), ") ");
+
+#line 1370 "./compiler/codegen.ae"
+      CodeGenerator__gen_control_body(this, node, node->u.loop->body, indent);
+
+#line 1371 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "\n");
+    } break;
+    case ASTType__For: {
+
+#line 1374 "./compiler/codegen.ae"
+      CodeGenerator__indent(this, indent);
+
+#line 1375 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "for (");
+
+#line 1376 "./compiler/codegen.ae"
+      if (((bool)node->u.loop->init)) {
+
+#line 1377 "./compiler/codegen.ae"
+        if (node->u.loop->init->type == ASTType__VarDeclaration) {
+
+#line 1378 "./compiler/codegen.ae"
+          CodeGenerator__gen_var_decl(this, node->u.loop->init, false);
+        }  else {
+
+#line 1380 "./compiler/codegen.ae"
+          CodeGenerator__gen_expression(this, node->u.loop->init);
+        } 
+      } 
+
+#line 1383 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "; ");
+
+#line 1384 "./compiler/codegen.ae"
+      if (((bool)node->u.loop->cond)) {
+
+#line 1385 "./compiler/codegen.ae"
+        CodeGenerator__gen_expression(this, node->u.loop->cond);
+      } 
+
+#line 1387 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "; ");
+
+#line 1388 "./compiler/codegen.ae"
+      if (((bool)node->u.loop->incr)) {
+
+#line 1389 "./compiler/codegen.ae"
+        CodeGenerator__gen_expression(this, node->u.loop->incr);
+      } 
+
+#line 1391 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), ") ");
+
+#line 1392 "./compiler/codegen.ae"
+      CodeGenerator__gen_control_body(this, node, node->u.loop->body, indent);
+
+#line 1393 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "\n");
+    } break;
+    case ASTType__ForIn: {
+
+#line 1395 "./compiler/codegen.ae"
+      CodeGenerator__gen_for_in(this, node, indent);
+    } break;
+    case ASTType__Block: {
+
+#line 1397 "./compiler/codegen.ae"
+      CodeGenerator__indent(this, indent);
+
+#line 1398 "./compiler/codegen.ae"
+      CodeGenerator__gen_block(this, node, indent);
+
+#line 1399 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "\n");
+    } break;
+    case ASTType__Scratch: {
+
+#line 1404 "./compiler/codegen.ae"
+      CodeGenerator__indent(this, indent);
+
+#line 1405 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "{\n");
+
+#line 1406 "./compiler/codegen.ae"
+      CodeGenerator__indent(this, (indent + 1));
+
+#line 1407 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "aecor_scratch_mark __scratch_mark __attribute__((cleanup(aecor_scratch_restore))) = aecor_scratch_save();\n");
+
+#line 1408 "./compiler/codegen.ae"
+      this->scratch_depth += 1;
+
+#line 1409 "./compiler/codegen.ae"
+      CodeGenerator__gen_statement(this, node->u.unary, (indent + 1));
+
+#line 1410 "./compiler/codegen.ae"
+      this->scratch_depth -= 1;
+
+#line 1411 "./compiler/codegen.ae"
+      CodeGenerator__indent(this, indent);
+
+#line 1412 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "}\n");
+    } break;
+    default: {
+
+#line 1415 "./compiler/codegen.ae"
+      CodeGenerator__indent(this, indent);
+
+#line 1416 "./compiler/codegen.ae"
+      CodeGenerator__gen_expression(this, node);
+
+#line 1417 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), ";\n");
+    } break;
+  }
+}
+
+
+#line 1422 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_block(CodeGenerator *this, AST *node, i32 indent) {
+
+#line 1423 "./compiler/codegen.ae"
+  CodeGenerator__push_scope(this);
+
+#line 1424 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "{\n");
+
+#line 1426 "./compiler/codegen.ae"
+  Vector *statements = node->u.block.statements;
+
+#line 1427 "./compiler/codegen.ae"
+  for (i32 i = 0; (i < statements->size); i += 1) {
+
+#line 1428 "./compiler/codegen.ae"
+    AST *statement = ((AST *)Vector__at(statements, i));
+
+#line 1429 "./compiler/codegen.ae"
+    CodeGenerator__gen_statement(this, statement, (indent + 1));
+  } 
+
+#line 1432 "./compiler/codegen.ae"
+  Vector *defers = CodeGenerator__scope(this);
+
+#line 1433 "./compiler/codegen.ae"
+  if ((defers->size > 0)) {
+
+#line 1434 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), "\n");
+
+#line 1435 "./compiler/codegen.ae"
+    CodeGenerator__indent(this, (indent + 1));
+
+#line 1436 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), "/* defers */\n");
+
+#line 1437 "./compiler/codegen.ae"
+    for (i32 i = (defers->size - 1); (i >= 0); i -= 1) {
+
+#line 1438 "./compiler/codegen.ae"
+      AST *node = ((AST *)Vector__at(defers, i));
+
+#line 1439 "./compiler/codegen.ae"
+      CodeGenerator__gen_statement(this, node, (indent + 1));
+    } 
+  } 
+
+#line 1443 "./compiler/codegen.ae"
+  CodeGenerator__indent(this, indent);
+
+#line 1444 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "}");
+
+#line 1445 "./compiler/codegen.ae"
+  CodeGenerator__pop_scope(this);
+}
+
+
+#line 1448 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_struct_decls(CodeGenerator *this, Program *program) {
+
+#line 1449 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "/* struct declarations */\n");
+
+#line 1450 "./compiler/codegen.ae"
+  for (i32 i = 0; (i < program->structures->size); i += 1) {
+
+#line 1451 "./compiler/codegen.ae"
+    Structure *struc = ((Structure *)Vector__at(program->structures, i));
+
+#line 1452 "./compiler/codegen.ae"
+    if (struc->is_extern) 
+
+#line 1452 "./compiler/codegen.ae"
+    continue;
+    
+
+#line 1454 "./compiler/codegen.ae"
+    char *name = struc->name;
+
+#line 1455 "./compiler/codegen.ae"
+    if (struc->is_enum) {
+
+#line 1456 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "typedef enum ");
+    }  else 
+#line 1457 "./compiler/codegen.ae"
+    if (struc->is_union) {
+
+#line 1458 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "typedef union ");
+    }  else {
+
+#line 1460 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "typedef struct ");
+    } 
+    
+
+#line 1462 "./compiler/codegen.ae"
+    ({ Buffer *__fmt_buf = (&this->out); Buffer__put_str(__fmt_buf, name); Buffer__puts(__fmt_buf, " "); Buffer__put_str(__fmt_buf, name); Buffer__puts(__fmt_buf, ";\n"); });
+  } 
+
+#line 1464 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "\n");
+}
+
+
+#line 1467 "./compiler/codegen.ae"
+static __attribute__((unused)) void string__replace(char **this, char *other) {
+
+#line 1468 "./compiler/codegen.ae"
+  char *s = (*this);
+
+#line 1469 "./compiler/codegen.ae"
+  free(s);
+
+#line 1470 "./compiler/codegen.ae"
+  (*this) = other;
+}
+
+
+#line 1473 "./compiler/codegen.ae"
+static __attribute__((unused)) char *CodeGenerator__get_type_name_string(CodeGenerator *this, Type *type, char *name, bool is_func_def) {
+
+#line 1476 "./compiler/codegen.ae"
+  char *final = strdup(name);
+
+#line 1478 "./compiler/codegen.ae"
+  for (Type *cur = type; ((bool)cur); cur = cur->ptr) {
+
+#line 1479 "./compiler/codegen.ae"
+    switch (cur->base) {
+      case BaseType__Void:
+      case BaseType__Bool:
+      case BaseType__Char:
+      case BaseType__I8:
+      case BaseType__I16:
+      case BaseType__I32:
+      case BaseType__I64:
+      case BaseType__U8:
+      case BaseType__U16:
+      case BaseType__U32:
+      case BaseType__U64:
+      case BaseType__F32:
+      case BaseType__F64: {
+
+#line 1484 "./compiler/codegen.ae"
+        string__replace((&final), format_string("%s %s", BaseType__str(cur->base), final));
+      } break;
+      case BaseType__Simd: {
+
+#line 1488 "./compiler/codegen.ae"
+        string__replace((&final), format_string("aecor_%s %s", Type__str(cur), final));
+
+#line 1489 "./compiler/codegen.ae"
+        string__strip_trailing_whitespace(final);
+
+#line 1490 "./compiler/codegen.ae"
+        return final;
+      } break;
+      case BaseType__Structure: {
+
+#line 1494 "./compiler/codegen.ae"
+        char *struct_name = ({ char *__yield_0;
+
+#line 1494 "./compiler/codegen.ae"
+  if (cur->struct_def->is_extern) {
+
+#line 1495 "./compiler/codegen.ae"
+    __yield_0 = cur->struct_def->extern_name;
+  }  else {
+
+#line 1497 "./compiler/codegen.ae"
+    __yield_0 = cur->struct_def->name;
+  } 
+;__yield_0; });
+
+#line 1499 "./compiler/codegen.ae"
+        string__replace((&final), format_string("%s %s", struct_name, final));
+      } break;
+      case BaseType__Pointer: {
+
+#line 1503 "./compiler/codegen.ae"
+        bool needs_parens = (((bool)cur->ptr) && (cur->ptr->base == BaseType__Array || cur->ptr->base == BaseType__Function));
+
+#line 1506 "./compiler/codegen.ae"
+        if (needs_parens) {
+
+#line 1507 "./compiler/codegen.ae"
+          string__replace((&final), format_string("(*%s)", final));
+        }  else {
+
+#line 1509 "./compiler/codegen.ae"
+          string__replace((&final), format_string("*%s", final));
+        } 
+      } break;
+      case BaseType__Array: {
+
+#line 1514 "./compiler/codegen.ae"
+        Buffer prev_builder = this->out;
+
+#line 1516 "./compiler/codegen.ae"
+        this->out = Buffer__make();
+
+#line 1517 "./compiler/codegen.ae"
+        CodeGenerator__gen_expression(this, cur->size_expr);
+
+#line 1518 "./compiler/codegen.ae"
+        string__replace((&final), format_string("%s[%s]", final, Buffer__str((&this->out))));
+
+#line 1519 "./compiler/codegen.ae"
+        free(this->out.data);
+
+#line 1520 "./compiler/codegen.ae"
+        this->out = prev_builder;
+      } break;
+      case BaseType__Function:
+      case BaseType__Method: {
+
+#line 1523 "./compiler/codegen.ae"
+        Buffer acc = Buffer__make();
+
+#line 1524 "./compiler/codegen.ae"
+        Vector *params = cur->params;
+
+#line 1526 "./compiler/codegen.ae"
+        if (params->size == 0) 
+
+#line 1526 "./compiler/codegen.ae"
+        Buffer__puts((&acc), "void");
+        
+
+#line 1527 "./compiler/codegen.ae"
+        for (i32 i = 0; (i < params->size); i += 1) {
+
+#line 1528 "./compiler/codegen.ae"
+          if ((i != 0)) 
+
+#line 1528 "./compiler/codegen.ae"
+          Buffer__puts((&acc), ", ");
+          
+
+#line 1529 "./compiler/codegen.ae"
+          Variable *var = ((Variable *)Vector__at(params, i));
+
+#line 1530 "./compiler/codegen.ae"
+          if (var->by_ref) {
+
+#line 1531 "./compiler/codegen.ae"
+            char *arg_str = CodeGenerator__get_type_name_string(this, var->type, format_string("*%s", var->name), false);
+
+#line 1532 "./compiler/codegen.ae"
+            ({ Buffer *__fmt_buf = (&acc); Buffer__puts(__fmt_buf, "const "); Buffer__put_str(__fmt_buf, arg_str); });
+          }  else {
+
+#line 1534 "./compiler/codegen.ae"
+            char *arg_str = CodeGenerator__get_type_name_string(this, var->type, var->name, false);
+
+#line 1535 "./compiler/codegen.ae"
+            Buffer__putsf((&acc), arg_str);
+          } 
+        } 
+
+#line 1538 "./compiler/codegen.ae"
+        if ((is_func_def && cur == type)) {
+
+#line 1540 "./compiler/codegen.ae"
+          string__replace((&final), format_string("%s(%s)", final, Buffer__str((&acc))));
+        }  else {
+
+#line 1542 "./compiler/codegen.ae"
+          string__replace((&final), format_string("(*%s)(%s)", final, Buffer__str((&acc))));
+        } 
+
+#line 1544 "./compiler/codegen.ae"
+        free(acc.data);
+
+#line 1545 "./compiler/codegen.ae"
+        string__replace((&final), CodeGenerator__get_type_name_string(this, cur->return_type, final, false));
+      } break;
+      case BaseType__Error: panic("Internal error: Error type in codegen"); break;
+    }
+  } 
+
+#line 1554 "./compiler/codegen.ae"
+  string__strip_trailing_whitespace(final);
+
+#line 1555 "./compiler/codegen.ae"
+  return final;
+}
+
+
+#line 1558 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_type_and_name(CodeGenerator *this, Type *type, char *name) {
+
+#line 1559 "./compiler/codegen.ae"
+  Buffer__putsf((&this->out), CodeGenerator__get_type_name_string(this, type, name, false));
+}
+
+
+#line 1562 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_type(CodeGenerator *this, Type *type) {
+
+#line 1563 "./compiler/codegen.ae"
+  CodeGenerator__gen_type_and_name(this, type, "");
+}
+
+
+#line 1566 "./compiler/codegen.ae"
+static __attribute__((unused)) char *CodeGenerator__get_function_name(CodeGenerator *this, Function *func) {
+
+#line 1567 "./compiler/codegen.ae"
+  return ({ char *__yield_0;
+
+#line 1567 "./compiler/codegen.ae"
+  if (func->is_extern) {
+
+#line 1568 "./compiler/codegen.ae"
+    __yield_0 = func->extern_name;
+  }  else     __yield_0 = ({ char *__yield_1;
+
+#line 1569 "./compiler/codegen.ae"
+  if (func->is_method) {
+
+#line 1570 "./compiler/codegen.ae"
+    __yield_1 = format_string("%s__%s", func->method_struct_name, func->name);
+  }  else {
+
+#line 1572 "./compiler/codegen.ae"
+    __yield_1 = func->name;
+  } 
+;__yield_1; });
+  
+;__yield_0; });
+}
+
+
+#line 1576 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_function_decl(CodeGenerator *this, Function *func) {
+
+#line 1581 "./compiler/codegen.ae"
+  bool is_main = ((!func->is_method) && string__eq(func->name, "main"));
+
+#line 1582 "./compiler/codegen.ae"
+  if (((!is_main) && (!func->is_export))) {
+
+#line 1583 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), "static ");
+
+#line 1584 "./compiler/codegen.ae"
+    if (func->is_inline) 
+
+#line 1584 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), "inline ");
+    
+
+#line 1585 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), "__attribute__((unused)) ");
+  } 
+
+#line 1588 "./compiler/codegen.ae"
+  if (func->exits) 
+
+#line 1589 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "__attribute__((noreturn)) ");
+  
+
+#line 1590 "./compiler/codegen.ae"
+  if (func->is_inline) 
+
+#line 1591 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "__attribute__((always_inline)) ");
+  
+
+#line 1592 "./compiler/codegen.ae"
+  if (func->is_noinline) 
+
+#line 1593 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "__attribute__((noinline)) ");
+  
+
+#line 1594 "./compiler/codegen.ae"
+  if (func->is_hot) 
+
+#line 1595 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "__attribute__((hot)) ");
+  
+
+#line 1596 "./compiler/codegen.ae"
+  if (func->is_cold) 
+
+#line 1597 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "__attribute__((cold)) ");
+  
+
+#line 1598 "./compiler/codegen.ae"
+  if (func->is_pure) 
+
+#line 1599 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "__attribute__((pure)) ");
+  
+
+#line 1601 "./compiler/codegen.ae"
+  char *func_name = CodeGenerator__get_function_name(this, func);
+
+#line 1602 "./compiler/codegen.ae"
+  char *s = CodeGenerator__get_type_name_string(this, func->type, func_name, true);
+
+#line 1603 "./compiler/codegen.ae"
+  Buffer__putsf((&this->out), s);
+}
+
+
+#line 1606 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_function_decls(CodeGenerator *this, Program *program) {
+
+#line 1607 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "/* function declarations */\n");
+
+#line 1608 "./compiler/codegen.ae"
+  for (i32 i = 0; (i < program->functions->size); i += 1) {
+
+#line 1609 "./compiler/codegen.ae"
+    Function *func = ((Function *)Vector__at(program->functions, i));
+
+#line 1610 "./compiler/codegen.ae"
+    if ((!func->is_extern)) {
+
+#line 1611 "./compiler/codegen.ae"
+      CodeGenerator__gen_function_decl(this, func);
+
+#line 1612 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), ";\n");
+    } 
+  } 
+
+#line 1615 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "\n");
+}
+
+
+#line 1620 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_generator_start(CodeGenerator *this, Function *func, i32 indent) {
+
+#line 1621 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "{\n");
+
+#line 1622 "./compiler/codegen.ae"
+  CodeGenerator__indent(this, (indent + 1));
+
+#line 1623 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "return (");
+
+#line 1624 "./compiler/codegen.ae"
+  CodeGenerator__gen_type(this, func->return_type);
+
+#line 1625 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "){");
+
+#line 1626 "./compiler/codegen.ae"
+  for (i32 i = 0; (i < func->params->size); i += 1) {
+
+#line 1627 "./compiler/codegen.ae"
+    Variable *param = ((Variable *)Vector__at(func->params, i));
+
+#line 1628 "./compiler/codegen.ae"
+    if ((i > 0)) 
+
+#line 1628 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), ", ");
+    
+
+#line 1629 "./compiler/codegen.ae"
+    ({ Buffer *__fmt_buf = (&this->out); Buffer__puts(__fmt_buf, "."); Buffer__put_str(__fmt_buf, param->frame_name); Buffer__puts(__fmt_buf, " = "); Buffer__put_str(__fmt_buf, param->name); });
+  } 
+
+#line 1631 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "};\n");
+
+#line 1632 "./compiler/codegen.ae"
+  CodeGenerator__indent(this, indent);
+
+#line 1633 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "}");
+}
+
+
+#line 1638 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_generator_next(CodeGenerator *this, Function *func, i32 indent) {
+
+#line 1639 "./compiler/codegen.ae"
+  Function *generator = func->generator;
+
+#line 1640 "./compiler/codegen.ae"
+  this->generator = generator;
+
+#line 1641 "./compiler/codegen.ae"
+  this->resume_points = 0;
+
+#line 1644 "./compiler/codegen.ae"
+  Buffer out = this->out;
+
+#line 1645 "./compiler/codegen.ae"
+  this->out = Buffer__make();
+
+#line 1646 "./compiler/codegen.ae"
+  CodeGenerator__indent(this, (indent + 1));
+
+#line 1647 "./compiler/codegen.ae"
+  CodeGenerator__gen_block(this, generator->body, (indent + 1));
+
+#line 1648 "./compiler/codegen.ae"
+  Buffer body = this->out;
+
+#line 1649 "./compiler/codegen.ae"
+  this->out = out;
+
+#line 1651 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "{\n");
+
+#line 1652 "./compiler/codegen.ae"
+  CodeGenerator__indent(this, (indent + 1));
+
+#line 1653 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "switch (__gen->__state) {\n");
+
+#line 1654 "./compiler/codegen.ae"
+  CodeGenerator__indent(this, (indent + 2));
+
+#line 1655 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "case 0: break;\n");
+
+#line 1656 "./compiler/codegen.ae"
+  for (i32 i = 1; (i <= this->resume_points); i += 1) {
+
+#line 1657 "./compiler/codegen.ae"
+    CodeGenerator__indent(this, (indent + 2));
+
+#line 1658 "./compiler/codegen.ae"
+    ({ Buffer *__fmt_buf = (&this->out); Buffer__puts(__fmt_buf, "case "); Buffer__put_i64(__fmt_buf, i); Buffer__puts(__fmt_buf, ": goto __resume_"); Buffer__put_i64(__fmt_buf, i); Buffer__puts(__fmt_buf, ";\n"); });
+  } 
+
+#line 1660 "./compiler/codegen.ae"
+  CodeGenerator__indent(this, (indent + 2));
+
+#line 1661 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "default: return false;\n");
+
+#line 1662 "./compiler/codegen.ae"
+  CodeGenerator__indent(this, (indent + 1));
+
+#line 1663 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "}\n");
+
+#line 1664 "./compiler/codegen.ae"
+  Buffer__putbf((&this->out), (&body));
+
+#line 1665 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "\n");
+
+#line 1666 "./compiler/codegen.ae"
+  CodeGenerator__indent(this, (indent + 1));
+
+#line 1667 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "__gen->__state = -1;\n");
+
+#line 1668 "./compiler/codegen.ae"
+  CodeGenerator__indent(this, (indent + 1));
+
+#line 1669 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "return false;\n");
+
+#line 1670 "./compiler/codegen.ae"
+  CodeGenerator__indent(this, indent);
+
+#line 1671 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "}");
+
+#line 1672 "./compiler/codegen.ae"
+  this->generator = NULL;
+}
+
+
+#line 1675 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_function_body(CodeGenerator *this, Function *func, i32 indent) {
+
+#line 1676 "./compiler/codegen.ae"
+  if (((bool)func->yield_type)) {
+
+#line 1677 "./compiler/codegen.ae"
+    CodeGenerator__gen_generator_start(this, func, indent);
+  }  else 
+#line 1678 "./compiler/codegen.ae"
+  if (((bool)func->generator)) {
+
+#line 1679 "./compiler/codegen.ae"
+    CodeGenerator__gen_generator_next(this, func, indent);
+  }  else 
+#line 1680 "./compiler/codegen.ae"
+  if (func->is_arrow) {
+
+#line 1681 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), "{\n");
+
+#line 1682 "./compiler/codegen.ae"
+    CodeGenerator__gen_statement(this, func->body, (indent + 1));
+
+#line 1683 "./compiler/codegen.ae"
+    CodeGenerator__indent(this, indent);
+
+#line 1684 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), "}");
+  }  else {
+
+#line 1686 "./compiler/codegen.ae"
+    CodeGenerator__gen_block(this, func->body, indent);
+  } 
+  
+  
+}
+
+
+#line 1690 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_function(CodeGenerator *this, Function *func) {
+
+#line 1691 "./compiler/codegen.ae"
+  if (func->is_extern) 
+
+#line 1691 "./compiler/codegen.ae"
+  return;
+  
+
+#line 1692 "./compiler/codegen.ae"
+  CodeGenerator__gen_debug_info(this, func->span);
+
+#line 1693 "./compiler/codegen.ae"
+  CodeGenerator__gen_function_decl(this, func);
+
+#line 1694 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), " ");
+
+#line 1695 "./compiler/codegen.ae"
+  if (this->instrument) {
+
+#line 1697 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), "{\n");
+
+#line 1698 "./compiler/codegen.ae"
+    CodeGenerator__indent(this, 1);
+
+#line 1699 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), "aecor_prof_frame __aecor_prof __attribute__((cleanup(aecor_prof_exit)));\n");
+
+#line 1700 "./compiler/codegen.ae"
+    CodeGenerator__indent(this, 1);
+
+#line 1701 "./compiler/codegen.ae"
+    ({ Buffer *__fmt_buf = (&this->out); Buffer__puts(__fmt_buf, "aecor_prof_enter(&__aecor_prof, "); Buffer__put_i64(__fmt_buf, this->instrumented->size); Buffer__puts(__fmt_buf, ");\n"); });
+
+#line 1702 "./compiler/codegen.ae"
+    Vector__push(this->instrumented, func);
+
+#line 1703 "./compiler/codegen.ae"
+    CodeGenerator__indent(this, 1);
+
+#line 1704 "./compiler/codegen.ae"
+    CodeGenerator__gen_function_body(this, func, 1);
+
+#line 1705 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), "\n}");
+  }  else {
+
+#line 1707 "./compiler/codegen.ae"
+    CodeGenerator__gen_function_body(this, func, 0);
+  } 
+
+#line 1709 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "\n\n");
+}
+
+
+#line 1714 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_profiling_table(CodeGenerator *this) {
+
+#line 1715 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "/* profiling table */\n");
+
+#line 1716 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "aecor_prof_entry aecor_prof_table[] = {\n");
+
+#line 1717 "./compiler/codegen.ae"
+  for (i32 i = 0; (i < this->instrumented->size); i += 1) {
+
+#line 1718 "./compiler/codegen.ae"
+    Function *func = ((Function *)Vector__at(this->instrumented, i));
+
+#line 1719 "./compiler/codegen.ae"
+    CodeGenerator__indent(this, 1);
+
+#line 1720 "./compiler/codegen.ae"
+    if (func->is_method) {
+
+#line 1721 "./compiler/codegen.ae"
+      ({ Buffer *__fmt_buf = (&this->out); Buffer__puts(__fmt_buf, "{\""); Buffer__put_str(__fmt_buf, func->method_struct_name); Buffer__puts(__fmt_buf, "::"); Buffer__put_str(__fmt_buf, func->name); Buffer__puts(__fmt_buf, "\", "); });
+    }  else {
+
+#line 1723 "./compiler/codegen.ae"
+      ({ Buffer *__fmt_buf = (&this->out); Buffer__puts(__fmt_buf, "{\""); Buffer__put_str(__fmt_buf, func->name); Buffer__puts(__fmt_buf, "\", "); });
+    } 
+
+#line 1725 "./compiler/codegen.ae"
+    ({ Buffer *__fmt_buf = (&this->out); Buffer__puts(__fmt_buf, "\""); Buffer__put_str(__fmt_buf, Location__str(func->span.start)); Buffer__puts(__fmt_buf, "\"},\n"); });
+  } 
+
+#line 1727 "./compiler/codegen.ae"
+  CodeGenerator__indent(this, 1);
+
+#line 1728 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "{0},\n};\n");
+
+#line 1729 "./compiler/codegen.ae"
+  ({ Buffer *__fmt_buf = (&this->out); Buffer__puts(__fmt_buf, "u32 aecor_prof_count = "); Buffer__put_i64(__fmt_buf, this->instrumented->size); Buffer__puts(__fmt_buf, ";\n"); });
+}
+
+
+#line 1732 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_global_vars(CodeGenerator *this, Program *program) {
+
+#line 1733 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "/* global variables */\n");
+
+#line 1734 "./compiler/codegen.ae"
+  for (i32 i = 0; (i < program->global_vars->size); i += 1) {
+
+#line 1735 "./compiler/codegen.ae"
+    AST *node = ((AST *)Vector__at(program->global_vars, i));
+
+#line 1736 "./compiler/codegen.ae"
+    if ((!node->u.var_decl.var->is_extern)) {
+
+#line 1737 "./compiler/codegen.ae"
+      CodeGenerator__gen_statement(this, node, 0);
+    } 
+  } 
+
+#line 1740 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "\n");
+}
+
+
+#line 1743 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_constants(CodeGenerator *this, Program *program) {
+
+#line 1744 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "/* constants */\n");
+
+#line 1745 "./compiler/codegen.ae"
+  for (i32 i = 0; (i < program->constants->size); i += 1) {
+
+#line 1746 "./compiler/codegen.ae"
+    AST *node = ((AST *)Vector__at(program->constants, i));
+
+#line 1747 "./compiler/codegen.ae"
+    if ((!node->u.var_decl.var->is_extern)) {
+
+#line 1748 "./compiler/codegen.ae"
+      CodeGenerator__gen_var_decl(this, node, true);
+
+#line 1749 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), ";\n");
+    } 
+  } 
+
+#line 1752 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "\n");
+}
+
+
+#line 1755 "./compiler/codegen.ae"
+static __attribute__((unused)) void CodeGenerator__gen_embed_headers(CodeGenerator *this, Program *program) {
+
+#line 1756 "./compiler/codegen.ae"
+  if ((!Vector__empty(program->c_embed_headers))) {
+
+#line 1757 "./compiler/codegen.ae"
+    for (i32 i = 0; (i < program->c_embed_headers->size); i += 1) {
+
+#line 1758 "./compiler/codegen.ae"
+      char *filename = ((char *)Vector__at(program->c_embed_headers, i));
+
+#line 1759 "./compiler/codegen.ae"
+      ({ Buffer *__fmt_buf = (&this->out); Buffer__puts(__fmt_buf, "/***************** embed '"); Buffer__put_str(__fmt_buf, filename); Buffer__puts(__fmt_buf, "' *****************/\n"); });
+
+#line 1761 "./compiler/codegen.ae"
+      FILE *file = File__open(filename, "r");
+
+#line 1762 "./compiler/codegen.ae"
+      ;
+
+#line 1764 "./compiler/codegen.ae"
+      char *contents = File__slurp(file);
+
+#line 1765 "./compiler/codegen.ae"
+      ;
+
+#line 1767 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), contents);
+
+#line 1768 "./compiler/codegen.ae"
+      Buffer__puts((&this->out), "\n\n");
+
+      /* defers */
+
+#line 1765 "./compiler/codegen.ae"
+      free(contents);
+
+#line 1762 "./compiler/codegen.ae"
+      fclose(file);
+    } 
+  } 
+}
+
+
+#line 1773 "./compiler/codegen.ae"
+static __attribute__((unused)) char *CodeGenerator__gen_program(CodeGenerator *this, Program *program) {
+
+#line 1774 "./compiler/codegen.ae"
+  this->program = program;
+
+#line 1775 "./compiler/codegen.ae"
+  if (this->instrument) {
+
+#line 1776 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), "#define AECOR_INSTRUMENT\n");
+  } 
+
+#line 1778 "./compiler/codegen.ae"
+  if (this->track_alloc) {
+
+#line 1779 "./compiler/codegen.ae"
+    Buffer__puts((&this->out), "#define AECOR_TRACK_ALLOC\n");
+  } 
+
+#line 1781 "./compiler/codegen.ae"
+  for (i32 i = 0; (i < program->c_includes->size); i += 1) {
+
+#line 1782 "./compiler/codegen.ae"
+    char *include = ((char *)Vector__at(program->c_includes, i));
+
+#line 1783 "./compiler/codegen.ae"
+    ({ Buffer *__fmt_buf = (&this->out); Buffer__puts(__fmt_buf, "#include \""); Buffer__put_str(__fmt_buf, include); Buffer__puts(__fmt_buf, "\"\n"); });
+  } 
+
+#line 1785 "./compiler/codegen.ae"
+  Buffer__puts((&this->out), "\n");
+
+#line 1787 "./compiler/codegen.ae"
+  CodeGenerator__gen_embed_headers(this, program);
+
+#line 1788 "./compiler/codegen.ae"
+  CodeGenerator__gen_constants(this, program);
+
+#line 1790 "./compiler/codegen.ae"
+  CodeGenerator__gen_struct_decls(this, program);
+
+#line 1791 "./compiler/codegen.ae"
+  for (i32 i = 0; (i < program->structures->size); i += 1) {
+
+#line 1792 "./compiler/codegen.ae"
+    Structure *struc = ((Structure *)Vector__at(program->structures, i));
+
+#line 1793 "./compiler/codegen.ae"
+    if (struc->is_enum) {
+
+#line 1794 "./compiler/codegen.ae"
+      CodeGenerator__gen_enum(this, struc);
+    }  else 
+#line 1795 "./compiler/codegen.ae"
+    if ((!((bool)struc->generator))) {
+
+#line 1796 "./compiler/codegen.ae"
+      CodeGenerator__gen_struct(this, struc);
+    } 
+    
+  } 
+
+#line 1799 "./compiler/codegen.ae"
+  Map *frames_done = Map__new();
+
+#line 1800 "./compiler/codegen.ae"
+  for (i32 i = 0; (i < program->structures->size); i += 1) {
+
+#line 1801 "./compiler/codegen.ae"
+    Structure *struc = ((Structure *)Vector__at(program->structures, i));
+
+#line 1802 "./compiler/codegen.ae"
+    if (((bool)struc->generator)) 
+
+#line 1802 "./compiler/codegen.ae"
+    CodeGenerator__gen_generator_frame(this, struc, frames_done);
+    
+  } 
+
+#line 1804 "./compiler/codegen.ae"
+  Map__free(frames_done);
+
+#line 1806 "./compiler/codegen.ae"
+  mark_ref_params(program);
+
+#line 1807 "./compiler/codegen.ae"
+  CodeGenerator__gen_function_decls(this, program);
+
+#line 1808 "./compiler/codegen.ae"
+  CodeGenerator__gen_global_vars(this, program);
+
+#line 1809 "./compiler/codegen.ae"
+  for (i32 i = 0; (i < program->functions->size); i += 1) {
+
+#line 1810 "./compiler/codegen.ae"
+    Function *func = ((Function *)Vector__at(program->functions, i));
+
+#line 1811 "./compiler/codegen.ae"
+    CodeGenerator__gen_function(this, func);
+  } 
+
+#line 1813 "./compiler/codegen.ae"
+  if (this->instrument) {
+
+#line 1814 "./compiler/codegen.ae"
+    CodeGenerator__gen_profiling_table(this);
+  } 
+
+#line 1816 "./compiler/codegen.ae"
+  return Buffer__str((&this->out));
+}
+
+
+#line 7 "./compiler/main.ae"
+static __attribute__((unused)) void usage(i32 code) {
+
+#line 8 "./compiler/main.ae"
+  printf("--------------------------------------------------------""\n");
+
+#line 9 "./compiler/main.ae"
+  printf("Usage: ./aecor [options] <file>""\n");
+
+#line 10 "./compiler/main.ae"
+  printf("Options:""\n");
+
+#line 11 "./compiler/main.ae"
+  printf("    -o path   Output executable (default: ./out)""\n");
+
+#line 12 "./compiler/main.ae"
+  printf("    -c path   Output C code (default: {out}.c)""\n");
+
+#line 13 "./compiler/main.ae"
+  printf("    -e0       Minimal one-line errors""\n");
+
+#line 14 "./compiler/main.ae"
+  printf("    -e1       Error messages with source code (default)""\n");
+
+#line 15 "./compiler/main.ae"
+  printf("    -e2       Error messages with source / hints""\n");
+
+#line 16 "./compiler/main.ae"
+  printf("    -s        Silent mode (no debug output)""\n");
+
+#line 17 "./compiler/main.ae"
+  printf("    -n        Don't compile C code (default: false)""\n");
+
+#line 18 "./compiler/main.ae"
+  printf("    -d        Emit debug information (default: false)""\n");
+
+#line 19 "./compiler/main.ae"
+  printf("    -b        Buffer output of print/println (default: false)""\n");
+
+#line 20 "./compiler/main.ae"
+  printf("    --release Remove debug_assert checks (default: false)""\n");
+
+#line 21 "./compiler/main.ae"
+  printf("    --instrument""\n");
+
+#line 22 "./compiler/main.ae"
+  printf("              Profile calls to every function, written to""\n");
+
+#line 23 "./compiler/main.ae"
+  printf("              $AECOR_PROFILE (default: aecor_profile.txt)""\n");
+
+#line 24 "./compiler/main.ae"
+  printf("    --track-alloc""\n");
+
+#line 25 "./compiler/main.ae"
+  printf("              Record allocations by call site, written to""\n");
+
+#line 26 "./compiler/main.ae"
+  printf("              $AECOR_ALLOC_REPORT (default: aecor_alloc.txt)""\n");
+
+#line 27 "./compiler/main.ae"
+  printf("    --match-hash-threshold n""\n");
+
+#line 28 "./compiler/main.ae"
+  printf("              Use hashed dispatch for string matches with at""\n");
+
+#line 29 "./compiler/main.ae"
+  printf("              least n cases (default: 4)""\n");
+
+#line 30 "./compiler/main.ae"
+  printf("    --layout-report""\n");
+
+#line 31 "./compiler/main.ae"
+  printf("              Print the size and padding of all structs""\n");
+
+#line 32 "./compiler/main.ae"
+  printf("    -l        Library path (root of aecor repo)""\n");
+
+#line 33 "./compiler/main.ae"
+  printf("                   (Default: working directory)""\n");
+
+#line 34 "./compiler/main.ae"
+  printf("--------------------------------------------------------""\n");
+
+#line 35 "./compiler/main.ae"
+  exit(code);
+}
+
+
+#line 38 "./compiler/main.ae"
+i32 main(i32 argc, char **argv) {
+
+#line 39 "./compiler/main.ae"
+  char *exec_path = "./out";
+
+#line 40 "./compiler/main.ae"
+  char *c_path = ((char *)NULL);
+
+#line 41 "./compiler/main.ae"
+  char *filename = ((char *)NULL);
+
+#line 42 "./compiler/main.ae"
+  bool compile_c = true;
+
+#line 43 "./compiler/main.ae"
+  bool silent = false;
+
+#line 44 "./compiler/main.ae"
+  char *lib_path = ((char *)NULL);
+
+#line 45 "./compiler/main.ae"
+  bool debug = false;
+
+#line 46 "./compiler/main.ae"
+  bool buffer_stdout = false;
+
+#line 47 "./compiler/main.ae"
+  bool release = false;
+
+#line 48 "./compiler/main.ae"
+  bool layout_report = false;
+
+#line 49 "./compiler/main.ae"
+  bool instrument = false;
+
+#line 50 "./compiler/main.ae"
+  bool track_alloc = false;
+
+#line 51 "./compiler/main.ae"
+  i32 match_hash_threshold = MATCH_HASH_THRESHOLD;
+
+#line 52 "./compiler/main.ae"
+  i32 error_level = 1;
+
+#line 54 "./compiler/main.ae"
+  for (i32 i = 1; (i < argc); i += 1) {
+
+#line 55 "./compiler/main.ae"
+    {
+      char *__match_str = argv[i];
+      switch (aecor_hash_str(__match_str, 2166136261u)) {
+        case 2220519670u:
+          if (!strcmp(__match_str, "-h")) goto __match_5_0;
+          break;
+        case 2052918106u:
+          if (!strcmp(__match_str, "-s")) goto __match_5_1;
+          break;
+        case 3645188425u:
+          if (!strcmp(__match_str, "-d")) goto __match_5_2;
+          break;
+        case 1824844442u:
+          if (!strcmp(__match_str, "-b")) goto __match_5_3;
+          break;
+        case 2177488406u:
+          if (!strcmp(__match_str, "--release")) goto __match_5_4;
+          break;
+        case 4259635330u:
+          if (!strcmp(__match_str, "--layout-report")) goto __match_5_5;
+          break;
+        case 1459777661u:
+          if (!strcmp(__match_str, "--instrument")) goto __match_5_6;
+          break;
+        case 43100850u:
+          if (!strcmp(__match_str, "--track-alloc")) goto __match_5_7;
+          break;
+        case 2658285261u:
+          if (!strcmp(__match_str, "-n")) goto __match_5_8;
+          break;
+        case 1726806915u:
+          if (!strcmp(__match_str, "-o")) goto __match_5_9;
+          break;
+        case 99153354u:
+          if (!strcmp(__match_str, "--match-hash-threshold")) goto __match_5_10;
+          break;
+        case 2033358811u:
+          if (!strcmp(__match_str, "-l")) goto __match_5_11;
+          break;
+        case 3638060290u:
+          if (!strcmp(__match_str, "-c")) goto __match_5_12;
+          break;
+        case 1756291605u:
+          if (!strcmp(__match_str, "-e0")) goto __match_5_13;
+          break;
+        case 2568938154u:
+          if (!strcmp(__match_str, "-e1")) goto __match_5_14;
+          break;
+        case 1256510838u:
+          if (!strcmp(__match_str, "-e2")) goto __match_5_15;
+          break;
+      }
+      goto __match_5_default;
+      __match_5_0: {
+
+#line 56 "./compiler/main.ae"
+        usage(0);
+      } goto __match_5_end;
+      __match_5_1: {
+
+#line 57 "./compiler/main.ae"
+        silent = true;
+      } goto __match_5_end;
+      __match_5_2: {
+
+#line 58 "./compiler/main.ae"
+        debug = true;
+      } goto __match_5_end;
+      __match_5_3: {
+
+#line 59 "./compiler/main.ae"
+        buffer_stdout = true;
+      } goto __match_5_end;
+      __match_5_4: {
+
+#line 60 "./compiler/main.ae"
+        release = true;
+      } goto __match_5_end;
+      __match_5_5: {
+
+#line 61 "./compiler/main.ae"
+        layout_report = true;
+      } goto __match_5_end;
+      __match_5_6: {
+
+#line 62 "./compiler/main.ae"
+        instrument = true;
+      } goto __match_5_end;
+      __match_5_7: {
+
+#line 63 "./compiler/main.ae"
+        track_alloc = true;
+      } goto __match_5_end;
+      __match_5_8: {
+
+#line 64 "./compiler/main.ae"
+        compile_c = false;
+      } goto __match_5_end;
+      __match_5_9: {
+
+#line 66 "./compiler/main.ae"
+        i += 1;
+
+#line 67 "./compiler/main.ae"
+        exec_path = argv[i];
+      } goto __match_5_end;
+      __match_5_10: {
+
+#line 70 "./compiler/main.ae"
+        i += 1;
+
+#line 71 "./compiler/main.ae"
+        match_hash_threshold = atoi(argv[i]);
+      } goto __match_5_end;
+      __match_5_11: {
+
+#line 74 "./compiler/main.ae"
+        i += 1;
+
+#line 75 "./compiler/main.ae"
+        lib_path = argv[i];
+      } goto __match_5_end;
+      __match_5_12: {
+
+#line 78 "./compiler/main.ae"
+        i += 1;
+
+#line 79 "./compiler/main.ae"
+        c_path = argv[i];
+      } goto __match_5_end;
+      __match_5_13: {
+
+#line 81 "./compiler/main.ae"
+        error_level = 0;
+      } goto __match_5_end;
+      __match_5_14: {
+
+#line 82 "./compiler/main.ae"
+        error_level = 1;
+      } goto __match_5_end;
+      __match_5_15: {
+
+#line 83 "./compiler/main.ae"
+        error_level = 2;
+      } goto __match_5_end;
+      __match_5_default: {
+
+#line 85 "./compiler/main.ae"
+        if (argv[i][0] == '-') {
+
+#line 86 "./compiler/main.ae"
+          printf("Unknown option: %s""\n", argv[i]);
+
+#line 87 "./compiler/main.ae"
+          usage(1);
+        }  else 
+#line 88 "./compiler/main.ae"
+        if ((!((bool)filename))) {
+
+#line 89 "./compiler/main.ae"
+          filename = argv[i];
+        }  else {
+
+#line 91 "./compiler/main.ae"
+          printf("Unknown option/argument: '%s'""\n", argv[i]);
+
+#line 92 "./compiler/main.ae"
+          usage(1);
+        } 
+        
+      }
+      __match_5_end:;
+    }
+  } 
+
+#line 98 "./compiler/main.ae"
+  if ((!((bool)filename))) {
+
+#line 99 "./compiler/main.ae"
+    printf("No file specified""\n");
+
+#line 100 "./compiler/main.ae"
+    usage(1);
+  } 
+
+#line 103 "./compiler/main.ae"
+  if ((!((bool)c_path))) {
+
+#line 104 "./compiler/main.ae"
+    c_path = format_string("%s.c", exec_path);
+  } 
+
+#line 107 "./compiler/main.ae"
+  Parser *parser = Parser__new(filename);
+
+#line 108 "./compiler/main.ae"
+  if (((bool)lib_path)) {
+
+#line 109 "./compiler/main.ae"
+    Parser__add_include_dir(parser, lib_path);
+  } 
+
+#line 112 "./compiler/main.ae"
+  Program *program = Program__new();
+
+#line 113 "./compiler/main.ae"
+  Parser__include_prelude(parser, program);
+
+#line 114 "./compiler/main.ae"
+  Parser__include_file(parser, program, filename);
+
+#line 116 "./compiler/main.ae"
+  TypeChecker *checker = TypeChecker__new();
+
+#line 117 "./compiler/main.ae"
+  TypeChecker__check_program(checker, program);
+
+#line 119 "./compiler/main.ae"
+  if ((program->errors->size > 0)) {
+
+#line 120 "./compiler/main.ae"
+    display_error_messages(program->errors, error_level);
+
+#line 121 "./compiler/main.ae"
+    exit(1);
+  } 
+
+#line 124 "./compiler/main.ae"
+  if (layout_report) {
+
+#line 125 "./compiler/main.ae"
+    print_layout_report(program);
+  } 
+
+#line 128 "./compiler/main.ae"
+  CodeGenerator generator = CodeGenerator__make(debug, buffer_stdout, release, instrument, track_alloc);
+
+#line 129 "./compiler/main.ae"
+  generator.match_hash_threshold = match_hash_threshold;
+
+#line 130 "./compiler/main.ae"
+  char *c_code = CodeGenerator__gen_program((&generator), program);
+
+#line 132 "./compiler/main.ae"
+  if ((program->errors->size > 0)) {
+
+#line 133 "./compiler/main.ae"
+    display_error_messages(program->errors, error_level);
+
+#line 134 "./compiler/main.ae"
+    exit(1);
+  } 
+
+#line 137 "./compiler/main.ae"
+  FILE *out_file = File__open(c_path, "w");
+
+#line 138 "./compiler/main.ae"
+  File__puts(out_file, c_code);
+
+#line 139 "./compiler/main.ae"
+  fclose(out_file);
+
+#line 141 "./compiler/main.ae"
+  if ((!compile_c)) {
+
+#line 142 "./compiler/main.ae"
+    return 0;
+  } 
+
+#line 145 "./compiler/main.ae"
+  char *cmdbuf = ((char *)calloc(1, 1024));
+
+#line 146 "./compiler/main.ae"
+  strcat(cmdbuf, format_string("gcc -o %s %s", exec_path, c_path));
+
+#line 147 "./compiler/main.ae"
+  for (i32 i = 0; (i < program->c_flags->size); i += 1) {
+
+#line 148 "./compiler/main.ae"
+    char *flag = ((char *)Vector__at(program->c_flags, i));
+
+#line 149 "./compiler/main.ae"
+    strcat(cmdbuf, " ");
+
+#line 150 "./compiler/main.ae"
+    strcat(cmdbuf, flag);
+  } 
+
+#line 152 "./compiler/main.ae"
+  if (debug) {
+
+#line 153 "./compiler/main.ae"
+    strcat(cmdbuf, " -ggdb3");
+  } 
+
+#line 156 "./compiler/main.ae"
+  if ((!silent)) {
+
+#line 157 "./compiler/main.ae"
+    printf("[+] %s""\n", cmdbuf);
+  } 
+
+#line 159 "./compiler/main.ae"
+  i32 code = system(cmdbuf);
+
+#line 160 "./compiler/main.ae"
+  if ((code != 0)) {
+
+#line 161 "./compiler/main.ae"
+    printf("[-] Compilation failed""\n");
+
+#line 162 "./compiler/main.ae"
+    exit(code);
+  } 
+}
+
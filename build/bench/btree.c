@@ -0,0 +1,1990 @@
+#include "stdio.h"
+#include "stdlib.h"
+#include "stdbool.h"
+#include "stdint.h"
+#include "string.h"
+#include "errno.h"
+#include "ctype.h"
+#include "time.h"
+
+/***************** embed './lib/prelude.h' *****************/
+#include "stdarg.h"
+
+typedef int8_t i8;
+typedef int16_t i16;
+typedef int32_t i32;
+typedef int64_t i64;
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+
+typedef float f32;
+typedef double f64;
+
+// SIMD vector types, such as `f32x4`, using GCC's vector extensions
+#define AECOR_SIMD_TYPE(T, lanes) \
+  typedef T aecor_##T##x##lanes __attribute__((vector_size(sizeof(T) * lanes)));
+#define AECOR_SIMD_TYPES(T) \
+  AECOR_SIMD_TYPE(T, 2) AECOR_SIMD_TYPE(T, 4) AECOR_SIMD_TYPE(T, 8) \
+  AECOR_SIMD_TYPE(T, 16) AECOR_SIMD_TYPE(T, 32) AECOR_SIMD_TYPE(T, 64)
+
+AECOR_SIMD_TYPES(i8) AECOR_SIMD_TYPES(i16) AECOR_SIMD_TYPES(i32) AECOR_SIMD_TYPES(i64)
+AECOR_SIMD_TYPES(u8) AECOR_SIMD_TYPES(u16) AECOR_SIMD_TYPES(u32) AECOR_SIMD_TYPES(u64)
+AECOR_SIMD_TYPES(f32) AECOR_SIMD_TYPES(f64)
+
+#ifdef AECOR_TRACK_ALLOC
+// Allocation tracking for `--track-alloc`. Calls to `malloc`, `calloc`,
+// `realloc`, `free` and `strdup` in aecor code go through the functions
+// below, each with a static `aecor_alloc_site` for the call site. Live
+// blocks are kept in a side table keyed by pointer, so `free` still works
+// on memory allocated by C code, which is just not counted.
+//
+// Like `--instrument`, this is not synchronized between threads.
+typedef struct aecor_alloc_site {
+  const char* location;
+  u64 allocs;
+  u64 bytes;
+  u64 live;
+  u64 live_bytes;
+  struct aecor_alloc_site* next;
+} aecor_alloc_site;
+
+typedef struct {
+  void* ptr;
+  size_t size;
+  aecor_alloc_site* site;
+} aecor_alloc_block;
+
+static aecor_alloc_site* aecor_alloc_sites = NULL;
+static aecor_alloc_block* aecor_alloc_blocks = NULL;
+static size_t aecor_alloc_capacity = 0;  // Always a power of two
+static size_t aecor_alloc_count = 0;
+static u64 aecor_alloc_live_bytes = 0;
+static u64 aecor_alloc_peak_bytes = 0;
+
+// Site of the format string being built, set by the generated code
+static aecor_alloc_site aecor_alloc_unknown_format = {"<format string>"};
+static aecor_alloc_site* aecor_alloc_format_site = &aecor_alloc_unknown_format;
+
+static inline size_t aecor_alloc_slot(void* ptr) {
+  return ((uintptr_t)ptr >> 4) * 0x9e3779b97f4a7c15ull & (aecor_alloc_capacity - 1);
+}
+
+static void aecor_alloc_insert(aecor_alloc_block block) {
+  if ((aecor_alloc_count + 1) * 2 > aecor_alloc_capacity) {
+    aecor_alloc_block* old = aecor_alloc_blocks;
+    size_t old_capacity = aecor_alloc_capacity;
+    aecor_alloc_capacity = old_capacity ? old_capacity * 2 : 1024;
+    aecor_alloc_blocks = calloc(aecor_alloc_capacity, sizeof(aecor_alloc_block));
+    aecor_alloc_count = 0;
+    for (size_t i = 0; i < old_capacity; i++) {
+      if (old[i].ptr) aecor_alloc_insert(old[i]);
+    }
+    free(old);
+  }
+  size_t i = aecor_alloc_slot(block.ptr);
+  while (aecor_alloc_blocks[i].ptr) i = (i + 1) & (aecor_alloc_capacity - 1);
+  aecor_alloc_blocks[i] = block;
+  aecor_alloc_count++;
+}
+
+// Removes the block for `ptr` using backward-shift deletion, returning
+// false if it wasn't allocated by tracked code.
+static bool aecor_alloc_remove(void* ptr, aecor_alloc_block* out) {
+  if (!aecor_alloc_capacity) return false;
+  size_t mask = aecor_alloc_capacity - 1;
+  size_t i = aecor_alloc_slot(ptr);
+  while (aecor_alloc_blocks[i].ptr != ptr) {
+    if (!aecor_alloc_blocks[i].ptr) return false;
+    i = (i + 1) & mask;
+  }
+  *out = aecor_alloc_blocks[i];
+  for (size_t j = (i + 1) & mask; aecor_alloc_blocks[j].ptr; j = (j + 1) & mask) {
+    size_t home = aecor_alloc_slot(aecor_alloc_blocks[j].ptr);
+    // Move the entry into the hole unless its home slot is after the hole
+    if (((j - home) & mask) >= ((j - i) & mask)) {
+      aecor_alloc_blocks[i] = aecor_alloc_blocks[j];
+      i = j;
+    }
+  }
+  aecor_alloc_blocks[i].ptr = NULL;
+  aecor_alloc_count--;
+  return true;
+}
+
+static void aecor_alloc_record(void* ptr, size_t size, aecor_alloc_site* site) {
+  if (!ptr) return;
+  if (!site->allocs) {
+    site->next = aecor_alloc_sites;
+    aecor_alloc_sites = site;
+  }
+  site->allocs++;
+  site->bytes += size;
+  site->live++;
+  site->live_bytes += size;
+  aecor_alloc_live_bytes += size;
+  if (aecor_alloc_live_bytes > aecor_alloc_peak_bytes) {
+    aecor_alloc_peak_bytes = aecor_alloc_live_bytes;
+  }
+  aecor_alloc_insert((aecor_alloc_block){ptr, size, site});
+}
+
+static void aecor_alloc_forget(void* ptr) {
+  aecor_alloc_block block;
+  if (!ptr || !aecor_alloc_remove(ptr, &block)) return;
+  block.site->live--;
+  block.site->live_bytes -= block.size;
+  aecor_alloc_live_bytes -= block.size;
+}
+
+void* aecor_track_malloc(size_t size, aecor_alloc_site* site) {
+  void* ptr = malloc(size);
+  aecor_alloc_record(ptr, size, site);
+  return ptr;
+}
+
+void* aecor_track_calloc(size_t count, size_t size, aecor_alloc_site* site) {
+  void* ptr = calloc(count, size);
+  aecor_alloc_record(ptr, count * size, site);
+  return ptr;
+}
+
+void* aecor_track_realloc(void* old, size_t size, aecor_alloc_site* site) {
+  void* ptr = realloc(old, size);
+  if (!ptr && size) return ptr;
+  aecor_alloc_forget(old);
+  aecor_alloc_record(ptr, size, site);
+  return ptr;
+}
+
+char* aecor_track_strdup(const char* s, aecor_alloc_site* site) {
+  char* copy = strdup(s);
+  aecor_alloc_record(copy, strlen(s) + 1, site);
+  return copy;
+}
+
+void aecor_track_free(void* ptr) {
+  aecor_alloc_forget(ptr);
+  free(ptr);
+}
+
+static void* aecor_track_format_alloc(size_t size) {
+  aecor_alloc_site* site = aecor_alloc_format_site;
+  aecor_alloc_format_site = &aecor_alloc_unknown_format;
+  return aecor_track_malloc(size, site);
+}
+
+static int aecor_alloc_compare_bytes(const void* a, const void* b) {
+  u64 x = (*(aecor_alloc_site**)a)->bytes, y = (*(aecor_alloc_site**)b)->bytes;
+  return x < y ? 1 : x > y ? -1 : 0;
+}
+
+static int aecor_alloc_compare_live(const void* a, const void* b) {
+  u64 x = (*(aecor_alloc_site**)a)->live_bytes, y = (*(aecor_alloc_site**)b)->live_bytes;
+  return x < y ? 1 : x > y ? -1 : 0;
+}
+
+// Writes the sites that allocated the most bytes, followed by the ones
+// with memory that was never freed.
+static void aecor_alloc_report(void) {
+  const char* path = getenv("AECOR_ALLOC_REPORT");
+  if (!path) path = "aecor_alloc.txt";
+  FILE* file = fopen(path, "w");
+  if (!file) {
+    fprintf(stderr, "Could not write allocation report to %s\n", path);
+    return;
+  }
+
+  size_t count = 0;
+  u64 allocs = 0, bytes = 0, live = 0;
+  for (aecor_alloc_site* site = aecor_alloc_sites; site; site = site->next) {
+    count++;
+    allocs += site->allocs;
+    bytes += site->bytes;
+    live += site->live;
+  }
+  aecor_alloc_site** sites = malloc((count + 1) * sizeof(aecor_alloc_site*));
+  size_t n = 0;
+  for (aecor_alloc_site* site = aecor_alloc_sites; site; site = site->next) sites[n++] = site;
+
+  fprintf(file, "# %llu allocations, %llu bytes, peak %llu bytes live\n",
+          (unsigned long long)allocs, (unsigned long long)bytes,
+          (unsigned long long)aecor_alloc_peak_bytes);
+  fprintf(file, "# %llu blocks, %llu bytes never freed\n",
+          (unsigned long long)live, (unsigned long long)aecor_alloc_live_bytes);
+
+  const char* header = "# %12s %14s %12s %14s  %s\n";
+  const char* row = "%14llu %14llu %12llu %14llu  %s\n";
+  fprintf(file, "\n# Top allocators\n");
+  fprintf(file, header, "allocs", "bytes", "live", "live_bytes", "site");
+  qsort(sites, n, sizeof(aecor_alloc_site*), aecor_alloc_compare_bytes);
+  for (size_t i = 0; i < n; i++) {
+    aecor_alloc_site* site = sites[i];
+    fprintf(file, row, (unsigned long long)site->allocs, (unsigned long long)site->bytes,
+            (unsigned long long)site->live, (unsigned long long)site->live_bytes, site->location);
+  }
+
+  fprintf(file, "\n# Leaks\n");
+  fprintf(file, header, "allocs", "bytes", "live", "live_bytes", "site");
+  qsort(sites, n, sizeof(aecor_alloc_site*), aecor_alloc_compare_live);
+  for (size_t i = 0; i < n && sites[i]->live; i++) {
+    aecor_alloc_site* site = sites[i];
+    fprintf(file, row, (unsigned long long)site->allocs, (unsigned long long)site->bytes,
+            (unsigned long long)site->live, (unsigned long long)site->live_bytes, site->location);
+  }
+  free(sites);
+  fclose(file);
+}
+
+__attribute__((constructor)) static void aecor_alloc_init(void) {
+  atexit(aecor_alloc_report);
+}
+
+#define AECOR_FORMAT_ALLOC aecor_track_format_alloc
+#else
+#define AECOR_FORMAT_ALLOC malloc
+#endif
+
+// Formats into `stack` if the result fits in `capacity` bytes, otherwise
+// returns a new heap-allocated string that the caller needs to free.
+char* format_string_into(char* stack, int capacity, const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  int size = vsnprintf(stack, capacity, format, args);
+  va_end(args);
+  if (size < capacity) return stack;
+  char* s = malloc(size + 1);
+  va_start(args, format);
+  vsnprintf(s, size + 1, format, args);
+  va_end(args);
+  return s;
+}
+
+// Formats into a stack buffer first since most formatted strings are short,
+// which saves a separate pass just to compute the size.
+static char* aecor_vformat(void* (*alloc)(size_t), const char* format, va_list args) {
+  char stack[256];
+  va_list copy;
+  va_copy(copy, args);
+  int size = vsnprintf(stack, sizeof(stack), format, copy);
+  va_end(copy);
+  char* s = alloc(size + 1);
+  if (size < (int)sizeof(stack)) {
+    memcpy(s, stack, size + 1);
+  } else {
+    vsnprintf(s, size + 1, format, args);
+  }
+  return s;
+}
+
+char* format_string(const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  char* s = aecor_vformat(AECOR_FORMAT_ALLOC, format, args);
+  va_end(args);
+  return s;
+}
+
+// Scratch arena backing `scratch { ... }` blocks. Memory is handed out from a
+// list of chunks with a bump pointer, and everything allocated inside a block
+// is released at once when it ends by restoring the position saved on entry.
+// Chunks past the current one are kept around to be reused.
+#define AECOR_SCRATCH_CHUNK_SIZE (64 * 1024)
+
+typedef struct aecor_scratch_chunk {
+  struct aecor_scratch_chunk* next;
+  size_t capacity;
+  size_t used;
+  char data[];
+} aecor_scratch_chunk;
+
+typedef struct {
+  aecor_scratch_chunk* chunk;
+  size_t used;
+} aecor_scratch_mark;
+
+static aecor_scratch_chunk* aecor_scratch_first = NULL;
+static aecor_scratch_chunk* aecor_scratch_current = NULL;
+
+void* scratch_alloc(size_t size) {
+  size = (size + 15) & ~(size_t)15;
+  aecor_scratch_chunk* chunk = aecor_scratch_current;
+  if (!chunk || chunk->used + size > chunk->capacity) {
+    aecor_scratch_chunk** link = chunk ? &chunk->next : &aecor_scratch_first;
+    if (!*link || (*link)->capacity < size) {
+      size_t capacity = size > AECOR_SCRATCH_CHUNK_SIZE ? size : AECOR_SCRATCH_CHUNK_SIZE;
+      aecor_scratch_chunk* fresh = malloc(sizeof(aecor_scratch_chunk) + capacity);
+      if (!fresh) {
+        printf("Out of memory!\n");
+        exit(1);
+      }
+      fresh->capacity = capacity;
+      fresh->next = *link;
+      *link = fresh;
+    }
+    chunk = *link;
+    chunk->used = 0;
+    aecor_scratch_current = chunk;
+  }
+  void* ptr = chunk->data + chunk->used;
+  chunk->used += size;
+  return ptr;
+}
+
+aecor_scratch_mark aecor_scratch_save() {
+  aecor_scratch_chunk* chunk = aecor_scratch_current;
+  return (aecor_scratch_mark){chunk, chunk ? chunk->used : 0};
+}
+
+void aecor_scratch_restore(aecor_scratch_mark* mark) {
+  aecor_scratch_current = mark->chunk;
+  if (mark->chunk) mark->chunk->used = mark->used;
+}
+
+char* format_string_scratch(const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  char* s = aecor_vformat(scratch_alloc, format, args);
+  va_end(args);
+  return s;
+}
+
+// Output buffer for `print` / `println` when compiling with `-b`. Writes are
+// collected here and handed to stdio in large chunks, which avoids paying
+// for `printf`'s locking and format parsing on every call.
+#define AECOR_STDOUT_BUFFER_SIZE (64 * 1024)
+
+static char aecor_stdout_buffer[AECOR_STDOUT_BUFFER_SIZE];
+static size_t aecor_stdout_size = 0;
+
+void aecor_stdout_flush(void) {
+  fwrite(aecor_stdout_buffer, 1, aecor_stdout_size, stdout);
+  fflush(stdout);
+  aecor_stdout_size = 0;
+}
+
+__attribute__((constructor)) static void aecor_stdout_init(void) {
+  atexit(aecor_stdout_flush);
+}
+
+static inline void aecor_stdout_write(const char* s, size_t len) {
+  if (aecor_stdout_size + len > AECOR_STDOUT_BUFFER_SIZE) {
+    aecor_stdout_flush();
+    if (len > AECOR_STDOUT_BUFFER_SIZE) {
+      fwrite(s, 1, len, stdout);
+      return;
+    }
+  }
+  memcpy(aecor_stdout_buffer + aecor_stdout_size, s, len);
+  aecor_stdout_size += len;
+}
+
+void aecor_stdout_puts(const char* s) {
+  aecor_stdout_write(s, strlen(s));
+}
+
+void aecor_stdout_putc(char c) {
+  if (aecor_stdout_size == AECOR_STDOUT_BUFFER_SIZE) aecor_stdout_flush();
+  aecor_stdout_buffer[aecor_stdout_size++] = c;
+}
+
+void aecor_stdout_put_u64(u64 value) {
+  char digits[20];
+  int len = 0;
+  do {
+    digits[sizeof(digits) - ++len] = '0' + value % 10;
+    value /= 10;
+  } while (value);
+  aecor_stdout_write(digits + sizeof(digits) - len, len);
+}
+
+void aecor_stdout_put_i64(i64 value) {
+  if (value < 0) {
+    aecor_stdout_putc('-');
+    aecor_stdout_put_u64(-(u64)value);
+  } else {
+    aecor_stdout_put_u64(value);
+  }
+}
+
+// Used for anything that isn't a format string literal, as well as the
+// arguments with explicit format specs.
+int aecor_stdout_printf(const char* format, ...) {
+  char stack[256];
+  va_list args;
+  va_start(args, format);
+  int size = vsnprintf(stack, sizeof(stack), format, args);
+  va_end(args);
+  if (size < (int)sizeof(stack)) {
+    aecor_stdout_write(stack, size);
+  } else {
+    char* s = malloc(size + 1);
+    va_start(args, format);
+    vsnprintf(s, size + 1, format, args);
+    va_end(args);
+    aecor_stdout_write(s, size);
+    free(s);
+  }
+  return size;
+}
+
+void aecor_stdout_put_f64(f64 value) {
+  aecor_stdout_printf("%f", value);
+}
+
+void aecor_stdout_put_ptr(void* value) {
+  aecor_stdout_printf("%p", value);
+}
+
+// FNV-1a with a murmur3 finalizer, used for hashed dispatch on strings.
+// Must be kept in sync with `hash_string` in `compiler/utils.ae`.
+u32 aecor_hash_str(const char* s, u32 seed) {
+  u32 hash = seed;
+  for (; *s; s++) {
+    hash = (hash ^ (u8)*s) * 16777619u;
+  }
+  hash = (hash ^ (hash >> 16)) * 0x85ebca6bu;
+  hash = (hash ^ (hash >> 13)) * 0xc2b2ae35u;
+  return hash ^ (hash >> 16);
+}
+
+#ifdef AECOR_INSTRUMENT
+#include <time.h>
+
+// Per-function profiling for `--instrument`. Every instrumented function
+// pushes a frame on entry, which is popped by a `cleanup` handler whenever
+// the function returns. Time spent in instrumented callees is subtracted
+// from the caller's exclusive time. Recursive calls only count towards
+// inclusive time once, for the outermost call.
+//
+// Counters are not synchronized, so this is only accurate for programs
+// that call instrumented functions from a single thread.
+typedef struct {
+  const char* name;
+  const char* location;
+  u64 calls;
+  u64 inclusive_ns;
+  u64 exclusive_ns;
+  u32 active;
+} aecor_prof_entry;
+
+typedef struct aecor_prof_frame {
+  aecor_prof_entry* entry;
+  struct aecor_prof_frame* parent;
+  u64 start;
+  u64 children;
+} aecor_prof_frame;
+
+// Defined at the end of the generated code, one entry per function
+extern aecor_prof_entry aecor_prof_table[];
+extern u32 aecor_prof_count;
+
+static __thread aecor_prof_frame* aecor_prof_current = NULL;
+
+static inline u64 aecor_prof_now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (u64)ts.tv_sec * 1000000000ull + (u64)ts.tv_nsec;
+}
+
+static inline void aecor_prof_enter(aecor_prof_frame* frame, u32 id) {
+  frame->entry = &aecor_prof_table[id];
+  frame->entry->calls++;
+  frame->entry->active++;
+  frame->parent = aecor_prof_current;
+  frame->children = 0;
+  aecor_prof_current = frame;
+  frame->start = aecor_prof_now();
+}
+
+static inline void aecor_prof_exit(aecor_prof_frame* frame) {
+  u64 elapsed = aecor_prof_now() - frame->start;
+  aecor_prof_entry* entry = frame->entry;
+  entry->active--;
+  if (entry->active == 0) entry->inclusive_ns += elapsed;
+  entry->exclusive_ns += elapsed - frame->children;
+  if (frame->parent) frame->parent->children += elapsed;
+  aecor_prof_current = frame->parent;
+}
+
+// Writes one line per function that was called, in declaration order so
+// that reports from different runs can be diffed directly. The output is
+// whitespace separated for `sort -k`, e.g. `sort -k3 -n -r` for the
+// functions with the most exclusive time.
+static void aecor_prof_report(void) {
+  // Functions still running when `exit()` was called end here
+  while (aecor_prof_current) aecor_prof_exit(aecor_prof_current);
+
+  const char* path = getenv("AECOR_PROFILE");
+  if (!path) path = "aecor_profile.txt";
+  FILE* file = fopen(path, "w");
+  if (!file) {
+    fprintf(stderr, "Could not write profile to %s\n", path);
+    return;
+  }
+  fprintf(file, "# %12s %16s %16s  %s  %s\n",
+          "calls", "inclusive_ns", "exclusive_ns", "function", "location");
+  for (u32 i = 0; i < aecor_prof_count; i++) {
+    aecor_prof_entry* entry = &aecor_prof_table[i];
+    if (entry->calls == 0) continue;
+    fprintf(file, "%14llu %16llu %16llu  %s  %s\n",
+            (unsigned long long)entry->calls,
+            (unsigned long long)entry->inclusive_ns,
+            (unsigned long long)entry->exclusive_ns,
+            entry->name, entry->location);
+  }
+  fclose(file);
+}
+
+__attribute__((constructor)) static void aecor_prof_init(void) {
+  atexit(aecor_prof_report);
+}
+#endif
+
+
+/* constants */
+const i32 HASHMAP_GROUP = 8;
+const i32 HASHMAP_EMPTY = 0x80;
+const i32 HASHMAP_DELETED = 0xFE;
+const u64 HASHMAP_LSBS = 0x0101010101010101;
+const u64 HASHMAP_MSBS = 0x8080808080808080;
+const i32 BTREE_MAX_KEYS = 31;
+
+/* struct declarations */
+typedef struct Vector Vector;
+typedef struct MapNode MapNode;
+typedef struct Map Map;
+typedef struct MapIterator MapIterator;
+typedef struct HashMapSlot HashMapSlot;
+typedef struct HashMap HashMap;
+typedef struct HashMapIterator HashMapIterator;
+typedef struct BTreeMap__i64_i64 BTreeMap__i64_i64;
+typedef struct BTreeIterator__i64_i64 BTreeIterator__i64_i64;
+typedef struct BTreeInner__i64_i64 BTreeInner__i64_i64;
+typedef struct BTreeLeaf__i64_i64 BTreeLeaf__i64_i64;
+typedef struct BTreeMap__ptr_char_ptr_char BTreeMap__ptr_char_ptr_char;
+typedef struct BTreeIterator__ptr_char_ptr_char BTreeIterator__ptr_char_ptr_char;
+typedef struct BTreeInner__ptr_char_ptr_char BTreeInner__ptr_char_ptr_char;
+typedef struct BTreeLeaf__ptr_char_ptr_char BTreeLeaf__ptr_char_ptr_char;
+
+struct Vector {
+  i32 size;
+  i32 capacity;
+  void **data;
+};
+
+struct MapNode {
+  char *key;
+  void *value;
+  MapNode *next;
+};
+
+struct Map {
+  MapNode **buckets;
+  i32 num_items;
+  i32 num_buckets;
+  i32 num_collisions;
+};
+
+struct MapIterator {
+  i32 idx;
+  MapNode *cur;
+  Map *map;
+};
+
+struct HashMapSlot {
+  u64 hash;
+  char *key;
+  void *value;
+};
+
+struct HashMap {
+  u8 *ctrl;
+  HashMapSlot *slots;
+  i32 capacity;
+  i32 num_items;
+  i32 growth_left;
+};
+
+struct HashMapIterator {
+  i32 idx;
+  HashMapSlot *cur;
+  HashMap *map;
+};
+
+struct BTreeMap__i64_i64 {
+  void *root;
+  i32 height;
+  i32 size;
+  i32 (*compare)(i64, i64);
+};
+
+struct BTreeIterator__i64_i64 {
+  BTreeMap__i64_i64 *map;
+  BTreeLeaf__i64_i64 *leaf;
+  i32 idx;
+  bool has_end;
+  i64 end;
+};
+
+struct BTreeInner__i64_i64 {
+  i32 num_keys;
+  i64 keys[31];
+  void *children[32];
+};
+
+struct BTreeLeaf__i64_i64 {
+  i32 num_keys;
+  i64 keys[31];
+  i64 values[31];
+  BTreeLeaf__i64_i64 *next;
+};
+
+struct BTreeMap__ptr_char_ptr_char {
+  void *root;
+  i32 height;
+  i32 size;
+  i32 (*compare)(char *, char *);
+};
+
+struct BTreeIterator__ptr_char_ptr_char {
+  BTreeMap__ptr_char_ptr_char *map;
+  BTreeLeaf__ptr_char_ptr_char *leaf;
+  i32 idx;
+  bool has_end;
+  char *end;
+};
+
+struct BTreeInner__ptr_char_ptr_char {
+  i32 num_keys;
+  char *keys[31];
+  void *children[32];
+};
+
+struct BTreeLeaf__ptr_char_ptr_char {
+  i32 num_keys;
+  char *keys[31];
+  char *values[31];
+  BTreeLeaf__ptr_char_ptr_char *next;
+};
+
+/* function declarations */
+static FILE *File__open(char *path, char *mode);
+static bool File__exists(char *path);
+static i32 File__size(FILE *this);
+static char *File__slurp(FILE *this);
+static i32 File__read(FILE *this, void *buf, i32 size);
+static i32 File__write(FILE *this, void *buf, i32 size);
+static void File__puts(FILE *this, char *str);
+static __attribute__((noreturn)) __attribute__((cold)) void panic(char *msg);
+static bool string__starts_with(char *this, char *prefix);
+static bool string__ends_with(char *this, char *suffix);
+static void string__remove_last_n(char *this, i32 n);
+static bool string__eq(char *this, char *str2);
+static char *string__substring(char *this, i32 start, i32 len);
+static void string__strip_trailing_whitespace(char *this);
+static i32 min(i32 a, i32 b);
+static i32 max(i32 a, i32 b);
+static f64 time_now(void);
+static void bench_report(char *name, f64 elapsed, i32 iters);
+static Vector *Vector__new_sized(i32 capacity);
+static Vector *Vector__new(void);
+static void Vector__resize(Vector *this, i32 new_capacity);
+static inline __attribute__((always_inline)) void Vector__push(Vector *this, void *val);
+static void Vector__push_front(Vector *this, void *val);
+static void *Vector__pop(Vector *this);
+static inline __attribute__((always_inline)) void *Vector__back(Vector *this);
+static inline __attribute__((always_inline)) void *Vector__at(Vector *this, i32 i);
+static inline __attribute__((always_inline)) bool Vector__empty(Vector *this);
+static void Vector__free(Vector *this);
+static MapNode *MapNode__new(char *key, void *value, MapNode *next);
+static void MapNode__free_list(MapNode *node);
+static Map *Map__new(void);
+static i32 Map__hash(Map *this, char *s);
+static MapNode *Map__get_node(Map *this, char *key);
+static void *Map__get(Map *this, char *key);
+static bool Map__exists(Map *this, char *key);
+static void Map__insert(Map *this, char *key, void *value);
+static void Map__resize(Map *this);
+static void Map__print_keys(Map *this);
+static void Map__push_keys(Map *this, Vector *vec);
+static void Map__free(Map *this);
+static MapIterator Map__iter(Map *this);
+static char *MapIterator__key(MapIterator *this);
+static void *MapIterator__value(MapIterator *this);
+static MapIterator MapIterator__make(Map *map);
+static void MapIterator__next(MapIterator *this);
+static u64 HashMap__hash(char *s);
+static u64 hashmap_match_byte(u64 group, u8 byte);
+static u64 hashmap_match_empty(u64 group);
+static u64 hashmap_match_free(u64 group);
+static HashMap *HashMap__new_sized(i32 capacity);
+static HashMap *HashMap__new(void);
+static void HashMap__alloc(HashMap *this, i32 min_capacity);
+static u64 HashMap__group(HashMap *this, i32 index);
+static i32 HashMap__find(HashMap *this, char *key, u64 hash);
+static i32 HashMap__find_free(HashMap *this, u64 hash);
+static void *HashMap__get(HashMap *this, char *key);
+static bool HashMap__exists(HashMap *this, char *key);
+static void HashMap__insert(HashMap *this, char *key, void *value);
+static void *HashMap__remove(HashMap *this, char *key);
+static void HashMap__resize(HashMap *this);
+static void HashMap__print_keys(HashMap *this);
+static void HashMap__push_keys(HashMap *this, Vector *vec);
+static void HashMap__free(HashMap *this);
+static HashMapIterator HashMap__iter(HashMap *this);
+static char *HashMapIterator__key(HashMapIterator *this);
+static void *HashMapIterator__value(HashMapIterator *this);
+static HashMapIterator HashMapIterator__make(HashMap *map);
+static void HashMapIterator__next(HashMapIterator *this);
+static i32 btree_compare_strings(char *a, char *b);
+static i32 btree_compare_i64(i64 a, i64 b);
+static i32 btree_compare_u64(u64 a, u64 b);
+static i32 btree_compare_f64(f64 a, f64 b);
+static i32 compare_string_ptrs(void *a, void *b);
+static void bench_sorted(char **keys, i32 n);
+static void bench_lookup(i32 n);
+i32 main(void);
+static BTreeMap__i64_i64 *BTreeMap__i64_i64__new(i32 (*compare)(i64, i64));
+static i32 BTreeMap__i64_i64__lower_bound_in(BTreeMap__i64_i64 *this, i64 *keys, i32 n, i64 key);
+static i32 BTreeMap__i64_i64__child_index(BTreeMap__i64_i64 *this, BTreeInner__i64_i64 *node, i64 key);
+static BTreeLeaf__i64_i64 *BTreeMap__i64_i64__find_leaf(BTreeMap__i64_i64 *this, i64 key);
+static i64 *BTreeMap__i64_i64__get_ptr(BTreeMap__i64_i64 *this, i64 key);
+static i64 BTreeMap__i64_i64__get_or(BTreeMap__i64_i64 *this, i64 key, i64 fallback);
+static bool BTreeMap__i64_i64__exists(BTreeMap__i64_i64 *this, i64 key);
+static void *BTreeMap__i64_i64__insert_into(BTreeMap__i64_i64 *this, void *node, i32 level, i64 key, i64 value, i64 *split_key);
+static void BTreeMap__i64_i64__insert(BTreeMap__i64_i64 *this, i64 key, i64 value);
+static BTreeMap__i64_i64 *BTreeMap__i64_i64__from_sorted(i64 *keys, i64 *values, i32 n, i32 (*compare)(i64, i64));
+static void BTreeMap__i64_i64__free_node(BTreeMap__i64_i64 *this, void *node, i32 level);
+static void BTreeMap__i64_i64__free(BTreeMap__i64_i64 *this);
+static BTreeIterator__i64_i64 BTreeMap__i64_i64__iter(BTreeMap__i64_i64 *this);
+static BTreeIterator__i64_i64 BTreeMap__i64_i64__lower_bound(BTreeMap__i64_i64 *this, i64 key);
+static BTreeIterator__i64_i64 BTreeMap__i64_i64__range(BTreeMap__i64_i64 *this, i64 lo, i64 hi);
+static i64 BTreeMap__i64_i64__root_key(BTreeMap__i64_i64 *this);
+static void BTreeIterator__i64_i64__skip_empty(BTreeIterator__i64_i64 *this);
+static bool BTreeIterator__i64_i64__valid(BTreeIterator__i64_i64 *this);
+static i64 BTreeIterator__i64_i64__key(BTreeIterator__i64_i64 *this);
+static i64 BTreeIterator__i64_i64__value(BTreeIterator__i64_i64 *this);
+static i64 *BTreeIterator__i64_i64__value_ptr(BTreeIterator__i64_i64 *this);
+static void BTreeIterator__i64_i64__next(BTreeIterator__i64_i64 *this);
+static BTreeMap__ptr_char_ptr_char *BTreeMap__ptr_char_ptr_char__new(i32 (*compare)(char *, char *));
+static i32 BTreeMap__ptr_char_ptr_char__lower_bound_in(BTreeMap__ptr_char_ptr_char *this, char **keys, i32 n, char *key);
+static i32 BTreeMap__ptr_char_ptr_char__child_index(BTreeMap__ptr_char_ptr_char *this, BTreeInner__ptr_char_ptr_char *node, char *key);
+static BTreeLeaf__ptr_char_ptr_char *BTreeMap__ptr_char_ptr_char__find_leaf(BTreeMap__ptr_char_ptr_char *this, char *key);
+static char **BTreeMap__ptr_char_ptr_char__get_ptr(BTreeMap__ptr_char_ptr_char *this, char *key);
+static char *BTreeMap__ptr_char_ptr_char__get_or(BTreeMap__ptr_char_ptr_char *this, char *key, char *fallback);
+static bool BTreeMap__ptr_char_ptr_char__exists(BTreeMap__ptr_char_ptr_char *this, char *key);
+static void *BTreeMap__ptr_char_ptr_char__insert_into(BTreeMap__ptr_char_ptr_char *this, void *node, i32 level, char *key, char *value, char **split_key);
+static void BTreeMap__ptr_char_ptr_char__insert(BTreeMap__ptr_char_ptr_char *this, char *key, char *value);
+static BTreeMap__ptr_char_ptr_char *BTreeMap__ptr_char_ptr_char__from_sorted(char **keys, char **values, i32 n, i32 (*compare)(char *, char *));
+static void BTreeMap__ptr_char_ptr_char__free_node(BTreeMap__ptr_char_ptr_char *this, void *node, i32 level);
+static void BTreeMap__ptr_char_ptr_char__free(BTreeMap__ptr_char_ptr_char *this);
+static BTreeIterator__ptr_char_ptr_char BTreeMap__ptr_char_ptr_char__iter(BTreeMap__ptr_char_ptr_char *this);
+static BTreeIterator__ptr_char_ptr_char BTreeMap__ptr_char_ptr_char__lower_bound(BTreeMap__ptr_char_ptr_char *this, char *key);
+static BTreeIterator__ptr_char_ptr_char BTreeMap__ptr_char_ptr_char__range(BTreeMap__ptr_char_ptr_char *this, char *lo, char *hi);
+static char *BTreeMap__ptr_char_ptr_char__root_key(BTreeMap__ptr_char_ptr_char *this);
+static void BTreeIterator__ptr_char_ptr_char__skip_empty(BTreeIterator__ptr_char_ptr_char *this);
+static bool BTreeIterator__ptr_char_ptr_char__valid(BTreeIterator__ptr_char_ptr_char *this);
+static char *BTreeIterator__ptr_char_ptr_char__key(BTreeIterator__ptr_char_ptr_char *this);
+static char *BTreeIterator__ptr_char_ptr_char__value(BTreeIterator__ptr_char_ptr_char *this);
+static char **BTreeIterator__ptr_char_ptr_char__value_ptr(BTreeIterator__ptr_char_ptr_char *this);
+static void BTreeIterator__ptr_char_ptr_char__next(BTreeIterator__ptr_char_ptr_char *this);
+
+/* global variables */
+u64 bench_sink = 0;
+
+static FILE *File__open(char *path, char *mode) {
+  FILE *file = fopen(path, mode);
+  if ((!((bool)file))) {
+    printf("Error opening file '%s': %s""\n", path, strerror(errno));
+    exit(1);
+  } 
+  return file;
+}
+
+static bool File__exists(char *path) {
+  FILE *file = fopen(path, "r");
+  if ((!((bool)file))) {
+    return false;
+  } 
+  fclose(file);
+  return true;
+}
+
+static i32 File__size(FILE *this) {
+  i32 pos = ftell(this);
+  fseek(this, 0, SEEK_END);
+  i32 size = ftell(this);
+  fseek(this, pos, SEEK_SET);
+  return size;
+}
+
+static char *File__slurp(FILE *this) {
+  i32 pos = ftell(this);
+  fseek(this, 0, SEEK_END);
+  i32 size = ftell(this);
+  fseek(this, pos, SEEK_SET);
+  void *buf = calloc((size + 1), sizeof(char));
+  fread(buf, 1, size, this);
+  fseek(this, pos, SEEK_SET);
+  return ((char *)buf);
+}
+
+static i32 File__read(FILE *this, void *buf, i32 size) {
+  return fread(buf, 1, size, this);
+}
+
+static i32 File__write(FILE *this, void *buf, i32 size) {
+  return fwrite(buf, 1, size, this);
+}
+
+static void File__puts(FILE *this, char *str) {
+  fwrite(str, 1, strlen(str), this);
+}
+
+static __attribute__((noreturn)) __attribute__((cold)) void panic(char *msg) {
+  printf("%s""\n", msg);
+  aecor_stdout_flush();
+  exit(1);
+}
+
+static bool string__starts_with(char *this, char *prefix) {
+  i32 prefix_len = strlen(prefix);
+  if ((strlen(this) < prefix_len)) {
+    return false;
+  } 
+  return strncmp(this, prefix, prefix_len) == 0;
+}
+
+static bool string__ends_with(char *this, char *suffix) {
+  i32 suffix_len = strlen(suffix);
+  if ((strlen(this) < suffix_len)) {
+    return false;
+  } 
+  return strncmp(this, suffix, suffix_len) == 0;
+}
+
+static void string__remove_last_n(char *this, i32 n) {
+  this[(strlen(this) - n)] = '\0';
+}
+
+static bool string__eq(char *this, char *str2) {
+  return strcmp(this, str2) == 0;
+}
+
+static char *string__substring(char *this, i32 start, i32 len) {
+  char *new_str = ((char *)calloc((len + 1), sizeof(char)));
+  memcpy(new_str, (this + start), len);
+  return new_str;
+}
+
+static void string__strip_trailing_whitespace(char *this) {
+  for (i32 i = (strlen(this) - 1); (i >= 0); i -= 1) {
+    if ((this[i] != ' ')) 
+    break;
+    
+    this[i] = '\0';
+  } 
+}
+
+static i32 min(i32 a, i32 b) {
+  return ((a < b) ? a : b);
+}
+
+static i32 max(i32 a, i32 b) {
+  return ((a > b) ? a : b);
+}
+
+static f64 time_now(void) {
+  struct timespec ts = {0};
+  clock_gettime(CLOCK_MONOTONIC, (&ts));
+  return (((f64)ts.tv_sec) + (((f64)ts.tv_nsec) / 1000000000.0));
+}
+
+static void bench_report(char *name, f64 elapsed, i32 iters) {
+  f64 ns = ((elapsed * 1000000000.0) / ((f64)iters));
+  printf("%-32s %10.3f ms %10.2f ns/iter""\n", name, (elapsed * 1000.0), ns);
+}
+
+static Vector *Vector__new_sized(i32 capacity) {
+  Vector *vec = ((Vector *)calloc(1, sizeof(Vector)));
+  vec->size = 0;
+  vec->capacity = capacity;
+  vec->data = ((void **)calloc(vec->capacity, sizeof(void *)));
+  return vec;
+}
+
+static Vector *Vector__new(void) {
+  return Vector__new_sized(16);
+}
+
+static void Vector__resize(Vector *this, i32 new_capacity) {
+  this->capacity = new_capacity;
+  this->data = ((void **)realloc(this->data, (this->capacity * sizeof(void *))));
+}
+
+static inline __attribute__((always_inline)) void Vector__push(Vector *this, void *val) {
+  if (this->size == this->capacity) {
+    Vector__resize(this, (this->capacity * 2));
+  } 
+  this->data[this->size] = val;
+  this->size += 1;
+}
+
+static void Vector__push_front(Vector *this, void *val) {
+  if (this->size == this->capacity) {
+    Vector__resize(this, (this->capacity * 2));
+  } 
+  for (i32 i = this->size; (i > 0); i -= 1) {
+    this->data[i] = this->data[(i - 1)];
+  } 
+  this->data[0] = val;
+  this->size += 1;
+}
+
+static void *Vector__pop(Vector *this) {
+  (__builtin_expect(!!((this->size > 0)), 1) ? (void)0 : panic("pop on empty vector"));
+  this->size -= 1;
+  return this->data[this->size];
+}
+
+static inline __attribute__((always_inline)) void *Vector__back(Vector *this) {
+  (__builtin_expect(!!((this->size > 0)), 1) ? (void)0 : panic("back on empty vector"));
+  return this->data[(this->size - 1)];
+}
+
+static inline __attribute__((always_inline)) void *Vector__at(Vector *this, i32 i) {
+  (__builtin_expect(!!(((i >= 0) && (i < this->size))), 1) ? (void)0 : panic("at out of bounds in vector"));
+  return this->data[i];
+}
+
+static inline __attribute__((always_inline)) bool Vector__empty(Vector *this) {
+  return this->size == 0;
+}
+
+static void Vector__free(Vector *this) {
+  free(this->data);
+  free(this);
+}
+
+static MapNode *MapNode__new(char *key, void *value, MapNode *next) {
+  MapNode *node = ((MapNode *)calloc(1, sizeof(MapNode)));
+  node->key = key;
+  node->value = value;
+  node->next = next;
+  return node;
+}
+
+static void MapNode__free_list(MapNode *node) {
+  MapNode *cur = node;
+  while (((bool)cur)) {
+    MapNode *next = cur->next;
+    free(cur);
+    cur = next;
+  } 
+}
+
+static Map *Map__new(void) {
+  Map *map = ((Map *)calloc(1, sizeof(Map)));
+  map->num_buckets = 4;
+  map->buckets = ((MapNode **)calloc(map->num_buckets, sizeof(MapNode *)));
+  return map;
+}
+
+static i32 Map__hash(Map *this, char *s) {
+  u32 hash = 5381;
+  for (i32 i = 0; (s[i] != '\0'); i += 1) {
+    hash = ((hash * 33) ^ ((u32)((u8)s[i])));
+  } 
+  hash = (hash ^ (hash >> 16));
+  return ((i32)(hash % ((u32)this->num_buckets)));
+}
+
+static MapNode *Map__get_node(Map *this, char *key) {
+  i32 hash = Map__hash(this, key);
+  MapNode *node = this->buckets[hash];
+  while (((bool)node)) {
+    if (string__eq(node->key, key)) {
+      return node;
+    } 
+    node = node->next;
+  } 
+  return NULL;
+}
+
+static void *Map__get(Map *this, char *key) {
+  MapNode *node = Map__get_node(this, key);
+  if (((bool)node)) {
+    return node->value;
+  } 
+  return NULL;
+}
+
+static bool Map__exists(Map *this, char *key) {
+  return ((bool)Map__get_node(this, key));
+}
+
+static void Map__insert(Map *this, char *key, void *value) {
+  MapNode *node = Map__get_node(this, key);
+  if (((bool)node)) {
+    node->value = value;
+  }  else {
+    i32 hash = Map__hash(this, key);
+    MapNode *new_node = MapNode__new(key, value, this->buckets[hash]);
+    if (((bool)this->buckets[hash])) {
+      this->num_collisions += 1;
+    } 
+    this->buckets[hash] = new_node;
+    this->num_items += 1;
+    if ((this->num_items > this->num_buckets)) {
+      Map__resize(this);
+    } 
+  } 
+}
+
+static void Map__resize(Map *this) {
+  MapNode **old_buckets = this->buckets;
+  i32 old_num_buckets = this->num_buckets;
+  i32 old_num_items = this->num_items;
+  this->num_collisions = 0;
+  this->num_buckets *= 2;
+  this->buckets = ((MapNode **)calloc(this->num_buckets, sizeof(MapNode *)));
+  for (i32 i = 0; (i < old_num_buckets); i += 1) {
+    MapNode *node = old_buckets[i];
+    while (((bool)node)) {
+      i32 new_hash = Map__hash(this, node->key);
+      MapNode *new_node = MapNode__new(node->key, node->value, this->buckets[new_hash]);
+      if (((bool)this->buckets[new_hash])) {
+        this->num_collisions += 1;
+      } 
+      this->buckets[new_hash] = new_node;
+      node = node->next;
+    } 
+  } 
+  for (i32 i = 0; (i < old_num_buckets); i += 1) {
+    MapNode__free_list(old_buckets[i]);
+  } 
+  free(old_buckets);
+}
+
+static void Map__print_keys(Map *this) {
+  for (i32 i = 0; (i < this->num_buckets); i += 1) {
+    MapNode *node = this->buckets[i];
+    while (((bool)node)) {
+      printf("- '%s'\n""\n", node->key);
+      node = node->next;
+    } 
+  } 
+}
+
+static void Map__push_keys(Map *this, Vector *vec) {
+  for (i32 i = 0; (i < this->num_buckets); i += 1) {
+    MapNode *node = this->buckets[i];
+    while (((bool)node)) {
+      Vector__push(vec, node->key);
+      node = node->next;
+    } 
+  } 
+}
+
+static void Map__free(Map *this) {
+  for (i32 i = 0; (i < this->num_buckets); i += 1) {
+    MapNode__free_list(this->buckets[i]);
+  } 
+  free(this->buckets);
+}
+
+static MapIterator Map__iter(Map *this) {
+  return MapIterator__make(this);
+}
+
+static char *MapIterator__key(MapIterator *this) {
+  return this->cur->key;
+}
+
+static void *MapIterator__value(MapIterator *this) {
+  return this->cur->value;
+}
+
+static MapIterator MapIterator__make(Map *map) {
+  MapIterator it = (MapIterator){.idx = (-1), .cur = NULL, map};
+  MapIterator__next((&it));
+  return it;
+}
+
+static void MapIterator__next(MapIterator *this) {
+  while ((this->idx < this->map->num_buckets)) {
+    while (((bool)this->cur)) {
+      this->cur = this->cur->next;
+      if (((bool)this->cur)) 
+      return;
+      
+    } 
+    this->idx += 1;
+    this->cur = ({ MapNode *__yield_0;
+  if ((this->idx < this->map->num_buckets)) {
+    __yield_0 = this->map->buckets[this->idx];
+  }  else {
+    __yield_0 = NULL;
+  } 
+;__yield_0; });
+    if (((bool)this->cur)) 
+    return;
+    
+  } 
+}
+
+static u64 HashMap__hash(char *s) {
+  u64 hash = 0xcbf29ce484222325;
+  for (i32 i = 0; (s[i] != '\0'); i += 1) {
+    hash = ((hash ^ ((u64)((u8)s[i]))) * 0x100000001b3);
+  } 
+  hash = (hash ^ (hash >> 32));
+  hash *= 0xd6e8feb86659fd93;
+  hash = (hash ^ (hash >> 32));
+  return hash;
+}
+
+static u64 hashmap_match_byte(u64 group, u8 byte) {
+  u64 x = (group ^ (HASHMAP_LSBS * ((u64)byte)));
+  return (((x - HASHMAP_LSBS) & (~x)) & HASHMAP_MSBS);
+}
+
+static u64 hashmap_match_empty(u64 group) {
+  return ((group & (~(group << 6))) & HASHMAP_MSBS);
+}
+
+static u64 hashmap_match_free(u64 group) {
+  return (group & HASHMAP_MSBS);
+}
+
+static HashMap *HashMap__new_sized(i32 capacity) {
+  HashMap *map = ((HashMap *)calloc(1, sizeof(HashMap)));
+  HashMap__alloc(map, capacity);
+  return map;
+}
+
+static HashMap *HashMap__new(void) {
+  return HashMap__new_sized(HASHMAP_GROUP);
+}
+
+static void HashMap__alloc(HashMap *this, i32 min_capacity) {
+  i32 capacity = HASHMAP_GROUP;
+  while ((capacity < min_capacity)) {
+    capacity *= 2;
+  } 
+  this->capacity = capacity;
+  this->ctrl = ((u8 *)malloc(capacity));
+  memset(this->ctrl, ((u8)HASHMAP_EMPTY), capacity);
+  this->slots = ((HashMapSlot *)malloc((capacity * sizeof(HashMapSlot))));
+  this->growth_left = ((capacity - (capacity / 8)) - this->num_items);
+}
+
+static u64 HashMap__group(HashMap *this, i32 index) {
+  return (*((u64 *)(this->ctrl + index)));
+}
+
+static i32 HashMap__find(HashMap *this, char *key, u64 hash) {
+  i32 mask = (this->capacity - 1);
+  u8 h2 = ((u8)(hash & 0x7F));
+  i32 pos = ((((i32)(hash >> 7)) & mask) & (~(HASHMAP_GROUP - 1)));
+  for (i32 step = HASHMAP_GROUP; true; step += HASHMAP_GROUP) {
+    u64 group = HashMap__group(this, pos);
+    for (u64 matches = hashmap_match_byte(group, h2); (matches != 0); matches = (matches & (matches - 1))) {
+      i32 index = (pos + (__builtin_ctzll(matches) / 8));
+      HashMapSlot *slot = (&this->slots[index]);
+      if ((slot->hash == hash && string__eq(slot->key, key))) 
+      return index;
+      
+    } 
+    if ((hashmap_match_empty(group) != 0)) 
+    return (-1);
+    
+    pos = ((pos + step) & mask);
+  } 
+  return (-1);
+}
+
+static i32 HashMap__find_free(HashMap *this, u64 hash) {
+  i32 mask = (this->capacity - 1);
+  i32 pos = ((((i32)(hash >> 7)) & mask) & (~(HASHMAP_GROUP - 1)));
+  for (i32 step = HASHMAP_GROUP; true; step += HASHMAP_GROUP) {
+    u64 free = hashmap_match_free(HashMap__group(this, pos));
+    if ((free != 0)) 
+    return (pos + (__builtin_ctzll(free) / 8));
+    
+    pos = ((pos + step) & mask);
+  } 
+  return (-1);
+}
+
+static void *HashMap__get(HashMap *this, char *key) {
+  i32 index = HashMap__find(this, key, HashMap__hash(key));
+  if ((index < 0)) 
+  return NULL;
+  
+  return this->slots[index].value;
+}
+
+static bool HashMap__exists(HashMap *this, char *key) {
+  return (HashMap__find(this, key, HashMap__hash(key)) >= 0);
+}
+
+static void HashMap__insert(HashMap *this, char *key, void *value) {
+  u64 hash = HashMap__hash(key);
+  i32 index = HashMap__find(this, key, hash);
+  if ((index >= 0)) {
+    this->slots[index].value = value;
+    return;
+  } 
+  index = HashMap__find_free(this, hash);
+  if ((this->growth_left == 0 && this->ctrl[index] == ((u8)HASHMAP_EMPTY))) {
+    HashMap__resize(this);
+    index = HashMap__find_free(this, hash);
+  } 
+  if (this->ctrl[index] == ((u8)HASHMAP_EMPTY)) {
+    this->growth_left -= 1;
+  } 
+  this->ctrl[index] = ((u8)(hash & 0x7F));
+  this->slots[index] = (HashMapSlot){hash, key, value};
+  this->num_items += 1;
+}
+
+static void *HashMap__remove(HashMap *this, char *key) {
+  i32 index = HashMap__find(this, key, HashMap__hash(key));
+  if ((index < 0)) 
+  return NULL;
+  
+  void *value = this->slots[index].value;
+  this->num_items -= 1;
+  i32 group_start = (index & (~(HASHMAP_GROUP - 1)));
+  if ((hashmap_match_empty(HashMap__group(this, group_start)) != 0)) {
+    this->ctrl[index] = ((u8)HASHMAP_EMPTY);
+    this->growth_left += 1;
+  }  else {
+    this->ctrl[index] = ((u8)HASHMAP_DELETED);
+  } 
+  return value;
+}
+
+static void HashMap__resize(HashMap *this) {
+  u8 *old_ctrl = this->ctrl;
+  HashMapSlot *old_slots = this->slots;
+  i32 old_capacity = this->capacity;
+  i32 capacity = (((this->num_items * 16) <= (old_capacity * 7)) ? old_capacity : (old_capacity * 2));
+  HashMap__alloc(this, capacity);
+  for (i32 i = 0; (i < old_capacity); i += 1) {
+    if (((old_ctrl[i] & 0x80) != 0)) 
+    continue;
+    
+    HashMapSlot slot = old_slots[i];
+    i32 index = HashMap__find_free(this, slot.hash);
+    this->ctrl[index] = old_ctrl[i];
+    this->slots[index] = slot;
+  } 
+  free(old_ctrl);
+  free(old_slots);
+}
+
+static void HashMap__print_keys(HashMap *this) {
+  for (HashMapIterator iter = HashMap__iter(this); ((bool)iter.cur); HashMapIterator__next((&iter))) {
+    printf("- '%s'\n""\n", HashMapIterator__key((&iter)));
+  } 
+}
+
+static void HashMap__push_keys(HashMap *this, Vector *vec) {
+  for (HashMapIterator iter = HashMap__iter(this); ((bool)iter.cur); HashMapIterator__next((&iter))) {
+    Vector__push(vec, HashMapIterator__key((&iter)));
+  } 
+}
+
+static void HashMap__free(HashMap *this) {
+  free(this->ctrl);
+  free(this->slots);
+}
+
+static HashMapIterator HashMap__iter(HashMap *this) {
+  return HashMapIterator__make(this);
+}
+
+static char *HashMapIterator__key(HashMapIterator *this) {
+  return this->cur->key;
+}
+
+static void *HashMapIterator__value(HashMapIterator *this) {
+  return this->cur->value;
+}
+
+static HashMapIterator HashMapIterator__make(HashMap *map) {
+  HashMapIterator it = (HashMapIterator){.idx = (-1), .cur = NULL, map};
+  HashMapIterator__next((&it));
+  return it;
+}
+
+static void HashMapIterator__next(HashMapIterator *this) {
+  this->cur = NULL;
+  this->idx += 1;
+  for (; (this->idx < this->map->capacity); this->idx += 1) {
+    if ((this->map->ctrl[this->idx] & 0x80) == 0) {
+      this->cur = (&this->map->slots[this->idx]);
+      return;
+    } 
+  } 
+}
+
+static i32 btree_compare_strings(char *a, char *b) {
+  return strcmp(a, b);
+}
+
+static i32 btree_compare_i64(i64 a, i64 b) {
+  return ((a < b) ? (-1) : ((a > b) ? 1 : 0));
+}
+
+static i32 btree_compare_u64(u64 a, u64 b) {
+  return ((a < b) ? (-1) : ((a > b) ? 1 : 0));
+}
+
+static i32 btree_compare_f64(f64 a, f64 b) {
+  return ((a < b) ? (-1) : ((a > b) ? 1 : 0));
+}
+
+static i32 compare_string_ptrs(void *a, void *b) {
+  return strcmp((*((char **)a)), (*((char **)b)));
+}
+
+static void bench_sorted(char **keys, i32 n) {
+  i32 rounds = (2000000 / n);
+  i32 ops = (n * rounds);
+  f64 start = time_now();
+  for (i32 r = 0; (r < rounds); r += 1) {
+    Map *map = Map__new();
+    for (i32 i = 0; (i < n); i += 1) {
+      Map__insert(map, keys[i], keys[i]);
+    } 
+    Vector *sorted = Vector__new();
+    Map__push_keys(map, sorted);
+    qsort(sorted->data, sorted->size, sizeof(char *), compare_string_ptrs);
+    for (i32 i = 0; (i < sorted->size); i += 1) {
+      bench_sink += ((u64)((char *)Vector__at(sorted, i))[0]);
+    } 
+    Vector__free(sorted);
+    Map__free(map);
+    free(map);
+  } 
+  bench_report(format_string("Map + sort (%d)", n), (time_now() - start), ops);
+  start = time_now();
+  for (i32 r = 0; (r < rounds); r += 1) {
+    BTreeMap__ptr_char_ptr_char *map = BTreeMap__ptr_char_ptr_char__new(btree_compare_strings);
+    for (i32 i = 0; (i < n); i += 1) {
+      BTreeMap__ptr_char_ptr_char__insert(map, keys[i], keys[i]);
+    } 
+    for (BTreeIterator__ptr_char_ptr_char it = BTreeMap__ptr_char_ptr_char__iter(map); BTreeIterator__ptr_char_ptr_char__valid((&it)); BTreeIterator__ptr_char_ptr_char__next((&it))) {
+      bench_sink += ((u64)BTreeIterator__ptr_char_ptr_char__key((&it))[0]);
+    } 
+    BTreeMap__ptr_char_ptr_char__free(map);
+  } 
+  bench_report(format_string("BTreeMap (%d)", n), (time_now() - start), ops);
+}
+
+static void bench_lookup(i32 n) {
+  i32 rounds = (2000000 / n);
+  i32 ops = (n * rounds);
+  BTreeMap__i64_i64 *btree = BTreeMap__i64_i64__new(btree_compare_i64);
+  char **keys = ((char **)calloc(n, sizeof(char *)));
+  HashMap *hashmap = HashMap__new();
+  for (i32 i = 0; (i < n); i += 1) {
+    i64 key = ((i64)(i * 7919));
+    keys[i] = format_string("%lld", key);
+    BTreeMap__i64_i64__insert(btree, key, key);
+    HashMap__insert(hashmap, keys[i], keys[i]);
+  } 
+  f64 start = time_now();
+  for (i32 r = 0; (r < rounds); r += 1) {
+    for (i32 i = 0; (i < n); i += 1) {
+      bench_sink += ((u64)HashMap__get(hashmap, keys[((i * 3) % n)]));
+    } 
+  } 
+  bench_report(format_string("HashMap lookup (%d)", n), (time_now() - start), ops);
+  start = time_now();
+  for (i32 r = 0; (r < rounds); r += 1) {
+    for (i32 i = 0; (i < n); i += 1) {
+      bench_sink += ((u64)BTreeMap__i64_i64__get_or(btree, ((i64)(((i * 3) % n) * 7919)), 0));
+    } 
+  } 
+  bench_report(format_string("BTreeMap lookup (%d)", n), (time_now() - start), ops);
+  BTreeMap__i64_i64__free(btree);
+  HashMap__free(hashmap);
+}
+
+i32 main(void) {
+  i32 n = 100000;
+  char **keys = ((char **)calloc(n, sizeof(char *)));
+  for (i32 i = 0; (i < n); i += 1) {
+    keys[i] = format_string("key_%d", ((i * 7919) % n));
+  } 
+  bench_sorted(keys, 16);
+  bench_sorted(keys, 1000);
+  bench_sorted(keys, 100000);
+  printf("""\n");
+  bench_lookup(1000);
+  bench_lookup(100000);
+}
+
+static BTreeMap__i64_i64 *BTreeMap__i64_i64__new(i32 (*compare)(i64, i64)) {
+  BTreeMap__i64_i64 *map = ((BTreeMap__i64_i64 *)calloc(1, sizeof(BTreeMap__i64_i64)));
+  map->root = calloc(1, sizeof(BTreeLeaf__i64_i64));
+  map->compare = compare;
+  return map;
+}
+
+static i32 BTreeMap__i64_i64__lower_bound_in(BTreeMap__i64_i64 *this, i64 *keys, i32 n, i64 key) {
+  i32 lo = 0;
+  i32 hi = n;
+  while ((lo < hi)) {
+    i32 mid = ((lo + hi) / 2);
+    if ((this->compare(keys[mid], key) < 0)) {
+      lo = (mid + 1);
+    }  else {
+      hi = mid;
+    } 
+  } 
+  return lo;
+}
+
+static i32 BTreeMap__i64_i64__child_index(BTreeMap__i64_i64 *this, BTreeInner__i64_i64 *node, i64 key) {
+  i32 lo = 0;
+  i32 hi = node->num_keys;
+  while ((lo < hi)) {
+    i32 mid = ((lo + hi) / 2);
+    if ((this->compare(node->keys[mid], key) <= 0)) {
+      lo = (mid + 1);
+    }  else {
+      hi = mid;
+    } 
+  } 
+  return lo;
+}
+
+static BTreeLeaf__i64_i64 *BTreeMap__i64_i64__find_leaf(BTreeMap__i64_i64 *this, i64 key) {
+  void *node = this->root;
+  for (i32 level = this->height; (level > 0); level -= 1) {
+    BTreeInner__i64_i64 *inner = ((BTreeInner__i64_i64 *)node);
+    node = inner->children[BTreeMap__i64_i64__child_index(this, inner, key)];
+  } 
+  return ((BTreeLeaf__i64_i64 *)node);
+}
+
+static i64 *BTreeMap__i64_i64__get_ptr(BTreeMap__i64_i64 *this, i64 key) {
+  BTreeLeaf__i64_i64 *leaf = BTreeMap__i64_i64__find_leaf(this, key);
+  i32 i = BTreeMap__i64_i64__lower_bound_in(this, leaf->keys, leaf->num_keys, key);
+  if (((i < leaf->num_keys) && this->compare(leaf->keys[i], key) == 0)) 
+  return (&leaf->values[i]);
+  
+  return NULL;
+}
+
+static i64 BTreeMap__i64_i64__get_or(BTreeMap__i64_i64 *this, i64 key, i64 fallback) {
+  i64 *value = BTreeMap__i64_i64__get_ptr(this, key);
+  if (((bool)value)) 
+  return (*value);
+  
+  return fallback;
+}
+
+static bool BTreeMap__i64_i64__exists(BTreeMap__i64_i64 *this, i64 key) {
+  return ((bool)BTreeMap__i64_i64__get_ptr(this, key));
+}
+
+static void *BTreeMap__i64_i64__insert_into(BTreeMap__i64_i64 *this, void *node, i32 level, i64 key, i64 value, i64 *split_key) {
+  if (level == 0) {
+    BTreeLeaf__i64_i64 *leaf = ((BTreeLeaf__i64_i64 *)node);
+    i32 i = BTreeMap__i64_i64__lower_bound_in(this, leaf->keys, leaf->num_keys, key);
+    if (((i < leaf->num_keys) && this->compare(leaf->keys[i], key) == 0)) {
+      leaf->values[i] = value;
+      return NULL;
+    } 
+    this->size += 1;
+    BTreeLeaf__i64_i64 *right = ((BTreeLeaf__i64_i64 *)NULL);
+    if (leaf->num_keys == BTREE_MAX_KEYS) {
+      right = ((BTreeLeaf__i64_i64 *)calloc(1, sizeof(BTreeLeaf__i64_i64)));
+      i32 half = (BTREE_MAX_KEYS / 2);
+      right->num_keys = (leaf->num_keys - half);
+      memcpy(right->keys, (&leaf->keys[half]), (right->num_keys * sizeof(i64)));
+      memcpy(right->values, (&leaf->values[half]), (right->num_keys * sizeof(i64)));
+      leaf->num_keys = half;
+      right->next = leaf->next;
+      leaf->next = right;
+      if ((i > half)) {
+        leaf = right;
+        i -= half;
+      } 
+    } 
+    i32 after = (leaf->num_keys - i);
+    memmove((&leaf->keys[(i + 1)]), (&leaf->keys[i]), (after * sizeof(i64)));
+    memmove((&leaf->values[(i + 1)]), (&leaf->values[i]), (after * sizeof(i64)));
+    leaf->keys[i] = key;
+    leaf->values[i] = value;
+    leaf->num_keys += 1;
+    if (((bool)right)) 
+    (*split_key) = right->keys[0];
+    
+    return right;
+  } 
+  BTreeInner__i64_i64 *inner = ((BTreeInner__i64_i64 *)node);
+  i32 i = BTreeMap__i64_i64__child_index(this, inner, key);
+  i64 child_key;
+  void *child = BTreeMap__i64_i64__insert_into(this, inner->children[i], (level - 1), key, value, (&child_key));
+  if ((!((bool)child))) 
+  return NULL;
+  
+  BTreeInner__i64_i64 *right = ((BTreeInner__i64_i64 *)NULL);
+  if (inner->num_keys == BTREE_MAX_KEYS) {
+    right = ((BTreeInner__i64_i64 *)calloc(1, sizeof(BTreeInner__i64_i64)));
+    i32 half = (BTREE_MAX_KEYS / 2);
+    right->num_keys = ((inner->num_keys - half) - 1);
+    memcpy(right->keys, (&inner->keys[(half + 1)]), (right->num_keys * sizeof(i64)));
+    memcpy(right->children, (&inner->children[(half + 1)]), ((right->num_keys + 1) * sizeof(void *)));
+    (*split_key) = inner->keys[half];
+    inner->num_keys = half;
+    if ((i > half)) {
+      inner = right;
+      i -= (half + 1);
+    } 
+  } 
+  i32 after = (inner->num_keys - i);
+  memmove((&inner->keys[(i + 1)]), (&inner->keys[i]), (after * sizeof(i64)));
+  memmove((&inner->children[(i + 2)]), (&inner->children[(i + 1)]), (after * sizeof(void *)));
+  inner->keys[i] = child_key;
+  inner->children[(i + 1)] = child;
+  inner->num_keys += 1;
+  return right;
+}
+
+static void BTreeMap__i64_i64__insert(BTreeMap__i64_i64 *this, i64 key, i64 value) {
+  i64 split_key;
+  void *right = BTreeMap__i64_i64__insert_into(this, this->root, this->height, key, value, (&split_key));
+  if ((!((bool)right))) 
+  return;
+  
+  BTreeInner__i64_i64 *root = ((BTreeInner__i64_i64 *)calloc(1, sizeof(BTreeInner__i64_i64)));
+  root->num_keys = 1;
+  root->keys[0] = split_key;
+  root->children[0] = this->root;
+  root->children[1] = right;
+  this->root = root;
+  this->height += 1;
+}
+
+static BTreeMap__i64_i64 *BTreeMap__i64_i64__from_sorted(i64 *keys, i64 *values, i32 n, i32 (*compare)(i64, i64)) {
+  BTreeMap__i64_i64 *map = BTreeMap__i64_i64__new(compare);
+  if (n == 0) 
+  return map;
+  
+  free(map->root);
+  map->size = n;
+  i32 num_nodes = (((n + BTREE_MAX_KEYS) - 1) / BTREE_MAX_KEYS);
+  void **nodes = ((void **)calloc(num_nodes, sizeof(void *)));
+  i64 *min_keys = ((i64 *)calloc(num_nodes, sizeof(i64)));
+  BTreeLeaf__i64_i64 *prev = ((BTreeLeaf__i64_i64 *)NULL);
+  i32 start = 0;
+  for (i32 i = 0; (i < num_nodes); i += 1) {
+    i32 end = ((i32)((((i64)n) * ((i64)(i + 1))) / ((i64)num_nodes)));
+    BTreeLeaf__i64_i64 *leaf = ((BTreeLeaf__i64_i64 *)calloc(1, sizeof(BTreeLeaf__i64_i64)));
+    leaf->num_keys = (end - start);
+    memcpy(leaf->keys, (&keys[start]), (leaf->num_keys * sizeof(i64)));
+    memcpy(leaf->values, (&values[start]), (leaf->num_keys * sizeof(i64)));
+    (__builtin_expect(!!((start == 0 || (compare(keys[(start - 1)], keys[start]) < 0))), 1) ? (void)0 : panic("keys are not sorted"));
+    if (((bool)prev)) 
+    prev->next = leaf;
+    
+    prev = leaf;
+    nodes[i] = leaf;
+    min_keys[i] = keys[start];
+    start = end;
+  } 
+  while ((num_nodes > 1)) {
+    i32 num_parents = ((num_nodes + BTREE_MAX_KEYS) / (BTREE_MAX_KEYS + 1));
+    start = 0;
+    for (i32 i = 0; (i < num_parents); i += 1) {
+      i32 end = ((i32)((((i64)num_nodes) * ((i64)(i + 1))) / ((i64)num_parents)));
+      BTreeInner__i64_i64 *inner = ((BTreeInner__i64_i64 *)calloc(1, sizeof(BTreeInner__i64_i64)));
+      inner->num_keys = ((end - start) - 1);
+      for (i32 j = start; (j < end); j += 1) {
+        inner->children[(j - start)] = nodes[j];
+        if ((j > start)) 
+        inner->keys[((j - start) - 1)] = min_keys[j];
+        
+      } 
+      nodes[i] = inner;
+      min_keys[i] = min_keys[start];
+      start = end;
+    } 
+    num_nodes = num_parents;
+    map->height += 1;
+  } 
+  map->root = nodes[0];
+  free(nodes);
+  free(min_keys);
+  return map;
+}
+
+static void BTreeMap__i64_i64__free_node(BTreeMap__i64_i64 *this, void *node, i32 level) {
+  if ((level > 0)) {
+    BTreeInner__i64_i64 *inner = ((BTreeInner__i64_i64 *)node);
+    for (i32 i = 0; (i <= inner->num_keys); i += 1) {
+      BTreeMap__i64_i64__free_node(this, inner->children[i], (level - 1));
+    } 
+  } 
+  free(node);
+}
+
+static void BTreeMap__i64_i64__free(BTreeMap__i64_i64 *this) {
+  BTreeMap__i64_i64__free_node(this, this->root, this->height);
+  free(this);
+}
+
+static BTreeIterator__i64_i64 BTreeMap__i64_i64__iter(BTreeMap__i64_i64 *this) {
+  void *node = this->root;
+  for (i32 level = this->height; (level > 0); level -= 1) {
+    node = ((BTreeInner__i64_i64 *)node)->children[0];
+  } 
+  BTreeIterator__i64_i64 it = (BTreeIterator__i64_i64){this, ((BTreeLeaf__i64_i64 *)node), 0, .has_end = false, .end = BTreeMap__i64_i64__root_key(this)};
+  BTreeIterator__i64_i64__skip_empty((&it));
+  return it;
+}
+
+static BTreeIterator__i64_i64 BTreeMap__i64_i64__lower_bound(BTreeMap__i64_i64 *this, i64 key) {
+  BTreeLeaf__i64_i64 *leaf = BTreeMap__i64_i64__find_leaf(this, key);
+  i32 i = BTreeMap__i64_i64__lower_bound_in(this, leaf->keys, leaf->num_keys, key);
+  BTreeIterator__i64_i64 it = (BTreeIterator__i64_i64){this, leaf, i, .has_end = false, .end = key};
+  BTreeIterator__i64_i64__skip_empty((&it));
+  return it;
+}
+
+static BTreeIterator__i64_i64 BTreeMap__i64_i64__range(BTreeMap__i64_i64 *this, i64 lo, i64 hi) {
+  BTreeIterator__i64_i64 it = BTreeMap__i64_i64__lower_bound(this, lo);
+  it.has_end = true;
+  it.end = hi;
+  return it;
+}
+
+static i64 BTreeMap__i64_i64__root_key(BTreeMap__i64_i64 *this) {
+  i64 unused;
+  memset((&unused), 0, sizeof(i64));
+  return unused;
+}
+
+static void BTreeIterator__i64_i64__skip_empty(BTreeIterator__i64_i64 *this) {
+  while ((((bool)this->leaf) && (this->idx >= this->leaf->num_keys))) {
+    this->leaf = this->leaf->next;
+    this->idx = 0;
+  } 
+}
+
+static bool BTreeIterator__i64_i64__valid(BTreeIterator__i64_i64 *this) {
+  if ((!((bool)this->leaf))) 
+  return false;
+  
+  if ((this->has_end && (this->map->compare(this->leaf->keys[this->idx], this->end) >= 0))) 
+  return false;
+  
+  return true;
+}
+
+static i64 BTreeIterator__i64_i64__key(BTreeIterator__i64_i64 *this) {
+  return this->leaf->keys[this->idx];
+}
+
+static i64 BTreeIterator__i64_i64__value(BTreeIterator__i64_i64 *this) {
+  return this->leaf->values[this->idx];
+}
+
+static i64 *BTreeIterator__i64_i64__value_ptr(BTreeIterator__i64_i64 *this) {
+  return (&this->leaf->values[this->idx]);
+}
+
+static void BTreeIterator__i64_i64__next(BTreeIterator__i64_i64 *this) {
+  this->idx += 1;
+  BTreeIterator__i64_i64__skip_empty(this);
+}
+
+static BTreeMap__ptr_char_ptr_char *BTreeMap__ptr_char_ptr_char__new(i32 (*compare)(char *, char *)) {
+  BTreeMap__ptr_char_ptr_char *map = ((BTreeMap__ptr_char_ptr_char *)calloc(1, sizeof(BTreeMap__ptr_char_ptr_char)));
+  map->root = calloc(1, sizeof(BTreeLeaf__ptr_char_ptr_char));
+  map->compare = compare;
+  return map;
+}
+
+static i32 BTreeMap__ptr_char_ptr_char__lower_bound_in(BTreeMap__ptr_char_ptr_char *this, char **keys, i32 n, char *key) {
+  i32 lo = 0;
+  i32 hi = n;
+  while ((lo < hi)) {
+    i32 mid = ((lo + hi) / 2);
+    if ((this->compare(keys[mid], key) < 0)) {
+      lo = (mid + 1);
+    }  else {
+      hi = mid;
+    } 
+  } 
+  return lo;
+}
+
+static i32 BTreeMap__ptr_char_ptr_char__child_index(BTreeMap__ptr_char_ptr_char *this, BTreeInner__ptr_char_ptr_char *node, char *key) {
+  i32 lo = 0;
+  i32 hi = node->num_keys;
+  while ((lo < hi)) {
+    i32 mid = ((lo + hi) / 2);
+    if ((this->compare(node->keys[mid], key) <= 0)) {
+      lo = (mid + 1);
+    }  else {
+      hi = mid;
+    } 
+  } 
+  return lo;
+}
+
+static BTreeLeaf__ptr_char_ptr_char *BTreeMap__ptr_char_ptr_char__find_leaf(BTreeMap__ptr_char_ptr_char *this, char *key) {
+  void *node = this->root;
+  for (i32 level = this->height; (level > 0); level -= 1) {
+    BTreeInner__ptr_char_ptr_char *inner = ((BTreeInner__ptr_char_ptr_char *)node);
+    node = inner->children[BTreeMap__ptr_char_ptr_char__child_index(this, inner, key)];
+  } 
+  return ((BTreeLeaf__ptr_char_ptr_char *)node);
+}
+
+static char **BTreeMap__ptr_char_ptr_char__get_ptr(BTreeMap__ptr_char_ptr_char *this, char *key) {
+  BTreeLeaf__ptr_char_ptr_char *leaf = BTreeMap__ptr_char_ptr_char__find_leaf(this, key);
+  i32 i = BTreeMap__ptr_char_ptr_char__lower_bound_in(this, leaf->keys, leaf->num_keys, key);
+  if (((i < leaf->num_keys) && this->compare(leaf->keys[i], key) == 0)) 
+  return (&leaf->values[i]);
+  
+  return NULL;
+}
+
+static char *BTreeMap__ptr_char_ptr_char__get_or(BTreeMap__ptr_char_ptr_char *this, char *key, char *fallback) {
+  char **value = BTreeMap__ptr_char_ptr_char__get_ptr(this, key);
+  if (((bool)value)) 
+  return (*value);
+  
+  return fallback;
+}
+
+static bool BTreeMap__ptr_char_ptr_char__exists(BTreeMap__ptr_char_ptr_char *this, char *key) {
+  return ((bool)BTreeMap__ptr_char_ptr_char__get_ptr(this, key));
+}
+
+static void *BTreeMap__ptr_char_ptr_char__insert_into(BTreeMap__ptr_char_ptr_char *this, void *node, i32 level, char *key, char *value, char **split_key) {
+  if (level == 0) {
+    BTreeLeaf__ptr_char_ptr_char *leaf = ((BTreeLeaf__ptr_char_ptr_char *)node);
+    i32 i = BTreeMap__ptr_char_ptr_char__lower_bound_in(this, leaf->keys, leaf->num_keys, key);
+    if (((i < leaf->num_keys) && this->compare(leaf->keys[i], key) == 0)) {
+      leaf->values[i] = value;
+      return NULL;
+    } 
+    this->size += 1;
+    BTreeLeaf__ptr_char_ptr_char *right = ((BTreeLeaf__ptr_char_ptr_char *)NULL);
+    if (leaf->num_keys == BTREE_MAX_KEYS) {
+      right = ((BTreeLeaf__ptr_char_ptr_char *)calloc(1, sizeof(BTreeLeaf__ptr_char_ptr_char)));
+      i32 half = (BTREE_MAX_KEYS / 2);
+      right->num_keys = (leaf->num_keys - half);
+      memcpy(right->keys, (&leaf->keys[half]), (right->num_keys * sizeof(char *)));
+      memcpy(right->values, (&leaf->values[half]), (right->num_keys * sizeof(char *)));
+      leaf->num_keys = half;
+      right->next = leaf->next;
+      leaf->next = right;
+      if ((i > half)) {
+        leaf = right;
+        i -= half;
+      } 
+    } 
+    i32 after = (leaf->num_keys - i);
+    memmove((&leaf->keys[(i + 1)]), (&leaf->keys[i]), (after * sizeof(char *)));
+    memmove((&leaf->values[(i + 1)]), (&leaf->values[i]), (after * sizeof(char *)));
+    leaf->keys[i] = key;
+    leaf->values[i] = value;
+    leaf->num_keys += 1;
+    if (((bool)right)) 
+    (*split_key) = right->keys[0];
+    
+    return right;
+  } 
+  BTreeInner__ptr_char_ptr_char *inner = ((BTreeInner__ptr_char_ptr_char *)node);
+  i32 i = BTreeMap__ptr_char_ptr_char__child_index(this, inner, key);
+  char *child_key;
+  void *child = BTreeMap__ptr_char_ptr_char__insert_into(this, inner->children[i], (level - 1), key, value, (&child_key));
+  if ((!((bool)child))) 
+  return NULL;
+  
+  BTreeInner__ptr_char_ptr_char *right = ((BTreeInner__ptr_char_ptr_char *)NULL);
+  if (inner->num_keys == BTREE_MAX_KEYS) {
+    right = ((BTreeInner__ptr_char_ptr_char *)calloc(1, sizeof(BTreeInner__ptr_char_ptr_char)));
+    i32 half = (BTREE_MAX_KEYS / 2);
+    right->num_keys = ((inner->num_keys - half) - 1);
+    memcpy(right->keys, (&inner->keys[(half + 1)]), (right->num_keys * sizeof(char *)));
+    memcpy(right->children, (&inner->children[(half + 1)]), ((right->num_keys + 1) * sizeof(void *)));
+    (*split_key) = inner->keys[half];
+    inner->num_keys = half;
+    if ((i > half)) {
+      inner = right;
+      i -= (half + 1);
+    } 
+  } 
+  i32 after = (inner->num_keys - i);
+  memmove((&inner->keys[(i + 1)]), (&inner->keys[i]), (after * sizeof(char *)));
+  memmove((&inner->children[(i + 2)]), (&inner->children[(i + 1)]), (after * sizeof(void *)));
+  inner->keys[i] = child_key;
+  inner->children[(i + 1)] = child;
+  inner->num_keys += 1;
+  return right;
+}
+
+static void BTreeMap__ptr_char_ptr_char__insert(BTreeMap__ptr_char_ptr_char *this, char *key, char *value) {
+  char *split_key;
+  void *right = BTreeMap__ptr_char_ptr_char__insert_into(this, this->root, this->height, key, value, (&split_key));
+  if ((!((bool)right))) 
+  return;
+  
+  BTreeInner__ptr_char_ptr_char *root = ((BTreeInner__ptr_char_ptr_char *)calloc(1, sizeof(BTreeInner__ptr_char_ptr_char)));
+  root->num_keys = 1;
+  root->keys[0] = split_key;
+  root->children[0] = this->root;
+  root->children[1] = right;
+  this->root = root;
+  this->height += 1;
+}
+
+static BTreeMap__ptr_char_ptr_char *BTreeMap__ptr_char_ptr_char__from_sorted(char **keys, char **values, i32 n, i32 (*compare)(char *, char *)) {
+  BTreeMap__ptr_char_ptr_char *map = BTreeMap__ptr_char_ptr_char__new(compare);
+  if (n == 0) 
+  return map;
+  
+  free(map->root);
+  map->size = n;
+  i32 num_nodes = (((n + BTREE_MAX_KEYS) - 1) / BTREE_MAX_KEYS);
+  void **nodes = ((void **)calloc(num_nodes, sizeof(void *)));
+  char **min_keys = ((char **)calloc(num_nodes, sizeof(char *)));
+  BTreeLeaf__ptr_char_ptr_char *prev = ((BTreeLeaf__ptr_char_ptr_char *)NULL);
+  i32 start = 0;
+  for (i32 i = 0; (i < num_nodes); i += 1) {
+    i32 end = ((i32)((((i64)n) * ((i64)(i + 1))) / ((i64)num_nodes)));
+    BTreeLeaf__ptr_char_ptr_char *leaf = ((BTreeLeaf__ptr_char_ptr_char *)calloc(1, sizeof(BTreeLeaf__ptr_char_ptr_char)));
+    leaf->num_keys = (end - start);
+    memcpy(leaf->keys, (&keys[start]), (leaf->num_keys * sizeof(char *)));
+    memcpy(leaf->values, (&values[start]), (leaf->num_keys * sizeof(char *)));
+    (__builtin_expect(!!((start == 0 || (compare(keys[(start - 1)], keys[start]) < 0))), 1) ? (void)0 : panic("keys are not sorted"));
+    if (((bool)prev)) 
+    prev->next = leaf;
+    
+    prev = leaf;
+    nodes[i] = leaf;
+    min_keys[i] = keys[start];
+    start = end;
+  } 
+  while ((num_nodes > 1)) {
+    i32 num_parents = ((num_nodes + BTREE_MAX_KEYS) / (BTREE_MAX_KEYS + 1));
+    start = 0;
+    for (i32 i = 0; (i < num_parents); i += 1) {
+      i32 end = ((i32)((((i64)num_nodes) * ((i64)(i + 1))) / ((i64)num_parents)));
+      BTreeInner__ptr_char_ptr_char *inner = ((BTreeInner__ptr_char_ptr_char *)calloc(1, sizeof(BTreeInner__ptr_char_ptr_char)));
+      inner->num_keys = ((end - start) - 1);
+      for (i32 j = start; (j < end); j += 1) {
+        inner->children[(j - start)] = nodes[j];
+        if ((j > start)) 
+        inner->keys[((j - start) - 1)] = min_keys[j];
+        
+      } 
+      nodes[i] = inner;
+      min_keys[i] = min_keys[start];
+      start = end;
+    } 
+    num_nodes = num_parents;
+    map->height += 1;
+  } 
+  map->root = nodes[0];
+  free(nodes);
+  free(min_keys);
+  return map;
+}
+
+static void BTreeMap__ptr_char_ptr_char__free_node(BTreeMap__ptr_char_ptr_char *this, void *node, i32 level) {
+  if ((level > 0)) {
+    BTreeInner__ptr_char_ptr_char *inner = ((BTreeInner__ptr_char_ptr_char *)node);
+    for (i32 i = 0; (i <= inner->num_keys); i += 1) {
+      BTreeMap__ptr_char_ptr_char__free_node(this, inner->children[i], (level - 1));
+    } 
+  } 
+  free(node);
+}
+
+static void BTreeMap__ptr_char_ptr_char__free(BTreeMap__ptr_char_ptr_char *this) {
+  BTreeMap__ptr_char_ptr_char__free_node(this, this->root, this->height);
+  free(this);
+}
+
+static BTreeIterator__ptr_char_ptr_char BTreeMap__ptr_char_ptr_char__iter(BTreeMap__ptr_char_ptr_char *this) {
+  void *node = this->root;
+  for (i32 level = this->height; (level > 0); level -= 1) {
+    node = ((BTreeInner__ptr_char_ptr_char *)node)->children[0];
+  } 
+  BTreeIterator__ptr_char_ptr_char it = (BTreeIterator__ptr_char_ptr_char){this, ((BTreeLeaf__ptr_char_ptr_char *)node), 0, .has_end = false, .end = BTreeMap__ptr_char_ptr_char__root_key(this)};
+  BTreeIterator__ptr_char_ptr_char__skip_empty((&it));
+  return it;
+}
+
+static BTreeIterator__ptr_char_ptr_char BTreeMap__ptr_char_ptr_char__lower_bound(BTreeMap__ptr_char_ptr_char *this, char *key) {
+  BTreeLeaf__ptr_char_ptr_char *leaf = BTreeMap__ptr_char_ptr_char__find_leaf(this, key);
+  i32 i = BTreeMap__ptr_char_ptr_char__lower_bound_in(this, leaf->keys, leaf->num_keys, key);
+  BTreeIterator__ptr_char_ptr_char it = (BTreeIterator__ptr_char_ptr_char){this, leaf, i, .has_end = false, .end = key};
+  BTreeIterator__ptr_char_ptr_char__skip_empty((&it));
+  return it;
+}
+
+static BTreeIterator__ptr_char_ptr_char BTreeMap__ptr_char_ptr_char__range(BTreeMap__ptr_char_ptr_char *this, char *lo, char *hi) {
+  BTreeIterator__ptr_char_ptr_char it = BTreeMap__ptr_char_ptr_char__lower_bound(this, lo);
+  it.has_end = true;
+  it.end = hi;
+  return it;
+}
+
+static char *BTreeMap__ptr_char_ptr_char__root_key(BTreeMap__ptr_char_ptr_char *this) {
+  char *unused;
+  memset((&unused), 0, sizeof(char *));
+  return unused;
+}
+
+static void BTreeIterator__ptr_char_ptr_char__skip_empty(BTreeIterator__ptr_char_ptr_char *this) {
+  while ((((bool)this->leaf) && (this->idx >= this->leaf->num_keys))) {
+    this->leaf = this->leaf->next;
+    this->idx = 0;
+  } 
+}
+
+static bool BTreeIterator__ptr_char_ptr_char__valid(BTreeIterator__ptr_char_ptr_char *this) {
+  if ((!((bool)this->leaf))) 
+  return false;
+  
+  if ((this->has_end && (this->map->compare(this->leaf->keys[this->idx], this->end) >= 0))) 
+  return false;
+  
+  return true;
+}
+
+static char *BTreeIterator__ptr_char_ptr_char__key(BTreeIterator__ptr_char_ptr_char *this) {
+  return this->leaf->keys[this->idx];
+}
+
+static char *BTreeIterator__ptr_char_ptr_char__value(BTreeIterator__ptr_char_ptr_char *this) {
+  return this->leaf->values[this->idx];
+}
+
+static char **BTreeIterator__ptr_char_ptr_char__value_ptr(BTreeIterator__ptr_char_ptr_char *this) {
+  return (&this->leaf->values[this->idx]);
+}
+
+static void BTreeIterator__ptr_char_ptr_char__next(BTreeIterator__ptr_char_ptr_char *this) {
+  this->idx += 1;
+  BTreeIterator__ptr_char_ptr_char__skip_empty(this);
+}
+
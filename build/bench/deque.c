@@ -0,0 +1,1049 @@
+#include "stdio.h"
+#include "stdlib.h"
+#include "stdbool.h"
+#include "stdint.h"
+#include "string.h"
+#include "errno.h"
+#include "ctype.h"
+#include "time.h"
+#include "pthread.h"
+#include "sched.h"
+
+/***************** embed './lib/prelude.h' *****************/
+#include "stdarg.h"
+
+typedef int8_t i8;
+typedef int16_t i16;
+typedef int32_t i32;
+typedef int64_t i64;
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+
+typedef float f32;
+typedef double f64;
+
+// SIMD vector types, such as `f32x4`, using GCC's vector extensions
+#define AECOR_SIMD_TYPE(T, lanes) \
+  typedef T aecor_##T##x##lanes __attribute__((vector_size(sizeof(T) * lanes)));
+#define AECOR_SIMD_TYPES(T) \
+  AECOR_SIMD_TYPE(T, 2) AECOR_SIMD_TYPE(T, 4) AECOR_SIMD_TYPE(T, 8) \
+  AECOR_SIMD_TYPE(T, 16) AECOR_SIMD_TYPE(T, 32) AECOR_SIMD_TYPE(T, 64)
+
+AECOR_SIMD_TYPES(i8) AECOR_SIMD_TYPES(i16) AECOR_SIMD_TYPES(i32) AECOR_SIMD_TYPES(i64)
+AECOR_SIMD_TYPES(u8) AECOR_SIMD_TYPES(u16) AECOR_SIMD_TYPES(u32) AECOR_SIMD_TYPES(u64)
+AECOR_SIMD_TYPES(f32) AECOR_SIMD_TYPES(f64)
+
+#ifdef AECOR_TRACK_ALLOC
+// Allocation tracking for `--track-alloc`. Calls to `malloc`, `calloc`,
+// `realloc`, `free` and `strdup` in aecor code go through the functions
+// below, each with a static `aecor_alloc_site` for the call site. Live
+// blocks are kept in a side table keyed by pointer, so `free` still works
+// on memory allocated by C code, which is just not counted.
+//
+// Like `--instrument`, this is not synchronized between threads.
+typedef struct aecor_alloc_site {
+  const char* location;
+  u64 allocs;
+  u64 bytes;
+  u64 live;
+  u64 live_bytes;
+  struct aecor_alloc_site* next;
+} aecor_alloc_site;
+
+typedef struct {
+  void* ptr;
+  size_t size;
+  aecor_alloc_site* site;
+} aecor_alloc_block;
+
+static aecor_alloc_site* aecor_alloc_sites = NULL;
+static aecor_alloc_block* aecor_alloc_blocks = NULL;
+static size_t aecor_alloc_capacity = 0;  // Always a power of two
+static size_t aecor_alloc_count = 0;
+static u64 aecor_alloc_live_bytes = 0;
+static u64 aecor_alloc_peak_bytes = 0;
+
+// Site of the format string being built, set by the generated code
+static aecor_alloc_site aecor_alloc_unknown_format = {"<format string>"};
+static aecor_alloc_site* aecor_alloc_format_site = &aecor_alloc_unknown_format;
+
+static inline size_t aecor_alloc_slot(void* ptr) {
+  return ((uintptr_t)ptr >> 4) * 0x9e3779b97f4a7c15ull & (aecor_alloc_capacity - 1);
+}
+
+static void aecor_alloc_insert(aecor_alloc_block block) {
+  if ((aecor_alloc_count + 1) * 2 > aecor_alloc_capacity) {
+    aecor_alloc_block* old = aecor_alloc_blocks;
+    size_t old_capacity = aecor_alloc_capacity;
+    aecor_alloc_capacity = old_capacity ? old_capacity * 2 : 1024;
+    aecor_alloc_blocks = calloc(aecor_alloc_capacity, sizeof(aecor_alloc_block));
+    aecor_alloc_count = 0;
+    for (size_t i = 0; i < old_capacity; i++) {
+      if (old[i].ptr) aecor_alloc_insert(old[i]);
+    }
+    free(old);
+  }
+  size_t i = aecor_alloc_slot(block.ptr);
+  while (aecor_alloc_blocks[i].ptr) i = (i + 1) & (aecor_alloc_capacity - 1);
+  aecor_alloc_blocks[i] = block;
+  aecor_alloc_count++;
+}
+
+// Removes the block for `ptr` using backward-shift deletion, returning
+// false if it wasn't allocated by tracked code.
+static bool aecor_alloc_remove(void* ptr, aecor_alloc_block* out) {
+  if (!aecor_alloc_capacity) return false;
+  size_t mask = aecor_alloc_capacity - 1;
+  size_t i = aecor_alloc_slot(ptr);
+  while (aecor_alloc_blocks[i].ptr != ptr) {
+    if (!aecor_alloc_blocks[i].ptr) return false;
+    i = (i + 1) & mask;
+  }
+  *out = aecor_alloc_blocks[i];
+  for (size_t j = (i + 1) & mask; aecor_alloc_blocks[j].ptr; j = (j + 1) & mask) {
+    size_t home = aecor_alloc_slot(aecor_alloc_blocks[j].ptr);
+    // Move the entry into the hole unless its home slot is after the hole
+    if (((j - home) & mask) >= ((j - i) & mask)) {
+      aecor_alloc_blocks[i] = aecor_alloc_blocks[j];
+      i = j;
+    }
+  }
+  aecor_alloc_blocks[i].ptr = NULL;
+  aecor_alloc_count--;
+  return true;
+}
+
+static void aecor_alloc_record(void* ptr, size_t size, aecor_alloc_site* site) {
+  if (!ptr) return;
+  if (!site->allocs) {
+    site->next = aecor_alloc_sites;
+    aecor_alloc_sites = site;
+  }
+  site->allocs++;
+  site->bytes += size;
+  site->live++;
+  site->live_bytes += size;
+  aecor_alloc_live_bytes += size;
+  if (aecor_alloc_live_bytes > aecor_alloc_peak_bytes) {
+    aecor_alloc_peak_bytes = aecor_alloc_live_bytes;
+  }
+  aecor_alloc_insert((aecor_alloc_block){ptr, size, site});
+}
+
+static void aecor_alloc_forget(void* ptr) {
+  aecor_alloc_block block;
+  if (!ptr || !aecor_alloc_remove(ptr, &block)) return;
+  block.site->live--;
+  block.site->live_bytes -= block.size;
+  aecor_alloc_live_bytes -= block.size;
+}
+
+void* aecor_track_malloc(size_t size, aecor_alloc_site* site) {
+  void* ptr = malloc(size);
+  aecor_alloc_record(ptr, size, site);
+  return ptr;
+}
+
+void* aecor_track_calloc(size_t count, size_t size, aecor_alloc_site* site) {
+  void* ptr = calloc(count, size);
+  aecor_alloc_record(ptr, count * size, site);
+  return ptr;
+}
+
+void* aecor_track_realloc(void* old, size_t size, aecor_alloc_site* site) {
+  void* ptr = realloc(old, size);
+  if (!ptr && size) return ptr;
+  aecor_alloc_forget(old);
+  aecor_alloc_record(ptr, size, site);
+  return ptr;
+}
+
+char* aecor_track_strdup(const char* s, aecor_alloc_site* site) {
+  char* copy = strdup(s);
+  aecor_alloc_record(copy, strlen(s) + 1, site);
+  return copy;
+}
+
+void aecor_track_free(void* ptr) {
+  aecor_alloc_forget(ptr);
+  free(ptr);
+}
+
+static void* aecor_track_format_alloc(size_t size) {
+  aecor_alloc_site* site = aecor_alloc_format_site;
+  aecor_alloc_format_site = &aecor_alloc_unknown_format;
+  return aecor_track_malloc(size, site);
+}
+
+static int aecor_alloc_compare_bytes(const void* a, const void* b) {
+  u64 x = (*(aecor_alloc_site**)a)->bytes, y = (*(aecor_alloc_site**)b)->bytes;
+  return x < y ? 1 : x > y ? -1 : 0;
+}
+
+static int aecor_alloc_compare_live(const void* a, const void* b) {
+  u64 x = (*(aecor_alloc_site**)a)->live_bytes, y = (*(aecor_alloc_site**)b)->live_bytes;
+  return x < y ? 1 : x > y ? -1 : 0;
+}
+
+// Writes the sites that allocated the most bytes, followed by the ones
+// with memory that was never freed.
+static void aecor_alloc_report(void) {
+  const char* path = getenv("AECOR_ALLOC_REPORT");
+  if (!path) path = "aecor_alloc.txt";
+  FILE* file = fopen(path, "w");
+  if (!file) {
+    fprintf(stderr, "Could not write allocation report to %s\n", path);
+    return;
+  }
+
+  size_t count = 0;
+  u64 allocs = 0, bytes = 0, live = 0;
+  for (aecor_alloc_site* site = aecor_alloc_sites; site; site = site->next) {
+    count++;
+    allocs += site->allocs;
+    bytes += site->bytes;
+    live += site->live;
+  }
+  aecor_alloc_site** sites = malloc((count + 1) * sizeof(aecor_alloc_site*));
+  size_t n = 0;
+  for (aecor_alloc_site* site = aecor_alloc_sites; site; site = site->next) sites[n++] = site;
+
+  fprintf(file, "# %llu allocations, %llu bytes, peak %llu bytes live\n",
+          (unsigned long long)allocs, (unsigned long long)bytes,
+          (unsigned long long)aecor_alloc_peak_bytes);
+  fprintf(file, "# %llu blocks, %llu bytes never freed\n",
+          (unsigned long long)live, (unsigned long long)aecor_alloc_live_bytes);
+
+  const char* header = "# %12s %14s %12s %14s  %s\n";
+  const char* row = "%14llu %14llu %12llu %14llu  %s\n";
+  fprintf(file, "\n# Top allocators\n");
+  fprintf(file, header, "allocs", "bytes", "live", "live_bytes", "site");
+  qsort(sites, n, sizeof(aecor_alloc_site*), aecor_alloc_compare_bytes);
+  for (size_t i = 0; i < n; i++) {
+    aecor_alloc_site* site = sites[i];
+    fprintf(file, row, (unsigned long long)site->allocs, (unsigned long long)site->bytes,
+            (unsigned long long)site->live, (unsigned long long)site->live_bytes, site->location);
+  }
+
+  fprintf(file, "\n# Leaks\n");
+  fprintf(file, header, "allocs", "bytes", "live", "live_bytes", "site");
+  qsort(sites, n, sizeof(aecor_alloc_site*), aecor_alloc_compare_live);
+  for (size_t i = 0; i < n && sites[i]->live; i++) {
+    aecor_alloc_site* site = sites[i];
+    fprintf(file, row, (unsigned long long)site->allocs, (unsigned long long)site->bytes,
+            (unsigned long long)site->live, (unsigned long long)site->live_bytes, site->location);
+  }
+  free(sites);
+  fclose(file);
+}
+
+__attribute__((constructor)) static void aecor_alloc_init(void) {
+  atexit(aecor_alloc_report);
+}
+
+#define AECOR_FORMAT_ALLOC aecor_track_format_alloc
+#else
+#define AECOR_FORMAT_ALLOC malloc
+#endif
+
+// Formats into `stack` if the result fits in `capacity` bytes, otherwise
+// returns a new heap-allocated string that the caller needs to free.
+char* format_string_into(char* stack, int capacity, const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  int size = vsnprintf(stack, capacity, format, args);
+  va_end(args);
+  if (size < capacity) return stack;
+  char* s = malloc(size + 1);
+  va_start(args, format);
+  vsnprintf(s, size + 1, format, args);
+  va_end(args);
+  return s;
+}
+
+// Formats into a stack buffer first since most formatted strings are short,
+// which saves a separate pass just to compute the size.
+static char* aecor_vformat(void* (*alloc)(size_t), const char* format, va_list args) {
+  char stack[256];
+  va_list copy;
+  va_copy(copy, args);
+  int size = vsnprintf(stack, sizeof(stack), format, copy);
+  va_end(copy);
+  char* s = alloc(size + 1);
+  if (size < (int)sizeof(stack)) {
+    memcpy(s, stack, size + 1);
+  } else {
+    vsnprintf(s, size + 1, format, args);
+  }
+  return s;
+}
+
+char* format_string(const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  char* s = aecor_vformat(AECOR_FORMAT_ALLOC, format, args);
+  va_end(args);
+  return s;
+}
+
+// Scratch arena backing `scratch { ... }` blocks. Memory is handed out from a
+// list of chunks with a bump pointer, and everything allocated inside a block
+// is released at once when it ends by restoring the position saved on entry.
+// Chunks past the current one are kept around to be reused.
+#define AECOR_SCRATCH_CHUNK_SIZE (64 * 1024)
+
+typedef struct aecor_scratch_chunk {
+  struct aecor_scratch_chunk* next;
+  size_t capacity;
+  size_t used;
+  char data[];
+} aecor_scratch_chunk;
+
+typedef struct {
+  aecor_scratch_chunk* chunk;
+  size_t used;
+} aecor_scratch_mark;
+
+static aecor_scratch_chunk* aecor_scratch_first = NULL;
+static aecor_scratch_chunk* aecor_scratch_current = NULL;
+
+void* scratch_alloc(size_t size) {
+  size = (size + 15) & ~(size_t)15;
+  aecor_scratch_chunk* chunk = aecor_scratch_current;
+  if (!chunk || chunk->used + size > chunk->capacity) {
+    aecor_scratch_chunk** link = chunk ? &chunk->next : &aecor_scratch_first;
+    if (!*link || (*link)->capacity < size) {
+      size_t capacity = size > AECOR_SCRATCH_CHUNK_SIZE ? size : AECOR_SCRATCH_CHUNK_SIZE;
+      aecor_scratch_chunk* fresh = malloc(sizeof(aecor_scratch_chunk) + capacity);
+      if (!fresh) {
+        printf("Out of memory!\n");
+        exit(1);
+      }
+      fresh->capacity = capacity;
+      fresh->next = *link;
+      *link = fresh;
+    }
+    chunk = *link;
+    chunk->used = 0;
+    aecor_scratch_current = chunk;
+  }
+  void* ptr = chunk->data + chunk->used;
+  chunk->used += size;
+  return ptr;
+}
+
+aecor_scratch_mark aecor_scratch_save() {
+  aecor_scratch_chunk* chunk = aecor_scratch_current;
+  return (aecor_scratch_mark){chunk, chunk ? chunk->used : 0};
+}
+
+void aecor_scratch_restore(aecor_scratch_mark* mark) {
+  aecor_scratch_current = mark->chunk;
+  if (mark->chunk) mark->chunk->used = mark->used;
+}
+
+char* format_string_scratch(const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  char* s = aecor_vformat(scratch_alloc, format, args);
+  va_end(args);
+  return s;
+}
+
+// Output buffer for `print` / `println` when compiling with `-b`. Writes are
+// collected here and handed to stdio in large chunks, which avoids paying
+// for `printf`'s locking and format parsing on every call.
+#define AECOR_STDOUT_BUFFER_SIZE (64 * 1024)
+
+static char aecor_stdout_buffer[AECOR_STDOUT_BUFFER_SIZE];
+static size_t aecor_stdout_size = 0;
+
+void aecor_stdout_flush(void) {
+  fwrite(aecor_stdout_buffer, 1, aecor_stdout_size, stdout);
+  fflush(stdout);
+  aecor_stdout_size = 0;
+}
+
+__attribute__((constructor)) static void aecor_stdout_init(void) {
+  atexit(aecor_stdout_flush);
+}
+
+static inline void aecor_stdout_write(const char* s, size_t len) {
+  if (aecor_stdout_size + len > AECOR_STDOUT_BUFFER_SIZE) {
+    aecor_stdout_flush();
+    if (len > AECOR_STDOUT_BUFFER_SIZE) {
+      fwrite(s, 1, len, stdout);
+      return;
+    }
+  }
+  memcpy(aecor_stdout_buffer + aecor_stdout_size, s, len);
+  aecor_stdout_size += len;
+}
+
+void aecor_stdout_puts(const char* s) {
+  aecor_stdout_write(s, strlen(s));
+}
+
+void aecor_stdout_putc(char c) {
+  if (aecor_stdout_size == AECOR_STDOUT_BUFFER_SIZE) aecor_stdout_flush();
+  aecor_stdout_buffer[aecor_stdout_size++] = c;
+}
+
+void aecor_stdout_put_u64(u64 value) {
+  char digits[20];
+  int len = 0;
+  do {
+    digits[sizeof(digits) - ++len] = '0' + value % 10;
+    value /= 10;
+  } while (value);
+  aecor_stdout_write(digits + sizeof(digits) - len, len);
+}
+
+void aecor_stdout_put_i64(i64 value) {
+  if (value < 0) {
+    aecor_stdout_putc('-');
+    aecor_stdout_put_u64(-(u64)value);
+  } else {
+    aecor_stdout_put_u64(value);
+  }
+}
+
+// Used for anything that isn't a format string literal, as well as the
+// arguments with explicit format specs.
+int aecor_stdout_printf(const char* format, ...) {
+  char stack[256];
+  va_list args;
+  va_start(args, format);
+  int size = vsnprintf(stack, sizeof(stack), format, args);
+  va_end(args);
+  if (size < (int)sizeof(stack)) {
+    aecor_stdout_write(stack, size);
+  } else {
+    char* s = malloc(size + 1);
+    va_start(args, format);
+    vsnprintf(s, size + 1, format, args);
+    va_end(args);
+    aecor_stdout_write(s, size);
+    free(s);
+  }
+  return size;
+}
+
+void aecor_stdout_put_f64(f64 value) {
+  aecor_stdout_printf("%f", value);
+}
+
+void aecor_stdout_put_ptr(void* value) {
+  aecor_stdout_printf("%p", value);
+}
+
+// FNV-1a with a murmur3 finalizer, used for hashed dispatch on strings.
+// Must be kept in sync with `hash_string` in `compiler/utils.ae`.
+u32 aecor_hash_str(const char* s, u32 seed) {
+  u32 hash = seed;
+  for (; *s; s++) {
+    hash = (hash ^ (u8)*s) * 16777619u;
+  }
+  hash = (hash ^ (hash >> 16)) * 0x85ebca6bu;
+  hash = (hash ^ (hash >> 13)) * 0xc2b2ae35u;
+  return hash ^ (hash >> 16);
+}
+
+#ifdef AECOR_INSTRUMENT
+#include <time.h>
+
+// Per-function profiling for `--instrument`. Every instrumented function
+// pushes a frame on entry, which is popped by a `cleanup` handler whenever
+// the function returns. Time spent in instrumented callees is subtracted
+// from the caller's exclusive time. Recursive calls only count towards
+// inclusive time once, for the outermost call.
+//
+// Counters are not synchronized, so this is only accurate for programs
+// that call instrumented functions from a single thread.
+typedef struct {
+  const char* name;
+  const char* location;
+  u64 calls;
+  u64 inclusive_ns;
+  u64 exclusive_ns;
+  u32 active;
+} aecor_prof_entry;
+
+typedef struct aecor_prof_frame {
+  aecor_prof_entry* entry;
+  struct aecor_prof_frame* parent;
+  u64 start;
+  u64 children;
+} aecor_prof_frame;
+
+// Defined at the end of the generated code, one entry per function
+extern aecor_prof_entry aecor_prof_table[];
+extern u32 aecor_prof_count;
+
+static __thread aecor_prof_frame* aecor_prof_current = NULL;
+
+static inline u64 aecor_prof_now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (u64)ts.tv_sec * 1000000000ull + (u64)ts.tv_nsec;
+}
+
+static inline void aecor_prof_enter(aecor_prof_frame* frame, u32 id) {
+  frame->entry = &aecor_prof_table[id];
+  frame->entry->calls++;
+  frame->entry->active++;
+  frame->parent = aecor_prof_current;
+  frame->children = 0;
+  aecor_prof_current = frame;
+  frame->start = aecor_prof_now();
+}
+
+static inline void aecor_prof_exit(aecor_prof_frame* frame) {
+  u64 elapsed = aecor_prof_now() - frame->start;
+  aecor_prof_entry* entry = frame->entry;
+  entry->active--;
+  if (entry->active == 0) entry->inclusive_ns += elapsed;
+  entry->exclusive_ns += elapsed - frame->children;
+  if (frame->parent) frame->parent->children += elapsed;
+  aecor_prof_current = frame->parent;
+}
+
+// Writes one line per function that was called, in declaration order so
+// that reports from different runs can be diffed directly. The output is
+// whitespace separated for `sort -k`, e.g. `sort -k3 -n -r` for the
+// functions with the most exclusive time.
+static void aecor_prof_report(void) {
+  // Functions still running when `exit()` was called end here
+  while (aecor_prof_current) aecor_prof_exit(aecor_prof_current);
+
+  const char* path = getenv("AECOR_PROFILE");
+  if (!path) path = "aecor_profile.txt";
+  FILE* file = fopen(path, "w");
+  if (!file) {
+    fprintf(stderr, "Could not write profile to %s\n", path);
+    return;
+  }
+  fprintf(file, "# %12s %16s %16s  %s  %s\n",
+          "calls", "inclusive_ns", "exclusive_ns", "function", "location");
+  for (u32 i = 0; i < aecor_prof_count; i++) {
+    aecor_prof_entry* entry = &aecor_prof_table[i];
+    if (entry->calls == 0) continue;
+    fprintf(file, "%14llu %16llu %16llu  %s  %s\n",
+            (unsigned long long)entry->calls,
+            (unsigned long long)entry->inclusive_ns,
+            (unsigned long long)entry->exclusive_ns,
+            entry->name, entry->location);
+  }
+  fclose(file);
+}
+
+__attribute__((constructor)) static void aecor_prof_init(void) {
+  atexit(aecor_prof_report);
+}
+#endif
+
+
+/* constants */
+const i32 SPSC_ITEMS = 2000000;
+
+/* struct declarations */
+typedef struct Vector Vector;
+typedef struct SPSCQueue SPSCQueue;
+typedef struct Deque__ptr_void Deque__ptr_void;
+
+struct Vector {
+  i32 size;
+  i32 capacity;
+  void **data;
+};
+
+struct SPSCQueue {
+  void **slots;
+  u32 mask;
+  u8 _pad0[64];
+  u32 tail;
+  u32 cached_head;
+  u8 _pad1[64];
+  u32 head;
+  u32 cached_tail;
+  u8 _pad2[64];
+};
+
+struct Deque__ptr_void {
+  i32 size;
+  i32 capacity;
+  i32 head;
+  void **data;
+};
+
+/* function declarations */
+static FILE *File__open(char *path, char *mode);
+static bool File__exists(char *path);
+static i32 File__size(FILE *this);
+static char *File__slurp(FILE *this);
+static i32 File__read(FILE *this, void *buf, i32 size);
+static i32 File__write(FILE *this, void *buf, i32 size);
+static void File__puts(FILE *this, char *str);
+static __attribute__((noreturn)) __attribute__((cold)) void panic(char *msg);
+static bool string__starts_with(char *this, char *prefix);
+static bool string__ends_with(char *this, char *suffix);
+static void string__remove_last_n(char *this, i32 n);
+static bool string__eq(char *this, char *str2);
+static char *string__substring(char *this, i32 start, i32 len);
+static void string__strip_trailing_whitespace(char *this);
+static i32 min(i32 a, i32 b);
+static i32 max(i32 a, i32 b);
+static f64 time_now(void);
+static void bench_report(char *name, f64 elapsed, i32 iters);
+static Vector *Vector__new_sized(i32 capacity);
+static Vector *Vector__new(void);
+static void Vector__resize(Vector *this, i32 new_capacity);
+static inline __attribute__((always_inline)) void Vector__push(Vector *this, void *val);
+static void Vector__push_front(Vector *this, void *val);
+static void *Vector__pop(Vector *this);
+static inline __attribute__((always_inline)) void *Vector__back(Vector *this);
+static inline __attribute__((always_inline)) void *Vector__at(Vector *this, i32 i);
+static inline __attribute__((always_inline)) bool Vector__empty(Vector *this);
+static void Vector__free(Vector *this);
+static pthread_t *Thread__spawn(void *(*func)(void *), void *arg);
+static void *Thread__join(pthread_t *this);
+static void Mutex__init(pthread_mutex_t *this);
+static SPSCQueue *SPSCQueue__new(i32 capacity);
+static i32 SPSCQueue__capacity(SPSCQueue *this);
+static bool SPSCQueue__push(SPSCQueue *this, void *value);
+static bool SPSCQueue__pop(SPSCQueue *this, void **value);
+static i32 SPSCQueue__size(SPSCQueue *this);
+static void SPSCQueue__free(SPSCQueue *this);
+static void bench_queue(i32 n);
+static void *spsc_producer(void *arg);
+static void bench_spsc(void);
+i32 main(void);
+static Deque__ptr_void *Deque__ptr_void__new_sized(i32 capacity);
+static Deque__ptr_void *Deque__ptr_void__new(void);
+static inline __attribute__((always_inline)) i32 Deque__ptr_void__index(Deque__ptr_void *this, i32 i);
+static void Deque__ptr_void__grow(Deque__ptr_void *this);
+static inline __attribute__((always_inline)) void Deque__ptr_void__push_back(Deque__ptr_void *this, void *val);
+static inline __attribute__((always_inline)) void Deque__ptr_void__push_front(Deque__ptr_void *this, void *val);
+static void *Deque__ptr_void__pop_back(Deque__ptr_void *this);
+static void *Deque__ptr_void__pop_front(Deque__ptr_void *this);
+static inline __attribute__((always_inline)) void *Deque__ptr_void__front(Deque__ptr_void *this);
+static inline __attribute__((always_inline)) void *Deque__ptr_void__back(Deque__ptr_void *this);
+static inline __attribute__((always_inline)) void *Deque__ptr_void__at(Deque__ptr_void *this, i32 i);
+static inline __attribute__((always_inline)) void **Deque__ptr_void__at_ptr(Deque__ptr_void *this, i32 i);
+static inline __attribute__((always_inline)) bool Deque__ptr_void__empty(Deque__ptr_void *this);
+static void Deque__ptr_void__clear(Deque__ptr_void *this);
+static void Deque__ptr_void__free(Deque__ptr_void *this);
+
+/* global variables */
+u64 bench_sink = 0;
+
+static FILE *File__open(char *path, char *mode) {
+  FILE *file = fopen(path, mode);
+  if ((!((bool)file))) {
+    printf("Error opening file '%s': %s""\n", path, strerror(errno));
+    exit(1);
+  } 
+  return file;
+}
+
+static bool File__exists(char *path) {
+  FILE *file = fopen(path, "r");
+  if ((!((bool)file))) {
+    return false;
+  } 
+  fclose(file);
+  return true;
+}
+
+static i32 File__size(FILE *this) {
+  i32 pos = ftell(this);
+  fseek(this, 0, SEEK_END);
+  i32 size = ftell(this);
+  fseek(this, pos, SEEK_SET);
+  return size;
+}
+
+static char *File__slurp(FILE *this) {
+  i32 pos = ftell(this);
+  fseek(this, 0, SEEK_END);
+  i32 size = ftell(this);
+  fseek(this, pos, SEEK_SET);
+  void *buf = calloc((size + 1), sizeof(char));
+  fread(buf, 1, size, this);
+  fseek(this, pos, SEEK_SET);
+  return ((char *)buf);
+}
+
+static i32 File__read(FILE *this, void *buf, i32 size) {
+  return fread(buf, 1, size, this);
+}
+
+static i32 File__write(FILE *this, void *buf, i32 size) {
+  return fwrite(buf, 1, size, this);
+}
+
+static void File__puts(FILE *this, char *str) {
+  fwrite(str, 1, strlen(str), this);
+}
+
+static __attribute__((noreturn)) __attribute__((cold)) void panic(char *msg) {
+  printf("%s""\n", msg);
+  aecor_stdout_flush();
+  exit(1);
+}
+
+static bool string__starts_with(char *this, char *prefix) {
+  i32 prefix_len = strlen(prefix);
+  if ((strlen(this) < prefix_len)) {
+    return false;
+  } 
+  return strncmp(this, prefix, prefix_len) == 0;
+}
+
+static bool string__ends_with(char *this, char *suffix) {
+  i32 suffix_len = strlen(suffix);
+  if ((strlen(this) < suffix_len)) {
+    return false;
+  } 
+  return strncmp(this, suffix, suffix_len) == 0;
+}
+
+static void string__remove_last_n(char *this, i32 n) {
+  this[(strlen(this) - n)] = '\0';
+}
+
+static bool string__eq(char *this, char *str2) {
+  return strcmp(this, str2) == 0;
+}
+
+static char *string__substring(char *this, i32 start, i32 len) {
+  char *new_str = ((char *)calloc((len + 1), sizeof(char)));
+  memcpy(new_str, (this + start), len);
+  return new_str;
+}
+
+static void string__strip_trailing_whitespace(char *this) {
+  for (i32 i = (strlen(this) - 1); (i >= 0); i -= 1) {
+    if ((this[i] != ' ')) 
+    break;
+    
+    this[i] = '\0';
+  } 
+}
+
+static i32 min(i32 a, i32 b) {
+  return ((a < b) ? a : b);
+}
+
+static i32 max(i32 a, i32 b) {
+  return ((a > b) ? a : b);
+}
+
+static f64 time_now(void) {
+  struct timespec ts = {0};
+  clock_gettime(CLOCK_MONOTONIC, (&ts));
+  return (((f64)ts.tv_sec) + (((f64)ts.tv_nsec) / 1000000000.0));
+}
+
+static void bench_report(char *name, f64 elapsed, i32 iters) {
+  f64 ns = ((elapsed * 1000000000.0) / ((f64)iters));
+  printf("%-32s %10.3f ms %10.2f ns/iter""\n", name, (elapsed * 1000.0), ns);
+}
+
+static Vector *Vector__new_sized(i32 capacity) {
+  Vector *vec = ((Vector *)calloc(1, sizeof(Vector)));
+  vec->size = 0;
+  vec->capacity = capacity;
+  vec->data = ((void **)calloc(vec->capacity, sizeof(void *)));
+  return vec;
+}
+
+static Vector *Vector__new(void) {
+  return Vector__new_sized(16);
+}
+
+static void Vector__resize(Vector *this, i32 new_capacity) {
+  this->capacity = new_capacity;
+  this->data = ((void **)realloc(this->data, (this->capacity * sizeof(void *))));
+}
+
+static inline __attribute__((always_inline)) void Vector__push(Vector *this, void *val) {
+  if (this->size == this->capacity) {
+    Vector__resize(this, (this->capacity * 2));
+  } 
+  this->data[this->size] = val;
+  this->size += 1;
+}
+
+static void Vector__push_front(Vector *this, void *val) {
+  if (this->size == this->capacity) {
+    Vector__resize(this, (this->capacity * 2));
+  } 
+  memmove((this->data + 1), this->data, (this->size * sizeof(void *)));
+  this->data[0] = val;
+  this->size += 1;
+}
+
+static void *Vector__pop(Vector *this) {
+  (__builtin_expect(!!((this->size > 0)), 1) ? (void)0 : panic("pop on empty vector"));
+  this->size -= 1;
+  return this->data[this->size];
+}
+
+static inline __attribute__((always_inline)) void *Vector__back(Vector *this) {
+  (__builtin_expect(!!((this->size > 0)), 1) ? (void)0 : panic("back on empty vector"));
+  return this->data[(this->size - 1)];
+}
+
+static inline __attribute__((always_inline)) void *Vector__at(Vector *this, i32 i) {
+  (__builtin_expect(!!(((i >= 0) && (i < this->size))), 1) ? (void)0 : panic("at out of bounds in vector"));
+  return this->data[i];
+}
+
+static inline __attribute__((always_inline)) bool Vector__empty(Vector *this) {
+  return this->size == 0;
+}
+
+static void Vector__free(Vector *this) {
+  free(this->data);
+  free(this);
+}
+
+static pthread_t *Thread__spawn(void *(*func)(void *), void *arg) {
+  pthread_t *thread = ((pthread_t *)calloc(1, sizeof(pthread_t)));
+  if ((pthread_create(thread, NULL, func, arg) != 0)) {
+    printf("Failed to create thread: %s""\n", strerror(errno));
+    exit(1);
+  } 
+  return thread;
+}
+
+static void *Thread__join(pthread_t *this) {
+  void *result = ((void *)NULL);
+  pthread_join((*this), (&result));
+  free(this);
+  return result;
+}
+
+static void Mutex__init(pthread_mutex_t *this) {
+  pthread_mutex_init(this, NULL);
+}
+
+static SPSCQueue *SPSCQueue__new(i32 capacity) {
+  SPSCQueue *queue = ((SPSCQueue *)calloc(1, sizeof(SPSCQueue)));
+  i32 size = 1;
+  while ((size < capacity)) {
+    size *= 2;
+  } 
+  queue->slots = ((void **)calloc(size, sizeof(void *)));
+  queue->mask = ((u32)(size - 1));
+  return queue;
+}
+
+static i32 SPSCQueue__capacity(SPSCQueue *this) {
+  return (((i32)this->mask) + 1);
+}
+
+static bool SPSCQueue__push(SPSCQueue *this, void *value) {
+  u32 tail = this->tail;
+  if (((tail - this->cached_head) > this->mask)) {
+    this->cached_head = __atomic_load_n((&this->head), __ATOMIC_ACQUIRE);
+    if (((tail - this->cached_head) > this->mask)) 
+    return false;
+    
+  } 
+  this->slots[((i32)(tail & this->mask))] = value;
+  __atomic_store_n((&this->tail), (tail + 1), __ATOMIC_RELEASE);
+  return true;
+}
+
+static bool SPSCQueue__pop(SPSCQueue *this, void **value) {
+  u32 head = this->head;
+  if (head == this->cached_tail) {
+    this->cached_tail = __atomic_load_n((&this->tail), __ATOMIC_ACQUIRE);
+    if (head == this->cached_tail) 
+    return false;
+    
+  } 
+  (*value) = this->slots[((i32)(head & this->mask))];
+  __atomic_store_n((&this->head), (head + 1), __ATOMIC_RELEASE);
+  return true;
+}
+
+static i32 SPSCQueue__size(SPSCQueue *this) {
+  u32 tail = __atomic_load_n((&this->tail), __ATOMIC_ACQUIRE);
+  u32 head = __atomic_load_n((&this->head), __ATOMIC_ACQUIRE);
+  return ((i32)(tail - head));
+}
+
+static void SPSCQueue__free(SPSCQueue *this) {
+  free(this->slots);
+  free(this);
+}
+
+static void bench_queue(i32 n) {
+  i32 rounds = (2000000 / n);
+  i32 ops = (n * rounds);
+  f64 start = time_now();
+  for (i32 r = 0; (r < rounds); r += 1) {
+    Vector *vec = Vector__new();
+    for (i32 i = 0; (i < n); i += 1) {
+      Vector__push_front(vec, ((void *)((u64)i)));
+    } 
+    while ((!Vector__empty(vec))) {
+      bench_sink += ((u64)Vector__pop(vec));
+    } 
+    Vector__free(vec);
+  } 
+  bench_report(format_string("Vector::push_front (%d)", n), (time_now() - start), ops);
+  start = time_now();
+  for (i32 r = 0; (r < rounds); r += 1) {
+    Deque__ptr_void *deque = Deque__ptr_void__new();
+    for (i32 i = 0; (i < n); i += 1) {
+      Deque__ptr_void__push_front(deque, ((void *)((u64)i)));
+    } 
+    while ((!Deque__ptr_void__empty(deque))) {
+      bench_sink += ((u64)Deque__ptr_void__pop_back(deque));
+    } 
+    Deque__ptr_void__free(deque);
+  } 
+  bench_report(format_string("Deque::push_front (%d)", n), (time_now() - start), ops);
+}
+
+static void *spsc_producer(void *arg) {
+  SPSCQueue *queue = ((SPSCQueue *)arg);
+  for (i32 i = 1; (i <= SPSC_ITEMS); i += 1) {
+    while ((!SPSCQueue__push(queue, ((void *)((u64)i))))) {
+      sched_yield();
+    } 
+  } 
+  return NULL;
+}
+
+static void bench_spsc(void) {
+  SPSCQueue *queue = SPSCQueue__new(1024);
+  f64 start = time_now();
+  pthread_t *thread = Thread__spawn(spsc_producer, queue);
+  for (i32 i = 0; (i < SPSC_ITEMS); i += 1) {
+    void *value;
+    while ((!SPSCQueue__pop(queue, (&value)))) {
+      sched_yield();
+    } 
+    bench_sink += ((u64)value);
+  } 
+  Thread__join(thread);
+  bench_report("SPSCQueue, 2 threads", (time_now() - start), SPSC_ITEMS);
+  SPSCQueue__free(queue);
+}
+
+i32 main(void) {
+  bench_queue(16);
+  bench_queue(1000);
+  bench_queue(20000);
+  printf("""\n");
+  bench_spsc();
+}
+
+static Deque__ptr_void *Deque__ptr_void__new_sized(i32 capacity) {
+  Deque__ptr_void *deque = ((Deque__ptr_void *)calloc(1, sizeof(Deque__ptr_void)));
+  deque->capacity = 1;
+  while ((deque->capacity < capacity)) {
+    deque->capacity *= 2;
+  } 
+  deque->data = ((void **)calloc(deque->capacity, sizeof(void *)));
+  return deque;
+}
+
+static Deque__ptr_void *Deque__ptr_void__new(void) {
+  return Deque__ptr_void__new_sized(16);
+}
+
+static inline __attribute__((always_inline)) i32 Deque__ptr_void__index(Deque__ptr_void *this, i32 i) {
+  return ((this->head + i) & (this->capacity - 1));
+}
+
+static void Deque__ptr_void__grow(Deque__ptr_void *this) {
+  i32 old_capacity = this->capacity;
+  this->capacity *= 2;
+  this->data = ((void **)realloc(this->data, (this->capacity * sizeof(void *))));
+  i32 wrapped = ((this->head + this->size) - old_capacity);
+  if ((wrapped <= 0)) 
+  return;
+  
+  i32 tail = (old_capacity - this->head);
+  if ((wrapped <= tail)) {
+    memcpy((this->data + old_capacity), this->data, (wrapped * sizeof(void *)));
+  }  else {
+    memcpy(((this->data + this->head) + old_capacity), (this->data + this->head), (tail * sizeof(void *)));
+    this->head += old_capacity;
+  } 
+}
+
+static inline __attribute__((always_inline)) void Deque__ptr_void__push_back(Deque__ptr_void *this, void *val) {
+  if (this->size == this->capacity) {
+    Deque__ptr_void__grow(this);
+  } 
+  this->data[Deque__ptr_void__index(this, this->size)] = val;
+  this->size += 1;
+}
+
+static inline __attribute__((always_inline)) void Deque__ptr_void__push_front(Deque__ptr_void *this, void *val) {
+  if (this->size == this->capacity) {
+    Deque__ptr_void__grow(this);
+  } 
+  this->head = ((this->head - 1) & (this->capacity - 1));
+  this->data[this->head] = val;
+  this->size += 1;
+}
+
+static void *Deque__ptr_void__pop_back(Deque__ptr_void *this) {
+  (__builtin_expect(!!((this->size > 0)), 1) ? (void)0 : panic("pop_back on empty deque"));
+  this->size -= 1;
+  return this->data[Deque__ptr_void__index(this, this->size)];
+}
+
+static void *Deque__ptr_void__pop_front(Deque__ptr_void *this) {
+  (__builtin_expect(!!((this->size > 0)), 1) ? (void)0 : panic("pop_front on empty deque"));
+  void *val = this->data[this->head];
+  this->head = ((this->head + 1) & (this->capacity - 1));
+  this->size -= 1;
+  return val;
+}
+
+static inline __attribute__((always_inline)) void *Deque__ptr_void__front(Deque__ptr_void *this) {
+  (__builtin_expect(!!((this->size > 0)), 1) ? (void)0 : panic("front on empty deque"));
+  return this->data[this->head];
+}
+
+static inline __attribute__((always_inline)) void *Deque__ptr_void__back(Deque__ptr_void *this) {
+  (__builtin_expect(!!((this->size > 0)), 1) ? (void)0 : panic("back on empty deque"));
+  return this->data[Deque__ptr_void__index(this, (this->size - 1))];
+}
+
+static inline __attribute__((always_inline)) void *Deque__ptr_void__at(Deque__ptr_void *this, i32 i) {
+  (__builtin_expect(!!(((i >= 0) && (i < this->size))), 1) ? (void)0 : panic("at out of bounds in deque"));
+  return this->data[Deque__ptr_void__index(this, i)];
+}
+
+static inline __attribute__((always_inline)) void **Deque__ptr_void__at_ptr(Deque__ptr_void *this, i32 i) {
+  (__builtin_expect(!!(((i >= 0) && (i < this->size))), 1) ? (void)0 : panic("at_ptr out of bounds in deque"));
+  return (&this->data[Deque__ptr_void__index(this, i)]);
+}
+
+static inline __attribute__((always_inline)) bool Deque__ptr_void__empty(Deque__ptr_void *this) {
+  return this->size == 0;
+}
+
+static void Deque__ptr_void__clear(Deque__ptr_void *this) {
+  this->size = 0;
+  this->head = 0;
+}
+
+static void Deque__ptr_void__free(Deque__ptr_void *this) {
+  free(this->data);
+  free(this);
+}
+
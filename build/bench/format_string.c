@@ -0,0 +1,397 @@
+#include "stdio.h"
+#include "stdlib.h"
+#include "stdbool.h"
+#include "stdint.h"
+#include "string.h"
+#include "errno.h"
+#include "ctype.h"
+#include "time.h"
+
+/***************** embed './lib/prelude.h' *****************/
+#include "stdarg.h"
+
+typedef int8_t i8;
+typedef int16_t i16;
+typedef int32_t i32;
+typedef int64_t i64;
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+
+typedef float f32;
+typedef double f64;
+
+// Formats into `stack` if the result fits in `capacity` bytes, otherwise
+// returns a new heap-allocated string that the caller needs to free.
+char* format_string_into(char* stack, int capacity, const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  int size = vsnprintf(stack, capacity, format, args);
+  va_end(args);
+  if (size < capacity) return stack;
+  char* s = malloc(size + 1);
+  va_start(args, format);
+  vsnprintf(s, size + 1, format, args);
+  va_end(args);
+  return s;
+}
+
+char* format_string(const char* format, ...) {
+  // Most formatted strings are short, so try formatting into a stack buffer
+  // first instead of doing a separate pass just to compute the size.
+  char stack[256];
+  va_list args;
+  va_start(args, format);
+  int size = vsnprintf(stack, sizeof(stack), format, args);
+  va_end(args);
+  char* s = malloc(size + 1);
+  if (size < (int)sizeof(stack)) {
+    memcpy(s, stack, size + 1);
+  } else {
+    va_start(args, format);
+    vsnprintf(s, size + 1, format, args);
+    va_end(args);
+  }
+  return s;
+}
+
+// FNV-1a with a murmur3 finalizer, used for hashed dispatch on strings.
+// Must be kept in sync with `hash_string` in `compiler/utils.ae`.
+u32 aecor_hash_str(const char* s, u32 seed) {
+  u32 hash = seed;
+  for (; *s; s++) {
+    hash = (hash ^ (u8)*s) * 16777619u;
+  }
+  hash = (hash ^ (hash >> 16)) * 0x85ebca6bu;
+  hash = (hash ^ (hash >> 13)) * 0xc2b2ae35u;
+  return hash ^ (hash >> 16);
+}
+
+
+/* constants */
+
+/* struct declarations */
+typedef struct Buffer Buffer;
+
+struct Buffer {
+  u8 *data;
+  i32 size;
+  i32 capacity;
+};
+
+/* function declarations */
+FILE *File__open(char *path, char *mode);
+bool File__exists(char *path);
+i32 File__size(FILE *this);
+char *File__slurp(FILE *this);
+i32 File__read(FILE *this, void *buf, i32 size);
+i32 File__write(FILE *this, void *buf, i32 size);
+void File__puts(FILE *this, char *str);
+__attribute__((noreturn)) void panic(char *msg);
+bool string__starts_with(char *this, char *prefix);
+bool string__ends_with(char *this, char *suffix);
+void string__remove_last_n(char *this, i32 n);
+bool string__eq(char *this, char *str2);
+char *string__substring(char *this, i32 start, i32 len);
+void string__strip_trailing_whitespace(char *this);
+i32 min(i32 a, i32 b);
+i32 max(i32 a, i32 b);
+f64 time_now(void);
+void bench_report(char *name, f64 elapsed, i32 iters);
+Buffer Buffer__make(void);
+Buffer Buffer__from_string(char *s);
+Buffer Buffer__from_sized_string(char *s, i32 size);
+void Buffer__resize_if_necessary(Buffer *this, i32 new_size);
+void Buffer__hex_dump(Buffer *this);
+void Buffer__putb(Buffer *this, Buffer *buf);
+void Buffer__putbf(Buffer *this, Buffer *buf);
+void Buffer__puts(Buffer *this, char *s);
+void Buffer__putc(Buffer *this, char c);
+void Buffer__put_u64(Buffer *this, u64 value);
+void Buffer__put_i64(Buffer *this, i64 value);
+void Buffer__put_f64(Buffer *this, f64 value);
+void Buffer__put_ptr(Buffer *this, void *value);
+void Buffer__putsf(Buffer *this, char *s);
+char *Buffer__str(Buffer *this);
+char *Buffer__new_str(Buffer *this);
+void Buffer__free(Buffer *this);
+void run_putsf(i32 iters);
+void run_format_string(i32 iters);
+i32 main(void);
+
+/* global variables */
+u64 bench_sink = 0;
+
+FILE *File__open(char *path, char *mode) {
+  FILE *file = fopen(path, mode);
+  if ((!((bool)file))) {
+    printf("Error opening file '%s': %s""\n", path, strerror(errno));
+    exit(1);
+  } 
+  return file;
+}
+
+bool File__exists(char *path) {
+  FILE *file = fopen(path, "r");
+  if ((!((bool)file))) {
+    return false;
+  } 
+  fclose(file);
+  return true;
+}
+
+i32 File__size(FILE *this) {
+  i32 pos = ftell(this);
+  fseek(this, 0, SEEK_END);
+  i32 size = ftell(this);
+  fseek(this, pos, SEEK_SET);
+  return size;
+}
+
+char *File__slurp(FILE *this) {
+  i32 pos = ftell(this);
+  fseek(this, 0, SEEK_END);
+  i32 size = ftell(this);
+  fseek(this, pos, SEEK_SET);
+  void *buf = calloc((size + 1), sizeof(char));
+  fread(buf, 1, size, this);
+  fseek(this, pos, SEEK_SET);
+  return ((char *)buf);
+}
+
+i32 File__read(FILE *this, void *buf, i32 size) {
+  return fread(buf, 1, size, this);
+}
+
+i32 File__write(FILE *this, void *buf, i32 size) {
+  return fwrite(buf, 1, size, this);
+}
+
+void File__puts(FILE *this, char *str) {
+  fwrite(str, 1, strlen(str), this);
+}
+
+__attribute__((noreturn)) void panic(char *msg) {
+  printf("%s""\n", msg);
+  exit(1);
+}
+
+bool string__starts_with(char *this, char *prefix) {
+  i32 prefix_len = strlen(prefix);
+  if ((strlen(this) < prefix_len)) {
+    return false;
+  } 
+  return strncmp(this, prefix, prefix_len) == 0;
+}
+
+bool string__ends_with(char *this, char *suffix) {
+  i32 suffix_len = strlen(suffix);
+  if ((strlen(this) < suffix_len)) {
+    return false;
+  } 
+  return strncmp(this, suffix, suffix_len) == 0;
+}
+
+void string__remove_last_n(char *this, i32 n) {
+  this[(strlen(this) - n)] = '\0';
+}
+
+bool string__eq(char *this, char *str2) {
+  return strcmp(this, str2) == 0;
+}
+
+char *string__substring(char *this, i32 start, i32 len) {
+  char *new_str = ((char *)calloc((len + 1), sizeof(char)));
+  memcpy(new_str, (this + start), len);
+  return new_str;
+}
+
+void string__strip_trailing_whitespace(char *this) {
+  for (i32 i = (strlen(this) - 1); (i >= 0); i -= 1) {
+    if ((this[i] != ' ')) 
+    break;
+    
+    this[i] = '\0';
+  } 
+}
+
+i32 min(i32 a, i32 b) {
+  return ((a < b) ? a : b);
+}
+
+i32 max(i32 a, i32 b) {
+  return ((a > b) ? a : b);
+}
+
+f64 time_now(void) {
+  struct timespec ts = {0};
+  clock_gettime(CLOCK_MONOTONIC, (&ts));
+  return (((f64)ts.tv_sec) + (((f64)ts.tv_nsec) / 1000000000.0));
+}
+
+void bench_report(char *name, f64 elapsed, i32 iters) {
+  f64 ns = ((elapsed * 1000000000.0) / ((f64)iters));
+  printf("%-32s %10.3f ms %10.2f ns/iter""\n", name, (elapsed * 1000.0), ns);
+}
+
+Buffer Buffer__make(void) {
+  i32 initial_capacity = 16;
+  return (Buffer){.data = calloc(initial_capacity, 1), .size = 0, .capacity = initial_capacity};
+}
+
+Buffer Buffer__from_string(char *s) {
+  return (Buffer){.data = ((u8 *)s), .size = strlen(s), .capacity = strlen(s)};
+}
+
+Buffer Buffer__from_sized_string(char *s, i32 size) {
+  return (Buffer){.data = ((u8 *)s), .size = ((i32)size), .capacity = strlen(s)};
+}
+
+void Buffer__resize_if_necessary(Buffer *this, i32 new_size) {
+  if ((new_size >= this->capacity)) {
+    i32 new_capacity = max((this->capacity * 2), new_size);
+    this->data = ((u8 *)realloc(this->data, new_capacity));
+    if (this->data == NULL) {
+      printf("Out of memory!""\n");
+      exit(1);
+    } 
+    this->capacity = new_capacity;
+  } 
+}
+
+void Buffer__hex_dump(Buffer *this) {
+  printf("(%d bytes): ", this->size);
+  for (i32 i = 0; (i < this->size); i += 1) {
+    if (((i % 4) == 0 && (i > 0))) 
+    printf("_");
+    
+    printf("%02x", this->data[i]);
+  } 
+  printf("""\n");
+}
+
+void Buffer__putb(Buffer *this, Buffer *buf) {
+  Buffer__resize_if_necessary(this, ((this->size + buf->size) + 1));
+  memcpy((this->data + this->size), buf->data, buf->size);
+  this->data[(this->size + buf->size)] = ((u8)'\0');
+  this->size += buf->size;
+}
+
+void Buffer__putbf(Buffer *this, Buffer *buf) {
+  Buffer__putb(this, buf);
+  Buffer__free(buf);
+}
+
+void Buffer__puts(Buffer *this, char *s) {
+  i32 len = strlen(s);
+  Buffer__resize_if_necessary(this, ((this->size + len) + 1));
+  memcpy((this->data + this->size), s, (len + 1));
+  this->size += len;
+}
+
+void Buffer__putc(Buffer *this, char c) {
+  Buffer__resize_if_necessary(this, (this->size + 2));
+  this->data[this->size] = ((u8)c);
+  this->size += 1;
+  this->data[this->size] = ((u8)'\0');
+}
+
+void Buffer__put_u64(Buffer *this, u64 value) {
+  u8 digits[20];
+  i32 len = 0;
+  while (true) {
+    digits[len] = (((u8)(value % 10)) + ((u8)'0'));
+    len += 1;
+    value = (value / 10);
+    if (value == 0) 
+    break;
+    
+  } 
+  Buffer__resize_if_necessary(this, ((this->size + len) + 1));
+  for (i32 i = 0; (i < len); i += 1) {
+    this->data[(this->size + i)] = digits[((len - i) - 1)];
+  } 
+  this->size += len;
+  this->data[this->size] = ((u8)'\0');
+}
+
+void Buffer__put_i64(Buffer *this, i64 value) {
+  if ((value < 0)) {
+    Buffer__putc(this, '-');
+    Buffer__put_u64(this, (-((u64)value)));
+  }  else {
+    Buffer__put_u64(this, ((u64)value));
+  } 
+}
+
+void Buffer__put_f64(Buffer *this, f64 value) {
+  char stack[64];
+  char *s = format_string_into(stack, 64, "%f", value);
+  Buffer__puts(this, s);
+  if ((s != ((char *)stack))) 
+  free(s);
+  
+}
+
+void Buffer__put_ptr(Buffer *this, void *value) {
+  char stack[32];
+  Buffer__puts(this, format_string_into(stack, 32, "%p", value));
+}
+
+void Buffer__putsf(Buffer *this, char *s) {
+  Buffer__puts(this, s);
+  free(s);
+}
+
+char *Buffer__str(Buffer *this) {
+  return ((char *)this->data);
+}
+
+char *Buffer__new_str(Buffer *this) {
+  return strdup(((char *)this->data));
+}
+
+void Buffer__free(Buffer *this) {
+  free(this->data);
+}
+
+void run_putsf(i32 iters) {
+  Buffer sb = Buffer__make();
+  char *name = "name";
+  f64 start = time_now();
+  for (i32 i = 0; (i < iters); i += 1) {
+    if ((sb.size > 4096)) 
+    sb.size = 0;
+    
+    ({ Buffer *__fmt_buf = (&sb); Buffer__put_i64(__fmt_buf, i); Buffer__puts(__fmt_buf, ": \""); Buffer__puts(__fmt_buf, name); Buffer__puts(__fmt_buf, "\" = "); Buffer__put_i64(__fmt_buf, (i * 7)); Buffer__puts(__fmt_buf, "\n"); });
+  } 
+  bench_report("Buffer::putsf (specialized)", (time_now() - start), iters);
+  bench_sink += ((u64)sb.size);
+  Buffer__free((&sb));
+}
+
+void run_format_string(i32 iters) {
+  Buffer sb = Buffer__make();
+  char *name = "name";
+  f64 start = time_now();
+  for (i32 i = 0; (i < iters); i += 1) {
+    if ((sb.size > 4096)) 
+    sb.size = 0;
+    
+    char *s = format_string("%d: \"%s\" = %d\n", i, name, (i * 7));
+    Buffer__puts((&sb), s);
+    free(s);
+  } 
+  bench_report("format_string + puts", (time_now() - start), iters);
+  bench_sink += ((u64)sb.size);
+  Buffer__free((&sb));
+}
+
+i32 main(void) {
+  i32 iters = 5000000;
+  run_putsf(iters);
+  run_format_string(iters);
+}
+
@@ -0,0 +1,1900 @@
+#include "stdio.h"
+#include "stdlib.h"
+#include "stdbool.h"
+#include "stdint.h"
+#include "string.h"
+#include "errno.h"
+#include "ctype.h"
+#include "time.h"
+
+/***************** embed './lib/prelude.h' *****************/
+#include "stdarg.h"
+
+typedef int8_t i8;
+typedef int16_t i16;
+typedef int32_t i32;
+typedef int64_t i64;
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+
+typedef float f32;
+typedef double f64;
+
+// SIMD vector types, such as `f32x4`, using GCC's vector extensions
+#define AECOR_SIMD_TYPE(T, lanes) \
+  typedef T aecor_##T##x##lanes __attribute__((vector_size(sizeof(T) * lanes)));
+#define AECOR_SIMD_TYPES(T) \
+  AECOR_SIMD_TYPE(T, 2) AECOR_SIMD_TYPE(T, 4) AECOR_SIMD_TYPE(T, 8) \
+  AECOR_SIMD_TYPE(T, 16) AECOR_SIMD_TYPE(T, 32) AECOR_SIMD_TYPE(T, 64)
+
+AECOR_SIMD_TYPES(i8) AECOR_SIMD_TYPES(i16) AECOR_SIMD_TYPES(i32) AECOR_SIMD_TYPES(i64)
+AECOR_SIMD_TYPES(u8) AECOR_SIMD_TYPES(u16) AECOR_SIMD_TYPES(u32) AECOR_SIMD_TYPES(u64)
+AECOR_SIMD_TYPES(f32) AECOR_SIMD_TYPES(f64)
+
+#ifdef AECOR_TRACK_ALLOC
+// Allocation tracking for `--track-alloc`. Calls to `malloc`, `calloc`,
+// `realloc`, `free` and `strdup` in aecor code go through the functions
+// below, each with a static `aecor_alloc_site` for the call site. Live
+// blocks are kept in a side table keyed by pointer, so `free` still works
+// on memory allocated by C code, which is just not counted.
+//
+// Like `--instrument`, this is not synchronized between threads.
+typedef struct aecor_alloc_site {
+  const char* location;
+  u64 allocs;
+  u64 bytes;
+  u64 live;
+  u64 live_bytes;
+  struct aecor_alloc_site* next;
+} aecor_alloc_site;
+
+typedef struct {
+  void* ptr;
+  size_t size;
+  aecor_alloc_site* site;
+} aecor_alloc_block;
+
+static aecor_alloc_site* aecor_alloc_sites = NULL;
+static aecor_alloc_block* aecor_alloc_blocks = NULL;
+static size_t aecor_alloc_capacity = 0;  // Always a power of two
+static size_t aecor_alloc_count = 0;
+static u64 aecor_alloc_live_bytes = 0;
+static u64 aecor_alloc_peak_bytes = 0;
+
+// Site of the format string being built, set by the generated code
+static aecor_alloc_site aecor_alloc_unknown_format = {"<format string>"};
+static aecor_alloc_site* aecor_alloc_format_site = &aecor_alloc_unknown_format;
+
+static inline size_t aecor_alloc_slot(void* ptr) {
+  return ((uintptr_t)ptr >> 4) * 0x9e3779b97f4a7c15ull & (aecor_alloc_capacity - 1);
+}
+
+static void aecor_alloc_insert(aecor_alloc_block block) {
+  if ((aecor_alloc_count + 1) * 2 > aecor_alloc_capacity) {
+    aecor_alloc_block* old = aecor_alloc_blocks;
+    size_t old_capacity = aecor_alloc_capacity;
+    aecor_alloc_capacity = old_capacity ? old_capacity * 2 : 1024;
+    aecor_alloc_blocks = calloc(aecor_alloc_capacity, sizeof(aecor_alloc_block));
+    aecor_alloc_count = 0;
+    for (size_t i = 0; i < old_capacity; i++) {
+      if (old[i].ptr) aecor_alloc_insert(old[i]);
+    }
+    free(old);
+  }
+  size_t i = aecor_alloc_slot(block.ptr);
+  while (aecor_alloc_blocks[i].ptr) i = (i + 1) & (aecor_alloc_capacity - 1);
+  aecor_alloc_blocks[i] = block;
+  aecor_alloc_count++;
+}
+
+// Removes the block for `ptr` using backward-shift deletion, returning
+// false if it wasn't allocated by tracked code.
+static bool aecor_alloc_remove(void* ptr, aecor_alloc_block* out) {
+  if (!aecor_alloc_capacity) return false;
+  size_t mask = aecor_alloc_capacity - 1;
+  size_t i = aecor_alloc_slot(ptr);
+  while (aecor_alloc_blocks[i].ptr != ptr) {
+    if (!aecor_alloc_blocks[i].ptr) return false;
+    i = (i + 1) & mask;
+  }
+  *out = aecor_alloc_blocks[i];
+  for (size_t j = (i + 1) & mask; aecor_alloc_blocks[j].ptr; j = (j + 1) & mask) {
+    size_t home = aecor_alloc_slot(aecor_alloc_blocks[j].ptr);
+    // Move the entry into the hole unless its home slot is after the hole
+    if (((j - home) & mask) >= ((j - i) & mask)) {
+      aecor_alloc_blocks[i] = aecor_alloc_blocks[j];
+      i = j;
+    }
+  }
+  aecor_alloc_blocks[i].ptr = NULL;
+  aecor_alloc_count--;
+  return true;
+}
+
+static void aecor_alloc_record(void* ptr, size_t size, aecor_alloc_site* site) {
+  if (!ptr) return;
+  if (!site->allocs) {
+    site->next = aecor_alloc_sites;
+    aecor_alloc_sites = site;
+  }
+  site->allocs++;
+  site->bytes += size;
+  site->live++;
+  site->live_bytes += size;
+  aecor_alloc_live_bytes += size;
+  if (aecor_alloc_live_bytes > aecor_alloc_peak_bytes) {
+    aecor_alloc_peak_bytes = aecor_alloc_live_bytes;
+  }
+  aecor_alloc_insert((aecor_alloc_block){ptr, size, site});
+}
+
+static void aecor_alloc_forget(void* ptr) {
+  aecor_alloc_block block;
+  if (!ptr || !aecor_alloc_remove(ptr, &block)) return;
+  block.site->live--;
+  block.site->live_bytes -= block.size;
+  aecor_alloc_live_bytes -= block.size;
+}
+
+void* aecor_track_malloc(size_t size, aecor_alloc_site* site) {
+  void* ptr = malloc(size);
+  aecor_alloc_record(ptr, size, site);
+  return ptr;
+}
+
+void* aecor_track_calloc(size_t count, size_t size, aecor_alloc_site* site) {
+  void* ptr = calloc(count, size);
+  aecor_alloc_record(ptr, count * size, site);
+  return ptr;
+}
+
+void* aecor_track_realloc(void* old, size_t size, aecor_alloc_site* site) {
+  void* ptr = realloc(old, size);
+  if (!ptr && size) return ptr;
+  aecor_alloc_forget(old);
+  aecor_alloc_record(ptr, size, site);
+  return ptr;
+}
+
+char* aecor_track_strdup(const char* s, aecor_alloc_site* site) {
+  char* copy = strdup(s);
+  aecor_alloc_record(copy, strlen(s) + 1, site);
+  return copy;
+}
+
+void aecor_track_free(void* ptr) {
+  aecor_alloc_forget(ptr);
+  free(ptr);
+}
+
+static void* aecor_track_format_alloc(size_t size) {
+  aecor_alloc_site* site = aecor_alloc_format_site;
+  aecor_alloc_format_site = &aecor_alloc_unknown_format;
+  return aecor_track_malloc(size, site);
+}
+
+static int aecor_alloc_compare_bytes(const void* a, const void* b) {
+  u64 x = (*(aecor_alloc_site**)a)->bytes, y = (*(aecor_alloc_site**)b)->bytes;
+  return x < y ? 1 : x > y ? -1 : 0;
+}
+
+static int aecor_alloc_compare_live(const void* a, const void* b) {
+  u64 x = (*(aecor_alloc_site**)a)->live_bytes, y = (*(aecor_alloc_site**)b)->live_bytes;
+  return x < y ? 1 : x > y ? -1 : 0;
+}
+
+// Writes the sites that allocated the most bytes, followed by the ones
+// with memory that was never freed.
+static void aecor_alloc_report(void) {
+  const char* path = getenv("AECOR_ALLOC_REPORT");
+  if (!path) path = "aecor_alloc.txt";
+  FILE* file = fopen(path, "w");
+  if (!file) {
+    fprintf(stderr, "Could not write allocation report to %s\n", path);
+    return;
+  }
+
+  size_t count = 0;
+  u64 allocs = 0, bytes = 0, live = 0;
+  for (aecor_alloc_site* site = aecor_alloc_sites; site; site = site->next) {
+    count++;
+    allocs += site->allocs;
+    bytes += site->bytes;
+    live += site->live;
+  }
+  aecor_alloc_site** sites = malloc((count + 1) * sizeof(aecor_alloc_site*));
+  size_t n = 0;
+  for (aecor_alloc_site* site = aecor_alloc_sites; site; site = site->next) sites[n++] = site;
+
+  fprintf(file, "# %llu allocations, %llu bytes, peak %llu bytes live\n",
+          (unsigned long long)allocs, (unsigned long long)bytes,
+          (unsigned long long)aecor_alloc_peak_bytes);
+  fprintf(file, "# %llu blocks, %llu bytes never freed\n",
+          (unsigned long long)live, (unsigned long long)aecor_alloc_live_bytes);
+
+  const char* header = "# %12s %14s %12s %14s  %s\n";
+  const char* row = "%14llu %14llu %12llu %14llu  %s\n";
+  fprintf(file, "\n# Top allocators\n");
+  fprintf(file, header, "allocs", "bytes", "live", "live_bytes", "site");
+  qsort(sites, n, sizeof(aecor_alloc_site*), aecor_alloc_compare_bytes);
+  for (size_t i = 0; i < n; i++) {
+    aecor_alloc_site* site = sites[i];
+    fprintf(file, row, (unsigned long long)site->allocs, (unsigned long long)site->bytes,
+            (unsigned long long)site->live, (unsigned long long)site->live_bytes, site->location);
+  }
+
+  fprintf(file, "\n# Leaks\n");
+  fprintf(file, header, "allocs", "bytes", "live", "live_bytes", "site");
+  qsort(sites, n, sizeof(aecor_alloc_site*), aecor_alloc_compare_live);
+  for (size_t i = 0; i < n && sites[i]->live; i++) {
+    aecor_alloc_site* site = sites[i];
+    fprintf(file, row, (unsigned long long)site->allocs, (unsigned long long)site->bytes,
+            (unsigned long long)site->live, (unsigned long long)site->live_bytes, site->location);
+  }
+  free(sites);
+  fclose(file);
+}
+
+__attribute__((constructor)) static void aecor_alloc_init(void) {
+  atexit(aecor_alloc_report);
+}
+
+#define AECOR_FORMAT_ALLOC aecor_track_format_alloc
+#else
+#define AECOR_FORMAT_ALLOC malloc
+#endif
+
+// Formats into `stack` if the result fits in `capacity` bytes, otherwise
+// returns a new heap-allocated string that the caller needs to free.
+char* format_string_into(char* stack, int capacity, const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  int size = vsnprintf(stack, capacity, format, args);
+  va_end(args);
+  if (size < capacity) return stack;
+  char* s = malloc(size + 1);
+  va_start(args, format);
+  vsnprintf(s, size + 1, format, args);
+  va_end(args);
+  return s;
+}
+
+// Formats into a stack buffer first since most formatted strings are short,
+// which saves a separate pass just to compute the size.
+static char* aecor_vformat(void* (*alloc)(size_t), const char* format, va_list args) {
+  char stack[256];
+  va_list copy;
+  va_copy(copy, args);
+  int size = vsnprintf(stack, sizeof(stack), format, copy);
+  va_end(copy);
+  char* s = alloc(size + 1);
+  if (size < (int)sizeof(stack)) {
+    memcpy(s, stack, size + 1);
+  } else {
+    vsnprintf(s, size + 1, format, args);
+  }
+  return s;
+}
+
+char* format_string(const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  char* s = aecor_vformat(AECOR_FORMAT_ALLOC, format, args);
+  va_end(args);
+  return s;
+}
+
+// Scratch arena backing `scratch { ... }` blocks. Memory is handed out from a
+// list of chunks with a bump pointer, and everything allocated inside a block
+// is released at once when it ends by restoring the position saved on entry.
+// Chunks past the current one are kept around to be reused.
+#define AECOR_SCRATCH_CHUNK_SIZE (64 * 1024)
+
+typedef struct aecor_scratch_chunk {
+  struct aecor_scratch_chunk* next;
+  size_t capacity;
+  size_t used;
+  char data[];
+} aecor_scratch_chunk;
+
+typedef struct {
+  aecor_scratch_chunk* chunk;
+  size_t used;
+} aecor_scratch_mark;
+
+static aecor_scratch_chunk* aecor_scratch_first = NULL;
+static aecor_scratch_chunk* aecor_scratch_current = NULL;
+
+void* scratch_alloc(size_t size) {
+  size = (size + 15) & ~(size_t)15;
+  aecor_scratch_chunk* chunk = aecor_scratch_current;
+  if (!chunk || chunk->used + size > chunk->capacity) {
+    aecor_scratch_chunk** link = chunk ? &chunk->next : &aecor_scratch_first;
+    if (!*link || (*link)->capacity < size) {
+      size_t capacity = size > AECOR_SCRATCH_CHUNK_SIZE ? size : AECOR_SCRATCH_CHUNK_SIZE;
+      aecor_scratch_chunk* fresh = malloc(sizeof(aecor_scratch_chunk) + capacity);
+      if (!fresh) {
+        printf("Out of memory!\n");
+        exit(1);
+      }
+      fresh->capacity = capacity;
+      fresh->next = *link;
+      *link = fresh;
+    }
+    chunk = *link;
+    chunk->used = 0;
+    aecor_scratch_current = chunk;
+  }
+  void* ptr = chunk->data + chunk->used;
+  chunk->used += size;
+  return ptr;
+}
+
+aecor_scratch_mark aecor_scratch_save() {
+  aecor_scratch_chunk* chunk = aecor_scratch_current;
+  return (aecor_scratch_mark){chunk, chunk ? chunk->used : 0};
+}
+
+void aecor_scratch_restore(aecor_scratch_mark* mark) {
+  aecor_scratch_current = mark->chunk;
+  if (mark->chunk) mark->chunk->used = mark->used;
+}
+
+char* format_string_scratch(const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  char* s = aecor_vformat(scratch_alloc, format, args);
+  va_end(args);
+  return s;
+}
+
+// Output buffer for `print` / `println` when compiling with `-b`. Writes are
+// collected here and handed to stdio in large chunks, which avoids paying
+// for `printf`'s locking and format parsing on every call.
+//
+// Once a second thread has been started (see `Thread::spawn`), the buffer is
+// guarded by a spinlock. It is only held for a `memcpy` or a flush, but
+// single-threaded programs don't pay for it at all.
+#define AECOR_STDOUT_BUFFER_SIZE (64 * 1024)
+
+static char aecor_stdout_buffer[AECOR_STDOUT_BUFFER_SIZE];
+static size_t aecor_stdout_size = 0;
+static char aecor_stdout_locked = 0;
+
+// Set before the first thread is created, so that thread sees it too
+bool aecor_multithreaded = false;
+
+static inline void aecor_stdout_lock(void) {
+  if (!aecor_multithreaded) return;
+  while (__atomic_test_and_set(&aecor_stdout_locked, __ATOMIC_ACQUIRE)) {
+    while (__atomic_load_n(&aecor_stdout_locked, __ATOMIC_RELAXED)) {}
+  }
+}
+
+static inline void aecor_stdout_unlock(void) {
+  if (!aecor_multithreaded) return;
+  __atomic_clear(&aecor_stdout_locked, __ATOMIC_RELEASE);
+}
+
+// Must be called with the lock held
+static void aecor_stdout_flush_locked(void) {
+  fwrite(aecor_stdout_buffer, 1, aecor_stdout_size, stdout);
+  fflush(stdout);
+  aecor_stdout_size = 0;
+}
+
+void aecor_stdout_flush(void) {
+  aecor_stdout_lock();
+  aecor_stdout_flush_locked();
+  aecor_stdout_unlock();
+}
+
+__attribute__((constructor)) static void aecor_stdout_init(void) {
+  atexit(aecor_stdout_flush);
+}
+
+static inline void aecor_stdout_write(const char* s, size_t len) {
+  aecor_stdout_lock();
+  if (aecor_stdout_size + len > AECOR_STDOUT_BUFFER_SIZE) {
+    aecor_stdout_flush_locked();
+    if (len > AECOR_STDOUT_BUFFER_SIZE) {
+      fwrite(s, 1, len, stdout);
+      aecor_stdout_unlock();
+      return;
+    }
+  }
+  memcpy(aecor_stdout_buffer + aecor_stdout_size, s, len);
+  aecor_stdout_size += len;
+  aecor_stdout_unlock();
+}
+
+void aecor_stdout_puts(const char* s) {
+  aecor_stdout_write(s, strlen(s));
+}
+
+// Prints "(null)" for a null string, like `printf` does
+void aecor_stdout_put_str(const char* s) {
+  aecor_stdout_puts(s ? s : "(null)");
+}
+
+void aecor_stdout_putc(char c) {
+  aecor_stdout_lock();
+  if (aecor_stdout_size == AECOR_STDOUT_BUFFER_SIZE) aecor_stdout_flush_locked();
+  aecor_stdout_buffer[aecor_stdout_size++] = c;
+  aecor_stdout_unlock();
+}
+
+void aecor_stdout_put_u64(u64 value) {
+  char digits[20];
+  int len = 0;
+  do {
+    digits[sizeof(digits) - ++len] = '0' + value % 10;
+    value /= 10;
+  } while (value);
+  aecor_stdout_write(digits + sizeof(digits) - len, len);
+}
+
+void aecor_stdout_put_i64(i64 value) {
+  if (value < 0) {
+    aecor_stdout_putc('-');
+    aecor_stdout_put_u64(-(u64)value);
+  } else {
+    aecor_stdout_put_u64(value);
+  }
+}
+
+// Used for anything that isn't a format string literal, as well as the
+// arguments with explicit format specs.
+int aecor_stdout_printf(const char* format, ...) {
+  char stack[256];
+  va_list args;
+  va_start(args, format);
+  int size = vsnprintf(stack, sizeof(stack), format, args);
+  va_end(args);
+  if (size < (int)sizeof(stack)) {
+    aecor_stdout_write(stack, size);
+  } else {
+    char* s = malloc(size + 1);
+    va_start(args, format);
+    vsnprintf(s, size + 1, format, args);
+    va_end(args);
+    aecor_stdout_write(s, size);
+    free(s);
+  }
+  return size;
+}
+
+void aecor_stdout_put_f64(f64 value) {
+  aecor_stdout_printf("%f", value);
+}
+
+void aecor_stdout_put_ptr(void* value) {
+  aecor_stdout_printf("%p", value);
+}
+
+// FNV-1a with a murmur3 finalizer, used for hashed dispatch on strings.
+// Must be kept in sync with `hash_string` in `compiler/utils.ae`.
+u32 aecor_hash_str(const char* s, u32 seed) {
+  u32 hash = seed;
+  for (; *s; s++) {
+    hash = (hash ^ (u8)*s) * 16777619u;
+  }
+  hash = (hash ^ (hash >> 16)) * 0x85ebca6bu;
+  hash = (hash ^ (hash >> 13)) * 0xc2b2ae35u;
+  return hash ^ (hash >> 16);
+}
+
+#ifdef AECOR_INSTRUMENT
+#include <time.h>
+
+// Per-function profiling for `--instrument`. Every instrumented function
+// pushes a frame on entry, which is popped by a `cleanup` handler whenever
+// the function returns. Time spent in instrumented callees is subtracted
+// from the caller's exclusive time. Recursive calls only count towards
+// inclusive time once, for the outermost call.
+//
+// Counters are not synchronized, so this is only accurate for programs
+// that call instrumented functions from a single thread.
+typedef struct {
+  const char* name;
+  const char* location;
+  u64 calls;
+  u64 inclusive_ns;
+  u64 exclusive_ns;
+  u32 active;
+} aecor_prof_entry;
+
+typedef struct aecor_prof_frame {
+  aecor_prof_entry* entry;
+  struct aecor_prof_frame* parent;
+  u64 start;
+  u64 children;
+} aecor_prof_frame;
+
+// Defined at the end of the generated code, one entry per function
+extern aecor_prof_entry aecor_prof_table[];
+extern u32 aecor_prof_count;
+
+static __thread aecor_prof_frame* aecor_prof_current = NULL;
+
+static inline u64 aecor_prof_now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (u64)ts.tv_sec * 1000000000ull + (u64)ts.tv_nsec;
+}
+
+static inline void aecor_prof_enter(aecor_prof_frame* frame, u32 id) {
+  frame->entry = &aecor_prof_table[id];
+  frame->entry->calls++;
+  frame->entry->active++;
+  frame->parent = aecor_prof_current;
+  frame->children = 0;
+  aecor_prof_current = frame;
+  frame->start = aecor_prof_now();
+}
+
+static inline void aecor_prof_exit(aecor_prof_frame* frame) {
+  u64 elapsed = aecor_prof_now() - frame->start;
+  aecor_prof_entry* entry = frame->entry;
+  entry->active--;
+  if (entry->active == 0) entry->inclusive_ns += elapsed;
+  entry->exclusive_ns += elapsed - frame->children;
+  if (frame->parent) frame->parent->children += elapsed;
+  aecor_prof_current = frame->parent;
+}
+
+// Writes one line per function that was called, in declaration order so
+// that reports from different runs can be diffed directly. The output is
+// whitespace separated for `sort -k`, e.g. `sort -k3 -n -r` for the
+// functions with the most exclusive time.
+static void aecor_prof_report(void) {
+  // Functions still running when `exit()` was called end here
+  while (aecor_prof_current) aecor_prof_exit(aecor_prof_current);
+
+  const char* path = getenv("AECOR_PROFILE");
+  if (!path) path = "aecor_profile.txt";
+  FILE* file = fopen(path, "w");
+  if (!file) {
+    fprintf(stderr, "Could not write profile to %s\n", path);
+    return;
+  }
+  fprintf(file, "# %12s %16s %16s  %s  %s\n",
+          "calls", "inclusive_ns", "exclusive_ns", "function", "location");
+  for (u32 i = 0; i < aecor_prof_count; i++) {
+    aecor_prof_entry* entry = &aecor_prof_table[i];
+    if (entry->calls == 0) continue;
+    fprintf(file, "%14llu %16llu %16llu  %s  %s\n",
+            (unsigned long long)entry->calls,
+            (unsigned long long)entry->inclusive_ns,
+            (unsigned long long)entry->exclusive_ns,
+            entry->name, entry->location);
+  }
+  fclose(file);
+}
+
+__attribute__((constructor)) static void aecor_prof_init(void) {
+  atexit(aecor_prof_report);
+}
+#endif
+
+
+/* constants */
+const i32 VECTOR_INLINE_CAPACITY = 4;
+const i32 VECTOR_MAX_INLINE_CAPACITY = 8;
+const i32 HASHMAP_GROUP = 8;
+const i32 HASHMAP_EMPTY = 0x80;
+const i32 HASHMAP_DELETED = 0xFE;
+const u64 HASHMAP_LSBS = 0x0101010101010101ULL;
+const u64 HASHMAP_MSBS = 0x8080808080808080ULL;
+
+/* struct declarations */
+typedef struct Vector Vector;
+typedef struct MapNode MapNode;
+typedef struct Map Map;
+typedef struct MapIterator MapIterator;
+typedef struct HashMapSlot HashMapSlot;
+typedef struct HashMap HashMap;
+typedef struct HashMapIterator HashMapIterator;
+typedef struct IntMapSlot IntMapSlot;
+typedef struct IntMap IntMap;
+typedef struct IntMapIterator IntMapIterator;
+typedef struct SetSlot SetSlot;
+typedef struct Set Set;
+typedef struct SetIterator SetIterator;
+
+struct Vector {
+  i32 size;
+  i32 capacity;
+  void **data;
+  bool is_inline;
+};
+
+struct MapNode {
+  char *key;
+  void *value;
+  MapNode *next;
+};
+
+struct Map {
+  MapNode **buckets;
+  i32 num_items;
+  i32 num_buckets;
+  i32 num_collisions;
+};
+
+struct MapIterator {
+  i32 idx;
+  MapNode *cur;
+  Map *map;
+};
+
+struct HashMapSlot {
+  u64 hash;
+  char *key;
+  void *value;
+};
+
+struct HashMap {
+  u8 *ctrl;
+  HashMapSlot *slots;
+  i32 capacity;
+  i32 num_items;
+  i32 growth_left;
+};
+
+struct HashMapIterator {
+  i32 idx;
+  HashMapSlot *cur;
+  HashMap *map;
+};
+
+struct IntMapSlot {
+  u64 key;
+  void *value;
+};
+
+struct IntMap {
+  u8 *ctrl;
+  IntMapSlot *slots;
+  i32 capacity;
+  i32 num_items;
+  i32 growth_left;
+};
+
+struct IntMapIterator {
+  i32 idx;
+  IntMapSlot *cur;
+  IntMap *map;
+};
+
+struct SetSlot {
+  u64 hash;
+  char *key;
+};
+
+struct Set {
+  u8 *ctrl;
+  SetSlot *slots;
+  i32 capacity;
+  i32 num_items;
+  i32 growth_left;
+};
+
+struct SetIterator {
+  i32 idx;
+  SetSlot *cur;
+  Set *set;
+};
+
+/* function declarations */
+static FILE *File__open(char *path, char *mode);
+static bool File__exists(char *path);
+static i32 File__size(FILE *this);
+static char *File__slurp(FILE *this);
+static i32 File__read(FILE *this, void *buf, i32 size);
+static i32 File__write(FILE *this, void *buf, i32 size);
+static void File__puts(FILE *this, char *str);
+static __attribute__((noreturn)) __attribute__((cold)) void panic(char *msg);
+static bool string__starts_with(char *this, char *prefix);
+static bool string__ends_with(char *this, char *suffix);
+static void string__remove_last_n(char *this, i32 n);
+static bool string__eq(char *this, char *str2);
+static char *string__substring(char *this, i32 start, i32 len);
+static void string__strip_trailing_whitespace(char *this);
+static i32 min(i32 a, i32 b);
+static i32 max(i32 a, i32 b);
+static f64 time_now(void);
+static void bench_report(char *name, f64 elapsed, i32 iters);
+static inline __attribute__((always_inline)) void **Vector__inline_data(Vector *this);
+static Vector *Vector__new_sized(i32 capacity);
+static Vector *Vector__new(void);
+static void Vector__resize(Vector *this, i32 new_capacity);
+static inline __attribute__((always_inline)) i32 Vector__next_capacity(Vector *this);
+static inline __attribute__((always_inline)) void Vector__push(Vector *this, void *val);
+static void Vector__push_front(Vector *this, void *val);
+static void *Vector__pop(Vector *this);
+static inline __attribute__((always_inline)) void *Vector__back(Vector *this);
+static inline __attribute__((always_inline)) void *Vector__at(Vector *this, i32 i);
+static inline __attribute__((always_inline)) bool Vector__empty(Vector *this);
+static void Vector__free(Vector *this);
+static MapNode *MapNode__new(char *key, void *value, MapNode *next);
+static void MapNode__free_list(MapNode *node);
+static Map *Map__new(void);
+static i32 Map__hash(Map *this, char *s);
+static MapNode *Map__get_node(Map *this, char *key);
+static void *Map__get(Map *this, char *key);
+static bool Map__exists(Map *this, char *key);
+static void Map__insert(Map *this, char *key, void *value);
+static void Map__resize(Map *this);
+static void Map__print_keys(Map *this);
+static void Map__push_keys(Map *this, Vector *vec);
+static void Map__free(Map *this);
+static MapIterator Map__iter(Map *this);
+static char *MapIterator__key(MapIterator *this);
+static void *MapIterator__value(MapIterator *this);
+static MapIterator MapIterator__make(Map *map);
+static void MapIterator__next(MapIterator *this);
+static u64 HashMap__hash(char *s);
+static u64 hashmap_match_byte(u64 group, u8 byte);
+static u64 hashmap_match_empty(u64 group);
+static u64 hashmap_match_free(u64 group);
+static inline __attribute__((always_inline)) u8 hashmap_h2(u64 hash);
+static inline __attribute__((always_inline)) i32 hashmap_start(u64 hash, i32 capacity);
+static i32 hashmap_resize_capacity(i32 num_items, i32 capacity);
+static u64 HashMapSlot__hash_of(HashMapSlot *slot);
+static bool HashMapSlot__matches(HashMapSlot *slot, char *key, u64 hash);
+static HashMap *HashMap__new_sized(i32 capacity);
+static HashMap *HashMap__new(void);
+static i32 HashMap__find(HashMap *this, char *key, u64 hash);
+static void *HashMap__get(HashMap *this, char *key);
+static bool HashMap__exists(HashMap *this, char *key);
+static void HashMap__insert(HashMap *this, char *key, void *value);
+static void *HashMap__remove(HashMap *this, char *key);
+static void HashMap__resize(HashMap *this);
+static void HashMap__print_keys(HashMap *this);
+static void HashMap__push_keys(HashMap *this, Vector *vec);
+static void HashMap__free(HashMap *this);
+static HashMapIterator HashMap__iter(HashMap *this);
+static char *HashMapIterator__key(HashMapIterator *this);
+static void *HashMapIterator__value(HashMapIterator *this);
+static HashMapIterator HashMapIterator__make(HashMap *map);
+static void HashMapIterator__next(HashMapIterator *this);
+static u64 IntMap__hash(u64 key);
+static u64 IntMapSlot__hash_of(IntMapSlot *slot);
+static bool IntMapSlot__matches(IntMapSlot *slot, u64 key, u64 hash);
+static IntMap *IntMap__new_sized(i32 capacity);
+static IntMap *IntMap__new(void);
+static i32 IntMap__find(IntMap *this, u64 key, u64 hash);
+static void *IntMap__get(IntMap *this, u64 key);
+static bool IntMap__exists(IntMap *this, u64 key);
+static void IntMap__insert(IntMap *this, u64 key, void *value);
+static void *IntMap__remove(IntMap *this, u64 key);
+static void IntMap__resize(IntMap *this);
+static void IntMap__free(IntMap *this);
+static IntMapIterator IntMap__iter(IntMap *this);
+static u64 IntMapIterator__key(IntMapIterator *this);
+static void *IntMapIterator__value(IntMapIterator *this);
+static IntMapIterator IntMapIterator__make(IntMap *map);
+static void IntMapIterator__next(IntMapIterator *this);
+static u64 SetSlot__hash_of(SetSlot *slot);
+static bool SetSlot__matches(SetSlot *slot, char *key, u64 hash);
+static Set *Set__new_sized(i32 capacity);
+static Set *Set__new(void);
+static i32 Set__find(Set *this, char *key, u64 hash);
+static bool Set__contains(Set *this, char *key);
+static bool Set__add(Set *this, char *key);
+static bool Set__remove(Set *this, char *key);
+static void Set__resize(Set *this);
+static void Set__push_keys(Set *this, Vector *vec);
+static void Set__free(Set *this);
+static SetIterator Set__iter(Set *this);
+static char *SetIterator__key(SetIterator *this);
+static SetIterator SetIterator__make(Set *set);
+static void SetIterator__next(SetIterator *this);
+static void bench_int_keys(i32 n);
+static void bench_set(i32 n);
+i32 main(void);
+static i32 hashmap_next_item__Set(Set *map, i32 index);
+static void hashmap_resize__Set_SetSlot(Set *map, i32 num_items);
+static void hashmap_rehash__Set_SetSlot(Set *map, u8 *old_ctrl, SetSlot *old_slots, i32 old_capacity);
+static i32 hashmap_find_free__Set(Set *map, u64 hash);
+static inline __attribute__((always_inline)) u64 hashmap_group__Set(Set *map, i32 index);
+static void hashmap_erase__Set(Set *map, i32 index);
+static i32 hashmap_claim__Set(Set *map, u64 hash);
+static i32 hashmap_find__Set_SetSlot_ptr_char(Set *map, char *key, u64 hash);
+static void hashmap_alloc__Set_SetSlot(Set *map, i32 min_capacity, i32 num_items);
+static i32 hashmap_next_item__IntMap(IntMap *map, i32 index);
+static void hashmap_resize__IntMap_IntMapSlot(IntMap *map, i32 num_items);
+static void hashmap_rehash__IntMap_IntMapSlot(IntMap *map, u8 *old_ctrl, IntMapSlot *old_slots, i32 old_capacity);
+static i32 hashmap_find_free__IntMap(IntMap *map, u64 hash);
+static inline __attribute__((always_inline)) u64 hashmap_group__IntMap(IntMap *map, i32 index);
+static void hashmap_erase__IntMap(IntMap *map, i32 index);
+static i32 hashmap_claim__IntMap(IntMap *map, u64 hash);
+static i32 hashmap_find__IntMap_IntMapSlot_u64(IntMap *map, u64 key, u64 hash);
+static void hashmap_alloc__IntMap_IntMapSlot(IntMap *map, i32 min_capacity, i32 num_items);
+static i32 hashmap_next_item__HashMap(HashMap *map, i32 index);
+static void hashmap_resize__HashMap_HashMapSlot(HashMap *map, i32 num_items);
+static void hashmap_rehash__HashMap_HashMapSlot(HashMap *map, u8 *old_ctrl, HashMapSlot *old_slots, i32 old_capacity);
+static i32 hashmap_find_free__HashMap(HashMap *map, u64 hash);
+static inline __attribute__((always_inline)) u64 hashmap_group__HashMap(HashMap *map, i32 index);
+static void hashmap_erase__HashMap(HashMap *map, i32 index);
+static i32 hashmap_claim__HashMap(HashMap *map, u64 hash);
+static i32 hashmap_find__HashMap_HashMapSlot_ptr_char(HashMap *map, char *key, u64 hash);
+static void hashmap_alloc__HashMap_HashMapSlot(HashMap *map, i32 min_capacity, i32 num_items);
+
+/* global variables */
+u64 bench_sink = 0;
+
+static FILE *File__open(char *path, char *mode) {
+  FILE *file = fopen(path, mode);
+  if ((!((bool)file))) {
+    printf("Error opening file '%s': %s""\n", path, strerror(errno));
+    exit(1);
+  } 
+  return file;
+}
+
+static bool File__exists(char *path) {
+  FILE *file = fopen(path, "r");
+  if ((!((bool)file))) {
+    return false;
+  } 
+  fclose(file);
+  return true;
+}
+
+static i32 File__size(FILE *this) {
+  i32 pos = ftell(this);
+  fseek(this, 0, SEEK_END);
+  i32 size = ftell(this);
+  fseek(this, pos, SEEK_SET);
+  return size;
+}
+
+static char *File__slurp(FILE *this) {
+  i32 pos = ftell(this);
+  fseek(this, 0, SEEK_END);
+  i32 size = ftell(this);
+  fseek(this, pos, SEEK_SET);
+  void *buf = calloc((size + 1), sizeof(char));
+  fread(buf, 1, size, this);
+  fseek(this, pos, SEEK_SET);
+  return ((char *)buf);
+}
+
+static i32 File__read(FILE *this, void *buf, i32 size) {
+  return fread(buf, 1, size, this);
+}
+
+static i32 File__write(FILE *this, void *buf, i32 size) {
+  return fwrite(buf, 1, size, this);
+}
+
+static void File__puts(FILE *this, char *str) {
+  fwrite(str, 1, strlen(str), this);
+}
+
+static __attribute__((noreturn)) __attribute__((cold)) void panic(char *msg) {
+  printf("%s""\n", msg);
+  aecor_stdout_flush();
+  exit(1);
+}
+
+static bool string__starts_with(char *this, char *prefix) {
+  i32 prefix_len = strlen(prefix);
+  if ((strlen(this) < prefix_len)) {
+    return false;
+  } 
+  return strncmp(this, prefix, prefix_len) == 0;
+}
+
+static bool string__ends_with(char *this, char *suffix) {
+  i32 suffix_len = strlen(suffix);
+  if ((strlen(this) < suffix_len)) {
+    return false;
+  } 
+  return strncmp(this, suffix, suffix_len) == 0;
+}
+
+static void string__remove_last_n(char *this, i32 n) {
+  this[(strlen(this) - n)] = '\0';
+}
+
+static bool string__eq(char *this, char *str2) {
+  return strcmp(this, str2) == 0;
+}
+
+static char *string__substring(char *this, i32 start, i32 len) {
+  char *new_str = ((char *)calloc((len + 1), sizeof(char)));
+  memcpy(new_str, (this + start), len);
+  return new_str;
+}
+
+static void string__strip_trailing_whitespace(char *this) {
+  for (i32 i = (strlen(this) - 1); (i >= 0); i -= 1) {
+    if ((this[i] != ' ')) 
+    break;
+    
+    this[i] = '\0';
+  } 
+}
+
+static i32 min(i32 a, i32 b) {
+  return ((a < b) ? a : b);
+}
+
+static i32 max(i32 a, i32 b) {
+  return ((a > b) ? a : b);
+}
+
+static f64 time_now(void) {
+  struct timespec ts = {0};
+  clock_gettime(CLOCK_MONOTONIC, (&ts));
+  return (((f64)ts.tv_sec) + (((f64)ts.tv_nsec) / 1000000000.0));
+}
+
+static void bench_report(char *name, f64 elapsed, i32 iters) {
+  f64 ns = ((elapsed * 1000000000.0) / ((f64)iters));
+  printf("%-32s %10.3f ms %10.2f ns/iter""\n", name, (elapsed * 1000.0), ns);
+}
+
+static inline __attribute__((always_inline)) void **Vector__inline_data(Vector *this) {
+  return ((void **)(((u8 *)this) + sizeof(Vector)));
+}
+
+static Vector *Vector__new_sized(i32 capacity) {
+  if ((capacity <= VECTOR_MAX_INLINE_CAPACITY)) {
+    Vector *vec = ((Vector *)calloc(1, (sizeof(Vector) + (capacity * sizeof(void *)))));
+    vec->capacity = capacity;
+    if ((capacity > 0)) {
+      vec->data = Vector__inline_data(vec);
+      vec->is_inline = true;
+    } 
+    return vec;
+  } 
+  Vector *vec = ((Vector *)calloc(1, sizeof(Vector)));
+  vec->size = 0;
+  vec->capacity = capacity;
+  vec->data = ((void **)calloc(vec->capacity, sizeof(void *)));
+  return vec;
+}
+
+static Vector *Vector__new(void) {
+  return Vector__new_sized(VECTOR_INLINE_CAPACITY);
+}
+
+static void Vector__resize(Vector *this, i32 new_capacity) {
+  if (this->is_inline) {
+    void **data = ((void **)malloc((new_capacity * sizeof(void *))));
+    memcpy(data, this->data, (this->size * sizeof(void *)));
+    this->data = data;
+    this->is_inline = false;
+  }  else {
+    this->data = ((void **)realloc(this->data, (new_capacity * sizeof(void *))));
+  } 
+  this->capacity = new_capacity;
+}
+
+static inline __attribute__((always_inline)) i32 Vector__next_capacity(Vector *this) {
+  return max((this->capacity * 2), VECTOR_INLINE_CAPACITY);
+}
+
+static inline __attribute__((always_inline)) void Vector__push(Vector *this, void *val) {
+  if (this->size == this->capacity) {
+    Vector__resize(this, Vector__next_capacity(this));
+  } 
+  this->data[this->size] = val;
+  this->size += 1;
+}
+
+static void Vector__push_front(Vector *this, void *val) {
+  if (this->size == this->capacity) {
+    Vector__resize(this, Vector__next_capacity(this));
+  } 
+  memmove((this->data + 1), this->data, (this->size * sizeof(void *)));
+  this->data[0] = val;
+  this->size += 1;
+}
+
+static void *Vector__pop(Vector *this) {
+  (__builtin_expect(!!((this->size > 0)), 1) ? (void)0 : panic("pop on empty vector"));
+  this->size -= 1;
+  return this->data[this->size];
+}
+
+static inline __attribute__((always_inline)) void *Vector__back(Vector *this) {
+  (__builtin_expect(!!((this->size > 0)), 1) ? (void)0 : panic("back on empty vector"));
+  return this->data[(this->size - 1)];
+}
+
+static inline __attribute__((always_inline)) void *Vector__at(Vector *this, i32 i) {
+  (__builtin_expect(!!(((i >= 0) && (i < this->size))), 1) ? (void)0 : panic("at out of bounds in vector"));
+  return this->data[i];
+}
+
+static inline __attribute__((always_inline)) bool Vector__empty(Vector *this) {
+  return this->size == 0;
+}
+
+static void Vector__free(Vector *this) {
+  if ((!this->is_inline)) 
+  free(this->data);
+  
+  free(this);
+}
+
+static MapNode *MapNode__new(char *key, void *value, MapNode *next) {
+  MapNode *node = ((MapNode *)calloc(1, sizeof(MapNode)));
+  node->key = key;
+  node->value = value;
+  node->next = next;
+  return node;
+}
+
+static void MapNode__free_list(MapNode *node) {
+  MapNode *cur = node;
+  while (((bool)cur)) {
+    MapNode *next = cur->next;
+    free(cur);
+    cur = next;
+  } 
+}
+
+static Map *Map__new(void) {
+  Map *map = ((Map *)calloc(1, sizeof(Map)));
+  map->num_buckets = 4;
+  map->buckets = ((MapNode **)calloc(map->num_buckets, sizeof(MapNode *)));
+  return map;
+}
+
+static i32 Map__hash(Map *this, char *s) {
+  u32 hash = 5381U;
+  for (i32 i = 0; (s[i] != '\0'); i += 1) {
+    hash = ((hash * 33) ^ ((u32)((u8)s[i])));
+  } 
+  hash = (hash ^ (hash >> 16U));
+  return ((i32)(hash % ((u32)this->num_buckets)));
+}
+
+static MapNode *Map__get_node(Map *this, char *key) {
+  i32 hash = Map__hash(this, key);
+  MapNode *node = this->buckets[hash];
+  while (((bool)node)) {
+    if (string__eq(node->key, key)) {
+      return node;
+    } 
+    node = node->next;
+  } 
+  return NULL;
+}
+
+static void *Map__get(Map *this, char *key) {
+  MapNode *node = Map__get_node(this, key);
+  if (((bool)node)) {
+    return node->value;
+  } 
+  return NULL;
+}
+
+static bool Map__exists(Map *this, char *key) {
+  return ((bool)Map__get_node(this, key));
+}
+
+static void Map__insert(Map *this, char *key, void *value) {
+  MapNode *node = Map__get_node(this, key);
+  if (((bool)node)) {
+    node->value = value;
+  }  else {
+    i32 hash = Map__hash(this, key);
+    MapNode *new_node = MapNode__new(key, value, this->buckets[hash]);
+    if (((bool)this->buckets[hash])) {
+      this->num_collisions += 1;
+    } 
+    this->buckets[hash] = new_node;
+    this->num_items += 1;
+    if ((this->num_items > this->num_buckets)) {
+      Map__resize(this);
+    } 
+  } 
+}
+
+static void Map__resize(Map *this) {
+  MapNode **old_buckets = this->buckets;
+  i32 old_num_buckets = this->num_buckets;
+  i32 old_num_items = this->num_items;
+  this->num_collisions = 0;
+  this->num_buckets *= 2;
+  this->buckets = ((MapNode **)calloc(this->num_buckets, sizeof(MapNode *)));
+  for (i32 i = 0; (i < old_num_buckets); i += 1) {
+    MapNode *node = old_buckets[i];
+    while (((bool)node)) {
+      i32 new_hash = Map__hash(this, node->key);
+      MapNode *new_node = MapNode__new(node->key, node->value, this->buckets[new_hash]);
+      if (((bool)this->buckets[new_hash])) {
+        this->num_collisions += 1;
+      } 
+      this->buckets[new_hash] = new_node;
+      node = node->next;
+    } 
+  } 
+  for (i32 i = 0; (i < old_num_buckets); i += 1) {
+    MapNode__free_list(old_buckets[i]);
+  } 
+  free(old_buckets);
+}
+
+static void Map__print_keys(Map *this) {
+  for (i32 i = 0; (i < this->num_buckets); i += 1) {
+    MapNode *node = this->buckets[i];
+    while (((bool)node)) {
+      printf("- '%s'\n""\n", node->key);
+      node = node->next;
+    } 
+  } 
+}
+
+static void Map__push_keys(Map *this, Vector *vec) {
+  for (i32 i = 0; (i < this->num_buckets); i += 1) {
+    MapNode *node = this->buckets[i];
+    while (((bool)node)) {
+      Vector__push(vec, node->key);
+      node = node->next;
+    } 
+  } 
+}
+
+static void Map__free(Map *this) {
+  for (i32 i = 0; (i < this->num_buckets); i += 1) {
+    MapNode__free_list(this->buckets[i]);
+  } 
+  free(this->buckets);
+}
+
+static MapIterator Map__iter(Map *this) {
+  return MapIterator__make(this);
+}
+
+static char *MapIterator__key(MapIterator *this) {
+  return this->cur->key;
+}
+
+static void *MapIterator__value(MapIterator *this) {
+  return this->cur->value;
+}
+
+static MapIterator MapIterator__make(Map *map) {
+  MapIterator it = (MapIterator){.idx = (-1), .cur = NULL, map};
+  MapIterator__next((&it));
+  return it;
+}
+
+static void MapIterator__next(MapIterator *this) {
+  while ((this->idx < this->map->num_buckets)) {
+    while (((bool)this->cur)) {
+      this->cur = this->cur->next;
+      if (((bool)this->cur)) 
+      return;
+      
+    } 
+    this->idx += 1;
+    this->cur = ({ MapNode *__yield_0;
+  if ((this->idx < this->map->num_buckets)) {
+    __yield_0 = this->map->buckets[this->idx];
+  }  else {
+    __yield_0 = NULL;
+  } 
+;__yield_0; });
+    if (((bool)this->cur)) 
+    return;
+    
+  } 
+}
+
+static u64 HashMap__hash(char *s) {
+  u64 hash = 0xcbf29ce484222325ULL;
+  for (i32 i = 0; (s[i] != '\0'); i += 1) {
+    hash = ((hash ^ ((u64)((u8)s[i]))) * 0x100000001b3ULL);
+  } 
+  hash = (hash ^ (hash >> 32ULL));
+  hash *= 0xd6e8feb86659fd93ULL;
+  hash = (hash ^ (hash >> 32ULL));
+  return hash;
+}
+
+static u64 hashmap_match_byte(u64 group, u8 byte) {
+  u64 x = (group ^ (HASHMAP_LSBS * ((u64)byte)));
+  return (((x - HASHMAP_LSBS) & (~x)) & HASHMAP_MSBS);
+}
+
+static u64 hashmap_match_empty(u64 group) {
+  return ((group & (~(group << 6ULL))) & HASHMAP_MSBS);
+}
+
+static u64 hashmap_match_free(u64 group) {
+  return (group & HASHMAP_MSBS);
+}
+
+static inline __attribute__((always_inline)) u8 hashmap_h2(u64 hash) {
+  return ((u8)(hash & 0x7FULL));
+}
+
+static inline __attribute__((always_inline)) i32 hashmap_start(u64 hash, i32 capacity) {
+  return ((((i32)(hash >> 7ULL)) & (capacity - 1)) & (~(HASHMAP_GROUP - 1)));
+}
+
+static i32 hashmap_resize_capacity(i32 num_items, i32 capacity) {
+  return (((num_items * 16) <= (capacity * 7)) ? capacity : (capacity * 2));
+}
+
+static u64 HashMapSlot__hash_of(HashMapSlot *slot) {
+  return slot->hash;
+}
+
+static bool HashMapSlot__matches(HashMapSlot *slot, char *key, u64 hash) {
+  return (slot->hash == hash && string__eq(slot->key, key));
+}
+
+static HashMap *HashMap__new_sized(i32 capacity) {
+  HashMap *map = ((HashMap *)calloc(1, sizeof(HashMap)));
+  hashmap_alloc__HashMap_HashMapSlot(map, capacity, 0);
+  return map;
+}
+
+static HashMap *HashMap__new(void) {
+  return HashMap__new_sized(HASHMAP_GROUP);
+}
+
+static i32 HashMap__find(HashMap *this, char *key, u64 hash) {
+  return hashmap_find__HashMap_HashMapSlot_ptr_char(this, key, hash);
+}
+
+static void *HashMap__get(HashMap *this, char *key) {
+  i32 index = HashMap__find(this, key, HashMap__hash(key));
+  if ((index < 0)) 
+  return NULL;
+  
+  return this->slots[index].value;
+}
+
+static bool HashMap__exists(HashMap *this, char *key) {
+  return (HashMap__find(this, key, HashMap__hash(key)) >= 0);
+}
+
+static void HashMap__insert(HashMap *this, char *key, void *value) {
+  u64 hash = HashMap__hash(key);
+  i32 index = HashMap__find(this, key, hash);
+  if ((index >= 0)) {
+    this->slots[index].value = value;
+    return;
+  } 
+  index = hashmap_claim__HashMap(this, hash);
+  if ((index < 0)) {
+    HashMap__resize(this);
+    index = hashmap_claim__HashMap(this, hash);
+  } 
+  this->slots[index] = (HashMapSlot){hash, key, value};
+  this->ctrl[index] = hashmap_h2(hash);
+  this->num_items += 1;
+}
+
+static void *HashMap__remove(HashMap *this, char *key) {
+  i32 index = HashMap__find(this, key, HashMap__hash(key));
+  if ((index < 0)) 
+  return NULL;
+  
+  void *value = this->slots[index].value;
+  this->num_items -= 1;
+  hashmap_erase__HashMap(this, index);
+  return value;
+}
+
+static void HashMap__resize(HashMap *this) {
+  hashmap_resize__HashMap_HashMapSlot(this, this->num_items);
+}
+
+static void HashMap__print_keys(HashMap *this) {
+  for (HashMapIterator iter = HashMap__iter(this); ((bool)iter.cur); HashMapIterator__next((&iter))) {
+    printf("- '%s'\n""\n", HashMapIterator__key((&iter)));
+  } 
+}
+
+static void HashMap__push_keys(HashMap *this, Vector *vec) {
+  for (HashMapIterator iter = HashMap__iter(this); ((bool)iter.cur); HashMapIterator__next((&iter))) {
+    Vector__push(vec, HashMapIterator__key((&iter)));
+  } 
+}
+
+static void HashMap__free(HashMap *this) {
+  free(this->ctrl);
+  free(this->slots);
+}
+
+static HashMapIterator HashMap__iter(HashMap *this) {
+  return HashMapIterator__make(this);
+}
+
+static char *HashMapIterator__key(HashMapIterator *this) {
+  return this->cur->key;
+}
+
+static void *HashMapIterator__value(HashMapIterator *this) {
+  return this->cur->value;
+}
+
+static HashMapIterator HashMapIterator__make(HashMap *map) {
+  HashMapIterator it = (HashMapIterator){.idx = (-1), .cur = NULL, map};
+  HashMapIterator__next((&it));
+  return it;
+}
+
+static void HashMapIterator__next(HashMapIterator *this) {
+  this->idx = hashmap_next_item__HashMap(this->map, (this->idx + 1));
+  this->cur = ((this->idx < this->map->capacity) ? (&this->map->slots[this->idx]) : NULL);
+}
+
+static u64 IntMap__hash(u64 key) {
+  key = (key ^ (key >> 33ULL));
+  key *= 0xff51afd7ed558ccdULL;
+  key = (key ^ (key >> 33ULL));
+  key *= 0xc4ceb9fe1a85ec53ULL;
+  return (key ^ (key >> 33ULL));
+}
+
+static u64 IntMapSlot__hash_of(IntMapSlot *slot) {
+  return IntMap__hash(slot->key);
+}
+
+static bool IntMapSlot__matches(IntMapSlot *slot, u64 key, u64 hash) {
+  return slot->key == key;
+}
+
+static IntMap *IntMap__new_sized(i32 capacity) {
+  IntMap *map = ((IntMap *)calloc(1, sizeof(IntMap)));
+  hashmap_alloc__IntMap_IntMapSlot(map, capacity, 0);
+  return map;
+}
+
+static IntMap *IntMap__new(void) {
+  return IntMap__new_sized(HASHMAP_GROUP);
+}
+
+static i32 IntMap__find(IntMap *this, u64 key, u64 hash) {
+  return hashmap_find__IntMap_IntMapSlot_u64(this, key, hash);
+}
+
+static void *IntMap__get(IntMap *this, u64 key) {
+  i32 index = IntMap__find(this, key, IntMap__hash(key));
+  if ((index < 0)) 
+  return NULL;
+  
+  return this->slots[index].value;
+}
+
+static bool IntMap__exists(IntMap *this, u64 key) {
+  return (IntMap__find(this, key, IntMap__hash(key)) >= 0);
+}
+
+static void IntMap__insert(IntMap *this, u64 key, void *value) {
+  u64 hash = IntMap__hash(key);
+  i32 index = IntMap__find(this, key, hash);
+  if ((index >= 0)) {
+    this->slots[index].value = value;
+    return;
+  } 
+  index = hashmap_claim__IntMap(this, hash);
+  if ((index < 0)) {
+    IntMap__resize(this);
+    index = hashmap_claim__IntMap(this, hash);
+  } 
+  this->slots[index] = (IntMapSlot){key, value};
+  this->ctrl[index] = hashmap_h2(hash);
+  this->num_items += 1;
+}
+
+static void *IntMap__remove(IntMap *this, u64 key) {
+  i32 index = IntMap__find(this, key, IntMap__hash(key));
+  if ((index < 0)) 
+  return NULL;
+  
+  void *value = this->slots[index].value;
+  this->num_items -= 1;
+  hashmap_erase__IntMap(this, index);
+  return value;
+}
+
+static void IntMap__resize(IntMap *this) {
+  hashmap_resize__IntMap_IntMapSlot(this, this->num_items);
+}
+
+static void IntMap__free(IntMap *this) {
+  free(this->ctrl);
+  free(this->slots);
+}
+
+static IntMapIterator IntMap__iter(IntMap *this) {
+  return IntMapIterator__make(this);
+}
+
+static u64 IntMapIterator__key(IntMapIterator *this) {
+  return this->cur->key;
+}
+
+static void *IntMapIterator__value(IntMapIterator *this) {
+  return this->cur->value;
+}
+
+static IntMapIterator IntMapIterator__make(IntMap *map) {
+  IntMapIterator it = (IntMapIterator){.idx = (-1), .cur = NULL, map};
+  IntMapIterator__next((&it));
+  return it;
+}
+
+static void IntMapIterator__next(IntMapIterator *this) {
+  this->idx = hashmap_next_item__IntMap(this->map, (this->idx + 1));
+  this->cur = ((this->idx < this->map->capacity) ? (&this->map->slots[this->idx]) : NULL);
+}
+
+static u64 SetSlot__hash_of(SetSlot *slot) {
+  return slot->hash;
+}
+
+static bool SetSlot__matches(SetSlot *slot, char *key, u64 hash) {
+  return (slot->hash == hash && string__eq(slot->key, key));
+}
+
+static Set *Set__new_sized(i32 capacity) {
+  Set *set = ((Set *)calloc(1, sizeof(Set)));
+  hashmap_alloc__Set_SetSlot(set, capacity, 0);
+  return set;
+}
+
+static Set *Set__new(void) {
+  return Set__new_sized(HASHMAP_GROUP);
+}
+
+static i32 Set__find(Set *this, char *key, u64 hash) {
+  return hashmap_find__Set_SetSlot_ptr_char(this, key, hash);
+}
+
+static bool Set__contains(Set *this, char *key) {
+  return (Set__find(this, key, HashMap__hash(key)) >= 0);
+}
+
+static bool Set__add(Set *this, char *key) {
+  u64 hash = HashMap__hash(key);
+  if ((Set__find(this, key, hash) >= 0)) 
+  return false;
+  
+  i32 index = hashmap_claim__Set(this, hash);
+  if ((index < 0)) {
+    Set__resize(this);
+    index = hashmap_claim__Set(this, hash);
+  } 
+  this->slots[index] = (SetSlot){hash, key};
+  this->ctrl[index] = hashmap_h2(hash);
+  this->num_items += 1;
+  return true;
+}
+
+static bool Set__remove(Set *this, char *key) {
+  i32 index = Set__find(this, key, HashMap__hash(key));
+  if ((index < 0)) 
+  return false;
+  
+  this->num_items -= 1;
+  hashmap_erase__Set(this, index);
+  return true;
+}
+
+static void Set__resize(Set *this) {
+  hashmap_resize__Set_SetSlot(this, this->num_items);
+}
+
+static void Set__push_keys(Set *this, Vector *vec) {
+  for (SetIterator iter = Set__iter(this); ((bool)iter.cur); SetIterator__next((&iter))) {
+    Vector__push(vec, SetIterator__key((&iter)));
+  } 
+}
+
+static void Set__free(Set *this) {
+  free(this->ctrl);
+  free(this->slots);
+}
+
+static SetIterator Set__iter(Set *this) {
+  return SetIterator__make(this);
+}
+
+static char *SetIterator__key(SetIterator *this) {
+  return this->cur->key;
+}
+
+static SetIterator SetIterator__make(Set *set) {
+  SetIterator it = (SetIterator){.idx = (-1), .cur = NULL, set};
+  SetIterator__next((&it));
+  return it;
+}
+
+static void SetIterator__next(SetIterator *this) {
+  this->idx = hashmap_next_item__Set(this->set, (this->idx + 1));
+  this->cur = ((this->idx < this->set->capacity) ? (&this->set->slots[this->idx]) : NULL);
+}
+
+static void bench_int_keys(i32 n) {
+  i32 rounds = (2000000 / n);
+  i32 ops = (n * rounds);
+  f64 start = time_now();
+  for (i32 r = 0; (r < rounds); r += 1) {
+    Map *map = Map__new();
+    for (i32 i = 0; (i < n); i += 1) {
+      Map__insert(map, format_string("%d", (i * 7919)), ((void *)((u64)i)));
+    } 
+    for (i32 i = 0; (i < n); i += 1) {
+      char *key = format_string("%d", (i * 7919));
+      bench_sink += ((u64)Map__get(map, key));
+      free(key);
+    } 
+    for (MapIterator iter = Map__iter(map); ((bool)iter.cur); MapIterator__next((&iter))) {
+      free(MapIterator__key((&iter)));
+    } 
+    Map__free(map);
+    free(map);
+  } 
+  bench_report(format_string("Map, formatted keys (%d)", n), (time_now() - start), ops);
+  start = time_now();
+  for (i32 r = 0; (r < rounds); r += 1) {
+    IntMap *map = IntMap__new();
+    for (i32 i = 0; (i < n); i += 1) {
+      IntMap__insert(map, ((u64)(i * 7919)), ((void *)((u64)i)));
+    } 
+    for (i32 i = 0; (i < n); i += 1) {
+      bench_sink += ((u64)IntMap__get(map, ((u64)(i * 7919))));
+    } 
+    IntMap__free(map);
+    free(map);
+  } 
+  bench_report(format_string("IntMap (%d)", n), (time_now() - start), ops);
+}
+
+static void bench_set(i32 n) {
+  i32 rounds = (2000000 / n);
+  i32 ops = (n * rounds);
+  char **keys = ((char **)calloc(n, sizeof(char *)));
+  for (i32 i = 0; (i < n); i += 1) {
+    keys[i] = format_string("key_%d", (i * 7919));
+  } 
+  f64 start = time_now();
+  for (i32 r = 0; (r < rounds); r += 1) {
+    Map *set = Map__new();
+    for (i32 i = 0; (i < n); i += 1) {
+      Map__insert(set, keys[i], keys[i]);
+    } 
+    for (i32 i = 0; (i < n); i += 1) {
+      bench_sink += ((u64)Map__exists(set, keys[((i * 3) % n)]));
+    } 
+    Map__free(set);
+    free(set);
+  } 
+  bench_report(format_string("Map as a set (%d)", n), (time_now() - start), ops);
+  start = time_now();
+  for (i32 r = 0; (r < rounds); r += 1) {
+    Set *set = Set__new();
+    for (i32 i = 0; (i < n); i += 1) {
+      Set__add(set, keys[i]);
+    } 
+    for (i32 i = 0; (i < n); i += 1) {
+      bench_sink += ((u64)Set__contains(set, keys[((i * 3) % n)]));
+    } 
+    Set__free(set);
+    free(set);
+  } 
+  bench_report(format_string("Set (%d)", n), (time_now() - start), ops);
+}
+
+i32 main(void) {
+  bench_int_keys(16);
+  bench_int_keys(1000);
+  bench_int_keys(100000);
+  printf("""\n");
+  bench_set(16);
+  bench_set(1000);
+  bench_set(100000);
+}
+
+static i32 hashmap_next_item__Set(Set *map, i32 index) {
+  while (((index < map->capacity) && ((map->ctrl[index] & 0x80) != 0))) {
+    index += 1;
+  } 
+  return index;
+}
+
+static void hashmap_resize__Set_SetSlot(Set *map, i32 num_items) {
+  u8 *old_ctrl = map->ctrl;
+  SetSlot *old_slots = map->slots;
+  i32 old_capacity = map->capacity;
+  hashmap_alloc__Set_SetSlot(map, hashmap_resize_capacity(num_items, old_capacity), num_items);
+  hashmap_rehash__Set_SetSlot(map, old_ctrl, old_slots, old_capacity);
+  free(old_ctrl);
+  free(old_slots);
+}
+
+static void hashmap_rehash__Set_SetSlot(Set *map, u8 *old_ctrl, SetSlot *old_slots, i32 old_capacity) {
+  for (i32 i = 0; (i < old_capacity); i += 1) {
+    if (((old_ctrl[i] & 0x80) != 0)) 
+    continue;
+    
+    i32 index = hashmap_find_free__Set(map, SetSlot__hash_of((&old_slots[i])));
+    map->ctrl[index] = old_ctrl[i];
+    map->slots[index] = old_slots[i];
+  } 
+}
+
+static i32 hashmap_find_free__Set(Set *map, u64 hash) {
+  i32 mask = (map->capacity - 1);
+  i32 pos = hashmap_start(hash, map->capacity);
+  for (i32 step = HASHMAP_GROUP; true; step += HASHMAP_GROUP) {
+    u64 free = hashmap_match_free(hashmap_group__Set(map, pos));
+    if ((free != 0)) 
+    return (pos + (__builtin_ctzll(free) / 8));
+    
+    pos = ((pos + step) & mask);
+  } 
+  return (-1);
+}
+
+static inline __attribute__((always_inline)) u64 hashmap_group__Set(Set *map, i32 index) {
+  return (*((u64 *)(map->ctrl + index)));
+}
+
+static void hashmap_erase__Set(Set *map, i32 index) {
+  i32 group_start = (index & (~(HASHMAP_GROUP - 1)));
+  if ((hashmap_match_empty(hashmap_group__Set(map, group_start)) != 0)) {
+    map->ctrl[index] = ((u8)HASHMAP_EMPTY);
+    map->growth_left += 1;
+  }  else {
+    map->ctrl[index] = ((u8)HASHMAP_DELETED);
+  } 
+}
+
+static i32 hashmap_claim__Set(Set *map, u64 hash) {
+  i32 index = hashmap_find_free__Set(map, hash);
+  if (map->ctrl[index] == ((u8)HASHMAP_EMPTY)) {
+    if (map->growth_left == 0) 
+    return (-1);
+    
+    map->growth_left -= 1;
+  } 
+  return index;
+}
+
+static i32 hashmap_find__Set_SetSlot_ptr_char(Set *map, char *key, u64 hash) {
+  i32 mask = (map->capacity - 1);
+  u8 h2 = hashmap_h2(hash);
+  i32 pos = hashmap_start(hash, map->capacity);
+  for (i32 step = HASHMAP_GROUP; true; step += HASHMAP_GROUP) {
+    u64 group = hashmap_group__Set(map, pos);
+    for (u64 matches = hashmap_match_byte(group, h2); (matches != 0); matches = (matches & (matches - 1))) {
+      i32 index = (pos + (__builtin_ctzll(matches) / 8));
+      if (SetSlot__matches((&map->slots[index]), key, hash)) 
+      return index;
+      
+    } 
+    if ((hashmap_match_empty(group) != 0)) 
+    return (-1);
+    
+    pos = ((pos + step) & mask);
+  } 
+  return (-1);
+}
+
+static void hashmap_alloc__Set_SetSlot(Set *map, i32 min_capacity, i32 num_items) {
+  i32 capacity = HASHMAP_GROUP;
+  while ((capacity < min_capacity)) {
+    capacity *= 2;
+  } 
+  map->capacity = capacity;
+  map->ctrl = ((u8 *)malloc(capacity));
+  memset(map->ctrl, ((u8)HASHMAP_EMPTY), capacity);
+  map->slots = ((SetSlot *)malloc((capacity * sizeof(SetSlot))));
+  map->growth_left = ((capacity - (capacity / 8)) - num_items);
+}
+
+static i32 hashmap_next_item__IntMap(IntMap *map, i32 index) {
+  while (((index < map->capacity) && ((map->ctrl[index] & 0x80) != 0))) {
+    index += 1;
+  } 
+  return index;
+}
+
+static void hashmap_resize__IntMap_IntMapSlot(IntMap *map, i32 num_items) {
+  u8 *old_ctrl = map->ctrl;
+  IntMapSlot *old_slots = map->slots;
+  i32 old_capacity = map->capacity;
+  hashmap_alloc__IntMap_IntMapSlot(map, hashmap_resize_capacity(num_items, old_capacity), num_items);
+  hashmap_rehash__IntMap_IntMapSlot(map, old_ctrl, old_slots, old_capacity);
+  free(old_ctrl);
+  free(old_slots);
+}
+
+static void hashmap_rehash__IntMap_IntMapSlot(IntMap *map, u8 *old_ctrl, IntMapSlot *old_slots, i32 old_capacity) {
+  for (i32 i = 0; (i < old_capacity); i += 1) {
+    if (((old_ctrl[i] & 0x80) != 0)) 
+    continue;
+    
+    i32 index = hashmap_find_free__IntMap(map, IntMapSlot__hash_of((&old_slots[i])));
+    map->ctrl[index] = old_ctrl[i];
+    map->slots[index] = old_slots[i];
+  } 
+}
+
+static i32 hashmap_find_free__IntMap(IntMap *map, u64 hash) {
+  i32 mask = (map->capacity - 1);
+  i32 pos = hashmap_start(hash, map->capacity);
+  for (i32 step = HASHMAP_GROUP; true; step += HASHMAP_GROUP) {
+    u64 free = hashmap_match_free(hashmap_group__IntMap(map, pos));
+    if ((free != 0)) 
+    return (pos + (__builtin_ctzll(free) / 8));
+    
+    pos = ((pos + step) & mask);
+  } 
+  return (-1);
+}
+
+static inline __attribute__((always_inline)) u64 hashmap_group__IntMap(IntMap *map, i32 index) {
+  return (*((u64 *)(map->ctrl + index)));
+}
+
+static void hashmap_erase__IntMap(IntMap *map, i32 index) {
+  i32 group_start = (index & (~(HASHMAP_GROUP - 1)));
+  if ((hashmap_match_empty(hashmap_group__IntMap(map, group_start)) != 0)) {
+    map->ctrl[index] = ((u8)HASHMAP_EMPTY);
+    map->growth_left += 1;
+  }  else {
+    map->ctrl[index] = ((u8)HASHMAP_DELETED);
+  } 
+}
+
+static i32 hashmap_claim__IntMap(IntMap *map, u64 hash) {
+  i32 index = hashmap_find_free__IntMap(map, hash);
+  if (map->ctrl[index] == ((u8)HASHMAP_EMPTY)) {
+    if (map->growth_left == 0) 
+    return (-1);
+    
+    map->growth_left -= 1;
+  } 
+  return index;
+}
+
+static i32 hashmap_find__IntMap_IntMapSlot_u64(IntMap *map, u64 key, u64 hash) {
+  i32 mask = (map->capacity - 1);
+  u8 h2 = hashmap_h2(hash);
+  i32 pos = hashmap_start(hash, map->capacity);
+  for (i32 step = HASHMAP_GROUP; true; step += HASHMAP_GROUP) {
+    u64 group = hashmap_group__IntMap(map, pos);
+    for (u64 matches = hashmap_match_byte(group, h2); (matches != 0); matches = (matches & (matches - 1))) {
+      i32 index = (pos + (__builtin_ctzll(matches) / 8));
+      if (IntMapSlot__matches((&map->slots[index]), key, hash)) 
+      return index;
+      
+    } 
+    if ((hashmap_match_empty(group) != 0)) 
+    return (-1);
+    
+    pos = ((pos + step) & mask);
+  } 
+  return (-1);
+}
+
+static void hashmap_alloc__IntMap_IntMapSlot(IntMap *map, i32 min_capacity, i32 num_items) {
+  i32 capacity = HASHMAP_GROUP;
+  while ((capacity < min_capacity)) {
+    capacity *= 2;
+  } 
+  map->capacity = capacity;
+  map->ctrl = ((u8 *)malloc(capacity));
+  memset(map->ctrl, ((u8)HASHMAP_EMPTY), capacity);
+  map->slots = ((IntMapSlot *)malloc((capacity * sizeof(IntMapSlot))));
+  map->growth_left = ((capacity - (capacity / 8)) - num_items);
+}
+
+static i32 hashmap_next_item__HashMap(HashMap *map, i32 index) {
+  while (((index < map->capacity) && ((map->ctrl[index] & 0x80) != 0))) {
+    index += 1;
+  } 
+  return index;
+}
+
+static void hashmap_resize__HashMap_HashMapSlot(HashMap *map, i32 num_items) {
+  u8 *old_ctrl = map->ctrl;
+  HashMapSlot *old_slots = map->slots;
+  i32 old_capacity = map->capacity;
+  hashmap_alloc__HashMap_HashMapSlot(map, hashmap_resize_capacity(num_items, old_capacity), num_items);
+  hashmap_rehash__HashMap_HashMapSlot(map, old_ctrl, old_slots, old_capacity);
+  free(old_ctrl);
+  free(old_slots);
+}
+
+static void hashmap_rehash__HashMap_HashMapSlot(HashMap *map, u8 *old_ctrl, HashMapSlot *old_slots, i32 old_capacity) {
+  for (i32 i = 0; (i < old_capacity); i += 1) {
+    if (((old_ctrl[i] & 0x80) != 0)) 
+    continue;
+    
+    i32 index = hashmap_find_free__HashMap(map, HashMapSlot__hash_of((&old_slots[i])));
+    map->ctrl[index] = old_ctrl[i];
+    map->slots[index] = old_slots[i];
+  } 
+}
+
+static i32 hashmap_find_free__HashMap(HashMap *map, u64 hash) {
+  i32 mask = (map->capacity - 1);
+  i32 pos = hashmap_start(hash, map->capacity);
+  for (i32 step = HASHMAP_GROUP; true; step += HASHMAP_GROUP) {
+    u64 free = hashmap_match_free(hashmap_group__HashMap(map, pos));
+    if ((free != 0)) 
+    return (pos + (__builtin_ctzll(free) / 8));
+    
+    pos = ((pos + step) & mask);
+  } 
+  return (-1);
+}
+
+static inline __attribute__((always_inline)) u64 hashmap_group__HashMap(HashMap *map, i32 index) {
+  return (*((u64 *)(map->ctrl + index)));
+}
+
+static void hashmap_erase__HashMap(HashMap *map, i32 index) {
+  i32 group_start = (index & (~(HASHMAP_GROUP - 1)));
+  if ((hashmap_match_empty(hashmap_group__HashMap(map, group_start)) != 0)) {
+    map->ctrl[index] = ((u8)HASHMAP_EMPTY);
+    map->growth_left += 1;
+  }  else {
+    map->ctrl[index] = ((u8)HASHMAP_DELETED);
+  } 
+}
+
+static i32 hashmap_claim__HashMap(HashMap *map, u64 hash) {
+  i32 index = hashmap_find_free__HashMap(map, hash);
+  if (map->ctrl[index] == ((u8)HASHMAP_EMPTY)) {
+    if (map->growth_left == 0) 
+    return (-1);
+    
+    map->growth_left -= 1;
+  } 
+  return index;
+}
+
+static i32 hashmap_find__HashMap_HashMapSlot_ptr_char(HashMap *map, char *key, u64 hash) {
+  i32 mask = (map->capacity - 1);
+  u8 h2 = hashmap_h2(hash);
+  i32 pos = hashmap_start(hash, map->capacity);
+  for (i32 step = HASHMAP_GROUP; true; step += HASHMAP_GROUP) {
+    u64 group = hashmap_group__HashMap(map, pos);
+    for (u64 matches = hashmap_match_byte(group, h2); (matches != 0); matches = (matches & (matches - 1))) {
+      i32 index = (pos + (__builtin_ctzll(matches) / 8));
+      if (HashMapSlot__matches((&map->slots[index]), key, hash)) 
+      return index;
+      
+    } 
+    if ((hashmap_match_empty(group) != 0)) 
+    return (-1);
+    
+    pos = ((pos + step) & mask);
+  } 
+  return (-1);
+}
+
+static void hashmap_alloc__HashMap_HashMapSlot(HashMap *map, i32 min_capacity, i32 num_items) {
+  i32 capacity = HASHMAP_GROUP;
+  while ((capacity < min_capacity)) {
+    capacity *= 2;
+  } 
+  map->capacity = capacity;
+  map->ctrl = ((u8 *)malloc(capacity));
+  memset(map->ctrl, ((u8)HASHMAP_EMPTY), capacity);
+  map->slots = ((HashMapSlot *)malloc((capacity * sizeof(HashMapSlot))));
+  map->growth_left = ((capacity - (capacity / 8)) - num_items);
+}
+
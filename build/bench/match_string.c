@@ -0,0 +1,957 @@
+#include "stdio.h"
+#include "stdlib.h"
+#include "stdbool.h"
+#include "stdint.h"
+#include "string.h"
+#include "errno.h"
+#include "ctype.h"
+#include "time.h"
+
+/***************** embed './lib/prelude.h' *****************/
+#include "stdarg.h"
+
+typedef int8_t i8;
+typedef int16_t i16;
+typedef int32_t i32;
+typedef int64_t i64;
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+
+typedef float f32;
+typedef double f64;
+
+char* format_string(const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  int size = vsnprintf(NULL, 0, format, args);
+  va_end(args);
+  va_start(args, format);
+  char* s = calloc(1, size + 1);
+  vsprintf(s, format, args);
+  s[size] = '\0';
+  va_end(args);
+  return s;
+}
+
+// FNV-1a with a murmur3 finalizer, used for hashed dispatch on strings.
+// Must be kept in sync with `hash_string` in `compiler/utils.ae`.
+u32 aecor_hash_str(const char* s, u32 seed) {
+  u32 hash = seed;
+  for (; *s; s++) {
+    hash = (hash ^ (u8)*s) * 16777619u;
+  }
+  hash = (hash ^ (hash >> 16)) * 0x85ebca6bu;
+  hash = (hash ^ (hash >> 13)) * 0xc2b2ae35u;
+  return hash ^ (hash >> 16);
+}
+
+
+/* constants */
+
+/* struct declarations */
+
+/* function declarations */
+FILE *File__open(char *path, char *mode);
+bool File__exists(char *path);
+i32 File__size(FILE *this);
+char *File__slurp(FILE *this);
+i32 File__read(FILE *this, void *buf, i32 size);
+i32 File__write(FILE *this, void *buf, i32 size);
+void File__puts(FILE *this, char *str);
+__attribute__((noreturn)) void panic(char *msg);
+bool string__starts_with(char *this, char *prefix);
+bool string__ends_with(char *this, char *suffix);
+void string__remove_last_n(char *this, i32 n);
+bool string__eq(char *this, char *str2);
+char *string__substring(char *this, i32 start, i32 len);
+void string__strip_trailing_whitespace(char *this);
+i32 min(i32 a, i32 b);
+i32 max(i32 a, i32 b);
+f64 time_now(void);
+void bench_report(char *name, f64 elapsed, i32 iters);
+i32 match_2(char *s);
+i32 match_3(char *s);
+i32 match_4(char *s);
+i32 match_6(char *s);
+i32 match_8(char *s);
+i32 match_12(char *s);
+i32 match_16(char *s);
+i32 match_32(char *s);
+char **make_inputs(i32 n);
+char *all_words(i32 i);
+void run(i32 n, i32 (*f)(char *));
+i32 main(void);
+
+/* global variables */
+u64 bench_sink = 0;
+
+FILE *File__open(char *path, char *mode) {
+  FILE *file = fopen(path, mode);
+  if ((!((bool)file))) {
+    printf("Error opening file '%s': %s""\n", path, strerror(errno));
+    exit(1);
+  } 
+  return file;
+}
+
+bool File__exists(char *path) {
+  FILE *file = fopen(path, "r");
+  if ((!((bool)file))) {
+    return false;
+  } 
+  fclose(file);
+  return true;
+}
+
+i32 File__size(FILE *this) {
+  i32 pos = ftell(this);
+  fseek(this, 0, SEEK_END);
+  i32 size = ftell(this);
+  fseek(this, pos, SEEK_SET);
+  return size;
+}
+
+char *File__slurp(FILE *this) {
+  i32 pos = ftell(this);
+  fseek(this, 0, SEEK_END);
+  i32 size = ftell(this);
+  fseek(this, pos, SEEK_SET);
+  void *buf = calloc((size + 1), sizeof(char));
+  fread(buf, 1, size, this);
+  fseek(this, pos, SEEK_SET);
+  return ((char *)buf);
+}
+
+i32 File__read(FILE *this, void *buf, i32 size) {
+  return fread(buf, 1, size, this);
+}
+
+i32 File__write(FILE *this, void *buf, i32 size) {
+  return fwrite(buf, 1, size, this);
+}
+
+void File__puts(FILE *this, char *str) {
+  fwrite(str, 1, strlen(str), this);
+}
+
+__attribute__((noreturn)) void panic(char *msg) {
+  printf("%s""\n", msg);
+  exit(1);
+}
+
+bool string__starts_with(char *this, char *prefix) {
+  i32 prefix_len = strlen(prefix);
+  if ((strlen(this) < prefix_len)) {
+    return false;
+  } 
+  return strncmp(this, prefix, prefix_len) == 0;
+}
+
+bool string__ends_with(char *this, char *suffix) {
+  i32 suffix_len = strlen(suffix);
+  if ((strlen(this) < suffix_len)) {
+    return false;
+  } 
+  return strncmp(this, suffix, suffix_len) == 0;
+}
+
+void string__remove_last_n(char *this, i32 n) {
+  this[(strlen(this) - n)] = '\0';
+}
+
+bool string__eq(char *this, char *str2) {
+  return strcmp(this, str2) == 0;
+}
+
+char *string__substring(char *this, i32 start, i32 len) {
+  char *new_str = ((char *)calloc((len + 1), sizeof(char)));
+  memcpy(new_str, (this + start), len);
+  return new_str;
+}
+
+void string__strip_trailing_whitespace(char *this) {
+  for (i32 i = (strlen(this) - 1); (i >= 0); i -= 1) {
+    if ((this[i] != ' ')) 
+    break;
+    
+    this[i] = '\0';
+  } 
+}
+
+i32 min(i32 a, i32 b) {
+  return ((a < b) ? a : b);
+}
+
+i32 max(i32 a, i32 b) {
+  return ((a > b) ? a : b);
+}
+
+f64 time_now(void) {
+  struct timespec ts = {0};
+  clock_gettime(CLOCK_MONOTONIC, (&ts));
+  return (((f64)ts.tv_sec) + (((f64)ts.tv_nsec) / 1000000000.0));
+}
+
+void bench_report(char *name, f64 elapsed, i32 iters) {
+  f64 ns = ((elapsed * 1000000000.0) / ((f64)iters));
+  printf("%-32s %10.3f ms %10.2f ns/iter""\n", name, (elapsed * 1000.0), ns);
+}
+
+i32 match_2(char *s) {
+  return ({ i32 __yield_0;
+  {
+    char *__match_str = s;
+    switch (aecor_hash_str(__match_str, 2166136261u)) {
+      case 1305964296u:
+        if (!strcmp(__match_str, "and")) goto __match_0_0;
+        break;
+      case 106731536u:
+        if (!strcmp(__match_str, "as")) goto __match_0_1;
+        break;
+    }
+    goto __match_0_default;
+    __match_0_0: {
+      __yield_0 = 0;
+} goto __match_0_end;
+    __match_0_1: {
+      __yield_0 = 1;
+} goto __match_0_end;
+    __match_0_default: {
+      __yield_0 = (-1);
+}
+    __match_0_end:;
+  }
+;__yield_0; });
+}
+
+i32 match_3(char *s) {
+  return ({ i32 __yield_0;
+  {
+    char *__match_str = s;
+    switch (aecor_hash_str(__match_str, 2166136261u)) {
+      case 1305964296u:
+        if (!strcmp(__match_str, "and")) goto __match_1_0;
+        break;
+      case 106731536u:
+        if (!strcmp(__match_str, "as")) goto __match_1_1;
+        break;
+      case 2869110635u:
+        if (!strcmp(__match_str, "bool")) goto __match_1_2;
+        break;
+    }
+    goto __match_1_default;
+    __match_1_0: {
+      __yield_0 = 0;
+} goto __match_1_end;
+    __match_1_1: {
+      __yield_0 = 1;
+} goto __match_1_end;
+    __match_1_2: {
+      __yield_0 = 2;
+} goto __match_1_end;
+    __match_1_default: {
+      __yield_0 = (-1);
+}
+    __match_1_end:;
+  }
+;__yield_0; });
+}
+
+i32 match_4(char *s) {
+  return ({ i32 __yield_0;
+  {
+    char *__match_str = s;
+    switch (aecor_hash_str(__match_str, 2166136261u)) {
+      case 1305964296u:
+        if (!strcmp(__match_str, "and")) goto __match_2_0;
+        break;
+      case 106731536u:
+        if (!strcmp(__match_str, "as")) goto __match_2_1;
+        break;
+      case 2869110635u:
+        if (!strcmp(__match_str, "bool")) goto __match_2_2;
+        break;
+      case 1349183411u:
+        if (!strcmp(__match_str, "break")) goto __match_2_3;
+        break;
+    }
+    goto __match_2_default;
+    __match_2_0: {
+      __yield_0 = 0;
+} goto __match_2_end;
+    __match_2_1: {
+      __yield_0 = 1;
+} goto __match_2_end;
+    __match_2_2: {
+      __yield_0 = 2;
+} goto __match_2_end;
+    __match_2_3: {
+      __yield_0 = 3;
+} goto __match_2_end;
+    __match_2_default: {
+      __yield_0 = (-1);
+}
+    __match_2_end:;
+  }
+;__yield_0; });
+}
+
+i32 match_6(char *s) {
+  return ({ i32 __yield_0;
+  {
+    char *__match_str = s;
+    switch (aecor_hash_str(__match_str, 2166136261u)) {
+      case 1305964296u:
+        if (!strcmp(__match_str, "and")) goto __match_3_0;
+        break;
+      case 106731536u:
+        if (!strcmp(__match_str, "as")) goto __match_3_1;
+        break;
+      case 2869110635u:
+        if (!strcmp(__match_str, "bool")) goto __match_3_2;
+        break;
+      case 1349183411u:
+        if (!strcmp(__match_str, "break")) goto __match_3_3;
+        break;
+      case 3477080843u:
+        if (!strcmp(__match_str, "char")) goto __match_3_4;
+        break;
+      case 2245205078u:
+        if (!strcmp(__match_str, "const")) goto __match_3_5;
+        break;
+    }
+    goto __match_3_default;
+    __match_3_0: {
+      __yield_0 = 0;
+} goto __match_3_end;
+    __match_3_1: {
+      __yield_0 = 1;
+} goto __match_3_end;
+    __match_3_2: {
+      __yield_0 = 2;
+} goto __match_3_end;
+    __match_3_3: {
+      __yield_0 = 3;
+} goto __match_3_end;
+    __match_3_4: {
+      __yield_0 = 4;
+} goto __match_3_end;
+    __match_3_5: {
+      __yield_0 = 5;
+} goto __match_3_end;
+    __match_3_default: {
+      __yield_0 = (-1);
+}
+    __match_3_end:;
+  }
+;__yield_0; });
+}
+
+i32 match_8(char *s) {
+  return ({ i32 __yield_0;
+  {
+    char *__match_str = s;
+    switch (aecor_hash_str(__match_str, 2166136261u)) {
+      case 1305964296u:
+        if (!strcmp(__match_str, "and")) goto __match_4_0;
+        break;
+      case 106731536u:
+        if (!strcmp(__match_str, "as")) goto __match_4_1;
+        break;
+      case 2869110635u:
+        if (!strcmp(__match_str, "bool")) goto __match_4_2;
+        break;
+      case 1349183411u:
+        if (!strcmp(__match_str, "break")) goto __match_4_3;
+        break;
+      case 3477080843u:
+        if (!strcmp(__match_str, "char")) goto __match_4_4;
+        break;
+      case 2245205078u:
+        if (!strcmp(__match_str, "const")) goto __match_4_5;
+        break;
+      case 3663126513u:
+        if (!strcmp(__match_str, "continue")) goto __match_4_6;
+        break;
+      case 832636142u:
+        if (!strcmp(__match_str, "def")) goto __match_4_7;
+        break;
+    }
+    goto __match_4_default;
+    __match_4_0: {
+      __yield_0 = 0;
+} goto __match_4_end;
+    __match_4_1: {
+      __yield_0 = 1;
+} goto __match_4_end;
+    __match_4_2: {
+      __yield_0 = 2;
+} goto __match_4_end;
+    __match_4_3: {
+      __yield_0 = 3;
+} goto __match_4_end;
+    __match_4_4: {
+      __yield_0 = 4;
+} goto __match_4_end;
+    __match_4_5: {
+      __yield_0 = 5;
+} goto __match_4_end;
+    __match_4_6: {
+      __yield_0 = 6;
+} goto __match_4_end;
+    __match_4_7: {
+      __yield_0 = 7;
+} goto __match_4_end;
+    __match_4_default: {
+      __yield_0 = (-1);
+}
+    __match_4_end:;
+  }
+;__yield_0; });
+}
+
+i32 match_12(char *s) {
+  return ({ i32 __yield_0;
+  {
+    char *__match_str = s;
+    switch (aecor_hash_str(__match_str, 2166136261u)) {
+      case 1305964296u:
+        if (!strcmp(__match_str, "and")) goto __match_5_0;
+        break;
+      case 106731536u:
+        if (!strcmp(__match_str, "as")) goto __match_5_1;
+        break;
+      case 2869110635u:
+        if (!strcmp(__match_str, "bool")) goto __match_5_2;
+        break;
+      case 1349183411u:
+        if (!strcmp(__match_str, "break")) goto __match_5_3;
+        break;
+      case 3477080843u:
+        if (!strcmp(__match_str, "char")) goto __match_5_4;
+        break;
+      case 2245205078u:
+        if (!strcmp(__match_str, "const")) goto __match_5_5;
+        break;
+      case 3663126513u:
+        if (!strcmp(__match_str, "continue")) goto __match_5_6;
+        break;
+      case 832636142u:
+        if (!strcmp(__match_str, "def")) goto __match_5_7;
+        break;
+      case 2838665391u:
+        if (!strcmp(__match_str, "defer")) goto __match_5_8;
+        break;
+      case 642373404u:
+        if (!strcmp(__match_str, "else")) goto __match_5_9;
+        break;
+      case 1633607337u:
+        if (!strcmp(__match_str, "enum")) goto __match_5_10;
+        break;
+      case 594816953u:
+        if (!strcmp(__match_str, "extern")) goto __match_5_11;
+        break;
+    }
+    goto __match_5_default;
+    __match_5_0: {
+      __yield_0 = 0;
+} goto __match_5_end;
+    __match_5_1: {
+      __yield_0 = 1;
+} goto __match_5_end;
+    __match_5_2: {
+      __yield_0 = 2;
+} goto __match_5_end;
+    __match_5_3: {
+      __yield_0 = 3;
+} goto __match_5_end;
+    __match_5_4: {
+      __yield_0 = 4;
+} goto __match_5_end;
+    __match_5_5: {
+      __yield_0 = 5;
+} goto __match_5_end;
+    __match_5_6: {
+      __yield_0 = 6;
+} goto __match_5_end;
+    __match_5_7: {
+      __yield_0 = 7;
+} goto __match_5_end;
+    __match_5_8: {
+      __yield_0 = 8;
+} goto __match_5_end;
+    __match_5_9: {
+      __yield_0 = 9;
+} goto __match_5_end;
+    __match_5_10: {
+      __yield_0 = 10;
+} goto __match_5_end;
+    __match_5_11: {
+      __yield_0 = 11;
+} goto __match_5_end;
+    __match_5_default: {
+      __yield_0 = (-1);
+}
+    __match_5_end:;
+  }
+;__yield_0; });
+}
+
+i32 match_16(char *s) {
+  return ({ i32 __yield_0;
+  {
+    char *__match_str = s;
+    switch (aecor_hash_str(__match_str, 2166136261u)) {
+      case 1305964296u:
+        if (!strcmp(__match_str, "and")) goto __match_6_0;
+        break;
+      case 106731536u:
+        if (!strcmp(__match_str, "as")) goto __match_6_1;
+        break;
+      case 2869110635u:
+        if (!strcmp(__match_str, "bool")) goto __match_6_2;
+        break;
+      case 1349183411u:
+        if (!strcmp(__match_str, "break")) goto __match_6_3;
+        break;
+      case 3477080843u:
+        if (!strcmp(__match_str, "char")) goto __match_6_4;
+        break;
+      case 2245205078u:
+        if (!strcmp(__match_str, "const")) goto __match_6_5;
+        break;
+      case 3663126513u:
+        if (!strcmp(__match_str, "continue")) goto __match_6_6;
+        break;
+      case 832636142u:
+        if (!strcmp(__match_str, "def")) goto __match_6_7;
+        break;
+      case 2838665391u:
+        if (!strcmp(__match_str, "defer")) goto __match_6_8;
+        break;
+      case 642373404u:
+        if (!strcmp(__match_str, "else")) goto __match_6_9;
+        break;
+      case 1633607337u:
+        if (!strcmp(__match_str, "enum")) goto __match_6_10;
+        break;
+      case 594816953u:
+        if (!strcmp(__match_str, "extern")) goto __match_6_11;
+        break;
+      case 4275523303u:
+        if (!strcmp(__match_str, "false")) goto __match_6_12;
+        break;
+      case 3121374858u:
+        if (!strcmp(__match_str, "for")) goto __match_6_13;
+        break;
+      case 2551052472u:
+        if (!strcmp(__match_str, "if")) goto __match_6_14;
+        break;
+      case 950579197u:
+        if (!strcmp(__match_str, "let")) goto __match_6_15;
+        break;
+    }
+    goto __match_6_default;
+    __match_6_0: {
+      __yield_0 = 0;
+} goto __match_6_end;
+    __match_6_1: {
+      __yield_0 = 1;
+} goto __match_6_end;
+    __match_6_2: {
+      __yield_0 = 2;
+} goto __match_6_end;
+    __match_6_3: {
+      __yield_0 = 3;
+} goto __match_6_end;
+    __match_6_4: {
+      __yield_0 = 4;
+} goto __match_6_end;
+    __match_6_5: {
+      __yield_0 = 5;
+} goto __match_6_end;
+    __match_6_6: {
+      __yield_0 = 6;
+} goto __match_6_end;
+    __match_6_7: {
+      __yield_0 = 7;
+} goto __match_6_end;
+    __match_6_8: {
+      __yield_0 = 8;
+} goto __match_6_end;
+    __match_6_9: {
+      __yield_0 = 9;
+} goto __match_6_end;
+    __match_6_10: {
+      __yield_0 = 10;
+} goto __match_6_end;
+    __match_6_11: {
+      __yield_0 = 11;
+} goto __match_6_end;
+    __match_6_12: {
+      __yield_0 = 12;
+} goto __match_6_end;
+    __match_6_13: {
+      __yield_0 = 13;
+} goto __match_6_end;
+    __match_6_14: {
+      __yield_0 = 14;
+} goto __match_6_end;
+    __match_6_15: {
+      __yield_0 = 15;
+} goto __match_6_end;
+    __match_6_default: {
+      __yield_0 = (-1);
+}
+    __match_6_end:;
+  }
+;__yield_0; });
+}
+
+i32 match_32(char *s) {
+  return ({ i32 __yield_0;
+  {
+    char *__match_str = s;
+    switch (aecor_hash_str(__match_str, 2166136261u)) {
+      case 1305964296u:
+        if (!strcmp(__match_str, "and")) goto __match_7_0;
+        break;
+      case 106731536u:
+        if (!strcmp(__match_str, "as")) goto __match_7_1;
+        break;
+      case 2869110635u:
+        if (!strcmp(__match_str, "bool")) goto __match_7_2;
+        break;
+      case 1349183411u:
+        if (!strcmp(__match_str, "break")) goto __match_7_3;
+        break;
+      case 3477080843u:
+        if (!strcmp(__match_str, "char")) goto __match_7_4;
+        break;
+      case 2245205078u:
+        if (!strcmp(__match_str, "const")) goto __match_7_5;
+        break;
+      case 3663126513u:
+        if (!strcmp(__match_str, "continue")) goto __match_7_6;
+        break;
+      case 832636142u:
+        if (!strcmp(__match_str, "def")) goto __match_7_7;
+        break;
+      case 2838665391u:
+        if (!strcmp(__match_str, "defer")) goto __match_7_8;
+        break;
+      case 642373404u:
+        if (!strcmp(__match_str, "else")) goto __match_7_9;
+        break;
+      case 1633607337u:
+        if (!strcmp(__match_str, "enum")) goto __match_7_10;
+        break;
+      case 594816953u:
+        if (!strcmp(__match_str, "extern")) goto __match_7_11;
+        break;
+      case 4275523303u:
+        if (!strcmp(__match_str, "false")) goto __match_7_12;
+        break;
+      case 3121374858u:
+        if (!strcmp(__match_str, "for")) goto __match_7_13;
+        break;
+      case 2551052472u:
+        if (!strcmp(__match_str, "if")) goto __match_7_14;
+        break;
+      case 950579197u:
+        if (!strcmp(__match_str, "let")) goto __match_7_15;
+        break;
+      case 2717393236u:
+        if (!strcmp(__match_str, "match")) goto __match_7_16;
+        break;
+      case 2827039351u:
+        if (!strcmp(__match_str, "null")) goto __match_7_17;
+        break;
+      case 1957039169u:
+        if (!strcmp(__match_str, "not")) goto __match_7_18;
+        break;
+      case 2654982702u:
+        if (!strcmp(__match_str, "or")) goto __match_7_19;
+        break;
+      case 4108485794u:
+        if (!strcmp(__match_str, "return")) goto __match_7_20;
+        break;
+      case 2850059673u:
+        if (!strcmp(__match_str, "sizeof")) goto __match_7_21;
+        break;
+      case 930201698u:
+        if (!strcmp(__match_str, "string")) goto __match_7_22;
+        break;
+      case 289050604u:
+        if (!strcmp(__match_str, "struct")) goto __match_7_23;
+        break;
+      case 1715307617u:
+        if (!strcmp(__match_str, "true")) goto __match_7_24;
+        break;
+      case 3201516176u:
+        if (!strcmp(__match_str, "then")) goto __match_7_25;
+        break;
+      case 3495413904u:
+        if (!strcmp(__match_str, "union")) goto __match_7_26;
+        break;
+      case 621625292u:
+        if (!strcmp(__match_str, "use")) goto __match_7_27;
+        break;
+      case 2454924575u:
+        if (!strcmp(__match_str, "void")) goto __match_7_28;
+        break;
+      case 317341496u:
+        if (!strcmp(__match_str, "yield")) goto __match_7_29;
+        break;
+      case 4040919573u:
+        if (!strcmp(__match_str, "while")) goto __match_7_30;
+        break;
+      case 4025494924u:
+        if (!strcmp(__match_str, "untyped_ptr")) goto __match_7_31;
+        break;
+    }
+    goto __match_7_default;
+    __match_7_0: {
+      __yield_0 = 0;
+} goto __match_7_end;
+    __match_7_1: {
+      __yield_0 = 1;
+} goto __match_7_end;
+    __match_7_2: {
+      __yield_0 = 2;
+} goto __match_7_end;
+    __match_7_3: {
+      __yield_0 = 3;
+} goto __match_7_end;
+    __match_7_4: {
+      __yield_0 = 4;
+} goto __match_7_end;
+    __match_7_5: {
+      __yield_0 = 5;
+} goto __match_7_end;
+    __match_7_6: {
+      __yield_0 = 6;
+} goto __match_7_end;
+    __match_7_7: {
+      __yield_0 = 7;
+} goto __match_7_end;
+    __match_7_8: {
+      __yield_0 = 8;
+} goto __match_7_end;
+    __match_7_9: {
+      __yield_0 = 9;
+} goto __match_7_end;
+    __match_7_10: {
+      __yield_0 = 10;
+} goto __match_7_end;
+    __match_7_11: {
+      __yield_0 = 11;
+} goto __match_7_end;
+    __match_7_12: {
+      __yield_0 = 12;
+} goto __match_7_end;
+    __match_7_13: {
+      __yield_0 = 13;
+} goto __match_7_end;
+    __match_7_14: {
+      __yield_0 = 14;
+} goto __match_7_end;
+    __match_7_15: {
+      __yield_0 = 15;
+} goto __match_7_end;
+    __match_7_16: {
+      __yield_0 = 16;
+} goto __match_7_end;
+    __match_7_17: {
+      __yield_0 = 17;
+} goto __match_7_end;
+    __match_7_18: {
+      __yield_0 = 18;
+} goto __match_7_end;
+    __match_7_19: {
+      __yield_0 = 19;
+} goto __match_7_end;
+    __match_7_20: {
+      __yield_0 = 20;
+} goto __match_7_end;
+    __match_7_21: {
+      __yield_0 = 21;
+} goto __match_7_end;
+    __match_7_22: {
+      __yield_0 = 22;
+} goto __match_7_end;
+    __match_7_23: {
+      __yield_0 = 23;
+} goto __match_7_end;
+    __match_7_24: {
+      __yield_0 = 24;
+} goto __match_7_end;
+    __match_7_25: {
+      __yield_0 = 25;
+} goto __match_7_end;
+    __match_7_26: {
+      __yield_0 = 26;
+} goto __match_7_end;
+    __match_7_27: {
+      __yield_0 = 27;
+} goto __match_7_end;
+    __match_7_28: {
+      __yield_0 = 28;
+} goto __match_7_end;
+    __match_7_29: {
+      __yield_0 = 29;
+} goto __match_7_end;
+    __match_7_30: {
+      __yield_0 = 30;
+} goto __match_7_end;
+    __match_7_31: {
+      __yield_0 = 31;
+} goto __match_7_end;
+    __match_7_default: {
+      __yield_0 = (-1);
+}
+    __match_7_end:;
+  }
+;__yield_0; });
+}
+
+char **make_inputs(i32 n) {
+  char **inputs = ((char **)calloc((2 * n), sizeof(char *)));
+  for (i32 i = 0; (i < n); i += 1) {
+    inputs[(2 * i)] = all_words(i);
+    inputs[((2 * i) + 1)] = format_string("%s_", all_words(i));
+  } 
+  return inputs;
+}
+
+char *all_words(i32 i) {
+  return ({ char *__yield_0;
+  switch (i) {
+    case 0: {
+      __yield_0 = "and";
+} break;
+    case 1: {
+      __yield_0 = "as";
+} break;
+    case 2: {
+      __yield_0 = "bool";
+} break;
+    case 3: {
+      __yield_0 = "break";
+} break;
+    case 4: {
+      __yield_0 = "char";
+} break;
+    case 5: {
+      __yield_0 = "const";
+} break;
+    case 6: {
+      __yield_0 = "continue";
+} break;
+    case 7: {
+      __yield_0 = "def";
+} break;
+    case 8: {
+      __yield_0 = "defer";
+} break;
+    case 9: {
+      __yield_0 = "else";
+} break;
+    case 10: {
+      __yield_0 = "enum";
+} break;
+    case 11: {
+      __yield_0 = "extern";
+} break;
+    case 12: {
+      __yield_0 = "false";
+} break;
+    case 13: {
+      __yield_0 = "for";
+} break;
+    case 14: {
+      __yield_0 = "if";
+} break;
+    case 15: {
+      __yield_0 = "let";
+} break;
+    case 16: {
+      __yield_0 = "match";
+} break;
+    case 17: {
+      __yield_0 = "null";
+} break;
+    case 18: {
+      __yield_0 = "not";
+} break;
+    case 19: {
+      __yield_0 = "or";
+} break;
+    case 20: {
+      __yield_0 = "return";
+} break;
+    case 21: {
+      __yield_0 = "sizeof";
+} break;
+    case 22: {
+      __yield_0 = "string";
+} break;
+    case 23: {
+      __yield_0 = "struct";
+} break;
+    case 24: {
+      __yield_0 = "true";
+} break;
+    case 25: {
+      __yield_0 = "then";
+} break;
+    case 26: {
+      __yield_0 = "union";
+} break;
+    case 27: {
+      __yield_0 = "use";
+} break;
+    case 28: {
+      __yield_0 = "void";
+} break;
+    case 29: {
+      __yield_0 = "yield";
+} break;
+    case 30: {
+      __yield_0 = "while";
+} break;
+    case 31: {
+      __yield_0 = "untyped_ptr";
+} break;
+    default: {
+      __yield_0 = "";
+} break;
+  }
+;__yield_0; });
+}
+
+void run(i32 n, i32 (*f)(char *)) {
+  i32 iters = 20000000;
+  char **inputs = make_inputs(n);
+  i32 mask = (2 * n);
+  f64 start = time_now();
+  for (i32 i = 0; (i < iters); i += 1) {
+    bench_sink += ((u64)f(inputs[(i % mask)]));
+  } 
+  bench_report(format_string("match on %d strings", n), (time_now() - start), iters);
+}
+
+i32 main(void) {
+  run(2, match_2);
+  run(3, match_3);
+  run(4, match_4);
+  run(6, match_6);
+  run(8, match_8);
+  run(12, match_12);
+  run(16, match_16);
+  run(32, match_32);
+}
+
@@ -0,0 +1,6389 @@
+#include "stdio.h"
+#include "stdlib.h"
+#include "stdbool.h"
+#include "stdint.h"
+#include "string.h"
+#include "errno.h"
+#include "ctype.h"
+#include "time.h"
+#include "math.h"
+#include "libgen.h"
+
+/***************** embed './lib/prelude.h' *****************/
+#include "stdarg.h"
+
+typedef int8_t i8;
+typedef int16_t i16;
+typedef int32_t i32;
+typedef int64_t i64;
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+
+typedef float f32;
+typedef double f64;
+
+// SIMD vector types, such as `f32x4`, using GCC's vector extensions
+#define AECOR_SIMD_TYPE(T, lanes) \
+  typedef T aecor_##T##x##lanes __attribute__((vector_size(sizeof(T) * lanes)));
+#define AECOR_SIMD_TYPES(T) \
+  AECOR_SIMD_TYPE(T, 2) AECOR_SIMD_TYPE(T, 4) AECOR_SIMD_TYPE(T, 8) \
+  AECOR_SIMD_TYPE(T, 16) AECOR_SIMD_TYPE(T, 32) AECOR_SIMD_TYPE(T, 64)
+
+AECOR_SIMD_TYPES(i8) AECOR_SIMD_TYPES(i16) AECOR_SIMD_TYPES(i32) AECOR_SIMD_TYPES(i64)
+AECOR_SIMD_TYPES(u8) AECOR_SIMD_TYPES(u16) AECOR_SIMD_TYPES(u32) AECOR_SIMD_TYPES(u64)
+AECOR_SIMD_TYPES(f32) AECOR_SIMD_TYPES(f64)
+
+// Formats into `stack` if the result fits in `capacity` bytes, otherwise
+// returns a new heap-allocated string that the caller needs to free.
+char* format_string_into(char* stack, int capacity, const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  int size = vsnprintf(stack, capacity, format, args);
+  va_end(args);
+  if (size < capacity) return stack;
+  char* s = malloc(size + 1);
+  va_start(args, format);
+  vsnprintf(s, size + 1, format, args);
+  va_end(args);
+  return s;
+}
+
+// Formats into a stack buffer first since most formatted strings are short,
+// which saves a separate pass just to compute the size.
+static char* aecor_vformat(void* (*alloc)(size_t), const char* format, va_list args) {
+  char stack[256];
+  va_list copy;
+  va_copy(copy, args);
+  int size = vsnprintf(stack, sizeof(stack), format, copy);
+  va_end(copy);
+  char* s = alloc(size + 1);
+  if (size < (int)sizeof(stack)) {
+    memcpy(s, stack, size + 1);
+  } else {
+    vsnprintf(s, size + 1, format, args);
+  }
+  return s;
+}
+
+char* format_string(const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  char* s = aecor_vformat(malloc, format, args);
+  va_end(args);
+  return s;
+}
+
+// Scratch arena backing `scratch { ... }` blocks. Memory is handed out from a
+// list of chunks with a bump pointer, and everything allocated inside a block
+// is released at once when it ends by restoring the position saved on entry.
+// Chunks past the current one are kept around to be reused.
+#define AECOR_SCRATCH_CHUNK_SIZE (64 * 1024)
+
+typedef struct aecor_scratch_chunk {
+  struct aecor_scratch_chunk* next;
+  size_t capacity;
+  size_t used;
+  char data[];
+} aecor_scratch_chunk;
+
+typedef struct {
+  aecor_scratch_chunk* chunk;
+  size_t used;
+} aecor_scratch_mark;
+
+static aecor_scratch_chunk* aecor_scratch_first = NULL;
+static aecor_scratch_chunk* aecor_scratch_current = NULL;
+
+void* scratch_alloc(size_t size) {
+  size = (size + 15) & ~(size_t)15;
+  aecor_scratch_chunk* chunk = aecor_scratch_current;
+  if (!chunk || chunk->used + size > chunk->capacity) {
+    aecor_scratch_chunk** link = chunk ? &chunk->next : &aecor_scratch_first;
+    if (!*link || (*link)->capacity < size) {
+      size_t capacity = size > AECOR_SCRATCH_CHUNK_SIZE ? size : AECOR_SCRATCH_CHUNK_SIZE;
+      aecor_scratch_chunk* fresh = malloc(sizeof(aecor_scratch_chunk) + capacity);
+      if (!fresh) {
+        printf("Out of memory!\n");
+        exit(1);
+      }
+      fresh->capacity = capacity;
+      fresh->next = *link;
+      *link = fresh;
+    }
+    chunk = *link;
+    chunk->used = 0;
+    aecor_scratch_current = chunk;
+  }
+  void* ptr = chunk->data + chunk->used;
+  chunk->used += size;
+  return ptr;
+}
+
+aecor_scratch_mark aecor_scratch_save() {
+  aecor_scratch_chunk* chunk = aecor_scratch_current;
+  return (aecor_scratch_mark){chunk, chunk ? chunk->used : 0};
+}
+
+void aecor_scratch_restore(aecor_scratch_mark* mark) {
+  aecor_scratch_current = mark->chunk;
+  if (mark->chunk) mark->chunk->used = mark->used;
+}
+
+char* format_string_scratch(const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  char* s = aecor_vformat(scratch_alloc, format, args);
+  va_end(args);
+  return s;
+}
+
+// Output buffer for `print` / `println` when compiling with `-b`. Writes are
+// collected here and handed to stdio in large chunks, which avoids paying
+// for `printf`'s locking and format parsing on every call.
+#define AECOR_STDOUT_BUFFER_SIZE (64 * 1024)
+
+static char aecor_stdout_buffer[AECOR_STDOUT_BUFFER_SIZE];
+static size_t aecor_stdout_size = 0;
+
+void aecor_stdout_flush(void) {
+  fwrite(aecor_stdout_buffer, 1, aecor_stdout_size, stdout);
+  fflush(stdout);
+  aecor_stdout_size = 0;
+}
+
+__attribute__((constructor)) static void aecor_stdout_init(void) {
+  atexit(aecor_stdout_flush);
+}
+
+static inline void aecor_stdout_write(const char* s, size_t len) {
+  if (aecor_stdout_size + len > AECOR_STDOUT_BUFFER_SIZE) {
+    aecor_stdout_flush();
+    if (len > AECOR_STDOUT_BUFFER_SIZE) {
+      fwrite(s, 1, len, stdout);
+      return;
+    }
+  }
+  memcpy(aecor_stdout_buffer + aecor_stdout_size, s, len);
+  aecor_stdout_size += len;
+}
+
+void aecor_stdout_puts(const char* s) {
+  aecor_stdout_write(s, strlen(s));
+}
+
+void aecor_stdout_putc(char c) {
+  if (aecor_stdout_size == AECOR_STDOUT_BUFFER_SIZE) aecor_stdout_flush();
+  aecor_stdout_buffer[aecor_stdout_size++] = c;
+}
+
+void aecor_stdout_put_u64(u64 value) {
+  char digits[20];
+  int len = 0;
+  do {
+    digits[sizeof(digits) - ++len] = '0' + value % 10;
+    value /= 10;
+  } while (value);
+  aecor_stdout_write(digits + sizeof(digits) - len, len);
+}
+
+void aecor_stdout_put_i64(i64 value) {
+  if (value < 0) {
+    aecor_stdout_putc('-');
+    aecor_stdout_put_u64(-(u64)value);
+  } else {
+    aecor_stdout_put_u64(value);
+  }
+}
+
+// Used for anything that isn't a format string literal, as well as the
+// arguments with explicit format specs.
+int aecor_stdout_printf(const char* format, ...) {
+  char stack[256];
+  va_list args;
+  va_start(args, format);
+  int size = vsnprintf(stack, sizeof(stack), format, args);
+  va_end(args);
+  if (size < (int)sizeof(stack)) {
+    aecor_stdout_write(stack, size);
+  } else {
+    char* s = malloc(size + 1);
+    va_start(args, format);
+    vsnprintf(s, size + 1, format, args);
+    va_end(args);
+    aecor_stdout_write(s, size);
+    free(s);
+  }
+  return size;
+}
+
+void aecor_stdout_put_f64(f64 value) {
+  aecor_stdout_printf("%f", value);
+}
+
+void aecor_stdout_put_ptr(void* value) {
+  aecor_stdout_printf("%p", value);
+}
+
+// FNV-1a with a murmur3 finalizer, used for hashed dispatch on strings.
+// Must be kept in sync with `hash_string` in `compiler/utils.ae`.
+u32 aecor_hash_str(const char* s, u32 seed) {
+  u32 hash = seed;
+  for (; *s; s++) {
+    hash = (hash ^ (u8)*s) * 16777619u;
+  }
+  hash = (hash ^ (hash >> 16)) * 0x85ebca6bu;
+  hash = (hash ^ (hash >> 13)) * 0xc2b2ae35u;
+  return hash ^ (hash >> 16);
+}
+
+
+/* constants */
+
+/* struct declarations */
+typedef struct Buffer Buffer;
+typedef struct Vector Vector;
+typedef struct MapNode MapNode;
+typedef struct Map Map;
+typedef struct MapIterator MapIterator;
+typedef struct Location Location;
+typedef struct Span Span;
+typedef enum TokenType TokenType;
+typedef struct Token Token;
+typedef enum BaseType BaseType;
+typedef struct Type Type;
+typedef enum ErrorType ErrorType;
+typedef struct Error Error;
+typedef enum MessageType MessageType;
+typedef enum ASTType ASTType;
+typedef struct Variable Variable;
+typedef struct Function Function;
+typedef struct Structure Structure;
+typedef struct Program Program;
+typedef struct Block Block;
+typedef struct Binary Binary;
+typedef struct Identifier Identifier;
+typedef struct FormatString FormatString;
+typedef struct Argument Argument;
+typedef struct FuncCall FuncCall;
+typedef struct Constructor Constructor;
+typedef struct Member Member;
+typedef struct EnumValue EnumValue;
+typedef struct VarDeclaration VarDeclaration;
+typedef struct IfStatement IfStatement;
+typedef struct Loop Loop;
+typedef struct Cast Cast;
+typedef struct MatchCase MatchCase;
+typedef struct Match Match;
+typedef struct NumLiteral NumLiteral;
+typedef union ASTUnion ASTUnion;
+typedef struct AST AST;
+typedef struct Lexer Lexer;
+typedef struct ParserContext ParserContext;
+typedef struct Template Template;
+typedef struct Instance Instance;
+typedef struct Parser Parser;
+typedef struct TypeChecker TypeChecker;
+
+struct Buffer {
+  u8 *data;
+  i32 size;
+  i32 capacity;
+};
+
+struct Vector {
+  i32 size;
+  i32 capacity;
+  void **data;
+};
+
+struct MapNode {
+  char *key;
+  void *value;
+  MapNode *next;
+};
+
+struct Map {
+  MapNode **buckets;
+  i32 num_items;
+  i32 num_buckets;
+  i32 num_collisions;
+};
+
+struct MapIterator {
+  i32 idx;
+  MapNode *cur;
+  Map *map;
+};
+
+struct Location {
+  char *filename;
+  i32 line;
+  i32 col;
+  i32 index;
+};
+
+struct Span {
+  Location start;
+  Location end;
+};
+
+enum TokenType {
+  TokenType__And,
+  TokenType__As,
+  TokenType__Bool,
+  TokenType__Break,
+  TokenType__Char,
+  TokenType__Const,
+  TokenType__Continue,
+  TokenType__Def,
+  TokenType__Defer,
+  TokenType__Else,
+  TokenType__Enum,
+  TokenType__Extern,
+  TokenType__False,
+  TokenType__F32,
+  TokenType__F64,
+  TokenType__For,
+  TokenType__Fn,
+  TokenType__I8,
+  TokenType__I16,
+  TokenType__I32,
+  TokenType__I64,
+  TokenType__If,
+  TokenType__Let,
+  TokenType__Match,
+  TokenType__Null,
+  TokenType__Not,
+  TokenType__Or,
+  TokenType__Return,
+  TokenType__Scratch,
+  TokenType__SizeOf,
+  TokenType__String,
+  TokenType__Struct,
+  TokenType__True,
+  TokenType__Then,
+  TokenType__U8,
+  TokenType__U16,
+  TokenType__U32,
+  TokenType__U64,
+  TokenType__UntypedPtr,
+  TokenType__Union,
+  TokenType__Use,
+  TokenType__Void,
+  TokenType__Yield,
+  TokenType__While,
+  TokenType__AtSign,
+  TokenType__Ampersand,
+  TokenType__Backtick,
+  TokenType__Caret,
+  TokenType__CharLiteral,
+  TokenType__CloseCurly,
+  TokenType__CloseParen,
+  TokenType__CloseSquare,
+  TokenType__Colon,
+  TokenType__ColonColon,
+  TokenType__Comma,
+  TokenType__Dot,
+  TokenType__EOF,
+  TokenType__Equals,
+  TokenType__EqualEquals,
+  TokenType__Exclamation,
+  TokenType__FatArrow,
+  TokenType__FloatLiteral,
+  TokenType__FormatStringLiteral,
+  TokenType__GreaterThan,
+  TokenType__GreaterThanGreaterThan,
+  TokenType__GreaterThanEquals,
+  TokenType__Identifier,
+  TokenType__IntLiteral,
+  TokenType__LessThan,
+  TokenType__LessThanLessThan,
+  TokenType__LessThanEquals,
+  TokenType__Line,
+  TokenType__Minus,
+  TokenType__MinusEquals,
+  TokenType__NotEquals,
+  TokenType__Newline,
+  TokenType__OpenCurly,
+  TokenType__OpenParen,
+  TokenType__OpenSquare,
+  TokenType__Percent,
+  TokenType__Plus,
+  TokenType__PlusEquals,
+  TokenType__Question,
+  TokenType__Semicolon,
+  TokenType__Slash,
+  TokenType__SlashEquals,
+  TokenType__Star,
+  TokenType__StarEquals,
+  TokenType__StringLiteral,
+  TokenType__Tilde,
+};
+
+static char *__TokenType_names[] = {"And", "As", "Bool", "Break", "Char", "Const", "Continue", "Def", "Defer", "Else", "Enum", "Extern", "False", "F32", "F64", "For", "Fn", "I8", "I16", "I32", "I64", "If", "Let", "Match", "Null", "Not", "Or", "Return", "Scratch", "SizeOf", "String", "Struct", "True", "Then", "U8", "U16", "U32", "U64", "UntypedPtr", "Union", "Use", "Void", "Yield", "While", "AtSign", "Ampersand", "Backtick", "Caret", "CharLiteral", "CloseCurly", "CloseParen", "CloseSquare", "Colon", "ColonColon", "Comma", "Dot", "EOF", "Equals", "EqualEquals", "Exclamation", "FatArrow", "FloatLiteral", "FormatStringLiteral", "GreaterThan", "GreaterThanGreaterThan", "GreaterThanEquals", "Identifier", "IntLiteral", "LessThan", "LessThanLessThan", "LessThanEquals", "Line", "Minus", "MinusEquals", "NotEquals", "Newline", "OpenCurly", "OpenParen", "OpenSquare", "Percent", "Plus", "PlusEquals", "Question", "Semicolon", "Slash", "SlashEquals", "Star", "StarEquals", "StringLiteral", "Tilde"};
+static TokenType __TokenType_values[] = {TokenType__And, TokenType__As, TokenType__Bool, TokenType__Break, TokenType__Char, TokenType__Const, TokenType__Continue, TokenType__Def, TokenType__Defer, TokenType__Else, TokenType__Enum, TokenType__Extern, TokenType__False, TokenType__F32, TokenType__F64, TokenType__For, TokenType__Fn, TokenType__I8, TokenType__I16, TokenType__I32, TokenType__I64, TokenType__If, TokenType__Let, TokenType__Match, TokenType__Null, TokenType__Not, TokenType__Or, TokenType__Return, TokenType__Scratch, TokenType__SizeOf, TokenType__String, TokenType__Struct, TokenType__True, TokenType__Then, TokenType__U8, TokenType__U16, TokenType__U32, TokenType__U64, TokenType__UntypedPtr, TokenType__Union, TokenType__Use, TokenType__Void, TokenType__Yield, TokenType__While, TokenType__AtSign, TokenType__Ampersand, TokenType__Backtick, TokenType__Caret, TokenType__CharLiteral, TokenType__CloseCurly, TokenType__CloseParen, TokenType__CloseSquare, TokenType__Colon, TokenType__ColonColon, TokenType__Comma, TokenType__Dot, TokenType__EOF, TokenType__Equals, TokenType__EqualEquals, TokenType__Exclamation, TokenType__FatArrow, TokenType__FloatLiteral, TokenType__FormatStringLiteral, TokenType__GreaterThan, TokenType__GreaterThanGreaterThan, TokenType__GreaterThanEquals, TokenType__Identifier, TokenType__IntLiteral, TokenType__LessThan, TokenType__LessThanLessThan, TokenType__LessThanEquals, TokenType__Line, TokenType__Minus, TokenType__MinusEquals, TokenType__NotEquals, TokenType__Newline, TokenType__OpenCurly, TokenType__OpenParen, TokenType__OpenSquare, TokenType__Percent, TokenType__Plus, TokenType__PlusEquals, TokenType__Question, TokenType__Semicolon, TokenType__Slash, TokenType__SlashEquals, TokenType__Star, TokenType__StarEquals, TokenType__StringLiteral, TokenType__Tilde};
+
+static char *TokenType__dbg(TokenType this) {
+  if ((u32)this < 90u) return __TokenType_names[this];
+  return "<unknown>";
+}
+
+static i32 __TokenType_displace[] = {-28, -66, 0, -32, 1, 0, 0, -29, -60, 0, -15, 0, -18, 0, 0, 1, 0, -51, 0, -53, -47, 2, 1, -2, 0, 1, -24, -19, -9, 0, 0, -12, 0, -34, 0, -62, 0, -50, 0, 0, 0, -49, 0, 0, 0, 0, -17, 0, -5, 0, 1, 0, 1, 0, 0, 0, 1, 0, 0, -31, 2, -38, 3, 0, -8, 0, -10, -64, -61, -30, -3, -57, -39, 0, -43, 0, -63, 6, 0, 0, -41, 0, -1, -54, 0, 0, 0, 0, -48, 0, 0, -40, 0, 0, -11, 0, -44, -20, -58, 1, 0, 1, 0, 0, 0, -7, 0, 1, 0, 1, -23, 0, -42, 0, 0, 0, -52, -6, 0, 2, 1, -26, -21, -59, 0, -37, 0, 0};
+static i32 __TokenType_slots[] = {1, 2, 5, 21, 7, 8, 12, 14, 16, 19, 20, 24, 35, 15, 25, 11, 30, 32, 33, 36, 37, 74, 38, 39, 23, 42, 41, 43, 44, 48, 49, 51, 18, 53, 31, 29, 54, 55, 57, 58, 59, 63, 65, 66, 28, 22, 67, 68, 70, 71, 72, 73, 75, 77, 4, 62, 78, 80, 83, 84, 85, 86, 87, 88, 9, 89, 34, 46, -1, -1, 76, -1, -1, 60, -1, 17, -1, -1, 82, 52, 10, 69, -1, 56, 27, -1, 13, -1, -1, 50, -1, -1, -1, -1, -1, 47, 3, -1, 81, -1, 79, -1, -1, -1, -1, -1, 26, -1, -1, -1, 64, 45, -1, -1, -1, -1, 6, -1, -1, -1, -1, 61, -1, 0, 40, -1, -1, -1};
+
+static TokenType *TokenType__from_str(char *s) {
+  i32 d = __TokenType_displace[aecor_hash_str(s, 0) & 127u];
+  i32 i = __TokenType_slots[d < 0 ? -d - 1 : aecor_hash_str(s, d) & 127u];
+  if (i < 0 || strcmp(s, __TokenType_names[i])) return NULL;
+  return &__TokenType_values[i];
+}
+
+struct Token {
+  TokenType type;
+  Span span;
+  char *text;
+  Token *suffix;
+  bool seen_newline;
+};
+
+enum BaseType {
+  BaseType__Char,
+  BaseType__Bool,
+  BaseType__Void,
+  BaseType__I8,
+  BaseType__I16,
+  BaseType__I32,
+  BaseType__I64,
+  BaseType__U8,
+  BaseType__U16,
+  BaseType__U32,
+  BaseType__U64,
+  BaseType__F32,
+  BaseType__F64,
+  BaseType__Pointer,
+  BaseType__Structure,
+  BaseType__Function,
+  BaseType__Method,
+  BaseType__Array,
+  BaseType__Simd,
+  BaseType__Error,
+};
+
+static char *__BaseType_names[] = {"Char", "Bool", "Void", "I8", "I16", "I32", "I64", "U8", "U16", "U32", "U64", "F32", "F64", "Pointer", "Structure", "Function", "Method", "Array", "Simd", "Error"};
+static BaseType __BaseType_values[] = {BaseType__Char, BaseType__Bool, BaseType__Void, BaseType__I8, BaseType__I16, BaseType__I32, BaseType__I64, BaseType__U8, BaseType__U16, BaseType__U32, BaseType__U64, BaseType__F32, BaseType__F64, BaseType__Pointer, BaseType__Structure, BaseType__Function, BaseType__Method, BaseType__Array, BaseType__Simd, BaseType__Error};
+
+static char *BaseType__dbg(BaseType this) {
+  if ((u32)this < 20u) return __BaseType_names[this];
+  return "<unknown>";
+}
+
+static i32 __BaseType_displace[] = {-14, -8, -4, 0, -11, -3, 0, 0, 0, 0, 0, -17, 0, 1, 0, 1, 0, 0, -16, 0, 0, 0, 1, -2, 0, 0, -9, -15, -7, 0, -5, 0};
+static i32 __BaseType_slots[] = {4, 1, 2, 5, 6, 0, 7, 9, 10, 15, 11, 3, 8, 12, 13, 17, 19, -1, -1, 18, -1, -1, -1, -1, 16, -1, -1, -1, 14, -1, -1, -1};
+
+static BaseType *BaseType__from_str(char *s) {
+  i32 d = __BaseType_displace[aecor_hash_str(s, 0) & 31u];
+  i32 i = __BaseType_slots[d < 0 ? -d - 1 : aecor_hash_str(s, d) & 31u];
+  if (i < 0 || strcmp(s, __BaseType_names[i])) return NULL;
+  return &__BaseType_values[i];
+}
+
+struct Type {
+  BaseType base;
+  Type *ptr;
+  char *name;
+  Span span;
+  AST *size_expr;
+  Structure *struct_def;
+  Function *func_def;
+  Type *return_type;
+  Vector *params;
+  i32 lanes;
+};
+
+enum ErrorType {
+  ErrorType__Standard,
+  ErrorType__WithNote,
+  ErrorType__WithHint,
+};
+
+static char *__ErrorType_names[] = {"Standard", "WithNote", "WithHint"};
+static ErrorType __ErrorType_values[] = {ErrorType__Standard, ErrorType__WithNote, ErrorType__WithHint};
+
+static char *ErrorType__dbg(ErrorType this) {
+  if ((u32)this < 3u) return __ErrorType_names[this];
+  return "<unknown>";
+}
+
+static i32 __ErrorType_displace[] = {-1, 0, 0, 2};
+static i32 __ErrorType_slots[] = {0, -1, 2, 1};
+
+static ErrorType *ErrorType__from_str(char *s) {
+  i32 d = __ErrorType_displace[aecor_hash_str(s, 0) & 3u];
+  i32 i = __ErrorType_slots[d < 0 ? -d - 1 : aecor_hash_str(s, d) & 3u];
+  if (i < 0 || strcmp(s, __ErrorType_names[i])) return NULL;
+  return &__ErrorType_values[i];
+}
+
+struct Error {
+  ErrorType type;
+  char *msg1;
+  Span span1;
+  char *msg2;
+  Span span2;
+};
+
+enum MessageType {
+  MessageType__Error,
+  MessageType__Warning,
+  MessageType__Note,
+};
+
+static char *__MessageType_names[] = {"Error", "Warning", "Note"};
+static MessageType __MessageType_values[] = {MessageType__Error, MessageType__Warning, MessageType__Note};
+
+static char *MessageType__dbg(MessageType this) {
+  if ((u32)this < 3u) return __MessageType_names[this];
+  return "<unknown>";
+}
+
+static i32 __MessageType_displace[] = {0, 0, 0, 1};
+static i32 __MessageType_slots[] = {0, 2, -1, 1};
+
+static MessageType *MessageType__from_str(char *s) {
+  i32 d = __MessageType_displace[aecor_hash_str(s, 0) & 3u];
+  i32 i = __MessageType_slots[d < 0 ? -d - 1 : aecor_hash_str(s, d) & 3u];
+  if (i < 0 || strcmp(s, __MessageType_names[i])) return NULL;
+  return &__MessageType_values[i];
+}
+
+enum ASTType {
+  ASTType__Assignment,
+  ASTType__Address,
+  ASTType__And,
+  ASTType__Block,
+  ASTType__BoolLiteral,
+  ASTType__BitwiseAnd,
+  ASTType__BitwiseNot,
+  ASTType__BitwiseOr,
+  ASTType__BitwiseXor,
+  ASTType__Break,
+  ASTType__Call,
+  ASTType__Cast,
+  ASTType__CharLiteral,
+  ASTType__Constant,
+  ASTType__Constructor,
+  ASTType__Continue,
+  ASTType__Defer,
+  ASTType__Dereference,
+  ASTType__Divide,
+  ASTType__DivideEquals,
+  ASTType__EnumValue,
+  ASTType__Equals,
+  ASTType__Error,
+  ASTType__FloatLiteral,
+  ASTType__FormatStringLiteral,
+  ASTType__For,
+  ASTType__GreaterThan,
+  ASTType__GreaterThanEquals,
+  ASTType__If,
+  ASTType__Identifier,
+  ASTType__Index,
+  ASTType__IntLiteral,
+  ASTType__IsNotNull,
+  ASTType__LeftShift,
+  ASTType__LessThan,
+  ASTType__LessThanEquals,
+  ASTType__Match,
+  ASTType__Member,
+  ASTType__Minus,
+  ASTType__MinusEquals,
+  ASTType__Modulus,
+  ASTType__Multiply,
+  ASTType__MultiplyEquals,
+  ASTType__Not,
+  ASTType__NotEquals,
+  ASTType__Null,
+  ASTType__Or,
+  ASTType__Plus,
+  ASTType__PlusEquals,
+  ASTType__Return,
+  ASTType__RightShift,
+  ASTType__SizeOf,
+  ASTType__ScopeLookup,
+  ASTType__Scratch,
+  ASTType__StringLiteral,
+  ASTType__UnaryMinus,
+  ASTType__VarDeclaration,
+  ASTType__Yield,
+  ASTType__While,
+};
+
+static char *__ASTType_names[] = {"Assignment", "Address", "And", "Block", "BoolLiteral", "BitwiseAnd", "BitwiseNot", "BitwiseOr", "BitwiseXor", "Break", "Call", "Cast", "CharLiteral", "Constant", "Constructor", "Continue", "Defer", "Dereference", "Divide", "DivideEquals", "EnumValue", "Equals", "Error", "FloatLiteral", "FormatStringLiteral", "For", "GreaterThan", "GreaterThanEquals", "If", "Identifier", "Index", "IntLiteral", "IsNotNull", "LeftShift", "LessThan", "LessThanEquals", "Match", "Member", "Minus", "MinusEquals", "Modulus", "Multiply", "MultiplyEquals", "Not", "NotEquals", "Null", "Or", "Plus", "PlusEquals", "Return", "RightShift", "SizeOf", "ScopeLookup", "Scratch", "StringLiteral", "UnaryMinus", "VarDeclaration", "Yield", "While"};
+static ASTType __ASTType_values[] = {ASTType__Assignment, ASTType__Address, ASTType__And, ASTType__Block, ASTType__BoolLiteral, ASTType__BitwiseAnd, ASTType__BitwiseNot, ASTType__BitwiseOr, ASTType__BitwiseXor, ASTType__Break, ASTType__Call, ASTType__Cast, ASTType__CharLiteral, ASTType__Constant, ASTType__Constructor, ASTType__Continue, ASTType__Defer, ASTType__Dereference, ASTType__Divide, ASTType__DivideEquals, ASTType__EnumValue, ASTType__Equals, ASTType__Error, ASTType__FloatLiteral, ASTType__FormatStringLiteral, ASTType__For, ASTType__GreaterThan, ASTType__GreaterThanEquals, ASTType__If, ASTType__Identifier, ASTType__Index, ASTType__IntLiteral, ASTType__IsNotNull, ASTType__LeftShift, ASTType__LessThan, ASTType__LessThanEquals, ASTType__Match, ASTType__Member, ASTType__Minus, ASTType__MinusEquals, ASTType__Modulus, ASTType__Multiply, ASTType__MultiplyEquals, ASTType__Not, ASTType__NotEquals, ASTType__Null, ASTType__Or, ASTType__Plus, ASTType__PlusEquals, ASTType__Return, ASTType__RightShift, ASTType__SizeOf, ASTType__ScopeLookup, ASTType__Scratch, ASTType__StringLiteral, ASTType__UnaryMinus, ASTType__VarDeclaration, ASTType__Yield, ASTType__While};
+
+static char *ASTType__dbg(ASTType this) {
+  if ((u32)this < 59u) return __ASTType_names[this];
+  return "<unknown>";
+}
+
+static i32 __ASTType_displace[] = {-54, 0, 0, 2, -10, -13, 1, 0, -23, 0, 1, 3, -16, 1, 0, -42, 0, 1, -1, 0, -32, 2, -17, 5, -34, -25, -2, -46, 0, 0, 0, -47, -31, -33, -48, 0, -49, 0, 0, 0, 0, -37, 0, -52, 0, -8, 0, 0, -28, 0, 1, 1, 1, -18, 0, 0, 3, -53, -44, -22, -26, -12, 3, 0};
+static i32 __ASTType_slots[] = {0, 1, 52, 28, 55, 38, 54, 7, 8, 9, 42, 10, 12, 25, 40, 14, 15, 16, 11, 44, 49, 20, 21, 27, 23, 24, 2, 26, 43, 4, 29, 31, 32, 34, 48, 56, 35, 18, 3, 6, 19, 36, 46, 37, 53, 41, 45, 47, 50, 22, 39, 51, 57, 58, 5, -1, 30, -1, -1, 13, 33, 17, -1, -1};
+
+static ASTType *ASTType__from_str(char *s) {
+  i32 d = __ASTType_displace[aecor_hash_str(s, 0) & 63u];
+  i32 i = __ASTType_slots[d < 0 ? -d - 1 : aecor_hash_str(s, d) & 63u];
+  if (i < 0 || strcmp(s, __ASTType_names[i])) return NULL;
+  return &__ASTType_values[i];
+}
+
+struct Variable {
+  char *name;
+  Type *type;
+  Span span;
+  bool is_extern;
+  char *extern_name;
+  bool by_ref;
+};
+
+struct Function {
+  char *name;
+  Vector *params;
+  Type *return_type;
+  AST *body;
+  bool exits;
+  Type *type;
+  Span span;
+  bool is_arrow;
+  bool is_address_taken;
+  bool is_extern;
+  char *extern_name;
+  bool is_static;
+  bool is_method;
+  char *method_struct_name;
+  bool is_inline;
+  bool is_noinline;
+  bool is_hot;
+  bool is_cold;
+  bool is_pure;
+  bool is_export;
+};
+
+struct Structure {
+  Type *type;
+  char *name;
+  Vector *fields;
+  Span span;
+  bool is_extern;
+  char *extern_name;
+  bool is_enum;
+  bool is_union;
+};
+
+struct Program {
+  Vector *functions;
+  Vector *structures;
+  Vector *constants;
+  Vector *global_vars;
+  Span span;
+  Map *included_files;
+  Vector *errors;
+  Vector *c_flags;
+  Vector *c_includes;
+  Vector *c_embed_headers;
+  Map *methods;
+};
+
+struct Block {
+  Vector *statements;
+};
+
+struct Binary {
+  AST *lhs;
+  AST *rhs;
+};
+
+struct Identifier {
+  char *name;
+  Variable *var;
+  bool is_function;
+  Function *func;
+};
+
+struct FormatString {
+  Vector *parts;
+  Vector *specs;
+  Vector *exprs;
+};
+
+struct Argument {
+  AST *expr;
+  AST *label;
+};
+
+struct FuncCall {
+  AST *callee;
+  Vector *args;
+  Function *func;
+  bool added_method_arg;
+};
+
+struct Constructor {
+  AST *callee;
+  Structure *struc;
+  Vector *args;
+};
+
+struct Member {
+  AST *lhs;
+  AST *rhs;
+  bool is_method;
+  bool is_pointer;
+};
+
+struct EnumValue {
+  AST *lhs;
+  AST *rhs;
+  Structure *struct_def;
+  Variable *var;
+};
+
+struct VarDeclaration {
+  Variable *var;
+  AST *init;
+};
+
+struct IfStatement {
+  AST *cond;
+  AST *body;
+  AST *els;
+};
+
+struct Loop {
+  AST *init;
+  AST *cond;
+  AST *incr;
+  AST *body;
+};
+
+struct Cast {
+  AST *lhs;
+  Type *to;
+};
+
+struct MatchCase {
+  AST *cond;
+  AST *body;
+};
+
+struct Match {
+  AST *expr;
+  Vector *cases;
+  AST *defolt;
+  Span defolt_span;
+};
+
+struct NumLiteral {
+  char *text;
+  Type *suffix;
+};
+
+union ASTUnion {
+  Block block;
+  Binary binary;
+  Identifier ident;
+  FormatString fmt_str;
+  FuncCall call;
+  Member member;
+  EnumValue enum_val;
+  VarDeclaration var_decl;
+  IfStatement if_stmt;
+  Loop loop;
+  Cast cast;
+  AST *unary;
+  Match match_stmt;
+  NumLiteral num_literal;
+  bool bool_literal;
+  char *string_literal;
+  char *char_literal;
+  Constructor constructor;
+  Type *size_of_type;
+};
+
+struct AST {
+  ASTType type;
+  Span span;
+  ASTUnion u;
+  Type *etype;
+  bool returns;
+};
+
+struct Lexer {
+  char *source;
+  i32 source_len;
+  i32 i;
+  Location loc;
+  bool seen_newline;
+  Vector *tokens;
+  Vector *errors;
+};
+
+struct ParserContext {
+  Vector *tokens;
+  i32 offset;
+};
+
+struct Template {
+  char *name;
+  Vector *params;
+  Vector *tokens;
+  i32 start;
+  bool is_struct;
+};
+
+struct Instance {
+  char *template_name;
+  Vector *args;
+  char *name;
+  Span span;
+};
+
+struct Parser {
+  Vector *tokens;
+  i32 curr;
+  Vector *context_stack;
+  char *project_root;
+  Vector *include_dirs;
+  Program *program;
+  Map *templates;
+  Map *method_templates;
+  Map *instances;
+  Vector *pending_instances;
+  Map *type_params;
+  char *instance_name;
+  bool defining_template;
+  bool pending_greater;
+};
+
+struct TypeChecker {
+  Vector *scopes;
+  Map *functions;
+  Map *structures;
+  Map *constants;
+  Map *methods;
+  Function *cur_func;
+  AST *callee;
+  bool in_loop;
+  bool can_yield;
+  Program *program;
+};
+
+/* function declarations */
+static FILE *File__open(char *path, char *mode);
+static bool File__exists(char *path);
+static i32 File__size(FILE *this);
+static char *File__slurp(FILE *this);
+static i32 File__read(FILE *this, void *buf, i32 size);
+static i32 File__write(FILE *this, void *buf, i32 size);
+static void File__puts(FILE *this, char *str);
+static __attribute__((noreturn)) __attribute__((cold)) void panic(char *msg);
+static bool string__starts_with(char *this, char *prefix);
+static bool string__ends_with(char *this, char *suffix);
+static void string__remove_last_n(char *this, i32 n);
+static bool string__eq(char *this, char *str2);
+static char *string__substring(char *this, i32 start, i32 len);
+static void string__strip_trailing_whitespace(char *this);
+static i32 min(i32 a, i32 b);
+static i32 max(i32 a, i32 b);
+static f64 time_now(void);
+static void bench_report(char *name, f64 elapsed, i32 iters);
+static Buffer Buffer__make(void);
+static Buffer Buffer__from_string(char *s);
+static Buffer Buffer__from_sized_string(char *s, i32 size);
+static void Buffer__resize_if_necessary(Buffer *this, i32 new_size);
+static void Buffer__hex_dump(Buffer *this);
+static void Buffer__putb(Buffer *this, Buffer *buf);
+static void Buffer__putbf(Buffer *this, Buffer *buf);
+static void Buffer__puts(Buffer *this, char *s);
+static inline __attribute__((always_inline)) void Buffer__putc(Buffer *this, char c);
+static void Buffer__put_u64(Buffer *this, u64 value);
+static void Buffer__put_i64(Buffer *this, i64 value);
+static void Buffer__put_f64(Buffer *this, f64 value);
+static void Buffer__put_ptr(Buffer *this, void *value);
+static void Buffer__putsf(Buffer *this, char *s);
+static char *Buffer__str(Buffer *this);
+static char *Buffer__new_str(Buffer *this);
+static void Buffer__free(Buffer *this);
+static Vector *Vector__new_sized(i32 capacity);
+static Vector *Vector__new(void);
+static void Vector__resize(Vector *this, i32 new_capacity);
+static inline __attribute__((always_inline)) void Vector__push(Vector *this, void *val);
+static void Vector__push_front(Vector *this, void *val);
+static void *Vector__pop(Vector *this);
+static inline __attribute__((always_inline)) void *Vector__back(Vector *this);
+static inline __attribute__((always_inline)) void *Vector__at(Vector *this, i32 i);
+static inline __attribute__((always_inline)) bool Vector__empty(Vector *this);
+static void Vector__free(Vector *this);
+static MapNode *MapNode__new(char *key, void *value, MapNode *next);
+static void MapNode__free_list(MapNode *node);
+static Map *Map__new(void);
+static i32 Map__hash(Map *this, char *s);
+static MapNode *Map__get_node(Map *this, char *key);
+static void *Map__get(Map *this, char *key);
+static bool Map__exists(Map *this, char *key);
+static void Map__insert(Map *this, char *key, void *value);
+static void Map__resize(Map *this);
+static void Map__print_keys(Map *this);
+static void Map__push_keys(Map *this, Vector *vec);
+static void Map__free(Map *this);
+static MapIterator Map__iter(Map *this);
+static char *MapIterator__key(MapIterator *this);
+static void *MapIterator__value(MapIterator *this);
+static MapIterator MapIterator__make(Map *map);
+static void MapIterator__next(MapIterator *this);
+static char *Location__str(Location this);
+static bool Location__is_before(Location *this, Location other);
+static char *Span__str(Span this);
+static Span Span__default(void);
+static Span Span__join(Span this, Span other);
+static bool Span__contains_loc(Span this, Location loc);
+static Token *Token__new(TokenType type, Span span, char *text);
+static Token *Token__from_type(TokenType type, Span span);
+static Token *Token__from_ident(char *text, Span span);
+static char *Token__str(Token *this);
+static TokenType TokenType__from_text(char *text);
+static char *TokenType__str(TokenType this);
+static char *BaseType__str(BaseType this);
+static i32 BaseType__scalar_size(BaseType this);
+static Type *Type__new(BaseType base, Span span);
+static Type *Type__new_link(BaseType base, Type *next, Span span);
+static Type *Type__ptr_to(BaseType base, Span span);
+static Type *Type__simd_from_name(char *name, Span span);
+static bool Type__is_struct_or_ptr(Type *this);
+static bool Type__is_integer(Type *this);
+static bool Type__is_float(Type *this);
+static bool Type__is_numeric(Type *this);
+static bool Type__is_numeric_or_char(Type *this);
+static bool Type__eq(Type *this, Type *other);
+static char *Type__str(Type *this);
+static bool Type__is_string(Type *this);
+static Type *Type__decay_array(Type *this);
+static bool Type__is_enum(Type *this);
+static bool Type__is_struct(Type *this);
+static bool Type__is_array(Type *this);
+static bool Type__is_simd(Type *this);
+static f32 minf(f32 a, f32 b);
+static f32 maxf(f32 a, f32 b);
+static f32 clampf(f32 x, f32 min, f32 max);
+static f32 clamp01(f32 x);
+static f32 degrees(f32 radians);
+static f32 radians(f32 degrees);
+static i32 edit_distance(char *str1, char *str2);
+static char *find_word_suggestion(char *s, Vector *options);
+static u32 hash_string(char *s, u32 seed);
+static char *ErrorType__str(ErrorType this);
+static char *MessageType__to_color(MessageType this);
+static char *MessageType__str(MessageType this);
+static void display_line(void);
+static void display_message(MessageType type, Span span, char *msg);
+static void display_message_span(MessageType type, Span span, char *msg);
+static void Error__display(Error *this);
+static __attribute__((noreturn)) void Error__panic(Error *this);
+static Error *Error__new(Span span, char *msg);
+static Error *Error__new_note(Span span, char *msg, char *note);
+static Error *Error__new_hint(Span span, char *msg, Span span2, char *hint);
+static void display_error_messages(Vector *errors, i32 detail_level);
+static ASTType ASTType__from_token(TokenType type);
+static Variable *Variable__new(char *name, Type *type, Span span);
+static Function *Function__new(Span span);
+static Structure *Structure__new(Span span);
+static Variable *Structure__find_field(Structure *this, char *name);
+static Program *Program__new(void);
+static bool Program__is_file_included(Program *this, char *filename);
+static void Program__add_included_file(Program *this, char *filename);
+static Argument *Argument__new(AST *label, AST *expr);
+static MatchCase *MatchCase__new(AST *cond, AST *body);
+static AST *AST__new(ASTType type, Span span);
+static AST *AST__new_unop(ASTType type, Span span, AST *expr);
+static AST *AST__new_binop(ASTType type, AST *lhs, AST *rhs);
+static bool AST__callee_is(AST *this, char *expected);
+static bool AST__is_lvalue(AST *this);
+static bool is_hex_digit(char c);
+static Lexer Lexer__make(char *source, char *filename);
+static void Lexer__push(Lexer *this, Token *token);
+static void Lexer__push_type(Lexer *this, TokenType type, i32 len);
+static inline __attribute__((always_inline)) char Lexer__cur(Lexer *this);
+static void Lexer__inc(Lexer *this);
+static char Lexer__peek(Lexer *this, i32 offset);
+static void Lexer__lex_char_literal(Lexer *this);
+static void Lexer__lex_string_literal(Lexer *this);
+static Token *Lexer__lex_int_literal_different_base(Lexer *this);
+static Token *Lexer__lex_numeric_literal_helper(Lexer *this);
+static void Lexer__lex_numeric_literal(Lexer *this);
+static Vector *Lexer__lex(Lexer *this);
+static ParserContext *ParserContext__new(Vector *tokens, i32 offset);
+static Template *Template__new(char *name, Vector *params, Vector *tokens, i32 start);
+static Parser *Parser__new(char *filename);
+static void Parser__push_context(Parser *this, Vector *tokens);
+static void Parser__pop_context(Parser *this);
+static void Parser__add_include_dir(Parser *this, char *dir);
+static Error *Parser__error_msg(Parser *this, char *msg);
+static void Parser__error(Parser *this, Error *err);
+static void Parser__unhandled_type(Parser *this, char *func);
+static inline __attribute__((always_inline)) Token *Parser__token(Parser *this);
+static inline __attribute__((always_inline)) bool Parser__token_is(Parser *this, TokenType type);
+static bool Parser__consume_if(Parser *this, TokenType type);
+static void Parser__consume_newline_or(Parser *this, TokenType type);
+static Token *Parser__consume(Parser *this, TokenType type);
+static Type *Parser__parse_type_with_parent(Parser *this, Type *parent);
+static Type *Parser__parse_type(Parser *this);
+static i32 Parser__skip_type_args(Parser *this, i32 start);
+static void Parser__consume_closing_angle(Parser *this);
+static Vector *Parser__parse_type_args(Parser *this);
+static Vector *Parser__parse_type_params(Parser *this);
+static char *Parser__mangle_type(Parser *this, Type *type);
+static char *Parser__instantiate(Parser *this, char *name, Vector *args, Span span);
+static void Parser__begin_template_definition(Parser *this, Vector *params);
+static void Parser__end_template_definition(Parser *this);
+static Template *Parser__register_template(Parser *this, char *name, Vector *params, i32 start, bool is_struct);
+static void Parser__find_templates(Parser *this);
+static Map *Parser__bind_type_params(Parser *this, Vector *params, Vector *args);
+static void Parser__instantiate_templates(Parser *this, Program *program);
+static AST *Parser__parse_format_string(Parser *this);
+static Type *Parser__parse_literal_suffix_type(Parser *this, Token *suffix);
+static AST *Parser__parse_factor(Parser *this, TokenType end_type);
+static AST *Parser__parse_term(Parser *this, TokenType end_type);
+static AST *Parser__parse_additive(Parser *this, TokenType end_type);
+static AST *Parser__parse_shift(Parser *this, TokenType end_type);
+static AST *Parser__parse_bw_and(Parser *this, TokenType end_type);
+static AST *Parser__parse_bw_xor(Parser *this, TokenType end_type);
+static AST *Parser__parse_bw_or(Parser *this, TokenType end_type);
+static AST *Parser__parse_relational(Parser *this, TokenType end_type);
+static AST *Parser__parse_logical_and(Parser *this, TokenType end_type);
+static AST *Parser__parse_logical_or(Parser *this, TokenType end_type);
+static AST *Parser__parse_expression(Parser *this, TokenType end_type);
+static AST *Parser__parse_match(Parser *this);
+static AST *Parser__parse_if(Parser *this);
+static void Parser__consume_end_of_statement(Parser *this);
+static AST *Parser__parse_statement(Parser *this);
+static AST *Parser__parse_block(Parser *this);
+static void Parser__parse_function_attribute(Parser *this, Function *func, Token *attr);
+static Function *Parser__parse_function(Parser *this);
+static Structure *Parser__parse_enum(Parser *this);
+static Structure *Parser__parse_struct(Parser *this);
+static AST *Parser__parse_global_value(Parser *this, bool is_constant);
+static char *Parser__find_file_path(Parser *this, char *filename);
+static char *Parser__include_file(Parser *this, Program *program, char *filename);
+static void Parser__parse_use(Parser *this, Program *program);
+static void Parser__parse_compiler_option(Parser *this, Program *program);
+static void Parser__parse_into_program(Parser *this, Program *program);
+static void Parser__include_prelude(Parser *this, Program *program);
+static void TypeChecker__error(TypeChecker *this, Error *err);
+static TypeChecker *TypeChecker__new(void);
+static void TypeChecker__push_scope(TypeChecker *this);
+static Map *TypeChecker__scope(TypeChecker *this);
+static void TypeChecker__pop_scope(TypeChecker *this);
+static Variable *TypeChecker__find_constant(TypeChecker *this, char *name);
+static void TypeChecker__push_var(TypeChecker *this, Variable *var);
+static Variable *TypeChecker__find_var(TypeChecker *this, char *name);
+static Variable *TypeChecker__get_struct_member(TypeChecker *this, char *lhs, char *rhs);
+static bool TypeChecker__type_is_valid(TypeChecker *this, Type *type);
+static void TypeChecker__check_method_call(TypeChecker *this, Type *method_type, AST *node);
+static Type *TypeChecker__check_constructor(TypeChecker *this, Structure *struc, AST *node);
+static Type *TypeChecker__check_simd_constructor(TypeChecker *this, Type *type, AST *node);
+static Type *TypeChecker__check_shuffle(TypeChecker *this, AST *node);
+static Type *TypeChecker__check_simd_arith(TypeChecker *this, AST *node, Type *lhs, Type *rhs);
+static bool TypeChecker__simd_lane_to_index(TypeChecker *this, AST *node, Type *type);
+static void TypeChecker__call_dbg_on_enum_value(TypeChecker *this, AST *node);
+static Type *TypeChecker__check_debug_assert(TypeChecker *this, AST *node);
+static Type *TypeChecker__check_call(TypeChecker *this, AST *node);
+static Type *TypeChecker__check_format_string(TypeChecker *this, AST *node);
+static Type *TypeChecker__check_pointer_arith(TypeChecker *this, AST *node, Type *lhs, Type *rhs);
+static Type *TypeChecker__check_binary_op(TypeChecker *this, AST *node, AST *_lhs, AST *_rhs);
+static void TypeChecker__error_unknown_identifier(TypeChecker *this, Span span, char *name);
+static void TypeChecker__error_unknown_member(TypeChecker *this, AST *node, Type *struct_type, char *field_name, bool is_static);
+static bool TypeChecker__try_infer_enum(TypeChecker *this, AST *node, Type *type);
+static Type *TypeChecker__check_expression(TypeChecker *this, AST *node, Type *hint);
+static void TypeChecker__check_expression_statement(TypeChecker *this, AST *node, AST *body, bool is_expr, Type *hint);
+static void TypeChecker__check_match_for_enum(TypeChecker *this, Structure *struc, AST *node, bool is_expr, Type *hint);
+static void TypeChecker__check_match(TypeChecker *this, AST *node, bool is_expr, Type *hint);
+static void TypeChecker__check_if(TypeChecker *this, AST *node, bool is_expr, Type *hint);
+static Type *TypeChecker__check_constant_expression(TypeChecker *this, AST *node);
+static void TypeChecker__check_var_declaration(TypeChecker *this, AST *node, bool is_constant);
+static void TypeChecker__check_statement(TypeChecker *this, AST *node);
+static void TypeChecker__check_block(TypeChecker *this, AST *node, bool can_yield);
+static void TypeChecker__check_function(TypeChecker *this, Function *func);
+static void TypeChecker__check_all_functions(TypeChecker *this, Program *program);
+static void TypeChecker__dfs_structs(TypeChecker *this, Structure *struc, Vector *results, Map *done);
+static Function *TypeChecker__add_builtin_method(TypeChecker *this, Map *s_methods, Structure *struc, char *name, Variable *param, Type *return_type);
+static void TypeChecker__check_all_structs(TypeChecker *this, Program *program);
+static void TypeChecker__check_program(TypeChecker *this, Program *program);
+i32 main(void);
+
+/* global variables */
+u64 bench_sink = 0;
+
+static FILE *File__open(char *path, char *mode) {
+  FILE *file = fopen(path, mode);
+  if ((!((bool)file))) {
+    printf("Error opening file '%s': %s""\n", path, strerror(errno));
+    exit(1);
+  } 
+  return file;
+}
+
+static bool File__exists(char *path) {
+  FILE *file = fopen(path, "r");
+  if ((!((bool)file))) {
+    return false;
+  } 
+  fclose(file);
+  return true;
+}
+
+static i32 File__size(FILE *this) {
+  i32 pos = ftell(this);
+  fseek(this, 0, SEEK_END);
+  i32 size = ftell(this);
+  fseek(this, pos, SEEK_SET);
+  return size;
+}
+
+static char *File__slurp(FILE *this) {
+  i32 pos = ftell(this);
+  fseek(this, 0, SEEK_END);
+  i32 size = ftell(this);
+  fseek(this, pos, SEEK_SET);
+  void *buf = calloc((size + 1), sizeof(char));
+  fread(buf, 1, size, this);
+  fseek(this, pos, SEEK_SET);
+  return ((char *)buf);
+}
+
+static i32 File__read(FILE *this, void *buf, i32 size) {
+  return fread(buf, 1, size, this);
+}
+
+static i32 File__write(FILE *this, void *buf, i32 size) {
+  return fwrite(buf, 1, size, this);
+}
+
+static void File__puts(FILE *this, char *str) {
+  fwrite(str, 1, strlen(str), this);
+}
+
+static __attribute__((noreturn)) __attribute__((cold)) void panic(char *msg) {
+  printf("%s""\n", msg);
+  aecor_stdout_flush();
+  exit(1);
+}
+
+static bool string__starts_with(char *this, char *prefix) {
+  i32 prefix_len = strlen(prefix);
+  if ((strlen(this) < prefix_len)) {
+    return false;
+  } 
+  return strncmp(this, prefix, prefix_len) == 0;
+}
+
+static bool string__ends_with(char *this, char *suffix) {
+  i32 suffix_len = strlen(suffix);
+  if ((strlen(this) < suffix_len)) {
+    return false;
+  } 
+  return strncmp(this, suffix, suffix_len) == 0;
+}
+
+static void string__remove_last_n(char *this, i32 n) {
+  this[(strlen(this) - n)] = '\0';
+}
+
+static bool string__eq(char *this, char *str2) {
+  return strcmp(this, str2) == 0;
+}
+
+static char *string__substring(char *this, i32 start, i32 len) {
+  char *new_str = ((char *)calloc((len + 1), sizeof(char)));
+  memcpy(new_str, (this + start), len);
+  return new_str;
+}
+
+static void string__strip_trailing_whitespace(char *this) {
+  for (i32 i = (strlen(this) - 1); (i >= 0); i -= 1) {
+    if ((this[i] != ' ')) 
+    break;
+    
+    this[i] = '\0';
+  } 
+}
+
+static i32 min(i32 a, i32 b) {
+  return ((a < b) ? a : b);
+}
+
+static i32 max(i32 a, i32 b) {
+  return ((a > b) ? a : b);
+}
+
+static f64 time_now(void) {
+  struct timespec ts = {0};
+  clock_gettime(CLOCK_MONOTONIC, (&ts));
+  return (((f64)ts.tv_sec) + (((f64)ts.tv_nsec) / 1000000000.0));
+}
+
+static void bench_report(char *name, f64 elapsed, i32 iters) {
+  f64 ns = ((elapsed * 1000000000.0) / ((f64)iters));
+  printf("%-32s %10.3f ms %10.2f ns/iter""\n", name, (elapsed * 1000.0), ns);
+}
+
+static Buffer Buffer__make(void) {
+  i32 initial_capacity = 16;
+  return (Buffer){.data = calloc(initial_capacity, 1), .size = 0, .capacity = initial_capacity};
+}
+
+static Buffer Buffer__from_string(char *s) {
+  return (Buffer){.data = ((u8 *)s), .size = strlen(s), .capacity = strlen(s)};
+}
+
+static Buffer Buffer__from_sized_string(char *s, i32 size) {
+  return (Buffer){.data = ((u8 *)s), .size = ((i32)size), .capacity = strlen(s)};
+}
+
+static void Buffer__resize_if_necessary(Buffer *this, i32 new_size) {
+  if ((new_size >= this->capacity)) {
+    i32 new_capacity = max((this->capacity * 2), new_size);
+    this->data = ((u8 *)realloc(this->data, new_capacity));
+    if (this->data == NULL) {
+      printf("Out of memory!""\n");
+      exit(1);
+    } 
+    this->capacity = new_capacity;
+  } 
+}
+
+static void Buffer__hex_dump(Buffer *this) {
+  printf("(%d bytes): ", this->size);
+  for (i32 i = 0; (i < this->size); i += 1) {
+    if (((i % 4) == 0 && (i > 0))) 
+    printf("_");
+    
+    printf("%02x", this->data[i]);
+  } 
+  printf("""\n");
+}
+
+static void Buffer__putb(Buffer *this, Buffer *buf) {
+  Buffer__resize_if_necessary(this, ((this->size + buf->size) + 1));
+  memcpy((this->data + this->size), buf->data, buf->size);
+  this->data[(this->size + buf->size)] = ((u8)'\0');
+  this->size += buf->size;
+}
+
+static void Buffer__putbf(Buffer *this, Buffer *buf) {
+  Buffer__putb(this, buf);
+  Buffer__free(buf);
+}
+
+static void Buffer__puts(Buffer *this, char *s) {
+  i32 len = strlen(s);
+  Buffer__resize_if_necessary(this, ((this->size + len) + 1));
+  memcpy((this->data + this->size), s, (len + 1));
+  this->size += len;
+}
+
+static inline __attribute__((always_inline)) void Buffer__putc(Buffer *this, char c) {
+  Buffer__resize_if_necessary(this, (this->size + 2));
+  this->data[this->size] = ((u8)c);
+  this->size += 1;
+  this->data[this->size] = ((u8)'\0');
+}
+
+static void Buffer__put_u64(Buffer *this, u64 value) {
+  u8 digits[20];
+  i32 len = 0;
+  while (true) {
+    digits[len] = (((u8)(value % 10)) + ((u8)'0'));
+    len += 1;
+    value = (value / 10);
+    if (value == 0) 
+    break;
+    
+  } 
+  Buffer__resize_if_necessary(this, ((this->size + len) + 1));
+  for (i32 i = 0; (i < len); i += 1) {
+    this->data[(this->size + i)] = digits[((len - i) - 1)];
+  } 
+  this->size += len;
+  this->data[this->size] = ((u8)'\0');
+}
+
+static void Buffer__put_i64(Buffer *this, i64 value) {
+  if ((value < 0)) {
+    Buffer__putc(this, '-');
+    Buffer__put_u64(this, (-((u64)value)));
+  }  else {
+    Buffer__put_u64(this, ((u64)value));
+  } 
+}
+
+static void Buffer__put_f64(Buffer *this, f64 value) {
+  char stack[64];
+  char *s = format_string_into(stack, 64, "%f", value);
+  Buffer__puts(this, s);
+  if ((s != ((char *)stack))) 
+  free(s);
+  
+}
+
+static void Buffer__put_ptr(Buffer *this, void *value) {
+  char stack[32];
+  Buffer__puts(this, format_string_into(stack, 32, "%p", value));
+}
+
+static void Buffer__putsf(Buffer *this, char *s) {
+  Buffer__puts(this, s);
+  free(s);
+}
+
+static char *Buffer__str(Buffer *this) {
+  return ((char *)this->data);
+}
+
+static char *Buffer__new_str(Buffer *this) {
+  return strdup(((char *)this->data));
+}
+
+static void Buffer__free(Buffer *this) {
+  free(this->data);
+}
+
+static Vector *Vector__new_sized(i32 capacity) {
+  Vector *vec = ((Vector *)calloc(1, sizeof(Vector)));
+  vec->size = 0;
+  vec->capacity = capacity;
+  vec->data = ((void **)calloc(vec->capacity, sizeof(void *)));
+  return vec;
+}
+
+static Vector *Vector__new(void) {
+  return Vector__new_sized(16);
+}
+
+static void Vector__resize(Vector *this, i32 new_capacity) {
+  this->capacity = new_capacity;
+  this->data = ((void **)realloc(this->data, (this->capacity * sizeof(void *))));
+}
+
+static inline __attribute__((always_inline)) void Vector__push(Vector *this, void *val) {
+  if (this->size == this->capacity) {
+    Vector__resize(this, (this->capacity * 2));
+  } 
+  this->data[this->size] = val;
+  this->size += 1;
+}
+
+static void Vector__push_front(Vector *this, void *val) {
+  if (this->size == this->capacity) {
+    Vector__resize(this, (this->capacity * 2));
+  } 
+  for (i32 i = this->size; (i > 0); i -= 1) {
+    this->data[i] = this->data[(i - 1)];
+  } 
+  this->data[0] = val;
+  this->size += 1;
+}
+
+static void *Vector__pop(Vector *this) {
+  (__builtin_expect(!!((this->size > 0)), 1) ? (void)0 : panic("pop on empty vector"));
+  this->size -= 1;
+  return this->data[this->size];
+}
+
+static inline __attribute__((always_inline)) void *Vector__back(Vector *this) {
+  (__builtin_expect(!!((this->size > 0)), 1) ? (void)0 : panic("back on empty vector"));
+  return this->data[(this->size - 1)];
+}
+
+static inline __attribute__((always_inline)) void *Vector__at(Vector *this, i32 i) {
+  (__builtin_expect(!!(((i >= 0) && (i < this->size))), 1) ? (void)0 : panic("at out of bounds in vector"));
+  return this->data[i];
+}
+
+static inline __attribute__((always_inline)) bool Vector__empty(Vector *this) {
+  return this->size == 0;
+}
+
+static void Vector__free(Vector *this) {
+  free(this->data);
+  free(this);
+}
+
+static MapNode *MapNode__new(char *key, void *value, MapNode *next) {
+  MapNode *node = ((MapNode *)calloc(1, sizeof(MapNode)));
+  node->key = key;
+  node->value = value;
+  node->next = next;
+  return node;
+}
+
+static void MapNode__free_list(MapNode *node) {
+  MapNode *cur = node;
+  while (((bool)cur)) {
+    MapNode *next = cur->next;
+    free(cur);
+    cur = next;
+  } 
+}
+
+static Map *Map__new(void) {
+  Map *map = ((Map *)calloc(1, sizeof(Map)));
+  map->num_buckets = 4;
+  map->buckets = ((MapNode **)calloc(map->num_buckets, sizeof(MapNode *)));
+  return map;
+}
+
+static i32 Map__hash(Map *this, char *s) {
+  i32 hash = 5381;
+  i32 len = strlen(s);
+  for (i32 i = 0; (i < len); i += 1) {
+    hash = ((hash * 33) ^ ((i32)s[i]));
+  } 
+  hash = (hash % this->num_buckets);
+  if ((hash < 0)) {
+    hash += this->num_buckets;
+  } 
+  return hash;
+}
+
+static MapNode *Map__get_node(Map *this, char *key) {
+  i32 hash = Map__hash(this, key);
+  MapNode *node = this->buckets[hash];
+  while (((bool)node)) {
+    if (string__eq(node->key, key)) {
+      return node;
+    } 
+    node = node->next;
+  } 
+  return NULL;
+}
+
+static void *Map__get(Map *this, char *key) {
+  MapNode *node = Map__get_node(this, key);
+  if (((bool)node)) {
+    return node->value;
+  } 
+  return NULL;
+}
+
+static bool Map__exists(Map *this, char *key) {
+  return ((bool)Map__get_node(this, key));
+}
+
+static void Map__insert(Map *this, char *key, void *value) {
+  MapNode *node = Map__get_node(this, key);
+  if (((bool)node)) {
+    node->value = value;
+  }  else {
+    i32 hash = Map__hash(this, key);
+    MapNode *new_node = MapNode__new(key, value, this->buckets[hash]);
+    if (((bool)this->buckets[hash])) {
+      this->num_collisions += 1;
+    } 
+    this->buckets[hash] = new_node;
+    this->num_items += 1;
+    if ((this->num_items > this->num_buckets)) {
+      Map__resize(this);
+    } 
+  } 
+}
+
+static void Map__resize(Map *this) {
+  MapNode **old_buckets = this->buckets;
+  i32 old_num_buckets = this->num_buckets;
+  i32 old_num_items = this->num_items;
+  this->num_collisions = 0;
+  this->num_buckets *= 2;
+  this->buckets = ((MapNode **)calloc(this->num_buckets, sizeof(MapNode *)));
+  for (i32 i = 0; (i < old_num_buckets); i += 1) {
+    MapNode *node = old_buckets[i];
+    while (((bool)node)) {
+      i32 new_hash = Map__hash(this, node->key);
+      MapNode *new_node = MapNode__new(node->key, node->value, this->buckets[new_hash]);
+      if (((bool)this->buckets[new_hash])) {
+        this->num_collisions += 1;
+      } 
+      this->buckets[new_hash] = new_node;
+      node = node->next;
+    } 
+  } 
+  for (i32 i = 0; (i < old_num_buckets); i += 1) {
+    MapNode__free_list(old_buckets[i]);
+  } 
+  free(old_buckets);
+}
+
+static void Map__print_keys(Map *this) {
+  for (i32 i = 0; (i < this->num_buckets); i += 1) {
+    MapNode *node = this->buckets[i];
+    while (((bool)node)) {
+      printf("- '%s'\n""\n", node->key);
+      node = node->next;
+    } 
+  } 
+}
+
+static void Map__push_keys(Map *this, Vector *vec) {
+  for (i32 i = 0; (i < this->num_buckets); i += 1) {
+    MapNode *node = this->buckets[i];
+    while (((bool)node)) {
+      Vector__push(vec, node->key);
+      node = node->next;
+    } 
+  } 
+}
+
+static void Map__free(Map *this) {
+  for (i32 i = 0; (i < this->num_buckets); i += 1) {
+    MapNode__free_list(this->buckets[i]);
+  } 
+  free(this->buckets);
+}
+
+static MapIterator Map__iter(Map *this) {
+  return MapIterator__make(this);
+}
+
+static char *MapIterator__key(MapIterator *this) {
+  return this->cur->key;
+}
+
+static void *MapIterator__value(MapIterator *this) {
+  return this->cur->value;
+}
+
+static MapIterator MapIterator__make(Map *map) {
+  MapIterator it = (MapIterator){.idx = (-1), .cur = NULL, map};
+  MapIterator__next((&it));
+  return it;
+}
+
+static void MapIterator__next(MapIterator *this) {
+  while ((this->idx < this->map->num_buckets)) {
+    while (((bool)this->cur)) {
+      this->cur = this->cur->next;
+      if (((bool)this->cur)) 
+      return;
+      
+    } 
+    this->idx += 1;
+    this->cur = ({ MapNode *__yield_0;
+  if ((this->idx < this->map->num_buckets)) {
+    __yield_0 = this->map->buckets[this->idx];
+  }  else {
+    __yield_0 = NULL;
+  } 
+;__yield_0; });
+    if (((bool)this->cur)) 
+    return;
+    
+  } 
+}
+
+static char *Location__str(Location this) {
+  return format_string("%s:%d:%d", this.filename, this.line, this.col);
+}
+
+static bool Location__is_before(Location *this, Location other) {
+  if ((this->line > other.line)) 
+  return false;
+  
+  if ((this->line < other.line)) 
+  return true;
+  
+  return (this->col <= other.col);
+}
+
+static char *Span__str(Span this) {
+  return format_string("%s => %s", Location__str(this.start), Location__str(this.end));
+}
+
+static Span Span__default(void) {
+  Span span = {0};
+  span.start = (Location){.filename = "<default>", .line = 0, .col = 0, .index = 0};
+  span.end = (Location){.filename = "<default>", .line = 0, .col = 0, .index = 0};
+  return span;
+}
+
+static Span Span__join(Span this, Span other) {
+  Span span = {0};
+  span.start = this.start;
+  span.end = other.end;
+  return span;
+}
+
+static bool Span__contains_loc(Span this, Location loc) {
+  if ((!string__eq(this.start.filename, loc.filename))) 
+  return false;
+  
+  return (Location__is_before((&this.start), loc) && Location__is_before((&loc), this.end));
+}
+
+static Token *Token__new(TokenType type, Span span, char *text) {
+  Token *tok = ((Token *)calloc(1, sizeof(Token)));
+  (*tok) = (Token){type, span, text, .suffix = NULL, .seen_newline = false};
+  return tok;
+}
+
+static Token *Token__from_type(TokenType type, Span span) {
+  return Token__new(type, span, "");
+}
+
+static Token *Token__from_ident(char *text, Span span) {
+  TokenType type = TokenType__from_text(text);
+  return Token__new(type, span, text);
+}
+
+static char *Token__str(Token *this) {
+  return format_string("%s: %s", Span__str(this->span), TokenType__str(this->type));
+}
+
+static TokenType TokenType__from_text(char *text) {
+  return ({ TokenType __yield_0;
+  {
+    char *__match_str = text;
+    switch (aecor_hash_str(__match_str, 2166136261u)) {
+      case 1305964296u:
+        if (!strcmp(__match_str, "and")) goto __match_0_0;
+        break;
+      case 106731536u:
+        if (!strcmp(__match_str, "as")) goto __match_0_1;
+        break;
+      case 2869110635u:
+        if (!strcmp(__match_str, "bool")) goto __match_0_2;
+        break;
+      case 1349183411u:
+        if (!strcmp(__match_str, "break")) goto __match_0_3;
+        break;
+      case 3477080843u:
+        if (!strcmp(__match_str, "char")) goto __match_0_4;
+        break;
+      case 2245205078u:
+        if (!strcmp(__match_str, "const")) goto __match_0_5;
+        break;
+      case 3663126513u:
+        if (!strcmp(__match_str, "continue")) goto __match_0_6;
+        break;
+      case 832636142u:
+        if (!strcmp(__match_str, "def")) goto __match_0_7;
+        break;
+      case 2838665391u:
+        if (!strcmp(__match_str, "defer")) goto __match_0_8;
+        break;
+      case 642373404u:
+        if (!strcmp(__match_str, "else")) goto __match_0_9;
+        break;
+      case 1633607337u:
+        if (!strcmp(__match_str, "enum")) goto __match_0_10;
+        break;
+      case 594816953u:
+        if (!strcmp(__match_str, "extern")) goto __match_0_11;
+        break;
+      case 4275523303u:
+        if (!strcmp(__match_str, "false")) goto __match_0_12;
+        break;
+      case 859369167u:
+        if (!strcmp(__match_str, "f32")) goto __match_0_13;
+        break;
+      case 861975295u:
+        if (!strcmp(__match_str, "f64")) goto __match_0_14;
+        break;
+      case 3121374858u:
+        if (!strcmp(__match_str, "for")) goto __match_0_15;
+        break;
+      case 283012692u:
+        if (!strcmp(__match_str, "fn")) goto __match_0_16;
+        break;
+      case 1074601716u:
+        if (!strcmp(__match_str, "i8")) goto __match_0_17;
+        break;
+      case 833762287u:
+        if (!strcmp(__match_str, "i16")) goto __match_0_18;
+        break;
+      case 918736459u:
+        if (!strcmp(__match_str, "i32")) goto __match_0_19;
+        break;
+      case 3966529125u:
+        if (!strcmp(__match_str, "i64")) goto __match_0_20;
+        break;
+      case 2551052472u:
+        if (!strcmp(__match_str, "if")) goto __match_0_21;
+        break;
+      case 950579197u:
+        if (!strcmp(__match_str, "let")) goto __match_0_22;
+        break;
+      case 2717393236u:
+        if (!strcmp(__match_str, "match")) goto __match_0_23;
+        break;
+      case 1957039169u:
+        if (!strcmp(__match_str, "not")) goto __match_0_24;
+        break;
+      case 2827039351u:
+        if (!strcmp(__match_str, "null")) goto __match_0_25;
+        break;
+      case 2654982702u:
+        if (!strcmp(__match_str, "or")) goto __match_0_26;
+        break;
+      case 4108485794u:
+        if (!strcmp(__match_str, "return")) goto __match_0_27;
+        break;
+      case 3474485403u:
+        if (!strcmp(__match_str, "scratch")) goto __match_0_28;
+        break;
+      case 2850059673u:
+        if (!strcmp(__match_str, "sizeof")) goto __match_0_29;
+        break;
+      case 930201698u:
+        if (!strcmp(__match_str, "string")) goto __match_0_30;
+        break;
+      case 289050604u:
+        if (!strcmp(__match_str, "struct")) goto __match_0_31;
+        break;
+      case 1715307617u:
+        if (!strcmp(__match_str, "true")) goto __match_0_32;
+        break;
+      case 3201516176u:
+        if (!strcmp(__match_str, "then")) goto __match_0_33;
+        break;
+      case 3926084466u:
+        if (!strcmp(__match_str, "u8")) goto __match_0_34;
+        break;
+      case 4148185419u:
+        if (!strcmp(__match_str, "u16")) goto __match_0_35;
+        break;
+      case 1849896378u:
+        if (!strcmp(__match_str, "u32")) goto __match_0_36;
+        break;
+      case 2500781617u:
+        if (!strcmp(__match_str, "u64")) goto __match_0_37;
+        break;
+      case 4025494924u:
+        if (!strcmp(__match_str, "untyped_ptr")) goto __match_0_38;
+        break;
+      case 3495413904u:
+        if (!strcmp(__match_str, "union")) goto __match_0_39;
+        break;
+      case 621625292u:
+        if (!strcmp(__match_str, "use")) goto __match_0_40;
+        break;
+      case 2454924575u:
+        if (!strcmp(__match_str, "void")) goto __match_0_41;
+        break;
+      case 317341496u:
+        if (!strcmp(__match_str, "yield")) goto __match_0_42;
+        break;
+      case 4040919573u:
+        if (!strcmp(__match_str, "while")) goto __match_0_43;
+        break;
+    }
+    goto __match_0_default;
+    __match_0_0: {
+      __yield_0 = TokenType__And;
+} goto __match_0_end;
+    __match_0_1: {
+      __yield_0 = TokenType__As;
+} goto __match_0_end;
+    __match_0_2: {
+      __yield_0 = TokenType__Bool;
+} goto __match_0_end;
+    __match_0_3: {
+      __yield_0 = TokenType__Break;
+} goto __match_0_end;
+    __match_0_4: {
+      __yield_0 = TokenType__Char;
+} goto __match_0_end;
+    __match_0_5: {
+      __yield_0 = TokenType__Const;
+} goto __match_0_end;
+    __match_0_6: {
+      __yield_0 = TokenType__Continue;
+} goto __match_0_end;
+    __match_0_7: {
+      __yield_0 = TokenType__Def;
+} goto __match_0_end;
+    __match_0_8: {
+      __yield_0 = TokenType__Defer;
+} goto __match_0_end;
+    __match_0_9: {
+      __yield_0 = TokenType__Else;
+} goto __match_0_end;
+    __match_0_10: {
+      __yield_0 = TokenType__Enum;
+} goto __match_0_end;
+    __match_0_11: {
+      __yield_0 = TokenType__Extern;
+} goto __match_0_end;
+    __match_0_12: {
+      __yield_0 = TokenType__False;
+} goto __match_0_end;
+    __match_0_13: {
+      __yield_0 = TokenType__F32;
+} goto __match_0_end;
+    __match_0_14: {
+      __yield_0 = TokenType__F64;
+} goto __match_0_end;
+    __match_0_15: {
+      __yield_0 = TokenType__For;
+} goto __match_0_end;
+    __match_0_16: {
+      __yield_0 = TokenType__Fn;
+} goto __match_0_end;
+    __match_0_17: {
+      __yield_0 = TokenType__I8;
+} goto __match_0_end;
+    __match_0_18: {
+      __yield_0 = TokenType__I16;
+} goto __match_0_end;
+    __match_0_19: {
+      __yield_0 = TokenType__I32;
+} goto __match_0_end;
+    __match_0_20: {
+      __yield_0 = TokenType__I64;
+} goto __match_0_end;
+    __match_0_21: {
+      __yield_0 = TokenType__If;
+} goto __match_0_end;
+    __match_0_22: {
+      __yield_0 = TokenType__Let;
+} goto __match_0_end;
+    __match_0_23: {
+      __yield_0 = TokenType__Match;
+} goto __match_0_end;
+    __match_0_24: {
+      __yield_0 = TokenType__Not;
+} goto __match_0_end;
+    __match_0_25: {
+      __yield_0 = TokenType__Null;
+} goto __match_0_end;
+    __match_0_26: {
+      __yield_0 = TokenType__Or;
+} goto __match_0_end;
+    __match_0_27: {
+      __yield_0 = TokenType__Return;
+} goto __match_0_end;
+    __match_0_28: {
+      __yield_0 = TokenType__Scratch;
+} goto __match_0_end;
+    __match_0_29: {
+      __yield_0 = TokenType__SizeOf;
+} goto __match_0_end;
+    __match_0_30: {
+      __yield_0 = TokenType__String;
+} goto __match_0_end;
+    __match_0_31: {
+      __yield_0 = TokenType__Struct;
+} goto __match_0_end;
+    __match_0_32: {
+      __yield_0 = TokenType__True;
+} goto __match_0_end;
+    __match_0_33: {
+      __yield_0 = TokenType__Then;
+} goto __match_0_end;
+    __match_0_34: {
+      __yield_0 = TokenType__U8;
+} goto __match_0_end;
+    __match_0_35: {
+      __yield_0 = TokenType__U16;
+} goto __match_0_end;
+    __match_0_36: {
+      __yield_0 = TokenType__U32;
+} goto __match_0_end;
+    __match_0_37: {
+      __yield_0 = TokenType__U64;
+} goto __match_0_end;
+    __match_0_38: {
+      __yield_0 = TokenType__UntypedPtr;
+} goto __match_0_end;
+    __match_0_39: {
+      __yield_0 = TokenType__Union;
+} goto __match_0_end;
+    __match_0_40: {
+      __yield_0 = TokenType__Use;
+} goto __match_0_end;
+    __match_0_41: {
+      __yield_0 = TokenType__Void;
+} goto __match_0_end;
+    __match_0_42: {
+      __yield_0 = TokenType__Yield;
+} goto __match_0_end;
+    __match_0_43: {
+      __yield_0 = TokenType__While;
+} goto __match_0_end;
+    __match_0_default: {
+      __yield_0 = TokenType__Identifier;
+}
+    __match_0_end:;
+  }
+;__yield_0; });
+}
+
+static char *TokenType__str(TokenType this) {
+  return ({ char *__yield_0;
+  switch (this) {
+    case TokenType__And: {
+      __yield_0 = "and";
+} break;
+    case TokenType__As: {
+      __yield_0 = "as";
+} break;
+    case TokenType__Bool: {
+      __yield_0 = "bool";
+} break;
+    case TokenType__Break: {
+      __yield_0 = "break";
+} break;
+    case TokenType__Char: {
+      __yield_0 = "char";
+} break;
+    case TokenType__Const: {
+      __yield_0 = "const";
+} break;
+    case TokenType__Continue: {
+      __yield_0 = "continue";
+} break;
+    case TokenType__Def: {
+      __yield_0 = "def";
+} break;
+    case TokenType__Defer: {
+      __yield_0 = "defer";
+} break;
+    case TokenType__Else: {
+      __yield_0 = "else";
+} break;
+    case TokenType__Enum: {
+      __yield_0 = "enum";
+} break;
+    case TokenType__Extern: {
+      __yield_0 = "extern";
+} break;
+    case TokenType__False: {
+      __yield_0 = "false";
+} break;
+    case TokenType__F32: {
+      __yield_0 = "f32";
+} break;
+    case TokenType__F64: {
+      __yield_0 = "f64";
+} break;
+    case TokenType__For: {
+      __yield_0 = "for";
+} break;
+    case TokenType__Fn: {
+      __yield_0 = "fn";
+} break;
+    case TokenType__I8: {
+      __yield_0 = "i8";
+} break;
+    case TokenType__I16: {
+      __yield_0 = "i16";
+} break;
+    case TokenType__I32: {
+      __yield_0 = "i32";
+} break;
+    case TokenType__I64: {
+      __yield_0 = "i64";
+} break;
+    case TokenType__If: {
+      __yield_0 = "if";
+} break;
+    case TokenType__Let: {
+      __yield_0 = "let";
+} break;
+    case TokenType__Match: {
+      __yield_0 = "match";
+} break;
+    case TokenType__Not: {
+      __yield_0 = "not";
+} break;
+    case TokenType__Null: {
+      __yield_0 = "null";
+} break;
+    case TokenType__Or: {
+      __yield_0 = "or";
+} break;
+    case TokenType__Return: {
+      __yield_0 = "return";
+} break;
+    case TokenType__Scratch: {
+      __yield_0 = "scratch";
+} break;
+    case TokenType__SizeOf: {
+      __yield_0 = "sizeof";
+} break;
+    case TokenType__String: {
+      __yield_0 = "string";
+} break;
+    case TokenType__Struct: {
+      __yield_0 = "struct";
+} break;
+    case TokenType__True: {
+      __yield_0 = "true";
+} break;
+    case TokenType__Then: {
+      __yield_0 = "then";
+} break;
+    case TokenType__U8: {
+      __yield_0 = "u8";
+} break;
+    case TokenType__U16: {
+      __yield_0 = "u16";
+} break;
+    case TokenType__U32: {
+      __yield_0 = "u32";
+} break;
+    case TokenType__U64: {
+      __yield_0 = "u64";
+} break;
+    case TokenType__UntypedPtr: {
+      __yield_0 = "untyped_ptr";
+} break;
+    case TokenType__Union: {
+      __yield_0 = "union";
+} break;
+    case TokenType__Use: {
+      __yield_0 = "use";
+} break;
+    case TokenType__Void: {
+      __yield_0 = "void";
+} break;
+    case TokenType__Yield: {
+      __yield_0 = "yield";
+} break;
+    case TokenType__While: {
+      __yield_0 = "while";
+} break;
+    default: {
+      __yield_0 = TokenType__dbg(this);
+} break;
+  }
+;__yield_0; });
+}
+
+static char *BaseType__str(BaseType this) {
+  return ({ char *__yield_0;
+  switch (this) {
+    case BaseType__Char: {
+      __yield_0 = "char";
+} break;
+    case BaseType__Bool: {
+      __yield_0 = "bool";
+} break;
+    case BaseType__Void: {
+      __yield_0 = "void";
+} break;
+    case BaseType__I8: {
+      __yield_0 = "i8";
+} break;
+    case BaseType__I16: {
+      __yield_0 = "i16";
+} break;
+    case BaseType__I32: {
+      __yield_0 = "i32";
+} break;
+    case BaseType__I64: {
+      __yield_0 = "i64";
+} break;
+    case BaseType__U8: {
+      __yield_0 = "u8";
+} break;
+    case BaseType__U16: {
+      __yield_0 = "u16";
+} break;
+    case BaseType__U32: {
+      __yield_0 = "u32";
+} break;
+    case BaseType__U64: {
+      __yield_0 = "u64";
+} break;
+    case BaseType__F32: {
+      __yield_0 = "f32";
+} break;
+    case BaseType__F64: {
+      __yield_0 = "f64";
+} break;
+    default: {
+      __yield_0 = BaseType__dbg(this);
+} break;
+  }
+;__yield_0; });
+}
+
+static i32 BaseType__scalar_size(BaseType this) {
+  return ({ i32 __yield_0;
+  switch (this) {
+    case BaseType__Char:
+    case BaseType__Bool:
+    case BaseType__I8:
+    case BaseType__U8: {
+      __yield_0 = 1;
+} break;
+    case BaseType__I16:
+    case BaseType__U16: {
+      __yield_0 = 2;
+} break;
+    case BaseType__I32:
+    case BaseType__U32:
+    case BaseType__F32: {
+      __yield_0 = 4;
+} break;
+    case BaseType__I64:
+    case BaseType__U64:
+    case BaseType__F64: {
+      __yield_0 = 8;
+} break;
+    default: {
+      __yield_0 = 0;
+} break;
+  }
+;__yield_0; });
+}
+
+static Type *Type__new(BaseType base, Span span) {
+  Type *type = ((Type *)calloc(1, sizeof(Type)));
+  type->base = base;
+  type->span = span;
+  return type;
+}
+
+static Type *Type__new_link(BaseType base, Type *next, Span span) {
+  Type *type = Type__new(base, span);
+  type->ptr = next;
+  if (((base == BaseType__Pointer && ((bool)next)) && next->base == BaseType__Char)) {
+    type->name = "string";
+  } 
+  return type;
+}
+
+static Type *Type__ptr_to(BaseType base, Span span) {
+  Type *next = Type__new(base, span);
+  return Type__new_link(BaseType__Pointer, next, span);
+}
+
+static Type *Type__simd_from_name(char *name, Span span) {
+  i32 len = strlen(name);
+  i32 sep = 0;
+  while (((sep < len) && (name[sep] != 'x'))) {
+    sep += 1;
+  } 
+  if ((sep == 0 || ((sep + 1) >= len))) 
+  return NULL;
+  
+  for (i32 i = (sep + 1); (i < len); i += 1) {
+    if ((!isdigit(name[i]))) 
+    return NULL;
+    
+  } 
+  char *elem = string__substring(name, 0, sep);
+  BaseType base = ({ BaseType __yield_0;
+  {
+    char *__match_str = elem;
+    switch (aecor_hash_str(__match_str, 2166136261u)) {
+      case 1074601716u:
+        if (!strcmp(__match_str, "i8")) goto __match_1_0;
+        break;
+      case 833762287u:
+        if (!strcmp(__match_str, "i16")) goto __match_1_1;
+        break;
+      case 918736459u:
+        if (!strcmp(__match_str, "i32")) goto __match_1_2;
+        break;
+      case 3966529125u:
+        if (!strcmp(__match_str, "i64")) goto __match_1_3;
+        break;
+      case 3926084466u:
+        if (!strcmp(__match_str, "u8")) goto __match_1_4;
+        break;
+      case 4148185419u:
+        if (!strcmp(__match_str, "u16")) goto __match_1_5;
+        break;
+      case 1849896378u:
+        if (!strcmp(__match_str, "u32")) goto __match_1_6;
+        break;
+      case 2500781617u:
+        if (!strcmp(__match_str, "u64")) goto __match_1_7;
+        break;
+      case 859369167u:
+        if (!strcmp(__match_str, "f32")) goto __match_1_8;
+        break;
+      case 861975295u:
+        if (!strcmp(__match_str, "f64")) goto __match_1_9;
+        break;
+    }
+    goto __match_1_default;
+    __match_1_0: {
+      __yield_0 = BaseType__I8;
+} goto __match_1_end;
+    __match_1_1: {
+      __yield_0 = BaseType__I16;
+} goto __match_1_end;
+    __match_1_2: {
+      __yield_0 = BaseType__I32;
+} goto __match_1_end;
+    __match_1_3: {
+      __yield_0 = BaseType__I64;
+} goto __match_1_end;
+    __match_1_4: {
+      __yield_0 = BaseType__U8;
+} goto __match_1_end;
+    __match_1_5: {
+      __yield_0 = BaseType__U16;
+} goto __match_1_end;
+    __match_1_6: {
+      __yield_0 = BaseType__U32;
+} goto __match_1_end;
+    __match_1_7: {
+      __yield_0 = BaseType__U64;
+} goto __match_1_end;
+    __match_1_8: {
+      __yield_0 = BaseType__F32;
+} goto __match_1_end;
+    __match_1_9: {
+      __yield_0 = BaseType__F64;
+} goto __match_1_end;
+    __match_1_default: {
+      __yield_0 = BaseType__Error;
+}
+    __match_1_end:;
+  }
+;__yield_0; });
+  free(elem);
+  if (base == BaseType__Error) 
+  return NULL;
+  
+  char *digits = (&name[(sep + 1)]);
+  i32 lanes = atoi(digits);
+  if ((((lanes < 2) || (lanes > 64)) || ((lanes & (lanes - 1)) != 0))) 
+  return NULL;
+  
+  Type *type = Type__new_link(BaseType__Simd, Type__new(base, span), span);
+  type->lanes = lanes;
+  return type;
+}
+
+static bool Type__is_struct_or_ptr(Type *this) {
+  if (this->base == BaseType__Structure) 
+  return true;
+  
+  if ((this->base != BaseType__Pointer)) 
+  return false;
+  
+  return this->ptr->base == BaseType__Structure;
+}
+
+static bool Type__is_integer(Type *this) {
+  return ({ bool __yield_0;
+  switch (this->base) {
+    case BaseType__I8:
+    case BaseType__I16:
+    case BaseType__I32:
+    case BaseType__I64:
+    case BaseType__U8:
+    case BaseType__U16:
+    case BaseType__U32:
+    case BaseType__U64: {
+      __yield_0 = true;
+} break;
+    default: {
+      __yield_0 = false;
+} break;
+  }
+;__yield_0; });
+}
+
+static bool Type__is_float(Type *this) {
+  return (this->base == BaseType__F32 || this->base == BaseType__F64);
+}
+
+static bool Type__is_numeric(Type *this) {
+  return ({ bool __yield_0;
+  switch (this->base) {
+    case BaseType__I8:
+    case BaseType__I16:
+    case BaseType__I32:
+    case BaseType__I64:
+    case BaseType__U8:
+    case BaseType__U16:
+    case BaseType__U32:
+    case BaseType__U64:
+    case BaseType__F32:
+    case BaseType__F64: {
+      __yield_0 = true;
+} break;
+    default: {
+      __yield_0 = false;
+} break;
+  }
+;__yield_0; });
+}
+
+static bool Type__is_numeric_or_char(Type *this) {
+  return (Type__is_numeric(this) || this->base == BaseType__Char);
+}
+
+static bool Type__eq(Type *this, Type *other) {
+  if ((this == NULL && other == NULL)) 
+  return true;
+  
+  if ((this == NULL || other == NULL)) 
+  return false;
+  
+  if ((this->base != other->base)) 
+  return false;
+  
+  switch (this->base) {
+    case BaseType__Method:
+    case BaseType__Error: {
+      return false;
+    } break;
+    case BaseType__Array: {
+      return Type__eq(this->ptr, other->ptr);
+    } break;
+    case BaseType__Function: {
+      if ((!Type__eq(this->return_type, other->return_type))) 
+      return false;
+      
+      if ((this->params->size != other->params->size)) 
+      return false;
+      
+      for (i32 i = 0; (i < this->params->size); i += 1) {
+        Variable *a = ((Variable *)Vector__at(this->params, i));
+        Variable *b = ((Variable *)Vector__at(other->params, i));
+        if ((!Type__eq(a->type, b->type))) 
+        return false;
+        
+      } 
+      return true;
+    } break;
+    case BaseType__Structure: {
+      return string__eq(this->name, other->name);
+    } break;
+    case BaseType__Simd: {
+      return (this->lanes == other->lanes && Type__eq(this->ptr, other->ptr));
+    } break;
+    case BaseType__Pointer: {
+      if ((this->ptr->base == BaseType__Void || other->ptr->base == BaseType__Void)) {
+        return true;
+      } 
+      return Type__eq(this->ptr, other->ptr);
+    } break;
+    default: {
+      return true;
+    } break;
+  }
+}
+
+static char *Type__str(Type *this) {
+  return ({ char *__yield_0;
+  switch (this->base) {
+    case BaseType__Pointer: {
+      __yield_0 = format_string("&%s", Type__str(this->ptr));
+} break;
+    case BaseType__Array: {
+      __yield_0 = format_string("[%s]", Type__str(this->ptr));
+} break;
+    case BaseType__Simd: {
+      __yield_0 = format_string("%sx%d", Type__str(this->ptr), this->lanes);
+} break;
+    case BaseType__Structure: {
+      __yield_0 = this->name;
+} break;
+    case BaseType__Function: {
+      __yield_0 = "<function>";
+} break;
+    case BaseType__Method: {
+      __yield_0 = "<method>";
+} break;
+    default: {
+      __yield_0 = BaseType__str(this->base);
+} break;
+  }
+;__yield_0; });
+}
+
+static bool Type__is_string(Type *this) {
+  return (this->base == BaseType__Pointer && this->ptr->base == BaseType__Char);
+}
+
+static Type *Type__decay_array(Type *this) {
+  if ((this->base != BaseType__Array)) 
+  return this;
+  
+  return Type__new_link(BaseType__Pointer, this->ptr, this->span);
+}
+
+static bool Type__is_enum(Type *this) {
+  return ((this->base == BaseType__Structure && ((bool)this->struct_def)) && this->struct_def->is_enum);
+}
+
+static bool Type__is_struct(Type *this) {
+  return (this->base == BaseType__Structure && (!Type__is_enum(this)));
+}
+
+static bool Type__is_array(Type *this) {
+  return this->base == BaseType__Array;
+}
+
+static bool Type__is_simd(Type *this) {
+  return this->base == BaseType__Simd;
+}
+
+static f32 minf(f32 a, f32 b) {
+  if ((a < b)) 
+  return a;
+   else 
+  return b;
+  
+}
+
+static f32 maxf(f32 a, f32 b) {
+  if ((a > b)) 
+  return a;
+   else 
+  return b;
+  
+}
+
+static f32 clampf(f32 x, f32 min, f32 max) {
+  return maxf(minf(x, max), min);
+}
+
+static f32 clamp01(f32 x) {
+  return clampf(x, 0.0, 1.0);
+}
+
+static f32 degrees(f32 radians) {
+  return ((radians * 180.0) / M_PI);
+}
+
+static f32 radians(f32 degrees) {
+  return ((degrees * M_PI) / 180.0);
+}
+
+static i32 edit_distance(char *str1, char *str2) {
+  i32 n = strlen(str1);
+  i32 m = strlen(str2);
+  i32 stride = (m + 1);
+  i32 d[(n + 1)][(m + 1)];
+  for (i32 i = 0; (i <= n); i += 1) {
+    d[i][0] = i;
+  } 
+  for (i32 j = 0; (j <= m); j += 1) {
+    d[0][j] = j;
+  } 
+  for (i32 i = 1; (i <= n); i += 1) {
+    for (i32 j = 1; (j <= m); j += 1) {
+      i32 x = (d[(i - 1)][j] + 1);
+      i32 y = (d[i][(j - 1)] + 1);
+      i32 z;
+      if (str1[(i - 1)] == str2[(j - 1)]) {
+        z = d[(i - 1)][(j - 1)];
+      }  else {
+        z = (d[(i - 1)][(j - 1)] + 1);
+      } 
+      d[i][j] = min(x, min(y, z));
+    } 
+  } 
+  i32 result = d[n][m];
+  return result;
+}
+
+static char *find_word_suggestion(char *s, Vector *options) {
+  i32 threshold = 5;
+  if (options->size == 0) 
+  return NULL;
+  
+  char *closest = ((char *)Vector__at(options, 0));
+  i32 closest_distance = edit_distance(s, closest);
+  for (i32 i = 1; (i < options->size); i += 1) {
+    char *option = ((char *)Vector__at(options, i));
+    i32 distance = edit_distance(s, option);
+    if ((distance < closest_distance)) {
+      closest = option;
+      closest_distance = distance;
+    } 
+  } 
+  if ((closest_distance > threshold)) 
+  return NULL;
+  
+  return closest;
+}
+
+static u32 hash_string(char *s, u32 seed) {
+  u32 hash = seed;
+  i32 len = strlen(s);
+  for (i32 i = 0; (i < len); i += 1) {
+    hash = ((hash ^ ((u32)((u8)s[i]))) * 16777619);
+  } 
+  hash = ((hash ^ (hash >> 16)) * 0x85ebca6b);
+  hash = ((hash ^ (hash >> 13)) * 0xc2b2ae35);
+  return (hash ^ (hash >> 16));
+}
+
+static char *ErrorType__str(ErrorType this) {
+  return ({ char *__yield_0;
+  switch (this) {
+    case ErrorType__Standard: {
+      __yield_0 = "Standard";
+} break;
+    case ErrorType__WithNote: {
+      __yield_0 = "WithNote";
+} break;
+    case ErrorType__WithHint: {
+      __yield_0 = "WithHint";
+} break;
+  }
+;__yield_0; });
+}
+
+static char *MessageType__to_color(MessageType this) {
+  return ({ char *__yield_0;
+  switch (this) {
+    case MessageType__Error: {
+      __yield_0 = "\x1b[31m";
+} break;
+    case MessageType__Warning: {
+      __yield_0 = "\x1b[33m";
+} break;
+    case MessageType__Note: {
+      __yield_0 = "\x1b[32m";
+} break;
+  }
+;__yield_0; });
+}
+
+static char *MessageType__str(MessageType this) {
+  return ({ char *__yield_0;
+  switch (this) {
+    case MessageType__Error: {
+      __yield_0 = "Error";
+} break;
+    case MessageType__Warning: {
+      __yield_0 = "Warning";
+} break;
+    case MessageType__Note: {
+      __yield_0 = "Note";
+} break;
+  }
+;__yield_0; });
+}
+
+static void display_line(void) {
+  printf("--------------------------------------------------------------------------------""\n");
+}
+
+static void display_message(MessageType type, Span span, char *msg) {
+  display_line();
+  printf("%s: %s: %s""\n", Location__str(span.start), MessageType__str(type), msg);
+  display_line();
+}
+
+static void display_message_span(MessageType type, Span span, char *msg) {
+  char *color = MessageType__to_color(type);
+  char *reset = "\x1b[0m";
+  char *filename = span.start.filename;
+  FILE *file = File__open(filename, "r");
+  ;
+  char *contents = File__slurp(file);
+  ;
+  i32 around_offset = 1;
+  i32 min_line = max((span.start.line - around_offset), 1);
+  i32 max_line = (span.end.line + around_offset);
+  display_message(type, span, msg);
+  char *lines = contents;
+  char *cur = strsep((&lines), "\n");
+  i32 line_no = 1;
+  while ((((bool)cur) && (line_no <= max_line))) {
+    if (((line_no >= min_line) && (line_no <= max_line))) {
+      printf("%4d | ", line_no);
+      if (line_no == span.start.line) {
+        i32 start_col = (span.start.col - 1);
+        i32 end_col = (span.end.col - 1);
+        if ((span.end.line != span.start.line)) {
+          end_col = strlen(cur);
+        } 
+        for (i32 i = 0; (i < start_col); i += 1) {
+          printf("%c", cur[i]);
+        } 
+        printf("%s", color);
+        for (i32 i = start_col; (i < end_col); i += 1) {
+          printf("%c", cur[i]);
+        } 
+        printf("%s%s""\n", reset, (cur + end_col));
+        printf("%*s%s^ %s%s""\n", (start_col + 7), "", color, msg, reset);
+      }  else {
+        printf("%s""\n", cur);
+      } 
+    } 
+    line_no += 1;
+    cur = strsep((&lines), "\n");
+  } 
+
+  /* defers */
+  free(contents);
+  fclose(file);
+}
+
+static void Error__display(Error *this) {
+  switch (this->type) {
+    case ErrorType__Standard: {
+      display_message_span(MessageType__Error, this->span1, this->msg1);
+      display_line();
+    } break;
+    case ErrorType__WithNote: {
+      display_message_span(MessageType__Error, this->span1, this->msg1);
+      display_message(MessageType__Note, this->span1, this->msg2);
+    } break;
+    case ErrorType__WithHint: {
+      display_message_span(MessageType__Error, this->span1, this->msg1);
+      display_message_span(MessageType__Note, this->span2, this->msg2);
+      display_line();
+    } break;
+  }
+}
+
+static __attribute__((noreturn)) void Error__panic(Error *this) {
+  Error__display(this);
+  exit(1);
+}
+
+static Error *Error__new(Span span, char *msg) {
+  Error *err = ((Error *)calloc(1, sizeof(Error)));
+  err->type = ErrorType__Standard;
+  err->msg1 = msg;
+  err->span1 = span;
+  return err;
+}
+
+static Error *Error__new_note(Span span, char *msg, char *note) {
+  Error *err = ((Error *)calloc(1, sizeof(Error)));
+  err->type = ErrorType__WithNote;
+  err->msg1 = msg;
+  err->span1 = span;
+  err->msg2 = note;
+  return err;
+}
+
+static Error *Error__new_hint(Span span, char *msg, Span span2, char *hint) {
+  Error *err = ((Error *)calloc(1, sizeof(Error)));
+  err->type = ErrorType__WithHint;
+  err->msg1 = msg;
+  err->span1 = span;
+  err->msg2 = hint;
+  err->span2 = span2;
+  return err;
+}
+
+static void display_error_messages(Vector *errors, i32 detail_level) {
+  char *num_errors_env = getenv("AECOR_NUM_ERRORS");
+  i32 max_num_errors = (((bool)num_errors_env) ? atoi(num_errors_env) : 10);
+  i32 num_errors = min(errors->size, max_num_errors);
+  bool first = true;
+  for (i32 i = (num_errors - 1); (i >= 0); i -= 1) {
+    Error *err = ((Error *)Vector__at(errors, i));
+    switch (detail_level) {
+      case 0: {
+        printf("%s: %s""\n", Location__str(err->span1.start), err->msg1);
+      } break;
+      case 1: {
+        display_message_span(MessageType__Error, err->span1, err->msg1);
+      } break;
+      case 2: {
+        if (first) 
+        printf("""\n");
+        
+        first = false;
+        Error__display(err);
+      } break;
+      default: panic("invalid detail level"); break;
+    }
+  } 
+}
+
+static ASTType ASTType__from_token(TokenType type) {
+  return ({ ASTType __yield_0;
+  switch (type) {
+    case TokenType__Ampersand: {
+      __yield_0 = ASTType__BitwiseAnd;
+} break;
+    case TokenType__And: {
+      __yield_0 = ASTType__And;
+} break;
+    case TokenType__Caret: {
+      __yield_0 = ASTType__BitwiseXor;
+} break;
+    case TokenType__EqualEquals: {
+      __yield_0 = ASTType__Equals;
+} break;
+    case TokenType__Equals: {
+      __yield_0 = ASTType__Assignment;
+} break;
+    case TokenType__GreaterThan: {
+      __yield_0 = ASTType__GreaterThan;
+} break;
+    case TokenType__GreaterThanEquals: {
+      __yield_0 = ASTType__GreaterThanEquals;
+} break;
+    case TokenType__GreaterThanGreaterThan: {
+      __yield_0 = ASTType__RightShift;
+} break;
+    case TokenType__LessThan: {
+      __yield_0 = ASTType__LessThan;
+} break;
+    case TokenType__LessThanEquals: {
+      __yield_0 = ASTType__LessThanEquals;
+} break;
+    case TokenType__LessThanLessThan: {
+      __yield_0 = ASTType__LeftShift;
+} break;
+    case TokenType__Line: {
+      __yield_0 = ASTType__BitwiseOr;
+} break;
+    case TokenType__Minus: {
+      __yield_0 = ASTType__Minus;
+} break;
+    case TokenType__MinusEquals: {
+      __yield_0 = ASTType__MinusEquals;
+} break;
+    case TokenType__NotEquals: {
+      __yield_0 = ASTType__NotEquals;
+} break;
+    case TokenType__Or: {
+      __yield_0 = ASTType__Or;
+} break;
+    case TokenType__Percent: {
+      __yield_0 = ASTType__Modulus;
+} break;
+    case TokenType__Plus: {
+      __yield_0 = ASTType__Plus;
+} break;
+    case TokenType__PlusEquals: {
+      __yield_0 = ASTType__PlusEquals;
+} break;
+    case TokenType__Slash: {
+      __yield_0 = ASTType__Divide;
+} break;
+    case TokenType__SlashEquals: {
+      __yield_0 = ASTType__DivideEquals;
+} break;
+    case TokenType__Star: {
+      __yield_0 = ASTType__Multiply;
+} break;
+    case TokenType__StarEquals: {
+      __yield_0 = ASTType__MultiplyEquals;
+} break;
+    case TokenType__Tilde: {
+      __yield_0 = ASTType__BitwiseNot;
+} break;
+    default: panic(format_string("Unhandled token type in ASTType::from_token: %s", TokenType__str(type))); break;
+  }
+;__yield_0; });
+}
+
+static Variable *Variable__new(char *name, Type *type, Span span) {
+  Variable *var = ((Variable *)calloc(1, sizeof(Variable)));
+  var->name = name;
+  var->type = type;
+  var->span = span;
+  return var;
+}
+
+static Function *Function__new(Span span) {
+  Function *func = ((Function *)calloc(1, sizeof(Function)));
+  func->params = Vector__new();
+  func->span = span;
+  return func;
+}
+
+static Structure *Structure__new(Span span) {
+  Structure *struc = ((Structure *)calloc(1, sizeof(Structure)));
+  struc->fields = Vector__new();
+  struc->span = span;
+  return struc;
+}
+
+static Variable *Structure__find_field(Structure *this, char *name) {
+  for (i32 i = 0; (i < this->fields->size); i += 1) {
+    Variable *field = ((Variable *)Vector__at(this->fields, i));
+    if (string__eq(field->name, name)) {
+      return field;
+    } 
+  } 
+  return NULL;
+}
+
+static Program *Program__new(void) {
+  Program *prog = ((Program *)calloc(1, sizeof(Program)));
+  prog->functions = Vector__new();
+  prog->structures = Vector__new();
+  prog->global_vars = Vector__new();
+  prog->constants = Vector__new();
+  prog->included_files = Map__new();
+  prog->errors = Vector__new();
+  prog->c_flags = Vector__new();
+  prog->c_includes = Vector__new();
+  prog->c_embed_headers = Vector__new();
+  return prog;
+}
+
+static bool Program__is_file_included(Program *this, char *filename) {
+  i32 len = strlen(filename);
+  if ((((len > 2) && filename[0] == '.') && filename[1] == '/')) {
+    filename = (&filename[2]);
+  } 
+  return Map__exists(this->included_files, filename);
+}
+
+static void Program__add_included_file(Program *this, char *filename) {
+  i32 len = strlen(filename);
+  if ((((len > 2) && filename[0] == '.') && filename[1] == '/')) {
+    filename = (&filename[2]);
+  } 
+  Map__insert(this->included_files, filename, filename);
+}
+
+static Argument *Argument__new(AST *label, AST *expr) {
+  Argument *arg = ((Argument *)calloc(1, sizeof(Argument)));
+  arg->expr = expr;
+  arg->label = label;
+  return arg;
+}
+
+static MatchCase *MatchCase__new(AST *cond, AST *body) {
+  MatchCase *_case = ((MatchCase *)calloc(1, sizeof(MatchCase)));
+  _case->cond = cond;
+  _case->body = body;
+  return _case;
+}
+
+static AST *AST__new(ASTType type, Span span) {
+  AST *ast = ((AST *)calloc(1, sizeof(AST)));
+  ast->type = type;
+  ast->span = span;
+  return ast;
+}
+
+static AST *AST__new_unop(ASTType type, Span span, AST *expr) {
+  AST *ast = AST__new(type, span);
+  ast->u.unary = expr;
+  return ast;
+}
+
+static AST *AST__new_binop(ASTType type, AST *lhs, AST *rhs) {
+  AST *ast = AST__new(type, Span__join(lhs->span, rhs->span));
+  ast->u.binary.lhs = lhs;
+  ast->u.binary.rhs = rhs;
+  return ast;
+}
+
+static bool AST__callee_is(AST *this, char *expected) {
+  if ((!((bool)this))) 
+  return false;
+  
+  if ((this->type != ASTType__Call)) 
+  return false;
+  
+  if ((this->u.call.callee->type != ASTType__Identifier)) 
+  return false;
+  
+  char *name = this->u.call.callee->u.ident.name;
+  return string__eq(name, expected);
+}
+
+static bool AST__is_lvalue(AST *this) {
+  return ({ bool __yield_0;
+  switch (this->type) {
+    case ASTType__Dereference: {
+      __yield_0 = true;
+} break;
+    case ASTType__Index: {
+      __yield_0 = true;
+} break;
+    case ASTType__Member: {
+      __yield_0 = (!this->u.member.is_method);
+} break;
+    case ASTType__Identifier: {
+      __yield_0 = (!this->u.ident.is_function);
+} break;
+    default: {
+      __yield_0 = false;
+} break;
+  }
+;__yield_0; });
+}
+
+static bool is_hex_digit(char c) {
+  if (isdigit(c)) 
+  return true;
+  
+  if ((('a' <= c) && (c <= 'f'))) 
+  return true;
+  
+  if ((('A' <= c) && (c <= 'F'))) 
+  return true;
+  
+  return false;
+}
+
+static Lexer Lexer__make(char *source, char *filename) {
+  return (Lexer){source, .source_len = strlen(source), .i = 0, .loc = (Location){filename, 1, 1, 0}, .seen_newline = false, .tokens = Vector__new(), .errors = Vector__new()};
+}
+
+static void Lexer__push(Lexer *this, Token *token) {
+  token->seen_newline = this->seen_newline;
+  Vector__push(this->tokens, token);
+  this->seen_newline = false;
+}
+
+static void Lexer__push_type(Lexer *this, TokenType type, i32 len) {
+  Location start_loc = this->loc;
+  for (i32 i = 0; (i < len); i += 1) {
+    Lexer__inc(this);
+  } 
+  Lexer__push(this, Token__from_type(type, (Span){start_loc, this->loc}));
+}
+
+static inline __attribute__((always_inline)) char Lexer__cur(Lexer *this) {
+  return this->source[this->i];
+}
+
+static void Lexer__inc(Lexer *this) {
+  switch (Lexer__cur(this)) {
+    case '\n': {
+      this->loc.line += 1;
+      this->loc.col = 1;
+      this->seen_newline = true;
+    } break;
+    default: {
+      this->loc.col += 1;
+    } break;
+  }
+  this->i += 1;
+  this->loc.index += 1;
+}
+
+static char Lexer__peek(Lexer *this, i32 offset) {
+  if (Lexer__cur(this) == '\0') {
+    return Lexer__cur(this);
+  } 
+  return this->source[(this->i + 1)];
+}
+
+static void Lexer__lex_char_literal(Lexer *this) {
+  Location start_loc = this->loc;
+  i32 start = (this->i + 1);
+  Lexer__inc(this);
+  if (Lexer__cur(this) == '\\') {
+    Lexer__inc(this);
+  } 
+  Lexer__inc(this);
+  if ((Lexer__cur(this) != '\'')) {
+    Vector__push(this->errors, Error__new((Span){this->loc, this->loc}, "Expected ' after character literal"));
+  } 
+  i32 len = (this->i - start);
+  char *text = string__substring(this->source, start, len);
+  Lexer__inc(this);
+  Lexer__push(this, Token__new(TokenType__CharLiteral, (Span){start_loc, this->loc}, text));
+}
+
+static void Lexer__lex_string_literal(Lexer *this) {
+  Location start_loc = this->loc;
+  char end_char = Lexer__cur(this);
+  i32 start = (this->i + 1);
+  Lexer__inc(this);
+  while (((this->i < this->source_len) && (Lexer__cur(this) != end_char))) {
+    if (Lexer__cur(this) == '\\') {
+      Lexer__inc(this);
+    } 
+    Lexer__inc(this);
+  } 
+  i32 len = (this->i - start);
+  char *text = string__substring(this->source, start, len);
+  Lexer__inc(this);
+  if ((this->i >= this->source_len)) {
+    Vector__push(this->errors, Error__new((Span){this->loc, this->loc}, "Unterminated string literal"));
+  } 
+  if (end_char == '`') {
+    Lexer__push(this, Token__new(TokenType__FormatStringLiteral, (Span){start_loc, this->loc}, text));
+  }  else {
+    Lexer__push(this, Token__new(TokenType__StringLiteral, (Span){start_loc, this->loc}, text));
+  } 
+}
+
+static Token *Lexer__lex_int_literal_different_base(Lexer *this) {
+  Location start_loc = this->loc;
+  i32 start = this->i;
+  Lexer__inc(this);
+  switch (Lexer__cur(this)) {
+    case 'x': {
+      Lexer__inc(this);
+      while (((this->i < this->source_len) && is_hex_digit(Lexer__cur(this)))) {
+        Lexer__inc(this);
+      } 
+    } break;
+    case 'b': {
+      Lexer__inc(this);
+      while ((((this->i < this->source_len) && Lexer__cur(this) == '0') || Lexer__cur(this) == '1')) {
+        Lexer__inc(this);
+      } 
+    } break;
+    default: {
+    } break;
+  }
+  i32 len = (this->i - start);
+  char *text = string__substring(this->source, start, len);
+  return Token__new(TokenType__IntLiteral, (Span){start_loc, this->loc}, text);
+}
+
+static Token *Lexer__lex_numeric_literal_helper(Lexer *this) {
+  Location start_loc = this->loc;
+  if (Lexer__cur(this) == '0') {
+    switch (Lexer__peek(this, 1)) {
+      case 'x':
+      case 'b': {
+        return Lexer__lex_int_literal_different_base(this);
+      } break;
+      default: {
+      } break;
+    }
+  } 
+  i32 start = this->i;
+  TokenType token_type;
+  while (isdigit(Lexer__cur(this))) {
+    Lexer__inc(this);
+  } 
+  if (Lexer__cur(this) == '.') {
+    Lexer__inc(this);
+    while (isdigit(Lexer__cur(this))) {
+      Lexer__inc(this);
+    } 
+    token_type = TokenType__FloatLiteral;
+  }  else {
+    token_type = TokenType__IntLiteral;
+  } 
+  i32 len = (this->i - start);
+  char *text = string__substring(this->source, start, len);
+  return Token__new(token_type, (Span){start_loc, this->loc}, text);
+}
+
+static void Lexer__lex_numeric_literal(Lexer *this) {
+  Token *token = Lexer__lex_numeric_literal_helper(this);
+  if (((Lexer__cur(this) == 'u' || Lexer__cur(this) == 'i') || Lexer__cur(this) == 'f')) {
+    Location start_loc = this->loc;
+    i32 start = this->i;
+    Lexer__inc(this);
+    while (((this->i < this->source_len) && isdigit(Lexer__cur(this)))) {
+      Lexer__inc(this);
+    } 
+    i32 len = (this->i - start);
+    char *suffix = string__substring(this->source, start, len);
+    token->suffix = Token__from_ident(suffix, (Span){start_loc, this->loc});
+  } 
+  Lexer__push(this, token);
+}
+
+static Vector *Lexer__lex(Lexer *this) {
+  while ((this->i < this->source_len)) {
+    char c = Lexer__cur(this);
+    switch (c) {
+      case ' ':
+      case '\t':
+      case '\v':
+      case '\r':
+      case '\b':
+      case '\n': {
+        Lexer__inc(this);
+      } break;
+      case ';': {
+        Lexer__push_type(this, TokenType__Semicolon, 1);
+      } break;
+      case ',': {
+        Lexer__push_type(this, TokenType__Comma, 1);
+      } break;
+      case '.': {
+        Lexer__push_type(this, TokenType__Dot, 1);
+      } break;
+      case '(': {
+        Lexer__push_type(this, TokenType__OpenParen, 1);
+      } break;
+      case ')': {
+        Lexer__push_type(this, TokenType__CloseParen, 1);
+      } break;
+      case '[': {
+        Lexer__push_type(this, TokenType__OpenSquare, 1);
+      } break;
+      case ']': {
+        Lexer__push_type(this, TokenType__CloseSquare, 1);
+      } break;
+      case '{': {
+        Lexer__push_type(this, TokenType__OpenCurly, 1);
+      } break;
+      case '}': {
+        Lexer__push_type(this, TokenType__CloseCurly, 1);
+      } break;
+      case '@': {
+        Lexer__push_type(this, TokenType__AtSign, 1);
+      } break;
+      case '%': {
+        Lexer__push_type(this, TokenType__Percent, 1);
+      } break;
+      case '^': {
+        Lexer__push_type(this, TokenType__Caret, 1);
+      } break;
+      case '&': {
+        Lexer__push_type(this, TokenType__Ampersand, 1);
+      } break;
+      case '|': {
+        Lexer__push_type(this, TokenType__Line, 1);
+      } break;
+      case '?': {
+        Lexer__push_type(this, TokenType__Question, 1);
+      } break;
+      case '~': {
+        Lexer__push_type(this, TokenType__Tilde, 1);
+      } break;
+      case '!': {
+        switch (Lexer__peek(this, 1)) {
+          case '=': {
+            Lexer__push_type(this, TokenType__NotEquals, 2);
+          } break;
+          default: {
+            Lexer__push_type(this, TokenType__Exclamation, 1);
+          } break;
+        }
+      } break;
+      case ':': {
+        switch (Lexer__peek(this, 1)) {
+          case ':': {
+            Lexer__push_type(this, TokenType__ColonColon, 2);
+          } break;
+          default: {
+            Lexer__push_type(this, TokenType__Colon, 1);
+          } break;
+        }
+      } break;
+      case '=': {
+        switch (Lexer__peek(this, 1)) {
+          case '=': {
+            Lexer__push_type(this, TokenType__EqualEquals, 2);
+          } break;
+          case '>': {
+            Lexer__push_type(this, TokenType__FatArrow, 2);
+          } break;
+          default: {
+            Lexer__push_type(this, TokenType__Equals, 1);
+          } break;
+        }
+      } break;
+      case '*': {
+        switch (Lexer__peek(this, 1)) {
+          case '=': {
+            Lexer__push_type(this, TokenType__StarEquals, 2);
+          } break;
+          default: {
+            Lexer__push_type(this, TokenType__Star, 1);
+          } break;
+        }
+      } break;
+      case '+': {
+        switch (Lexer__peek(this, 1)) {
+          case '=': {
+            Lexer__push_type(this, TokenType__PlusEquals, 2);
+          } break;
+          default: {
+            Lexer__push_type(this, TokenType__Plus, 1);
+          } break;
+        }
+      } break;
+      case '-': {
+        switch (Lexer__peek(this, 1)) {
+          case '=': {
+            Lexer__push_type(this, TokenType__MinusEquals, 2);
+          } break;
+          default: {
+            Lexer__push_type(this, TokenType__Minus, 1);
+          } break;
+        }
+      } break;
+      case '<': {
+        switch (Lexer__peek(this, 1)) {
+          case '=': {
+            Lexer__push_type(this, TokenType__LessThanEquals, 2);
+          } break;
+          case '<': {
+            Lexer__push_type(this, TokenType__LessThanLessThan, 2);
+          } break;
+          default: {
+            Lexer__push_type(this, TokenType__LessThan, 1);
+          } break;
+        }
+      } break;
+      case '>': {
+        switch (Lexer__peek(this, 1)) {
+          case '=': {
+            Lexer__push_type(this, TokenType__GreaterThanEquals, 2);
+          } break;
+          case '>': {
+            Lexer__push_type(this, TokenType__GreaterThanGreaterThan, 2);
+          } break;
+          default: {
+            Lexer__push_type(this, TokenType__GreaterThan, 1);
+          } break;
+        }
+      } break;
+      case '/': {
+        switch (Lexer__peek(this, 1)) {
+          case '/': {
+            Lexer__inc(this);
+            while (((this->i < this->source_len) && (Lexer__cur(this) != '\n'))) {
+              Lexer__inc(this);
+            } 
+          } break;
+          case '=': {
+            Lexer__push_type(this, TokenType__SlashEquals, 2);
+          } break;
+          default: {
+            Lexer__push_type(this, TokenType__Slash, 1);
+          } break;
+        }
+      } break;
+      case '\'': {
+        Lexer__lex_char_literal(this);
+      } break;
+      case '"':
+      case '`': {
+        Lexer__lex_string_literal(this);
+      } break;
+      default: {
+        Location start_loc = this->loc;
+        if (isdigit(c)) {
+          Lexer__lex_numeric_literal(this);
+        }  else         if ((isalpha(c) || c == '_')) {
+          i32 start = this->i;
+          while ((isalnum(Lexer__cur(this)) || Lexer__cur(this) == '_')) {
+            Lexer__inc(this);
+          } 
+          i32 len = (this->i - start);
+          char *text = string__substring(this->source, start, len);
+          Lexer__push(this, Token__from_ident(text, (Span){start_loc, this->loc}));
+        }  else {
+          Vector__push(this->errors, Error__new((Span){this->loc, this->loc}, format_string("Unrecognized char in lexer: '%c'", c)));
+          Lexer__inc(this);
+        } 
+        
+      } break;
+    }
+  } 
+  this->seen_newline = true;
+  Lexer__push_type(this, TokenType__EOF, 0);
+  return this->tokens;
+}
+
+static ParserContext *ParserContext__new(Vector *tokens, i32 offset) {
+  ParserContext *context = ((ParserContext *)calloc(1, sizeof(ParserContext)));
+  (*context) = (ParserContext){tokens, offset};
+  return context;
+}
+
+static Template *Template__new(char *name, Vector *params, Vector *tokens, i32 start) {
+  Template *template = ((Template *)calloc(1, sizeof(Template)));
+  (*template) = (Template){name, params, tokens, start, .is_struct = false};
+  return template;
+}
+
+static Parser *Parser__new(char *filename) {
+  Parser *parser = ((Parser *)calloc(1, sizeof(Parser)));
+  parser->include_dirs = Vector__new();
+  Parser__add_include_dir(parser, ".");
+  char *tmp_filename = strdup(filename);
+  parser->project_root = strdup(dirname(tmp_filename));
+  free(tmp_filename);
+  char *aecor_root = getenv("AECOR_ROOT");
+  if (((bool)aecor_root)) {
+    Parser__add_include_dir(parser, aecor_root);
+  } 
+  parser->context_stack = Vector__new();
+  parser->templates = Map__new();
+  parser->method_templates = Map__new();
+  parser->instances = Map__new();
+  parser->pending_instances = Vector__new();
+  return parser;
+}
+
+static void Parser__push_context(Parser *this, Vector *tokens) {
+  ParserContext *cur_context = ParserContext__new(this->tokens, this->curr);
+  Vector__push(this->context_stack, cur_context);
+  this->tokens = tokens;
+  this->curr = 0;
+}
+
+static void Parser__pop_context(Parser *this) {
+  ParserContext *cur_context = ((ParserContext *)Vector__pop(this->context_stack));
+  this->tokens = cur_context->tokens;
+  this->curr = cur_context->offset;
+  free(cur_context);
+}
+
+static void Parser__add_include_dir(Parser *this, char *dir) {
+  Vector__push(this->include_dirs, dir);
+}
+
+static Error *Parser__error_msg(Parser *this, char *msg) {
+  Error *err = Error__new(Parser__token(this)->span, msg);
+  Vector__push(this->program->errors, err);
+  return err;
+}
+
+static void Parser__error(Parser *this, Error *err) {
+  Vector__push(this->program->errors, err);
+}
+
+static void Parser__unhandled_type(Parser *this, char *func) {
+  Parser__error_msg(this, format_string("Unexpected token in %s: %s", func, TokenType__str(Parser__token(this)->type)));
+}
+
+static inline __attribute__((always_inline)) Token *Parser__token(Parser *this) {
+  return Vector__at(this->tokens, this->curr);
+}
+
+static inline __attribute__((always_inline)) bool Parser__token_is(Parser *this, TokenType type) {
+  if (type == TokenType__Newline) {
+    return Parser__token(this)->seen_newline;
+  } 
+  return Parser__token(this)->type == type;
+}
+
+static bool Parser__consume_if(Parser *this, TokenType type) {
+  if (Parser__token_is(this, type)) {
+    if ((type != TokenType__Newline)) {
+      this->curr += 1;
+    } 
+    return true;
+  } 
+  return false;
+}
+
+static void Parser__consume_newline_or(Parser *this, TokenType type) {
+  if (Parser__token_is(this, type)) {
+    this->curr += 1;
+  }  else   if ((!Parser__token(this)->seen_newline)) {
+    Error__panic(Parser__error_msg(this, format_string("Expected %s or newline", TokenType__str(type))));
+  } 
+  
+}
+
+static Token *Parser__consume(Parser *this, TokenType type) {
+  Token *tok = Parser__token(this);
+  if ((!Parser__consume_if(this, type))) {
+    Error__panic(Parser__error_msg(this, format_string("Expected TokenType::%s", TokenType__str(type))));
+  } 
+  return tok;
+}
+
+static Type *Parser__parse_type_with_parent(Parser *this, Type *parent) {
+  Type *type = ((Type *)NULL);
+  Span span = Parser__token(this)->span;
+  switch (Parser__token(this)->type) {
+    case TokenType__Ampersand: {
+      type = Type__new(BaseType__Pointer, Parser__consume(this, TokenType__Ampersand)->span);
+      Parser__parse_type_with_parent(this, type);
+    } break;
+    case TokenType__Bool: {
+      type = Type__new(BaseType__Bool, Parser__consume(this, TokenType__Bool)->span);
+    } break;
+    case TokenType__Char: {
+      type = Type__new(BaseType__Char, Parser__consume(this, TokenType__Char)->span);
+    } break;
+    case TokenType__I8: {
+      type = Type__new(BaseType__I8, Parser__consume(this, TokenType__I8)->span);
+    } break;
+    case TokenType__I16: {
+      type = Type__new(BaseType__I16, Parser__consume(this, TokenType__I16)->span);
+    } break;
+    case TokenType__I32: {
+      type = Type__new(BaseType__I32, Parser__consume(this, TokenType__I32)->span);
+    } break;
+    case TokenType__I64: {
+      type = Type__new(BaseType__I64, Parser__consume(this, TokenType__I64)->span);
+    } break;
+    case TokenType__U8: {
+      type = Type__new(BaseType__U8, Parser__consume(this, TokenType__U8)->span);
+    } break;
+    case TokenType__U16: {
+      type = Type__new(BaseType__U16, Parser__consume(this, TokenType__U16)->span);
+    } break;
+    case TokenType__U32: {
+      type = Type__new(BaseType__U32, Parser__consume(this, TokenType__U32)->span);
+    } break;
+    case TokenType__U64: {
+      type = Type__new(BaseType__U64, Parser__consume(this, TokenType__U64)->span);
+    } break;
+    case TokenType__F32: {
+      type = Type__new(BaseType__F32, Parser__consume(this, TokenType__F32)->span);
+    } break;
+    case TokenType__F64: {
+      type = Type__new(BaseType__F64, Parser__consume(this, TokenType__F64)->span);
+    } break;
+    case TokenType__UntypedPtr: {
+      type = Type__ptr_to(BaseType__Void, Parser__consume(this, TokenType__UntypedPtr)->span);
+    } break;
+    case TokenType__String: {
+      type = Type__ptr_to(BaseType__Char, Parser__consume(this, TokenType__String)->span);
+      type->ptr->name = "string";
+    } break;
+    case TokenType__Identifier: {
+      Token *name = Parser__consume(this, TokenType__Identifier);
+      if ((((bool)this->type_params) && Map__exists(this->type_params, name->text))) {
+        type = ((Type *)Map__get(this->type_params, name->text));
+      }  else       if ((Parser__token_is(this, TokenType__LessThan) && Map__exists(this->templates, name->text))) {
+        Vector *args = Parser__parse_type_args(this);
+        type = Type__new(BaseType__Structure, span);
+        type->name = Parser__instantiate(this, name->text, args, span);
+      }  else {
+        type = Type__simd_from_name(name->text, span);
+        if ((!((bool)type))) {
+          type = Type__new(BaseType__Structure, span);
+          type->name = name->text;
+        } 
+      } 
+      
+    } break;
+    case TokenType__Fn: {
+      Parser__consume(this, TokenType__Fn);
+      Parser__consume(this, TokenType__OpenParen);
+      Vector *params = Vector__new();
+      while ((!Parser__token_is(this, TokenType__CloseParen))) {
+        Type *param_type = Parser__parse_type(this);
+        Vector__push(params, Variable__new("", param_type, param_type->span));
+        if ((!Parser__token_is(this, TokenType__CloseParen))) {
+          Parser__consume(this, TokenType__Comma);
+        } 
+      } 
+      Parser__consume(this, TokenType__CloseParen);
+      Type *return_type;
+      if (Parser__consume_if(this, TokenType__Colon)) {
+        return_type = Parser__parse_type(this);
+      }  else {
+        return_type = Type__new(BaseType__Void, Parser__token(this)->span);
+      } 
+      type = Type__new(BaseType__Function, Span__join(span, Parser__token(this)->span));
+      type->params = params;
+      type->return_type = return_type;
+    } break;
+    case TokenType__OpenSquare: {
+      Parser__consume(this, TokenType__OpenSquare);
+      type = Type__new(BaseType__Array, span);
+      Parser__parse_type_with_parent(this, type);
+      Parser__consume(this, TokenType__Semicolon);
+      type->size_expr = Parser__parse_expression(this, TokenType__CloseSquare);
+      type->span = Span__join(type->span, Parser__token(this)->span);
+      Parser__consume(this, TokenType__CloseSquare);
+    } break;
+    default: {
+      Parser__unhandled_type(this, "parse_type");
+      type = Type__new(BaseType__Error, Parser__token(this)->span);
+    } break;
+  }
+  if (((bool)parent)) {
+    parent->ptr = type;
+    parent->span = Span__join(parent->span, type->span);
+  } 
+  return type;
+}
+
+static Type *Parser__parse_type(Parser *this) {
+  return Parser__parse_type_with_parent(this, NULL);
+}
+
+static i32 Parser__skip_type_args(Parser *this, i32 start) {
+  i32 depth = 0;
+  for (i32 i = start; (i < this->tokens->size); i += 1) {
+    Token *tok = ((Token *)Vector__at(this->tokens, i));
+    switch (tok->type) {
+      case TokenType__LessThan: {
+        depth += 1;
+      } break;
+      case TokenType__GreaterThan: {
+        depth -= 1;
+      } break;
+      case TokenType__GreaterThanGreaterThan: {
+        depth -= 2;
+      } break;
+      case TokenType__Identifier:
+      case TokenType__Ampersand:
+      case TokenType__Comma:
+      case TokenType__Bool:
+      case TokenType__Char:
+      case TokenType__String:
+      case TokenType__UntypedPtr:
+      case TokenType__I8:
+      case TokenType__I16:
+      case TokenType__I32:
+      case TokenType__I64:
+      case TokenType__U8:
+      case TokenType__U16:
+      case TokenType__U32:
+      case TokenType__U64:
+      case TokenType__F32:
+      case TokenType__F64: {
+      } break;
+      default: {
+        return (-1);
+      } break;
+    }
+    if (depth == 0) 
+    return (i + 1);
+    
+    if ((depth < 0)) 
+    return (-1);
+    
+  } 
+  return (-1);
+}
+
+static void Parser__consume_closing_angle(Parser *this) {
+  if (this->pending_greater) {
+    this->pending_greater = false;
+  }  else   if (Parser__consume_if(this, TokenType__GreaterThanGreaterThan)) {
+    this->pending_greater = true;
+  }  else {
+    Parser__consume(this, TokenType__GreaterThan);
+  } 
+  
+}
+
+static Vector *Parser__parse_type_args(Parser *this) {
+  Vector *args = Vector__new();
+  Parser__consume(this, TokenType__LessThan);
+  while (true) {
+    Vector__push(args, Parser__parse_type(this));
+    if ((this->pending_greater || (!Parser__consume_if(this, TokenType__Comma)))) 
+    break;
+    
+  } 
+  Parser__consume_closing_angle(this);
+  return args;
+}
+
+static Vector *Parser__parse_type_params(Parser *this) {
+  Vector *params = Vector__new();
+  Parser__consume(this, TokenType__LessThan);
+  while ((!Parser__token_is(this, TokenType__GreaterThan))) {
+    Vector__push(params, Parser__consume(this, TokenType__Identifier)->text);
+    if ((!Parser__token_is(this, TokenType__GreaterThan))) {
+      Parser__consume(this, TokenType__Comma);
+    } 
+  } 
+  Parser__consume(this, TokenType__GreaterThan);
+  return params;
+}
+
+static char *Parser__mangle_type(Parser *this, Type *type) {
+  return ({ char *__yield_0;
+  switch (type->base) {
+    case BaseType__Pointer: {
+      __yield_0 = format_string("ptr_%s", Parser__mangle_type(this, type->ptr));
+} break;
+    case BaseType__Structure: {
+      __yield_0 = type->name;
+} break;
+    case BaseType__Simd: {
+      __yield_0 = Type__str(type);
+} break;
+    case BaseType__Function:
+    case BaseType__Method:
+    case BaseType__Array:
+    case BaseType__Error: {
+      Parser__error(this, Error__new(type->span, "Unsupported type argument for generic"));
+      __yield_0 = "error";
+    } break;
+    default: {
+      __yield_0 = BaseType__str(type->base);
+} break;
+  }
+;__yield_0; });
+}
+
+static char *Parser__instantiate(Parser *this, char *name, Vector *args, Span span) {
+  if (this->defining_template) 
+  return name;
+  
+  Buffer mangled = Buffer__make();
+  Buffer__puts((&mangled), name);
+  Buffer__puts((&mangled), "_");
+  for (i32 i = 0; (i < args->size); i += 1) {
+    ({ Buffer *__fmt_buf = (&mangled); Buffer__puts(__fmt_buf, "_"); Buffer__puts(__fmt_buf, Parser__mangle_type(this, ((Type *)Vector__at(args, i)))); });
+  } 
+  char *instance_name = Buffer__str((&mangled));
+  if ((!Map__exists(this->instances, instance_name))) {
+    Instance *instance = ((Instance *)calloc(1, sizeof(Instance)));
+    (*instance) = (Instance){name, args, instance_name, span};
+    Map__insert(this->instances, instance_name, instance);
+    Vector__push(this->pending_instances, instance);
+  } 
+  return instance_name;
+}
+
+static void Parser__begin_template_definition(Parser *this, Vector *params) {
+  this->defining_template = true;
+  this->type_params = Map__new();
+  for (i32 i = 0; (i < params->size); i += 1) {
+    char *param = ((char *)Vector__at(params, i));
+    Type *placeholder = Type__new(BaseType__Structure, Parser__token(this)->span);
+    placeholder->name = param;
+    Map__insert(this->type_params, param, placeholder);
+  } 
+}
+
+static void Parser__end_template_definition(Parser *this) {
+  Map__free(this->type_params);
+  this->type_params = NULL;
+  this->defining_template = false;
+}
+
+static Template *Parser__register_template(Parser *this, char *name, Vector *params, i32 start, bool is_struct) {
+  Template *template = ((Template *)Map__get(this->templates, name));
+  if ((!((bool)template))) {
+    template = Template__new(name, params, this->tokens, start);
+    Map__insert(this->templates, name, template);
+  } 
+  template->params = params;
+  template->tokens = this->tokens;
+  template->start = start;
+  template->is_struct = is_struct;
+  return template;
+}
+
+static void Parser__find_templates(Parser *this) {
+  for (i32 i = 0; ((i + 2) < this->tokens->size); i += 1) {
+    Token *tok = ((Token *)Vector__at(this->tokens, i));
+    Token *name = ((Token *)Vector__at(this->tokens, (i + 1)));
+    Token *next = ((Token *)Vector__at(this->tokens, (i + 2)));
+    if (((name->type != TokenType__Identifier) || (next->type != TokenType__LessThan))) 
+    continue;
+    
+    bool is_struct = (tok->type == TokenType__Struct || tok->type == TokenType__Union);
+    if ((!is_struct)) {
+      if ((tok->type != TokenType__Def)) 
+      continue;
+      
+      i32 end = Parser__skip_type_args(this, (i + 2));
+      if ((end < 0)) 
+      continue;
+      
+      Token *after = ((Token *)Vector__at(this->tokens, end));
+      if ((after->type != TokenType__OpenParen)) 
+      continue;
+      
+    } 
+    Parser__register_template(this, name->text, NULL, 0, is_struct);
+  } 
+}
+
+static Map *Parser__bind_type_params(Parser *this, Vector *params, Vector *args) {
+  Map *bindings = Map__new();
+  for (i32 i = 0; (i < params->size); i += 1) {
+    Map__insert(bindings, ((char *)Vector__at(params, i)), Vector__at(args, i));
+  } 
+  return bindings;
+}
+
+static void Parser__instantiate_templates(Parser *this, Program *program) {
+  while ((!Vector__empty(this->pending_instances))) {
+    Instance *instance = ((Instance *)Vector__pop(this->pending_instances));
+    Template *template = ((Template *)Map__get(this->templates, instance->template_name));
+    if ((!((bool)template))) {
+      Parser__error(this, Error__new(instance->span, "Unknown generic with this name"));
+      continue;
+    } 
+    if ((template->params->size != instance->args->size)) {
+      Parser__error(this, Error__new_note(instance->span, "Incorrect number of type arguments", format_string("Expected %d, got %d", template->params->size, instance->args->size)));
+      continue;
+    } 
+    Parser__push_context(this, template->tokens);
+    this->curr = template->start;
+    this->type_params = Parser__bind_type_params(this, template->params, instance->args);
+    this->instance_name = instance->name;
+    if (template->is_struct) {
+      Vector__push(program->structures, Parser__parse_struct(this));
+      Vector *methods = ((Vector *)Map__get(this->method_templates, template->name));
+      for (i32 i = 0; (((bool)methods) && (i < methods->size)); i += 1) {
+        Template *method = ((Template *)Vector__at(methods, i));
+        Map__free(this->type_params);
+        this->type_params = Parser__bind_type_params(this, method->params, instance->args);
+        this->curr = method->start;
+        Vector__push(program->functions, Parser__parse_function(this));
+      } 
+    }  else {
+      Vector__push(program->functions, Parser__parse_function(this));
+    } 
+    Map__free(this->type_params);
+    this->type_params = NULL;
+    Parser__pop_context(this);
+  } 
+}
+
+static AST *Parser__parse_format_string(Parser *this) {
+  Token *fstr = Parser__consume(this, TokenType__FormatStringLiteral);
+  i32 fstr_len = strlen(fstr->text);
+  Vector *expr_parts = Vector__new();
+  Vector *expr_start = Vector__new();
+  Vector *format_parts = Vector__new();
+  Vector *specifiers = Vector__new();
+  i32 count = 0;
+  i32 cur_start = 0;
+  i32 specifier_loc = (-1);
+  for (i32 i = 0; (i < fstr_len); i += 1) {
+    if (fstr->text[i] == '\\') {
+      i += 1;
+    }  else     if (fstr->text[i] == '{') {
+      if (count == 0) {
+        char *part = string__substring(fstr->text, cur_start, (i - cur_start));
+        Vector__push(format_parts, part);
+        cur_start = (i + 1);
+      } 
+      count += 1;
+    }  else     if (fstr->text[i] == '}') {
+      count -= 1;
+      if (count == 0) {
+        if ((specifier_loc > 0)) {
+          char *part = string__substring(fstr->text, cur_start, (specifier_loc - cur_start));
+          Vector__push(expr_parts, part);
+          Vector__push(expr_start, (fstr->text + cur_start));
+          specifier_loc += 1;
+          while (((specifier_loc < i) && fstr->text[specifier_loc] == ' ')) {
+            specifier_loc += 1;
+          } 
+          if (specifier_loc == i) {
+            Location loc = fstr->span.start;
+            loc.col += (specifier_loc + 1);
+            Span span = (Span){loc, loc};
+            Parser__error(this, Error__new(span, "Expected format specifier"));
+            return NULL;
+          } 
+          char *spec = string__substring(fstr->text, specifier_loc, (i - specifier_loc));
+          Vector__push(specifiers, spec);
+        }  else {
+          char *part = string__substring(fstr->text, cur_start, (i - cur_start));
+          Vector__push(expr_parts, part);
+          Vector__push(expr_start, (fstr->text + cur_start));
+          Vector__push(specifiers, NULL);
+        } 
+        cur_start = (i + 1);
+        specifier_loc = (-1);
+      }  else       if ((count < 0)) {
+        Parser__error(this, Error__new(fstr->span, "Unmatched '}' in format string"));
+        return NULL;
+      } 
+      
+    }  else     if ((fstr->text[i] == ':' && (fstr->text[(i - 1)] != '\\'))) {
+      if (((count == 1 && (fstr->text[(i - 1)] != ':')) && (fstr->text[(i + 1)] != ':'))) {
+        specifier_loc = i;
+      } 
+    } 
+    
+    
+    
+  } 
+  if ((count != 0)) {
+    Parser__error(this, Error__new(fstr->span, "Unmatched '{' in format string"));
+    return NULL;
+  } 
+  char *part = string__substring(fstr->text, cur_start, (fstr_len - cur_start));
+  Vector__push(format_parts, part);
+  AST *node = AST__new(ASTType__FormatStringLiteral, fstr->span);
+  node->u.fmt_str.parts = format_parts;
+  Location fstr_start = fstr->span.start;
+  Vector *expr_nodes = Vector__new();
+  for (i32 i = 0; (i < expr_parts->size); i += 1) {
+    char *part = ((char *)Vector__at(expr_parts, i));
+    i32 start = (((char *)Vector__at(expr_start, i)) - fstr->text);
+    Lexer lexer = Lexer__make(part, fstr_start.filename);
+    lexer.loc = fstr_start;
+    lexer.loc.col += (start + 1);
+    Vector *tokens = Lexer__lex((&lexer));
+    for (i32 i = 0; (i < lexer.errors->size); i += 1) {
+      Parser__error(this, Vector__at(lexer.errors, i));
+    } 
+    Vector__free(lexer.errors);
+    Parser__push_context(this, tokens);
+    AST *expr = Parser__parse_expression(this, TokenType__CloseCurly);
+    if ((!Parser__token_is(this, TokenType__EOF))) {
+      Parser__error(this, Error__new(expr->span, "Invalid expression in format string"));
+    } 
+    Parser__pop_context(this);
+    Vector__push(expr_nodes, expr);
+  } 
+  node->u.fmt_str.exprs = expr_nodes;
+  node->u.fmt_str.specs = specifiers;
+  Vector__free(expr_parts);
+  Vector__free(expr_start);
+  return node;
+}
+
+static Type *Parser__parse_literal_suffix_type(Parser *this, Token *suffix) {
+  if ((!((bool)suffix))) 
+  return NULL;
+  
+  Vector *tokens = Vector__new();
+  Vector__push(tokens, suffix);
+  Vector__push(tokens, Vector__back(this->tokens));
+  Parser__push_context(this, tokens);
+  Type *type = Parser__parse_type(this);
+  if ((!Parser__token_is(this, TokenType__EOF))) {
+    Location loc = Parser__token(this)->span.start;
+    Span span = (Span){loc, loc};
+    Parser__error(this, Error__new(span, "Invalid type suffix"));
+  } 
+  Parser__pop_context(this);
+  Vector__free(tokens);
+  return type;
+}
+
+static AST *Parser__parse_factor(Parser *this, TokenType end_type) {
+  AST *node = ((AST *)NULL);
+  switch (Parser__token(this)->type) {
+    case TokenType__FormatStringLiteral: {
+      node = Parser__parse_format_string(this);
+    } break;
+    case TokenType__IntLiteral: {
+      node = AST__new(ASTType__IntLiteral, Parser__token(this)->span);
+      Token *tok = Parser__consume(this, TokenType__IntLiteral);
+      node->u.num_literal = (NumLiteral){.text = tok->text, .suffix = Parser__parse_literal_suffix_type(this, tok->suffix)};
+    } break;
+    case TokenType__FloatLiteral: {
+      node = AST__new(ASTType__FloatLiteral, Parser__token(this)->span);
+      Token *tok = Parser__consume(this, TokenType__FloatLiteral);
+      node->u.num_literal = (NumLiteral){.text = tok->text, .suffix = Parser__parse_literal_suffix_type(this, tok->suffix)};
+    } break;
+    case TokenType__StringLiteral: {
+      node = AST__new(ASTType__StringLiteral, Parser__token(this)->span);
+      Token *tok = Parser__consume(this, TokenType__StringLiteral);
+      node->u.string_literal = tok->text;
+    } break;
+    case TokenType__CharLiteral: {
+      node = AST__new(ASTType__CharLiteral, Parser__token(this)->span);
+      Token *tok = Parser__consume(this, TokenType__CharLiteral);
+      node->u.char_literal = tok->text;
+    } break;
+    case TokenType__True:
+    case TokenType__False: {
+      Token *tok = Parser__consume(this, Parser__token(this)->type);
+      node = AST__new(ASTType__BoolLiteral, tok->span);
+      node->u.bool_literal = tok->type == TokenType__True;
+    } break;
+    case TokenType__Null: {
+      node = AST__new(ASTType__Null, Parser__token(this)->span);
+      Parser__consume(this, TokenType__Null);
+    } break;
+    case TokenType__Dot: {
+      Token *op = Parser__consume(this, TokenType__Dot);
+      AST *lhs = AST__new(ASTType__Identifier, op->span);
+      lhs->u.ident.name = "this";
+      lhs->u.ident.is_function = false;
+      AST *rhs = ({ AST *__yield_0;
+  if (Parser__token_is(this, TokenType__Identifier)) {
+    Token *name = Parser__consume(this, TokenType__Identifier);
+    AST *tmp = AST__new(ASTType__Identifier, name->span);
+    tmp->u.ident.name = name->text;
+    __yield_0 = tmp;
+  }  else {
+    Parser__error(this, Error__new(op->span, "Expected identifier after '.'"));
+    __yield_0 = AST__new(ASTType__Error, op->span);
+  } 
+;__yield_0; });
+      node = AST__new(ASTType__Member, Span__join(lhs->span, rhs->span));
+      node->u.member.lhs = lhs;
+      node->u.member.rhs = rhs;
+    } break;
+    case TokenType__Minus: {
+      Token *op = Parser__consume(this, TokenType__Minus);
+      AST *expr = Parser__parse_factor(this, end_type);
+      node = AST__new_unop(ASTType__UnaryMinus, Span__join(op->span, expr->span), expr);
+    } break;
+    case TokenType__Not: {
+      Token *op = Parser__consume(this, TokenType__Not);
+      AST *expr = Parser__parse_factor(this, end_type);
+      node = AST__new_unop(ASTType__Not, Span__join(op->span, expr->span), expr);
+    } break;
+    case TokenType__Tilde: {
+      Token *op = Parser__consume(this, TokenType__Tilde);
+      AST *expr = Parser__parse_factor(this, end_type);
+      node = AST__new_unop(ASTType__BitwiseNot, Span__join(op->span, expr->span), expr);
+    } break;
+    case TokenType__Ampersand: {
+      Token *op = Parser__consume(this, TokenType__Ampersand);
+      AST *expr = Parser__parse_factor(this, end_type);
+      node = AST__new_unop(ASTType__Address, Span__join(op->span, expr->span), expr);
+    } break;
+    case TokenType__Star: {
+      Token *op = Parser__consume(this, TokenType__Star);
+      AST *expr = Parser__parse_factor(this, end_type);
+      node = AST__new_unop(ASTType__Dereference, Span__join(op->span, expr->span), expr);
+    } break;
+    case TokenType__Identifier: {
+      Token *op = Parser__consume(this, TokenType__Identifier);
+      node = AST__new(ASTType__Identifier, op->span);
+      node->u.ident.name = op->text;
+      if ((((bool)this->type_params) && Map__exists(this->type_params, op->text))) {
+        Type *type = ((Type *)Map__get(this->type_params, op->text));
+        if (type->base == BaseType__Structure) 
+        node->u.ident.name = type->name;
+        
+      }  else       if ((Parser__token_is(this, TokenType__LessThan) && Map__exists(this->templates, op->text))) {
+        i32 end = Parser__skip_type_args(this, this->curr);
+        if ((end >= 0)) {
+          Token *next = ((Token *)Vector__at(this->tokens, end));
+          if ((next->type == TokenType__ColonColon || next->type == TokenType__OpenParen)) {
+            Vector *args = Parser__parse_type_args(this);
+            node->u.ident.name = Parser__instantiate(this, op->text, args, op->span);
+          } 
+        } 
+      } 
+      
+    } break;
+    case TokenType__OpenParen: {
+      Token *open = Parser__consume(this, TokenType__OpenParen);
+      node = Parser__parse_expression(this, TokenType__CloseParen);
+      Token *close = Parser__consume(this, TokenType__CloseParen);
+      node->span = Span__join(open->span, close->span);
+    } break;
+    case TokenType__SizeOf: {
+      Token *start = Parser__consume(this, TokenType__SizeOf);
+      Parser__consume(this, TokenType__OpenParen);
+      Type *type = Parser__parse_type(this);
+      Token *close = Parser__consume(this, TokenType__CloseParen);
+      node = AST__new(ASTType__SizeOf, Span__join(start->span, close->span));
+      node->u.size_of_type = type;
+    } break;
+    case TokenType__Match: {
+      node = Parser__parse_match(this);
+    } break;
+    case TokenType__If: {
+      node = Parser__parse_if(this);
+    } break;
+    default: {
+      Parser__unhandled_type(this, "parse_expression");
+      node = AST__new(ASTType__Error, Parser__token(this)->span);
+      this->curr += 1;
+    } break;
+  }
+  bool running = true;
+  while (running) {
+    if (Parser__token_is(this, end_type)) 
+    break;
+    
+    switch (Parser__token(this)->type) {
+      case TokenType__OpenParen: {
+        Parser__consume(this, TokenType__OpenParen);
+        Vector *args = Vector__new();
+        while ((!Parser__token_is(this, TokenType__CloseParen))) {
+          AST *label = ((AST *)NULL);
+          AST *expr = Parser__parse_expression(this, TokenType__Comma);
+          if ((expr->type == ASTType__Identifier && Parser__token_is(this, TokenType__Colon))) {
+            Parser__consume(this, TokenType__Colon);
+            label = expr;
+            expr = Parser__parse_expression(this, TokenType__Comma);
+          } 
+          Vector__push(args, Argument__new(label, expr));
+          if ((!Parser__token_is(this, TokenType__CloseParen))) {
+            Parser__consume(this, TokenType__Comma);
+          } 
+        } 
+        Token *end = Parser__consume(this, TokenType__CloseParen);
+        ASTType call_type = ASTType__Call;
+        AST *call = AST__new(call_type, Span__join(node->span, end->span));
+        call->u.call.callee = node;
+        call->u.call.args = args;
+        call->u.call.added_method_arg = false;
+        node = call;
+      } break;
+      case TokenType__OpenSquare: {
+        Parser__consume(this, TokenType__OpenSquare);
+        AST *index = Parser__parse_expression(this, TokenType__CloseSquare);
+        Parser__consume(this, TokenType__CloseSquare);
+        node = AST__new_binop(ASTType__Index, node, index);
+      } break;
+      case TokenType__Dot: {
+        Token *dot = Parser__consume(this, TokenType__Dot);
+        AST *rhs = ({ AST *__yield_0;
+  if (Parser__token_is(this, TokenType__Identifier)) {
+    Token *name = Parser__consume(this, TokenType__Identifier);
+    AST *tmp = AST__new(ASTType__Identifier, name->span);
+    tmp->u.ident.name = name->text;
+    __yield_0 = tmp;
+  }  else {
+    Parser__error(this, Error__new(Parser__token(this)->span, "Expected identifier after '.'"));
+    __yield_0 = AST__new(ASTType__Error, dot->span);
+  } 
+;__yield_0; });
+        AST *member = AST__new(ASTType__Member, Span__join(node->span, rhs->span));
+        member->u.member.lhs = node;
+        member->u.member.rhs = rhs;
+        node = member;
+      } break;
+      case TokenType__ColonColon: {
+        Parser__consume(this, TokenType__ColonColon);
+        Token *name = Parser__consume(this, TokenType__Identifier);
+        AST *member = AST__new(ASTType__ScopeLookup, Span__join(node->span, name->span));
+        AST *rhs = AST__new(ASTType__Identifier, name->span);
+        rhs->u.ident.name = name->text;
+        member->u.member.lhs = node;
+        member->u.member.rhs = rhs;
+        node = member;
+      } break;
+      case TokenType__As: {
+        Parser__consume(this, TokenType__As);
+        Type *type = Parser__parse_type(this);
+        AST *cast = AST__new(ASTType__Cast, Span__join(node->span, type->span));
+        cast->u.cast.lhs = node;
+        cast->u.cast.to = type;
+        node = cast;
+      } break;
+      case TokenType__Question: {
+        Parser__consume(this, TokenType__Question);
+        node = AST__new_unop(ASTType__IsNotNull, Span__join(node->span, Parser__token(this)->span), node);
+      } break;
+      default: {
+        running = false;
+      } break;
+    }
+  } 
+  return node;
+}
+
+static AST *Parser__parse_term(Parser *this, TokenType end_type) {
+  AST *lhs = Parser__parse_factor(this, end_type);
+  while (((Parser__token_is(this, TokenType__Star) || Parser__token_is(this, TokenType__Slash)) || Parser__token_is(this, TokenType__Percent))) {
+    if (Parser__token_is(this, end_type)) 
+    break;
+    
+    ASTType op = ASTType__from_token(Parser__token(this)->type);
+    this->curr += 1;
+    AST *rhs = Parser__parse_factor(this, end_type);
+    lhs = AST__new_binop(op, lhs, rhs);
+  } 
+  return lhs;
+}
+
+static AST *Parser__parse_additive(Parser *this, TokenType end_type) {
+  AST *lhs = Parser__parse_term(this, end_type);
+  while ((Parser__token_is(this, TokenType__Plus) || Parser__token_is(this, TokenType__Minus))) {
+    if (Parser__token_is(this, end_type)) 
+    break;
+    
+    ASTType op = ASTType__from_token(Parser__token(this)->type);
+    this->curr += 1;
+    AST *rhs = Parser__parse_term(this, end_type);
+    lhs = AST__new_binop(op, lhs, rhs);
+  } 
+  return lhs;
+}
+
+static AST *Parser__parse_shift(Parser *this, TokenType end_type) {
+  AST *lhs = Parser__parse_additive(this, end_type);
+  while ((Parser__token_is(this, TokenType__LessThanLessThan) || Parser__token_is(this, TokenType__GreaterThanGreaterThan))) {
+    if (Parser__token_is(this, end_type)) 
+    break;
+    
+    ASTType op = ASTType__from_token(Parser__token(this)->type);
+    this->curr += 1;
+    AST *rhs = Parser__parse_additive(this, end_type);
+    lhs = AST__new_binop(op, lhs, rhs);
+  } 
+  return lhs;
+}
+
+static AST *Parser__parse_bw_and(Parser *this, TokenType end_type) {
+  AST *lhs = Parser__parse_shift(this, end_type);
+  while (Parser__token_is(this, TokenType__Ampersand)) {
+    if (Parser__token_is(this, end_type)) 
+    break;
+    
+    ASTType op = ASTType__from_token(Parser__token(this)->type);
+    this->curr += 1;
+    AST *rhs = Parser__parse_shift(this, end_type);
+    lhs = AST__new_binop(op, lhs, rhs);
+  } 
+  return lhs;
+}
+
+static AST *Parser__parse_bw_xor(Parser *this, TokenType end_type) {
+  AST *lhs = Parser__parse_bw_and(this, end_type);
+  while (Parser__token_is(this, TokenType__Caret)) {
+    if (Parser__token_is(this, end_type)) 
+    break;
+    
+    ASTType op = ASTType__from_token(Parser__token(this)->type);
+    this->curr += 1;
+    AST *rhs = Parser__parse_bw_and(this, end_type);
+    lhs = AST__new_binop(op, lhs, rhs);
+  } 
+  return lhs;
+}
+
+static AST *Parser__parse_bw_or(Parser *this, TokenType end_type) {
+  AST *lhs = Parser__parse_bw_xor(this, end_type);
+  while (Parser__token_is(this, TokenType__Line)) {
+    if (Parser__token_is(this, end_type)) 
+    break;
+    
+    ASTType op = ASTType__from_token(Parser__token(this)->type);
+    this->curr += 1;
+    AST *rhs = Parser__parse_bw_xor(this, end_type);
+    lhs = AST__new_binop(op, lhs, rhs);
+  } 
+  return lhs;
+}
+
+static AST *Parser__parse_relational(Parser *this, TokenType end_type) {
+  Vector *operands = Vector__new();
+  Vector *operators = Vector__new();
+  Vector__push(operands, Parser__parse_bw_or(this, end_type));
+  while ((((((Parser__token_is(this, TokenType__LessThan) || Parser__token_is(this, TokenType__GreaterThan)) || Parser__token_is(this, TokenType__LessThanEquals)) || Parser__token_is(this, TokenType__GreaterThanEquals)) || Parser__token_is(this, TokenType__EqualEquals)) || Parser__token_is(this, TokenType__NotEquals))) {
+    if (Parser__token_is(this, end_type)) 
+    break;
+    
+    Vector__push(operators, Parser__token(this));
+    this->curr += 1;
+    AST *term = Parser__parse_bw_or(this, end_type);
+    Vector__push(operands, term);
+  } 
+  if (operators->size == 0) 
+  return Vector__at(operands, 0);
+  
+  AST *root = ((AST *)NULL);
+  for (i32 i = 0; (i < operators->size); i += 1) {
+    Token *tok = ((Token *)Vector__at(operators, i));
+    AST *lhs = ((AST *)Vector__at(operands, i));
+    AST *rhs = ((AST *)Vector__at(operands, (i + 1)));
+    AST *op = AST__new_binop(ASTType__from_token(tok->type), lhs, rhs);
+    if (((bool)root)) {
+      root = AST__new_binop(ASTType__And, root, op);
+    }  else {
+      root = op;
+    } 
+  } 
+  Vector__free(operands);
+  Vector__free(operators);
+  return root;
+}
+
+static AST *Parser__parse_logical_and(Parser *this, TokenType end_type) {
+  AST *lhs = Parser__parse_relational(this, end_type);
+  while (Parser__token_is(this, TokenType__And)) {
+    if (Parser__token_is(this, end_type)) 
+    break;
+    
+    ASTType op = ASTType__from_token(Parser__token(this)->type);
+    this->curr += 1;
+    AST *rhs = Parser__parse_relational(this, end_type);
+    lhs = AST__new_binop(op, lhs, rhs);
+  } 
+  return lhs;
+}
+
+static AST *Parser__parse_logical_or(Parser *this, TokenType end_type) {
+  AST *lhs = Parser__parse_logical_and(this, end_type);
+  while (Parser__token_is(this, TokenType__Or)) {
+    if (Parser__token_is(this, end_type)) 
+    break;
+    
+    ASTType op = ASTType__from_token(Parser__token(this)->type);
+    this->curr += 1;
+    AST *rhs = Parser__parse_logical_and(this, end_type);
+    lhs = AST__new_binop(op, lhs, rhs);
+  } 
+  return lhs;
+}
+
+static AST *Parser__parse_expression(Parser *this, TokenType end_type) {
+  AST *lhs = Parser__parse_logical_or(this, end_type);
+  while (((((Parser__token_is(this, TokenType__Equals) || Parser__token_is(this, TokenType__PlusEquals)) || Parser__token_is(this, TokenType__MinusEquals)) || Parser__token_is(this, TokenType__StarEquals)) || Parser__token_is(this, TokenType__SlashEquals))) {
+    if (Parser__token_is(this, end_type)) 
+    break;
+    
+    ASTType op = ASTType__from_token(Parser__token(this)->type);
+    this->curr += 1;
+    AST *rhs = Parser__parse_expression(this, end_type);
+    lhs = AST__new_binop(op, lhs, rhs);
+  } 
+  return lhs;
+}
+
+static AST *Parser__parse_match(Parser *this) {
+  Token *op = Parser__consume(this, TokenType__Match);
+  AST *expr = Parser__parse_expression(this, TokenType__OpenCurly);
+  AST *node = AST__new(ASTType__Match, Span__join(op->span, expr->span));
+  node->u.match_stmt.expr = expr;
+  Vector *cases = Vector__new();
+  Parser__consume(this, TokenType__OpenCurly);
+  while ((!Parser__token_is(this, TokenType__CloseCurly))) {
+    if (Parser__token_is(this, TokenType__Else)) {
+      node->u.match_stmt.defolt_span = Parser__token(this)->span;
+      Parser__consume(this, TokenType__Else);
+      Parser__consume(this, TokenType__FatArrow);
+      node->u.match_stmt.defolt = Parser__parse_statement(this);
+    }  else {
+      AST *cond = Parser__parse_factor(this, TokenType__Line);
+      AST *body = ((AST *)NULL);
+      if ((!Parser__consume_if(this, TokenType__Line))) {
+        Parser__consume(this, TokenType__FatArrow);
+        body = Parser__parse_statement(this);
+        if ((!Parser__token_is(this, TokenType__CloseCurly))) {
+          Parser__consume_newline_or(this, TokenType__Comma);
+        } 
+      } 
+      MatchCase *_case = MatchCase__new(cond, body);
+      Vector__push(cases, _case);
+    } 
+  } 
+  node->span = Span__join(op->span, Parser__token(this)->span);
+  Parser__consume(this, TokenType__CloseCurly);
+  node->u.match_stmt.cases = cases;
+  return node;
+}
+
+static AST *Parser__parse_if(Parser *this) {
+  Span start_span = Parser__token(this)->span;
+  Parser__consume(this, TokenType__If);
+  AST *cond = Parser__parse_expression(this, TokenType__Newline);
+  Parser__consume_if(this, TokenType__Then);
+  AST *body = Parser__parse_statement(this);
+  Span end_span = body->span;
+  AST *els = ((AST *)NULL);
+  if (Parser__consume_if(this, TokenType__Else)) {
+    els = Parser__parse_statement(this);
+    end_span = els->span;
+  } 
+  AST *node = AST__new(ASTType__If, Span__join(start_span, end_span));
+  node->u.if_stmt.cond = cond;
+  node->u.if_stmt.body = body;
+  node->u.if_stmt.els = els;
+  return node;
+}
+
+static void Parser__consume_end_of_statement(Parser *this) {
+  if (Parser__token_is(this, TokenType__CloseCurly)) 
+  return;
+  
+  Parser__consume_newline_or(this, TokenType__Semicolon);
+}
+
+static AST *Parser__parse_statement(Parser *this) {
+  AST *node = ((AST *)NULL);
+  Span start_span = Parser__token(this)->span;
+  switch (Parser__token(this)->type) {
+    case TokenType__Match: {
+      node = Parser__parse_match(this);
+    } break;
+    case TokenType__If: {
+      node = Parser__parse_if(this);
+    } break;
+    case TokenType__OpenCurly: {
+      node = Parser__parse_block(this);
+    } break;
+    case TokenType__Return: {
+      Parser__consume(this, TokenType__Return);
+      AST *expr = ((AST *)NULL);
+      if ((!Parser__token(this)->seen_newline)) {
+        expr = Parser__parse_expression(this, TokenType__Newline);
+      } 
+      node = AST__new_unop(ASTType__Return, Span__join(start_span, Parser__token(this)->span), expr);
+      Parser__consume_end_of_statement(this);
+    } break;
+    case TokenType__Break: {
+      node = AST__new(ASTType__Break, start_span);
+      Parser__consume(this, TokenType__Break);
+      Parser__consume_end_of_statement(this);
+    } break;
+    case TokenType__Continue: {
+      Parser__consume(this, TokenType__Continue);
+      node = AST__new(ASTType__Continue, start_span);
+      Parser__consume_end_of_statement(this);
+    } break;
+    case TokenType__Defer: {
+      Parser__consume(this, TokenType__Defer);
+      AST *expr = Parser__parse_statement(this);
+      node = AST__new_unop(ASTType__Defer, Span__join(start_span, expr->span), expr);
+    } break;
+    case TokenType__Scratch: {
+      Parser__consume(this, TokenType__Scratch);
+      AST *body = Parser__parse_block(this);
+      node = AST__new_unop(ASTType__Scratch, Span__join(start_span, body->span), body);
+    } break;
+    case TokenType__Yield: {
+      Parser__consume(this, TokenType__Yield);
+      AST *expr = Parser__parse_expression(this, TokenType__Newline);
+      node = AST__new_unop(ASTType__Yield, Span__join(start_span, expr->span), expr);
+      Parser__consume_end_of_statement(this);
+    } break;
+    case TokenType__While: {
+      Parser__consume(this, TokenType__While);
+      AST *cond = Parser__parse_expression(this, TokenType__Newline);
+      AST *body = Parser__parse_statement(this);
+      node = AST__new(ASTType__While, Span__join(start_span, body->span));
+      node->u.loop.cond = cond;
+      node->u.loop.body = body;
+    } break;
+    case TokenType__For: {
+      node = AST__new(ASTType__For, Parser__token(this)->span);
+      Parser__consume(this, TokenType__For);
+      if ((!Parser__token_is(this, TokenType__Semicolon))) {
+        AST *init = Parser__parse_statement(this);
+        if (((init->type != ASTType__Assignment) && (init->type != ASTType__VarDeclaration))) {
+          Parser__error(this, Error__new(init->span, "Invalid for loop initializer"));
+        } 
+        node->u.loop.init = init;
+        Token *prev = ((Token *)Vector__at(this->tokens, (this->curr - 1)));
+        if (prev->type == TokenType__Semicolon) {
+          this->curr -= 1;
+        } 
+      } 
+      Parser__consume(this, TokenType__Semicolon);
+      if ((!Parser__token_is(this, TokenType__Semicolon))) 
+      node->u.loop.cond = Parser__parse_expression(this, TokenType__Semicolon);
+      
+      Parser__consume(this, TokenType__Semicolon);
+      if ((!Parser__token_is(this, TokenType__CloseCurly))) 
+      node->u.loop.incr = Parser__parse_expression(this, TokenType__Newline);
+      
+      node->u.loop.body = Parser__parse_statement(this);
+      node->span = Span__join(node->span, node->u.loop.body->span);
+    } break;
+    case TokenType__Let: {
+      Parser__consume(this, TokenType__Let);
+      Token *name = Parser__consume(this, TokenType__Identifier);
+      Span end_span = name->span;
+      Type *type = ((Type *)NULL);
+      if (Parser__consume_if(this, TokenType__Colon)) {
+        type = Parser__parse_type(this);
+        end_span = type->span;
+      } 
+      AST *init = ((AST *)NULL);
+      if (Parser__consume_if(this, TokenType__Equals)) {
+        init = Parser__parse_expression(this, TokenType__Newline);
+        end_span = init->span;
+      } 
+      Parser__consume_end_of_statement(this);
+      node = AST__new(ASTType__VarDeclaration, Span__join(start_span, end_span));
+      node->u.var_decl.var = Variable__new(name->text, type, name->span);
+      node->u.var_decl.init = init;
+    } break;
+    case TokenType__Const: {
+      Parser__error(this, Error__new(Parser__token(this)->span, "Const declarations are only allowed in the global scope"));
+    } break;
+    default: {
+      node = Parser__parse_expression(this, TokenType__Newline);
+      Parser__consume_if(this, TokenType__Semicolon);
+    } break;
+  }
+  return node;
+}
+
+static AST *Parser__parse_block(Parser *this) {
+  AST *node = AST__new(ASTType__Block, Parser__token(this)->span);
+  Parser__consume(this, TokenType__OpenCurly);
+  Vector *statements = Vector__new();
+  while ((!Parser__token_is(this, TokenType__CloseCurly))) {
+    AST *statement = Parser__parse_statement(this);
+    Vector__push(statements, statement);
+  } 
+  node->u.block.statements = statements;
+  Parser__consume(this, TokenType__CloseCurly);
+  return node;
+}
+
+static void Parser__parse_function_attribute(Parser *this, Function *func, Token *attr) {
+  {
+    char *__match_str = attr->text;
+    switch (aecor_hash_str(__match_str, 2166136261u)) {
+      case 808185403u:
+        if (!strcmp(__match_str, "inline")) goto __match_2_0;
+        break;
+      case 3723689721u:
+        if (!strcmp(__match_str, "noinline")) goto __match_2_1;
+        break;
+      case 1858890578u:
+        if (!strcmp(__match_str, "hot")) goto __match_2_2;
+        break;
+      case 4289777599u:
+        if (!strcmp(__match_str, "cold")) goto __match_2_3;
+        break;
+      case 45253003u:
+        if (!strcmp(__match_str, "pure")) goto __match_2_4;
+        break;
+      case 2848935426u:
+        if (!strcmp(__match_str, "export")) goto __match_2_5;
+        break;
+    }
+    goto __match_2_default;
+    __match_2_0: {
+      func->is_inline = true;
+    } goto __match_2_end;
+    __match_2_1: {
+      func->is_noinline = true;
+    } goto __match_2_end;
+    __match_2_2: {
+      func->is_hot = true;
+    } goto __match_2_end;
+    __match_2_3: {
+      func->is_cold = true;
+    } goto __match_2_end;
+    __match_2_4: {
+      func->is_pure = true;
+    } goto __match_2_end;
+    __match_2_5: {
+      func->is_export = true;
+    } goto __match_2_end;
+    __match_2_default: {
+      Parser__error(this, Error__new(attr->span, "Unknown function attribute"));
+    }
+    __match_2_end:;
+  }
+}
+
+static Function *Parser__parse_function(Parser *this) {
+  i32 start = this->curr;
+  Vector *attributes = Vector__new();
+  while (Parser__consume_if(this, TokenType__AtSign)) {
+    Vector__push(attributes, Parser__consume(this, TokenType__Identifier));
+  } 
+  Parser__consume(this, TokenType__Def);
+  Type *struct_type = ((Type *)NULL);
+  char *struct_name = ((char *)NULL);
+  bool is_method = false;
+  bool is_static = false;
+  Token *next_token = ((Token *)Vector__at(this->tokens, (this->curr + 1)));
+  bool is_generic_method = false;
+  if (next_token->type == TokenType__LessThan) {
+    i32 end = Parser__skip_type_args(this, (this->curr + 1));
+    if ((end >= 0)) {
+      Token *after = ((Token *)Vector__at(this->tokens, end));
+      is_generic_method = after->type == TokenType__ColonColon;
+    } 
+  } 
+  bool is_template = false;
+  if ((is_generic_method && (!((bool)this->type_params)))) {
+    Token *name = Parser__consume(this, TokenType__Identifier);
+    Vector *params = Parser__parse_type_params(this);
+    if ((!Map__exists(this->method_templates, name->text))) {
+      Map__insert(this->method_templates, name->text, Vector__new());
+    } 
+    Vector *methods = ((Vector *)Map__get(this->method_templates, name->text));
+    Vector__push(methods, Template__new(name->text, params, this->tokens, start));
+    Parser__begin_template_definition(this, params);
+    is_template = true;
+    struct_type = Type__new(BaseType__Structure, name->span);
+    struct_type->name = name->text;
+    struct_name = name->text;
+    is_method = true;
+    Parser__consume(this, TokenType__ColonColon);
+  }  else   if ((next_token->type == TokenType__ColonColon || is_generic_method)) {
+    struct_type = Parser__parse_type(this);
+    if ((!((bool)struct_type->name))) {
+      Parser__error(this, Error__new(struct_type->span, "Invalid type in method declaration"));
+    } 
+    struct_name = struct_type->name;
+    is_method = true;
+    Parser__consume(this, TokenType__ColonColon);
+  } 
+  
+  Token *name = Parser__consume(this, TokenType__Identifier);
+  Function *func = Function__new(name->span);
+  func->name = name->text;
+  func->is_method = is_method;
+  if (Parser__token_is(this, TokenType__LessThan)) {
+    if (((bool)this->instance_name)) {
+      Parser__parse_type_params(this);
+      func->name = this->instance_name;
+      this->instance_name = NULL;
+    }  else {
+      Vector *params = Parser__parse_type_params(this);
+      Parser__register_template(this, name->text, params, start, false);
+      Parser__begin_template_definition(this, params);
+      is_template = true;
+    } 
+  } 
+  func->method_struct_name = struct_name;
+  for (i32 i = 0; (i < attributes->size); i += 1) {
+    Parser__parse_function_attribute(this, func, ((Token *)Vector__at(attributes, i)));
+  } 
+  if ((func->is_inline && func->is_noinline)) {
+    Parser__error(this, Error__new(name->span, "Function cannot be both @inline and @noinline"));
+  } 
+  if ((func->is_hot && func->is_cold)) {
+    Parser__error(this, Error__new(name->span, "Function cannot be both @hot and @cold"));
+  } 
+  Parser__consume(this, TokenType__OpenParen);
+  while ((!Parser__token_is(this, TokenType__CloseParen))) {
+    bool found_amp = Parser__consume_if(this, TokenType__Ampersand);
+    Token *var_name = Parser__consume(this, TokenType__Identifier);
+    Type *type = ((Type *)NULL);
+    if ((Vector__empty(func->params) && is_method)) {
+      if (string__eq(var_name->text, "this")) {
+        type = struct_type;
+        if (found_amp) {
+          type = Type__new_link(BaseType__Pointer, type, name->span);
+        } 
+      }  else       if (found_amp) {
+        Parser__error(this, Error__new(var_name->span, "Expected 'this' over here"));
+      }  else {
+        is_static = true;
+      } 
+      
+    } 
+    if ((!((bool)type))) {
+      Parser__consume(this, TokenType__Colon);
+      type = Parser__parse_type(this);
+    } 
+    Variable *var = Variable__new(var_name->text, type, var_name->span);
+    Vector__push(func->params, var);
+    if ((!Parser__token_is(this, TokenType__CloseParen))) {
+      Parser__consume(this, TokenType__Comma);
+    } 
+  } 
+  Parser__consume(this, TokenType__CloseParen);
+  if ((is_method && func->params->size == 0)) {
+    is_static = true;
+  } 
+  func->is_static = is_static;
+  if (Parser__consume_if(this, TokenType__Colon)) {
+    func->return_type = Parser__parse_type(this);
+  }  else   if (string__eq(name->text, "main")) {
+    func->return_type = Type__new(BaseType__I32, name->span);
+  }  else {
+    func->return_type = Type__new(BaseType__Void, name->span);
+    if ((Parser__token_is(this, TokenType__Identifier) && string__eq(Parser__token(this)->text, "exits"))) {
+      Parser__consume(this, TokenType__Identifier);
+      func->exits = true;
+    } 
+  } 
+  
+  if (Parser__consume_if(this, TokenType__Extern)) {
+    func->is_extern = true;
+    func->extern_name = func->name;
+    if (Parser__consume_if(this, TokenType__OpenParen)) {
+      Token *name = Parser__consume(this, TokenType__StringLiteral);
+      func->extern_name = name->text;
+      Parser__consume(this, TokenType__CloseParen);
+    } 
+  }  else   if (Parser__consume_if(this, TokenType__FatArrow)) {
+    func->is_arrow = true;
+    AST *expr = Parser__parse_expression(this, TokenType__Newline);
+    if ((!Parser__token(this)->seen_newline)) {
+      Span end_loc = (Span){expr->span.end, expr->span.end};
+      Parser__error(this, Error__new(end_loc, "Expected newline after arrow function"));
+    } 
+    AST *ret_stmt = AST__new_unop(ASTType__Return, expr->span, expr);
+    func->body = ret_stmt;
+  }  else {
+    func->is_extern = false;
+    func->body = Parser__parse_block(this);
+  } 
+  
+  if (is_template) {
+    Parser__end_template_definition(this);
+    return NULL;
+  } 
+  return func;
+}
+
+static Structure *Parser__parse_enum(Parser *this) {
+  Span start_span = Parser__consume(this, TokenType__Enum)->span;
+  Token *name = Parser__consume(this, TokenType__Identifier);
+  Structure *enum_def = Structure__new(Span__join(start_span, name->span));
+  enum_def->name = name->text;
+  enum_def->is_enum = true;
+  Type *type = Type__new(BaseType__Structure, name->span);
+  enum_def->type = type;
+  type->name = name->text;
+  type->struct_def = enum_def;
+  if (Parser__consume_if(this, TokenType__Extern)) {
+    enum_def->is_extern = true;
+    enum_def->extern_name = enum_def->name;
+    if (Parser__consume_if(this, TokenType__OpenParen)) {
+      Token *name = Parser__consume(this, TokenType__StringLiteral);
+      enum_def->extern_name = name->text;
+      Parser__consume(this, TokenType__CloseParen);
+    } 
+  } 
+  Parser__consume(this, TokenType__OpenCurly);
+  while ((!Parser__token_is(this, TokenType__CloseCurly))) {
+    Token *name = Parser__consume(this, TokenType__Identifier);
+    Type *type = Type__new(BaseType__I32, name->span);
+    Variable *var = Variable__new(name->text, type, name->span);
+    if (enum_def->is_extern) {
+      Parser__consume(this, TokenType__Equals);
+      Parser__consume(this, TokenType__Extern);
+      Parser__consume(this, TokenType__OpenParen);
+      Token *name = Parser__consume(this, TokenType__StringLiteral);
+      Parser__consume(this, TokenType__CloseParen);
+      var->extern_name = name->text;
+      var->is_extern = true;
+    } 
+    Vector__push(enum_def->fields, var);
+    if ((!Parser__token_is(this, TokenType__CloseCurly))) {
+      Parser__consume_newline_or(this, TokenType__Comma);
+    } 
+  } 
+  Parser__consume(this, TokenType__CloseCurly);
+  return enum_def;
+}
+
+static Structure *Parser__parse_struct(Parser *this) {
+  i32 start = this->curr;
+  bool is_union = false;
+  Span start_span = Parser__token(this)->span;
+  if (Parser__consume_if(this, TokenType__Union)) {
+    is_union = true;
+  }  else {
+    Parser__consume(this, TokenType__Struct);
+  } 
+  Token *name = Parser__consume(this, TokenType__Identifier);
+  Structure *struc = Structure__new(Span__join(start_span, name->span));
+  struc->name = name->text;
+  bool is_template = false;
+  if (Parser__token_is(this, TokenType__LessThan)) {
+    if (((bool)this->instance_name)) {
+      Parser__parse_type_params(this);
+      struc->name = this->instance_name;
+      this->instance_name = NULL;
+    }  else {
+      Vector *params = Parser__parse_type_params(this);
+      Parser__register_template(this, name->text, params, start, true);
+      Parser__begin_template_definition(this, params);
+      is_template = true;
+    } 
+  } 
+  if (Parser__consume_if(this, TokenType__Extern)) {
+    struc->is_extern = true;
+    struc->extern_name = struc->name;
+    if (Parser__consume_if(this, TokenType__OpenParen)) {
+      Token *name = Parser__consume(this, TokenType__StringLiteral);
+      struc->extern_name = name->text;
+      Parser__consume(this, TokenType__CloseParen);
+    } 
+  } 
+  if (((!struc->is_extern) || Parser__token_is(this, TokenType__OpenCurly))) {
+    Parser__consume(this, TokenType__OpenCurly);
+    while ((!Parser__token_is(this, TokenType__CloseCurly))) {
+      Token *name = Parser__consume(this, TokenType__Identifier);
+      Parser__consume(this, TokenType__Colon);
+      Type *type = Parser__parse_type(this);
+      Variable *var = Variable__new(name->text, type, name->span);
+      Vector__push(struc->fields, var);
+      if ((!Parser__token_is(this, TokenType__CloseCurly))) {
+        Parser__consume_newline_or(this, TokenType__Comma);
+      } 
+    } 
+    Parser__consume(this, TokenType__CloseCurly);
+  } 
+  if (is_template) {
+    Parser__end_template_definition(this);
+    return NULL;
+  } 
+  Type *type = Type__new(BaseType__Structure, name->span);
+  type->name = struc->name;
+  struc->type = type;
+  type->struct_def = struc;
+  struc->is_union = is_union;
+  return struc;
+}
+
+static AST *Parser__parse_global_value(Parser *this, bool is_constant) {
+  Token *start_token = ({ Token *__yield_0;
+  if (is_constant) {
+    __yield_0 = Parser__consume(this, TokenType__Const);
+  }  else {
+    __yield_0 = Parser__consume(this, TokenType__Let);
+  } 
+;__yield_0; });
+  AST *node = AST__new(ASTType__VarDeclaration, Parser__token(this)->span);
+  Token *name = ({ Token *__yield_0;
+  if (Parser__token_is(this, TokenType__Identifier)) {
+    __yield_0 = Parser__consume(this, TokenType__Identifier);
+  }  else {
+    Parser__error(this, Error__new(Parser__token(this)->span, "Expected identifier"));
+    return node;
+  } 
+;__yield_0; });
+  Type *type = ((Type *)NULL);
+  if (Parser__consume_if(this, TokenType__Colon)) {
+    type = Parser__parse_type(this);
+  } 
+  Variable *var = Variable__new(name->text, type, name->span);
+  node->u.var_decl.var = var;
+  if (Parser__consume_if(this, TokenType__Extern)) {
+    var->is_extern = true;
+    if (Parser__consume_if(this, TokenType__OpenParen)) {
+      Token *name = Parser__consume(this, TokenType__StringLiteral);
+      var->extern_name = name->text;
+      Parser__consume(this, TokenType__CloseParen);
+    }  else {
+      var->extern_name = var->name;
+    } 
+    if ((!((bool)type))) {
+      Parser__error(this, Error__new(name->span, "Extern values must have a type specified"));
+    } 
+  }  else {
+    var->is_extern = false;
+    if (Parser__consume_if(this, TokenType__Equals)) {
+      node->u.var_decl.init = Parser__parse_expression(this, TokenType__Newline);
+    } 
+  } 
+  Parser__consume_newline_or(this, TokenType__Semicolon);
+  return node;
+}
+
+static char *Parser__find_file_path(Parser *this, char *filename) {
+  if (string__starts_with(filename, "/")) 
+  return filename;
+  
+  if (string__starts_with(filename, "@/")) {
+    char *file_path = format_string("%s/%s", this->project_root, (filename + 2));
+    if (File__exists(file_path)) 
+    return file_path;
+    
+    free(file_path);
+  }  else {
+    for (i32 i = 0; (i < this->include_dirs->size); i += 1) {
+      char *dir = ((char *)Vector__at(this->include_dirs, i));
+      char *file_path = format_string("%s/%s", dir, filename);
+      if (File__exists(file_path)) 
+      return file_path;
+      
+      free(file_path);
+    } 
+  } 
+  if (this->curr == 0) {
+    printf("---------------------------------------------------------------""\n");
+    printf("[-] Error: Could not find file '%s'""\n", filename);
+    printf("[+] Hint: Specify the aecor root directory with the -l option""\n");
+    printf("---------------------------------------------------------------""\n");
+    printf("burhhhh0""\n");
+    exit(1);
+  } 
+  this->curr -= 1;
+  Parser__error(this, Error__new(Parser__token(this)->span, format_string("Could not find file: %s", filename)));
+  this->curr += 1;
+  return NULL;
+}
+
+static char *Parser__include_file(Parser *this, Program *program, char *filename) {
+  filename = Parser__find_file_path(this, filename);
+  if ((!((bool)filename))) 
+  return NULL;
+  
+  if (Program__is_file_included(program, filename)) 
+  return filename;
+  
+  Program__add_included_file(program, filename);
+  FILE *file = File__open(filename, "r");
+  char *contents = File__slurp(file);
+  Lexer lexer = Lexer__make(contents, filename);
+  Vector *tokens = Lexer__lex((&lexer));
+  for (i32 i = 0; (i < lexer.errors->size); i += 1) {
+    Parser__error(this, Vector__at(lexer.errors, i));
+  } 
+  Vector__free(lexer.errors);
+  Parser__push_context(this, tokens);
+  Parser__find_templates(this);
+  Parser__parse_into_program(this, program);
+  Parser__pop_context(this);
+  if (Vector__empty(this->context_stack)) {
+    Parser__instantiate_templates(this, program);
+  } 
+  return filename;
+}
+
+static void Parser__parse_use(Parser *this, Program *program) {
+  Parser__consume(this, TokenType__Use);
+  Token *name = Parser__consume(this, TokenType__StringLiteral);
+  Parser__consume_newline_or(this, TokenType__Semicolon);
+  Parser__include_file(this, program, name->text);
+}
+
+static void Parser__parse_compiler_option(Parser *this, Program *program) {
+  Parser__consume(this, TokenType__AtSign);
+  Token *compiler = Parser__consume(this, TokenType__Identifier);
+  if ((!string__eq(compiler->text, "compiler"))) {
+    Parser__error(this, Error__new(compiler->span, "Expected 'compiler'"));
+  } 
+  Token *name = Parser__consume(this, TokenType__Identifier);
+  {
+    char *__match_str = name->text;
+    if (!strcmp(__match_str, "c_include")) {
+      Token *filename = Parser__consume(this, TokenType__StringLiteral);
+      Vector__push(program->c_includes, filename->text);
+    } else if (!strcmp(__match_str, "c_flag")) {
+      Token *flag = Parser__consume(this, TokenType__StringLiteral);
+      Vector__push(program->c_flags, flag->text);
+    } else if (!strcmp(__match_str, "c_embed_header")) {
+      Token *filename = Parser__consume(this, TokenType__StringLiteral);
+      char *resolved = Parser__find_file_path(this, filename->text);
+      Vector__push(program->c_embed_headers, resolved);
+    } else  {
+      Parser__error(this, Error__new(name->span, "Unknown compiler option"));
+    }
+  }
+}
+
+static void Parser__parse_into_program(Parser *this, Program *program) {
+  while ((!Parser__token_is(this, TokenType__EOF))) {
+    switch (Parser__token(this)->type) {
+      case TokenType__Use: {
+        Parser__parse_use(this, program);
+      } break;
+      case TokenType__AtSign: {
+        Token *next = ((Token *)Vector__at(this->tokens, (this->curr + 1)));
+        if (string__eq(next->text, "compiler")) {
+          Parser__parse_compiler_option(this, program);
+        }  else {
+          Function *func = Parser__parse_function(this);
+          if (((bool)func)) 
+          Vector__push(program->functions, func);
+          
+        } 
+      } break;
+      case TokenType__Def: {
+        Function *func = Parser__parse_function(this);
+        if (((bool)func)) 
+        Vector__push(program->functions, func);
+        
+      } break;
+      case TokenType__Let: {
+        AST *node = Parser__parse_global_value(this, false);
+        Vector__push(program->global_vars, node);
+      } break;
+      case TokenType__Const: {
+        AST *node = Parser__parse_global_value(this, true);
+        Vector__push(program->constants, node);
+      } break;
+      case TokenType__Struct:
+      case TokenType__Union: {
+        Structure *structure = Parser__parse_struct(this);
+        if (((bool)structure)) 
+        Vector__push(program->structures, structure);
+        
+      } break;
+      case TokenType__Enum: {
+        Structure *structure = Parser__parse_enum(this);
+        Vector__push(program->structures, structure);
+      } break;
+      default: {
+        Parser__unhandled_type(this, "parse_program");
+      } break;
+    }
+  } 
+}
+
+static void Parser__include_prelude(Parser *this, Program *program) {
+  this->program = program;
+  Parser__include_file(this, program, "lib/prelude.ae");
+}
+
+static void TypeChecker__error(TypeChecker *this, Error *err) {
+  Vector__push(this->program->errors, err);
+}
+
+static TypeChecker *TypeChecker__new(void) {
+  TypeChecker *checker = ((TypeChecker *)calloc(1, sizeof(TypeChecker)));
+  checker->scopes = Vector__new();
+  checker->functions = Map__new();
+  checker->structures = Map__new();
+  checker->methods = Map__new();
+  checker->constants = Map__new();
+  Map__insert(checker->methods, "string", Map__new());
+  return checker;
+}
+
+static void TypeChecker__push_scope(TypeChecker *this) {
+  Map *scope = Map__new();
+  Vector__push(this->scopes, scope);
+}
+
+static Map *TypeChecker__scope(TypeChecker *this) {
+  return Vector__back(this->scopes);
+}
+
+static void TypeChecker__pop_scope(TypeChecker *this) {
+  Map *scope = ((Map *)Vector__pop(this->scopes));
+  Map__free(scope);
+}
+
+static Variable *TypeChecker__find_constant(TypeChecker *this, char *name) {
+  return Map__get(this->constants, name);
+}
+
+static void TypeChecker__push_var(TypeChecker *this, Variable *var) {
+  Map *scope = TypeChecker__scope(this);
+  Variable *existing = ((Variable *)Map__get(scope, var->name));
+  if (((bool)existing)) {
+    TypeChecker__error(this, Error__new_hint(var->span, "Variable is already defined in scope", existing->span, "Previous definition here"));
+    return;
+  } 
+  AST *constant = ((AST *)TypeChecker__find_constant(this, var->name));
+  if (((bool)constant)) {
+    TypeChecker__error(this, Error__new_hint(var->span, "Variable is already defined as a constant", constant->span, "Previous definition here"));
+  } 
+  Map__insert(TypeChecker__scope(this), var->name, var);
+}
+
+static Variable *TypeChecker__find_var(TypeChecker *this, char *name) {
+  for (i32 i = (this->scopes->size - 1); (i >= 0); i -= 1) {
+    Map *scope = ((Map *)Vector__at(this->scopes, i));
+    Variable *var = ((Variable *)Map__get(scope, name));
+    if (((bool)var)) 
+    return var;
+    
+  } 
+  return TypeChecker__find_constant(this, name);
+}
+
+static Variable *TypeChecker__get_struct_member(TypeChecker *this, char *lhs, char *rhs) {
+  Structure *struc = ((Structure *)Map__get(this->structures, lhs));
+  return (((bool)struc) ? Structure__find_field(struc, rhs) : NULL);
+}
+
+static bool TypeChecker__type_is_valid(TypeChecker *this, Type *type) {
+  if ((!((bool)type))) 
+  return false;
+  
+  switch (type->base) {
+    case BaseType__Pointer: {
+      return TypeChecker__type_is_valid(this, type->ptr);
+    } break;
+    case BaseType__Function:
+    case BaseType__Method: {
+      for (i32 i = 0; (i < type->params->size); i += 1) {
+        Variable *var = ((Variable *)Vector__at(type->params, i));
+        if ((!TypeChecker__type_is_valid(this, var->type))) {
+          return false;
+        } 
+      } 
+      return TypeChecker__type_is_valid(this, type->return_type);
+    } break;
+    case BaseType__Structure: {
+      Structure *struc = ((Structure *)Map__get(this->structures, type->name));
+      if (((bool)struc)) {
+        type->struct_def = struc;
+        return true;
+      } 
+      return false;
+    } break;
+    case BaseType__Array: {
+      Type *expr_type = TypeChecker__check_expression(this, type->size_expr, NULL);
+      return (TypeChecker__type_is_valid(this, type->ptr) && TypeChecker__type_is_valid(this, expr_type));
+    } break;
+    default: {
+      return true;
+    } break;
+  }
+}
+
+static void TypeChecker__check_method_call(TypeChecker *this, Type *method_type, AST *node) {
+  AST *callee = node->u.call.callee;
+  if (((callee->type != ASTType__Member) && (callee->type != ASTType__ScopeLookup))) {
+    TypeChecker__error(this, Error__new(callee->span, "Method call is not to a member, internal compiler error"));
+    return;
+  } 
+  Map *s_methods = ((Map *)Map__get(this->methods, method_type->name));
+  AST *rhs = callee->u.member.rhs;
+  Function *method = ((Function *)Map__get(s_methods, rhs->u.ident.name));
+  node->u.call.func = method;
+  if (node->u.call.added_method_arg) 
+  return;
+  
+  node->u.call.added_method_arg = true;
+  if ((callee->type != ASTType__Member)) 
+  return;
+  
+  if (method->params->size == 0) {
+    TypeChecker__error(this, Error__new(callee->span, "Instance method should have `this` argument, internal error"));
+    return;
+  } 
+  Type *method_param = ((Variable *)Vector__at(method->params, 0))->type;
+  Member member = callee->u.member;
+  AST *first_arg = member.lhs;
+  if ((member.is_pointer && ((bool)method_param->name))) {
+    first_arg = AST__new_unop(ASTType__Dereference, first_arg->span, first_arg);
+  }  else   if (((!member.is_pointer) && (!((bool)method_param->name)))) {
+    first_arg = AST__new_unop(ASTType__Address, first_arg->span, first_arg);
+  } 
+  
+  Vector__push_front(node->u.call.args, Argument__new(NULL, first_arg));
+}
+
+static Type *TypeChecker__check_constructor(TypeChecker *this, Structure *struc, AST *node) {
+  if ((struc->is_enum || struc->is_union)) {
+    TypeChecker__error(this, Error__new(node->span, "Cannot use constructor for enum or union"));
+    return NULL;
+  } 
+  Vector *args = node->u.call.args;
+  AST *callee = node->u.call.callee;
+  node->type = ASTType__Constructor;
+  node->u.constructor.struc = struc;
+  node->u.constructor.args = args;
+  node->u.constructor.callee = callee;
+  Vector *fields = struc->fields;
+  if ((fields->size != args->size)) {
+    TypeChecker__error(this, Error__new_hint(node->span, "Constructor has wrong number of arguments", struc->span, format_string("Struct has %d fields, but got %d arguments", fields->size, args->size)));
+    return struc->type;
+  } 
+  for (i32 i = 0; (i < fields->size); i += 1) {
+    Variable *field = ((Variable *)Vector__at(fields, i));
+    Argument *arg = ((Argument *)Vector__at(args, i));
+    Type *arg_type = TypeChecker__check_expression(this, arg->expr, field->type);
+    if (((bool)arg->label)) {
+      char *label = arg->label->u.ident.name;
+      if ((!string__eq(label, field->name))) {
+        TypeChecker__error(this, Error__new_hint(arg->label->span, "Label on parameter does not match struct field", field->span, format_string("Expected '%s', got '%s'", field->name, label)));
+      } 
+    } 
+    if ((((bool)arg_type) && (!Type__eq(field->type, arg_type)))) {
+      TypeChecker__error(this, Error__new_hint(arg->expr->span, "Argument type does not match struct field", field->span, format_string("Expected '%s', got '%s'", Type__str(field->type), Type__str(arg_type))));
+    } 
+  } 
+  return struc->type;
+}
+
+static Type *TypeChecker__check_simd_constructor(TypeChecker *this, Type *type, AST *node) {
+  Vector *args = node->u.call.args;
+  AST *callee = node->u.call.callee;
+  node->type = ASTType__Constructor;
+  node->u.constructor.struc = NULL;
+  node->u.constructor.args = args;
+  node->u.constructor.callee = callee;
+  if (((args->size != type->lanes) && (args->size != 1))) {
+    TypeChecker__error(this, Error__new_note(node->span, "Constructor has wrong number of arguments", format_string("Expected 1 or %d values for '%s', got %d", type->lanes, Type__str(type), args->size)));
+    return type;
+  } 
+  for (i32 i = 0; (i < args->size); i += 1) {
+    Argument *arg = ((Argument *)Vector__at(args, i));
+    Type *arg_type = TypeChecker__check_expression(this, arg->expr, type->ptr);
+    if ((((bool)arg_type) && (!Type__eq(arg_type, type->ptr)))) {
+      TypeChecker__error(this, Error__new_note(arg->expr->span, "Argument type does not match vector element type", format_string("Expected '%s', got '%s'", Type__str(type->ptr), Type__str(arg_type))));
+    } 
+  } 
+  return type;
+}
+
+static Type *TypeChecker__check_shuffle(TypeChecker *this, AST *node) {
+  Vector *args = node->u.call.args;
+  if (((args->size != 2) && (args->size != 3))) {
+    TypeChecker__error(this, Error__new_note(node->span, "Incorrect arguments to shuffle", "Expected one or two vectors and a mask"));
+    return NULL;
+  } 
+  Argument *first = ((Argument *)Vector__at(args, 0));
+  Type *type = TypeChecker__check_expression(this, first->expr, NULL);
+  if ((!((bool)type))) 
+  return NULL;
+  
+  if ((!Type__is_simd(type))) {
+    TypeChecker__error(this, Error__new_note(first->expr->span, "Expression must be a SIMD vector", format_string("Got type '%s'", Type__str(type))));
+    return NULL;
+  } 
+  if (args->size == 3) {
+    Argument *second = ((Argument *)Vector__at(args, 1));
+    Type *second_type = TypeChecker__check_expression(this, second->expr, type);
+    if ((((bool)second_type) && (!Type__eq(second_type, type)))) {
+      TypeChecker__error(this, Error__new_note(second->expr->span, "Vectors to shuffle must be of the same type", format_string("Expected '%s', got '%s'", Type__str(type), Type__str(second_type))));
+    } 
+  } 
+  Argument *mask = ((Argument *)Vector__back(args));
+  Type *mask_type = TypeChecker__check_expression(this, mask->expr, NULL);
+  if ((!((bool)mask_type))) 
+  return type;
+  
+  bool valid_mask = (((Type__is_simd(mask_type) && Type__is_integer(mask_type->ptr)) && mask_type->lanes == type->lanes) && BaseType__scalar_size(mask_type->ptr->base) == BaseType__scalar_size(type->ptr->base));
+  if ((!valid_mask)) {
+    TypeChecker__error(this, Error__new_note(mask->expr->span, "Invalid shuffle mask", format_string("Expected %d integer lanes of the same size as '%s', got '%s'", type->lanes, Type__str(type->ptr), Type__str(mask_type))));
+  } 
+  return type;
+}
+
+static Type *TypeChecker__check_simd_arith(TypeChecker *this, AST *node, Type *lhs, Type *rhs) {
+  Type *simd = (Type__is_simd(lhs) ? lhs : rhs);
+  Type *other = (Type__is_simd(lhs) ? rhs : lhs);
+  if (((!Type__eq(other, simd)) && (!Type__eq(other, simd->ptr)))) {
+    TypeChecker__error(this, Error__new_note(node->span, "Operands must be the same vector type, or its element type", format_string("Got types '%s' and '%s'", Type__str(lhs), Type__str(rhs))));
+    return NULL;
+  } 
+  bool needs_integer = ({ bool __yield_0;
+  switch (node->type) {
+    case ASTType__Modulus:
+    case ASTType__BitwiseOr:
+    case ASTType__BitwiseAnd:
+    case ASTType__BitwiseXor:
+    case ASTType__LeftShift:
+    case ASTType__RightShift: {
+      __yield_0 = true;
+} break;
+    default: {
+      __yield_0 = false;
+} break;
+  }
+;__yield_0; });
+  if ((needs_integer && (!Type__is_integer(simd->ptr)))) {
+    TypeChecker__error(this, Error__new_note(node->span, "Operator requires integer types", format_string("Got types '%s' and '%s'", Type__str(lhs), Type__str(rhs))));
+  } 
+  return simd;
+}
+
+static bool TypeChecker__simd_lane_to_index(TypeChecker *this, AST *node, Type *type) {
+  AST *rhs = node->u.member.rhs;
+  i32 lane = ({ i32 __yield_0;
+  {
+    char *__match_str = rhs->u.ident.name;
+    switch (aecor_hash_str(__match_str, 2166136261u)) {
+      case 794621484u:
+        if (!strcmp(__match_str, "x")) goto __match_3_0;
+        break;
+      case 804166841u:
+        if (!strcmp(__match_str, "y")) goto __match_3_1;
+        break;
+      case 228143771u:
+        if (!strcmp(__match_str, "z")) goto __match_3_2;
+        break;
+      case 1701362178u:
+        if (!strcmp(__match_str, "w")) goto __match_3_3;
+        break;
+    }
+    goto __match_3_default;
+    __match_3_0: {
+      __yield_0 = 0;
+} goto __match_3_end;
+    __match_3_1: {
+      __yield_0 = 1;
+} goto __match_3_end;
+    __match_3_2: {
+      __yield_0 = 2;
+} goto __match_3_end;
+    __match_3_3: {
+      __yield_0 = 3;
+} goto __match_3_end;
+    __match_3_default: {
+      __yield_0 = (-1);
+}
+    __match_3_end:;
+  }
+;__yield_0; });
+  if (((lane < 0) || (lane >= type->lanes))) {
+    TypeChecker__error(this, Error__new_note(rhs->span, format_string("Type '%s' has no member with this name", Type__str(type)), "Use an index to access lanes"));
+    return false;
+  } 
+  AST *index = AST__new(ASTType__IntLiteral, rhs->span);
+  index->u.num_literal.text = format_string("%d", lane);
+  AST *lhs = node->u.member.lhs;
+  node->type = ASTType__Index;
+  node->u.binary.lhs = lhs;
+  node->u.binary.rhs = index;
+  return true;
+}
+
+static void TypeChecker__call_dbg_on_enum_value(TypeChecker *this, AST *node) {
+  if ((!((bool)node->etype))) 
+  return;
+  
+  if ((!Type__is_enum(node->etype))) 
+  return;
+  
+  AST *lhs = ((AST *)calloc(1, sizeof(AST)));
+  (*lhs) = (*node);
+  AST *rhs = AST__new(ASTType__Identifier, node->span);
+  rhs->u.ident.name = "dbg";
+  AST *method = AST__new(ASTType__Member, node->span);
+  method->u.member.lhs = lhs;
+  method->u.member.rhs = rhs;
+  node->type = ASTType__Call;
+  node->u.call.callee = method;
+  node->u.call.args = Vector__new();
+  TypeChecker__check_expression(this, node, NULL);
+}
+
+static Type *TypeChecker__check_debug_assert(TypeChecker *this, AST *node) {
+  Vector *args = node->u.call.args;
+  if ((args->size != 2)) {
+    TypeChecker__error(this, Error__new_note(node->span, "Incorrect arguments to debug_assert", "Expected a condition and a message"));
+    return Type__new(BaseType__Void, node->span);
+  } 
+  Argument *cond = ((Argument *)Vector__at(args, 0));
+  Type *cond_type = TypeChecker__check_expression(this, cond->expr, NULL);
+  if ((((bool)cond_type) && (cond_type->base != BaseType__Bool))) {
+    TypeChecker__error(this, Error__new_note(cond->expr->span, "Condition must be a boolean", format_string("Got type '%s'", Type__str(cond_type))));
+  } 
+  Argument *msg = ((Argument *)Vector__at(args, 1));
+  Type *msg_type = TypeChecker__check_expression(this, msg->expr, NULL);
+  if ((((bool)msg_type) && (!Type__is_string(msg_type)))) {
+    TypeChecker__error(this, Error__new_note(msg->expr->span, "Message must be a string", format_string("Got type '%s'", Type__str(msg_type))));
+  } 
+  return Type__new(BaseType__Void, node->span);
+}
+
+static Type *TypeChecker__check_call(TypeChecker *this, AST *node) {
+  AST *callee = node->u.call.callee;
+  if (callee->type == ASTType__Identifier) {
+    callee->u.ident.is_function = false;
+    char *name = callee->u.ident.name;
+    if ((string__eq(name, "print") || string__eq(name, "println"))) {
+      for (i32 i = 0; (i < node->u.call.args->size); i += 1) {
+        Argument *arg = ((Argument *)Vector__at(node->u.call.args, i));
+        TypeChecker__check_expression(this, arg->expr, NULL);
+        TypeChecker__call_dbg_on_enum_value(this, arg->expr);
+      } 
+      return Type__new(BaseType__Void, node->span);
+    } 
+    if (string__eq(name, "debug_assert")) {
+      return TypeChecker__check_debug_assert(this, node);
+    } 
+    if ((string__eq(name, "shuffle") && (!Map__exists(this->functions, name)))) {
+      return TypeChecker__check_shuffle(this, node);
+    } 
+    Structure *struc = ((Structure *)Map__get(this->structures, name));
+    if (((bool)struc)) {
+      return TypeChecker__check_constructor(this, struc, node);
+    } 
+    Type *simd = Type__simd_from_name(name, callee->span);
+    if (((bool)simd)) {
+      return TypeChecker__check_simd_constructor(this, simd, node);
+    } 
+  } 
+  this->callee = callee;
+  Type *func_type = TypeChecker__check_expression(this, callee, NULL);
+  if ((!((bool)func_type))) 
+  return NULL;
+  
+  Function *func_def = func_type->func_def;
+  node->u.call.func = func_def;
+  if ((((bool)func_def) && func_def->exits)) {
+    node->returns = true;
+  } 
+  if (((func_type->base != BaseType__Function) && (func_type->base != BaseType__Method))) {
+    TypeChecker__error(this, Error__new_note(callee->span, "Cannot call a non-function type", format_string("Type for expression is '%s'", Type__str(func_type))));
+    return NULL;
+  } 
+  if (func_type->base == BaseType__Method) {
+    TypeChecker__check_method_call(this, func_type, node);
+  } 
+  Vector *params = func_type->params;
+  if ((params->size != node->u.call.args->size)) {
+    TypeChecker__error(this, Error__new_hint(node->span, "Number of arguments does not match function signature", func_type->span, format_string("This function expects %d arguments, got %d", params->size, node->u.call.args->size)));
+    return func_type->return_type;
+  } 
+  for (i32 i = 0; (i < params->size); i += 1) {
+    Variable *param = ((Variable *)Vector__at(params, i));
+    Argument *arg = ((Argument *)Vector__at(node->u.call.args, i));
+    Type *arg_type = TypeChecker__check_expression(this, arg->expr, param->type);
+    if ((((bool)arg_type) && (!Type__eq(param->type, arg_type)))) {
+      TypeChecker__error(this, Error__new_hint(arg->expr->span, "Argument type does not match function parameter type", param->span, format_string("Expected '%s', got '%s'", Type__str(param->type), Type__str(arg_type))));
+    } 
+    if ((!((bool)arg->label))) 
+    continue;
+    
+    if (string__eq(param->name, "")) {
+      TypeChecker__error(this, Error__new_hint(arg->label->span, "Label on non-labeled parameter", param->span, "This parameter does not have a name"));
+    } 
+    char *label = arg->label->u.ident.name;
+    if ((!string__eq(label, param->name))) {
+      TypeChecker__error(this, Error__new_hint(arg->label->span, "Label on parameter does not match parameter name", param->span, format_string("Expected '%s', got '%s'", param->name, label)));
+    } 
+  } 
+  return func_type->return_type;
+}
+
+static Type *TypeChecker__check_format_string(TypeChecker *this, AST *node) {
+  Vector *parts = node->u.fmt_str.parts;
+  Vector *exprs = node->u.fmt_str.exprs;
+  if ((parts->size != (exprs->size + 1))) {
+    TypeChecker__error(this, Error__new(node->span, "Number of format string parts does not match number of expressions"));
+  } 
+  for (i32 i = 0; (i < exprs->size); i += 1) {
+    AST *expr = ((AST *)Vector__at(exprs, i));
+    TypeChecker__check_expression(this, expr, NULL);
+    TypeChecker__call_dbg_on_enum_value(this, expr);
+  } 
+  return Type__ptr_to(BaseType__Char, node->span);
+}
+
+static Type *TypeChecker__check_pointer_arith(TypeChecker *this, AST *node, Type *lhs, Type *rhs) {
+  if ((node->type == ASTType__Plus || node->type == ASTType__Minus)) {
+    if ((lhs->base == BaseType__Pointer && Type__is_integer(rhs))) {
+      return lhs;
+    } 
+    if ((Type__is_integer(lhs) && rhs->base == BaseType__Pointer)) {
+      return rhs;
+    } 
+    if ((Type__eq(lhs, rhs) && lhs->base == BaseType__Pointer)) {
+      if (node->type == ASTType__Minus) {
+        return Type__new(BaseType__I32, node->span);
+      } 
+    } 
+  } 
+  TypeChecker__error(this, Error__new(node->span, "Invalid pointer arithmetic"));
+  return NULL;
+}
+
+static Type *TypeChecker__check_binary_op(TypeChecker *this, AST *node, AST *_lhs, AST *_rhs) {
+  if (((!((bool)_lhs->etype)) || (!((bool)_rhs->etype)))) {
+    panic("Expressions not checked in check_binary_op");
+  } 
+  Type *lhs = _lhs->etype;
+  Type *rhs = _rhs->etype;
+  switch (node->type) {
+    case ASTType__Plus:
+    case ASTType__Minus:
+    case ASTType__Multiply:
+    case ASTType__Divide: {
+      if ((Type__is_simd(lhs) || Type__is_simd(rhs))) {
+        return TypeChecker__check_simd_arith(this, node, lhs, rhs);
+      }  else       if ((lhs->base == BaseType__Pointer || rhs->base == BaseType__Pointer)) {
+        return TypeChecker__check_pointer_arith(this, node, lhs, rhs);
+      }  else       if (((!Type__is_numeric(lhs)) || (!Type__is_numeric(rhs)))) {
+        TypeChecker__error(this, Error__new_note(node->span, "Operator requires numeric types", format_string("Got types '%s' and '%s'", Type__str(lhs), Type__str(rhs))));
+        return NULL;
+      }  else       if ((!Type__eq(lhs, rhs))) {
+        TypeChecker__error(this, Error__new_note(node->span, "Operands must be of the same type", format_string("Got types '%s' and '%s'", Type__str(lhs), Type__str(rhs))));
+        return NULL;
+      }  else {
+        return lhs;
+      } 
+      
+      
+      
+    } break;
+    case ASTType__LessThan:
+    case ASTType__LessThanEquals:
+    case ASTType__GreaterThan:
+    case ASTType__GreaterThanEquals: {
+      if (((!Type__is_numeric_or_char(lhs)) || (!Type__is_numeric_or_char(rhs)))) {
+        TypeChecker__error(this, Error__new_note(node->span, "Operator requires numeric or char types", format_string("Got types '%s' and '%s'", Type__str(lhs), Type__str(rhs))));
+      } 
+      if ((!Type__eq(lhs, rhs))) {
+        TypeChecker__error(this, Error__new_note(node->span, "Operands must be of the same type", format_string("Got types '%s' and '%s'", Type__str(lhs), Type__str(rhs))));
+      } 
+      return Type__new(BaseType__Bool, node->span);
+    } break;
+    case ASTType__Equals:
+    case ASTType__NotEquals: {
+      if ((!Type__eq(lhs, rhs))) {
+        TypeChecker__error(this, Error__new_note(node->span, "Operands must be of the same type", format_string("Got types '%s' and '%s'", Type__str(lhs), Type__str(rhs))));
+      } 
+      if (lhs->base == BaseType__Structure) {
+        Structure *struc = ((Structure *)Map__get(this->structures, lhs->name));
+        if ((!struc->is_enum)) {
+          TypeChecker__error(this, Error__new(node->span, "Cannot compare structs directly"));
+        } 
+      } 
+      if (Type__is_simd(lhs)) {
+        TypeChecker__error(this, Error__new(node->span, "Cannot compare vectors directly"));
+      } 
+      return Type__new(BaseType__Bool, node->span);
+    } break;
+    case ASTType__And:
+    case ASTType__Or: {
+      if (((!Type__eq(lhs, rhs)) || (lhs->base != BaseType__Bool))) {
+        TypeChecker__error(this, Error__new_note(node->span, "Operands must be boolean", format_string("Got types '%s' and '%s'", Type__str(lhs), Type__str(rhs))));
+      } 
+      return Type__new(BaseType__Bool, node->span);
+    } break;
+    case ASTType__Modulus:
+    case ASTType__BitwiseOr:
+    case ASTType__BitwiseAnd:
+    case ASTType__BitwiseXor:
+    case ASTType__LeftShift:
+    case ASTType__RightShift: {
+      if ((Type__is_simd(lhs) || Type__is_simd(rhs))) {
+        return TypeChecker__check_simd_arith(this, node, lhs, rhs);
+      } 
+      if (((!Type__is_integer(lhs)) || (!Type__is_integer(rhs)))) {
+        TypeChecker__error(this, Error__new_note(node->span, "Operator requires integer types", format_string("Got types '%s' and '%s'", Type__str(lhs), Type__str(rhs))));
+      } 
+      if ((!Type__eq(lhs, rhs))) {
+        TypeChecker__error(this, Error__new_note(node->span, "Operands must be of the same type", format_string("Got types '%s' and '%s'", Type__str(lhs), Type__str(rhs))));
+      } 
+      return lhs;
+    } break;
+    default: panic(format_string("Internal error: unhandled op in check_binary_op: %s", ASTType__dbg(node->type))); break;
+  }
+}
+
+static void TypeChecker__error_unknown_identifier(TypeChecker *this, Span span, char *name) {
+  Vector *options = Vector__new();
+  for (i32 i = 0; (i < this->scopes->size); i += 1) {
+    Map *scope = ((Map *)Vector__at(this->scopes, i));
+    Map__push_keys(scope, options);
+  } 
+  for (MapIterator iter = Map__iter(this->functions); ((bool)iter.cur); MapIterator__next((&iter))) {
+    Function *func = ((Function *)MapIterator__value((&iter)));
+    if ((!func->is_method)) {
+      Vector__push(options, MapIterator__key((&iter)));
+    } 
+  } 
+  char *suggestion = find_word_suggestion(name, options);
+  if (((bool)suggestion)) {
+    TypeChecker__error(this, Error__new_note(span, "Unknown Identifier", format_string("Possible alternative: \x1b[32m%s\x1b[0m", suggestion)));
+  }  else {
+    TypeChecker__error(this, Error__new(span, "Unknown Identifier"));
+  } 
+}
+
+static void TypeChecker__error_unknown_member(TypeChecker *this, AST *node, Type *struct_type, char *field_name, bool is_static) {
+  char *suggestion = ((char *)NULL);
+  if (((bool)struct_type->struct_def)) {
+    Vector *options = Vector__new();
+    if (struct_type->struct_def->is_enum == is_static) {
+      Vector *fields = struct_type->struct_def->fields;
+      for (i32 i = 0; (i < fields->size); i += 1) {
+        Variable *field = ((Variable *)Vector__at(fields, i));
+        Vector__push(options, field->name);
+      } 
+    } 
+    Map *s_methods = ((Map *)Map__get(this->methods, struct_type->name));
+    if (((bool)s_methods)) {
+      for (MapIterator iter = Map__iter(s_methods); ((bool)iter.cur); MapIterator__next((&iter))) {
+        Function *method = ((Function *)MapIterator__value((&iter)));
+        if (method->is_static == is_static) {
+          Vector__push(options, method->name);
+        } 
+      } 
+    } 
+    suggestion = find_word_suggestion(field_name, options);
+  } 
+  if (((bool)suggestion)) {
+    TypeChecker__error(this, Error__new_note(node->u.member.rhs->span, format_string("Type '%s' has no member with this name", Type__str(struct_type)), format_string("Possible alternative: \x1b[32m%s\x1b[0m", suggestion)));
+  }  else {
+    TypeChecker__error(this, Error__new(node->u.member.rhs->span, format_string("Type '%s' has no member with this name", Type__str(struct_type))));
+  } 
+}
+
+static bool TypeChecker__try_infer_enum(TypeChecker *this, AST *node, Type *type) {
+  if ((node->type != ASTType__Identifier)) 
+  return false;
+  
+  char *name = node->u.ident.name;
+  if ((!((bool)type))) 
+  return false;
+  
+  if ((!Type__is_enum(type))) 
+  return false;
+  
+  Structure *struc = type->struct_def;
+  if ((!((bool)struc))) 
+  return false;
+  
+  Variable *var = Structure__find_field(struc, name);
+  if ((!((bool)var))) 
+  return false;
+  
+  AST *rhs = AST__new(ASTType__Identifier, node->span);
+  (*rhs) = (*node);
+  node->type = ASTType__EnumValue;
+  node->u.enum_val.struct_def = struc;
+  node->u.enum_val.var = var;
+  node->u.enum_val.lhs = NULL;
+  node->u.enum_val.rhs = rhs;
+  node->etype = struc->type;
+  return true;
+}
+
+static Type *TypeChecker__check_expression(TypeChecker *this, AST *node, Type *hint) {
+  Type *etype = ((Type *)NULL);
+  switch (node->type) {
+    case ASTType__Call: {
+      etype = TypeChecker__check_call(this, node);
+    } break;
+    case ASTType__BoolLiteral: {
+      etype = Type__new(BaseType__Bool, node->span);
+    } break;
+    case ASTType__CharLiteral: {
+      etype = Type__new(BaseType__Char, node->span);
+    } break;
+    case ASTType__StringLiteral: {
+      etype = Type__ptr_to(BaseType__Char, node->span);
+    } break;
+    case ASTType__Null: {
+      etype = Type__ptr_to(BaseType__Void, node->span);
+    } break;
+    case ASTType__FormatStringLiteral: {
+      etype = TypeChecker__check_format_string(this, node);
+    } break;
+    case ASTType__IntLiteral:
+    case ASTType__FloatLiteral: {
+      NumLiteral *num_lit = (&node->u.num_literal);
+      if ((((bool)hint) && Type__is_simd(hint))) {
+        hint = hint->ptr;
+      } 
+      if (((bool)num_lit->suffix)) {
+        etype = num_lit->suffix;
+        if ((!TypeChecker__type_is_valid(this, etype))) {
+          TypeChecker__error(this, Error__new(etype->span, "Invalid type"));
+        } 
+      }  else       if (node->type == ASTType__IntLiteral) {
+        etype = ({ Type *__yield_0;
+  if ((((bool)hint) && Type__is_integer(hint))) {
+    __yield_0 = hint;
+  }  else {
+    __yield_0 = Type__new(BaseType__I32, node->span);
+  } 
+;__yield_0; });
+      }  else {
+        etype = ({ Type *__yield_0;
+  if ((((bool)hint) && Type__is_float(hint))) {
+    __yield_0 = hint;
+  }  else {
+    __yield_0 = Type__new(BaseType__F32, node->span);
+  } 
+;__yield_0; });
+      } 
+      
+    } break;
+    case ASTType__Error: {
+      return NULL;
+    } break;
+    case ASTType__Constructor: {
+      etype = node->etype;
+    } break;
+    case ASTType__SizeOf: {
+      if ((!TypeChecker__type_is_valid(this, node->u.size_of_type))) {
+        TypeChecker__error(this, Error__new(node->u.size_of_type->span, "Invalid type"));
+      } 
+      etype = ({ Type *__yield_0;
+  if ((((bool)hint) && Type__is_integer(hint))) {
+    __yield_0 = hint;
+  }  else {
+    __yield_0 = Type__new(BaseType__I32, node->span);
+  } 
+;__yield_0; });
+    } break;
+    case ASTType__Identifier: {
+      Identifier *ident = (&node->u.ident);
+      Variable *var = TypeChecker__find_var(this, ident->name);
+      Function *func = ((Function *)Map__get(this->functions, ident->name));
+      if ((((bool)hint) && TypeChecker__try_infer_enum(this, node, hint))) {
+        etype = node->etype;
+      }  else       if (ident->is_function) {
+        etype = ident->func->type;
+      }  else       if (((bool)var)) {
+        ident->is_function = false;
+        ident->var = var;
+        etype = var->type;
+      }  else       if (((bool)func)) {
+        ident->is_function = true;
+        ident->func = func;
+        etype = func->type;
+        if ((node != this->callee)) 
+        func->is_address_taken = true;
+        
+      }  else {
+        TypeChecker__error_unknown_identifier(this, node->span, ident->name);
+        return NULL;
+      } 
+      
+      
+      
+    } break;
+    case ASTType__Plus:
+    case ASTType__Minus:
+    case ASTType__Multiply:
+    case ASTType__Divide:
+    case ASTType__LessThan:
+    case ASTType__LessThanEquals:
+    case ASTType__GreaterThan:
+    case ASTType__GreaterThanEquals:
+    case ASTType__Equals:
+    case ASTType__NotEquals:
+    case ASTType__And:
+    case ASTType__Or:
+    case ASTType__Modulus:
+    case ASTType__BitwiseOr:
+    case ASTType__BitwiseAnd:
+    case ASTType__BitwiseXor:
+    case ASTType__LeftShift:
+    case ASTType__RightShift: {
+      Type *lhs_type = TypeChecker__check_expression(this, node->u.binary.lhs, hint);
+      Type *rhs_type = TypeChecker__check_expression(this, node->u.binary.rhs, lhs_type);
+      if (((!((bool)lhs_type)) || (!((bool)rhs_type)))) 
+      return NULL;
+      
+      etype = TypeChecker__check_binary_op(this, node, node->u.binary.lhs, node->u.binary.rhs);
+    } break;
+    case ASTType__Not: {
+      Type *rhs = TypeChecker__check_expression(this, node->u.unary, NULL);
+      if ((((bool)rhs) && (rhs->base != BaseType__Bool))) {
+        TypeChecker__error(this, Error__new_note(node->u.unary->span, "Expression must be boolean", format_string("Got type '%s'", Type__str(rhs))));
+      } 
+      etype = Type__new(BaseType__Bool, node->span);
+    } break;
+    case ASTType__BitwiseNot: {
+      etype = TypeChecker__check_expression(this, node->u.unary, hint);
+      bool is_integer = (((bool)etype) && (Type__is_integer(etype) || (Type__is_simd(etype) && Type__is_integer(etype->ptr))));
+      if ((((bool)etype) && (!is_integer))) {
+        TypeChecker__error(this, Error__new_note(node->u.unary->span, "Expression must be an integer", format_string("Got type '%s'", Type__str(etype))));
+      } 
+    } break;
+    case ASTType__UnaryMinus: {
+      etype = TypeChecker__check_expression(this, node->u.unary, hint);
+      if ((!((bool)etype))) 
+      return NULL;
+      
+      if (((!Type__is_numeric(etype)) && (!Type__is_simd(etype)))) {
+        TypeChecker__error(this, Error__new_note(node->u.unary->span, "Expression must be a number", format_string("Got type '%s'", Type__str(etype))));
+      } 
+    } break;
+    case ASTType__Address: {
+      etype = TypeChecker__check_expression(this, node->u.unary, NULL);
+      if ((!((bool)etype))) 
+      return NULL;
+      
+      etype = Type__new_link(BaseType__Pointer, etype, node->span);
+    } break;
+    case ASTType__Dereference: {
+      Type *expr_type = TypeChecker__check_expression(this, node->u.unary, NULL);
+      if ((!((bool)expr_type))) 
+      return NULL;
+      
+      if ((expr_type->base != BaseType__Pointer)) {
+        TypeChecker__error(this, Error__new_note(node->u.unary->span, "Expression must be a pointer-type", format_string("Got type '%s'", Type__str(expr_type))));
+      } 
+      etype = expr_type->ptr;
+    } break;
+    case ASTType__Index: {
+      Type *expr_type = TypeChecker__check_expression(this, node->u.binary.lhs, NULL);
+      if ((!((bool)expr_type))) 
+      return NULL;
+      
+      if (((expr_type->base != BaseType__Pointer) && (!Type__is_simd(expr_type)))) {
+        TypeChecker__error(this, Error__new_note(node->u.binary.lhs->span, "Expression must be a pointer-type", format_string("Got type '%s'", Type__str(expr_type))));
+      } 
+      Type *index_type = TypeChecker__check_expression(this, node->u.binary.rhs, NULL);
+      if ((((bool)index_type) && (!Type__is_integer(index_type)))) {
+        TypeChecker__error(this, Error__new_note(node->u.binary.rhs->span, "Index must be an integer", format_string("Got type '%s'", Type__str(index_type))));
+      } 
+      etype = expr_type->ptr;
+    } break;
+    case ASTType__PlusEquals:
+    case ASTType__MinusEquals:
+    case ASTType__DivideEquals:
+    case ASTType__MultiplyEquals: {
+      Type *lhs = TypeChecker__check_expression(this, node->u.binary.lhs, NULL);
+      Type *rhs = TypeChecker__check_expression(this, node->u.binary.rhs, lhs);
+      if (((!((bool)lhs)) || (!((bool)rhs)))) 
+      return NULL;
+      
+      if ((!AST__is_lvalue(node->u.binary.lhs))) {
+        TypeChecker__error(this, Error__new(node->u.binary.lhs->span, "Must be an l-value"));
+      } 
+      if (Type__is_simd(lhs)) {
+        TypeChecker__check_simd_arith(this, node, lhs, rhs);
+      }  else {
+        if (((!Type__is_numeric(lhs)) || (!Type__is_numeric(rhs)))) {
+          TypeChecker__error(this, Error__new_note(node->span, "Operator requires numeric types", format_string("Got types '%s' and '%s'", Type__str(lhs), Type__str(rhs))));
+        } 
+        if ((!Type__eq(lhs, rhs))) {
+          TypeChecker__error(this, Error__new_note(node->span, "Operands must be of the same type", format_string("Got types '%s' and '%s'", Type__str(lhs), Type__str(rhs))));
+        } 
+      } 
+      etype = lhs;
+    } break;
+    case ASTType__Assignment: {
+      Type *lhs = TypeChecker__check_expression(this, node->u.binary.lhs, NULL);
+      Type *rhs = TypeChecker__check_expression(this, node->u.binary.rhs, lhs);
+      if (((!((bool)lhs)) || (!((bool)rhs)))) 
+      return NULL;
+      
+      if ((!AST__is_lvalue(node->u.binary.lhs))) {
+        TypeChecker__error(this, Error__new(node->u.binary.lhs->span, "Must be an l-value"));
+      } 
+      if ((!Type__eq(lhs, rhs))) {
+        TypeChecker__error(this, Error__new_note(node->span, "Variable type does not match assignment type", format_string("Expected type '%s', got '%s'", Type__str(lhs), Type__str(rhs))));
+      } 
+      etype = lhs;
+    } break;
+    case ASTType__ScopeLookup: {
+      if ((node->u.member.lhs->type != ASTType__Identifier)) {
+        TypeChecker__error(this, Error__new(node->u.member.lhs->span, "Left hand side of `::` must be a struct name"));
+        return NULL;
+      } 
+      char *struct_name = node->u.member.lhs->u.ident.name;
+      Structure *struc = ((Structure *)Map__get(this->structures, struct_name));
+      if ((!((bool)struc))) {
+        TypeChecker__error(this, Error__new(node->u.member.lhs->span, "Unknown struct with this name"));
+        return NULL;
+      } 
+      AST *lhs = node->u.member.lhs;
+      lhs->etype = struc->type;
+      AST *rhs = node->u.member.rhs;
+      char *field_name = rhs->u.ident.name;
+      Variable *var = TypeChecker__get_struct_member(this, struct_name, field_name);
+      Map *s_methods = ((Map *)Map__get(this->methods, struct_name));
+      Function *method = ((Function *)Map__get(s_methods, field_name));
+      if ((struc->is_enum && ((bool)var))) {
+        rhs->u.ident.var = var;
+        node->type = ASTType__EnumValue;
+        node->u.enum_val.struct_def = struc;
+        node->u.enum_val.var = var;
+        node->u.enum_val.lhs = lhs;
+        node->u.enum_val.rhs = rhs;
+        etype = struc->type;
+      }  else       if (((bool)method)) {
+        rhs->u.ident.is_function = true;
+        rhs->u.ident.func = method;
+        etype = method->type;
+        if ((node != this->callee)) 
+        method->is_address_taken = true;
+        
+      }  else {
+        TypeChecker__error_unknown_member(this, node, struc->type, field_name, true);
+        return NULL;
+      } 
+      
+    } break;
+    case ASTType__Member: {
+      Type *lhs_type = TypeChecker__check_expression(this, node->u.member.lhs, NULL);
+      if ((!((bool)lhs_type))) 
+      return NULL;
+      
+      if (Type__is_simd(lhs_type)) {
+        if ((!TypeChecker__simd_lane_to_index(this, node, lhs_type))) 
+        return NULL;
+        
+        return TypeChecker__check_expression(this, node, hint);
+      } 
+      if (((!Type__is_struct_or_ptr(lhs_type)) && (!Type__is_string(lhs_type)))) {
+        TypeChecker__error(this, Error__new_note(node->u.member.lhs->span, "LHS of member access must be a struct / string", format_string("Got type '%s'", Type__str(lhs_type))));
+        return NULL;
+      } 
+      node->u.member.is_pointer = lhs_type->name == NULL;
+      Type *struct_type = (((bool)lhs_type->name) ? lhs_type : lhs_type->ptr);
+      AST *rhs = node->u.member.rhs;
+      if ((rhs->type != ASTType__Identifier)) 
+      return NULL;
+      
+      char *struct_name = struct_type->name;
+      char *field_name = rhs->u.ident.name;
+      Structure *struc = ((Structure *)Map__get(this->structures, struct_name));
+      Variable *field = TypeChecker__get_struct_member(this, struct_name, field_name);
+      Map *s_methods = ((Map *)Map__get(this->methods, struct_name));
+      if ((!((bool)s_methods))) {
+        TypeChecker__error(this, Error__new(node->span, "Unknown struct with this name"));
+        return NULL;
+      } 
+      Function *method = ((Function *)Map__get(s_methods, field_name));
+      if (((((bool)struc) && ((bool)field)) && (!struc->is_enum))) {
+        etype = field->type;
+        rhs->u.ident.var = field;
+      }  else       if (((bool)method)) {
+        if (method->is_static) {
+          TypeChecker__error(this, Error__new_hint(node->span, "Member access requires a non-static method", method->span, "This is a static method"));
+        } 
+        rhs->u.ident.is_function = true;
+        rhs->u.ident.func = method;
+        etype = method->type;
+      }  else {
+        TypeChecker__error_unknown_member(this, node, struct_type, field_name, false);
+        return NULL;
+      } 
+      
+    } break;
+    case ASTType__Cast: {
+      Type *lhs_type = TypeChecker__check_expression(this, node->u.cast.lhs, NULL);
+      if ((!TypeChecker__type_is_valid(this, node->u.cast.to))) {
+        TypeChecker__error(this, Error__new(node->u.cast.to->span, "Type does not exist"));
+        return NULL;
+      } 
+      etype = node->u.cast.to;
+    } break;
+    case ASTType__IsNotNull: {
+      Type *lhs_type = TypeChecker__check_expression(this, node->u.unary, NULL);
+      if ((!((bool)lhs_type))) 
+      return NULL;
+      
+      if ((lhs_type->base != BaseType__Pointer)) {
+        TypeChecker__error(this, Error__new_note(node->span, "Can only use ? on pointer types", format_string("Type of expression is '%s'", Type__str(lhs_type))));
+      } 
+      etype = Type__new(BaseType__Bool, node->span);
+    } break;
+    case ASTType__Match: {
+      TypeChecker__check_match(this, node, true, hint);
+      etype = node->etype;
+    } break;
+    case ASTType__If: {
+      TypeChecker__check_if(this, node, true, hint);
+      etype = node->etype;
+    } break;
+    default: {
+      TypeChecker__error(this, Error__new(node->span, "Expected an expression statement"));
+    } break;
+  }
+  if ((!((bool)etype))) 
+  return NULL;
+  
+  etype = Type__decay_array(etype);
+  node->etype = etype;
+  return etype;
+}
+
+static void TypeChecker__check_expression_statement(TypeChecker *this, AST *node, AST *body, bool is_expr, Type *hint) {
+  switch (body->type) {
+    case ASTType__Match: {
+      TypeChecker__check_match(this, body, is_expr, hint);
+    } break;
+    case ASTType__If: {
+      TypeChecker__check_if(this, body, is_expr, hint);
+    } break;
+    case ASTType__Block: {
+      TypeChecker__check_block(this, body, is_expr);
+    } break;
+    default: {
+      if (is_expr) {
+        TypeChecker__check_expression(this, body, hint);
+      }  else {
+        TypeChecker__check_statement(this, body);
+      } 
+    } break;
+  }
+  node->returns = (node->returns && body->returns);
+  if ((!is_expr)) 
+  return;
+  
+  Type *ret = body->etype;
+  if (body->returns) {
+  }  else   if ((!((bool)ret))) {
+    TypeChecker__error(this, Error__new(body->span, "Must yield a value in this branch"));
+  }  else   if ((!((bool)node->etype))) {
+    node->etype = ret;
+  }  else   if ((!Type__eq(node->etype, ret))) {
+    TypeChecker__error(this, Error__new_note(body->span, "Yield type doesn't match previous branches", format_string("Expected type '%s', got '%s'", Type__str(node->etype), Type__str(ret))));
+  } 
+  
+  
+  
+}
+
+static void TypeChecker__check_match_for_enum(TypeChecker *this, Structure *struc, AST *node, bool is_expr, Type *hint) {
+  Map *mapping = Map__new();
+  ;
+  Vector *cases = node->u.match_stmt.cases;
+  node->returns = (cases->size > 0);
+  for (i32 i = 0; (i < cases->size); i += 1) {
+    MatchCase *_case = ((MatchCase *)Vector__at(cases, i));
+    AST *cond = _case->cond;
+    char *name;
+    Type *cond_type = TypeChecker__check_expression(this, cond, struc->type);
+    if ((!Type__eq(cond_type, struc->type))) {
+      TypeChecker__error(this, Error__new_hint(cond->span, "Condition does not match expression type", node->u.match_stmt.expr->span, format_string("Match expression is of type '%s'", Type__str(struc->type))));
+    } 
+    if ((cond->type != ASTType__EnumValue)) {
+      TypeChecker__error(this, Error__new(cond->span, "Expected an enum value"));
+      continue;
+    } 
+    name = cond->u.enum_val.var->name;
+    MatchCase *prev = ((MatchCase *)Map__get(mapping, name));
+    if (((bool)prev)) {
+      TypeChecker__error(this, Error__new_hint(cond->span, "Duplicate condition name in match", prev->cond->span, "This condition was previously used here"));
+    } 
+    Map__insert(mapping, name, _case);
+    if (((bool)_case->body)) {
+      TypeChecker__check_expression_statement(this, node, _case->body, is_expr, hint);
+    } 
+  } 
+  AST *defolt = node->u.match_stmt.defolt;
+  if ((mapping->num_items != struc->fields->size)) {
+    if ((!((bool)defolt))) {
+      TypeChecker__error(this, Error__new_note(node->span, "Match does not cover all cases", format_string("Only %d of %d cases are covered", mapping->num_items, struc->fields->size)));
+    }  else {
+      TypeChecker__check_expression_statement(this, node, defolt, is_expr, hint);
+    } 
+  }  else {
+    if (((bool)defolt)) {
+      TypeChecker__error(this, Error__new(node->u.match_stmt.defolt_span, "`else` case is not needed for this match"));
+    } 
+  } 
+  if (((is_expr && (!((bool)node->etype))) && (!node->returns))) {
+    TypeChecker__error(this, Error__new(node->span, "Expression-match must yield a value"));
+  } 
+
+  /* defers */
+  Map__free(mapping);
+}
+
+static void TypeChecker__check_match(TypeChecker *this, AST *node, bool is_expr, Type *hint) {
+  AST *expr = node->u.match_stmt.expr;
+  Type *expr_type = TypeChecker__check_expression(this, expr, NULL);
+  if ((!((bool)expr_type))) {
+    TypeChecker__error(this, Error__new(node->span, "Match statement must have a valid expression"));
+    return;
+  } 
+  Structure *struc;
+  if (expr_type->base == BaseType__Structure) {
+    struc = ((Structure *)Map__get(this->structures, expr_type->name));
+    if (struc->is_enum) {
+      TypeChecker__check_match_for_enum(this, struc, node, is_expr, hint);
+      return;
+    } 
+  } 
+  if ((((!Type__is_integer(expr_type)) && (expr_type->base != BaseType__Char)) && (!Type__is_string(expr_type)))) {
+    TypeChecker__error(this, Error__new_note(expr->span, "This type cannot be matched on", format_string("Expression type is '%s'", Type__str(expr_type))));
+  } 
+  Vector *cases = node->u.match_stmt.cases;
+  node->returns = (cases->size > 0);
+  for (i32 i = 0; (i < cases->size); i += 1) {
+    MatchCase *_case = ((MatchCase *)Vector__at(cases, i));
+    Type *cond_type = TypeChecker__check_expression(this, _case->cond, expr_type);
+    if ((!((bool)cond_type))) 
+    continue;
+    
+    if ((!Type__eq(cond_type, expr_type))) {
+      TypeChecker__error(this, Error__new_hint(cond_type->span, "Condition does not match expression type", node->u.match_stmt.expr->span, format_string("Match expression is of type '%s'", Type__str(cond_type))));
+    } 
+    if ((((_case->cond->type != ASTType__IntLiteral) && (_case->cond->type != ASTType__CharLiteral)) && (_case->cond->type != ASTType__StringLiteral))) {
+      TypeChecker__error(this, Error__new(_case->cond->span, "Match condition must use only literals"));
+    } 
+    if (((bool)_case->body)) {
+      TypeChecker__check_expression_statement(this, node, _case->body, is_expr, hint);
+    } 
+  } 
+  AST *defolt = node->u.match_stmt.defolt;
+  if ((!((bool)defolt))) {
+    TypeChecker__error(this, Error__new(node->span, "`else` case is missing"));
+  }  else {
+    TypeChecker__check_expression_statement(this, node, defolt, is_expr, hint);
+  } 
+  if (((is_expr && (!((bool)node->etype))) && (!node->returns))) {
+    TypeChecker__error(this, Error__new(node->span, "Expression-match must yield a value"));
+  } 
+}
+
+static void TypeChecker__check_if(TypeChecker *this, AST *node, bool is_expr, Type *hint) {
+  Type *cond_type = TypeChecker__check_expression(this, node->u.if_stmt.cond, NULL);
+  if ((((bool)cond_type) && (cond_type->base != BaseType__Bool))) {
+    TypeChecker__error(this, Error__new_note(node->u.if_stmt.cond->span, "Condition must be a boolean", format_string("Got type '%s'", Type__str(cond_type))));
+  } 
+  TypeChecker__check_expression_statement(this, node, node->u.if_stmt.body, is_expr, hint);
+  if (((bool)node->u.if_stmt.els)) {
+    AST *else_stmt = node->u.if_stmt.els;
+    TypeChecker__check_expression_statement(this, node, else_stmt, is_expr, hint);
+    if ((node->u.if_stmt.body->returns && else_stmt->returns)) {
+      node->returns = true;
+    } 
+  }  else   if (is_expr) {
+    TypeChecker__error(this, Error__new(node->span, "Expression-if must have an 'else' branch"));
+  } 
+  
+  if (((is_expr && (!((bool)node->etype))) && (!node->returns))) {
+    TypeChecker__error(this, Error__new(node->span, "Expression-if must yield a value"));
+  } 
+}
+
+static Type *TypeChecker__check_constant_expression(TypeChecker *this, AST *node) {
+  Type *etype = ({ Type *__yield_0;
+  switch (node->type) {
+    case ASTType__Identifier: {
+      Variable *constant = TypeChecker__find_constant(this, node->u.ident.name);
+      if ((!((bool)constant))) {
+        TypeChecker__error(this, Error__new(node->span, "No constant value found with this name"));
+        return NULL;
+      } 
+      node->u.ident.var = constant;
+      __yield_0 = constant->type;
+    } break;
+    case ASTType__IntLiteral: {
+      __yield_0 = Type__new(BaseType__I32, node->span);
+} break;
+    case ASTType__FloatLiteral: {
+      __yield_0 = Type__new(BaseType__F32, node->span);
+} break;
+    case ASTType__BoolLiteral: {
+      __yield_0 = Type__new(BaseType__Bool, node->span);
+} break;
+    case ASTType__CharLiteral: {
+      __yield_0 = Type__new(BaseType__Char, node->span);
+} break;
+    case ASTType__StringLiteral: {
+      __yield_0 = Type__ptr_to(BaseType__Char, node->span);
+} break;
+    case ASTType__Plus:
+    case ASTType__Minus:
+    case ASTType__Multiply:
+    case ASTType__Divide:
+    case ASTType__LessThan:
+    case ASTType__LessThanEquals:
+    case ASTType__GreaterThan:
+    case ASTType__GreaterThanEquals:
+    case ASTType__Equals:
+    case ASTType__NotEquals:
+    case ASTType__And:
+    case ASTType__Or:
+    case ASTType__Modulus:
+    case ASTType__BitwiseNot:
+    case ASTType__BitwiseOr:
+    case ASTType__BitwiseAnd:
+    case ASTType__BitwiseXor:
+    case ASTType__LeftShift:
+    case ASTType__RightShift: {
+      Type *lhs = TypeChecker__check_constant_expression(this, node->u.binary.lhs);
+      Type *rhs = TypeChecker__check_constant_expression(this, node->u.binary.rhs);
+      if (((!((bool)lhs)) || (!((bool)rhs)))) 
+      return NULL;
+      
+      if ((lhs->base == BaseType__Pointer || rhs->base == BaseType__Pointer)) {
+        TypeChecker__error(this, Error__new(node->span, "Cannot do pointer arithmetic in constant expressions"));
+      } 
+      __yield_0 = TypeChecker__check_binary_op(this, node, node->u.binary.lhs, node->u.binary.rhs);
+    } break;
+    default: {
+      TypeChecker__error(this, Error__new(node->span, "Unsupported operator in constant expression"));
+      return NULL;
+    } break;
+  }
+;__yield_0; });
+  node->etype = etype;
+  return etype;
+}
+
+static void TypeChecker__check_var_declaration(TypeChecker *this, AST *node, bool is_constant) {
+  VarDeclaration *var_decl = (&node->u.var_decl);
+  Type *declared_type = var_decl->var->type;
+  if ((((bool)declared_type) && (!TypeChecker__type_is_valid(this, declared_type)))) {
+    TypeChecker__error(this, Error__new(declared_type->span, "Invalid variable type"));
+  } 
+  if (((bool)var_decl->init)) {
+    Type *init_type = ({ Type *__yield_0;
+  if (is_constant) {
+    __yield_0 = TypeChecker__check_constant_expression(this, var_decl->init);
+  }  else {
+    __yield_0 = TypeChecker__check_expression(this, var_decl->init, declared_type);
+  } 
+;__yield_0; });
+    if ((((bool)init_type) && init_type->base == BaseType__Method)) {
+      TypeChecker__error(this, Error__new(var_decl->init->span, "Cannot assign methods to variables"));
+    } 
+    if ((!((bool)var_decl->var->type))) {
+      var_decl->var->type = init_type;
+    }  else     if (((bool)init_type)) {
+      if ((!Type__eq(declared_type, init_type))) {
+        TypeChecker__error(this, Error__new_note(var_decl->init->span, "Variable type does not match initializer type", format_string("Expected '%s' but got '%s'", Type__str(declared_type), Type__str(init_type))));
+      } 
+    } 
+    
+  }  else {
+    if ((!((bool)declared_type))) {
+      TypeChecker__error(this, Error__new(var_decl->var->span, "Variable type cannot be inferred, specify explicitly"));
+      var_decl->var->type = Type__new(BaseType__Void, node->span);
+    } 
+  } 
+  Variable *var = var_decl->var;
+  if (is_constant) {
+    Map__insert(this->constants, var->name, var);
+  }  else {
+    TypeChecker__push_var(this, var);
+  } 
+}
+
+static void TypeChecker__check_statement(TypeChecker *this, AST *node) {
+  switch (node->type) {
+    case ASTType__Block: {
+      TypeChecker__check_block(this, node, false);
+    } break;
+    case ASTType__Defer: {
+      TypeChecker__check_expression(this, node->u.unary, NULL);
+    } break;
+    case ASTType__Scratch: {
+      TypeChecker__check_block(this, node->u.unary, false);
+      node->returns = node->u.unary->returns;
+    } break;
+    case ASTType__Match: {
+      TypeChecker__check_match(this, node, false, NULL);
+    } break;
+    case ASTType__Yield: {
+      if ((!this->can_yield)) {
+        TypeChecker__error(this, Error__new(node->span, "Cannot yield in this context"));
+      } 
+      node->etype = TypeChecker__check_expression(this, node->u.unary, NULL);
+    } break;
+    case ASTType__Return: {
+      if ((!((bool)this->cur_func))) {
+        TypeChecker__error(this, Error__new(node->span, "Return statement outside of function"));
+      } 
+      if ((!((bool)node->u.unary))) {
+        if ((this->cur_func->return_type->base != BaseType__Void)) {
+          TypeChecker__error(this, Error__new_hint(node->span, "Cannot have empty return in non-void function", this->cur_func->return_type->span, format_string("This function returns '%s'", Type__str(this->cur_func->return_type))));
+        } 
+      }  else {
+        Type *ret_type = TypeChecker__check_expression(this, node->u.unary, this->cur_func->return_type);
+        if ((((bool)ret_type) && this->cur_func->return_type->base == BaseType__Void)) {
+          if ((ret_type->base != BaseType__Void)) {
+            TypeChecker__error(this, Error__new_hint(node->u.unary->span, format_string("Cannot return '%s' in void function", Type__str(ret_type)), this->cur_func->span, "This function does not return a value"));
+          } 
+        } 
+        if ((((bool)ret_type) && (!Type__eq(ret_type, this->cur_func->return_type)))) {
+          TypeChecker__error(this, Error__new_hint(node->u.unary->span, format_string("Return type '%s' is incorrect", Type__str(ret_type)), this->cur_func->return_type->span, format_string("This function returns '%s'", Type__str(this->cur_func->return_type))));
+        } 
+      } 
+      node->returns = true;
+    } break;
+    case ASTType__Break:
+    case ASTType__Continue: {
+      if ((!this->in_loop)) {
+        TypeChecker__error(this, Error__new(node->span, format_string("%s statement outside of loop", ASTType__dbg(node->type))));
+      } 
+    } break;
+    case ASTType__VarDeclaration: {
+      TypeChecker__check_var_declaration(this, node, false);
+    } break;
+    case ASTType__While: {
+      bool was_in_loop = this->in_loop;
+      this->in_loop = true;
+      Type *cond_type = TypeChecker__check_expression(this, node->u.loop.cond, NULL);
+      if ((((bool)cond_type) && (cond_type->base != BaseType__Bool))) {
+        TypeChecker__error(this, Error__new_note(node->u.loop.cond->span, "Condition must be boolean", format_string("Got type '%s'", Type__str(cond_type))));
+      } 
+      TypeChecker__check_statement(this, node->u.loop.body);
+      this->in_loop = was_in_loop;
+    } break;
+    case ASTType__For: {
+      bool was_in_loop = this->in_loop;
+      this->in_loop = true;
+      TypeChecker__push_scope(this);
+      if (((bool)node->u.loop.init)) {
+        TypeChecker__check_statement(this, node->u.loop.init);
+      } 
+      if (((bool)node->u.loop.cond)) {
+        Type *cond_type = TypeChecker__check_expression(this, node->u.loop.cond, NULL);
+        if ((((bool)cond_type) && (cond_type->base != BaseType__Bool))) {
+          TypeChecker__error(this, Error__new_note(node->u.loop.cond->span, "Condition must be boolean", format_string("Got type '%s'", Type__str(cond_type))));
+        } 
+      } 
+      if (((bool)node->u.loop.incr)) {
+        TypeChecker__check_statement(this, node->u.loop.incr);
+      } 
+      TypeChecker__check_statement(this, node->u.loop.body);
+      TypeChecker__pop_scope(this);
+      this->in_loop = was_in_loop;
+    } break;
+    case ASTType__If: {
+      TypeChecker__check_if(this, node, false, NULL);
+    } break;
+    default: {
+      TypeChecker__check_expression(this, node, NULL);
+    } break;
+  }
+}
+
+static void TypeChecker__check_block(TypeChecker *this, AST *node, bool can_yield) {
+  bool could_yield = this->can_yield;
+  this->can_yield = can_yield;
+  Span yield_span = {0};
+  TypeChecker__push_scope(this);
+  Vector *statements = node->u.block.statements;
+  for (i32 i = 0; (i < statements->size); i += 1) {
+    AST *statement = ((AST *)Vector__at(statements, i));
+    TypeChecker__check_statement(this, statement);
+    if (statement->returns) {
+      node->returns = true;
+    } 
+    if ((statement->type != ASTType__Yield)) 
+    continue;
+    
+    if (((bool)node->etype)) {
+      TypeChecker__error(this, Error__new_hint(statement->span, "Cannot yield multiple times in a block", yield_span, "Previously yield here is here"));
+    } 
+    node->etype = statement->etype;
+    yield_span = statement->span;
+  } 
+  TypeChecker__pop_scope(this);
+  this->can_yield = could_yield;
+}
+
+static void TypeChecker__check_function(TypeChecker *this, Function *func) {
+  Function *prev_func = this->cur_func;
+  this->cur_func = func;
+  TypeChecker__push_scope(this);
+  for (i32 i = 0; (i < func->params->size); i += 1) {
+    Variable *var = ((Variable *)Vector__at(func->params, i));
+    TypeChecker__push_var(this, var);
+  } 
+  if (((bool)func->body)) {
+    if (func->is_arrow) {
+      TypeChecker__check_statement(this, func->body);
+    }  else {
+      TypeChecker__check_block(this, func->body, false);
+    } 
+    if (((!func->body->returns) && (func->return_type->base != BaseType__Void))) {
+      if ((!string__eq(func->name, "main"))) {
+        TypeChecker__error(this, Error__new(func->span, "Function does not always return"));
+      } 
+    } 
+  } 
+  TypeChecker__pop_scope(this);
+  this->cur_func = prev_func;
+}
+
+static void TypeChecker__check_all_functions(TypeChecker *this, Program *program) {
+  for (i32 i = 0; (i < program->functions->size); i += 1) {
+    Function *func = ((Function *)Vector__at(program->functions, i));
+    char *name = func->name;
+    char *struct_name = func->method_struct_name;
+    Type *func_type = ((Type *)NULL);
+    if (func->is_method) {
+      Map *s_methods = ((Map *)Map__get(this->methods, struct_name));
+      if ((!((bool)s_methods))) {
+        TypeChecker__error(this, Error__new(func->span, "Type for method does not exist"));
+      } 
+      if ((((bool)s_methods) && Map__exists(s_methods, name))) {
+        Function *method = ((Function *)Map__get(s_methods, name));
+        TypeChecker__error(this, Error__new_hint(func->span, "Method is already defined for this type", method->span, "Previous definition here"));
+      } 
+      Variable *var = TypeChecker__get_struct_member(this, struct_name, name);
+      if (((bool)var)) {
+        TypeChecker__error(this, Error__new_hint(func->span, "Type already has a field with this name", var->span, "Previous definition here"));
+      } 
+      func_type = Type__new(BaseType__Method, func->span);
+      func_type->name = struct_name;
+    }  else {
+      func_type = Type__new(BaseType__Function, func->span);
+      if (Map__exists(this->functions, name)) {
+        Function *prev = ((Function *)Map__get(this->functions, name));
+        TypeChecker__error(this, Error__new_hint(func->span, "Function is already defined", prev->span, "Previous definition here"));
+      } 
+    } 
+    func_type->func_def = func;
+    for (i32 j = 0; (j < func->params->size); j += 1) {
+      Variable *param = ((Variable *)Vector__at(func->params, j));
+      if ((!TypeChecker__type_is_valid(this, param->type))) {
+        TypeChecker__error(this, Error__new(param->type->span, "Invalid parameter type"));
+      } 
+    } 
+    func_type->params = func->params;
+    if ((!TypeChecker__type_is_valid(this, func->return_type))) {
+      TypeChecker__error(this, Error__new(func->return_type->span, "Invalid return type"));
+    } 
+    func_type->return_type = func->return_type;
+    func->type = func_type;
+    if (func->is_method) {
+      Map *s_methods = ((Map *)Map__get(this->methods, struct_name));
+      if (((bool)s_methods)) 
+      Map__insert(s_methods, name, func);
+      
+    }  else {
+      Map__insert(this->functions, name, func);
+    } 
+  } 
+  for (i32 i = 0; (i < program->functions->size); i += 1) {
+    TypeChecker__check_function(this, ((Function *)Vector__at(program->functions, i)));
+  } 
+}
+
+static void TypeChecker__dfs_structs(TypeChecker *this, Structure *struc, Vector *results, Map *done) {
+  Map__insert(done, struc->name, struc);
+  for (i32 i = 0; (i < struc->fields->size); i += 1) {
+    Variable *field = ((Variable *)Vector__at(struc->fields, i));
+    if ((!TypeChecker__type_is_valid(this, field->type))) {
+      TypeChecker__error(this, Error__new(field->type->span, "Type of field is undefined"));
+      continue;
+    } 
+    if (((!struc->is_extern) && field->type->base == BaseType__Structure)) {
+      char *neib_name = field->type->name;
+      Structure *neib_struc = ((Structure *)Map__get(this->structures, neib_name));
+      if ((((bool)neib_struc) && (!Map__exists(done, neib_name)))) {
+        TypeChecker__dfs_structs(this, neib_struc, results, done);
+      } 
+    } 
+  } 
+  Vector__push(results, struc);
+}
+
+static Function *TypeChecker__add_builtin_method(TypeChecker *this, Map *s_methods, Structure *struc, char *name, Variable *param, Type *return_type) {
+  Function *func = Function__new(struc->span);
+  func->name = name;
+  func->return_type = return_type;
+  func->is_method = true;
+  func->method_struct_name = struc->name;
+  Vector__push(func->params, param);
+  Map__insert(s_methods, name, func);
+  func->type = Type__new(BaseType__Method, func->span);
+  func->type->name = struc->name;
+  func->type->func_def = func;
+  func->type->params = func->params;
+  func->type->return_type = func->return_type;
+  return func;
+}
+
+static void TypeChecker__check_all_structs(TypeChecker *this, Program *program) {
+  for (i32 i = 0; (i < program->structures->size); i += 1) {
+    Structure *struc = ((Structure *)Vector__at(program->structures, i));
+    char *name = struc->name;
+    if (Map__exists(this->structures, name)) {
+      Structure *prev = ((Structure *)Map__get(this->structures, name));
+      TypeChecker__error(this, Error__new_hint(struc->span, "Struct has already been defined", prev->span, "Previous definition here"));
+    } 
+    Map__insert(this->structures, name, struc);
+    Map *s_methods = Map__new();
+    if (struc->is_enum) {
+      Variable *this_param = Variable__new("this", struc->type, struc->span);
+      Type *str_type = Type__ptr_to(BaseType__Char, struc->span);
+      TypeChecker__add_builtin_method(this, s_methods, struc, "dbg", this_param, str_type);
+      Variable *str_param = Variable__new("s", str_type, struc->span);
+      Type *ptr_type = Type__new_link(BaseType__Pointer, struc->type, struc->span);
+      Function *from_str = TypeChecker__add_builtin_method(this, s_methods, struc, "from_str", str_param, ptr_type);
+      from_str->is_static = true;
+    } 
+    Map__insert(this->methods, name, s_methods);
+  } 
+  Map *done = Map__new();
+  Vector *results = Vector__new();
+  for (i32 i = 0; (i < program->structures->size); i += 1) {
+    Structure *struc = ((Structure *)Vector__at(program->structures, i));
+    if ((!Map__exists(done, struc->name))) {
+      TypeChecker__dfs_structs(this, struc, results, done);
+    } 
+  } 
+  Map__free(done);
+  Vector__free(program->structures);
+  program->structures = results;
+}
+
+static void TypeChecker__check_program(TypeChecker *this, Program *program) {
+  this->program = program;
+  for (i32 i = 0; (i < program->constants->size); i += 1) {
+    AST *node = ((AST *)Vector__at(program->constants, i));
+    TypeChecker__check_var_declaration(this, node, true);
+  } 
+  TypeChecker__check_all_structs(this, program);
+  TypeChecker__push_scope(this);
+  for (i32 i = 0; (i < program->global_vars->size); i += 1) {
+    AST *var = ((AST *)Vector__at(program->global_vars, i));
+    TypeChecker__check_var_declaration(this, var, false);
+  } 
+  TypeChecker__check_all_functions(this, program);
+  TypeChecker__pop_scope(this);
+  program->methods = this->methods;
+}
+
+i32 main(void) {
+  i32 iters = 20;
+  char *filename = "compiler/main.ae";
+  f64 start = time_now();
+  for (i32 i = 0; (i < iters); i += 1) {
+    Parser *parser = Parser__new(filename);
+    Program *program = Program__new();
+    Parser__include_prelude(parser, program);
+    Parser__include_file(parser, program, filename);
+    TypeChecker *checker = TypeChecker__new();
+    TypeChecker__check_program(checker, program);
+    bench_sink += ((u64)program->functions->size);
+  } 
+  bench_report("parse + check compiler/main.ae", (time_now() - start), iters);
+}
+
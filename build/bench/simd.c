@@ -0,0 +1,596 @@
+#include "stdio.h"
+#include "stdlib.h"
+#include "stdbool.h"
+#include "stdint.h"
+#include "string.h"
+#include "errno.h"
+#include "ctype.h"
+#include "time.h"
+#include "math.h"
+
+/***************** embed './lib/prelude.h' *****************/
+#include "stdarg.h"
+
+typedef int8_t i8;
+typedef int16_t i16;
+typedef int32_t i32;
+typedef int64_t i64;
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+
+typedef float f32;
+typedef double f64;
+
+// SIMD vector types, such as `f32x4`, using GCC's vector extensions
+#define AECOR_SIMD_TYPE(T, lanes) \
+  typedef T aecor_##T##x##lanes __attribute__((vector_size(sizeof(T) * lanes)));
+#define AECOR_SIMD_TYPES(T) \
+  AECOR_SIMD_TYPE(T, 2) AECOR_SIMD_TYPE(T, 4) AECOR_SIMD_TYPE(T, 8) \
+  AECOR_SIMD_TYPE(T, 16) AECOR_SIMD_TYPE(T, 32) AECOR_SIMD_TYPE(T, 64)
+
+AECOR_SIMD_TYPES(i8) AECOR_SIMD_TYPES(i16) AECOR_SIMD_TYPES(i32) AECOR_SIMD_TYPES(i64)
+AECOR_SIMD_TYPES(u8) AECOR_SIMD_TYPES(u16) AECOR_SIMD_TYPES(u32) AECOR_SIMD_TYPES(u64)
+AECOR_SIMD_TYPES(f32) AECOR_SIMD_TYPES(f64)
+
+// Formats into `stack` if the result fits in `capacity` bytes, otherwise
+// returns a new heap-allocated string that the caller needs to free.
+char* format_string_into(char* stack, int capacity, const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  int size = vsnprintf(stack, capacity, format, args);
+  va_end(args);
+  if (size < capacity) return stack;
+  char* s = malloc(size + 1);
+  va_start(args, format);
+  vsnprintf(s, size + 1, format, args);
+  va_end(args);
+  return s;
+}
+
+// Formats into a stack buffer first since most formatted strings are short,
+// which saves a separate pass just to compute the size.
+static char* aecor_vformat(void* (*alloc)(size_t), const char* format, va_list args) {
+  char stack[256];
+  va_list copy;
+  va_copy(copy, args);
+  int size = vsnprintf(stack, sizeof(stack), format, copy);
+  va_end(copy);
+  char* s = alloc(size + 1);
+  if (size < (int)sizeof(stack)) {
+    memcpy(s, stack, size + 1);
+  } else {
+    vsnprintf(s, size + 1, format, args);
+  }
+  return s;
+}
+
+char* format_string(const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  char* s = aecor_vformat(malloc, format, args);
+  va_end(args);
+  return s;
+}
+
+// Scratch arena backing `scratch { ... }` blocks. Memory is handed out from a
+// list of chunks with a bump pointer, and everything allocated inside a block
+// is released at once when it ends by restoring the position saved on entry.
+// Chunks past the current one are kept around to be reused.
+#define AECOR_SCRATCH_CHUNK_SIZE (64 * 1024)
+
+typedef struct aecor_scratch_chunk {
+  struct aecor_scratch_chunk* next;
+  size_t capacity;
+  size_t used;
+  char data[];
+} aecor_scratch_chunk;
+
+typedef struct {
+  aecor_scratch_chunk* chunk;
+  size_t used;
+} aecor_scratch_mark;
+
+static aecor_scratch_chunk* aecor_scratch_first = NULL;
+static aecor_scratch_chunk* aecor_scratch_current = NULL;
+
+void* scratch_alloc(size_t size) {
+  size = (size + 15) & ~(size_t)15;
+  aecor_scratch_chunk* chunk = aecor_scratch_current;
+  if (!chunk || chunk->used + size > chunk->capacity) {
+    aecor_scratch_chunk** link = chunk ? &chunk->next : &aecor_scratch_first;
+    if (!*link || (*link)->capacity < size) {
+      size_t capacity = size > AECOR_SCRATCH_CHUNK_SIZE ? size : AECOR_SCRATCH_CHUNK_SIZE;
+      aecor_scratch_chunk* fresh = malloc(sizeof(aecor_scratch_chunk) + capacity);
+      if (!fresh) {
+        printf("Out of memory!\n");
+        exit(1);
+      }
+      fresh->capacity = capacity;
+      fresh->next = *link;
+      *link = fresh;
+    }
+    chunk = *link;
+    chunk->used = 0;
+    aecor_scratch_current = chunk;
+  }
+  void* ptr = chunk->data + chunk->used;
+  chunk->used += size;
+  return ptr;
+}
+
+aecor_scratch_mark aecor_scratch_save() {
+  aecor_scratch_chunk* chunk = aecor_scratch_current;
+  return (aecor_scratch_mark){chunk, chunk ? chunk->used : 0};
+}
+
+void aecor_scratch_restore(aecor_scratch_mark* mark) {
+  aecor_scratch_current = mark->chunk;
+  if (mark->chunk) mark->chunk->used = mark->used;
+}
+
+char* format_string_scratch(const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  char* s = aecor_vformat(scratch_alloc, format, args);
+  va_end(args);
+  return s;
+}
+
+// Output buffer for `print` / `println` when compiling with `-b`. Writes are
+// collected here and handed to stdio in large chunks, which avoids paying
+// for `printf`'s locking and format parsing on every call.
+#define AECOR_STDOUT_BUFFER_SIZE (64 * 1024)
+
+static char aecor_stdout_buffer[AECOR_STDOUT_BUFFER_SIZE];
+static size_t aecor_stdout_size = 0;
+
+void aecor_stdout_flush(void) {
+  fwrite(aecor_stdout_buffer, 1, aecor_stdout_size, stdout);
+  fflush(stdout);
+  aecor_stdout_size = 0;
+}
+
+__attribute__((constructor)) static void aecor_stdout_init(void) {
+  atexit(aecor_stdout_flush);
+}
+
+static inline void aecor_stdout_write(const char* s, size_t len) {
+  if (aecor_stdout_size + len > AECOR_STDOUT_BUFFER_SIZE) {
+    aecor_stdout_flush();
+    if (len > AECOR_STDOUT_BUFFER_SIZE) {
+      fwrite(s, 1, len, stdout);
+      return;
+    }
+  }
+  memcpy(aecor_stdout_buffer + aecor_stdout_size, s, len);
+  aecor_stdout_size += len;
+}
+
+void aecor_stdout_puts(const char* s) {
+  aecor_stdout_write(s, strlen(s));
+}
+
+void aecor_stdout_putc(char c) {
+  if (aecor_stdout_size == AECOR_STDOUT_BUFFER_SIZE) aecor_stdout_flush();
+  aecor_stdout_buffer[aecor_stdout_size++] = c;
+}
+
+void aecor_stdout_put_u64(u64 value) {
+  char digits[20];
+  int len = 0;
+  do {
+    digits[sizeof(digits) - ++len] = '0' + value % 10;
+    value /= 10;
+  } while (value);
+  aecor_stdout_write(digits + sizeof(digits) - len, len);
+}
+
+void aecor_stdout_put_i64(i64 value) {
+  if (value < 0) {
+    aecor_stdout_putc('-');
+    aecor_stdout_put_u64(-(u64)value);
+  } else {
+    aecor_stdout_put_u64(value);
+  }
+}
+
+// Used for anything that isn't a format string literal, as well as the
+// arguments with explicit format specs.
+int aecor_stdout_printf(const char* format, ...) {
+  char stack[256];
+  va_list args;
+  va_start(args, format);
+  int size = vsnprintf(stack, sizeof(stack), format, args);
+  va_end(args);
+  if (size < (int)sizeof(stack)) {
+    aecor_stdout_write(stack, size);
+  } else {
+    char* s = malloc(size + 1);
+    va_start(args, format);
+    vsnprintf(s, size + 1, format, args);
+    va_end(args);
+    aecor_stdout_write(s, size);
+    free(s);
+  }
+  return size;
+}
+
+void aecor_stdout_put_f64(f64 value) {
+  aecor_stdout_printf("%f", value);
+}
+
+void aecor_stdout_put_ptr(void* value) {
+  aecor_stdout_printf("%p", value);
+}
+
+// FNV-1a with a murmur3 finalizer, used for hashed dispatch on strings.
+// Must be kept in sync with `hash_string` in `compiler/utils.ae`.
+u32 aecor_hash_str(const char* s, u32 seed) {
+  u32 hash = seed;
+  for (; *s; s++) {
+    hash = (hash ^ (u8)*s) * 16777619u;
+  }
+  hash = (hash ^ (hash >> 16)) * 0x85ebca6bu;
+  hash = (hash ^ (hash >> 13)) * 0xc2b2ae35u;
+  return hash ^ (hash >> 16);
+}
+
+
+/* constants */
+const i32 NUM_FLOATS = 4096;
+const i32 NUM_POINTS = 4096;
+
+/* struct declarations */
+typedef struct Vec Vec;
+
+struct Vec {
+  f32 x;
+  f32 y;
+  f32 z;
+};
+
+/* function declarations */
+static FILE *File__open(char *path, char *mode);
+static bool File__exists(char *path);
+static i32 File__size(FILE *this);
+static char *File__slurp(FILE *this);
+static i32 File__read(FILE *this, void *buf, i32 size);
+static i32 File__write(FILE *this, void *buf, i32 size);
+static void File__puts(FILE *this, char *str);
+static __attribute__((noreturn)) __attribute__((cold)) void panic(char *msg);
+static bool string__starts_with(char *this, char *prefix);
+static bool string__ends_with(char *this, char *suffix);
+static void string__remove_last_n(char *this, i32 n);
+static bool string__eq(char *this, char *str2);
+static char *string__substring(char *this, i32 start, i32 len);
+static void string__strip_trailing_whitespace(char *this);
+static i32 min(i32 a, i32 b);
+static i32 max(i32 a, i32 b);
+static f64 time_now(void);
+static void bench_report(char *name, f64 elapsed, i32 iters);
+static f32 minf(f32 a, f32 b);
+static f32 maxf(f32 a, f32 b);
+static f32 clampf(f32 x, f32 min, f32 max);
+static f32 clamp01(f32 x);
+static f32 degrees(f32 radians);
+static f32 radians(f32 degrees);
+static void Vec__print(Vec this);
+static inline __attribute__((always_inline)) Vec Vec__add(Vec this, Vec other);
+static inline __attribute__((always_inline)) Vec Vec__addf(Vec this, f32 val);
+static inline __attribute__((always_inline)) Vec Vec__sub(Vec this, Vec other);
+static inline __attribute__((always_inline)) Vec Vec__subf(Vec this, f32 val);
+static inline __attribute__((always_inline)) Vec Vec__mult(Vec this, Vec other);
+static inline __attribute__((always_inline)) Vec Vec__multf(Vec this, f32 val);
+static inline __attribute__((always_inline)) Vec Vec__div(Vec this, Vec other);
+static inline __attribute__((always_inline)) Vec Vec__divf(Vec this, f32 val);
+static inline __attribute__((always_inline)) f32 Vec__dot(Vec this, Vec other);
+static inline __attribute__((always_inline)) Vec Vec__cross(Vec this, Vec other);
+static inline __attribute__((always_inline)) f32 Vec__length(Vec this);
+static inline __attribute__((always_inline)) f32 Vec__length_sq(Vec this);
+static inline __attribute__((always_inline)) Vec Vec__normalized(Vec this);
+static void run_dot_scalar(f32 *a, f32 *b, i32 iters);
+static void run_dot_simd(f32 *a, f32 *b, i32 iters);
+static void run_vec(i32 iters);
+static void run_vec_simd(i32 iters);
+i32 main(void);
+
+/* global variables */
+u64 bench_sink = 0;
+
+static FILE *File__open(char *path, char *mode) {
+  FILE *file = fopen(path, mode);
+  if ((!((bool)file))) {
+    printf("Error opening file '%s': %s""\n", path, strerror(errno));
+    exit(1);
+  } 
+  return file;
+}
+
+static bool File__exists(char *path) {
+  FILE *file = fopen(path, "r");
+  if ((!((bool)file))) {
+    return false;
+  } 
+  fclose(file);
+  return true;
+}
+
+static i32 File__size(FILE *this) {
+  i32 pos = ftell(this);
+  fseek(this, 0, SEEK_END);
+  i32 size = ftell(this);
+  fseek(this, pos, SEEK_SET);
+  return size;
+}
+
+static char *File__slurp(FILE *this) {
+  i32 pos = ftell(this);
+  fseek(this, 0, SEEK_END);
+  i32 size = ftell(this);
+  fseek(this, pos, SEEK_SET);
+  void *buf = calloc((size + 1), sizeof(char));
+  fread(buf, 1, size, this);
+  fseek(this, pos, SEEK_SET);
+  return ((char *)buf);
+}
+
+static i32 File__read(FILE *this, void *buf, i32 size) {
+  return fread(buf, 1, size, this);
+}
+
+static i32 File__write(FILE *this, void *buf, i32 size) {
+  return fwrite(buf, 1, size, this);
+}
+
+static void File__puts(FILE *this, char *str) {
+  fwrite(str, 1, strlen(str), this);
+}
+
+static __attribute__((noreturn)) __attribute__((cold)) void panic(char *msg) {
+  printf("%s""\n", msg);
+  aecor_stdout_flush();
+  exit(1);
+}
+
+static bool string__starts_with(char *this, char *prefix) {
+  i32 prefix_len = strlen(prefix);
+  if ((strlen(this) < prefix_len)) {
+    return false;
+  } 
+  return strncmp(this, prefix, prefix_len) == 0;
+}
+
+static bool string__ends_with(char *this, char *suffix) {
+  i32 suffix_len = strlen(suffix);
+  if ((strlen(this) < suffix_len)) {
+    return false;
+  } 
+  return strncmp(this, suffix, suffix_len) == 0;
+}
+
+static void string__remove_last_n(char *this, i32 n) {
+  this[(strlen(this) - n)] = '\0';
+}
+
+static bool string__eq(char *this, char *str2) {
+  return strcmp(this, str2) == 0;
+}
+
+static char *string__substring(char *this, i32 start, i32 len) {
+  char *new_str = ((char *)calloc((len + 1), sizeof(char)));
+  memcpy(new_str, (this + start), len);
+  return new_str;
+}
+
+static void string__strip_trailing_whitespace(char *this) {
+  for (i32 i = (strlen(this) - 1); (i >= 0); i -= 1) {
+    if ((this[i] != ' ')) 
+    break;
+    
+    this[i] = '\0';
+  } 
+}
+
+static i32 min(i32 a, i32 b) {
+  return ((a < b) ? a : b);
+}
+
+static i32 max(i32 a, i32 b) {
+  return ((a > b) ? a : b);
+}
+
+static f64 time_now(void) {
+  struct timespec ts = {0};
+  clock_gettime(CLOCK_MONOTONIC, (&ts));
+  return (((f64)ts.tv_sec) + (((f64)ts.tv_nsec) / 1000000000.0));
+}
+
+static void bench_report(char *name, f64 elapsed, i32 iters) {
+  f64 ns = ((elapsed * 1000000000.0) / ((f64)iters));
+  printf("%-32s %10.3f ms %10.2f ns/iter""\n", name, (elapsed * 1000.0), ns);
+}
+
+static f32 minf(f32 a, f32 b) {
+  if ((a < b)) 
+  return a;
+   else 
+  return b;
+  
+}
+
+static f32 maxf(f32 a, f32 b) {
+  if ((a > b)) 
+  return a;
+   else 
+  return b;
+  
+}
+
+static f32 clampf(f32 x, f32 min, f32 max) {
+  return maxf(minf(x, max), min);
+}
+
+static f32 clamp01(f32 x) {
+  return clampf(x, 0.0, 1.0);
+}
+
+static f32 degrees(f32 radians) {
+  return ((radians * 180.0) / M_PI);
+}
+
+static f32 radians(f32 degrees) {
+  return ((degrees * M_PI) / 180.0);
+}
+
+static void Vec__print(Vec this) {
+  printf("%f %f %f\n""\n", this.x, this.y, this.z);
+}
+
+static inline __attribute__((always_inline)) Vec Vec__add(Vec this, Vec other) {
+  return (Vec){(this.x + other.x), (this.y + other.y), (this.z + other.z)};
+}
+
+static inline __attribute__((always_inline)) Vec Vec__addf(Vec this, f32 val) {
+  return (Vec){(this.x + val), (this.y + val), (this.z + val)};
+}
+
+static inline __attribute__((always_inline)) Vec Vec__sub(Vec this, Vec other) {
+  return (Vec){(this.x - other.x), (this.y - other.y), (this.z - other.z)};
+}
+
+static inline __attribute__((always_inline)) Vec Vec__subf(Vec this, f32 val) {
+  return (Vec){(this.x - val), (this.y - val), (this.z - val)};
+}
+
+static inline __attribute__((always_inline)) Vec Vec__mult(Vec this, Vec other) {
+  return (Vec){(this.x * other.x), (this.y * other.y), (this.z * other.z)};
+}
+
+static inline __attribute__((always_inline)) Vec Vec__multf(Vec this, f32 val) {
+  return (Vec){(this.x * val), (this.y * val), (this.z * val)};
+}
+
+static inline __attribute__((always_inline)) Vec Vec__div(Vec this, Vec other) {
+  return (Vec){(this.x / other.x), (this.y / other.y), (this.z / other.z)};
+}
+
+static inline __attribute__((always_inline)) Vec Vec__divf(Vec this, f32 val) {
+  return (Vec){(this.x / val), (this.y / val), (this.z / val)};
+}
+
+static inline __attribute__((always_inline)) f32 Vec__dot(Vec this, Vec other) {
+  return (((this.x * other.x) + (this.y * other.y)) + (this.z * other.z));
+}
+
+static inline __attribute__((always_inline)) Vec Vec__cross(Vec this, Vec other) {
+  return (Vec){((this.y * other.z) - (this.z * other.y)), ((this.z * other.x) - (this.x * other.z)), ((this.x * other.y) - (this.y * other.x))};
+}
+
+static inline __attribute__((always_inline)) f32 Vec__length(Vec this) {
+  return sqrt((((this.x * this.x) + (this.y * this.y)) + (this.z * this.z)));
+}
+
+static inline __attribute__((always_inline)) f32 Vec__length_sq(Vec this) {
+  return (((this.x * this.x) + (this.y * this.y)) + (this.z * this.z));
+}
+
+static inline __attribute__((always_inline)) Vec Vec__normalized(Vec this) {
+  return Vec__divf(this, Vec__length(this));
+}
+
+static void run_dot_scalar(f32 *a, f32 *b, i32 iters) {
+  f64 start = time_now();
+  f32 total = 0.0;
+  for (i32 n = 0; (n < iters); n += 1) {
+    a[(n % NUM_FLOATS)] += 1.0;
+    f32 sum = 0.0;
+    for (i32 i = 0; (i < NUM_FLOATS); i += 1) {
+      sum += (a[i] * b[i]);
+    } 
+    total += sum;
+  } 
+  bench_report("dot f32 (scalar)", (time_now() - start), iters);
+  bench_sink += ((u64)total);
+}
+
+static void run_dot_simd(f32 *a, f32 *b, i32 iters) {
+  aecor_f32x4 *va = ((aecor_f32x4 *)a);
+  aecor_f32x4 *vb = ((aecor_f32x4 *)b);
+  f64 start = time_now();
+  f32 total = 0.0;
+  for (i32 n = 0; (n < iters); n += 1) {
+    a[(n % NUM_FLOATS)] += 1.0;
+    aecor_f32x4 sum = ((aecor_f32x4){0} + ((f32)0.0));
+    for (i32 i = 0; (i < (NUM_FLOATS / 4)); i += 1) {
+      sum += (va[i] * vb[i]);
+    } 
+    for (i32 i = 0; (i < 4); i += 1) {
+      total += sum[i];
+    } 
+  } 
+  bench_report("dot f32x4 (simd)", (time_now() - start), iters);
+  bench_sink += ((u64)total);
+}
+
+static void run_vec(i32 iters) {
+  Vec *a = ((Vec *)calloc(NUM_POINTS, sizeof(Vec)));
+  Vec *b = ((Vec *)calloc(NUM_POINTS, sizeof(Vec)));
+  for (i32 i = 0; (i < NUM_POINTS); i += 1) {
+    a[i] = (Vec){((f32)i), 1.0, 2.0};
+    b[i] = (Vec){0.5, ((f32)i), 0.25};
+  } 
+  f64 start = time_now();
+  Vec total = (Vec){0.0, 0.0, 0.0};
+  for (i32 n = 0; (n < iters); n += 1) {
+    for (i32 i = 0; (i < NUM_POINTS); i += 1) {
+      b[i] = Vec__add(Vec__multf(Vec__normalized(a[i]), 0.5), b[i]);
+    } 
+    total = Vec__add(total, b[(n % NUM_POINTS)]);
+  } 
+  bench_report("normalize Vec (struct)", (time_now() - start), iters);
+  bench_sink += ((u64)total.x);
+  free(a);
+  free(b);
+}
+
+static void run_vec_simd(i32 iters) {
+  aecor_f32x4 *a = ((aecor_f32x4 *)calloc(NUM_POINTS, sizeof(aecor_f32x4)));
+  aecor_f32x4 *b = ((aecor_f32x4 *)calloc(NUM_POINTS, sizeof(aecor_f32x4)));
+  for (i32 i = 0; (i < NUM_POINTS); i += 1) {
+    a[i] = ((aecor_f32x4){((f32)i), 1.0, 2.0, 0.0});
+    b[i] = ((aecor_f32x4){0.5, ((f32)i), 0.25, 0.0});
+  } 
+  f64 start = time_now();
+  aecor_f32x4 total = ((aecor_f32x4){0} + ((f32)0.0));
+  for (i32 n = 0; (n < iters); n += 1) {
+    for (i32 i = 0; (i < NUM_POINTS); i += 1) {
+      aecor_f32x4 v = a[i];
+      aecor_f32x4 sq = (v * v);
+      b[i] = ((v * ((f32)(0.5 / sqrt(((sq[0] + sq[1]) + sq[2]))))) + b[i]);
+    } 
+    total += b[(n % NUM_POINTS)];
+  } 
+  bench_report("normalize f32x4 (simd)", (time_now() - start), iters);
+  bench_sink += ((u64)total[0]);
+  free(a);
+  free(b);
+}
+
+i32 main(void) {
+  f32 *a = ((f32 *)aligned_alloc(32, (NUM_FLOATS * sizeof(f32))));
+  f32 *b = ((f32 *)aligned_alloc(32, (NUM_FLOATS * sizeof(f32))));
+  for (i32 i = 0; (i < NUM_FLOATS); i += 1) {
+    a[i] = (((f32)(i % 7)) * 0.5);
+    b[i] = (((f32)(i % 5)) * 0.25);
+  } 
+  run_dot_scalar(a, b, 100000);
+  run_dot_simd(a, b, 100000);
+  free(a);
+  free(b);
+  run_vec(10000);
+  run_vec_simd(10000);
+}
+
@@ -0,0 +1,3483 @@
+#include "stdio.h"
+#include "stdlib.h"
+#include "stdbool.h"
+#include "stdint.h"
+#include "string.h"
+#include "errno.h"
+#include "ctype.h"
+#include "math.h"
+#include "sys/socket.h"
+#include "netinet/in.h"
+#include "arpa/inet.h"
+#include "unistd.h"
+#include "errno.h"
+#include "sys/types.h"
+#include "time.h"
+#include "netdb.h"
+
+/***************** embed './lib/prelude.h' *****************/
+#include "stdarg.h"
+
+typedef int8_t i8;
+typedef int16_t i16;
+typedef int32_t i32;
+typedef int64_t i64;
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+
+typedef float f32;
+typedef double f64;
+
+// Formats into `stack` if the result fits in `capacity` bytes, otherwise
+// returns a new heap-allocated string that the caller needs to free.
+char* format_string_into(char* stack, int capacity, const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  int size = vsnprintf(stack, capacity, format, args);
+  va_end(args);
+  if (size < capacity) return stack;
+  char* s = malloc(size + 1);
+  va_start(args, format);
+  vsnprintf(s, size + 1, format, args);
+  va_end(args);
+  return s;
+}
+
+// Formats into a stack buffer first since most formatted strings are short,
+// which saves a separate pass just to compute the size.
+static char* aecor_vformat(void* (*alloc)(size_t), const char* format, va_list args) {
+  char stack[256];
+  va_list copy;
+  va_copy(copy, args);
+  int size = vsnprintf(stack, sizeof(stack), format, copy);
+  va_end(copy);
+  char* s = alloc(size + 1);
+  if (size < (int)sizeof(stack)) {
+    memcpy(s, stack, size + 1);
+  } else {
+    vsnprintf(s, size + 1, format, args);
+  }
+  return s;
+}
+
+char* format_string(const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  char* s = aecor_vformat(malloc, format, args);
+  va_end(args);
+  return s;
+}
+
+// Scratch arena backing `scratch { ... }` blocks. Memory is handed out from a
+// list of chunks with a bump pointer, and everything allocated inside a block
+// is released at once when it ends by restoring the position saved on entry.
+// Chunks past the current one are kept around to be reused.
+#define AECOR_SCRATCH_CHUNK_SIZE (64 * 1024)
+
+typedef struct aecor_scratch_chunk {
+  struct aecor_scratch_chunk* next;
+  size_t capacity;
+  size_t used;
+  char data[];
+} aecor_scratch_chunk;
+
+typedef struct {
+  aecor_scratch_chunk* chunk;
+  size_t used;
+} aecor_scratch_mark;
+
+static aecor_scratch_chunk* aecor_scratch_first = NULL;
+static aecor_scratch_chunk* aecor_scratch_current = NULL;
+
+void* scratch_alloc(size_t size) {
+  size = (size + 15) & ~(size_t)15;
+  aecor_scratch_chunk* chunk = aecor_scratch_current;
+  if (!chunk || chunk->used + size > chunk->capacity) {
+    aecor_scratch_chunk** link = chunk ? &chunk->next : &aecor_scratch_first;
+    if (!*link || (*link)->capacity < size) {
+      size_t capacity = size > AECOR_SCRATCH_CHUNK_SIZE ? size : AECOR_SCRATCH_CHUNK_SIZE;
+      aecor_scratch_chunk* fresh = malloc(sizeof(aecor_scratch_chunk) + capacity);
+      if (!fresh) {
+        printf("Out of memory!\n");
+        exit(1);
+      }
+      fresh->capacity = capacity;
+      fresh->next = *link;
+      *link = fresh;
+    }
+    chunk = *link;
+    chunk->used = 0;
+    aecor_scratch_current = chunk;
+  }
+  void* ptr = chunk->data + chunk->used;
+  chunk->used += size;
+  return ptr;
+}
+
+aecor_scratch_mark aecor_scratch_save() {
+  aecor_scratch_chunk* chunk = aecor_scratch_current;
+  return (aecor_scratch_mark){chunk, chunk ? chunk->used : 0};
+}
+
+void aecor_scratch_restore(aecor_scratch_mark* mark) {
+  aecor_scratch_current = mark->chunk;
+  if (mark->chunk) mark->chunk->used = mark->used;
+}
+
+char* format_string_scratch(const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  char* s = aecor_vformat(scratch_alloc, format, args);
+  va_end(args);
+  return s;
+}
+
+// Output buffer for `print` / `println` when compiling with `-b`. Writes are
+// collected here and handed to stdio in large chunks, which avoids paying
+// for `printf`'s locking and format parsing on every call.
+#define AECOR_STDOUT_BUFFER_SIZE (64 * 1024)
+
+static char aecor_stdout_buffer[AECOR_STDOUT_BUFFER_SIZE];
+static size_t aecor_stdout_size = 0;
+
+void aecor_stdout_flush(void) {
+  fwrite(aecor_stdout_buffer, 1, aecor_stdout_size, stdout);
+  fflush(stdout);
+  aecor_stdout_size = 0;
+}
+
+__attribute__((constructor)) static void aecor_stdout_init(void) {
+  atexit(aecor_stdout_flush);
+}
+
+static inline void aecor_stdout_write(const char* s, size_t len) {
+  if (aecor_stdout_size + len > AECOR_STDOUT_BUFFER_SIZE) {
+    aecor_stdout_flush();
+    if (len > AECOR_STDOUT_BUFFER_SIZE) {
+      fwrite(s, 1, len, stdout);
+      return;
+    }
+  }
+  memcpy(aecor_stdout_buffer + aecor_stdout_size, s, len);
+  aecor_stdout_size += len;
+}
+
+void aecor_stdout_puts(const char* s) {
+  aecor_stdout_write(s, strlen(s));
+}
+
+void aecor_stdout_putc(char c) {
+  if (aecor_stdout_size == AECOR_STDOUT_BUFFER_SIZE) aecor_stdout_flush();
+  aecor_stdout_buffer[aecor_stdout_size++] = c;
+}
+
+void aecor_stdout_put_u64(u64 value) {
+  char digits[20];
+  int len = 0;
+  do {
+    digits[sizeof(digits) - ++len] = '0' + value % 10;
+    value /= 10;
+  } while (value);
+  aecor_stdout_write(digits + sizeof(digits) - len, len);
+}
+
+void aecor_stdout_put_i64(i64 value) {
+  if (value < 0) {
+    aecor_stdout_putc('-');
+    aecor_stdout_put_u64(-(u64)value);
+  } else {
+    aecor_stdout_put_u64(value);
+  }
+}
+
+// Used for anything that isn't a format string literal, as well as the
+// arguments with explicit format specs.
+int aecor_stdout_printf(const char* format, ...) {
+  char stack[256];
+  va_list args;
+  va_start(args, format);
+  int size = vsnprintf(stack, sizeof(stack), format, args);
+  va_end(args);
+  if (size < (int)sizeof(stack)) {
+    aecor_stdout_write(stack, size);
+  } else {
+    char* s = malloc(size + 1);
+    va_start(args, format);
+    vsnprintf(s, size + 1, format, args);
+    va_end(args);
+    aecor_stdout_write(s, size);
+    free(s);
+  }
+  return size;
+}
+
+void aecor_stdout_put_f64(f64 value) {
+  aecor_stdout_printf("%f", value);
+}
+
+void aecor_stdout_put_ptr(void* value) {
+  aecor_stdout_printf("%p", value);
+}
+
+// FNV-1a with a murmur3 finalizer, used for hashed dispatch on strings.
+// Must be kept in sync with `hash_string` in `compiler/utils.ae`.
+u32 aecor_hash_str(const char* s, u32 seed) {
+  u32 hash = seed;
+  for (; *s; s++) {
+    hash = (hash ^ (u8)*s) * 16777619u;
+  }
+  hash = (hash ^ (hash >> 16)) * 0x85ebca6bu;
+  hash = (hash ^ (hash >> 13)) * 0xc2b2ae35u;
+  return hash ^ (hash >> 16);
+}
+
+
+/* constants */
+
+/* struct declarations */
+typedef struct Vector Vector;
+typedef struct MapNode MapNode;
+typedef struct Map Map;
+typedef struct MapIterator MapIterator;
+typedef struct Location Location;
+typedef struct Span Span;
+typedef enum TokenType TokenType;
+typedef struct Token Token;
+typedef enum ErrorType ErrorType;
+typedef struct Error Error;
+typedef enum MessageType MessageType;
+typedef struct Lexer Lexer;
+typedef struct Buffer Buffer;
+typedef struct JSONParser JSONParser;
+typedef struct JSON JSON;
+typedef enum ValueType ValueType;
+typedef union ValueUnion ValueUnion;
+typedef struct Value Value;
+typedef struct BencodeParser BencodeParser;
+typedef struct Bencode Bencode;
+typedef struct SHA1 SHA1;
+typedef struct BufferIO BufferIO;
+typedef struct Socket Socket;
+typedef enum SocketMode SocketMode;
+typedef struct TrackerState TrackerState;
+
+struct Vector {
+  i32 size;
+  i32 capacity;
+  void **data;
+};
+
+struct MapNode {
+  char *key;
+  void *value;
+  MapNode *next;
+};
+
+struct Map {
+  MapNode **buckets;
+  i32 num_items;
+  i32 num_buckets;
+  i32 num_collisions;
+};
+
+struct MapIterator {
+  i32 idx;
+  MapNode *cur;
+  Map *map;
+};
+
+struct Location {
+  char *filename;
+  i32 line;
+  i32 col;
+  i32 index;
+};
+
+struct Span {
+  Location start;
+  Location end;
+};
+
+enum TokenType {
+  TokenType__And,
+  TokenType__As,
+  TokenType__Bool,
+  TokenType__Break,
+  TokenType__Char,
+  TokenType__Const,
+  TokenType__Continue,
+  TokenType__Def,
+  TokenType__Defer,
+  TokenType__Else,
+  TokenType__Enum,
+  TokenType__Extern,
+  TokenType__False,
+  TokenType__F32,
+  TokenType__F64,
+  TokenType__For,
+  TokenType__Fn,
+  TokenType__I8,
+  TokenType__I16,
+  TokenType__I32,
+  TokenType__I64,
+  TokenType__If,
+  TokenType__Let,
+  TokenType__Match,
+  TokenType__Null,
+  TokenType__Not,
+  TokenType__Or,
+  TokenType__Return,
+  TokenType__Scratch,
+  TokenType__SizeOf,
+  TokenType__String,
+  TokenType__Struct,
+  TokenType__True,
+  TokenType__Then,
+  TokenType__U8,
+  TokenType__U16,
+  TokenType__U32,
+  TokenType__U64,
+  TokenType__UntypedPtr,
+  TokenType__Union,
+  TokenType__Use,
+  TokenType__Void,
+  TokenType__Yield,
+  TokenType__While,
+  TokenType__AtSign,
+  TokenType__Ampersand,
+  TokenType__Backtick,
+  TokenType__Caret,
+  TokenType__CharLiteral,
+  TokenType__CloseCurly,
+  TokenType__CloseParen,
+  TokenType__CloseSquare,
+  TokenType__Colon,
+  TokenType__ColonColon,
+  TokenType__Comma,
+  TokenType__Dot,
+  TokenType__EOF,
+  TokenType__Equals,
+  TokenType__EqualEquals,
+  TokenType__Exclamation,
+  TokenType__FatArrow,
+  TokenType__FloatLiteral,
+  TokenType__FormatStringLiteral,
+  TokenType__GreaterThan,
+  TokenType__GreaterThanGreaterThan,
+  TokenType__GreaterThanEquals,
+  TokenType__Identifier,
+  TokenType__IntLiteral,
+  TokenType__LessThan,
+  TokenType__LessThanLessThan,
+  TokenType__LessThanEquals,
+  TokenType__Line,
+  TokenType__Minus,
+  TokenType__MinusEquals,
+  TokenType__NotEquals,
+  TokenType__Newline,
+  TokenType__OpenCurly,
+  TokenType__OpenParen,
+  TokenType__OpenSquare,
+  TokenType__Percent,
+  TokenType__Plus,
+  TokenType__PlusEquals,
+  TokenType__Question,
+  TokenType__Semicolon,
+  TokenType__Slash,
+  TokenType__SlashEquals,
+  TokenType__Star,
+  TokenType__StarEquals,
+  TokenType__StringLiteral,
+  TokenType__Tilde,
+};
+
+static char *__TokenType_names[] = {"And", "As", "Bool", "Break", "Char", "Const", "Continue", "Def", "Defer", "Else", "Enum", "Extern", "False", "F32", "F64", "For", "Fn", "I8", "I16", "I32", "I64", "If", "Let", "Match", "Null", "Not", "Or", "Return", "Scratch", "SizeOf", "String", "Struct", "True", "Then", "U8", "U16", "U32", "U64", "UntypedPtr", "Union", "Use", "Void", "Yield", "While", "AtSign", "Ampersand", "Backtick", "Caret", "CharLiteral", "CloseCurly", "CloseParen", "CloseSquare", "Colon", "ColonColon", "Comma", "Dot", "EOF", "Equals", "EqualEquals", "Exclamation", "FatArrow", "FloatLiteral", "FormatStringLiteral", "GreaterThan", "GreaterThanGreaterThan", "GreaterThanEquals", "Identifier", "IntLiteral", "LessThan", "LessThanLessThan", "LessThanEquals", "Line", "Minus", "MinusEquals", "NotEquals", "Newline", "OpenCurly", "OpenParen", "OpenSquare", "Percent", "Plus", "PlusEquals", "Question", "Semicolon", "Slash", "SlashEquals", "Star", "StarEquals", "StringLiteral", "Tilde"};
+static TokenType __TokenType_values[] = {TokenType__And, TokenType__As, TokenType__Bool, TokenType__Break, TokenType__Char, TokenType__Const, TokenType__Continue, TokenType__Def, TokenType__Defer, TokenType__Else, TokenType__Enum, TokenType__Extern, TokenType__False, TokenType__F32, TokenType__F64, TokenType__For, TokenType__Fn, TokenType__I8, TokenType__I16, TokenType__I32, TokenType__I64, TokenType__If, TokenType__Let, TokenType__Match, TokenType__Null, TokenType__Not, TokenType__Or, TokenType__Return, TokenType__Scratch, TokenType__SizeOf, TokenType__String, TokenType__Struct, TokenType__True, TokenType__Then, TokenType__U8, TokenType__U16, TokenType__U32, TokenType__U64, TokenType__UntypedPtr, TokenType__Union, TokenType__Use, TokenType__Void, TokenType__Yield, TokenType__While, TokenType__AtSign, TokenType__Ampersand, TokenType__Backtick, TokenType__Caret, TokenType__CharLiteral, TokenType__CloseCurly, TokenType__CloseParen, TokenType__CloseSquare, TokenType__Colon, TokenType__ColonColon, TokenType__Comma, TokenType__Dot, TokenType__EOF, TokenType__Equals, TokenType__EqualEquals, TokenType__Exclamation, TokenType__FatArrow, TokenType__FloatLiteral, TokenType__FormatStringLiteral, TokenType__GreaterThan, TokenType__GreaterThanGreaterThan, TokenType__GreaterThanEquals, TokenType__Identifier, TokenType__IntLiteral, TokenType__LessThan, TokenType__LessThanLessThan, TokenType__LessThanEquals, TokenType__Line, TokenType__Minus, TokenType__MinusEquals, TokenType__NotEquals, TokenType__Newline, TokenType__OpenCurly, TokenType__OpenParen, TokenType__OpenSquare, TokenType__Percent, TokenType__Plus, TokenType__PlusEquals, TokenType__Question, TokenType__Semicolon, TokenType__Slash, TokenType__SlashEquals, TokenType__Star, TokenType__StarEquals, TokenType__StringLiteral, TokenType__Tilde};
+
+static char *TokenType__dbg(TokenType this) {
+  if ((u32)this < 90u) return __TokenType_names[this];
+  return "<unknown>";
+}
+
+static i32 __TokenType_displace[] = {-28, -66, 0, -32, 1, 0, 0, -29, -60, 0, -15, 0, -18, 0, 0, 1, 0, -51, 0, -53, -47, 2, 1, -2, 0, 1, -24, -19, -9, 0, 0, -12, 0, -34, 0, -62, 0, -50, 0, 0, 0, -49, 0, 0, 0, 0, -17, 0, -5, 0, 1, 0, 1, 0, 0, 0, 1, 0, 0, -31, 2, -38, 3, 0, -8, 0, -10, -64, -61, -30, -3, -57, -39, 0, -43, 0, -63, 6, 0, 0, -41, 0, -1, -54, 0, 0, 0, 0, -48, 0, 0, -40, 0, 0, -11, 0, -44, -20, -58, 1, 0, 1, 0, 0, 0, -7, 0, 1, 0, 1, -23, 0, -42, 0, 0, 0, -52, -6, 0, 2, 1, -26, -21, -59, 0, -37, 0, 0};
+static i32 __TokenType_slots[] = {1, 2, 5, 21, 7, 8, 12, 14, 16, 19, 20, 24, 35, 15, 25, 11, 30, 32, 33, 36, 37, 74, 38, 39, 23, 42, 41, 43, 44, 48, 49, 51, 18, 53, 31, 29, 54, 55, 57, 58, 59, 63, 65, 66, 28, 22, 67, 68, 70, 71, 72, 73, 75, 77, 4, 62, 78, 80, 83, 84, 85, 86, 87, 88, 9, 89, 34, 46, -1, -1, 76, -1, -1, 60, -1, 17, -1, -1, 82, 52, 10, 69, -1, 56, 27, -1, 13, -1, -1, 50, -1, -1, -1, -1, -1, 47, 3, -1, 81, -1, 79, -1, -1, -1, -1, -1, 26, -1, -1, -1, 64, 45, -1, -1, -1, -1, 6, -1, -1, -1, -1, 61, -1, 0, 40, -1, -1, -1};
+
+static TokenType *TokenType__from_str(char *s) {
+  i32 d = __TokenType_displace[aecor_hash_str(s, 0) & 127u];
+  i32 i = __TokenType_slots[d < 0 ? -d - 1 : aecor_hash_str(s, d) & 127u];
+  if (i < 0 || strcmp(s, __TokenType_names[i])) return NULL;
+  return &__TokenType_values[i];
+}
+
+struct Token {
+  TokenType type;
+  Span span;
+  char *text;
+  Token *suffix;
+  bool seen_newline;
+};
+
+enum ErrorType {
+  ErrorType__Standard,
+  ErrorType__WithNote,
+  ErrorType__WithHint,
+};
+
+static char *__ErrorType_names[] = {"Standard", "WithNote", "WithHint"};
+static ErrorType __ErrorType_values[] = {ErrorType__Standard, ErrorType__WithNote, ErrorType__WithHint};
+
+static char *ErrorType__dbg(ErrorType this) {
+  if ((u32)this < 3u) return __ErrorType_names[this];
+  return "<unknown>";
+}
+
+static i32 __ErrorType_displace[] = {-1, 0, 0, 2};
+static i32 __ErrorType_slots[] = {0, -1, 2, 1};
+
+static ErrorType *ErrorType__from_str(char *s) {
+  i32 d = __ErrorType_displace[aecor_hash_str(s, 0) & 3u];
+  i32 i = __ErrorType_slots[d < 0 ? -d - 1 : aecor_hash_str(s, d) & 3u];
+  if (i < 0 || strcmp(s, __ErrorType_names[i])) return NULL;
+  return &__ErrorType_values[i];
+}
+
+struct Error {
+  ErrorType type;
+  char *msg1;
+  Span span1;
+  char *msg2;
+  Span span2;
+};
+
+enum MessageType {
+  MessageType__Error,
+  MessageType__Warning,
+  MessageType__Note,
+};
+
+static char *__MessageType_names[] = {"Error", "Warning", "Note"};
+static MessageType __MessageType_values[] = {MessageType__Error, MessageType__Warning, MessageType__Note};
+
+static char *MessageType__dbg(MessageType this) {
+  if ((u32)this < 3u) return __MessageType_names[this];
+  return "<unknown>";
+}
+
+static i32 __MessageType_displace[] = {0, 0, 0, 1};
+static i32 __MessageType_slots[] = {0, 2, -1, 1};
+
+static MessageType *MessageType__from_str(char *s) {
+  i32 d = __MessageType_displace[aecor_hash_str(s, 0) & 3u];
+  i32 i = __MessageType_slots[d < 0 ? -d - 1 : aecor_hash_str(s, d) & 3u];
+  if (i < 0 || strcmp(s, __MessageType_names[i])) return NULL;
+  return &__MessageType_values[i];
+}
+
+struct Lexer {
+  char *source;
+  i32 source_len;
+  i32 i;
+  Location loc;
+  bool seen_newline;
+  Vector *tokens;
+  Vector *errors;
+};
+
+struct Buffer {
+  u8 *data;
+  i32 size;
+  i32 capacity;
+};
+
+struct JSONParser {
+  Vector *tokens;
+  i32 curr;
+};
+
+struct JSON {
+};
+
+enum ValueType {
+  ValueType__Null,
+  ValueType__Bool,
+  ValueType__Integer,
+  ValueType__String,
+  ValueType__List,
+  ValueType__Dictionary,
+};
+
+static char *__ValueType_names[] = {"Null", "Bool", "Integer", "String", "List", "Dictionary"};
+static ValueType __ValueType_values[] = {ValueType__Null, ValueType__Bool, ValueType__Integer, ValueType__String, ValueType__List, ValueType__Dictionary};
+
+static char *ValueType__dbg(ValueType this) {
+  if ((u32)this < 6u) return __ValueType_names[this];
+  return "<unknown>";
+}
+
+static i32 __ValueType_displace[] = {0, -5, 0, 0, -1, 0, -3, 1};
+static i32 __ValueType_slots[] = {2, 0, 3, 1, 4, 5, -1, -1};
+
+static ValueType *ValueType__from_str(char *s) {
+  i32 d = __ValueType_displace[aecor_hash_str(s, 0) & 7u];
+  i32 i = __ValueType_slots[d < 0 ? -d - 1 : aecor_hash_str(s, d) & 7u];
+  if (i < 0 || strcmp(s, __ValueType_names[i])) return NULL;
+  return &__ValueType_values[i];
+}
+
+union ValueUnion {
+  bool as_bool;
+  i64 as_num;
+  Buffer as_str;
+  Vector *as_list;
+  Map *as_dict;
+};
+
+struct Value {
+  ValueType type;
+  ValueUnion u;
+  Span span;
+};
+
+struct BencodeParser {
+  char *input;
+  Location loc;
+};
+
+struct Bencode {
+};
+
+struct SHA1 {
+};
+
+struct BufferIO {
+  Buffer *data;
+  i32 index;
+};
+
+struct Socket {
+  i32 fd;
+};
+
+enum SocketMode {
+  SocketMode__UDP,
+  SocketMode__TCP,
+};
+
+static char *__SocketMode_names[] = {"UDP", "TCP"};
+static SocketMode __SocketMode_values[] = {SocketMode__UDP, SocketMode__TCP};
+
+static char *SocketMode__dbg(SocketMode this) {
+  if ((u32)this < 2u) return __SocketMode_names[this];
+  return "<unknown>";
+}
+
+static i32 __SocketMode_displace[] = {-2, -1};
+static i32 __SocketMode_slots[] = {0, 1};
+
+static SocketMode *SocketMode__from_str(char *s) {
+  i32 d = __SocketMode_displace[aecor_hash_str(s, 0) & 1u];
+  i32 i = __SocketMode_slots[d < 0 ? -d - 1 : aecor_hash_str(s, d) & 1u];
+  if (i < 0 || strcmp(s, __SocketMode_names[i])) return NULL;
+  return &__SocketMode_values[i];
+}
+
+struct TrackerState {
+  i32 transaction_id;
+  i64 connection_id;
+  char *chosen_peer;
+  i32 chosen_port;
+};
+
+/* function declarations */
+static FILE *File__open(char *path, char *mode);
+static bool File__exists(char *path);
+static i32 File__size(FILE *this);
+static char *File__slurp(FILE *this);
+static i32 File__read(FILE *this, void *buf, i32 size);
+static i32 File__write(FILE *this, void *buf, i32 size);
+static void File__puts(FILE *this, char *str);
+static __attribute__((noreturn)) __attribute__((cold)) void panic(char *msg);
+static bool string__starts_with(char *this, char *prefix);
+static bool string__ends_with(char *this, char *suffix);
+static void string__remove_last_n(char *this, i32 n);
+static bool string__eq(char *this, char *str2);
+static char *string__substring(char *this, i32 start, i32 len);
+static void string__strip_trailing_whitespace(char *this);
+static i32 min(i32 a, i32 b);
+static i32 max(i32 a, i32 b);
+static Vector *Vector__new_sized(i32 capacity);
+static Vector *Vector__new(void);
+static void Vector__resize(Vector *this, i32 new_capacity);
+static inline __attribute__((always_inline)) void Vector__push(Vector *this, void *val);
+static void Vector__push_front(Vector *this, void *val);
+static void *Vector__pop(Vector *this);
+static inline __attribute__((always_inline)) void *Vector__back(Vector *this);
+static inline __attribute__((always_inline)) void *Vector__at(Vector *this, i32 i);
+static inline __attribute__((always_inline)) bool Vector__empty(Vector *this);
+static void Vector__free(Vector *this);
+static MapNode *MapNode__new(char *key, void *value, MapNode *next);
+static void MapNode__free_list(MapNode *node);
+static Map *Map__new(void);
+static i32 Map__hash(Map *this, char *s);
+static MapNode *Map__get_node(Map *this, char *key);
+static void *Map__get(Map *this, char *key);
+static bool Map__exists(Map *this, char *key);
+static void Map__insert(Map *this, char *key, void *value);
+static void Map__resize(Map *this);
+static void Map__print_keys(Map *this);
+static void Map__push_keys(Map *this, Vector *vec);
+static void Map__free(Map *this);
+static MapIterator Map__iter(Map *this);
+static char *MapIterator__key(MapIterator *this);
+static void *MapIterator__value(MapIterator *this);
+static MapIterator MapIterator__make(Map *map);
+static void MapIterator__next(MapIterator *this);
+static char *Location__str(Location this);
+static bool Location__is_before(Location *this, Location other);
+static char *Span__str(Span this);
+static Span Span__default(void);
+static Span Span__join(Span this, Span other);
+static bool Span__contains_loc(Span this, Location loc);
+static Token *Token__new(TokenType type, Span span, char *text);
+static Token *Token__from_type(TokenType type, Span span);
+static Token *Token__from_ident(char *text, Span span);
+static char *Token__str(Token *this);
+static TokenType TokenType__from_text(char *text);
+static char *TokenType__str(TokenType this);
+static f32 minf(f32 a, f32 b);
+static f32 maxf(f32 a, f32 b);
+static f32 clampf(f32 x, f32 min, f32 max);
+static f32 clamp01(f32 x);
+static f32 degrees(f32 radians);
+static f32 radians(f32 degrees);
+static i32 edit_distance(char *str1, char *str2);
+static char *find_word_suggestion(char *s, Vector *options);
+static u32 hash_string(char *s, u32 seed);
+static char *ErrorType__str(ErrorType this);
+static char *MessageType__to_color(MessageType this);
+static char *MessageType__str(MessageType this);
+static void display_line(void);
+static void display_message(MessageType type, Span span, char *msg);
+static void display_message_span(MessageType type, Span span, char *msg);
+static void Error__display(Error *this);
+static __attribute__((noreturn)) void Error__panic(Error *this);
+static Error *Error__new(Span span, char *msg);
+static Error *Error__new_note(Span span, char *msg, char *note);
+static Error *Error__new_hint(Span span, char *msg, Span span2, char *hint);
+static void display_error_messages(Vector *errors, i32 detail_level);
+static bool is_hex_digit(char c);
+static Lexer Lexer__make(char *source, char *filename);
+static void Lexer__push(Lexer *this, Token *token);
+static void Lexer__push_type(Lexer *this, TokenType type, i32 len);
+static inline __attribute__((always_inline)) char Lexer__cur(Lexer *this);
+static void Lexer__inc(Lexer *this);
+static char Lexer__peek(Lexer *this, i32 offset);
+static void Lexer__lex_char_literal(Lexer *this);
+static void Lexer__lex_string_literal(Lexer *this);
+static Token *Lexer__lex_int_literal_different_base(Lexer *this);
+static Token *Lexer__lex_numeric_literal_helper(Lexer *this);
+static void Lexer__lex_numeric_literal(Lexer *this);
+static Vector *Lexer__lex(Lexer *this);
+static Buffer Buffer__make(void);
+static Buffer Buffer__from_string(char *s);
+static Buffer Buffer__from_sized_string(char *s, i32 size);
+static void Buffer__resize_if_necessary(Buffer *this, i32 new_size);
+static void Buffer__hex_dump(Buffer *this);
+static void Buffer__putb(Buffer *this, Buffer *buf);
+static void Buffer__putbf(Buffer *this, Buffer *buf);
+static void Buffer__puts(Buffer *this, char *s);
+static inline __attribute__((always_inline)) void Buffer__putc(Buffer *this, char c);
+static void Buffer__put_u64(Buffer *this, u64 value);
+static void Buffer__put_i64(Buffer *this, i64 value);
+static void Buffer__put_f64(Buffer *this, f64 value);
+static void Buffer__put_ptr(Buffer *this, void *value);
+static void Buffer__putsf(Buffer *this, char *s);
+static char *Buffer__str(Buffer *this);
+static char *Buffer__new_str(Buffer *this);
+static void Buffer__free(Buffer *this);
+static JSONParser JSONParser__make(Vector *tokens);
+static Token *JSONParser__token(JSONParser *this);
+static Token *JSONParser__consume(JSONParser *this, TokenType type);
+static Value *JSONParser__parse_object(JSONParser *this);
+static Value *JSONParser__parse_array(JSONParser *this);
+static Value *JSONParser__parse_value(JSONParser *this);
+static Value *JSONParser__parse(JSONParser *this);
+static Value *JSON__parse(char *source, char *filename);
+static Value *JSON__parse_from_string(char *json_str);
+static Value *JSON__parse_from_file(char *filename);
+static void JSON__serialize_into(Value *val, Buffer *sb);
+static Buffer JSON__serialize(Value *val);
+static char *ValueType__str(ValueType this);
+static Value *Value__new(ValueType type);
+static Value *Value__new_str(Buffer str);
+static Value *Value__new_bool(bool bul);
+static Value *Value__new_number(i64 num);
+static Value *Value__new_array(Vector *vec);
+static Value *Value__new_dictect(Map *map);
+static void Value__ensure(Value *this, ValueType type);
+static bool Value__is(Value this, ValueType type);
+static Value *Value__at(Value *this, u64 idx);
+static void Value__set(Value *this, i64 idx, Value *value);
+static void Value__push(Value *this, Value *value);
+static Value *Value__get(Value *this, char *key);
+static void Value__insert(Value *this, char *key, Value *value);
+static bool Value__as_bool(Value *this);
+static i64 Value__as_num(Value *this);
+static Buffer Value__as_str(Value *this);
+static Vector *Value__as_arr(Value *this);
+static Map *Value__as_dict(Value *this);
+static char *Value__dbg(Value *this);
+static void Value__free(Value *this);
+static BencodeParser BencodeParser__new(char *input);
+static char BencodeParser__cur(BencodeParser *this);
+static Value *BencodeParser__parse(BencodeParser *this);
+static void BencodeParser__inc(BencodeParser *this);
+static i64 BencodeParser__parse_int_internal(BencodeParser *this);
+static Value *BencodeParser__parse_list(BencodeParser *this);
+static Value *BencodeParser__parse_dict(BencodeParser *this);
+static Buffer BencodeParser__parse_string_internal(BencodeParser *this);
+static Value *BencodeParser__parse_string(BencodeParser *this);
+static Value *BencodeParser__parse_int(BencodeParser *this);
+static Value *Bencode__parse(char *s);
+static void Bencode__serialize_into(Value *val, Buffer *sb);
+static Buffer Bencode__serialize(Value *val);
+static u32 SHA1__rotate_left(u32 value, u32 bits);
+static Buffer SHA1__hash(Buffer *input);
+static Buffer SHA1__hash_string(char *data);
+static BufferIO BufferIO__make(Buffer *data);
+static i64 BufferIO__read_i64_be(BufferIO *this);
+static u64 BufferIO__read_u64_be(BufferIO *this);
+static i32 BufferIO__read_i32_be(BufferIO *this);
+static u32 BufferIO__read_u32_be(BufferIO *this);
+static void BufferIO__read_bytes(BufferIO *this, void *_dst, i32 count);
+static i16 BufferIO__read_i16_be(BufferIO *this);
+static u16 BufferIO__read_u16_be(BufferIO *this);
+static void BufferIO__write_i64_be(BufferIO *this, i64 value);
+static void BufferIO__write_u64_be(BufferIO *this, u64 value);
+static void BufferIO__write_i32_be(BufferIO *this, i32 value);
+static void BufferIO__write_u32_be(BufferIO *this, u32 value);
+static void BufferIO__write_i16_be(BufferIO *this, i16 value);
+static void BufferIO__write_u16_be(BufferIO *this, u16 value);
+static void BufferIO__write_i8(BufferIO *this, i8 value);
+static void BufferIO__write_u8(BufferIO *this, u8 value);
+static void BufferIO__write_bytes(BufferIO *this, void *_src, i32 count);
+static Socket Socket__connect(char *host, i32 port, SocketMode mode);
+static i32 Socket__read(Socket *this, Buffer *buf, i32 max_size);
+static i32 Socket__read_exactly(Socket *this, Buffer *buf, i32 size);
+static i32 Socket__write(Socket *this, Buffer *buf);
+static Buffer get_info_hash(char *data, Value *info);
+static void read_peer_message(Socket *peer);
+static void send_peer_message(char *dbg, Socket *peer, Buffer *payload);
+i32 main(i32 argc, char **argv);
+
+/* global variables */
+
+static FILE *File__open(char *path, char *mode) {
+  FILE *file = fopen(path, mode);
+  if ((!((bool)file))) {
+    printf("Error opening file '%s': %s""\n", path, strerror(errno));
+    exit(1);
+  } 
+  return file;
+}
+
+static bool File__exists(char *path) {
+  FILE *file = fopen(path, "r");
+  if ((!((bool)file))) {
+    return false;
+  } 
+  fclose(file);
+  return true;
+}
+
+static i32 File__size(FILE *this) {
+  i32 pos = ftell(this);
+  fseek(this, 0, SEEK_END);
+  i32 size = ftell(this);
+  fseek(this, pos, SEEK_SET);
+  return size;
+}
+
+static char *File__slurp(FILE *this) {
+  i32 pos = ftell(this);
+  fseek(this, 0, SEEK_END);
+  i32 size = ftell(this);
+  fseek(this, pos, SEEK_SET);
+  void *buf = calloc((size + 1), sizeof(char));
+  fread(buf, 1, size, this);
+  fseek(this, pos, SEEK_SET);
+  return ((char *)buf);
+}
+
+static i32 File__read(FILE *this, void *buf, i32 size) {
+  return fread(buf, 1, size, this);
+}
+
+static i32 File__write(FILE *this, void *buf, i32 size) {
+  return fwrite(buf, 1, size, this);
+}
+
+static void File__puts(FILE *this, char *str) {
+  fwrite(str, 1, strlen(str), this);
+}
+
+static __attribute__((noreturn)) __attribute__((cold)) void panic(char *msg) {
+  printf("%s""\n", msg);
+  aecor_stdout_flush();
+  exit(1);
+}
+
+static bool string__starts_with(char *this, char *prefix) {
+  i32 prefix_len = strlen(prefix);
+  if ((strlen(this) < prefix_len)) {
+    return false;
+  } 
+  return strncmp(this, prefix, prefix_len) == 0;
+}
+
+static bool string__ends_with(char *this, char *suffix) {
+  i32 suffix_len = strlen(suffix);
+  if ((strlen(this) < suffix_len)) {
+    return false;
+  } 
+  return strncmp(this, suffix, suffix_len) == 0;
+}
+
+static void string__remove_last_n(char *this, i32 n) {
+  this[(strlen(this) - n)] = '\0';
+}
+
+static bool string__eq(char *this, char *str2) {
+  return strcmp(this, str2) == 0;
+}
+
+static char *string__substring(char *this, i32 start, i32 len) {
+  char *new_str = ((char *)calloc((len + 1), sizeof(char)));
+  memcpy(new_str, (this + start), len);
+  return new_str;
+}
+
+static void string__strip_trailing_whitespace(char *this) {
+  for (i32 i = (strlen(this) - 1); (i >= 0); i -= 1) {
+    if ((this[i] != ' ')) 
+    break;
+    
+    this[i] = '\0';
+  } 
+}
+
+static i32 min(i32 a, i32 b) {
+  return ((a < b) ? a : b);
+}
+
+static i32 max(i32 a, i32 b) {
+  return ((a > b) ? a : b);
+}
+
+static Vector *Vector__new_sized(i32 capacity) {
+  Vector *vec = ((Vector *)calloc(1, sizeof(Vector)));
+  vec->size = 0;
+  vec->capacity = capacity;
+  vec->data = ((void **)calloc(vec->capacity, sizeof(void *)));
+  return vec;
+}
+
+static Vector *Vector__new(void) {
+  return Vector__new_sized(16);
+}
+
+static void Vector__resize(Vector *this, i32 new_capacity) {
+  this->capacity = new_capacity;
+  this->data = ((void **)realloc(this->data, (this->capacity * sizeof(void *))));
+}
+
+static inline __attribute__((always_inline)) void Vector__push(Vector *this, void *val) {
+  if (this->size == this->capacity) {
+    Vector__resize(this, (this->capacity * 2));
+  } 
+  this->data[this->size] = val;
+  this->size += 1;
+}
+
+static void Vector__push_front(Vector *this, void *val) {
+  if (this->size == this->capacity) {
+    Vector__resize(this, (this->capacity * 2));
+  } 
+  for (i32 i = this->size; (i > 0); i -= 1) {
+    this->data[i] = this->data[(i - 1)];
+  } 
+  this->data[0] = val;
+  this->size += 1;
+}
+
+static void *Vector__pop(Vector *this) {
+  (__builtin_expect(!!((this->size > 0)), 1) ? (void)0 : panic("pop on empty vector"));
+  this->size -= 1;
+  return this->data[this->size];
+}
+
+static inline __attribute__((always_inline)) void *Vector__back(Vector *this) {
+  (__builtin_expect(!!((this->size > 0)), 1) ? (void)0 : panic("back on empty vector"));
+  return this->data[(this->size - 1)];
+}
+
+static inline __attribute__((always_inline)) void *Vector__at(Vector *this, i32 i) {
+  (__builtin_expect(!!(((i >= 0) && (i < this->size))), 1) ? (void)0 : panic("at out of bounds in vector"));
+  return this->data[i];
+}
+
+static inline __attribute__((always_inline)) bool Vector__empty(Vector *this) {
+  return this->size == 0;
+}
+
+static void Vector__free(Vector *this) {
+  free(this->data);
+  free(this);
+}
+
+static MapNode *MapNode__new(char *key, void *value, MapNode *next) {
+  MapNode *node = ((MapNode *)calloc(1, sizeof(MapNode)));
+  node->key = key;
+  node->value = value;
+  node->next = next;
+  return node;
+}
+
+static void MapNode__free_list(MapNode *node) {
+  MapNode *cur = node;
+  while (((bool)cur)) {
+    MapNode *next = cur->next;
+    free(cur);
+    cur = next;
+  } 
+}
+
+static Map *Map__new(void) {
+  Map *map = ((Map *)calloc(1, sizeof(Map)));
+  map->num_buckets = 4;
+  map->buckets = ((MapNode **)calloc(map->num_buckets, sizeof(MapNode *)));
+  return map;
+}
+
+static i32 Map__hash(Map *this, char *s) {
+  i32 hash = 5381;
+  i32 len = strlen(s);
+  for (i32 i = 0; (i < len); i += 1) {
+    hash = ((hash * 33) ^ ((i32)s[i]));
+  } 
+  hash = (hash % this->num_buckets);
+  if ((hash < 0)) {
+    hash += this->num_buckets;
+  } 
+  return hash;
+}
+
+static MapNode *Map__get_node(Map *this, char *key) {
+  i32 hash = Map__hash(this, key);
+  MapNode *node = this->buckets[hash];
+  while (((bool)node)) {
+    if (string__eq(node->key, key)) {
+      return node;
+    } 
+    node = node->next;
+  } 
+  return NULL;
+}
+
+static void *Map__get(Map *this, char *key) {
+  MapNode *node = Map__get_node(this, key);
+  if (((bool)node)) {
+    return node->value;
+  } 
+  return NULL;
+}
+
+static bool Map__exists(Map *this, char *key) {
+  return ((bool)Map__get_node(this, key));
+}
+
+static void Map__insert(Map *this, char *key, void *value) {
+  MapNode *node = Map__get_node(this, key);
+  if (((bool)node)) {
+    node->value = value;
+  }  else {
+    i32 hash = Map__hash(this, key);
+    MapNode *new_node = MapNode__new(key, value, this->buckets[hash]);
+    if (((bool)this->buckets[hash])) {
+      this->num_collisions += 1;
+    } 
+    this->buckets[hash] = new_node;
+    this->num_items += 1;
+    if ((this->num_items > this->num_buckets)) {
+      Map__resize(this);
+    } 
+  } 
+}
+
+static void Map__resize(Map *this) {
+  MapNode **old_buckets = this->buckets;
+  i32 old_num_buckets = this->num_buckets;
+  i32 old_num_items = this->num_items;
+  this->num_collisions = 0;
+  this->num_buckets *= 2;
+  this->buckets = ((MapNode **)calloc(this->num_buckets, sizeof(MapNode *)));
+  for (i32 i = 0; (i < old_num_buckets); i += 1) {
+    MapNode *node = old_buckets[i];
+    while (((bool)node)) {
+      i32 new_hash = Map__hash(this, node->key);
+      MapNode *new_node = MapNode__new(node->key, node->value, this->buckets[new_hash]);
+      if (((bool)this->buckets[new_hash])) {
+        this->num_collisions += 1;
+      } 
+      this->buckets[new_hash] = new_node;
+      node = node->next;
+    } 
+  } 
+  for (i32 i = 0; (i < old_num_buckets); i += 1) {
+    MapNode__free_list(old_buckets[i]);
+  } 
+  free(old_buckets);
+}
+
+static void Map__print_keys(Map *this) {
+  for (i32 i = 0; (i < this->num_buckets); i += 1) {
+    MapNode *node = this->buckets[i];
+    while (((bool)node)) {
+      printf("- '%s'\n""\n", node->key);
+      node = node->next;
+    } 
+  } 
+}
+
+static void Map__push_keys(Map *this, Vector *vec) {
+  for (i32 i = 0; (i < this->num_buckets); i += 1) {
+    MapNode *node = this->buckets[i];
+    while (((bool)node)) {
+      Vector__push(vec, node->key);
+      node = node->next;
+    } 
+  } 
+}
+
+static void Map__free(Map *this) {
+  for (i32 i = 0; (i < this->num_buckets); i += 1) {
+    MapNode__free_list(this->buckets[i]);
+  } 
+  free(this->buckets);
+}
+
+static MapIterator Map__iter(Map *this) {
+  return MapIterator__make(this);
+}
+
+static char *MapIterator__key(MapIterator *this) {
+  return this->cur->key;
+}
+
+static void *MapIterator__value(MapIterator *this) {
+  return this->cur->value;
+}
+
+static MapIterator MapIterator__make(Map *map) {
+  MapIterator it = (MapIterator){.idx = (-1), .cur = NULL, map};
+  MapIterator__next((&it));
+  return it;
+}
+
+static void MapIterator__next(MapIterator *this) {
+  while ((this->idx < this->map->num_buckets)) {
+    while (((bool)this->cur)) {
+      this->cur = this->cur->next;
+      if (((bool)this->cur)) 
+      return;
+      
+    } 
+    this->idx += 1;
+    this->cur = ({ MapNode *__yield_0;
+  if ((this->idx < this->map->num_buckets)) {
+    __yield_0 = this->map->buckets[this->idx];
+  }  else {
+    __yield_0 = NULL;
+  } 
+;__yield_0; });
+    if (((bool)this->cur)) 
+    return;
+    
+  } 
+}
+
+static char *Location__str(Location this) {
+  return format_string("%s:%d:%d", this.filename, this.line, this.col);
+}
+
+static bool Location__is_before(Location *this, Location other) {
+  if ((this->line > other.line)) 
+  return false;
+  
+  if ((this->line < other.line)) 
+  return true;
+  
+  return (this->col <= other.col);
+}
+
+static char *Span__str(Span this) {
+  return format_string("%s => %s", Location__str(this.start), Location__str(this.end));
+}
+
+static Span Span__default(void) {
+  Span span = {0};
+  span.start = (Location){.filename = "<default>", .line = 0, .col = 0, .index = 0};
+  span.end = (Location){.filename = "<default>", .line = 0, .col = 0, .index = 0};
+  return span;
+}
+
+static Span Span__join(Span this, Span other) {
+  Span span = {0};
+  span.start = this.start;
+  span.end = other.end;
+  return span;
+}
+
+static bool Span__contains_loc(Span this, Location loc) {
+  if ((!string__eq(this.start.filename, loc.filename))) 
+  return false;
+  
+  return (Location__is_before((&this.start), loc) && Location__is_before((&loc), this.end));
+}
+
+static Token *Token__new(TokenType type, Span span, char *text) {
+  Token *tok = ((Token *)calloc(1, sizeof(Token)));
+  (*tok) = (Token){type, span, text, .suffix = NULL, .seen_newline = false};
+  return tok;
+}
+
+static Token *Token__from_type(TokenType type, Span span) {
+  return Token__new(type, span, "");
+}
+
+static Token *Token__from_ident(char *text, Span span) {
+  TokenType type = TokenType__from_text(text);
+  return Token__new(type, span, text);
+}
+
+static char *Token__str(Token *this) {
+  return format_string("%s: %s", Span__str(this->span), TokenType__str(this->type));
+}
+
+static TokenType TokenType__from_text(char *text) {
+  return ({ TokenType __yield_0;
+  {
+    char *__match_str = text;
+    switch (aecor_hash_str(__match_str, 2166136261u)) {
+      case 1305964296u:
+        if (!strcmp(__match_str, "and")) goto __match_0_0;
+        break;
+      case 106731536u:
+        if (!strcmp(__match_str, "as")) goto __match_0_1;
+        break;
+      case 2869110635u:
+        if (!strcmp(__match_str, "bool")) goto __match_0_2;
+        break;
+      case 1349183411u:
+        if (!strcmp(__match_str, "break")) goto __match_0_3;
+        break;
+      case 3477080843u:
+        if (!strcmp(__match_str, "char")) goto __match_0_4;
+        break;
+      case 2245205078u:
+        if (!strcmp(__match_str, "const")) goto __match_0_5;
+        break;
+      case 3663126513u:
+        if (!strcmp(__match_str, "continue")) goto __match_0_6;
+        break;
+      case 832636142u:
+        if (!strcmp(__match_str, "def")) goto __match_0_7;
+        break;
+      case 2838665391u:
+        if (!strcmp(__match_str, "defer")) goto __match_0_8;
+        break;
+      case 642373404u:
+        if (!strcmp(__match_str, "else")) goto __match_0_9;
+        break;
+      case 1633607337u:
+        if (!strcmp(__match_str, "enum")) goto __match_0_10;
+        break;
+      case 594816953u:
+        if (!strcmp(__match_str, "extern")) goto __match_0_11;
+        break;
+      case 4275523303u:
+        if (!strcmp(__match_str, "false")) goto __match_0_12;
+        break;
+      case 859369167u:
+        if (!strcmp(__match_str, "f32")) goto __match_0_13;
+        break;
+      case 861975295u:
+        if (!strcmp(__match_str, "f64")) goto __match_0_14;
+        break;
+      case 3121374858u:
+        if (!strcmp(__match_str, "for")) goto __match_0_15;
+        break;
+      case 283012692u:
+        if (!strcmp(__match_str, "fn")) goto __match_0_16;
+        break;
+      case 1074601716u:
+        if (!strcmp(__match_str, "i8")) goto __match_0_17;
+        break;
+      case 833762287u:
+        if (!strcmp(__match_str, "i16")) goto __match_0_18;
+        break;
+      case 918736459u:
+        if (!strcmp(__match_str, "i32")) goto __match_0_19;
+        break;
+      case 3966529125u:
+        if (!strcmp(__match_str, "i64")) goto __match_0_20;
+        break;
+      case 2551052472u:
+        if (!strcmp(__match_str, "if")) goto __match_0_21;
+        break;
+      case 950579197u:
+        if (!strcmp(__match_str, "let")) goto __match_0_22;
+        break;
+      case 2717393236u:
+        if (!strcmp(__match_str, "match")) goto __match_0_23;
+        break;
+      case 1957039169u:
+        if (!strcmp(__match_str, "not")) goto __match_0_24;
+        break;
+      case 2827039351u:
+        if (!strcmp(__match_str, "null")) goto __match_0_25;
+        break;
+      case 2654982702u:
+        if (!strcmp(__match_str, "or")) goto __match_0_26;
+        break;
+      case 4108485794u:
+        if (!strcmp(__match_str, "return")) goto __match_0_27;
+        break;
+      case 3474485403u:
+        if (!strcmp(__match_str, "scratch")) goto __match_0_28;
+        break;
+      case 2850059673u:
+        if (!strcmp(__match_str, "sizeof")) goto __match_0_29;
+        break;
+      case 930201698u:
+        if (!strcmp(__match_str, "string")) goto __match_0_30;
+        break;
+      case 289050604u:
+        if (!strcmp(__match_str, "struct")) goto __match_0_31;
+        break;
+      case 1715307617u:
+        if (!strcmp(__match_str, "true")) goto __match_0_32;
+        break;
+      case 3201516176u:
+        if (!strcmp(__match_str, "then")) goto __match_0_33;
+        break;
+      case 3926084466u:
+        if (!strcmp(__match_str, "u8")) goto __match_0_34;
+        break;
+      case 4148185419u:
+        if (!strcmp(__match_str, "u16")) goto __match_0_35;
+        break;
+      case 1849896378u:
+        if (!strcmp(__match_str, "u32")) goto __match_0_36;
+        break;
+      case 2500781617u:
+        if (!strcmp(__match_str, "u64")) goto __match_0_37;
+        break;
+      case 4025494924u:
+        if (!strcmp(__match_str, "untyped_ptr")) goto __match_0_38;
+        break;
+      case 3495413904u:
+        if (!strcmp(__match_str, "union")) goto __match_0_39;
+        break;
+      case 621625292u:
+        if (!strcmp(__match_str, "use")) goto __match_0_40;
+        break;
+      case 2454924575u:
+        if (!strcmp(__match_str, "void")) goto __match_0_41;
+        break;
+      case 317341496u:
+        if (!strcmp(__match_str, "yield")) goto __match_0_42;
+        break;
+      case 4040919573u:
+        if (!strcmp(__match_str, "while")) goto __match_0_43;
+        break;
+    }
+    goto __match_0_default;
+    __match_0_0: {
+      __yield_0 = TokenType__And;
+} goto __match_0_end;
+    __match_0_1: {
+      __yield_0 = TokenType__As;
+} goto __match_0_end;
+    __match_0_2: {
+      __yield_0 = TokenType__Bool;
+} goto __match_0_end;
+    __match_0_3: {
+      __yield_0 = TokenType__Break;
+} goto __match_0_end;
+    __match_0_4: {
+      __yield_0 = TokenType__Char;
+} goto __match_0_end;
+    __match_0_5: {
+      __yield_0 = TokenType__Const;
+} goto __match_0_end;
+    __match_0_6: {
+      __yield_0 = TokenType__Continue;
+} goto __match_0_end;
+    __match_0_7: {
+      __yield_0 = TokenType__Def;
+} goto __match_0_end;
+    __match_0_8: {
+      __yield_0 = TokenType__Defer;
+} goto __match_0_end;
+    __match_0_9: {
+      __yield_0 = TokenType__Else;
+} goto __match_0_end;
+    __match_0_10: {
+      __yield_0 = TokenType__Enum;
+} goto __match_0_end;
+    __match_0_11: {
+      __yield_0 = TokenType__Extern;
+} goto __match_0_end;
+    __match_0_12: {
+      __yield_0 = TokenType__False;
+} goto __match_0_end;
+    __match_0_13: {
+      __yield_0 = TokenType__F32;
+} goto __match_0_end;
+    __match_0_14: {
+      __yield_0 = TokenType__F64;
+} goto __match_0_end;
+    __match_0_15: {
+      __yield_0 = TokenType__For;
+} goto __match_0_end;
+    __match_0_16: {
+      __yield_0 = TokenType__Fn;
+} goto __match_0_end;
+    __match_0_17: {
+      __yield_0 = TokenType__I8;
+} goto __match_0_end;
+    __match_0_18: {
+      __yield_0 = TokenType__I16;
+} goto __match_0_end;
+    __match_0_19: {
+      __yield_0 = TokenType__I32;
+} goto __match_0_end;
+    __match_0_20: {
+      __yield_0 = TokenType__I64;
+} goto __match_0_end;
+    __match_0_21: {
+      __yield_0 = TokenType__If;
+} goto __match_0_end;
+    __match_0_22: {
+      __yield_0 = TokenType__Let;
+} goto __match_0_end;
+    __match_0_23: {
+      __yield_0 = TokenType__Match;
+} goto __match_0_end;
+    __match_0_24: {
+      __yield_0 = TokenType__Not;
+} goto __match_0_end;
+    __match_0_25: {
+      __yield_0 = TokenType__Null;
+} goto __match_0_end;
+    __match_0_26: {
+      __yield_0 = TokenType__Or;
+} goto __match_0_end;
+    __match_0_27: {
+      __yield_0 = TokenType__Return;
+} goto __match_0_end;
+    __match_0_28: {
+      __yield_0 = TokenType__Scratch;
+} goto __match_0_end;
+    __match_0_29: {
+      __yield_0 = TokenType__SizeOf;
+} goto __match_0_end;
+    __match_0_30: {
+      __yield_0 = TokenType__String;
+} goto __match_0_end;
+    __match_0_31: {
+      __yield_0 = TokenType__Struct;
+} goto __match_0_end;
+    __match_0_32: {
+      __yield_0 = TokenType__True;
+} goto __match_0_end;
+    __match_0_33: {
+      __yield_0 = TokenType__Then;
+} goto __match_0_end;
+    __match_0_34: {
+      __yield_0 = TokenType__U8;
+} goto __match_0_end;
+    __match_0_35: {
+      __yield_0 = TokenType__U16;
+} goto __match_0_end;
+    __match_0_36: {
+      __yield_0 = TokenType__U32;
+} goto __match_0_end;
+    __match_0_37: {
+      __yield_0 = TokenType__U64;
+} goto __match_0_end;
+    __match_0_38: {
+      __yield_0 = TokenType__UntypedPtr;
+} goto __match_0_end;
+    __match_0_39: {
+      __yield_0 = TokenType__Union;
+} goto __match_0_end;
+    __match_0_40: {
+      __yield_0 = TokenType__Use;
+} goto __match_0_end;
+    __match_0_41: {
+      __yield_0 = TokenType__Void;
+} goto __match_0_end;
+    __match_0_42: {
+      __yield_0 = TokenType__Yield;
+} goto __match_0_end;
+    __match_0_43: {
+      __yield_0 = TokenType__While;
+} goto __match_0_end;
+    __match_0_default: {
+      __yield_0 = TokenType__Identifier;
+}
+    __match_0_end:;
+  }
+;__yield_0; });
+}
+
+static char *TokenType__str(TokenType this) {
+  return ({ char *__yield_0;
+  switch (this) {
+    case TokenType__And: {
+      __yield_0 = "and";
+} break;
+    case TokenType__As: {
+      __yield_0 = "as";
+} break;
+    case TokenType__Bool: {
+      __yield_0 = "bool";
+} break;
+    case TokenType__Break: {
+      __yield_0 = "break";
+} break;
+    case TokenType__Char: {
+      __yield_0 = "char";
+} break;
+    case TokenType__Const: {
+      __yield_0 = "const";
+} break;
+    case TokenType__Continue: {
+      __yield_0 = "continue";
+} break;
+    case TokenType__Def: {
+      __yield_0 = "def";
+} break;
+    case TokenType__Defer: {
+      __yield_0 = "defer";
+} break;
+    case TokenType__Else: {
+      __yield_0 = "else";
+} break;
+    case TokenType__Enum: {
+      __yield_0 = "enum";
+} break;
+    case TokenType__Extern: {
+      __yield_0 = "extern";
+} break;
+    case TokenType__False: {
+      __yield_0 = "false";
+} break;
+    case TokenType__F32: {
+      __yield_0 = "f32";
+} break;
+    case TokenType__F64: {
+      __yield_0 = "f64";
+} break;
+    case TokenType__For: {
+      __yield_0 = "for";
+} break;
+    case TokenType__Fn: {
+      __yield_0 = "fn";
+} break;
+    case TokenType__I8: {
+      __yield_0 = "i8";
+} break;
+    case TokenType__I16: {
+      __yield_0 = "i16";
+} break;
+    case TokenType__I32: {
+      __yield_0 = "i32";
+} break;
+    case TokenType__I64: {
+      __yield_0 = "i64";
+} break;
+    case TokenType__If: {
+      __yield_0 = "if";
+} break;
+    case TokenType__Let: {
+      __yield_0 = "let";
+} break;
+    case TokenType__Match: {
+      __yield_0 = "match";
+} break;
+    case TokenType__Not: {
+      __yield_0 = "not";
+} break;
+    case TokenType__Null: {
+      __yield_0 = "null";
+} break;
+    case TokenType__Or: {
+      __yield_0 = "or";
+} break;
+    case TokenType__Return: {
+      __yield_0 = "return";
+} break;
+    case TokenType__Scratch: {
+      __yield_0 = "scratch";
+} break;
+    case TokenType__SizeOf: {
+      __yield_0 = "sizeof";
+} break;
+    case TokenType__String: {
+      __yield_0 = "string";
+} break;
+    case TokenType__Struct: {
+      __yield_0 = "struct";
+} break;
+    case TokenType__True: {
+      __yield_0 = "true";
+} break;
+    case TokenType__Then: {
+      __yield_0 = "then";
+} break;
+    case TokenType__U8: {
+      __yield_0 = "u8";
+} break;
+    case TokenType__U16: {
+      __yield_0 = "u16";
+} break;
+    case TokenType__U32: {
+      __yield_0 = "u32";
+} break;
+    case TokenType__U64: {
+      __yield_0 = "u64";
+} break;
+    case TokenType__UntypedPtr: {
+      __yield_0 = "untyped_ptr";
+} break;
+    case TokenType__Union: {
+      __yield_0 = "union";
+} break;
+    case TokenType__Use: {
+      __yield_0 = "use";
+} break;
+    case TokenType__Void: {
+      __yield_0 = "void";
+} break;
+    case TokenType__Yield: {
+      __yield_0 = "yield";
+} break;
+    case TokenType__While: {
+      __yield_0 = "while";
+} break;
+    default: {
+      __yield_0 = TokenType__dbg(this);
+} break;
+  }
+;__yield_0; });
+}
+
+static f32 minf(f32 a, f32 b) {
+  if ((a < b)) 
+  return a;
+   else 
+  return b;
+  
+}
+
+static f32 maxf(f32 a, f32 b) {
+  if ((a > b)) 
+  return a;
+   else 
+  return b;
+  
+}
+
+static f32 clampf(f32 x, f32 min, f32 max) {
+  return maxf(minf(x, max), min);
+}
+
+static f32 clamp01(f32 x) {
+  return clampf(x, 0.0, 1.0);
+}
+
+static f32 degrees(f32 radians) {
+  return ((radians * 180.0) / M_PI);
+}
+
+static f32 radians(f32 degrees) {
+  return ((degrees * M_PI) / 180.0);
+}
+
+static i32 edit_distance(char *str1, char *str2) {
+  i32 n = strlen(str1);
+  i32 m = strlen(str2);
+  i32 stride = (m + 1);
+  i32 d[(n + 1)][(m + 1)];
+  for (i32 i = 0; (i <= n); i += 1) {
+    d[i][0] = i;
+  } 
+  for (i32 j = 0; (j <= m); j += 1) {
+    d[0][j] = j;
+  } 
+  for (i32 i = 1; (i <= n); i += 1) {
+    for (i32 j = 1; (j <= m); j += 1) {
+      i32 x = (d[(i - 1)][j] + 1);
+      i32 y = (d[i][(j - 1)] + 1);
+      i32 z;
+      if (str1[(i - 1)] == str2[(j - 1)]) {
+        z = d[(i - 1)][(j - 1)];
+      }  else {
+        z = (d[(i - 1)][(j - 1)] + 1);
+      } 
+      d[i][j] = min(x, min(y, z));
+    } 
+  } 
+  i32 result = d[n][m];
+  return result;
+}
+
+static char *find_word_suggestion(char *s, Vector *options) {
+  i32 threshold = 5;
+  if (options->size == 0) 
+  return NULL;
+  
+  char *closest = ((char *)Vector__at(options, 0));
+  i32 closest_distance = edit_distance(s, closest);
+  for (i32 i = 1; (i < options->size); i += 1) {
+    char *option = ((char *)Vector__at(options, i));
+    i32 distance = edit_distance(s, option);
+    if ((distance < closest_distance)) {
+      closest = option;
+      closest_distance = distance;
+    } 
+  } 
+  if ((closest_distance > threshold)) 
+  return NULL;
+  
+  return closest;
+}
+
+static u32 hash_string(char *s, u32 seed) {
+  u32 hash = seed;
+  i32 len = strlen(s);
+  for (i32 i = 0; (i < len); i += 1) {
+    hash = ((hash ^ ((u32)((u8)s[i]))) * 16777619);
+  } 
+  hash = ((hash ^ (hash >> 16)) * 0x85ebca6b);
+  hash = ((hash ^ (hash >> 13)) * 0xc2b2ae35);
+  return (hash ^ (hash >> 16));
+}
+
+static char *ErrorType__str(ErrorType this) {
+  return ({ char *__yield_0;
+  switch (this) {
+    case ErrorType__Standard: {
+      __yield_0 = "Standard";
+} break;
+    case ErrorType__WithNote: {
+      __yield_0 = "WithNote";
+} break;
+    case ErrorType__WithHint: {
+      __yield_0 = "WithHint";
+} break;
+  }
+;__yield_0; });
+}
+
+static char *MessageType__to_color(MessageType this) {
+  return ({ char *__yield_0;
+  switch (this) {
+    case MessageType__Error: {
+      __yield_0 = "\x1b[31m";
+} break;
+    case MessageType__Warning: {
+      __yield_0 = "\x1b[33m";
+} break;
+    case MessageType__Note: {
+      __yield_0 = "\x1b[32m";
+} break;
+  }
+;__yield_0; });
+}
+
+static char *MessageType__str(MessageType this) {
+  return ({ char *__yield_0;
+  switch (this) {
+    case MessageType__Error: {
+      __yield_0 = "Error";
+} break;
+    case MessageType__Warning: {
+      __yield_0 = "Warning";
+} break;
+    case MessageType__Note: {
+      __yield_0 = "Note";
+} break;
+  }
+;__yield_0; });
+}
+
+static void display_line(void) {
+  printf("--------------------------------------------------------------------------------""\n");
+}
+
+static void display_message(MessageType type, Span span, char *msg) {
+  display_line();
+  printf("%s: %s: %s""\n", Location__str(span.start), MessageType__str(type), msg);
+  display_line();
+}
+
+static void display_message_span(MessageType type, Span span, char *msg) {
+  char *color = MessageType__to_color(type);
+  char *reset = "\x1b[0m";
+  char *filename = span.start.filename;
+  FILE *file = File__open(filename, "r");
+  ;
+  char *contents = File__slurp(file);
+  ;
+  i32 around_offset = 1;
+  i32 min_line = max((span.start.line - around_offset), 1);
+  i32 max_line = (span.end.line + around_offset);
+  display_message(type, span, msg);
+  char *lines = contents;
+  char *cur = strsep((&lines), "\n");
+  i32 line_no = 1;
+  while ((((bool)cur) && (line_no <= max_line))) {
+    if (((line_no >= min_line) && (line_no <= max_line))) {
+      printf("%4d | ", line_no);
+      if (line_no == span.start.line) {
+        i32 start_col = (span.start.col - 1);
+        i32 end_col = (span.end.col - 1);
+        if ((span.end.line != span.start.line)) {
+          end_col = strlen(cur);
+        } 
+        for (i32 i = 0; (i < start_col); i += 1) {
+          printf("%c", cur[i]);
+        } 
+        printf("%s", color);
+        for (i32 i = start_col; (i < end_col); i += 1) {
+          printf("%c", cur[i]);
+        } 
+        printf("%s%s""\n", reset, (cur + end_col));
+        printf("%*s%s^ %s%s""\n", (start_col + 7), "", color, msg, reset);
+      }  else {
+        printf("%s""\n", cur);
+      } 
+    } 
+    line_no += 1;
+    cur = strsep((&lines), "\n");
+  } 
+
+  /* defers */
+  free(contents);
+  fclose(file);
+}
+
+static void Error__display(Error *this) {
+  switch (this->type) {
+    case ErrorType__Standard: {
+      display_message_span(MessageType__Error, this->span1, this->msg1);
+      display_line();
+    } break;
+    case ErrorType__WithNote: {
+      display_message_span(MessageType__Error, this->span1, this->msg1);
+      display_message(MessageType__Note, this->span1, this->msg2);
+    } break;
+    case ErrorType__WithHint: {
+      display_message_span(MessageType__Error, this->span1, this->msg1);
+      display_message_span(MessageType__Note, this->span2, this->msg2);
+      display_line();
+    } break;
+  }
+}
+
+static __attribute__((noreturn)) void Error__panic(Error *this) {
+  Error__display(this);
+  exit(1);
+}
+
+static Error *Error__new(Span span, char *msg) {
+  Error *err = ((Error *)calloc(1, sizeof(Error)));
+  err->type = ErrorType__Standard;
+  err->msg1 = msg;
+  err->span1 = span;
+  return err;
+}
+
+static Error *Error__new_note(Span span, char *msg, char *note) {
+  Error *err = ((Error *)calloc(1, sizeof(Error)));
+  err->type = ErrorType__WithNote;
+  err->msg1 = msg;
+  err->span1 = span;
+  err->msg2 = note;
+  return err;
+}
+
+static Error *Error__new_hint(Span span, char *msg, Span span2, char *hint) {
+  Error *err = ((Error *)calloc(1, sizeof(Error)));
+  err->type = ErrorType__WithHint;
+  err->msg1 = msg;
+  err->span1 = span;
+  err->msg2 = hint;
+  err->span2 = span2;
+  return err;
+}
+
+static void display_error_messages(Vector *errors, i32 detail_level) {
+  char *num_errors_env = getenv("AECOR_NUM_ERRORS");
+  i32 max_num_errors = (((bool)num_errors_env) ? atoi(num_errors_env) : 10);
+  i32 num_errors = min(errors->size, max_num_errors);
+  bool first = true;
+  for (i32 i = (num_errors - 1); (i >= 0); i -= 1) {
+    Error *err = ((Error *)Vector__at(errors, i));
+    switch (detail_level) {
+      case 0: {
+        printf("%s: %s""\n", Location__str(err->span1.start), err->msg1);
+      } break;
+      case 1: {
+        display_message_span(MessageType__Error, err->span1, err->msg1);
+      } break;
+      case 2: {
+        if (first) 
+        printf("""\n");
+        
+        first = false;
+        Error__display(err);
+      } break;
+      default: panic("invalid detail level"); break;
+    }
+  } 
+}
+
+static bool is_hex_digit(char c) {
+  if (isdigit(c)) 
+  return true;
+  
+  if ((('a' <= c) && (c <= 'f'))) 
+  return true;
+  
+  if ((('A' <= c) && (c <= 'F'))) 
+  return true;
+  
+  return false;
+}
+
+static Lexer Lexer__make(char *source, char *filename) {
+  return (Lexer){source, .source_len = strlen(source), .i = 0, .loc = (Location){filename, 1, 1, 0}, .seen_newline = false, .tokens = Vector__new(), .errors = Vector__new()};
+}
+
+static void Lexer__push(Lexer *this, Token *token) {
+  token->seen_newline = this->seen_newline;
+  Vector__push(this->tokens, token);
+  this->seen_newline = false;
+}
+
+static void Lexer__push_type(Lexer *this, TokenType type, i32 len) {
+  Location start_loc = this->loc;
+  for (i32 i = 0; (i < len); i += 1) {
+    Lexer__inc(this);
+  } 
+  Lexer__push(this, Token__from_type(type, (Span){start_loc, this->loc}));
+}
+
+static inline __attribute__((always_inline)) char Lexer__cur(Lexer *this) {
+  return this->source[this->i];
+}
+
+static void Lexer__inc(Lexer *this) {
+  switch (Lexer__cur(this)) {
+    case '\n': {
+      this->loc.line += 1;
+      this->loc.col = 1;
+      this->seen_newline = true;
+    } break;
+    default: {
+      this->loc.col += 1;
+    } break;
+  }
+  this->i += 1;
+  this->loc.index += 1;
+}
+
+static char Lexer__peek(Lexer *this, i32 offset) {
+  if (Lexer__cur(this) == '\0') {
+    return Lexer__cur(this);
+  } 
+  return this->source[(this->i + 1)];
+}
+
+static void Lexer__lex_char_literal(Lexer *this) {
+  Location start_loc = this->loc;
+  i32 start = (this->i + 1);
+  Lexer__inc(this);
+  if (Lexer__cur(this) == '\\') {
+    Lexer__inc(this);
+  } 
+  Lexer__inc(this);
+  if ((Lexer__cur(this) != '\'')) {
+    Vector__push(this->errors, Error__new((Span){this->loc, this->loc}, "Expected ' after character literal"));
+  } 
+  i32 len = (this->i - start);
+  char *text = string__substring(this->source, start, len);
+  Lexer__inc(this);
+  Lexer__push(this, Token__new(TokenType__CharLiteral, (Span){start_loc, this->loc}, text));
+}
+
+static void Lexer__lex_string_literal(Lexer *this) {
+  Location start_loc = this->loc;
+  char end_char = Lexer__cur(this);
+  i32 start = (this->i + 1);
+  Lexer__inc(this);
+  while (((this->i < this->source_len) && (Lexer__cur(this) != end_char))) {
+    if (Lexer__cur(this) == '\\') {
+      Lexer__inc(this);
+    } 
+    Lexer__inc(this);
+  } 
+  i32 len = (this->i - start);
+  char *text = string__substring(this->source, start, len);
+  Lexer__inc(this);
+  if ((this->i >= this->source_len)) {
+    Vector__push(this->errors, Error__new((Span){this->loc, this->loc}, "Unterminated string literal"));
+  } 
+  if (end_char == '`') {
+    Lexer__push(this, Token__new(TokenType__FormatStringLiteral, (Span){start_loc, this->loc}, text));
+  }  else {
+    Lexer__push(this, Token__new(TokenType__StringLiteral, (Span){start_loc, this->loc}, text));
+  } 
+}
+
+static Token *Lexer__lex_int_literal_different_base(Lexer *this) {
+  Location start_loc = this->loc;
+  i32 start = this->i;
+  Lexer__inc(this);
+  switch (Lexer__cur(this)) {
+    case 'x': {
+      Lexer__inc(this);
+      while (((this->i < this->source_len) && is_hex_digit(Lexer__cur(this)))) {
+        Lexer__inc(this);
+      } 
+    } break;
+    case 'b': {
+      Lexer__inc(this);
+      while ((((this->i < this->source_len) && Lexer__cur(this) == '0') || Lexer__cur(this) == '1')) {
+        Lexer__inc(this);
+      } 
+    } break;
+    default: {
+    } break;
+  }
+  i32 len = (this->i - start);
+  char *text = string__substring(this->source, start, len);
+  return Token__new(TokenType__IntLiteral, (Span){start_loc, this->loc}, text);
+}
+
+static Token *Lexer__lex_numeric_literal_helper(Lexer *this) {
+  Location start_loc = this->loc;
+  if (Lexer__cur(this) == '0') {
+    switch (Lexer__peek(this, 1)) {
+      case 'x':
+      case 'b': {
+        return Lexer__lex_int_literal_different_base(this);
+      } break;
+      default: {
+      } break;
+    }
+  } 
+  i32 start = this->i;
+  TokenType token_type;
+  while (isdigit(Lexer__cur(this))) {
+    Lexer__inc(this);
+  } 
+  if (Lexer__cur(this) == '.') {
+    Lexer__inc(this);
+    while (isdigit(Lexer__cur(this))) {
+      Lexer__inc(this);
+    } 
+    token_type = TokenType__FloatLiteral;
+  }  else {
+    token_type = TokenType__IntLiteral;
+  } 
+  i32 len = (this->i - start);
+  char *text = string__substring(this->source, start, len);
+  return Token__new(token_type, (Span){start_loc, this->loc}, text);
+}
+
+static void Lexer__lex_numeric_literal(Lexer *this) {
+  Token *token = Lexer__lex_numeric_literal_helper(this);
+  if (((Lexer__cur(this) == 'u' || Lexer__cur(this) == 'i') || Lexer__cur(this) == 'f')) {
+    Location start_loc = this->loc;
+    i32 start = this->i;
+    Lexer__inc(this);
+    while (((this->i < this->source_len) && isdigit(Lexer__cur(this)))) {
+      Lexer__inc(this);
+    } 
+    i32 len = (this->i - start);
+    char *suffix = string__substring(this->source, start, len);
+    token->suffix = Token__from_ident(suffix, (Span){start_loc, this->loc});
+  } 
+  Lexer__push(this, token);
+}
+
+static Vector *Lexer__lex(Lexer *this) {
+  while ((this->i < this->source_len)) {
+    char c = Lexer__cur(this);
+    switch (c) {
+      case ' ':
+      case '\t':
+      case '\v':
+      case '\r':
+      case '\b':
+      case '\n': {
+        Lexer__inc(this);
+      } break;
+      case ';': {
+        Lexer__push_type(this, TokenType__Semicolon, 1);
+      } break;
+      case ',': {
+        Lexer__push_type(this, TokenType__Comma, 1);
+      } break;
+      case '.': {
+        Lexer__push_type(this, TokenType__Dot, 1);
+      } break;
+      case '(': {
+        Lexer__push_type(this, TokenType__OpenParen, 1);
+      } break;
+      case ')': {
+        Lexer__push_type(this, TokenType__CloseParen, 1);
+      } break;
+      case '[': {
+        Lexer__push_type(this, TokenType__OpenSquare, 1);
+      } break;
+      case ']': {
+        Lexer__push_type(this, TokenType__CloseSquare, 1);
+      } break;
+      case '{': {
+        Lexer__push_type(this, TokenType__OpenCurly, 1);
+      } break;
+      case '}': {
+        Lexer__push_type(this, TokenType__CloseCurly, 1);
+      } break;
+      case '@': {
+        Lexer__push_type(this, TokenType__AtSign, 1);
+      } break;
+      case '%': {
+        Lexer__push_type(this, TokenType__Percent, 1);
+      } break;
+      case '^': {
+        Lexer__push_type(this, TokenType__Caret, 1);
+      } break;
+      case '&': {
+        Lexer__push_type(this, TokenType__Ampersand, 1);
+      } break;
+      case '|': {
+        Lexer__push_type(this, TokenType__Line, 1);
+      } break;
+      case '?': {
+        Lexer__push_type(this, TokenType__Question, 1);
+      } break;
+      case '~': {
+        Lexer__push_type(this, TokenType__Tilde, 1);
+      } break;
+      case '!': {
+        switch (Lexer__peek(this, 1)) {
+          case '=': {
+            Lexer__push_type(this, TokenType__NotEquals, 2);
+          } break;
+          default: {
+            Lexer__push_type(this, TokenType__Exclamation, 1);
+          } break;
+        }
+      } break;
+      case ':': {
+        switch (Lexer__peek(this, 1)) {
+          case ':': {
+            Lexer__push_type(this, TokenType__ColonColon, 2);
+          } break;
+          default: {
+            Lexer__push_type(this, TokenType__Colon, 1);
+          } break;
+        }
+      } break;
+      case '=': {
+        switch (Lexer__peek(this, 1)) {
+          case '=': {
+            Lexer__push_type(this, TokenType__EqualEquals, 2);
+          } break;
+          case '>': {
+            Lexer__push_type(this, TokenType__FatArrow, 2);
+          } break;
+          default: {
+            Lexer__push_type(this, TokenType__Equals, 1);
+          } break;
+        }
+      } break;
+      case '*': {
+        switch (Lexer__peek(this, 1)) {
+          case '=': {
+            Lexer__push_type(this, TokenType__StarEquals, 2);
+          } break;
+          default: {
+            Lexer__push_type(this, TokenType__Star, 1);
+          } break;
+        }
+      } break;
+      case '+': {
+        switch (Lexer__peek(this, 1)) {
+          case '=': {
+            Lexer__push_type(this, TokenType__PlusEquals, 2);
+          } break;
+          default: {
+            Lexer__push_type(this, TokenType__Plus, 1);
+          } break;
+        }
+      } break;
+      case '-': {
+        switch (Lexer__peek(this, 1)) {
+          case '=': {
+            Lexer__push_type(this, TokenType__MinusEquals, 2);
+          } break;
+          default: {
+            Lexer__push_type(this, TokenType__Minus, 1);
+          } break;
+        }
+      } break;
+      case '<': {
+        switch (Lexer__peek(this, 1)) {
+          case '=': {
+            Lexer__push_type(this, TokenType__LessThanEquals, 2);
+          } break;
+          case '<': {
+            Lexer__push_type(this, TokenType__LessThanLessThan, 2);
+          } break;
+          default: {
+            Lexer__push_type(this, TokenType__LessThan, 1);
+          } break;
+        }
+      } break;
+      case '>': {
+        switch (Lexer__peek(this, 1)) {
+          case '=': {
+            Lexer__push_type(this, TokenType__GreaterThanEquals, 2);
+          } break;
+          case '>': {
+            Lexer__push_type(this, TokenType__GreaterThanGreaterThan, 2);
+          } break;
+          default: {
+            Lexer__push_type(this, TokenType__GreaterThan, 1);
+          } break;
+        }
+      } break;
+      case '/': {
+        switch (Lexer__peek(this, 1)) {
+          case '/': {
+            Lexer__inc(this);
+            while (((this->i < this->source_len) && (Lexer__cur(this) != '\n'))) {
+              Lexer__inc(this);
+            } 
+          } break;
+          case '=': {
+            Lexer__push_type(this, TokenType__SlashEquals, 2);
+          } break;
+          default: {
+            Lexer__push_type(this, TokenType__Slash, 1);
+          } break;
+        }
+      } break;
+      case '\'': {
+        Lexer__lex_char_literal(this);
+      } break;
+      case '"':
+      case '`': {
+        Lexer__lex_string_literal(this);
+      } break;
+      default: {
+        Location start_loc = this->loc;
+        if (isdigit(c)) {
+          Lexer__lex_numeric_literal(this);
+        }  else         if ((isalpha(c) || c == '_')) {
+          i32 start = this->i;
+          while ((isalnum(Lexer__cur(this)) || Lexer__cur(this) == '_')) {
+            Lexer__inc(this);
+          } 
+          i32 len = (this->i - start);
+          char *text = string__substring(this->source, start, len);
+          Lexer__push(this, Token__from_ident(text, (Span){start_loc, this->loc}));
+        }  else {
+          Vector__push(this->errors, Error__new((Span){this->loc, this->loc}, format_string("Unrecognized char in lexer: '%c'", c)));
+          Lexer__inc(this);
+        } 
+        
+      } break;
+    }
+  } 
+  this->seen_newline = true;
+  Lexer__push_type(this, TokenType__EOF, 0);
+  return this->tokens;
+}
+
+static Buffer Buffer__make(void) {
+  i32 initial_capacity = 16;
+  return (Buffer){.data = calloc(initial_capacity, 1), .size = 0, .capacity = initial_capacity};
+}
+
+static Buffer Buffer__from_string(char *s) {
+  return (Buffer){.data = ((u8 *)s), .size = strlen(s), .capacity = strlen(s)};
+}
+
+static Buffer Buffer__from_sized_string(char *s, i32 size) {
+  return (Buffer){.data = ((u8 *)s), .size = ((i32)size), .capacity = strlen(s)};
+}
+
+static void Buffer__resize_if_necessary(Buffer *this, i32 new_size) {
+  if ((new_size >= this->capacity)) {
+    i32 new_capacity = max((this->capacity * 2), new_size);
+    this->data = ((u8 *)realloc(this->data, new_capacity));
+    if (this->data == NULL) {
+      printf("Out of memory!""\n");
+      exit(1);
+    } 
+    this->capacity = new_capacity;
+  } 
+}
+
+static void Buffer__hex_dump(Buffer *this) {
+  printf("(%d bytes): ", this->size);
+  for (i32 i = 0; (i < this->size); i += 1) {
+    if (((i % 4) == 0 && (i > 0))) 
+    printf("_");
+    
+    printf("%02x", this->data[i]);
+  } 
+  printf("""\n");
+}
+
+static void Buffer__putb(Buffer *this, Buffer *buf) {
+  Buffer__resize_if_necessary(this, ((this->size + buf->size) + 1));
+  memcpy((this->data + this->size), buf->data, buf->size);
+  this->data[(this->size + buf->size)] = ((u8)'\0');
+  this->size += buf->size;
+}
+
+static void Buffer__putbf(Buffer *this, Buffer *buf) {
+  Buffer__putb(this, buf);
+  Buffer__free(buf);
+}
+
+static void Buffer__puts(Buffer *this, char *s) {
+  i32 len = strlen(s);
+  Buffer__resize_if_necessary(this, ((this->size + len) + 1));
+  memcpy((this->data + this->size), s, (len + 1));
+  this->size += len;
+}
+
+static inline __attribute__((always_inline)) void Buffer__putc(Buffer *this, char c) {
+  Buffer__resize_if_necessary(this, (this->size + 2));
+  this->data[this->size] = ((u8)c);
+  this->size += 1;
+  this->data[this->size] = ((u8)'\0');
+}
+
+static void Buffer__put_u64(Buffer *this, u64 value) {
+  u8 digits[20];
+  i32 len = 0;
+  while (true) {
+    digits[len] = (((u8)(value % 10)) + ((u8)'0'));
+    len += 1;
+    value = (value / 10);
+    if (value == 0) 
+    break;
+    
+  } 
+  Buffer__resize_if_necessary(this, ((this->size + len) + 1));
+  for (i32 i = 0; (i < len); i += 1) {
+    this->data[(this->size + i)] = digits[((len - i) - 1)];
+  } 
+  this->size += len;
+  this->data[this->size] = ((u8)'\0');
+}
+
+static void Buffer__put_i64(Buffer *this, i64 value) {
+  if ((value < 0)) {
+    Buffer__putc(this, '-');
+    Buffer__put_u64(this, (-((u64)value)));
+  }  else {
+    Buffer__put_u64(this, ((u64)value));
+  } 
+}
+
+static void Buffer__put_f64(Buffer *this, f64 value) {
+  char stack[64];
+  char *s = format_string_into(stack, 64, "%f", value);
+  Buffer__puts(this, s);
+  if ((s != ((char *)stack))) 
+  free(s);
+  
+}
+
+static void Buffer__put_ptr(Buffer *this, void *value) {
+  char stack[32];
+  Buffer__puts(this, format_string_into(stack, 32, "%p", value));
+}
+
+static void Buffer__putsf(Buffer *this, char *s) {
+  Buffer__puts(this, s);
+  free(s);
+}
+
+static char *Buffer__str(Buffer *this) {
+  return ((char *)this->data);
+}
+
+static char *Buffer__new_str(Buffer *this) {
+  return strdup(((char *)this->data));
+}
+
+static void Buffer__free(Buffer *this) {
+  free(this->data);
+}
+
+static JSONParser JSONParser__make(Vector *tokens) {
+  JSONParser parser = {0};
+  parser.tokens = tokens;
+  parser.curr = 0;
+  return parser;
+}
+
+static Token *JSONParser__token(JSONParser *this) {
+  return Vector__at(this->tokens, this->curr);
+}
+
+static Token *JSONParser__consume(JSONParser *this, TokenType type) {
+  if ((JSONParser__token(this)->type != type)) {
+    printf("Expected %s but got %s""\n", TokenType__str(type), TokenType__str(JSONParser__token(this)->type));
+    exit(1);
+  } 
+  Token *tok = JSONParser__token(this);
+  this->curr += 1;
+  return tok;
+}
+
+static Value *JSONParser__parse_object(JSONParser *this) {
+  JSONParser__consume(this, TokenType__OpenCurly);
+  Value *json = Value__new(ValueType__Dictionary);
+  while ((JSONParser__token(this)->type != TokenType__CloseCurly)) {
+    Token *key = JSONParser__consume(this, TokenType__StringLiteral);
+    JSONParser__consume(this, TokenType__Colon);
+    Value *value = JSONParser__parse_value(this);
+    Map__insert(json->u.as_dict, key->text, value);
+    if (JSONParser__token(this)->type == TokenType__Comma) {
+      JSONParser__consume(this, TokenType__Comma);
+    } 
+  } 
+  JSONParser__consume(this, TokenType__CloseCurly);
+  return json;
+}
+
+static Value *JSONParser__parse_array(JSONParser *this) {
+  JSONParser__consume(this, TokenType__OpenSquare);
+  Value *json = Value__new(ValueType__List);
+  while ((JSONParser__token(this)->type != TokenType__CloseSquare)) {
+    Value *value = JSONParser__parse_value(this);
+    Vector__push(json->u.as_list, value);
+    if (JSONParser__token(this)->type == TokenType__Comma) {
+      JSONParser__consume(this, TokenType__Comma);
+    } 
+  } 
+  JSONParser__consume(this, TokenType__CloseSquare);
+  return json;
+}
+
+static Value *JSONParser__parse_value(JSONParser *this) {
+  return ({ Value *__yield_0;
+  switch (JSONParser__token(this)->type) {
+    case TokenType__Null: {
+      JSONParser__consume(this, TokenType__Null);
+      __yield_0 = Value__new(ValueType__Null);
+    } break;
+    case TokenType__True:
+    case TokenType__False: {
+      Value *json = Value__new(ValueType__Bool);
+      Token *tok = JSONParser__token(this);
+      json->u.as_bool = string__eq(tok->text, "true");
+      this->curr += 1;
+      __yield_0 = json;
+    } break;
+    case TokenType__IntLiteral: {
+      Value *json = Value__new(ValueType__Integer);
+      Token *tok = JSONParser__consume(this, TokenType__IntLiteral);
+      json->u.as_num = ((i64)atoi(tok->text));
+      __yield_0 = json;
+    } break;
+    case TokenType__StringLiteral: {
+      Value *json = Value__new(ValueType__String);
+      json->u.as_str = Buffer__from_string(JSONParser__consume(this, TokenType__StringLiteral)->text);
+      __yield_0 = json;
+    } break;
+    case TokenType__OpenCurly: {
+      __yield_0 = JSONParser__parse_object(this);
+} break;
+    case TokenType__OpenSquare: {
+      __yield_0 = JSONParser__parse_array(this);
+} break;
+    default: {
+      printf("Unexpected token in JSONParser::parse_value: %s""\n", TokenType__str(JSONParser__token(this)->type));
+      exit(1);
+    } break;
+  }
+;__yield_0; });
+}
+
+static Value *JSONParser__parse(JSONParser *this) {
+  return ({ Value *__yield_0;
+  switch (JSONParser__token(this)->type) {
+    case TokenType__OpenCurly: {
+      __yield_0 = JSONParser__parse_object(this);
+} break;
+    case TokenType__OpenSquare: {
+      __yield_0 = JSONParser__parse_array(this);
+} break;
+    default: {
+      printf("Expected { or [ at JSON top level""\n");
+      exit(1);
+    } break;
+  }
+;__yield_0; });
+}
+
+static Value *JSON__parse(char *source, char *filename) {
+  Lexer lexer = Lexer__make(source, filename);
+  Vector *tokens = Lexer__lex((&lexer));
+  JSONParser parser = JSONParser__make(tokens);
+  return JSONParser__parse((&parser));
+}
+
+static Value *JSON__parse_from_string(char *json_str) {
+  return JSON__parse(json_str, "<anonymous>");
+}
+
+static Value *JSON__parse_from_file(char *filename) {
+  FILE *file = File__open(filename, "r");
+  char *source = File__slurp(file);
+  fclose(file);
+  return JSON__parse(source, filename);
+}
+
+static void JSON__serialize_into(Value *val, Buffer *sb) {
+  switch (val->type) {
+    case ValueType__Null: {
+      Buffer__puts(sb, "null");
+    } break;
+    case ValueType__Bool: {
+      Buffer__puts(sb, (val->u.as_bool ? "true" : "false"));
+    } break;
+    case ValueType__Integer: {
+      ({ Buffer *__fmt_buf = sb; Buffer__put_i64(__fmt_buf, val->u.as_num); });
+    } break;
+    case ValueType__String: {
+      Buffer__puts(sb, "\"");
+      Buffer buf = val->u.as_str;
+      for (i32 i = 0; (i < buf.size); i += 1) {
+        char c = ((char)buf.data[i]);
+        if (isprint(c)) {
+          if ((c == '\\' || c == '"')) {
+            ({ Buffer *__fmt_buf = sb; Buffer__puts(__fmt_buf, "\\"); Buffer__putc(__fmt_buf, c); });
+          }  else {
+            Buffer__putc(sb, c);
+          } 
+        }  else {
+          ({ Buffer *__fmt_buf = sb; Buffer__puts(__fmt_buf, "\\x"); { char __fmt_stack[64]; char *__fmt_str = format_string_into(__fmt_stack, 64, "%02x", buf.data[i]); Buffer__puts(__fmt_buf, __fmt_str); if (__fmt_str != __fmt_stack) free(__fmt_str); } });
+        } 
+      } 
+      Buffer__puts(sb, "\"");
+    } break;
+    case ValueType__List: {
+      Buffer__puts(sb, "[");
+      Vector *lst = val->u.as_list;
+      for (i32 i = 0; (i < lst->size); i += 1) {
+        Value *value = ((Value *)Vector__at(lst, i));
+        if ((i > 0)) {
+          Buffer__puts(sb, ", ");
+        } 
+        JSON__serialize_into(value, sb);
+      } 
+      Buffer__puts(sb, "]");
+    } break;
+    case ValueType__Dictionary: {
+      Buffer__puts(sb, "{");
+      bool first = true;
+      for (MapIterator iter = Map__iter(val->u.as_dict); ((bool)iter.cur); MapIterator__next((&iter))) {
+        if ((!first)) {
+          Buffer__puts(sb, ", ");
+        } 
+        first = false;
+        Buffer__puts(sb, "\"");
+        Buffer__puts(sb, MapIterator__key((&iter)));
+        Buffer__puts(sb, "\": ");
+        Value *value = ((Value *)MapIterator__value((&iter)));
+        JSON__serialize_into(value, sb);
+      } 
+      Buffer__puts(sb, "}");
+    } break;
+  }
+}
+
+static Buffer JSON__serialize(Value *val) {
+  Buffer sb = Buffer__make();
+  JSON__serialize_into(val, (&sb));
+  return sb;
+}
+
+static char *ValueType__str(ValueType this) {
+  return ({ char *__yield_0;
+  switch (this) {
+    case ValueType__Null: {
+      __yield_0 = "Null";
+} break;
+    case ValueType__Bool: {
+      __yield_0 = "Bool";
+} break;
+    case ValueType__Integer: {
+      __yield_0 = "Integer";
+} break;
+    case ValueType__String: {
+      __yield_0 = "String";
+} break;
+    case ValueType__List: {
+      __yield_0 = "List";
+} break;
+    case ValueType__Dictionary: {
+      __yield_0 = "Dictionary";
+} break;
+  }
+;__yield_0; });
+}
+
+static Value *Value__new(ValueType type) {
+  Value *val = ((Value *)calloc(1, sizeof(Value)));
+  val->type = type;
+  switch (type) {
+    case ValueType__Dictionary: {
+      val->u.as_dict = Map__new();
+    } break;
+    case ValueType__List: {
+      val->u.as_list = Vector__new();
+    } break;
+    default: {
+    } break;
+  }
+  val->span = Span__default();
+  return val;
+}
+
+static Value *Value__new_str(Buffer str) {
+  Value *val = Value__new(ValueType__String);
+  val->u.as_str = str;
+  return val;
+}
+
+static Value *Value__new_bool(bool bul) {
+  Value *val = Value__new(ValueType__Bool);
+  val->u.as_bool = bul;
+  return val;
+}
+
+static Value *Value__new_number(i64 num) {
+  Value *val = Value__new(ValueType__Integer);
+  val->u.as_num = num;
+  return val;
+}
+
+static Value *Value__new_array(Vector *vec) {
+  Value *val = Value__new(ValueType__List);
+  free(val->u.as_list);
+  val->u.as_list = vec;
+  return val;
+}
+
+static Value *Value__new_dictect(Map *map) {
+  Value *val = Value__new(ValueType__Dictionary);
+  free(val->u.as_dict);
+  val->u.as_dict = map;
+  return val;
+}
+
+static void Value__ensure(Value *this, ValueType type) {
+  (__builtin_expect(!!(this->type == type), 1) ? (void)0 : panic(format_string("Value type mismatch, expected %s but got %s", ValueType__str(type), ValueType__str(this->type))));
+}
+
+static bool Value__is(Value this, ValueType type) {
+  return this.type == type;
+}
+
+static Value *Value__at(Value *this, u64 idx) {
+  Value__ensure(this, ValueType__List);
+  return Vector__at(this->u.as_list, ((i32)idx));
+}
+
+static void Value__set(Value *this, i64 idx, Value *value) {
+  Value__ensure(this, ValueType__List);
+  this->u.as_list->data[idx] = value;
+}
+
+static void Value__push(Value *this, Value *value) {
+  Value__ensure(this, ValueType__List);
+  Vector__push(this->u.as_list, value);
+}
+
+static Value *Value__get(Value *this, char *key) {
+  Value__ensure(this, ValueType__Dictionary);
+  return Map__get(this->u.as_dict, key);
+}
+
+static void Value__insert(Value *this, char *key, Value *value) {
+  Value__ensure(this, ValueType__Dictionary);
+  Map__insert(this->u.as_dict, key, value);
+}
+
+static bool Value__as_bool(Value *this) {
+  Value__ensure(this, ValueType__Bool);
+  return this->u.as_bool;
+}
+
+static i64 Value__as_num(Value *this) {
+  Value__ensure(this, ValueType__Integer);
+  return this->u.as_num;
+}
+
+static Buffer Value__as_str(Value *this) {
+  Value__ensure(this, ValueType__String);
+  return this->u.as_str;
+}
+
+static Vector *Value__as_arr(Value *this) {
+  Value__ensure(this, ValueType__List);
+  return this->u.as_list;
+}
+
+static Map *Value__as_dict(Value *this) {
+  Value__ensure(this, ValueType__Dictionary);
+  return this->u.as_dict;
+}
+
+static char *Value__dbg(Value *this) {
+  Buffer buf = JSON__serialize(this);
+  return Buffer__str((&buf));
+}
+
+static void Value__free(Value *this) {
+  switch (this->type) {
+    case ValueType__String: {
+      Buffer__free((&this->u.as_str));
+    } break;
+    case ValueType__List: {
+      Vector *vec = this->u.as_list;
+      for (i32 i = 0; (i < vec->size); i += 1) {
+        Value__free(Vector__at(vec, i));
+      } 
+      Vector__free(this->u.as_list);
+    } break;
+    case ValueType__Dictionary: {
+      Map *map = this->u.as_dict;
+      for (MapIterator iter = Map__iter(map); ((bool)iter.cur); MapIterator__next((&iter))) {
+        free(iter.cur->key);
+        Value__free(iter.cur->value);
+      } 
+      Map__free(this->u.as_dict);
+    } break;
+    default: {
+    } break;
+  }
+  free(this);
+}
+
+static BencodeParser BencodeParser__new(char *input) {
+  return (BencodeParser){.input = input, .loc = (Location){.filename = "<bencoded string>", .line = 1, .col = 1, .index = 0}};
+}
+
+static char BencodeParser__cur(BencodeParser *this) {
+  return this->input[this->loc.index];
+}
+
+static Value *BencodeParser__parse(BencodeParser *this) {
+  Location start = this->loc;
+  Value *val = ({ Value *__yield_0;
+  switch (BencodeParser__cur(this)) {
+    case 'i': {
+      __yield_0 = BencodeParser__parse_int(this);
+} break;
+    case 'l': {
+      __yield_0 = BencodeParser__parse_list(this);
+} break;
+    case 'd': {
+      __yield_0 = BencodeParser__parse_dict(this);
+} break;
+    default: {
+      __yield_0 = BencodeParser__parse_string(this);
+} break;
+  }
+;__yield_0; });
+  val->span = (Span){start, this->loc};
+  return val;
+}
+
+static void BencodeParser__inc(BencodeParser *this) {
+  this->loc.index += 1;
+}
+
+static i64 BencodeParser__parse_int_internal(BencodeParser *this) {
+  i64 scale = 1;
+  if (BencodeParser__cur(this) == '-') {
+    scale = (-1);
+    BencodeParser__inc(this);
+  } 
+  i64 num = 0;
+  while (isdigit(BencodeParser__cur(this))) {
+    num *= 10;
+    num += (((i64)BencodeParser__cur(this)) - ((i64)'0'));
+    BencodeParser__inc(this);
+  } 
+  return (num * scale);
+}
+
+static Value *BencodeParser__parse_list(BencodeParser *this) {
+  Value *val = Value__new(ValueType__List);
+  val->u.as_list = Vector__new();
+  BencodeParser__inc(this);
+  while ((BencodeParser__cur(this) != 'e')) {
+    Vector__push(val->u.as_list, BencodeParser__parse(this));
+  } 
+  BencodeParser__inc(this);
+  return val;
+}
+
+static Value *BencodeParser__parse_dict(BencodeParser *this) {
+  Value *val = Value__new(ValueType__Dictionary);
+  val->u.as_dict = Map__new();
+  BencodeParser__inc(this);
+  while ((BencodeParser__cur(this) != 'e')) {
+    Buffer key = BencodeParser__parse_string_internal(this);
+    Value *value = BencodeParser__parse(this);
+    Map__insert(val->u.as_dict, Buffer__str((&key)), value);
+  } 
+  BencodeParser__inc(this);
+  return val;
+}
+
+static Buffer BencodeParser__parse_string_internal(BencodeParser *this) {
+  i64 len = BencodeParser__parse_int_internal(this);
+  BencodeParser__inc(this);
+  char *s = string__substring(this->input, ((i32)this->loc.index), ((i32)len));
+  for (i64 i = 0; (i < len); i += 1) {
+    BencodeParser__inc(this);
+  } 
+  return (Buffer){.data = ((u8 *)s), .size = ((i32)len), .capacity = ((i32)len)};
+}
+
+static Value *BencodeParser__parse_string(BencodeParser *this) {
+  Value *val = Value__new(ValueType__String);
+  val->u.as_str = BencodeParser__parse_string_internal(this);
+  return val;
+}
+
+static Value *BencodeParser__parse_int(BencodeParser *this) {
+  Value *val = Value__new(ValueType__Integer);
+  BencodeParser__inc(this);
+  i64 num = BencodeParser__parse_int_internal(this);
+  BencodeParser__inc(this);
+  val->u.as_num = num;
+  return val;
+}
+
+static Value *Bencode__parse(char *s) {
+  BencodeParser parser = BencodeParser__new(s);
+  return BencodeParser__parse((&parser));
+}
+
+static void Bencode__serialize_into(Value *val, Buffer *sb) {
+  switch (val->type) {
+    case ValueType__String: {
+      Buffer str = val->u.as_str;
+      ({ Buffer *__fmt_buf = sb; Buffer__put_i64(__fmt_buf, str.size); Buffer__puts(__fmt_buf, ":"); });
+      Buffer__putb(sb, (&str));
+    } break;
+    case ValueType__Integer: {
+      ({ Buffer *__fmt_buf = sb; Buffer__puts(__fmt_buf, "i"); Buffer__put_i64(__fmt_buf, val->u.as_num); Buffer__puts(__fmt_buf, "e"); });
+    } break;
+    case ValueType__List: {
+      Buffer__puts(sb, "l");
+      Vector *lst = val->u.as_list;
+      for (i32 i = 0; (i < lst->size); i += 1) {
+        Value *item = ((Value *)Vector__at(lst, i));
+        Bencode__serialize_into(item, sb);
+      } 
+      Buffer__puts(sb, "e");
+    } break;
+    case ValueType__Dictionary: {
+      Buffer__puts(sb, "d");
+      Map *map = val->u.as_dict;
+      for (MapIterator iter = Map__iter(map); ((bool)iter.cur); MapIterator__next((&iter))) {
+        char *key = ((char *)iter.cur->key);
+        Value *value = ((Value *)iter.cur->value);
+        ({ Buffer *__fmt_buf = sb; Buffer__put_i64(__fmt_buf, strlen(key)); Buffer__puts(__fmt_buf, ":"); Buffer__puts(__fmt_buf, key); });
+        Bencode__serialize_into(value, sb);
+      } 
+      Buffer__puts(sb, "e");
+    } break;
+    default: panic(format_string("Unsupported Value type %s in Bencode::serialize_into()", ValueType__dbg(val->type))); break;
+  }
+}
+
+static Buffer Bencode__serialize(Value *val) {
+  Buffer sb = Buffer__make();
+  Bencode__serialize_into(val, (&sb));
+  return sb;
+}
+
+static u32 SHA1__rotate_left(u32 value, u32 bits) {
+  return ((value << bits) | (value >> (32 - bits)));
+}
+
+static Buffer SHA1__hash(Buffer *input) {
+  u8 *data = input->data;
+  u64 size = ((u64)input->size);
+  u32 H[5];
+  H[0] = 0x67452301;
+  H[1] = 0xEFCDAB89;
+  H[2] = 0x98BADCFE;
+  H[3] = 0x10325476;
+  H[4] = 0xC3D2E1F0;
+  u64 loopcount = (((size + 8) / 64) + 1);
+  u64 tailbytes = ((loopcount * 64) - size);
+  u8 datatail[128];
+  memset(datatail, 0, (128 * sizeof(u8)));
+  datatail[0] = 0x80;
+  for (u64 i = 0; (i < 8); i += 1) {
+    datatail[((tailbytes - 1) - i)] = ((u8)(((size * 8) >> (((u64)i) * 8)) & 0xFF));
+  } 
+  u32 W[80];
+  u64 didx = 0;
+  for (u64 lidx = 0; (lidx < loopcount); lidx += 1) {
+    memset(W, 0, (80 * sizeof(u32)));
+    for (u32 widx = 0; (widx < 16); widx += 1) {
+      i32 wcount = 24;
+      while (((didx < size) && (wcount >= 0))) {
+        W[widx] += (((u32)data[didx]) << ((u32)wcount));
+        wcount -= 8;
+        didx += 1;
+      } 
+      while ((wcount >= 0)) {
+        W[widx] += (((u32)datatail[(didx - size)]) << ((u32)wcount));
+        wcount -= 8;
+        didx += 1;
+      } 
+    } 
+    for (u32 widx = 16; (widx < 32); widx += 1) {
+      W[widx] = SHA1__rotate_left((((W[(widx - 3)] ^ W[(widx - 8)]) ^ W[(widx - 14)]) ^ W[(widx - 16)]), 1);
+    } 
+    for (u32 widx = 32; (widx < 80); widx += 1) {
+      W[widx] = SHA1__rotate_left((((W[(widx - 6)] ^ W[(widx - 16)]) ^ W[(widx - 28)]) ^ W[(widx - 32)]), 2);
+    } 
+    u32 T[5];
+    memcpy(T, H, (5 * sizeof(u32)));
+    for (i32 idx = 0; (idx <= 79); idx += 1) {
+      u32 factor = ({ u32 __yield_0;
+  switch ((idx / 20)) {
+    case 0: {
+      __yield_0 = (0x5A827999 + ((T[1] & T[2]) | ((~T[1]) & T[3])));
+} break;
+    case 1: {
+      __yield_0 = (0x6ED9EBA1 + ((T[1] ^ T[2]) ^ T[3]));
+} break;
+    case 2: {
+      __yield_0 = (0x8F1BBCDC + (((T[1] & T[2]) | (T[1] & T[3])) | (T[2] & T[3])));
+} break;
+    case 3: {
+      __yield_0 = (0xCA62C1D6 + ((T[1] ^ T[2]) ^ T[3]));
+} break;
+    default: {
+      __yield_0 = 0;
+} break;
+  }
+;__yield_0; });
+      u32 temp = (((SHA1__rotate_left(T[0], 5) + T[4]) + factor) + W[idx]);
+      T[4] = T[3];
+      T[3] = T[2];
+      T[2] = SHA1__rotate_left(T[1], 30);
+      T[1] = T[0];
+      T[0] = temp;
+    } 
+    for (i32 i = 0; (i < 5); i += 1) {
+      H[i] += T[i];
+    } 
+  } 
+  Buffer out = Buffer__make();
+  Buffer__resize_if_necessary((&out), 20);
+  for (i32 idx = 0; (idx < 5); idx += 1) {
+    out.data[((idx * 4) + 0)] = ((u8)(H[idx] >> 24));
+    out.data[((idx * 4) + 1)] = ((u8)(H[idx] >> 16));
+    out.data[((idx * 4) + 2)] = ((u8)(H[idx] >> 8));
+    out.data[((idx * 4) + 3)] = ((u8)H[idx]);
+  } 
+  out.size = 20;
+  return out;
+}
+
+static Buffer SHA1__hash_string(char *data) {
+  Buffer input_data = Buffer__from_string(data);
+  return SHA1__hash((&input_data));
+}
+
+static BufferIO BufferIO__make(Buffer *data) {
+  return (BufferIO){.data = data, .index = 0};
+}
+
+static i64 BufferIO__read_i64_be(BufferIO *this) {
+  return ((i64)BufferIO__read_u64_be(this));
+}
+
+static u64 BufferIO__read_u64_be(BufferIO *this) {
+  u64 value = 0;
+  for (i32 i = 0; (i < 8); i += 1) {
+    value = (value | (((u64)this->data->data[(this->index + i)]) << (56 - (((u64)i) * 8))));
+  } 
+  this->index += 8;
+  return ((u64)value);
+}
+
+static i32 BufferIO__read_i32_be(BufferIO *this) {
+  return ((i32)BufferIO__read_u32_be(this));
+}
+
+static u32 BufferIO__read_u32_be(BufferIO *this) {
+  u32 value = 0;
+  for (i32 i = 0; (i < 4); i += 1) {
+    value = (value | (((u32)this->data->data[(this->index + i)]) << (24 - (((u32)i) * 8))));
+  } 
+  this->index += 4;
+  return value;
+}
+
+static void BufferIO__read_bytes(BufferIO *this, void *_dst, i32 count) {
+  u8 *dst = ((u8 *)_dst);
+  for (i32 i = 0; (i < count); i += 1) {
+    dst[i] = this->data->data[(this->index + i)];
+  } 
+  this->index += count;
+}
+
+static i16 BufferIO__read_i16_be(BufferIO *this) {
+  return ((i16)BufferIO__read_i16_be(this));
+}
+
+static u16 BufferIO__read_u16_be(BufferIO *this) {
+  u16 value = 0;
+  for (u16 i = 0; (i < 2); i += 1) {
+    value = (value | (((u16)this->data->data[(this->index + ((i32)i))]) << (8 - (i * 8))));
+  } 
+  this->index += 2;
+  return ((u16)value);
+}
+
+static void BufferIO__write_i64_be(BufferIO *this, i64 value) {
+  return BufferIO__write_u64_be(this, ((u64)value));
+}
+
+static void BufferIO__write_u64_be(BufferIO *this, u64 value) {
+  Buffer__resize_if_necessary(this->data, (this->data->size + 8));
+  for (u64 i = 0; (i < 8); i += 1) {
+    this->data->data[(this->data->size + ((i32)i))] = ((u8)((value >> (56 - (i * 8))) & 0xff));
+  } 
+  this->data->size += 8;
+}
+
+static void BufferIO__write_i32_be(BufferIO *this, i32 value) {
+  return BufferIO__write_u32_be(this, ((u32)value));
+}
+
+static void BufferIO__write_u32_be(BufferIO *this, u32 value) {
+  Buffer__resize_if_necessary(this->data, (this->data->size + 4));
+  for (u32 i = 0; (i < 4); i += 1) {
+    this->data->data[(this->data->size + ((i32)i))] = ((u8)((value >> (24 - (i * 8))) & 0xff));
+  } 
+  this->data->size += 4;
+}
+
+static void BufferIO__write_i16_be(BufferIO *this, i16 value) {
+  return BufferIO__write_u16_be(this, ((u16)value));
+}
+
+static void BufferIO__write_u16_be(BufferIO *this, u16 value) {
+  Buffer__resize_if_necessary(this->data, (this->data->size + 2));
+  for (u16 i = 0; (i < 2); i += 1) {
+    this->data->data[(this->data->size + ((i32)i))] = ((u8)((value >> (8 - (i * 8))) & 0xff));
+  } 
+  this->data->size += 2;
+}
+
+static void BufferIO__write_i8(BufferIO *this, i8 value) {
+  return BufferIO__write_u8(this, ((u8)value));
+}
+
+static void BufferIO__write_u8(BufferIO *this, u8 value) {
+  Buffer__resize_if_necessary(this->data, (this->data->size + 1));
+  this->data->data[this->data->size] = value;
+  this->data->size += 1;
+}
+
+static void BufferIO__write_bytes(BufferIO *this, void *_src, i32 count) {
+  u8 *src = ((u8 *)_src);
+  Buffer__resize_if_necessary(this->data, (this->data->size + count));
+  for (i32 i = 0; (i < count); i += 1) {
+    this->data->data[(this->data->size + i)] = src[i];
+  } 
+  this->data->size += count;
+}
+
+static Socket Socket__connect(char *host, i32 port, SocketMode mode) {
+  Socket sock = {0};
+  sock.fd = ({ i32 __yield_0;
+  switch (mode) {
+    case SocketMode__UDP: {
+      __yield_0 = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+} break;
+    case SocketMode__TCP: {
+      __yield_0 = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+} break;
+  }
+;__yield_0; });
+  if ((sock.fd < 0)) {
+    printf("Error creating socket: %s\n", strerror(errno));
+    exit(1);
+  } 
+  struct sockaddr_in server_address = {0};
+  server_address.sin_family = AF_INET;
+  server_address.sin_port = htons(port);
+  struct hostent *hostm = gethostbyname(host);
+  if (((!((bool)hostm)) || (!((bool)hostm->h_addr)))) {
+    panic(format_string("Error getting host by name, exiting"));
+  } 
+  server_address.sin_addr.s_addr = (*((i32 *)hostm->h_addr));
+  if ((inet_pton(AF_INET, host, (&server_address.sin_addr)) < 0)) {
+    printf("inet_pton had an error: %s\n", strerror(errno));
+    exit(1);
+  } 
+  if ((connect(sock.fd, ((struct sockaddr *)(&server_address)), sizeof(struct sockaddr_in)) < 0)) {
+    printf("Error connecting to socket: %s\n", strerror(errno));
+    exit(1);
+  } 
+  return sock;
+}
+
+static i32 Socket__read(Socket *this, Buffer *buf, i32 max_size) {
+  Buffer__resize_if_necessary(buf, max_size);
+  buf->size = read(this->fd, buf->data, max_size);
+  return buf->size;
+}
+
+static i32 Socket__read_exactly(Socket *this, Buffer *buf, i32 size) {
+  Buffer__resize_if_necessary(buf, size);
+  buf->size = 0;
+  while ((size > 0)) {
+    i32 n = read(this->fd, (buf->data + buf->size), size);
+    if ((n < 0)) {
+      printf("Error reading from socket: %s\n", strerror(errno));
+      return (-1);
+    } 
+    buf->size += n;
+    size -= n;
+  } 
+  return buf->size;
+}
+
+static i32 Socket__write(Socket *this, Buffer *buf) {
+  return write(this->fd, buf->data, buf->size);
+}
+
+static Buffer get_info_hash(char *data, Value *info) {
+  Span span = info->span;
+  char *start = (data + span.start.index);
+  i32 len = (span.end.index - span.start.index);
+  Buffer buffer = Buffer__from_sized_string(start, len);
+  return SHA1__hash((&buffer));
+}
+
+static void read_peer_message(Socket *peer) {
+  Buffer response = Buffer__make();
+  ;
+  i32 n = Socket__read_exactly(peer, (&response), 4);
+  BufferIO io = BufferIO__make((&response));
+  i32 len = BufferIO__read_i32_be((&io));
+  if (len == 0) {
+    printf("[+] Got a keep-alive message\n");
+    send_peer_message("keep-alive", peer, NULL);
+    return;
+  } 
+  n = Socket__read_exactly(peer, (&response), len);
+  switch (response.data[0]) {
+    case 0: {
+      printf("[+] Got a choke message");
+    } break;
+    case 1: {
+      printf("[+] Got an unchoke message");
+    } break;
+    case 2: {
+      printf("[+] Got an interested message");
+    } break;
+    case 3: {
+      printf("[+] Got a not interested message");
+    } break;
+    case 4: {
+      printf("[+] Got a have message");
+    } break;
+    case 5: {
+      printf("[+] Got a bitfield message");
+    } break;
+    case 6: {
+      printf("[+] Got a request message");
+    } break;
+    case 7: {
+      printf("[+] Got a piece message");
+    } break;
+    case 8: {
+      printf("[+] Got a cancel message");
+    } break;
+    case 9: {
+      printf("[+] Got a port message");
+    } break;
+    default: {
+      printf("[+] Got an unknown message");
+    } break;
+  }
+  printf(": ");
+  Buffer__hex_dump((&response));
+
+  /* defers */
+  Buffer__free((&response));
+}
+
+static void send_peer_message(char *dbg, Socket *peer, Buffer *payload) {
+  Buffer msg = Buffer__make();
+  ;
+  i32 len = (((bool)payload) ? (payload->size + 1) : 1);
+  u8 msg_id = 0;
+  {
+    char *__match_str = dbg;
+    switch (aecor_hash_str(__match_str, 2166136261u)) {
+      case 3389192450u:
+        if (!strcmp(__match_str, "keep-alive")) goto __match_1_0;
+        break;
+      case 2593585379u:
+        if (!strcmp(__match_str, "choke")) goto __match_1_1;
+        break;
+      case 2198478645u:
+        if (!strcmp(__match_str, "unchoke")) goto __match_1_2;
+        break;
+      case 3014830840u:
+        if (!strcmp(__match_str, "interested")) goto __match_1_3;
+        break;
+      case 2621452814u:
+        if (!strcmp(__match_str, "not interested")) goto __match_1_4;
+        break;
+      case 2970689859u:
+        if (!strcmp(__match_str, "have")) goto __match_1_5;
+        break;
+      case 1592560145u:
+        if (!strcmp(__match_str, "bitfield")) goto __match_1_6;
+        break;
+      case 2805734191u:
+        if (!strcmp(__match_str, "request")) goto __match_1_7;
+        break;
+      case 1785199847u:
+        if (!strcmp(__match_str, "piece")) goto __match_1_8;
+        break;
+      case 2467317528u:
+        if (!strcmp(__match_str, "cancel")) goto __match_1_9;
+        break;
+      case 1442372502u:
+        if (!strcmp(__match_str, "port")) goto __match_1_10;
+        break;
+    }
+    goto __match_1_default;
+    __match_1_0: {
+      len = 0;
+    } goto __match_1_end;
+    __match_1_1: {
+      msg_id = 0;
+    } goto __match_1_end;
+    __match_1_2: {
+      msg_id = 1;
+    } goto __match_1_end;
+    __match_1_3: {
+      msg_id = 2;
+    } goto __match_1_end;
+    __match_1_4: {
+      msg_id = 3;
+    } goto __match_1_end;
+    __match_1_5: {
+      msg_id = 4;
+    } goto __match_1_end;
+    __match_1_6: {
+      msg_id = 5;
+    } goto __match_1_end;
+    __match_1_7: {
+      msg_id = 6;
+    } goto __match_1_end;
+    __match_1_8: {
+      msg_id = 7;
+    } goto __match_1_end;
+    __match_1_9: {
+      msg_id = 8;
+    } goto __match_1_end;
+    __match_1_10: {
+      msg_id = 9;
+    } goto __match_1_end;
+    __match_1_default: panic(format_string("[+] Invalid message type: %s", dbg));
+    __match_1_end:;
+  }
+  BufferIO io = BufferIO__make((&msg));
+  BufferIO__write_i32_be((&io), len);
+  if ((len > 0)) {
+    BufferIO__write_u8((&io), msg_id);
+  } 
+  if (((bool)payload)) {
+    BufferIO__write_bytes((&io), payload->data, payload->size);
+  } 
+  printf("Sending %s message: ", dbg);
+  Buffer__hex_dump((&msg));
+  Socket__write(peer, (&msg));
+
+  /* defers */
+  Buffer__free((&msg));
+}
+
+i32 main(i32 argc, char **argv) {
+  if ((argc < 2)) {
+    printf("Usage: %s <file>\n", argv[0]);
+    exit(1);
+  } 
+  FILE *file = File__open(argv[1], "r");
+  char *data = File__slurp(file);
+  Value *metadata = Bencode__parse(data);
+  Value *metadata_info = Value__get(metadata, "info");
+  Buffer info_hash = get_info_hash(data, metadata_info);
+  printf("meta: %s\n", Value__dbg(metadata));
+  Buffer announce = Value__as_str(Value__get(metadata, "announce"));
+  char *announce_str = Buffer__new_str((&announce));
+  i32 port = (-1);
+  for (i32 i = (announce.size - 1); (i >= 0); i -= 1) {
+    if (announce_str[i] == ':') {
+      port = atoi(((announce_str + i) + 1));
+      announce_str[i] = '\0';
+      break;
+    } 
+  } 
+  char *host = ((char *)NULL);
+  for (i32 i = 0; (i < (announce.size - 1)); i += 1) {
+    if ((announce_str[i] == '/' && announce_str[(i + 1)] == '/')) {
+      host = ((announce_str + i) + 2);
+      break;
+    } 
+  } 
+  if (((port < 0) || (!((bool)host)))) {
+    printf("Invalid announce URL: %s\n", Buffer__str((&announce)));
+    exit(1);
+  } 
+  printf("host: %s, port: %d\n", host, port);
+  TrackerState state = {0};
+  state.transaction_id = 69;
+  Buffer response = Buffer__make();
+  Socket socket = Socket__connect(host, port, SocketMode__UDP);
+  {
+    Buffer msg = Buffer__make();
+    ;
+    BufferIO io = BufferIO__make((&msg));
+    BufferIO__write_i64_be((&io), 0x41727101980);
+    BufferIO__write_i32_be((&io), 0);
+    BufferIO__write_i32_be((&io), state.transaction_id);
+    printf("Sent message: ");
+    Buffer__hex_dump((&msg));
+    Socket__write((&socket), (&msg));
+
+    /* defers */
+    Buffer__free((&msg));
+  }
+  {
+    Socket__read_exactly((&socket), (&response), 16);
+    BufferIO io = BufferIO__make((&response));
+    i32 action = BufferIO__read_i32_be((&io));
+    i32 transaction_id = BufferIO__read_i32_be((&io));
+    i64 connection_id = BufferIO__read_i64_be((&io));
+    printf("-----------------------------------------------------------""\n");
+    printf("action: %d, trans_id: %d, conn_id: %llx\n", action, transaction_id, connection_id);
+    printf("-----------------------------------------------------------""\n");
+    if (((action != 0) && (transaction_id != state.transaction_id))) {
+      printf("[+] Invalid response from tracker\n");
+      exit(1);
+    } 
+    state.connection_id = connection_id;
+  }
+  {
+    Buffer msg = Buffer__make();
+    ;
+    i64 left = Value__as_num(Value__get(metadata_info, "length"));
+    BufferIO io = BufferIO__make((&msg));
+    BufferIO__write_i64_be((&io), state.connection_id);
+    BufferIO__write_i32_be((&io), 1);
+    BufferIO__write_i32_be((&io), state.transaction_id);
+    BufferIO__write_bytes((&io), info_hash.data, info_hash.size);
+    BufferIO__write_bytes((&io), "01234567890123456789", 20);
+    BufferIO__write_i64_be((&io), 0);
+    BufferIO__write_i64_be((&io), left);
+    BufferIO__write_i64_be((&io), 0);
+    BufferIO__write_i32_be((&io), 0);
+    BufferIO__write_u32_be((&io), 0);
+    BufferIO__write_u32_be((&io), 69);
+    BufferIO__write_u32_be((&io), (-1));
+    BufferIO__write_u16_be((&io), 6881);
+    BufferIO__write_u16_be((&io), 0);
+    printf("Sent message: ");
+    Buffer__hex_dump((&msg));
+    Socket__write((&socket), (&msg));
+
+    /* defers */
+    Buffer__free((&msg));
+  }
+  printf(">>>""\n");
+  {
+    i32 header_size = 20;
+    i32 n = Socket__read((&socket), (&response), 1024);
+    printf(">>>""\n");
+    i32 num_peers = ((n - header_size) / 6);
+    printf("Read %d bytes\n", n);
+    BufferIO io = BufferIO__make((&response));
+    i32 action = BufferIO__read_i32_be((&io));
+    i32 transaction_id = BufferIO__read_i32_be((&io));
+    i32 interval = BufferIO__read_i32_be((&io));
+    i32 leechers = BufferIO__read_i32_be((&io));
+    i32 seeders = BufferIO__read_i32_be((&io));
+    printf("-----------------------------------------------------------""\n");
+    printf("action = %d, trans_id=%d, interval=%d\n", action, transaction_id, interval);
+    printf("leechers=%d, seeders=%d\n", leechers, seeders);
+    printf("-----------------------------------------------------------""\n");
+    printf("Peers: %d\n", num_peers);
+    for (i32 i = 0; (i < num_peers); i += 1) {
+      u8 ip[4];
+      BufferIO__read_bytes((&io), (&ip), 4);
+      u16 port = BufferIO__read_u16_be((&io));
+      if (i == 5) {
+        state.chosen_peer = format_string("%u.%u.%u.%u", ip[0], ip[1], ip[2], ip[3]);
+        state.chosen_port = ((i32)((u32)port));
+      } 
+      printf(" - %u.%u.%u.%u:%u\n", ip[0], ip[1], ip[2], ip[3], port);
+    } 
+  }
+  {
+    Buffer msg = Buffer__make();
+    ;
+    BufferIO io = BufferIO__make((&msg));
+    BufferIO__write_i64_be((&io), state.connection_id);
+    BufferIO__write_i32_be((&io), 2);
+    BufferIO__write_i32_be((&io), state.transaction_id);
+    BufferIO__write_bytes((&io), info_hash.data, info_hash.size);
+    printf("Sent message: ");
+    Buffer__hex_dump((&msg));
+    Socket__write((&socket), (&msg));
+
+    /* defers */
+    Buffer__free((&msg));
+  }
+  {
+    i32 n = Socket__read((&socket), (&response), 1024);
+    printf("Read %d bytes: %s\n", n, strerror(errno));
+    i32 header_size = 8;
+    i32 num_entries = ((n - header_size) / 12);
+    BufferIO io = BufferIO__make((&response));
+    i32 action = BufferIO__read_i32_be((&io));
+    i32 transaction_id = BufferIO__read_i32_be((&io));
+    printf("-----------------------------------------------------------""\n");
+    printf("action: %d, trans_id: %d\n", action, transaction_id);
+    printf("-----------------------------------------------------------""\n");
+    printf("Scraping: %d\n", num_entries);
+    for (i32 i = 0; (i < num_entries); i += 1) {
+      i32 complete = BufferIO__read_i32_be((&io));
+      i32 downloaded = BufferIO__read_i32_be((&io));
+      i32 incomplete = BufferIO__read_i32_be((&io));
+      printf(" - complete: %d, downloaded: %d, incomplete: %d\n", complete, downloaded, incomplete);
+    } 
+  }
+  if ((!((bool)state.chosen_peer))) {
+    printf("[+] No peers found\n");
+    exit(1);
+  } 
+  printf("-----------------------------------------------------------""\n");
+  printf("Connecting to %s:%d\n", state.chosen_peer, state.chosen_port);
+  Socket peer = Socket__connect(state.chosen_peer, state.chosen_port, SocketMode__TCP);
+  {
+    Buffer msg = Buffer__make();
+    ;
+    BufferIO io = BufferIO__make((&msg));
+    BufferIO__write_u8((&io), 19);
+    BufferIO__write_bytes((&io), "BitTorrent protocol", 19);
+    BufferIO__write_u32_be((&io), 0);
+    BufferIO__write_u32_be((&io), 0);
+    BufferIO__write_bytes((&io), info_hash.data, info_hash.size);
+    BufferIO__write_bytes((&io), "01234567890123456789", 20);
+    printf("Sent message: ");
+    Buffer__hex_dump((&msg));
+    Socket__write((&peer), (&msg));
+
+    /* defers */
+    Buffer__free((&msg));
+  }
+  {
+    Socket__read_exactly((&peer), (&response), 1);
+    i32 len = ((i32)((u32)response.data[0]));
+    printf("pstrlen = %d\n", len);
+    Socket__read_exactly((&peer), (&response), len);
+    Socket__read_exactly((&peer), (&response), 8);
+    Socket__read_exactly((&peer), (&response), 20);
+    printf("Got info_hash: ");
+    Buffer__hex_dump((&response));
+    printf("known info_hash: ");
+    Buffer__hex_dump((&info_hash));
+    Socket__read_exactly((&peer), (&response), 20);
+    printf("Got Handshake response: ");
+    Buffer__hex_dump((&response));
+  }
+  printf("-----------------------------------------------------------""\n");
+  send_peer_message("unchoke", (&peer), NULL);
+  send_peer_message("interested", (&peer), NULL);
+  read_peer_message((&peer));
+  send_peer_message("unchoke", (&peer), NULL);
+  send_peer_message("interested", (&peer), NULL);
+  {
+    Buffer msg = Buffer__make();
+    ;
+    BufferIO io = BufferIO__make((&msg));
+    BufferIO__write_i32_be((&io), 0);
+    BufferIO__write_i32_be((&io), 0);
+    BufferIO__write_i32_be((&io), 123);
+    for (i32 i = 0; (i < 10); i += 1) {
+      send_peer_message("request", (&peer), (&msg));
+    } 
+
+    /* defers */
+    Buffer__free((&msg));
+  }
+  while (true) {
+    read_peer_message((&peer));
+  } 
+}
+
@@ -0,0 +1,754 @@
+#include "stdio.h"
+#include "stdlib.h"
+#include "stdbool.h"
+#include "stdint.h"
+#include "string.h"
+#include "errno.h"
+#include "ctype.h"
+#include "math.h"
+
+/***************** embed './lib/prelude.h' *****************/
+#include "stdarg.h"
+
+typedef int8_t i8;
+typedef int16_t i16;
+typedef int32_t i32;
+typedef int64_t i64;
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+
+typedef float f32;
+typedef double f64;
+
+// Formats into `stack` if the result fits in `capacity` bytes, otherwise
+// returns a new heap-allocated string that the caller needs to free.
+char* format_string_into(char* stack, int capacity, const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  int size = vsnprintf(stack, capacity, format, args);
+  va_end(args);
+  if (size < capacity) return stack;
+  char* s = malloc(size + 1);
+  va_start(args, format);
+  vsnprintf(s, size + 1, format, args);
+  va_end(args);
+  return s;
+}
+
+// Formats into a stack buffer first since most formatted strings are short,
+// which saves a separate pass just to compute the size.
+static char* aecor_vformat(void* (*alloc)(size_t), const char* format, va_list args) {
+  char stack[256];
+  va_list copy;
+  va_copy(copy, args);
+  int size = vsnprintf(stack, sizeof(stack), format, copy);
+  va_end(copy);
+  char* s = alloc(size + 1);
+  if (size < (int)sizeof(stack)) {
+    memcpy(s, stack, size + 1);
+  } else {
+    vsnprintf(s, size + 1, format, args);
+  }
+  return s;
+}
+
+char* format_string(const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  char* s = aecor_vformat(malloc, format, args);
+  va_end(args);
+  return s;
+}
+
+// Scratch arena backing `scratch { ... }` blocks. Memory is handed out from a
+// list of chunks with a bump pointer, and everything allocated inside a block
+// is released at once when it ends by restoring the position saved on entry.
+// Chunks past the current one are kept around to be reused.
+#define AECOR_SCRATCH_CHUNK_SIZE (64 * 1024)
+
+typedef struct aecor_scratch_chunk {
+  struct aecor_scratch_chunk* next;
+  size_t capacity;
+  size_t used;
+  char data[];
+} aecor_scratch_chunk;
+
+typedef struct {
+  aecor_scratch_chunk* chunk;
+  size_t used;
+} aecor_scratch_mark;
+
+static aecor_scratch_chunk* aecor_scratch_first = NULL;
+static aecor_scratch_chunk* aecor_scratch_current = NULL;
+
+void* scratch_alloc(size_t size) {
+  size = (size + 15) & ~(size_t)15;
+  aecor_scratch_chunk* chunk = aecor_scratch_current;
+  if (!chunk || chunk->used + size > chunk->capacity) {
+    aecor_scratch_chunk** link = chunk ? &chunk->next : &aecor_scratch_first;
+    if (!*link || (*link)->capacity < size) {
+      size_t capacity = size > AECOR_SCRATCH_CHUNK_SIZE ? size : AECOR_SCRATCH_CHUNK_SIZE;
+      aecor_scratch_chunk* fresh = malloc(sizeof(aecor_scratch_chunk) + capacity);
+      if (!fresh) {
+        printf("Out of memory!\n");
+        exit(1);
+      }
+      fresh->capacity = capacity;
+      fresh->next = *link;
+      *link = fresh;
+    }
+    chunk = *link;
+    chunk->used = 0;
+    aecor_scratch_current = chunk;
+  }
+  void* ptr = chunk->data + chunk->used;
+  chunk->used += size;
+  return ptr;
+}
+
+aecor_scratch_mark aecor_scratch_save() {
+  aecor_scratch_chunk* chunk = aecor_scratch_current;
+  return (aecor_scratch_mark){chunk, chunk ? chunk->used : 0};
+}
+
+void aecor_scratch_restore(aecor_scratch_mark* mark) {
+  aecor_scratch_current = mark->chunk;
+  if (mark->chunk) mark->chunk->used = mark->used;
+}
+
+char* format_string_scratch(const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  char* s = aecor_vformat(scratch_alloc, format, args);
+  va_end(args);
+  return s;
+}
+
+// Output buffer for `print` / `println` when compiling with `-b`. Writes are
+// collected here and handed to stdio in large chunks, which avoids paying
+// for `printf`'s locking and format parsing on every call.
+#define AECOR_STDOUT_BUFFER_SIZE (64 * 1024)
+
+static char aecor_stdout_buffer[AECOR_STDOUT_BUFFER_SIZE];
+static size_t aecor_stdout_size = 0;
+
+void aecor_stdout_flush(void) {
+  fwrite(aecor_stdout_buffer, 1, aecor_stdout_size, stdout);
+  fflush(stdout);
+  aecor_stdout_size = 0;
+}
+
+__attribute__((constructor)) static void aecor_stdout_init(void) {
+  atexit(aecor_stdout_flush);
+}
+
+static inline void aecor_stdout_write(const char* s, size_t len) {
+  if (aecor_stdout_size + len > AECOR_STDOUT_BUFFER_SIZE) {
+    aecor_stdout_flush();
+    if (len > AECOR_STDOUT_BUFFER_SIZE) {
+      fwrite(s, 1, len, stdout);
+      return;
+    }
+  }
+  memcpy(aecor_stdout_buffer + aecor_stdout_size, s, len);
+  aecor_stdout_size += len;
+}
+
+void aecor_stdout_puts(const char* s) {
+  aecor_stdout_write(s, strlen(s));
+}
+
+void aecor_stdout_putc(char c) {
+  if (aecor_stdout_size == AECOR_STDOUT_BUFFER_SIZE) aecor_stdout_flush();
+  aecor_stdout_buffer[aecor_stdout_size++] = c;
+}
+
+void aecor_stdout_put_u64(u64 value) {
+  char digits[20];
+  int len = 0;
+  do {
+    digits[sizeof(digits) - ++len] = '0' + value % 10;
+    value /= 10;
+  } while (value);
+  aecor_stdout_write(digits + sizeof(digits) - len, len);
+}
+
+void aecor_stdout_put_i64(i64 value) {
+  if (value < 0) {
+    aecor_stdout_putc('-');
+    aecor_stdout_put_u64(-(u64)value);
+  } else {
+    aecor_stdout_put_u64(value);
+  }
+}
+
+// Used for anything that isn't a format string literal, as well as the
+// arguments with explicit format specs.
+int aecor_stdout_printf(const char* format, ...) {
+  char stack[256];
+  va_list args;
+  va_start(args, format);
+  int size = vsnprintf(stack, sizeof(stack), format, args);
+  va_end(args);
+  if (size < (int)sizeof(stack)) {
+    aecor_stdout_write(stack, size);
+  } else {
+    char* s = malloc(size + 1);
+    va_start(args, format);
+    vsnprintf(s, size + 1, format, args);
+    va_end(args);
+    aecor_stdout_write(s, size);
+    free(s);
+  }
+  return size;
+}
+
+void aecor_stdout_put_f64(f64 value) {
+  aecor_stdout_printf("%f", value);
+}
+
+void aecor_stdout_put_ptr(void* value) {
+  aecor_stdout_printf("%p", value);
+}
+
+// FNV-1a with a murmur3 finalizer, used for hashed dispatch on strings.
+// Must be kept in sync with `hash_string` in `compiler/utils.ae`.
+u32 aecor_hash_str(const char* s, u32 seed) {
+  u32 hash = seed;
+  for (; *s; s++) {
+    hash = (hash ^ (u8)*s) * 16777619u;
+  }
+  hash = (hash ^ (hash >> 16)) * 0x85ebca6bu;
+  hash = (hash ^ (hash >> 13)) * 0xc2b2ae35u;
+  return hash ^ (hash >> 16);
+}
+
+
+/* constants */
+
+/* struct declarations */
+typedef struct Vec Vec;
+typedef struct Vector Vector;
+typedef struct Image Image;
+typedef struct Ray Ray;
+typedef struct Sphere Sphere;
+
+struct Vec {
+  f32 x;
+  f32 y;
+  f32 z;
+};
+
+struct Vector {
+  i32 size;
+  i32 capacity;
+  void **data;
+};
+
+struct Image {
+  i32 width;
+  i32 height;
+  Vec *data;
+};
+
+struct Ray {
+  Vec ori;
+  Vec dir;
+};
+
+struct Sphere {
+  Vec center;
+  Vec color;
+  f32 radius;
+};
+
+/* function declarations */
+FILE *File__open(char *path, char *mode);
+bool File__exists(char *path);
+i32 File__size(FILE *this);
+char *File__slurp(FILE *this);
+i32 File__read(FILE *this, void *buf, i32 size);
+i32 File__write(FILE *this, void *buf, i32 size);
+void File__puts(FILE *this, char *str);
+__attribute__((noreturn)) void panic(char *msg);
+bool string__starts_with(char *this, char *prefix);
+bool string__ends_with(char *this, char *suffix);
+void string__remove_last_n(char *this, i32 n);
+bool string__eq(char *this, char *str2);
+char *string__substring(char *this, i32 start, i32 len);
+void string__strip_trailing_whitespace(char *this);
+i32 min(i32 a, i32 b);
+i32 max(i32 a, i32 b);
+f32 minf(f32 a, f32 b);
+f32 maxf(f32 a, f32 b);
+f32 clampf(f32 x, f32 min, f32 max);
+f32 clamp01(f32 x);
+f32 degrees(f32 radians);
+f32 radians(f32 degrees);
+void Vec__print(Vec this);
+Vec Vec__add(Vec this, Vec other);
+Vec Vec__addf(Vec this, f32 val);
+Vec Vec__sub(Vec this, Vec other);
+Vec Vec__subf(Vec this, f32 val);
+Vec Vec__mult(Vec this, Vec other);
+Vec Vec__multf(Vec this, f32 val);
+Vec Vec__div(Vec this, Vec other);
+Vec Vec__divf(Vec this, f32 val);
+f32 Vec__dot(Vec this, Vec other);
+Vec Vec__cross(Vec this, Vec other);
+f32 Vec__length(Vec this);
+f32 Vec__length_sq(Vec this);
+Vec Vec__normalized(Vec this);
+Vector *Vector__new_sized(i32 capacity);
+Vector *Vector__new(void);
+void Vector__resize(Vector *this, i32 new_capacity);
+void Vector__push(Vector *this, void *val);
+void Vector__push_front(Vector *this, void *val);
+void *Vector__pop(Vector *this);
+void *Vector__back(Vector *this);
+void *Vector__at(Vector *this, i32 i);
+bool Vector__empty(Vector *this);
+void Vector__free(Vector *this);
+Image *Image__new(i32 width, i32 height);
+void Image__free(Image *this);
+Vec Image__get(Image *this, i32 x, i32 y);
+void Image__set(Image *this, i32 x, i32 y, Vec col);
+void Image__save(Image *this, char *filename);
+Vec random_vec(void);
+Vec random_vec_unit(void);
+Vec Ray__at(Ray *this, f32 t);
+Sphere *Sphere__new(f32 x, f32 y, f32 z, f32 radius, f32 r, f32 g, f32 b);
+bool Sphere__hit(Sphere *this, Ray *ray, f32 *t, Vec *n, Vec *col);
+Vec background_color(Ray *ray);
+i32 find_hit(Ray *ray, Vector *objs, f32 *t, Vec *n, Vec *obj_col);
+Vec raytrace(Ray *ray, Vector *objs, i32 depth);
+i32 main(void);
+
+/* global variables */
+f32 TOL = 0.00001;
+
+FILE *File__open(char *path, char *mode) {
+  FILE *file = fopen(path, mode);
+  if ((!((bool)file))) {
+    printf("Error opening file '%s': %s""\n", path, strerror(errno));
+    exit(1);
+  } 
+  return file;
+}
+
+bool File__exists(char *path) {
+  FILE *file = fopen(path, "r");
+  if ((!((bool)file))) {
+    return false;
+  } 
+  fclose(file);
+  return true;
+}
+
+i32 File__size(FILE *this) {
+  i32 pos = ftell(this);
+  fseek(this, 0, SEEK_END);
+  i32 size = ftell(this);
+  fseek(this, pos, SEEK_SET);
+  return size;
+}
+
+char *File__slurp(FILE *this) {
+  i32 pos = ftell(this);
+  fseek(this, 0, SEEK_END);
+  i32 size = ftell(this);
+  fseek(this, pos, SEEK_SET);
+  void *buf = calloc((size + 1), sizeof(char));
+  fread(buf, 1, size, this);
+  fseek(this, pos, SEEK_SET);
+  return ((char *)buf);
+}
+
+i32 File__read(FILE *this, void *buf, i32 size) {
+  return fread(buf, 1, size, this);
+}
+
+i32 File__write(FILE *this, void *buf, i32 size) {
+  return fwrite(buf, 1, size, this);
+}
+
+void File__puts(FILE *this, char *str) {
+  fwrite(str, 1, strlen(str), this);
+}
+
+__attribute__((noreturn)) void panic(char *msg) {
+  printf("%s""\n", msg);
+  aecor_stdout_flush();
+  exit(1);
+}
+
+bool string__starts_with(char *this, char *prefix) {
+  i32 prefix_len = strlen(prefix);
+  if ((strlen(this) < prefix_len)) {
+    return false;
+  } 
+  return strncmp(this, prefix, prefix_len) == 0;
+}
+
+bool string__ends_with(char *this, char *suffix) {
+  i32 suffix_len = strlen(suffix);
+  if ((strlen(this) < suffix_len)) {
+    return false;
+  } 
+  return strncmp(this, suffix, suffix_len) == 0;
+}
+
+void string__remove_last_n(char *this, i32 n) {
+  this[(strlen(this) - n)] = '\0';
+}
+
+bool string__eq(char *this, char *str2) {
+  return strcmp(this, str2) == 0;
+}
+
+char *string__substring(char *this, i32 start, i32 len) {
+  char *new_str = ((char *)calloc((len + 1), sizeof(char)));
+  memcpy(new_str, (this + start), len);
+  return new_str;
+}
+
+void string__strip_trailing_whitespace(char *this) {
+  for (i32 i = (strlen(this) - 1); (i >= 0); i -= 1) {
+    if ((this[i] != ' ')) 
+    break;
+    
+    this[i] = '\0';
+  } 
+}
+
+i32 min(i32 a, i32 b) {
+  return ((a < b) ? a : b);
+}
+
+i32 max(i32 a, i32 b) {
+  return ((a > b) ? a : b);
+}
+
+f32 minf(f32 a, f32 b) {
+  if ((a < b)) 
+  return a;
+   else 
+  return b;
+  
+}
+
+f32 maxf(f32 a, f32 b) {
+  if ((a > b)) 
+  return a;
+   else 
+  return b;
+  
+}
+
+f32 clampf(f32 x, f32 min, f32 max) {
+  return maxf(minf(x, max), min);
+}
+
+f32 clamp01(f32 x) {
+  return clampf(x, 0.0, 1.0);
+}
+
+f32 degrees(f32 radians) {
+  return ((radians * 180.0) / M_PI);
+}
+
+f32 radians(f32 degrees) {
+  return ((degrees * M_PI) / 180.0);
+}
+
+void Vec__print(Vec this) {
+  printf("%f %f %f\n""\n", this.x, this.y, this.z);
+}
+
+Vec Vec__add(Vec this, Vec other) {
+  return (Vec){(this.x + other.x), (this.y + other.y), (this.z + other.z)};
+}
+
+Vec Vec__addf(Vec this, f32 val) {
+  return (Vec){(this.x + val), (this.y + val), (this.z + val)};
+}
+
+Vec Vec__sub(Vec this, Vec other) {
+  return (Vec){(this.x - other.x), (this.y - other.y), (this.z - other.z)};
+}
+
+Vec Vec__subf(Vec this, f32 val) {
+  return (Vec){(this.x - val), (this.y - val), (this.z - val)};
+}
+
+Vec Vec__mult(Vec this, Vec other) {
+  return (Vec){(this.x * other.x), (this.y * other.y), (this.z * other.z)};
+}
+
+Vec Vec__multf(Vec this, f32 val) {
+  return (Vec){(this.x * val), (this.y * val), (this.z * val)};
+}
+
+Vec Vec__div(Vec this, Vec other) {
+  return (Vec){(this.x / other.x), (this.y / other.y), (this.z / other.z)};
+}
+
+Vec Vec__divf(Vec this, f32 val) {
+  return (Vec){(this.x / val), (this.y / val), (this.z / val)};
+}
+
+f32 Vec__dot(Vec this, Vec other) {
+  return (((this.x * other.x) + (this.y * other.y)) + (this.z * other.z));
+}
+
+Vec Vec__cross(Vec this, Vec other) {
+  return (Vec){((this.y * other.z) - (this.z * other.y)), ((this.z * other.x) - (this.x * other.z)), ((this.x * other.y) - (this.y * other.x))};
+}
+
+f32 Vec__length(Vec this) {
+  return sqrt((((this.x * this.x) + (this.y * this.y)) + (this.z * this.z)));
+}
+
+f32 Vec__length_sq(Vec this) {
+  return (((this.x * this.x) + (this.y * this.y)) + (this.z * this.z));
+}
+
+Vec Vec__normalized(Vec this) {
+  return Vec__divf(this, Vec__length(this));
+}
+
+Vector *Vector__new_sized(i32 capacity) {
+  Vector *vec = ((Vector *)calloc(1, sizeof(Vector)));
+  vec->size = 0;
+  vec->capacity = capacity;
+  vec->data = ((void **)calloc(vec->capacity, sizeof(void *)));
+  return vec;
+}
+
+Vector *Vector__new(void) {
+  return Vector__new_sized(16);
+}
+
+void Vector__resize(Vector *this, i32 new_capacity) {
+  this->capacity = new_capacity;
+  this->data = ((void **)realloc(this->data, (this->capacity * sizeof(void *))));
+}
+
+void Vector__push(Vector *this, void *val) {
+  if (this->size == this->capacity) {
+    Vector__resize(this, (this->capacity * 2));
+  } 
+  this->data[this->size] = val;
+  this->size += 1;
+}
+
+void Vector__push_front(Vector *this, void *val) {
+  if (this->size == this->capacity) {
+    Vector__resize(this, (this->capacity * 2));
+  } 
+  for (i32 i = this->size; (i > 0); i -= 1) {
+    this->data[i] = this->data[(i - 1)];
+  } 
+  this->data[0] = val;
+  this->size += 1;
+}
+
+void *Vector__pop(Vector *this) {
+  ((void)0);
+  this->size -= 1;
+  return this->data[this->size];
+}
+
+void *Vector__back(Vector *this) {
+  ((void)0);
+  return this->data[(this->size - 1)];
+}
+
+void *Vector__at(Vector *this, i32 i) {
+  ((void)0);
+  return this->data[i];
+}
+
+bool Vector__empty(Vector *this) {
+  return this->size == 0;
+}
+
+void Vector__free(Vector *this) {
+  free(this->data);
+  free(this);
+}
+
+Image *Image__new(i32 width, i32 height) {
+  Image *img = ((Image *)calloc(1, sizeof(Image)));
+  (*img) = (Image){width, height, calloc((width * height), sizeof(Vec))};
+  return img;
+}
+
+void Image__free(Image *this) {
+  free(this->data);
+  free(this);
+}
+
+Vec Image__get(Image *this, i32 x, i32 y) {
+  return this->data[((y * this->width) + x)];
+}
+
+void Image__set(Image *this, i32 x, i32 y, Vec col) {
+  this->data[((y * this->width) + x)] = col;
+}
+
+void Image__save(Image *this, char *filename) {
+  FILE *file = File__open(filename, "wb");
+  ;
+  u8 *u8buf = ((u8 *)calloc(1, (((this->width * this->height) * 3) * sizeof(u8))));
+  ;
+  for (i32 i = 0; (i < (this->width * this->height)); i += 1) {
+    Vec col = (*(this->data + i));
+    u8 *offset = (u8buf + (i * 3));
+    (*(offset + 0)) = ((u8)(clamp01(col.x) * 255.0));
+    (*(offset + 1)) = ((u8)(clamp01(col.y) * 255.0));
+    (*(offset + 2)) = ((u8)(clamp01(col.z) * 255.0));
+  } 
+  char *header = format_string("P6 %d %d 255\n", this->width, this->height);
+  File__write(file, header, strlen(header));
+  File__write(file, u8buf, ((3 * this->width) * this->height));
+
+  /* defers */
+  free(u8buf);
+  fclose(file);
+}
+
+Vec random_vec(void) {
+  return Vec__subf(Vec__multf((Vec){drand48(), drand48(), drand48()}, 2.0), 1.0);
+}
+
+Vec random_vec_unit(void) {
+  while (true) {
+    Vec vec = random_vec();
+    if ((Vec__length_sq(vec) < 1.0)) {
+      return Vec__normalized(vec);
+    } 
+  } 
+  return (Vec){0.0, 0.0, 0.0};
+}
+
+Vec Ray__at(Ray *this, f32 t) {
+  return Vec__add(Vec__multf(this->dir, t), this->ori);
+}
+
+Sphere *Sphere__new(f32 x, f32 y, f32 z, f32 radius, f32 r, f32 g, f32 b) {
+  Sphere *s = ((Sphere *)malloc(sizeof(Sphere)));
+  (*s) = (Sphere){.center = (Vec){x, y, z}, .color = (Vec){r, g, b}, radius};
+  return s;
+}
+
+bool Sphere__hit(Sphere *this, Ray *ray, f32 *t, Vec *n, Vec *col) {
+  Vec oc = Vec__sub(ray->ori, this->center);
+  f32 a = Vec__dot(ray->dir, ray->dir);
+  f32 b = (2.0 * Vec__dot(oc, ray->dir));
+  f32 c = (Vec__dot(oc, oc) - (this->radius * this->radius));
+  f32 disc = ((b * b) - ((4.0 * a) * c));
+  if ((disc < 0.0)) 
+  return false;
+  
+  f32 t0 = (((-b) - sqrt(disc)) / (2.0 * a));
+  f32 t1 = (((-b) + sqrt(disc)) / (2.0 * a));
+  f32 best = t0;
+  if ((best < TOL)) 
+  best = t1;
+  
+  if ((best < TOL)) 
+  return false;
+  
+  (*t) = best;
+  (*col) = this->color;
+  (*n) = Vec__normalized(Vec__sub(Ray__at(ray, best), this->center));
+  return true;
+}
+
+Vec background_color(Ray *ray) {
+  f32 t = (0.5 * (ray->dir.y + 1.0));
+  Vec col2 = Vec__multf((Vec){1.0, 1.0, 1.0}, (1.0 - t));
+  Vec res = (Vec){0.5, 0.7, 1.0};
+  return Vec__add(Vec__multf(res, t), col2);
+}
+
+i32 find_hit(Ray *ray, Vector *objs, f32 *t, Vec *n, Vec *obj_col) {
+  i32 idx = (-1);
+  for (i32 i = 0; (i < objs->size); i += 1) {
+    Sphere *obj = ((Sphere *)Vector__at(objs, i));
+    f32 tmp_t;
+    Vec tmp_n = {0};
+    Vec tmp_col = {0};
+    if (Sphere__hit(obj, ray, (&tmp_t), (&tmp_n), (&tmp_col))) {
+      if ((((*t) < 0.0) || (tmp_t < (*t)))) {
+        (*t) = tmp_t;
+        idx = i;
+        (*obj_col) = tmp_col;
+        (*n) = tmp_n;
+      } 
+    } 
+  } 
+  return idx;
+}
+
+Vec raytrace(Ray *ray, Vector *objs, i32 depth) {
+  if ((depth < 0)) 
+  return (Vec){0.0, 0.0, 0.0};
+  
+  f32 t = (-1.0);
+  Vec n = {0};
+  Vec obj_col = {0};
+  if ((find_hit(ray, objs, (&t), (&n), (&obj_col)) < 0)) 
+  return background_color(ray);
+  
+  ray->ori = Ray__at(ray, t);
+  ray->dir = Vec__add(random_vec_unit(), n);
+  Vec rec_col = raytrace(ray, objs, (depth - 1));
+  return Vec__mult(rec_col, obj_col);
+}
+
+i32 main(void) {
+  Vector *objs = Vector__new();
+  Vector__push(objs, Sphere__new(0.0, 0.0, (-1.0), 0.5, 1.0, 0.6, 0.3));
+  Vector__push(objs, Sphere__new(0.0, (-100.5), (-1.0), 100.0, 0.5, 0.5, 0.5));
+  f32 aspect_ratio = (16.0 / 9.0);
+  i32 image_width = 800;
+  i32 image_height = ((i32)(((f32)image_width) / aspect_ratio));
+  i32 samples_per_pixel = 100;
+  f32 viewport_height = 2.0;
+  f32 viewport_width = (aspect_ratio * viewport_height);
+  f32 focal_length = 1.0;
+  Vec origin = (Vec){0.0, 0.0, 0.0};
+  Vec horizontal = (Vec){viewport_width, 0.0, 0.0};
+  Vec vertical = (Vec){0.0, viewport_height, 0.0};
+  Vec ll_corner = Vec__sub(Vec__sub(Vec__sub(origin, Vec__divf(horizontal, 2.0)), Vec__divf(vertical, 2.0)), (Vec){0.0, 0.0, focal_length});
+  Image *img = Image__new(image_width, image_height);
+  ;
+  f32 div_factor = (1.0 / ((f32)samples_per_pixel));
+  for (i32 y = 0; (y < image_height); y += 1) {
+    printf("\r%d / %d done", y, image_height);
+    for (i32 x = 0; (x < image_width); x += 1) {
+      Vec total_col = (Vec){0.0, 0.0, 0.0};
+      for (i32 s = 0; (s < samples_per_pixel); s += 1) {
+        f32 u = ((drand48() + ((f32)x)) / ((f32)(image_width - 1)));
+        f32 v = (1.0 - ((drand48() + ((f32)y)) / ((f32)(image_height - 1))));
+        Ray ray = {0};
+        ray.ori = origin;
+        ray.dir = Vec__normalized(Vec__sub(Vec__add(Vec__add(ll_corner, Vec__multf(horizontal, u)), Vec__multf(vertical, v)), origin));
+        Vec color = raytrace((&ray), objs, 5);
+        total_col = Vec__add(total_col, color);
+      } 
+      Image__set(img, x, y, Vec__multf(total_col, div_factor));
+    } 
+  } 
+  printf("""\n");
+  Image__save(img, "out.ppm");
+
+  /* defers */
+  Image__free(img);
+}
+
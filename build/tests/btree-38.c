@@ -0,0 +1,1518 @@
+#include "stdio.h"
+#include "stdlib.h"
+#include "stdbool.h"
+#include "stdint.h"
+#include "string.h"
+#include "errno.h"
+#include "ctype.h"
+
+/***************** embed './lib/prelude.h' *****************/
+#include "stdarg.h"
+
+typedef int8_t i8;
+typedef int16_t i16;
+typedef int32_t i32;
+typedef int64_t i64;
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+
+typedef float f32;
+typedef double f64;
+
+// SIMD vector types, such as `f32x4`, using GCC's vector extensions
+#define AECOR_SIMD_TYPE(T, lanes) \
+  typedef T aecor_##T##x##lanes __attribute__((vector_size(sizeof(T) * lanes)));
+#define AECOR_SIMD_TYPES(T) \
+  AECOR_SIMD_TYPE(T, 2) AECOR_SIMD_TYPE(T, 4) AECOR_SIMD_TYPE(T, 8) \
+  AECOR_SIMD_TYPE(T, 16) AECOR_SIMD_TYPE(T, 32) AECOR_SIMD_TYPE(T, 64)
+
+AECOR_SIMD_TYPES(i8) AECOR_SIMD_TYPES(i16) AECOR_SIMD_TYPES(i32) AECOR_SIMD_TYPES(i64)
+AECOR_SIMD_TYPES(u8) AECOR_SIMD_TYPES(u16) AECOR_SIMD_TYPES(u32) AECOR_SIMD_TYPES(u64)
+AECOR_SIMD_TYPES(f32) AECOR_SIMD_TYPES(f64)
+
+#ifdef AECOR_TRACK_ALLOC
+// Allocation tracking for `--track-alloc`. Calls to `malloc`, `calloc`,
+// `realloc`, `free` and `strdup` in aecor code go through the functions
+// below, each with a static `aecor_alloc_site` for the call site. Live
+// blocks are kept in a side table keyed by pointer, so `free` still works
+// on memory allocated by C code, which is just not counted.
+//
+// Like `--instrument`, this is not synchronized between threads.
+typedef struct aecor_alloc_site {
+  const char* location;
+  u64 allocs;
+  u64 bytes;
+  u64 live;
+  u64 live_bytes;
+  struct aecor_alloc_site* next;
+} aecor_alloc_site;
+
+typedef struct {
+  void* ptr;
+  size_t size;
+  aecor_alloc_site* site;
+} aecor_alloc_block;
+
+static aecor_alloc_site* aecor_alloc_sites = NULL;
+static aecor_alloc_block* aecor_alloc_blocks = NULL;
+static size_t aecor_alloc_capacity = 0;  // Always a power of two
+static size_t aecor_alloc_count = 0;
+static u64 aecor_alloc_live_bytes = 0;
+static u64 aecor_alloc_peak_bytes = 0;
+
+// Site of the format string being built, set by the generated code
+static aecor_alloc_site aecor_alloc_unknown_format = {"<format string>"};
+static aecor_alloc_site* aecor_alloc_format_site = &aecor_alloc_unknown_format;
+
+static inline size_t aecor_alloc_slot(void* ptr) {
+  return ((uintptr_t)ptr >> 4) * 0x9e3779b97f4a7c15ull & (aecor_alloc_capacity - 1);
+}
+
+static void aecor_alloc_insert(aecor_alloc_block block) {
+  if ((aecor_alloc_count + 1) * 2 > aecor_alloc_capacity) {
+    aecor_alloc_block* old = aecor_alloc_blocks;
+    size_t old_capacity = aecor_alloc_capacity;
+    aecor_alloc_capacity = old_capacity ? old_capacity * 2 : 1024;
+    aecor_alloc_blocks = calloc(aecor_alloc_capacity, sizeof(aecor_alloc_block));
+    aecor_alloc_count = 0;
+    for (size_t i = 0; i < old_capacity; i++) {
+      if (old[i].ptr) aecor_alloc_insert(old[i]);
+    }
+    free(old);
+  }
+  size_t i = aecor_alloc_slot(block.ptr);
+  while (aecor_alloc_blocks[i].ptr) i = (i + 1) & (aecor_alloc_capacity - 1);
+  aecor_alloc_blocks[i] = block;
+  aecor_alloc_count++;
+}
+
+// Removes the block for `ptr` using backward-shift deletion, returning
+// false if it wasn't allocated by tracked code.
+static bool aecor_alloc_remove(void* ptr, aecor_alloc_block* out) {
+  if (!aecor_alloc_capacity) return false;
+  size_t mask = aecor_alloc_capacity - 1;
+  size_t i = aecor_alloc_slot(ptr);
+  while (aecor_alloc_blocks[i].ptr != ptr) {
+    if (!aecor_alloc_blocks[i].ptr) return false;
+    i = (i + 1) & mask;
+  }
+  *out = aecor_alloc_blocks[i];
+  for (size_t j = (i + 1) & mask; aecor_alloc_blocks[j].ptr; j = (j + 1) & mask) {
+    size_t home = aecor_alloc_slot(aecor_alloc_blocks[j].ptr);
+    // Move the entry into the hole unless its home slot is after the hole
+    if (((j - home) & mask) >= ((j - i) & mask)) {
+      aecor_alloc_blocks[i] = aecor_alloc_blocks[j];
+      i = j;
+    }
+  }
+  aecor_alloc_blocks[i].ptr = NULL;
+  aecor_alloc_count--;
+  return true;
+}
+
+static void aecor_alloc_record(void* ptr, size_t size, aecor_alloc_site* site) {
+  if (!ptr) return;
+  if (!site->allocs) {
+    site->next = aecor_alloc_sites;
+    aecor_alloc_sites = site;
+  }
+  site->allocs++;
+  site->bytes += size;
+  site->live++;
+  site->live_bytes += size;
+  aecor_alloc_live_bytes += size;
+  if (aecor_alloc_live_bytes > aecor_alloc_peak_bytes) {
+    aecor_alloc_peak_bytes = aecor_alloc_live_bytes;
+  }
+  aecor_alloc_insert((aecor_alloc_block){ptr, size, site});
+}
+
+static void aecor_alloc_forget(void* ptr) {
+  aecor_alloc_block block;
+  if (!ptr || !aecor_alloc_remove(ptr, &block)) return;
+  block.site->live--;
+  block.site->live_bytes -= block.size;
+  aecor_alloc_live_bytes -= block.size;
+}
+
+void* aecor_track_malloc(size_t size, aecor_alloc_site* site) {
+  void* ptr = malloc(size);
+  aecor_alloc_record(ptr, size, site);
+  return ptr;
+}
+
+void* aecor_track_calloc(size_t count, size_t size, aecor_alloc_site* site) {
+  void* ptr = calloc(count, size);
+  aecor_alloc_record(ptr, count * size, site);
+  return ptr;
+}
+
+void* aecor_track_realloc(void* old, size_t size, aecor_alloc_site* site) {
+  void* ptr = realloc(old, size);
+  if (!ptr && size) return ptr;
+  aecor_alloc_forget(old);
+  aecor_alloc_record(ptr, size, site);
+  return ptr;
+}
+
+char* aecor_track_strdup(const char* s, aecor_alloc_site* site) {
+  char* copy = strdup(s);
+  aecor_alloc_record(copy, strlen(s) + 1, site);
+  return copy;
+}
+
+void aecor_track_free(void* ptr) {
+  aecor_alloc_forget(ptr);
+  free(ptr);
+}
+
+static void* aecor_track_format_alloc(size_t size) {
+  aecor_alloc_site* site = aecor_alloc_format_site;
+  aecor_alloc_format_site = &aecor_alloc_unknown_format;
+  return aecor_track_malloc(size, site);
+}
+
+// Ties are broken by location, so reports from different runs can be diffed
+static int aecor_alloc_compare_bytes(const void* a, const void* b) {
+  aecor_alloc_site* sa = *(aecor_alloc_site**)a;
+  aecor_alloc_site* sb = *(aecor_alloc_site**)b;
+  if (sa->bytes != sb->bytes) return sa->bytes < sb->bytes ? 1 : -1;
+  return strcmp(sa->location, sb->location);
+}
+
+static int aecor_alloc_compare_live(const void* a, const void* b) {
+  aecor_alloc_site* sa = *(aecor_alloc_site**)a;
+  aecor_alloc_site* sb = *(aecor_alloc_site**)b;
+  if (sa->live_bytes != sb->live_bytes) return sa->live_bytes < sb->live_bytes ? 1 : -1;
+  return strcmp(sa->location, sb->location);
+}
+
+// Writes the sites that allocated the most bytes, followed by the ones
+// with memory that was never freed.
+static void aecor_alloc_report(void) {
+  const char* path = getenv("AECOR_ALLOC_REPORT");
+  if (!path) path = "aecor_alloc.txt";
+  FILE* file = fopen(path, "w");
+  if (!file) {
+    fprintf(stderr, "Could not write allocation report to %s\n", path);
+    return;
+  }
+
+  size_t count = 0;
+  u64 allocs = 0, bytes = 0, live = 0;
+  for (aecor_alloc_site* site = aecor_alloc_sites; site; site = site->next) {
+    count++;
+    allocs += site->allocs;
+    bytes += site->bytes;
+    live += site->live;
+  }
+  aecor_alloc_site** sites = malloc((count + 1) * sizeof(aecor_alloc_site*));
+  size_t n = 0;
+  for (aecor_alloc_site* site = aecor_alloc_sites; site; site = site->next) sites[n++] = site;
+
+  fprintf(file, "# %llu allocations, %llu bytes, peak %llu bytes live\n",
+          (unsigned long long)allocs, (unsigned long long)bytes,
+          (unsigned long long)aecor_alloc_peak_bytes);
+  fprintf(file, "# %llu blocks, %llu bytes never freed\n",
+          (unsigned long long)live, (unsigned long long)aecor_alloc_live_bytes);
+
+  const char* header = "# %12s %14s %12s %14s  %s\n";
+  const char* row = "%14llu %14llu %12llu %14llu  %s\n";
+  fprintf(file, "\n# Top allocators\n");
+  fprintf(file, header, "allocs", "bytes", "live", "live_bytes", "site");
+  qsort(sites, n, sizeof(aecor_alloc_site*), aecor_alloc_compare_bytes);
+  for (size_t i = 0; i < n; i++) {
+    aecor_alloc_site* site = sites[i];
+    fprintf(file, row, (unsigned long long)site->allocs, (unsigned long long)site->bytes,
+            (unsigned long long)site->live, (unsigned long long)site->live_bytes, site->location);
+  }
+
+  fprintf(file, "\n# Leaks\n");
+  fprintf(file, header, "allocs", "bytes", "live", "live_bytes", "site");
+  qsort(sites, n, sizeof(aecor_alloc_site*), aecor_alloc_compare_live);
+  for (size_t i = 0; i < n && sites[i]->live; i++) {
+    aecor_alloc_site* site = sites[i];
+    fprintf(file, row, (unsigned long long)site->allocs, (unsigned long long)site->bytes,
+            (unsigned long long)site->live, (unsigned long long)site->live_bytes, site->location);
+  }
+  free(sites);
+  fclose(file);
+}
+
+__attribute__((constructor)) static void aecor_alloc_init(void) {
+  atexit(aecor_alloc_report);
+}
+
+#define AECOR_FORMAT_ALLOC aecor_track_format_alloc
+#else
+#define AECOR_FORMAT_ALLOC malloc
+#endif
+
+// Formats into `stack` if the result fits in `capacity` bytes, otherwise
+// returns a new heap-allocated string that the caller needs to free.
+char* format_string_into(char* stack, int capacity, const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  int size = vsnprintf(stack, capacity, format, args);
+  va_end(args);
+  if (size < capacity) return stack;
+  char* s = malloc(size + 1);
+  va_start(args, format);
+  vsnprintf(s, size + 1, format, args);
+  va_end(args);
+  return s;
+}
+
+// Formats into a stack buffer first since most formatted strings are short,
+// which saves a separate pass just to compute the size.
+static char* aecor_vformat(void* (*alloc)(size_t), const char* format, va_list args) {
+  char stack[256];
+  va_list copy;
+  va_copy(copy, args);
+  int size = vsnprintf(stack, sizeof(stack), format, copy);
+  va_end(copy);
+  char* s = alloc(size + 1);
+  if (size < (int)sizeof(stack)) {
+    memcpy(s, stack, size + 1);
+  } else {
+    vsnprintf(s, size + 1, format, args);
+  }
+  return s;
+}
+
+char* format_string(const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  char* s = aecor_vformat(AECOR_FORMAT_ALLOC, format, args);
+  va_end(args);
+  return s;
+}
+
+// Scratch arena backing `scratch { ... }` blocks. Memory is handed out from a
+// list of chunks with a bump pointer, and everything allocated inside a block
+// is released at once when it ends by restoring the position saved on entry.
+// Chunks past the current one are kept around to be reused. Each thread has
+// its own arena.
+//
+// Format strings built inside a block come from the arena as well, so they
+// must not be passed to `free` or to anything that frees them, such as
+// `Buffer::putsf`, and must be copied to outlive the block.
+#define AECOR_SCRATCH_CHUNK_SIZE (64 * 1024)
+
+typedef struct aecor_scratch_chunk {
+  struct aecor_scratch_chunk* next;
+  size_t capacity;
+  size_t used;
+  char data[];
+} aecor_scratch_chunk;
+
+typedef struct {
+  aecor_scratch_chunk* chunk;
+  size_t used;
+} aecor_scratch_mark;
+
+static __thread aecor_scratch_chunk* aecor_scratch_first = NULL;
+static __thread aecor_scratch_chunk* aecor_scratch_current = NULL;
+
+void* scratch_alloc(size_t size) {
+  size = (size + 15) & ~(size_t)15;
+  aecor_scratch_chunk* chunk = aecor_scratch_current;
+  if (!chunk || chunk->used + size > chunk->capacity) {
+    aecor_scratch_chunk** link = chunk ? &chunk->next : &aecor_scratch_first;
+    if (!*link || (*link)->capacity < size) {
+      size_t capacity = size > AECOR_SCRATCH_CHUNK_SIZE ? size : AECOR_SCRATCH_CHUNK_SIZE;
+      aecor_scratch_chunk* fresh = malloc(sizeof(aecor_scratch_chunk) + capacity);
+      if (!fresh) {
+        printf("Out of memory!\n");
+        exit(1);
+      }
+      fresh->capacity = capacity;
+      fresh->next = *link;
+      *link = fresh;
+    }
+    chunk = *link;
+    chunk->used = 0;
+    aecor_scratch_current = chunk;
+  }
+  void* ptr = chunk->data + chunk->used;
+  chunk->used += size;
+  return ptr;
+}
+
+aecor_scratch_mark aecor_scratch_save() {
+  aecor_scratch_chunk* chunk = aecor_scratch_current;
+  return (aecor_scratch_mark){chunk, chunk ? chunk->used : 0};
+}
+
+void aecor_scratch_restore(aecor_scratch_mark* mark) {
+  aecor_scratch_current = mark->chunk;
+  if (mark->chunk) mark->chunk->used = mark->used;
+}
+
+char* format_string_scratch(const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  char* s = aecor_vformat(scratch_alloc, format, args);
+  va_end(args);
+  return s;
+}
+
+// Output buffer for `print` / `println` when compiling with `-b`. Writes are
+// collected here and handed to stdio in large chunks, which avoids paying
+// for `printf`'s locking and format parsing on every call.
+//
+// Once a second thread has been started (see `Thread::spawn`), the buffer is
+// guarded by a spinlock. It is only held for a `memcpy` or a flush, once per
+// `print`, and single-threaded programs don't pay for it at all.
+#define AECOR_STDOUT_BUFFER_SIZE (64 * 1024)
+
+static char aecor_stdout_buffer[AECOR_STDOUT_BUFFER_SIZE];
+static size_t aecor_stdout_size = 0;
+static char aecor_stdout_locked = 0;
+
+// Set before the first thread is created, so that thread sees it too
+bool aecor_multithreaded = false;
+
+static inline void aecor_stdout_lock(void) {
+  if (!aecor_multithreaded) return;
+  while (__atomic_test_and_set(&aecor_stdout_locked, __ATOMIC_ACQUIRE)) {
+    while (__atomic_load_n(&aecor_stdout_locked, __ATOMIC_RELAXED)) {}
+  }
+}
+
+static inline void aecor_stdout_unlock(void) {
+  if (!aecor_multithreaded) return;
+  __atomic_clear(&aecor_stdout_locked, __ATOMIC_RELEASE);
+}
+
+// Must be called with the lock held
+static void aecor_stdout_flush_locked(void) {
+  fwrite(aecor_stdout_buffer, 1, aecor_stdout_size, stdout);
+  fflush(stdout);
+  aecor_stdout_size = 0;
+}
+
+void aecor_stdout_flush(void) {
+  aecor_stdout_lock();
+  aecor_stdout_flush_locked();
+  aecor_stdout_unlock();
+}
+
+__attribute__((constructor)) static void aecor_stdout_init(void) {
+  atexit(aecor_stdout_flush);
+}
+
+static inline void aecor_stdout_write(const char* s, size_t len) {
+  aecor_stdout_lock();
+  if (aecor_stdout_size + len > AECOR_STDOUT_BUFFER_SIZE) {
+    aecor_stdout_flush_locked();
+    if (len > AECOR_STDOUT_BUFFER_SIZE) {
+      fwrite(s, 1, len, stdout);
+      aecor_stdout_unlock();
+      return;
+    }
+  }
+  memcpy(aecor_stdout_buffer + aecor_stdout_size, s, len);
+  aecor_stdout_size += len;
+  aecor_stdout_unlock();
+}
+
+// The pieces of one `print` with a format string are collected in a line on
+// the stack and added to the buffer at once, so lines printed by different
+// threads never interleave. Arguments are evaluated outside the lock, so
+// they can print too.
+typedef struct {
+  char* data;
+  size_t size;
+  size_t capacity;
+  char stack[256];
+} aecor_stdout_line;
+
+static inline void aecor_stdout_line_init(aecor_stdout_line* line) {
+  line->data = line->stack;
+  line->size = 0;
+  line->capacity = sizeof(line->stack);
+}
+
+static void aecor_stdout_line_grow(aecor_stdout_line* line, size_t min_capacity) {
+  size_t capacity = line->capacity * 2;
+  if (capacity < min_capacity) capacity = min_capacity;
+  if (line->data == line->stack) {
+    line->data = malloc(capacity);
+    memcpy(line->data, line->stack, line->size);
+  } else {
+    line->data = realloc(line->data, capacity);
+  }
+  line->capacity = capacity;
+}
+
+static inline void aecor_stdout_write_line(aecor_stdout_line* line, const char* s, size_t len) {
+  if (line->size + len > line->capacity) aecor_stdout_line_grow(line, line->size + len);
+  memcpy(line->data + line->size, s, len);
+  line->size += len;
+}
+
+void aecor_stdout_line_finish(aecor_stdout_line* line) {
+  aecor_stdout_write(line->data, line->size);
+  if (line->data != line->stack) free(line->data);
+}
+
+void aecor_stdout_puts(aecor_stdout_line* line, const char* s) {
+  aecor_stdout_write_line(line, s, strlen(s));
+}
+
+// Prints "(null)" for a null string, like `printf` does
+void aecor_stdout_put_str(aecor_stdout_line* line, const char* s) {
+  aecor_stdout_puts(line, s ? s : "(null)");
+}
+
+static inline void aecor_stdout_putc(aecor_stdout_line* line, char c) {
+  if (line->size == line->capacity) aecor_stdout_line_grow(line, line->size + 1);
+  line->data[line->size++] = c;
+}
+
+void aecor_stdout_put_u64(aecor_stdout_line* line, u64 value) {
+  char digits[20];
+  int len = 0;
+  do {
+    digits[sizeof(digits) - ++len] = '0' + value % 10;
+    value /= 10;
+  } while (value);
+  aecor_stdout_write_line(line, digits + sizeof(digits) - len, len);
+}
+
+void aecor_stdout_put_i64(aecor_stdout_line* line, i64 value) {
+  if (value < 0) {
+    aecor_stdout_putc(line, '-');
+    aecor_stdout_put_u64(line, -(u64)value);
+  } else {
+    aecor_stdout_put_u64(line, value);
+  }
+}
+
+void aecor_stdout_put_f64(aecor_stdout_line* line, f64 value) {
+  char stack[64];
+  char* s = format_string_into(stack, sizeof(stack), "%f", value);
+  aecor_stdout_puts(line, s);
+  if (s != stack) free(s);
+}
+
+void aecor_stdout_put_ptr(aecor_stdout_line* line, void* value) {
+  char stack[32];
+  aecor_stdout_puts(line, format_string_into(stack, sizeof(stack), "%p", value));
+}
+
+// Used for anything that isn't a format string literal, which is printed
+// with a single write.
+int aecor_stdout_printf(const char* format, ...) {
+  char stack[256];
+  va_list args;
+  va_start(args, format);
+  int size = vsnprintf(stack, sizeof(stack), format, args);
+  va_end(args);
+  if (size < (int)sizeof(stack)) {
+    aecor_stdout_write(stack, size);
+  } else {
+    char* s = malloc(size + 1);
+    va_start(args, format);
+    vsnprintf(s, size + 1, format, args);
+    va_end(args);
+    aecor_stdout_write(s, size);
+    free(s);
+  }
+  return size;
+}
+
+// FNV-1a with a murmur3 finalizer, used for hashed dispatch on strings.
+// Must be kept in sync with `hash_string` in `compiler/utils.ae`.
+u32 aecor_hash_str(const char* s, u32 seed) {
+  u32 hash = seed;
+  for (; *s; s++) {
+    hash = (hash ^ (u8)*s) * 16777619u;
+  }
+  hash = (hash ^ (hash >> 16)) * 0x85ebca6bu;
+  hash = (hash ^ (hash >> 13)) * 0xc2b2ae35u;
+  return hash ^ (hash >> 16);
+}
+
+#ifdef AECOR_INSTRUMENT
+#include <time.h>
+
+// Per-function profiling for `--instrument`. Every instrumented function
+// pushes a frame on entry, which is popped by a `cleanup` handler whenever
+// the function returns. Time spent in instrumented callees is subtracted
+// from the caller's exclusive time. Recursive calls only count towards
+// inclusive time once, for the outermost call.
+//
+// Counters are not synchronized, so this is only accurate for programs
+// that call instrumented functions from a single thread.
+typedef struct {
+  const char* name;
+  const char* location;
+  u64 calls;
+  u64 inclusive_ns;
+  u64 exclusive_ns;
+  u32 active;
+} aecor_prof_entry;
+
+typedef struct aecor_prof_frame {
+  aecor_prof_entry* entry;
+  struct aecor_prof_frame* parent;
+  u64 start;
+  u64 children;
+} aecor_prof_frame;
+
+// Defined at the end of the generated code, one entry per function
+extern aecor_prof_entry aecor_prof_table[];
+extern u32 aecor_prof_count;
+
+static __thread aecor_prof_frame* aecor_prof_current = NULL;
+
+static inline u64 aecor_prof_now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (u64)ts.tv_sec * 1000000000ull + (u64)ts.tv_nsec;
+}
+
+static inline void aecor_prof_enter(aecor_prof_frame* frame, u32 id) {
+  frame->entry = &aecor_prof_table[id];
+  frame->entry->calls++;
+  frame->entry->active++;
+  frame->parent = aecor_prof_current;
+  frame->children = 0;
+  aecor_prof_current = frame;
+  frame->start = aecor_prof_now();
+}
+
+static inline void aecor_prof_exit(aecor_prof_frame* frame) {
+  u64 elapsed = aecor_prof_now() - frame->start;
+  aecor_prof_entry* entry = frame->entry;
+  entry->active--;
+  if (entry->active == 0) entry->inclusive_ns += elapsed;
+  entry->exclusive_ns += elapsed - frame->children;
+  if (frame->parent) frame->parent->children += elapsed;
+  aecor_prof_current = frame->parent;
+}
+
+// Writes one line per function that was called, in declaration order so
+// that reports from different runs can be diffed directly. The output is
+// whitespace separated for `sort -k`, e.g. `sort -k3 -n -r` for the
+// functions with the most exclusive time.
+static void aecor_prof_report(void) {
+  // Functions still running when `exit()` was called end here
+  while (aecor_prof_current) aecor_prof_exit(aecor_prof_current);
+
+  const char* path = getenv("AECOR_PROFILE");
+  if (!path) path = "aecor_profile.txt";
+  FILE* file = fopen(path, "w");
+  if (!file) {
+    fprintf(stderr, "Could not write profile to %s\n", path);
+    return;
+  }
+  fprintf(file, "# %12s %16s %16s  %s  %s\n",
+          "calls", "inclusive_ns", "exclusive_ns", "function", "location");
+  for (u32 i = 0; i < aecor_prof_count; i++) {
+    aecor_prof_entry* entry = &aecor_prof_table[i];
+    if (entry->calls == 0) continue;
+    fprintf(file, "%14llu %16llu %16llu  %s  %s\n",
+            (unsigned long long)entry->calls,
+            (unsigned long long)entry->inclusive_ns,
+            (unsigned long long)entry->exclusive_ns,
+            entry->name, entry->location);
+  }
+  fclose(file);
+}
+
+__attribute__((constructor)) static void aecor_prof_init(void) {
+  atexit(aecor_prof_report);
+}
+#endif
+
+
+/* constants */
+const i32 BTREE_MAX_KEYS = 31;
+
+/* struct declarations */
+typedef struct BTreeMap__ptr_char_i32 BTreeMap__ptr_char_i32;
+typedef struct BTreeIterator__ptr_char_i32 BTreeIterator__ptr_char_i32;
+typedef struct BTreeInner__ptr_char_i32 BTreeInner__ptr_char_i32;
+typedef struct BTreeLeaf__ptr_char_i32 BTreeLeaf__ptr_char_i32;
+typedef struct BTreeMap__i64_i64 BTreeMap__i64_i64;
+typedef struct BTreeIterator__i64_i64 BTreeIterator__i64_i64;
+typedef struct BTreeInner__i64_i64 BTreeInner__i64_i64;
+typedef struct BTreeLeaf__i64_i64 BTreeLeaf__i64_i64;
+
+struct BTreeMap__ptr_char_i32 {
+  void *root;
+  i32 height;
+  i32 size;
+  i32 (*compare)(char *, char *);
+};
+
+struct BTreeIterator__ptr_char_i32 {
+  BTreeMap__ptr_char_i32 *map;
+  BTreeLeaf__ptr_char_i32 *leaf;
+  i32 idx;
+  bool has_end;
+  char *end;
+};
+
+struct BTreeInner__ptr_char_i32 {
+  i32 num_keys;
+  char *keys[31];
+  void *children[32];
+};
+
+struct BTreeLeaf__ptr_char_i32 {
+  i32 num_keys;
+  char *keys[31];
+  i32 values[31];
+  BTreeLeaf__ptr_char_i32 *next;
+};
+
+struct BTreeMap__i64_i64 {
+  void *root;
+  i32 height;
+  i32 size;
+  i32 (*compare)(i64, i64);
+};
+
+struct BTreeIterator__i64_i64 {
+  BTreeMap__i64_i64 *map;
+  BTreeLeaf__i64_i64 *leaf;
+  i32 idx;
+  bool has_end;
+  i64 end;
+};
+
+struct BTreeInner__i64_i64 {
+  i32 num_keys;
+  i64 keys[31];
+  void *children[32];
+};
+
+struct BTreeLeaf__i64_i64 {
+  i32 num_keys;
+  i64 keys[31];
+  i64 values[31];
+  BTreeLeaf__i64_i64 *next;
+};
+
+/* function declarations */
+static __attribute__((unused)) FILE *File__open(char *path, char *mode);
+static __attribute__((unused)) bool File__exists(char *path);
+static __attribute__((unused)) i32 File__size(FILE *this);
+static __attribute__((unused)) char *File__slurp(FILE *this);
+static __attribute__((unused)) i32 File__read(FILE *this, void *buf, i32 size);
+static __attribute__((unused)) i32 File__write(FILE *this, void *buf, i32 size);
+static __attribute__((unused)) void File__puts(FILE *this, char *str);
+static __attribute__((unused)) __attribute__((noreturn)) __attribute__((cold)) void panic(char *msg);
+static __attribute__((unused)) bool string__starts_with(char *this, char *prefix);
+static __attribute__((unused)) bool string__ends_with(char *this, char *suffix);
+static __attribute__((unused)) void string__remove_last_n(char *this, i32 n);
+static __attribute__((unused)) bool string__eq(char *this, char *str2);
+static __attribute__((unused)) char *string__substring(char *this, i32 start, i32 len);
+static __attribute__((unused)) void string__strip_trailing_whitespace(char *this);
+static __attribute__((unused)) i32 min(i32 a, i32 b);
+static __attribute__((unused)) i32 max(i32 a, i32 b);
+static __attribute__((unused)) i32 btree_compare_strings(char *a, char *b);
+static __attribute__((unused)) i32 btree_compare_i64(i64 a, i64 b);
+static __attribute__((unused)) i32 btree_compare_u64(u64 a, u64 b);
+static __attribute__((unused)) i32 btree_compare_f64(f64 a, f64 b);
+i32 main(void);
+static __attribute__((unused)) BTreeMap__ptr_char_i32 *BTreeMap__ptr_char_i32__new(i32 (*compare)(char *, char *));
+static __attribute__((unused)) i32 BTreeMap__ptr_char_i32__lower_bound_in(BTreeMap__ptr_char_i32 *this, char **keys, i32 n, char *key);
+static __attribute__((unused)) i32 BTreeMap__ptr_char_i32__child_index(BTreeMap__ptr_char_i32 *this, BTreeInner__ptr_char_i32 *node, char *key);
+static __attribute__((unused)) BTreeLeaf__ptr_char_i32 *BTreeMap__ptr_char_i32__find_leaf(BTreeMap__ptr_char_i32 *this, char *key);
+static __attribute__((unused)) i32 *BTreeMap__ptr_char_i32__get_ptr(BTreeMap__ptr_char_i32 *this, char *key);
+static __attribute__((unused)) i32 BTreeMap__ptr_char_i32__get_or(BTreeMap__ptr_char_i32 *this, char *key, i32 fallback);
+static __attribute__((unused)) bool BTreeMap__ptr_char_i32__exists(BTreeMap__ptr_char_i32 *this, char *key);
+static __attribute__((unused)) void *BTreeMap__ptr_char_i32__insert_into(BTreeMap__ptr_char_i32 *this, void *node, i32 level, char *key, i32 value, char **split_key);
+static __attribute__((unused)) void BTreeMap__ptr_char_i32__insert(BTreeMap__ptr_char_i32 *this, char *key, i32 value);
+static __attribute__((unused)) BTreeMap__ptr_char_i32 *BTreeMap__ptr_char_i32__from_sorted(char **keys, i32 *values, i32 n, i32 (*compare)(char *, char *));
+static __attribute__((unused)) void BTreeMap__ptr_char_i32__free_node(BTreeMap__ptr_char_i32 *this, void *node, i32 level);
+static __attribute__((unused)) void BTreeMap__ptr_char_i32__free(BTreeMap__ptr_char_i32 *this);
+static __attribute__((unused)) BTreeIterator__ptr_char_i32 BTreeMap__ptr_char_i32__iter(BTreeMap__ptr_char_i32 *this);
+static __attribute__((unused)) BTreeIterator__ptr_char_i32 BTreeMap__ptr_char_i32__lower_bound(BTreeMap__ptr_char_i32 *this, char *key);
+static __attribute__((unused)) BTreeIterator__ptr_char_i32 BTreeMap__ptr_char_i32__range(BTreeMap__ptr_char_i32 *this, char *lo, char *hi);
+static __attribute__((unused)) char *BTreeMap__ptr_char_i32__zero_key(BTreeMap__ptr_char_i32 *this);
+static __attribute__((unused)) void BTreeIterator__ptr_char_i32__skip_empty(BTreeIterator__ptr_char_i32 *this);
+static __attribute__((unused)) bool BTreeIterator__ptr_char_i32__valid(BTreeIterator__ptr_char_i32 *this);
+static __attribute__((unused)) char *BTreeIterator__ptr_char_i32__key(BTreeIterator__ptr_char_i32 *this);
+static __attribute__((unused)) i32 BTreeIterator__ptr_char_i32__value(BTreeIterator__ptr_char_i32 *this);
+static __attribute__((unused)) i32 *BTreeIterator__ptr_char_i32__value_ptr(BTreeIterator__ptr_char_i32 *this);
+static __attribute__((unused)) void BTreeIterator__ptr_char_i32__next(BTreeIterator__ptr_char_i32 *this);
+static __attribute__((unused)) BTreeMap__i64_i64 *BTreeMap__i64_i64__new(i32 (*compare)(i64, i64));
+static __attribute__((unused)) i32 BTreeMap__i64_i64__lower_bound_in(BTreeMap__i64_i64 *this, i64 *keys, i32 n, i64 key);
+static __attribute__((unused)) i32 BTreeMap__i64_i64__child_index(BTreeMap__i64_i64 *this, BTreeInner__i64_i64 *node, i64 key);
+static __attribute__((unused)) BTreeLeaf__i64_i64 *BTreeMap__i64_i64__find_leaf(BTreeMap__i64_i64 *this, i64 key);
+static __attribute__((unused)) i64 *BTreeMap__i64_i64__get_ptr(BTreeMap__i64_i64 *this, i64 key);
+static __attribute__((unused)) i64 BTreeMap__i64_i64__get_or(BTreeMap__i64_i64 *this, i64 key, i64 fallback);
+static __attribute__((unused)) bool BTreeMap__i64_i64__exists(BTreeMap__i64_i64 *this, i64 key);
+static __attribute__((unused)) void *BTreeMap__i64_i64__insert_into(BTreeMap__i64_i64 *this, void *node, i32 level, i64 key, i64 value, i64 *split_key);
+static __attribute__((unused)) void BTreeMap__i64_i64__insert(BTreeMap__i64_i64 *this, i64 key, i64 value);
+static __attribute__((unused)) BTreeMap__i64_i64 *BTreeMap__i64_i64__from_sorted(i64 *keys, i64 *values, i32 n, i32 (*compare)(i64, i64));
+static __attribute__((unused)) void BTreeMap__i64_i64__free_node(BTreeMap__i64_i64 *this, void *node, i32 level);
+static __attribute__((unused)) void BTreeMap__i64_i64__free(BTreeMap__i64_i64 *this);
+static __attribute__((unused)) BTreeIterator__i64_i64 BTreeMap__i64_i64__iter(BTreeMap__i64_i64 *this);
+static __attribute__((unused)) BTreeIterator__i64_i64 BTreeMap__i64_i64__lower_bound(BTreeMap__i64_i64 *this, i64 key);
+static __attribute__((unused)) BTreeIterator__i64_i64 BTreeMap__i64_i64__range(BTreeMap__i64_i64 *this, i64 lo, i64 hi);
+static __attribute__((unused)) i64 BTreeMap__i64_i64__zero_key(BTreeMap__i64_i64 *this);
+static __attribute__((unused)) void BTreeIterator__i64_i64__skip_empty(BTreeIterator__i64_i64 *this);
+static __attribute__((unused)) bool BTreeIterator__i64_i64__valid(BTreeIterator__i64_i64 *this);
+static __attribute__((unused)) i64 BTreeIterator__i64_i64__key(BTreeIterator__i64_i64 *this);
+static __attribute__((unused)) i64 BTreeIterator__i64_i64__value(BTreeIterator__i64_i64 *this);
+static __attribute__((unused)) i64 *BTreeIterator__i64_i64__value_ptr(BTreeIterator__i64_i64 *this);
+static __attribute__((unused)) void BTreeIterator__i64_i64__next(BTreeIterator__i64_i64 *this);
+
+/* global variables */
+
+static __attribute__((unused)) FILE *File__open(char *path, char *mode) {
+  FILE *file = fopen(path, mode);
+  if ((!((bool)file))) {
+    printf("Error opening file '%s': %s""\n", path, strerror(errno));
+    exit(1);
+  } 
+  return file;
+}
+
+static __attribute__((unused)) bool File__exists(char *path) {
+  FILE *file = fopen(path, "r");
+  if ((!((bool)file))) {
+    return false;
+  } 
+  fclose(file);
+  return true;
+}
+
+static __attribute__((unused)) i32 File__size(FILE *this) {
+  i32 pos = ftell(this);
+  fseek(this, 0, SEEK_END);
+  i32 size = ftell(this);
+  fseek(this, pos, SEEK_SET);
+  return size;
+}
+
+static __attribute__((unused)) char *File__slurp(FILE *this) {
+  i32 pos = ftell(this);
+  fseek(this, 0, SEEK_END);
+  i32 size = ftell(this);
+  fseek(this, pos, SEEK_SET);
+  void *buf = calloc((size + 1), sizeof(char));
+  fread(buf, 1, size, this);
+  fseek(this, pos, SEEK_SET);
+  return ((char *)buf);
+}
+
+static __attribute__((unused)) i32 File__read(FILE *this, void *buf, i32 size) {
+  return fread(buf, 1, size, this);
+}
+
+static __attribute__((unused)) i32 File__write(FILE *this, void *buf, i32 size) {
+  return fwrite(buf, 1, size, this);
+}
+
+static __attribute__((unused)) void File__puts(FILE *this, char *str) {
+  fwrite(str, 1, strlen(str), this);
+}
+
+static __attribute__((unused)) __attribute__((noreturn)) __attribute__((cold)) void panic(char *msg) {
+  printf("%s""\n", msg);
+  aecor_stdout_flush();
+  exit(1);
+}
+
+static __attribute__((unused)) bool string__starts_with(char *this, char *prefix) {
+  i32 prefix_len = strlen(prefix);
+  if ((strlen(this) < prefix_len)) {
+    return false;
+  } 
+  return strncmp(this, prefix, prefix_len) == 0;
+}
+
+static __attribute__((unused)) bool string__ends_with(char *this, char *suffix) {
+  i32 suffix_len = strlen(suffix);
+  if ((strlen(this) < suffix_len)) {
+    return false;
+  } 
+  return strncmp(this, suffix, suffix_len) == 0;
+}
+
+static __attribute__((unused)) void string__remove_last_n(char *this, i32 n) {
+  this[(strlen(this) - n)] = '\0';
+}
+
+static __attribute__((unused)) bool string__eq(char *this, char *str2) {
+  return strcmp(this, str2) == 0;
+}
+
+static __attribute__((unused)) char *string__substring(char *this, i32 start, i32 len) {
+  char *new_str = ((char *)calloc((len + 1), sizeof(char)));
+  memcpy(new_str, (this + start), len);
+  return new_str;
+}
+
+static __attribute__((unused)) void string__strip_trailing_whitespace(char *this) {
+  for (i32 i = (strlen(this) - 1); (i >= 0); i -= 1) {
+    if ((this[i] != ' ')) 
+    break;
+    
+    this[i] = '\0';
+  } 
+}
+
+static __attribute__((unused)) i32 min(i32 a, i32 b) {
+  return ((a < b) ? a : b);
+}
+
+static __attribute__((unused)) i32 max(i32 a, i32 b) {
+  return ((a > b) ? a : b);
+}
+
+static __attribute__((unused)) i32 btree_compare_strings(char *a, char *b) {
+  return strcmp(a, b);
+}
+
+static __attribute__((unused)) i32 btree_compare_i64(i64 a, i64 b) {
+  return ((a < b) ? (-1) : ((a > b) ? 1 : 0));
+}
+
+static __attribute__((unused)) i32 btree_compare_u64(u64 a, u64 b) {
+  return ((a < b) ? (-1) : ((a > b) ? 1 : 0));
+}
+
+static __attribute__((unused)) i32 btree_compare_f64(f64 a, f64 b) {
+  return ((a < b) ? (-1) : ((a > b) ? 1 : 0));
+}
+
+i32 main(void) {
+  BTreeMap__i64_i64 *map = BTreeMap__i64_i64__new(btree_compare_i64);
+  for (i32 i = 0; (i < 10000); i += 1) {
+    i64 key = (((i64)((i * 7919) % 10000)) * 3);
+    BTreeMap__i64_i64__insert(map, key, (key * 2));
+  } 
+  printf("%d keys, height %d | ", map->size, map->height);
+  bool ok = true;
+  i32 count = 0;
+  i64 prev = (-1LL);
+  for (BTreeIterator__i64_i64 it = BTreeMap__i64_i64__iter(map); BTreeIterator__i64_i64__valid((&it)); BTreeIterator__i64_i64__next((&it))) {
+    if (((BTreeIterator__i64_i64__key((&it)) <= prev) || (BTreeIterator__i64_i64__value((&it)) != (BTreeIterator__i64_i64__key((&it)) * 2)))) 
+    ok = false;
+    
+    prev = BTreeIterator__i64_i64__key((&it));
+    count += 1;
+  } 
+  for (i64 i = 0LL; (i < 30000); i += 1) {
+    if ((BTreeMap__i64_i64__exists(map, i) != (i % 3) == 0)) 
+    ok = false;
+    
+  } 
+  printf(((ok && count == 10000) ? "sorted ok | " : "sorted FAILED | "));
+  for (BTreeIterator__i64_i64 it = BTreeMap__i64_i64__range(map, 40, 50); BTreeIterator__i64_i64__valid((&it)); BTreeIterator__i64_i64__next((&it))) {
+    printf("%lld ", BTreeIterator__i64_i64__key((&it)));
+  } 
+  BTreeIterator__i64_i64 lb = BTreeMap__i64_i64__lower_bound(map, 100);
+  printf("| lb 100 -> %lld | ", BTreeIterator__i64_i64__key((&lb)));
+  BTreeIterator__i64_i64 past = BTreeMap__i64_i64__lower_bound(map, 30000);
+  printf("past end: %s | ", ((BTreeIterator__i64_i64__valid((&past))) ? "true" : "false"));
+  BTreeMap__i64_i64__insert(map, 3, 7);
+  printf("replaced %lld | ", BTreeMap__i64_i64__get_or(map, 3, (-1)));
+  BTreeMap__i64_i64__free(map);
+  free(map);
+  i64 *keys = ((i64 *)calloc(1000, sizeof(i64)));
+  i64 *values = ((i64 *)calloc(1000, sizeof(i64)));
+  for (i32 i = 0; (i < 1000); i += 1) {
+    keys[i] = (((i64)i) * 2);
+    values[i] = ((i64)i);
+  } 
+  BTreeMap__i64_i64 *bulk = BTreeMap__i64_i64__from_sorted(keys, values, 1000, btree_compare_i64);
+  i32 bulk_height = bulk->height;
+  bool bulk_ok = true;
+  for (i32 i = 0; (i < 2000); i += 1) {
+    i64 expected = ((i % 2) == 0 ? (((i64)i) / 2) : (-1LL));
+    if ((BTreeMap__i64_i64__get_or(bulk, ((i64)i), (-1)) != expected)) 
+    bulk_ok = false;
+    
+  } 
+  for (i32 i = 0; (i < 1000); i += 1) {
+    BTreeMap__i64_i64__insert(bulk, ((((i64)i) * 2) + 1), 0);
+  } 
+  i32 n = 0;
+  for (BTreeIterator__i64_i64 it = BTreeMap__i64_i64__iter(bulk); BTreeIterator__i64_i64__valid((&it)); BTreeIterator__i64_i64__next((&it))) {
+    if ((BTreeIterator__i64_i64__key((&it)) != ((i64)n))) 
+    bulk_ok = false;
+    
+    n += 1;
+  } 
+  char *result = ((bulk_ok && n == 2000) ? "ok" : "FAILED");
+  printf("bulk %d, height %d, %s | ", n, bulk_height, result);
+  BTreeMap__i64_i64__free(bulk);
+  free(bulk);
+  BTreeMap__ptr_char_i32 *names = BTreeMap__ptr_char_i32__new(btree_compare_strings);
+  BTreeMap__ptr_char_i32__insert(names, "b", 2);
+  BTreeMap__ptr_char_i32__insert(names, "a", 1);
+  BTreeMap__ptr_char_i32__insert(names, "c", 3);
+  printf("b=%d a=%d c=%d ->", BTreeMap__ptr_char_i32__get_or(names, "b", 0), BTreeMap__ptr_char_i32__get_or(names, "a", 0), BTreeMap__ptr_char_i32__get_or(names, "c", 0));
+  for (BTreeIterator__ptr_char_i32 it = BTreeMap__ptr_char_i32__iter(names); BTreeIterator__ptr_char_i32__valid((&it)); BTreeIterator__ptr_char_i32__next((&it))) {
+    printf(" %s", BTreeIterator__ptr_char_i32__key((&it)));
+  } 
+  printf("""\n");
+}
+
+static __attribute__((unused)) BTreeMap__ptr_char_i32 *BTreeMap__ptr_char_i32__new(i32 (*compare)(char *, char *)) {
+  BTreeMap__ptr_char_i32 *map = ((BTreeMap__ptr_char_i32 *)calloc(1, sizeof(BTreeMap__ptr_char_i32)));
+  map->root = calloc(1, sizeof(BTreeLeaf__ptr_char_i32));
+  map->compare = compare;
+  return map;
+}
+
+static __attribute__((unused)) i32 BTreeMap__ptr_char_i32__lower_bound_in(BTreeMap__ptr_char_i32 *this, char **keys, i32 n, char *key) {
+  i32 lo = 0;
+  i32 hi = n;
+  while ((lo < hi)) {
+    i32 mid = ((lo + hi) / 2);
+    if ((this->compare(keys[mid], key) < 0)) {
+      lo = (mid + 1);
+    }  else {
+      hi = mid;
+    } 
+  } 
+  return lo;
+}
+
+static __attribute__((unused)) i32 BTreeMap__ptr_char_i32__child_index(BTreeMap__ptr_char_i32 *this, BTreeInner__ptr_char_i32 *node, char *key) {
+  i32 lo = 0;
+  i32 hi = node->num_keys;
+  while ((lo < hi)) {
+    i32 mid = ((lo + hi) / 2);
+    if ((this->compare(node->keys[mid], key) <= 0)) {
+      lo = (mid + 1);
+    }  else {
+      hi = mid;
+    } 
+  } 
+  return lo;
+}
+
+static __attribute__((unused)) BTreeLeaf__ptr_char_i32 *BTreeMap__ptr_char_i32__find_leaf(BTreeMap__ptr_char_i32 *this, char *key) {
+  void *node = this->root;
+  for (i32 level = this->height; (level > 0); level -= 1) {
+    BTreeInner__ptr_char_i32 *inner = ((BTreeInner__ptr_char_i32 *)node);
+    node = inner->children[BTreeMap__ptr_char_i32__child_index(this, inner, key)];
+  } 
+  return ((BTreeLeaf__ptr_char_i32 *)node);
+}
+
+static __attribute__((unused)) i32 *BTreeMap__ptr_char_i32__get_ptr(BTreeMap__ptr_char_i32 *this, char *key) {
+  BTreeLeaf__ptr_char_i32 *leaf = BTreeMap__ptr_char_i32__find_leaf(this, key);
+  i32 i = BTreeMap__ptr_char_i32__lower_bound_in(this, leaf->keys, leaf->num_keys, key);
+  if (((i < leaf->num_keys) && this->compare(leaf->keys[i], key) == 0)) 
+  return (&leaf->values[i]);
+  
+  return NULL;
+}
+
+static __attribute__((unused)) i32 BTreeMap__ptr_char_i32__get_or(BTreeMap__ptr_char_i32 *this, char *key, i32 fallback) {
+  i32 *value = BTreeMap__ptr_char_i32__get_ptr(this, key);
+  if (((bool)value)) 
+  return (*value);
+  
+  return fallback;
+}
+
+static __attribute__((unused)) bool BTreeMap__ptr_char_i32__exists(BTreeMap__ptr_char_i32 *this, char *key) {
+  return ((bool)BTreeMap__ptr_char_i32__get_ptr(this, key));
+}
+
+static __attribute__((unused)) void *BTreeMap__ptr_char_i32__insert_into(BTreeMap__ptr_char_i32 *this, void *node, i32 level, char *key, i32 value, char **split_key) {
+  if (level == 0) {
+    BTreeLeaf__ptr_char_i32 *leaf = ((BTreeLeaf__ptr_char_i32 *)node);
+    i32 i = BTreeMap__ptr_char_i32__lower_bound_in(this, leaf->keys, leaf->num_keys, key);
+    if (((i < leaf->num_keys) && this->compare(leaf->keys[i], key) == 0)) {
+      leaf->values[i] = value;
+      return NULL;
+    } 
+    this->size += 1;
+    BTreeLeaf__ptr_char_i32 *right = ((BTreeLeaf__ptr_char_i32 *)NULL);
+    if (leaf->num_keys == BTREE_MAX_KEYS) {
+      right = ((BTreeLeaf__ptr_char_i32 *)calloc(1, sizeof(BTreeLeaf__ptr_char_i32)));
+      i32 half = (BTREE_MAX_KEYS / 2);
+      right->num_keys = (leaf->num_keys - half);
+      memcpy(right->keys, (&leaf->keys[half]), (right->num_keys * sizeof(char *)));
+      memcpy(right->values, (&leaf->values[half]), (right->num_keys * sizeof(i32)));
+      leaf->num_keys = half;
+      right->next = leaf->next;
+      leaf->next = right;
+      if ((i > half)) {
+        leaf = right;
+        i -= half;
+      } 
+    } 
+    i32 after = (leaf->num_keys - i);
+    memmove((&leaf->keys[(i + 1)]), (&leaf->keys[i]), (after * sizeof(char *)));
+    memmove((&leaf->values[(i + 1)]), (&leaf->values[i]), (after * sizeof(i32)));
+    leaf->keys[i] = key;
+    leaf->values[i] = value;
+    leaf->num_keys += 1;
+    if (((bool)right)) 
+    (*split_key) = right->keys[0];
+    
+    return right;
+  } 
+  BTreeInner__ptr_char_i32 *inner = ((BTreeInner__ptr_char_i32 *)node);
+  i32 i = BTreeMap__ptr_char_i32__child_index(this, inner, key);
+  char *child_key;
+  void *child = BTreeMap__ptr_char_i32__insert_into(this, inner->children[i], (level - 1), key, value, (&child_key));
+  if ((!((bool)child))) 
+  return NULL;
+  
+  BTreeInner__ptr_char_i32 *right = ((BTreeInner__ptr_char_i32 *)NULL);
+  if (inner->num_keys == BTREE_MAX_KEYS) {
+    right = ((BTreeInner__ptr_char_i32 *)calloc(1, sizeof(BTreeInner__ptr_char_i32)));
+    i32 half = (BTREE_MAX_KEYS / 2);
+    right->num_keys = ((inner->num_keys - half) - 1);
+    memcpy(right->keys, (&inner->keys[(half + 1)]), (right->num_keys * sizeof(char *)));
+    memcpy(right->children, (&inner->children[(half + 1)]), ((right->num_keys + 1) * sizeof(void *)));
+    (*split_key) = inner->keys[half];
+    inner->num_keys = half;
+    if ((i > half)) {
+      inner = right;
+      i -= (half + 1);
+    } 
+  } 
+  i32 after = (inner->num_keys - i);
+  memmove((&inner->keys[(i + 1)]), (&inner->keys[i]), (after * sizeof(char *)));
+  memmove((&inner->children[(i + 2)]), (&inner->children[(i + 1)]), (after * sizeof(void *)));
+  inner->keys[i] = child_key;
+  inner->children[(i + 1)] = child;
+  inner->num_keys += 1;
+  return right;
+}
+
+static __attribute__((unused)) void BTreeMap__ptr_char_i32__insert(BTreeMap__ptr_char_i32 *this, char *key, i32 value) {
+  char *split_key;
+  void *right = BTreeMap__ptr_char_i32__insert_into(this, this->root, this->height, key, value, (&split_key));
+  if ((!((bool)right))) 
+  return;
+  
+  BTreeInner__ptr_char_i32 *root = ((BTreeInner__ptr_char_i32 *)calloc(1, sizeof(BTreeInner__ptr_char_i32)));
+  root->num_keys = 1;
+  root->keys[0] = split_key;
+  root->children[0] = this->root;
+  root->children[1] = right;
+  this->root = root;
+  this->height += 1;
+}
+
+static __attribute__((unused)) BTreeMap__ptr_char_i32 *BTreeMap__ptr_char_i32__from_sorted(char **keys, i32 *values, i32 n, i32 (*compare)(char *, char *)) {
+  BTreeMap__ptr_char_i32 *map = BTreeMap__ptr_char_i32__new(compare);
+  if (n == 0) 
+  return map;
+  
+  free(map->root);
+  map->size = n;
+  i32 num_nodes = (((n + BTREE_MAX_KEYS) - 1) / BTREE_MAX_KEYS);
+  void **nodes = ((void **)calloc(num_nodes, sizeof(void *)));
+  char **min_keys = ((char **)calloc(num_nodes, sizeof(char *)));
+  BTreeLeaf__ptr_char_i32 *prev = ((BTreeLeaf__ptr_char_i32 *)NULL);
+  i32 start = 0;
+  for (i32 i = 0; (i < num_nodes); i += 1) {
+    i32 end = ((i32)((((i64)n) * ((i64)(i + 1))) / ((i64)num_nodes)));
+    BTreeLeaf__ptr_char_i32 *leaf = ((BTreeLeaf__ptr_char_i32 *)calloc(1, sizeof(BTreeLeaf__ptr_char_i32)));
+    leaf->num_keys = (end - start);
+    memcpy(leaf->keys, (&keys[start]), (leaf->num_keys * sizeof(char *)));
+    memcpy(leaf->values, (&values[start]), (leaf->num_keys * sizeof(i32)));
+    (__builtin_expect(!!((start == 0 || (compare(keys[(start - 1)], keys[start]) < 0))), 1) ? (void)0 : panic("keys are not sorted"));
+    if (((bool)prev)) 
+    prev->next = leaf;
+    
+    prev = leaf;
+    nodes[i] = leaf;
+    min_keys[i] = keys[start];
+    start = end;
+  } 
+  while ((num_nodes > 1)) {
+    i32 num_parents = ((num_nodes + BTREE_MAX_KEYS) / (BTREE_MAX_KEYS + 1));
+    start = 0;
+    for (i32 i = 0; (i < num_parents); i += 1) {
+      i32 end = ((i32)((((i64)num_nodes) * ((i64)(i + 1))) / ((i64)num_parents)));
+      BTreeInner__ptr_char_i32 *inner = ((BTreeInner__ptr_char_i32 *)calloc(1, sizeof(BTreeInner__ptr_char_i32)));
+      inner->num_keys = ((end - start) - 1);
+      for (i32 j = start; (j < end); j += 1) {
+        inner->children[(j - start)] = nodes[j];
+        if ((j > start)) 
+        inner->keys[((j - start) - 1)] = min_keys[j];
+        
+      } 
+      nodes[i] = inner;
+      min_keys[i] = min_keys[start];
+      start = end;
+    } 
+    num_nodes = num_parents;
+    map->height += 1;
+  } 
+  map->root = nodes[0];
+  free(nodes);
+  free(min_keys);
+  return map;
+}
+
+static __attribute__((unused)) void BTreeMap__ptr_char_i32__free_node(BTreeMap__ptr_char_i32 *this, void *node, i32 level) {
+  if ((level > 0)) {
+    BTreeInner__ptr_char_i32 *inner = ((BTreeInner__ptr_char_i32 *)node);
+    for (i32 i = 0; (i <= inner->num_keys); i += 1) {
+      BTreeMap__ptr_char_i32__free_node(this, inner->children[i], (level - 1));
+    } 
+  } 
+  free(node);
+}
+
+static __attribute__((unused)) void BTreeMap__ptr_char_i32__free(BTreeMap__ptr_char_i32 *this) {
+  BTreeMap__ptr_char_i32__free_node(this, this->root, this->height);
+}
+
+static __attribute__((unused)) BTreeIterator__ptr_char_i32 BTreeMap__ptr_char_i32__iter(BTreeMap__ptr_char_i32 *this) {
+  void *node = this->root;
+  for (i32 level = this->height; (level > 0); level -= 1) {
+    node = ((BTreeInner__ptr_char_i32 *)node)->children[0];
+  } 
+  BTreeIterator__ptr_char_i32 it = (BTreeIterator__ptr_char_i32){this, ((BTreeLeaf__ptr_char_i32 *)node), 0, .has_end = false, .end = BTreeMap__ptr_char_i32__zero_key(this)};
+  BTreeIterator__ptr_char_i32__skip_empty((&it));
+  return it;
+}
+
+static __attribute__((unused)) BTreeIterator__ptr_char_i32 BTreeMap__ptr_char_i32__lower_bound(BTreeMap__ptr_char_i32 *this, char *key) {
+  BTreeLeaf__ptr_char_i32 *leaf = BTreeMap__ptr_char_i32__find_leaf(this, key);
+  i32 i = BTreeMap__ptr_char_i32__lower_bound_in(this, leaf->keys, leaf->num_keys, key);
+  BTreeIterator__ptr_char_i32 it = (BTreeIterator__ptr_char_i32){this, leaf, i, .has_end = false, .end = key};
+  BTreeIterator__ptr_char_i32__skip_empty((&it));
+  return it;
+}
+
+static __attribute__((unused)) BTreeIterator__ptr_char_i32 BTreeMap__ptr_char_i32__range(BTreeMap__ptr_char_i32 *this, char *lo, char *hi) {
+  BTreeIterator__ptr_char_i32 it = BTreeMap__ptr_char_i32__lower_bound(this, lo);
+  it.has_end = true;
+  it.end = hi;
+  return it;
+}
+
+static __attribute__((unused)) char *BTreeMap__ptr_char_i32__zero_key(BTreeMap__ptr_char_i32 *this) {
+  char *unused;
+  memset((&unused), 0, sizeof(char *));
+  return unused;
+}
+
+static __attribute__((unused)) void BTreeIterator__ptr_char_i32__skip_empty(BTreeIterator__ptr_char_i32 *this) {
+  while ((((bool)this->leaf) && (this->idx >= this->leaf->num_keys))) {
+    this->leaf = this->leaf->next;
+    this->idx = 0;
+  } 
+}
+
+static __attribute__((unused)) bool BTreeIterator__ptr_char_i32__valid(BTreeIterator__ptr_char_i32 *this) {
+  if ((!((bool)this->leaf))) 
+  return false;
+  
+  if ((this->has_end && (this->map->compare(this->leaf->keys[this->idx], this->end) >= 0))) 
+  return false;
+  
+  return true;
+}
+
+static __attribute__((unused)) char *BTreeIterator__ptr_char_i32__key(BTreeIterator__ptr_char_i32 *this) {
+  return this->leaf->keys[this->idx];
+}
+
+static __attribute__((unused)) i32 BTreeIterator__ptr_char_i32__value(BTreeIterator__ptr_char_i32 *this) {
+  return this->leaf->values[this->idx];
+}
+
+static __attribute__((unused)) i32 *BTreeIterator__ptr_char_i32__value_ptr(BTreeIterator__ptr_char_i32 *this) {
+  return (&this->leaf->values[this->idx]);
+}
+
+static __attribute__((unused)) void BTreeIterator__ptr_char_i32__next(BTreeIterator__ptr_char_i32 *this) {
+  this->idx += 1;
+  BTreeIterator__ptr_char_i32__skip_empty(this);
+}
+
+static __attribute__((unused)) BTreeMap__i64_i64 *BTreeMap__i64_i64__new(i32 (*compare)(i64, i64)) {
+  BTreeMap__i64_i64 *map = ((BTreeMap__i64_i64 *)calloc(1, sizeof(BTreeMap__i64_i64)));
+  map->root = calloc(1, sizeof(BTreeLeaf__i64_i64));
+  map->compare = compare;
+  return map;
+}
+
+static __attribute__((unused)) i32 BTreeMap__i64_i64__lower_bound_in(BTreeMap__i64_i64 *this, i64 *keys, i32 n, i64 key) {
+  i32 lo = 0;
+  i32 hi = n;
+  while ((lo < hi)) {
+    i32 mid = ((lo + hi) / 2);
+    if ((this->compare(keys[mid], key) < 0)) {
+      lo = (mid + 1);
+    }  else {
+      hi = mid;
+    } 
+  } 
+  return lo;
+}
+
+static __attribute__((unused)) i32 BTreeMap__i64_i64__child_index(BTreeMap__i64_i64 *this, BTreeInner__i64_i64 *node, i64 key) {
+  i32 lo = 0;
+  i32 hi = node->num_keys;
+  while ((lo < hi)) {
+    i32 mid = ((lo + hi) / 2);
+    if ((this->compare(node->keys[mid], key) <= 0)) {
+      lo = (mid + 1);
+    }  else {
+      hi = mid;
+    } 
+  } 
+  return lo;
+}
+
+static __attribute__((unused)) BTreeLeaf__i64_i64 *BTreeMap__i64_i64__find_leaf(BTreeMap__i64_i64 *this, i64 key) {
+  void *node = this->root;
+  for (i32 level = this->height; (level > 0); level -= 1) {
+    BTreeInner__i64_i64 *inner = ((BTreeInner__i64_i64 *)node);
+    node = inner->children[BTreeMap__i64_i64__child_index(this, inner, key)];
+  } 
+  return ((BTreeLeaf__i64_i64 *)node);
+}
+
+static __attribute__((unused)) i64 *BTreeMap__i64_i64__get_ptr(BTreeMap__i64_i64 *this, i64 key) {
+  BTreeLeaf__i64_i64 *leaf = BTreeMap__i64_i64__find_leaf(this, key);
+  i32 i = BTreeMap__i64_i64__lower_bound_in(this, leaf->keys, leaf->num_keys, key);
+  if (((i < leaf->num_keys) && this->compare(leaf->keys[i], key) == 0)) 
+  return (&leaf->values[i]);
+  
+  return NULL;
+}
+
+static __attribute__((unused)) i64 BTreeMap__i64_i64__get_or(BTreeMap__i64_i64 *this, i64 key, i64 fallback) {
+  i64 *value = BTreeMap__i64_i64__get_ptr(this, key);
+  if (((bool)value)) 
+  return (*value);
+  
+  return fallback;
+}
+
+static __attribute__((unused)) bool BTreeMap__i64_i64__exists(BTreeMap__i64_i64 *this, i64 key) {
+  return ((bool)BTreeMap__i64_i64__get_ptr(this, key));
+}
+
+static __attribute__((unused)) void *BTreeMap__i64_i64__insert_into(BTreeMap__i64_i64 *this, void *node, i32 level, i64 key, i64 value, i64 *split_key) {
+  if (level == 0) {
+    BTreeLeaf__i64_i64 *leaf = ((BTreeLeaf__i64_i64 *)node);
+    i32 i = BTreeMap__i64_i64__lower_bound_in(this, leaf->keys, leaf->num_keys, key);
+    if (((i < leaf->num_keys) && this->compare(leaf->keys[i], key) == 0)) {
+      leaf->values[i] = value;
+      return NULL;
+    } 
+    this->size += 1;
+    BTreeLeaf__i64_i64 *right = ((BTreeLeaf__i64_i64 *)NULL);
+    if (leaf->num_keys == BTREE_MAX_KEYS) {
+      right = ((BTreeLeaf__i64_i64 *)calloc(1, sizeof(BTreeLeaf__i64_i64)));
+      i32 half = (BTREE_MAX_KEYS / 2);
+      right->num_keys = (leaf->num_keys - half);
+      memcpy(right->keys, (&leaf->keys[half]), (right->num_keys * sizeof(i64)));
+      memcpy(right->values, (&leaf->values[half]), (right->num_keys * sizeof(i64)));
+      leaf->num_keys = half;
+      right->next = leaf->next;
+      leaf->next = right;
+      if ((i > half)) {
+        leaf = right;
+        i -= half;
+      } 
+    } 
+    i32 after = (leaf->num_keys - i);
+    memmove((&leaf->keys[(i + 1)]), (&leaf->keys[i]), (after * sizeof(i64)));
+    memmove((&leaf->values[(i + 1)]), (&leaf->values[i]), (after * sizeof(i64)));
+    leaf->keys[i] = key;
+    leaf->values[i] = value;
+    leaf->num_keys += 1;
+    if (((bool)right)) 
+    (*split_key) = right->keys[0];
+    
+    return right;
+  } 
+  BTreeInner__i64_i64 *inner = ((BTreeInner__i64_i64 *)node);
+  i32 i = BTreeMap__i64_i64__child_index(this, inner, key);
+  i64 child_key;
+  void *child = BTreeMap__i64_i64__insert_into(this, inner->children[i], (level - 1), key, value, (&child_key));
+  if ((!((bool)child))) 
+  return NULL;
+  
+  BTreeInner__i64_i64 *right = ((BTreeInner__i64_i64 *)NULL);
+  if (inner->num_keys == BTREE_MAX_KEYS) {
+    right = ((BTreeInner__i64_i64 *)calloc(1, sizeof(BTreeInner__i64_i64)));
+    i32 half = (BTREE_MAX_KEYS / 2);
+    right->num_keys = ((inner->num_keys - half) - 1);
+    memcpy(right->keys, (&inner->keys[(half + 1)]), (right->num_keys * sizeof(i64)));
+    memcpy(right->children, (&inner->children[(half + 1)]), ((right->num_keys + 1) * sizeof(void *)));
+    (*split_key) = inner->keys[half];
+    inner->num_keys = half;
+    if ((i > half)) {
+      inner = right;
+      i -= (half + 1);
+    } 
+  } 
+  i32 after = (inner->num_keys - i);
+  memmove((&inner->keys[(i + 1)]), (&inner->keys[i]), (after * sizeof(i64)));
+  memmove((&inner->children[(i + 2)]), (&inner->children[(i + 1)]), (after * sizeof(void *)));
+  inner->keys[i] = child_key;
+  inner->children[(i + 1)] = child;
+  inner->num_keys += 1;
+  return right;
+}
+
+static __attribute__((unused)) void BTreeMap__i64_i64__insert(BTreeMap__i64_i64 *this, i64 key, i64 value) {
+  i64 split_key;
+  void *right = BTreeMap__i64_i64__insert_into(this, this->root, this->height, key, value, (&split_key));
+  if ((!((bool)right))) 
+  return;
+  
+  BTreeInner__i64_i64 *root = ((BTreeInner__i64_i64 *)calloc(1, sizeof(BTreeInner__i64_i64)));
+  root->num_keys = 1;
+  root->keys[0] = split_key;
+  root->children[0] = this->root;
+  root->children[1] = right;
+  this->root = root;
+  this->height += 1;
+}
+
+static __attribute__((unused)) BTreeMap__i64_i64 *BTreeMap__i64_i64__from_sorted(i64 *keys, i64 *values, i32 n, i32 (*compare)(i64, i64)) {
+  BTreeMap__i64_i64 *map = BTreeMap__i64_i64__new(compare);
+  if (n == 0) 
+  return map;
+  
+  free(map->root);
+  map->size = n;
+  i32 num_nodes = (((n + BTREE_MAX_KEYS) - 1) / BTREE_MAX_KEYS);
+  void **nodes = ((void **)calloc(num_nodes, sizeof(void *)));
+  i64 *min_keys = ((i64 *)calloc(num_nodes, sizeof(i64)));
+  BTreeLeaf__i64_i64 *prev = ((BTreeLeaf__i64_i64 *)NULL);
+  i32 start = 0;
+  for (i32 i = 0; (i < num_nodes); i += 1) {
+    i32 end = ((i32)((((i64)n) * ((i64)(i + 1))) / ((i64)num_nodes)));
+    BTreeLeaf__i64_i64 *leaf = ((BTreeLeaf__i64_i64 *)calloc(1, sizeof(BTreeLeaf__i64_i64)));
+    leaf->num_keys = (end - start);
+    memcpy(leaf->keys, (&keys[start]), (leaf->num_keys * sizeof(i64)));
+    memcpy(leaf->values, (&values[start]), (leaf->num_keys * sizeof(i64)));
+    (__builtin_expect(!!((start == 0 || (compare(keys[(start - 1)], keys[start]) < 0))), 1) ? (void)0 : panic("keys are not sorted"));
+    if (((bool)prev)) 
+    prev->next = leaf;
+    
+    prev = leaf;
+    nodes[i] = leaf;
+    min_keys[i] = keys[start];
+    start = end;
+  } 
+  while ((num_nodes > 1)) {
+    i32 num_parents = ((num_nodes + BTREE_MAX_KEYS) / (BTREE_MAX_KEYS + 1));
+    start = 0;
+    for (i32 i = 0; (i < num_parents); i += 1) {
+      i32 end = ((i32)((((i64)num_nodes) * ((i64)(i + 1))) / ((i64)num_parents)));
+      BTreeInner__i64_i64 *inner = ((BTreeInner__i64_i64 *)calloc(1, sizeof(BTreeInner__i64_i64)));
+      inner->num_keys = ((end - start) - 1);
+      for (i32 j = start; (j < end); j += 1) {
+        inner->children[(j - start)] = nodes[j];
+        if ((j > start)) 
+        inner->keys[((j - start) - 1)] = min_keys[j];
+        
+      } 
+      nodes[i] = inner;
+      min_keys[i] = min_keys[start];
+      start = end;
+    } 
+    num_nodes = num_parents;
+    map->height += 1;
+  } 
+  map->root = nodes[0];
+  free(nodes);
+  free(min_keys);
+  return map;
+}
+
+static __attribute__((unused)) void BTreeMap__i64_i64__free_node(BTreeMap__i64_i64 *this, void *node, i32 level) {
+  if ((level > 0)) {
+    BTreeInner__i64_i64 *inner = ((BTreeInner__i64_i64 *)node);
+    for (i32 i = 0; (i <= inner->num_keys); i += 1) {
+      BTreeMap__i64_i64__free_node(this, inner->children[i], (level - 1));
+    } 
+  } 
+  free(node);
+}
+
+static __attribute__((unused)) void BTreeMap__i64_i64__free(BTreeMap__i64_i64 *this) {
+  BTreeMap__i64_i64__free_node(this, this->root, this->height);
+}
+
+static __attribute__((unused)) BTreeIterator__i64_i64 BTreeMap__i64_i64__iter(BTreeMap__i64_i64 *this) {
+  void *node = this->root;
+  for (i32 level = this->height; (level > 0); level -= 1) {
+    node = ((BTreeInner__i64_i64 *)node)->children[0];
+  } 
+  BTreeIterator__i64_i64 it = (BTreeIterator__i64_i64){this, ((BTreeLeaf__i64_i64 *)node), 0, .has_end = false, .end = BTreeMap__i64_i64__zero_key(this)};
+  BTreeIterator__i64_i64__skip_empty((&it));
+  return it;
+}
+
+static __attribute__((unused)) BTreeIterator__i64_i64 BTreeMap__i64_i64__lower_bound(BTreeMap__i64_i64 *this, i64 key) {
+  BTreeLeaf__i64_i64 *leaf = BTreeMap__i64_i64__find_leaf(this, key);
+  i32 i = BTreeMap__i64_i64__lower_bound_in(this, leaf->keys, leaf->num_keys, key);
+  BTreeIterator__i64_i64 it = (BTreeIterator__i64_i64){this, leaf, i, .has_end = false, .end = key};
+  BTreeIterator__i64_i64__skip_empty((&it));
+  return it;
+}
+
+static __attribute__((unused)) BTreeIterator__i64_i64 BTreeMap__i64_i64__range(BTreeMap__i64_i64 *this, i64 lo, i64 hi) {
+  BTreeIterator__i64_i64 it = BTreeMap__i64_i64__lower_bound(this, lo);
+  it.has_end = true;
+  it.end = hi;
+  return it;
+}
+
+static __attribute__((unused)) i64 BTreeMap__i64_i64__zero_key(BTreeMap__i64_i64 *this) {
+  i64 unused;
+  memset((&unused), 0, sizeof(i64));
+  return unused;
+}
+
+static __attribute__((unused)) void BTreeIterator__i64_i64__skip_empty(BTreeIterator__i64_i64 *this) {
+  while ((((bool)this->leaf) && (this->idx >= this->leaf->num_keys))) {
+    this->leaf = this->leaf->next;
+    this->idx = 0;
+  } 
+}
+
+static __attribute__((unused)) bool BTreeIterator__i64_i64__valid(BTreeIterator__i64_i64 *this) {
+  if ((!((bool)this->leaf))) 
+  return false;
+  
+  if ((this->has_end && (this->map->compare(this->leaf->keys[this->idx], this->end) >= 0))) 
+  return false;
+  
+  return true;
+}
+
+static __attribute__((unused)) i64 BTreeIterator__i64_i64__key(BTreeIterator__i64_i64 *this) {
+  return this->leaf->keys[this->idx];
+}
+
+static __attribute__((unused)) i64 BTreeIterator__i64_i64__value(BTreeIterator__i64_i64 *this) {
+  return this->leaf->values[this->idx];
+}
+
+static __attribute__((unused)) i64 *BTreeIterator__i64_i64__value_ptr(BTreeIterator__i64_i64 *this) {
+  return (&this->leaf->values[this->idx]);
+}
+
+static __attribute__((unused)) void BTreeIterator__i64_i64__next(BTreeIterator__i64_i64 *this) {
+  this->idx += 1;
+  BTreeIterator__i64_i64__skip_empty(this);
+}
+
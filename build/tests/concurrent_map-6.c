@@ -0,0 +1,1687 @@
+#include "stdio.h"
+#include "stdlib.h"
+#include "stdbool.h"
+#include "stdint.h"
+#include "string.h"
+#include "errno.h"
+#include "ctype.h"
+#include "pthread.h"
+#include "sched.h"
+
+/***************** embed './lib/prelude.h' *****************/
+#include "stdarg.h"
+
+typedef int8_t i8;
+typedef int16_t i16;
+typedef int32_t i32;
+typedef int64_t i64;
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+
+typedef float f32;
+typedef double f64;
+
+// SIMD vector types, such as `f32x4`, using GCC's vector extensions
+#define AECOR_SIMD_TYPE(T, lanes) \
+  typedef T aecor_##T##x##lanes __attribute__((vector_size(sizeof(T) * lanes)));
+#define AECOR_SIMD_TYPES(T) \
+  AECOR_SIMD_TYPE(T, 2) AECOR_SIMD_TYPE(T, 4) AECOR_SIMD_TYPE(T, 8) \
+  AECOR_SIMD_TYPE(T, 16) AECOR_SIMD_TYPE(T, 32) AECOR_SIMD_TYPE(T, 64)
+
+AECOR_SIMD_TYPES(i8) AECOR_SIMD_TYPES(i16) AECOR_SIMD_TYPES(i32) AECOR_SIMD_TYPES(i64)
+AECOR_SIMD_TYPES(u8) AECOR_SIMD_TYPES(u16) AECOR_SIMD_TYPES(u32) AECOR_SIMD_TYPES(u64)
+AECOR_SIMD_TYPES(f32) AECOR_SIMD_TYPES(f64)
+
+#ifdef AECOR_TRACK_ALLOC
+// Allocation tracking for `--track-alloc`. Calls to `malloc`, `calloc`,
+// `realloc`, `free` and `strdup` in aecor code go through the functions
+// below, each with a static `aecor_alloc_site` for the call site. Live
+// blocks are kept in a side table keyed by pointer, so `free` still works
+// on memory allocated by C code, which is just not counted.
+//
+// Like `--instrument`, this is not synchronized between threads.
+typedef struct aecor_alloc_site {
+  const char* location;
+  u64 allocs;
+  u64 bytes;
+  u64 live;
+  u64 live_bytes;
+  struct aecor_alloc_site* next;
+} aecor_alloc_site;
+
+typedef struct {
+  void* ptr;
+  size_t size;
+  aecor_alloc_site* site;
+} aecor_alloc_block;
+
+static aecor_alloc_site* aecor_alloc_sites = NULL;
+static aecor_alloc_block* aecor_alloc_blocks = NULL;
+static size_t aecor_alloc_capacity = 0;  // Always a power of two
+static size_t aecor_alloc_count = 0;
+static u64 aecor_alloc_live_bytes = 0;
+static u64 aecor_alloc_peak_bytes = 0;
+
+// Site of the format string being built, set by the generated code
+static aecor_alloc_site aecor_alloc_unknown_format = {"<format string>"};
+static aecor_alloc_site* aecor_alloc_format_site = &aecor_alloc_unknown_format;
+
+static inline size_t aecor_alloc_slot(void* ptr) {
+  return ((uintptr_t)ptr >> 4) * 0x9e3779b97f4a7c15ull & (aecor_alloc_capacity - 1);
+}
+
+static void aecor_alloc_insert(aecor_alloc_block block) {
+  if ((aecor_alloc_count + 1) * 2 > aecor_alloc_capacity) {
+    aecor_alloc_block* old = aecor_alloc_blocks;
+    size_t old_capacity = aecor_alloc_capacity;
+    aecor_alloc_capacity = old_capacity ? old_capacity * 2 : 1024;
+    aecor_alloc_blocks = calloc(aecor_alloc_capacity, sizeof(aecor_alloc_block));
+    aecor_alloc_count = 0;
+    for (size_t i = 0; i < old_capacity; i++) {
+      if (old[i].ptr) aecor_alloc_insert(old[i]);
+    }
+    free(old);
+  }
+  size_t i = aecor_alloc_slot(block.ptr);
+  while (aecor_alloc_blocks[i].ptr) i = (i + 1) & (aecor_alloc_capacity - 1);
+  aecor_alloc_blocks[i] = block;
+  aecor_alloc_count++;
+}
+
+// Removes the block for `ptr` using backward-shift deletion, returning
+// false if it wasn't allocated by tracked code.
+static bool aecor_alloc_remove(void* ptr, aecor_alloc_block* out) {
+  if (!aecor_alloc_capacity) return false;
+  size_t mask = aecor_alloc_capacity - 1;
+  size_t i = aecor_alloc_slot(ptr);
+  while (aecor_alloc_blocks[i].ptr != ptr) {
+    if (!aecor_alloc_blocks[i].ptr) return false;
+    i = (i + 1) & mask;
+  }
+  *out = aecor_alloc_blocks[i];
+  for (size_t j = (i + 1) & mask; aecor_alloc_blocks[j].ptr; j = (j + 1) & mask) {
+    size_t home = aecor_alloc_slot(aecor_alloc_blocks[j].ptr);
+    // Move the entry into the hole unless its home slot is after the hole
+    if (((j - home) & mask) >= ((j - i) & mask)) {
+      aecor_alloc_blocks[i] = aecor_alloc_blocks[j];
+      i = j;
+    }
+  }
+  aecor_alloc_blocks[i].ptr = NULL;
+  aecor_alloc_count--;
+  return true;
+}
+
+static void aecor_alloc_record(void* ptr, size_t size, aecor_alloc_site* site) {
+  if (!ptr) return;
+  if (!site->allocs) {
+    site->next = aecor_alloc_sites;
+    aecor_alloc_sites = site;
+  }
+  site->allocs++;
+  site->bytes += size;
+  site->live++;
+  site->live_bytes += size;
+  aecor_alloc_live_bytes += size;
+  if (aecor_alloc_live_bytes > aecor_alloc_peak_bytes) {
+    aecor_alloc_peak_bytes = aecor_alloc_live_bytes;
+  }
+  aecor_alloc_insert((aecor_alloc_block){ptr, size, site});
+}
+
+static void aecor_alloc_forget(void* ptr) {
+  aecor_alloc_block block;
+  if (!ptr || !aecor_alloc_remove(ptr, &block)) return;
+  block.site->live--;
+  block.site->live_bytes -= block.size;
+  aecor_alloc_live_bytes -= block.size;
+}
+
+void* aecor_track_malloc(size_t size, aecor_alloc_site* site) {
+  void* ptr = malloc(size);
+  aecor_alloc_record(ptr, size, site);
+  return ptr;
+}
+
+void* aecor_track_calloc(size_t count, size_t size, aecor_alloc_site* site) {
+  void* ptr = calloc(count, size);
+  aecor_alloc_record(ptr, count * size, site);
+  return ptr;
+}
+
+void* aecor_track_realloc(void* old, size_t size, aecor_alloc_site* site) {
+  void* ptr = realloc(old, size);
+  if (!ptr && size) return ptr;
+  aecor_alloc_forget(old);
+  aecor_alloc_record(ptr, size, site);
+  return ptr;
+}
+
+char* aecor_track_strdup(const char* s, aecor_alloc_site* site) {
+  char* copy = strdup(s);
+  aecor_alloc_record(copy, strlen(s) + 1, site);
+  return copy;
+}
+
+void aecor_track_free(void* ptr) {
+  aecor_alloc_forget(ptr);
+  free(ptr);
+}
+
+static void* aecor_track_format_alloc(size_t size) {
+  aecor_alloc_site* site = aecor_alloc_format_site;
+  aecor_alloc_format_site = &aecor_alloc_unknown_format;
+  return aecor_track_malloc(size, site);
+}
+
+// Ties are broken by location, so reports from different runs can be diffed
+static int aecor_alloc_compare_bytes(const void* a, const void* b) {
+  aecor_alloc_site* sa = *(aecor_alloc_site**)a;
+  aecor_alloc_site* sb = *(aecor_alloc_site**)b;
+  if (sa->bytes != sb->bytes) return sa->bytes < sb->bytes ? 1 : -1;
+  return strcmp(sa->location, sb->location);
+}
+
+static int aecor_alloc_compare_live(const void* a, const void* b) {
+  aecor_alloc_site* sa = *(aecor_alloc_site**)a;
+  aecor_alloc_site* sb = *(aecor_alloc_site**)b;
+  if (sa->live_bytes != sb->live_bytes) return sa->live_bytes < sb->live_bytes ? 1 : -1;
+  return strcmp(sa->location, sb->location);
+}
+
+// Writes the sites that allocated the most bytes, followed by the ones
+// with memory that was never freed.
+static void aecor_alloc_report(void) {
+  const char* path = getenv("AECOR_ALLOC_REPORT");
+  if (!path) path = "aecor_alloc.txt";
+  FILE* file = fopen(path, "w");
+  if (!file) {
+    fprintf(stderr, "Could not write allocation report to %s\n", path);
+    return;
+  }
+
+  size_t count = 0;
+  u64 allocs = 0, bytes = 0, live = 0;
+  for (aecor_alloc_site* site = aecor_alloc_sites; site; site = site->next) {
+    count++;
+    allocs += site->allocs;
+    bytes += site->bytes;
+    live += site->live;
+  }
+  aecor_alloc_site** sites = malloc((count + 1) * sizeof(aecor_alloc_site*));
+  size_t n = 0;
+  for (aecor_alloc_site* site = aecor_alloc_sites; site; site = site->next) sites[n++] = site;
+
+  fprintf(file, "# %llu allocations, %llu bytes, peak %llu bytes live\n",
+          (unsigned long long)allocs, (unsigned long long)bytes,
+          (unsigned long long)aecor_alloc_peak_bytes);
+  fprintf(file, "# %llu blocks, %llu bytes never freed\n",
+          (unsigned long long)live, (unsigned long long)aecor_alloc_live_bytes);
+
+  const char* header = "# %12s %14s %12s %14s  %s\n";
+  const char* row = "%14llu %14llu %12llu %14llu  %s\n";
+  fprintf(file, "\n# Top allocators\n");
+  fprintf(file, header, "allocs", "bytes", "live", "live_bytes", "site");
+  qsort(sites, n, sizeof(aecor_alloc_site*), aecor_alloc_compare_bytes);
+  for (size_t i = 0; i < n; i++) {
+    aecor_alloc_site* site = sites[i];
+    fprintf(file, row, (unsigned long long)site->allocs, (unsigned long long)site->bytes,
+            (unsigned long long)site->live, (unsigned long long)site->live_bytes, site->location);
+  }
+
+  fprintf(file, "\n# Leaks\n");
+  fprintf(file, header, "allocs", "bytes", "live", "live_bytes", "site");
+  qsort(sites, n, sizeof(aecor_alloc_site*), aecor_alloc_compare_live);
+  for (size_t i = 0; i < n && sites[i]->live; i++) {
+    aecor_alloc_site* site = sites[i];
+    fprintf(file, row, (unsigned long long)site->allocs, (unsigned long long)site->bytes,
+            (unsigned long long)site->live, (unsigned long long)site->live_bytes, site->location);
+  }
+  free(sites);
+  fclose(file);
+}
+
+__attribute__((constructor)) static void aecor_alloc_init(void) {
+  atexit(aecor_alloc_report);
+}
+
+#define AECOR_FORMAT_ALLOC aecor_track_format_alloc
+#else
+#define AECOR_FORMAT_ALLOC malloc
+#endif
+
+// Formats into `stack` if the result fits in `capacity` bytes, otherwise
+// returns a new heap-allocated string that the caller needs to free.
+char* format_string_into(char* stack, int capacity, const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  int size = vsnprintf(stack, capacity, format, args);
+  va_end(args);
+  if (size < capacity) return stack;
+  char* s = malloc(size + 1);
+  va_start(args, format);
+  vsnprintf(s, size + 1, format, args);
+  va_end(args);
+  return s;
+}
+
+// Formats into a stack buffer first since most formatted strings are short,
+// which saves a separate pass just to compute the size.
+static char* aecor_vformat(void* (*alloc)(size_t), const char* format, va_list args) {
+  char stack[256];
+  va_list copy;
+  va_copy(copy, args);
+  int size = vsnprintf(stack, sizeof(stack), format, copy);
+  va_end(copy);
+  char* s = alloc(size + 1);
+  if (size < (int)sizeof(stack)) {
+    memcpy(s, stack, size + 1);
+  } else {
+    vsnprintf(s, size + 1, format, args);
+  }
+  return s;
+}
+
+char* format_string(const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  char* s = aecor_vformat(AECOR_FORMAT_ALLOC, format, args);
+  va_end(args);
+  return s;
+}
+
+// Scratch arena backing `scratch { ... }` blocks. Memory is handed out from a
+// list of chunks with a bump pointer, and everything allocated inside a block
+// is released at once when it ends by restoring the position saved on entry.
+// Chunks past the current one are kept around to be reused. Each thread has
+// its own arena.
+//
+// Format strings built inside a block come from the arena as well, so they
+// must not be passed to `free` or to anything that frees them, such as
+// `Buffer::putsf`, and must be copied to outlive the block.
+#define AECOR_SCRATCH_CHUNK_SIZE (64 * 1024)
+
+typedef struct aecor_scratch_chunk {
+  struct aecor_scratch_chunk* next;
+  size_t capacity;
+  size_t used;
+  char data[];
+} aecor_scratch_chunk;
+
+typedef struct {
+  aecor_scratch_chunk* chunk;
+  size_t used;
+} aecor_scratch_mark;
+
+static __thread aecor_scratch_chunk* aecor_scratch_first = NULL;
+static __thread aecor_scratch_chunk* aecor_scratch_current = NULL;
+
+void* scratch_alloc(size_t size) {
+  size = (size + 15) & ~(size_t)15;
+  aecor_scratch_chunk* chunk = aecor_scratch_current;
+  if (!chunk || chunk->used + size > chunk->capacity) {
+    aecor_scratch_chunk** link = chunk ? &chunk->next : &aecor_scratch_first;
+    if (!*link || (*link)->capacity < size) {
+      size_t capacity = size > AECOR_SCRATCH_CHUNK_SIZE ? size : AECOR_SCRATCH_CHUNK_SIZE;
+      aecor_scratch_chunk* fresh = malloc(sizeof(aecor_scratch_chunk) + capacity);
+      if (!fresh) {
+        printf("Out of memory!\n");
+        exit(1);
+      }
+      fresh->capacity = capacity;
+      fresh->next = *link;
+      *link = fresh;
+    }
+    chunk = *link;
+    chunk->used = 0;
+    aecor_scratch_current = chunk;
+  }
+  void* ptr = chunk->data + chunk->used;
+  chunk->used += size;
+  return ptr;
+}
+
+aecor_scratch_mark aecor_scratch_save() {
+  aecor_scratch_chunk* chunk = aecor_scratch_current;
+  return (aecor_scratch_mark){chunk, chunk ? chunk->used : 0};
+}
+
+void aecor_scratch_restore(aecor_scratch_mark* mark) {
+  aecor_scratch_current = mark->chunk;
+  if (mark->chunk) mark->chunk->used = mark->used;
+}
+
+char* format_string_scratch(const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  char* s = aecor_vformat(scratch_alloc, format, args);
+  va_end(args);
+  return s;
+}
+
+// Output buffer for `print` / `println` when compiling with `-b`. Writes are
+// collected here and handed to stdio in large chunks, which avoids paying
+// for `printf`'s locking and format parsing on every call.
+//
+// Once a second thread has been started (see `Thread::spawn`), the buffer is
+// guarded by a spinlock. It is only held for a `memcpy` or a flush, once per
+// `print`, and single-threaded programs don't pay for it at all.
+#define AECOR_STDOUT_BUFFER_SIZE (64 * 1024)
+
+static char aecor_stdout_buffer[AECOR_STDOUT_BUFFER_SIZE];
+static size_t aecor_stdout_size = 0;
+static char aecor_stdout_locked = 0;
+
+// Set before the first thread is created, so that thread sees it too
+bool aecor_multithreaded = false;
+
+static inline void aecor_stdout_lock(void) {
+  if (!aecor_multithreaded) return;
+  while (__atomic_test_and_set(&aecor_stdout_locked, __ATOMIC_ACQUIRE)) {
+    while (__atomic_load_n(&aecor_stdout_locked, __ATOMIC_RELAXED)) {}
+  }
+}
+
+static inline void aecor_stdout_unlock(void) {
+  if (!aecor_multithreaded) return;
+  __atomic_clear(&aecor_stdout_locked, __ATOMIC_RELEASE);
+}
+
+// Must be called with the lock held
+static void aecor_stdout_flush_locked(void) {
+  fwrite(aecor_stdout_buffer, 1, aecor_stdout_size, stdout);
+  fflush(stdout);
+  aecor_stdout_size = 0;
+}
+
+void aecor_stdout_flush(void) {
+  aecor_stdout_lock();
+  aecor_stdout_flush_locked();
+  aecor_stdout_unlock();
+}
+
+__attribute__((constructor)) static void aecor_stdout_init(void) {
+  atexit(aecor_stdout_flush);
+}
+
+static inline void aecor_stdout_write(const char* s, size_t len) {
+  aecor_stdout_lock();
+  if (aecor_stdout_size + len > AECOR_STDOUT_BUFFER_SIZE) {
+    aecor_stdout_flush_locked();
+    if (len > AECOR_STDOUT_BUFFER_SIZE) {
+      fwrite(s, 1, len, stdout);
+      aecor_stdout_unlock();
+      return;
+    }
+  }
+  memcpy(aecor_stdout_buffer + aecor_stdout_size, s, len);
+  aecor_stdout_size += len;
+  aecor_stdout_unlock();
+}
+
+// The pieces of one `print` with a format string are collected in a line on
+// the stack and added to the buffer at once, so lines printed by different
+// threads never interleave. Arguments are evaluated outside the lock, so
+// they can print too.
+typedef struct {
+  char* data;
+  size_t size;
+  size_t capacity;
+  char stack[256];
+} aecor_stdout_line;
+
+static inline void aecor_stdout_line_init(aecor_stdout_line* line) {
+  line->data = line->stack;
+  line->size = 0;
+  line->capacity = sizeof(line->stack);
+}
+
+static void aecor_stdout_line_grow(aecor_stdout_line* line, size_t min_capacity) {
+  size_t capacity = line->capacity * 2;
+  if (capacity < min_capacity) capacity = min_capacity;
+  if (line->data == line->stack) {
+    line->data = malloc(capacity);
+    memcpy(line->data, line->stack, line->size);
+  } else {
+    line->data = realloc(line->data, capacity);
+  }
+  line->capacity = capacity;
+}
+
+static inline void aecor_stdout_write_line(aecor_stdout_line* line, const char* s, size_t len) {
+  if (line->size + len > line->capacity) aecor_stdout_line_grow(line, line->size + len);
+  memcpy(line->data + line->size, s, len);
+  line->size += len;
+}
+
+void aecor_stdout_line_finish(aecor_stdout_line* line) {
+  aecor_stdout_write(line->data, line->size);
+  if (line->data != line->stack) free(line->data);
+}
+
+void aecor_stdout_puts(aecor_stdout_line* line, const char* s) {
+  aecor_stdout_write_line(line, s, strlen(s));
+}
+
+// Prints "(null)" for a null string, like `printf` does
+void aecor_stdout_put_str(aecor_stdout_line* line, const char* s) {
+  aecor_stdout_puts(line, s ? s : "(null)");
+}
+
+static inline void aecor_stdout_putc(aecor_stdout_line* line, char c) {
+  if (line->size == line->capacity) aecor_stdout_line_grow(line, line->size + 1);
+  line->data[line->size++] = c;
+}
+
+void aecor_stdout_put_u64(aecor_stdout_line* line, u64 value) {
+  char digits[20];
+  int len = 0;
+  do {
+    digits[sizeof(digits) - ++len] = '0' + value % 10;
+    value /= 10;
+  } while (value);
+  aecor_stdout_write_line(line, digits + sizeof(digits) - len, len);
+}
+
+void aecor_stdout_put_i64(aecor_stdout_line* line, i64 value) {
+  if (value < 0) {
+    aecor_stdout_putc(line, '-');
+    aecor_stdout_put_u64(line, -(u64)value);
+  } else {
+    aecor_stdout_put_u64(line, value);
+  }
+}
+
+void aecor_stdout_put_f64(aecor_stdout_line* line, f64 value) {
+  char stack[64];
+  char* s = format_string_into(stack, sizeof(stack), "%f", value);
+  aecor_stdout_puts(line, s);
+  if (s != stack) free(s);
+}
+
+void aecor_stdout_put_ptr(aecor_stdout_line* line, void* value) {
+  char stack[32];
+  aecor_stdout_puts(line, format_string_into(stack, sizeof(stack), "%p", value));
+}
+
+// Used for anything that isn't a format string literal, which is printed
+// with a single write.
+int aecor_stdout_printf(const char* format, ...) {
+  char stack[256];
+  va_list args;
+  va_start(args, format);
+  int size = vsnprintf(stack, sizeof(stack), format, args);
+  va_end(args);
+  if (size < (int)sizeof(stack)) {
+    aecor_stdout_write(stack, size);
+  } else {
+    char* s = malloc(size + 1);
+    va_start(args, format);
+    vsnprintf(s, size + 1, format, args);
+    va_end(args);
+    aecor_stdout_write(s, size);
+    free(s);
+  }
+  return size;
+}
+
+// FNV-1a with a murmur3 finalizer, used for hashed dispatch on strings.
+// Must be kept in sync with `hash_string` in `compiler/utils.ae`.
+u32 aecor_hash_str(const char* s, u32 seed) {
+  u32 hash = seed;
+  for (; *s; s++) {
+    hash = (hash ^ (u8)*s) * 16777619u;
+  }
+  hash = (hash ^ (hash >> 16)) * 0x85ebca6bu;
+  hash = (hash ^ (hash >> 13)) * 0xc2b2ae35u;
+  return hash ^ (hash >> 16);
+}
+
+#ifdef AECOR_INSTRUMENT
+#include <time.h>
+
+// Per-function profiling for `--instrument`. Every instrumented function
+// pushes a frame on entry, which is popped by a `cleanup` handler whenever
+// the function returns. Time spent in instrumented callees is subtracted
+// from the caller's exclusive time. Recursive calls only count towards
+// inclusive time once, for the outermost call.
+//
+// Counters are not synchronized, so this is only accurate for programs
+// that call instrumented functions from a single thread.
+typedef struct {
+  const char* name;
+  const char* location;
+  u64 calls;
+  u64 inclusive_ns;
+  u64 exclusive_ns;
+  u32 active;
+} aecor_prof_entry;
+
+typedef struct aecor_prof_frame {
+  aecor_prof_entry* entry;
+  struct aecor_prof_frame* parent;
+  u64 start;
+  u64 children;
+} aecor_prof_frame;
+
+// Defined at the end of the generated code, one entry per function
+extern aecor_prof_entry aecor_prof_table[];
+extern u32 aecor_prof_count;
+
+static __thread aecor_prof_frame* aecor_prof_current = NULL;
+
+static inline u64 aecor_prof_now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (u64)ts.tv_sec * 1000000000ull + (u64)ts.tv_nsec;
+}
+
+static inline void aecor_prof_enter(aecor_prof_frame* frame, u32 id) {
+  frame->entry = &aecor_prof_table[id];
+  frame->entry->calls++;
+  frame->entry->active++;
+  frame->parent = aecor_prof_current;
+  frame->children = 0;
+  aecor_prof_current = frame;
+  frame->start = aecor_prof_now();
+}
+
+static inline void aecor_prof_exit(aecor_prof_frame* frame) {
+  u64 elapsed = aecor_prof_now() - frame->start;
+  aecor_prof_entry* entry = frame->entry;
+  entry->active--;
+  if (entry->active == 0) entry->inclusive_ns += elapsed;
+  entry->exclusive_ns += elapsed - frame->children;
+  if (frame->parent) frame->parent->children += elapsed;
+  aecor_prof_current = frame->parent;
+}
+
+// Writes one line per function that was called, in declaration order so
+// that reports from different runs can be diffed directly. The output is
+// whitespace separated for `sort -k`, e.g. `sort -k3 -n -r` for the
+// functions with the most exclusive time.
+static void aecor_prof_report(void) {
+  // Functions still running when `exit()` was called end here
+  while (aecor_prof_current) aecor_prof_exit(aecor_prof_current);
+
+  const char* path = getenv("AECOR_PROFILE");
+  if (!path) path = "aecor_profile.txt";
+  FILE* file = fopen(path, "w");
+  if (!file) {
+    fprintf(stderr, "Could not write profile to %s\n", path);
+    return;
+  }
+  fprintf(file, "# %12s %16s %16s  %s  %s\n",
+          "calls", "inclusive_ns", "exclusive_ns", "function", "location");
+  for (u32 i = 0; i < aecor_prof_count; i++) {
+    aecor_prof_entry* entry = &aecor_prof_table[i];
+    if (entry->calls == 0) continue;
+    fprintf(file, "%14llu %16llu %16llu  %s  %s\n",
+            (unsigned long long)entry->calls,
+            (unsigned long long)entry->inclusive_ns,
+            (unsigned long long)entry->exclusive_ns,
+            entry->name, entry->location);
+  }
+  fclose(file);
+}
+
+__attribute__((constructor)) static void aecor_prof_init(void) {
+  atexit(aecor_prof_report);
+}
+#endif
+
+
+/* constants */
+const i32 VECTOR_INLINE_CAPACITY = 4;
+const i32 VECTOR_MAX_INLINE_CAPACITY = 8;
+const i32 HASHMAP_GROUP = 8;
+const i32 HASHMAP_EMPTY = 0x80;
+const i32 HASHMAP_DELETED = 0xFE;
+const u64 HASHMAP_LSBS = 0x0101010101010101ULL;
+const u64 HASHMAP_MSBS = 0x8080808080808080ULL;
+const i32 CONCURRENT_MAP_READ_RETRIES = 4;
+const i32 CONCURRENT_MAP_CACHE_LINE = 64;
+const i32 NUM_WRITERS = 4;
+const i32 NUM_READERS = 4;
+const i32 KEYS_PER_WRITER = 10000;
+
+/* struct declarations */
+typedef struct Vector Vector;
+typedef struct HashMapSlot HashMapSlot;
+typedef struct HashMap HashMap;
+typedef struct HashMapIterator HashMapIterator;
+typedef struct ConcurrentTable ConcurrentTable;
+typedef struct MapShard MapShard;
+typedef struct ConcurrentMap ConcurrentMap;
+typedef struct Worker Worker;
+typedef struct Vector__ptr_Thread Vector__ptr_Thread;
+
+struct Vector {
+  i32 size;
+  i32 capacity;
+  void **data;
+  bool is_inline;
+};
+
+struct HashMapSlot {
+  u64 hash;
+  char *key;
+  void *value;
+};
+
+struct HashMap {
+  u8 *ctrl;
+  HashMapSlot *slots;
+  i32 capacity;
+  i32 num_items;
+  i32 growth_left;
+};
+
+struct HashMapIterator {
+  i32 idx;
+  HashMapSlot *cur;
+  HashMap *map;
+};
+
+struct ConcurrentTable {
+  u8 *ctrl;
+  HashMapSlot *slots;
+  i32 capacity;
+  i32 growth_left;
+  ConcurrentTable *retired;
+};
+
+struct MapShard {
+  pthread_mutex_t lock;
+  u32 seq;
+  i32 num_items;
+  ConcurrentTable *table;
+};
+
+struct ConcurrentMap {
+  MapShard **shards;
+  i32 num_shards;
+};
+
+struct Worker {
+  ConcurrentMap *map;
+  char **keys;
+  i32 id;
+  i32 errors;
+};
+
+struct Vector__ptr_Thread {
+  i32 size;
+  i32 capacity;
+  pthread_t **data;
+};
+
+/* function declarations */
+static __attribute__((unused)) FILE *File__open(char *path, char *mode);
+static __attribute__((unused)) bool File__exists(char *path);
+static __attribute__((unused)) i32 File__size(FILE *this);
+static __attribute__((unused)) char *File__slurp(FILE *this);
+static __attribute__((unused)) i32 File__read(FILE *this, void *buf, i32 size);
+static __attribute__((unused)) i32 File__write(FILE *this, void *buf, i32 size);
+static __attribute__((unused)) void File__puts(FILE *this, char *str);
+static __attribute__((unused)) __attribute__((noreturn)) __attribute__((cold)) void panic(char *msg);
+static __attribute__((unused)) bool string__starts_with(char *this, char *prefix);
+static __attribute__((unused)) bool string__ends_with(char *this, char *suffix);
+static __attribute__((unused)) void string__remove_last_n(char *this, i32 n);
+static __attribute__((unused)) bool string__eq(char *this, char *str2);
+static __attribute__((unused)) char *string__substring(char *this, i32 start, i32 len);
+static __attribute__((unused)) void string__strip_trailing_whitespace(char *this);
+static __attribute__((unused)) i32 min(i32 a, i32 b);
+static __attribute__((unused)) i32 max(i32 a, i32 b);
+static inline __attribute__((unused)) __attribute__((always_inline)) void **Vector__inline_data(Vector *this);
+static __attribute__((unused)) Vector *Vector__new_sized(i32 capacity);
+static __attribute__((unused)) Vector *Vector__new(void);
+static __attribute__((unused)) void Vector__resize(Vector *this, i32 new_capacity);
+static inline __attribute__((unused)) __attribute__((always_inline)) i32 Vector__next_capacity(Vector *this);
+static inline __attribute__((unused)) __attribute__((always_inline)) void Vector__push(Vector *this, void *val);
+static __attribute__((unused)) void Vector__push_front(Vector *this, void *val);
+static __attribute__((unused)) void *Vector__pop(Vector *this);
+static inline __attribute__((unused)) __attribute__((always_inline)) void *Vector__back(Vector *this);
+static inline __attribute__((unused)) __attribute__((always_inline)) void *Vector__at(Vector *this, i32 i);
+static inline __attribute__((unused)) __attribute__((always_inline)) bool Vector__empty(Vector *this);
+static __attribute__((unused)) void Vector__free(Vector *this);
+static __attribute__((unused)) u64 HashMap__hash(char *s);
+static __attribute__((unused)) u64 hashmap_match_byte(u64 group, u8 byte);
+static __attribute__((unused)) u64 hashmap_match_empty(u64 group);
+static __attribute__((unused)) u64 hashmap_match_free(u64 group);
+static inline __attribute__((unused)) __attribute__((always_inline)) u8 hashmap_h2(u64 hash);
+static inline __attribute__((unused)) __attribute__((always_inline)) i32 hashmap_start(u64 hash, i32 capacity);
+static __attribute__((unused)) i32 hashmap_resize_capacity(i32 num_items, i32 capacity);
+static __attribute__((unused)) u64 HashMapSlot__hash_of(HashMapSlot *slot);
+static __attribute__((unused)) bool HashMapSlot__matches(HashMapSlot *slot, char *key, u64 hash);
+static __attribute__((unused)) HashMap *HashMap__new_sized(i32 capacity);
+static __attribute__((unused)) HashMap *HashMap__new(void);
+static __attribute__((unused)) i32 HashMap__find(HashMap *this, char *key, u64 hash);
+static __attribute__((unused)) void *HashMap__get(HashMap *this, char *key);
+static __attribute__((unused)) bool HashMap__exists(HashMap *this, char *key);
+static __attribute__((unused)) void HashMap__insert(HashMap *this, char *key, void *value);
+static __attribute__((unused)) void *HashMap__remove(HashMap *this, char *key);
+static __attribute__((unused)) void HashMap__resize(HashMap *this);
+static __attribute__((unused)) void HashMap__print_keys(HashMap *this);
+static __attribute__((unused)) void HashMap__push_keys(HashMap *this, Vector *vec);
+static __attribute__((unused)) void HashMap__free(HashMap *this);
+static __attribute__((unused)) HashMapIterator HashMap__iter(HashMap *this);
+static __attribute__((unused)) char *HashMapIterator__key(HashMapIterator *this);
+static __attribute__((unused)) void *HashMapIterator__value(HashMapIterator *this);
+static __attribute__((unused)) HashMapIterator HashMapIterator__make(HashMap *map);
+static __attribute__((unused)) void HashMapIterator__next(HashMapIterator *this);
+static __attribute__((unused)) pthread_t *Thread__spawn(void *(*func)(void *), void *arg);
+static __attribute__((unused)) void *Thread__join(pthread_t *this);
+static __attribute__((unused)) void Mutex__init(pthread_mutex_t *this);
+static __attribute__((unused)) ConcurrentTable *ConcurrentTable__new(i32 capacity, i32 num_items);
+static __attribute__((unused)) i32 ConcurrentTable__find(ConcurrentTable *this, char *key, u64 hash);
+static __attribute__((unused)) void ConcurrentTable__put(ConcurrentTable *this, i32 index, HashMapSlot slot);
+static __attribute__((unused)) void ConcurrentTable__free(ConcurrentTable *this);
+static __attribute__((unused)) void ConcurrentTable__clear_deleted(ConcurrentTable *this, i32 num_items);
+static __attribute__((unused)) void MapShard__begin_write(MapShard *this);
+static __attribute__((unused)) void MapShard__end_write(MapShard *this);
+static __attribute__((unused)) void MapShard__resize(MapShard *this);
+static __attribute__((unused)) ConcurrentMap *ConcurrentMap__new(i32 num_shards);
+static __attribute__((unused)) MapShard *ConcurrentMap__shard(ConcurrentMap *this, u64 hash);
+static __attribute__((unused)) void *ConcurrentMap__lookup(ConcurrentMap *this, char *key, bool *found);
+static __attribute__((unused)) void *ConcurrentMap__get(ConcurrentMap *this, char *key);
+static __attribute__((unused)) bool ConcurrentMap__exists(ConcurrentMap *this, char *key);
+static __attribute__((unused)) void ConcurrentMap__insert(ConcurrentMap *this, char *key, void *value);
+static __attribute__((unused)) void *ConcurrentMap__remove(ConcurrentMap *this, char *key);
+static __attribute__((unused)) i32 ConcurrentMap__num_items(ConcurrentMap *this);
+static __attribute__((unused)) i32 ConcurrentMap__num_retired(ConcurrentMap *this);
+static __attribute__((unused)) void ConcurrentMap__push_keys(ConcurrentMap *this, Vector *vec);
+static __attribute__((unused)) void ConcurrentMap__free(ConcurrentMap *this);
+static __attribute__((unused)) void *writer(void *arg);
+static __attribute__((unused)) void *reader(void *arg);
+i32 main(void);
+static __attribute__((unused)) Vector__ptr_Thread *Vector__ptr_Thread__new_sized(i32 capacity);
+static __attribute__((unused)) Vector__ptr_Thread *Vector__ptr_Thread__new(void);
+static __attribute__((unused)) void Vector__ptr_Thread__resize(Vector__ptr_Thread *this, i32 new_capacity);
+static inline __attribute__((unused)) __attribute__((always_inline)) void Vector__ptr_Thread__push(Vector__ptr_Thread *this, pthread_t *val);
+static __attribute__((unused)) pthread_t *Vector__ptr_Thread__pop(Vector__ptr_Thread *this);
+static inline __attribute__((unused)) __attribute__((always_inline)) pthread_t *Vector__ptr_Thread__back(Vector__ptr_Thread *this);
+static inline __attribute__((unused)) __attribute__((always_inline)) pthread_t *Vector__ptr_Thread__at(Vector__ptr_Thread *this, i32 i);
+static inline __attribute__((unused)) __attribute__((always_inline)) pthread_t **Vector__ptr_Thread__at_ptr(Vector__ptr_Thread *this, i32 i);
+static inline __attribute__((unused)) __attribute__((always_inline)) bool Vector__ptr_Thread__empty(Vector__ptr_Thread *this);
+static __attribute__((unused)) void Vector__ptr_Thread__free(Vector__ptr_Thread *this);
+static __attribute__((unused)) void hashmap_erase__ConcurrentTable(ConcurrentTable *map, i32 index);
+static __attribute__((unused)) i32 hashmap_claim__ConcurrentTable(ConcurrentTable *map, u64 hash);
+static __attribute__((unused)) i32 hashmap_find_free__ConcurrentTable(ConcurrentTable *map, u64 hash);
+static __attribute__((unused)) void hashmap_rehash__ConcurrentTable_HashMapSlot(ConcurrentTable *map, u8 *old_ctrl, HashMapSlot *old_slots, i32 old_capacity);
+static inline __attribute__((unused)) __attribute__((always_inline)) u64 hashmap_group__ConcurrentTable(ConcurrentTable *map, i32 index);
+static __attribute__((unused)) void hashmap_alloc__ConcurrentTable_HashMapSlot(ConcurrentTable *map, i32 min_capacity, i32 num_items);
+static __attribute__((unused)) i32 hashmap_next_item__HashMap(HashMap *map, i32 index);
+static __attribute__((unused)) void hashmap_resize__HashMap_HashMapSlot(HashMap *map, i32 num_items);
+static __attribute__((unused)) void hashmap_rehash__HashMap_HashMapSlot(HashMap *map, u8 *old_ctrl, HashMapSlot *old_slots, i32 old_capacity);
+static __attribute__((unused)) i32 hashmap_find_free__HashMap(HashMap *map, u64 hash);
+static inline __attribute__((unused)) __attribute__((always_inline)) u64 hashmap_group__HashMap(HashMap *map, i32 index);
+static __attribute__((unused)) void hashmap_erase__HashMap(HashMap *map, i32 index);
+static __attribute__((unused)) i32 hashmap_claim__HashMap(HashMap *map, u64 hash);
+static __attribute__((unused)) i32 hashmap_find__HashMap_HashMapSlot_ptr_char(HashMap *map, char *key, u64 hash);
+static __attribute__((unused)) void hashmap_alloc__HashMap_HashMapSlot(HashMap *map, i32 min_capacity, i32 num_items);
+
+/* global variables */
+
+static __attribute__((unused)) FILE *File__open(char *path, char *mode) {
+  FILE *file = fopen(path, mode);
+  if ((!((bool)file))) {
+    printf("Error opening file '%s': %s""\n", path, strerror(errno));
+    exit(1);
+  } 
+  return file;
+}
+
+static __attribute__((unused)) bool File__exists(char *path) {
+  FILE *file = fopen(path, "r");
+  if ((!((bool)file))) {
+    return false;
+  } 
+  fclose(file);
+  return true;
+}
+
+static __attribute__((unused)) i32 File__size(FILE *this) {
+  i32 pos = ftell(this);
+  fseek(this, 0, SEEK_END);
+  i32 size = ftell(this);
+  fseek(this, pos, SEEK_SET);
+  return size;
+}
+
+static __attribute__((unused)) char *File__slurp(FILE *this) {
+  i32 pos = ftell(this);
+  fseek(this, 0, SEEK_END);
+  i32 size = ftell(this);
+  fseek(this, pos, SEEK_SET);
+  void *buf = calloc((size + 1), sizeof(char));
+  fread(buf, 1, size, this);
+  fseek(this, pos, SEEK_SET);
+  return ((char *)buf);
+}
+
+static __attribute__((unused)) i32 File__read(FILE *this, void *buf, i32 size) {
+  return fread(buf, 1, size, this);
+}
+
+static __attribute__((unused)) i32 File__write(FILE *this, void *buf, i32 size) {
+  return fwrite(buf, 1, size, this);
+}
+
+static __attribute__((unused)) void File__puts(FILE *this, char *str) {
+  fwrite(str, 1, strlen(str), this);
+}
+
+static __attribute__((unused)) __attribute__((noreturn)) __attribute__((cold)) void panic(char *msg) {
+  printf("%s""\n", msg);
+  aecor_stdout_flush();
+  exit(1);
+}
+
+static __attribute__((unused)) bool string__starts_with(char *this, char *prefix) {
+  i32 prefix_len = strlen(prefix);
+  if ((strlen(this) < prefix_len)) {
+    return false;
+  } 
+  return strncmp(this, prefix, prefix_len) == 0;
+}
+
+static __attribute__((unused)) bool string__ends_with(char *this, char *suffix) {
+  i32 suffix_len = strlen(suffix);
+  if ((strlen(this) < suffix_len)) {
+    return false;
+  } 
+  return strncmp(this, suffix, suffix_len) == 0;
+}
+
+static __attribute__((unused)) void string__remove_last_n(char *this, i32 n) {
+  this[(strlen(this) - n)] = '\0';
+}
+
+static __attribute__((unused)) bool string__eq(char *this, char *str2) {
+  return strcmp(this, str2) == 0;
+}
+
+static __attribute__((unused)) char *string__substring(char *this, i32 start, i32 len) {
+  char *new_str = ((char *)calloc((len + 1), sizeof(char)));
+  memcpy(new_str, (this + start), len);
+  return new_str;
+}
+
+static __attribute__((unused)) void string__strip_trailing_whitespace(char *this) {
+  for (i32 i = (strlen(this) - 1); (i >= 0); i -= 1) {
+    if ((this[i] != ' ')) 
+    break;
+    
+    this[i] = '\0';
+  } 
+}
+
+static __attribute__((unused)) i32 min(i32 a, i32 b) {
+  return ((a < b) ? a : b);
+}
+
+static __attribute__((unused)) i32 max(i32 a, i32 b) {
+  return ((a > b) ? a : b);
+}
+
+static inline __attribute__((unused)) __attribute__((always_inline)) void **Vector__inline_data(Vector *this) {
+  return ((void **)(((u8 *)this) + sizeof(Vector)));
+}
+
+static __attribute__((unused)) Vector *Vector__new_sized(i32 capacity) {
+  if ((capacity <= VECTOR_MAX_INLINE_CAPACITY)) {
+    Vector *vec = ((Vector *)calloc(1, (sizeof(Vector) + (capacity * sizeof(void *)))));
+    vec->capacity = capacity;
+    if ((capacity > 0)) {
+      vec->data = Vector__inline_data(vec);
+      vec->is_inline = true;
+    } 
+    return vec;
+  } 
+  Vector *vec = ((Vector *)calloc(1, sizeof(Vector)));
+  vec->size = 0;
+  vec->capacity = capacity;
+  vec->data = ((void **)calloc(vec->capacity, sizeof(void *)));
+  return vec;
+}
+
+static __attribute__((unused)) Vector *Vector__new(void) {
+  return Vector__new_sized(VECTOR_INLINE_CAPACITY);
+}
+
+static __attribute__((unused)) void Vector__resize(Vector *this, i32 new_capacity) {
+  if (this->is_inline) {
+    void **data = ((void **)malloc((new_capacity * sizeof(void *))));
+    memcpy(data, this->data, (this->size * sizeof(void *)));
+    this->data = data;
+    this->is_inline = false;
+  }  else {
+    this->data = ((void **)realloc(this->data, (new_capacity * sizeof(void *))));
+  } 
+  this->capacity = new_capacity;
+}
+
+static inline __attribute__((unused)) __attribute__((always_inline)) i32 Vector__next_capacity(Vector *this) {
+  return max((this->capacity * 2), VECTOR_INLINE_CAPACITY);
+}
+
+static inline __attribute__((unused)) __attribute__((always_inline)) void Vector__push(Vector *this, void *val) {
+  if (this->size == this->capacity) {
+    Vector__resize(this, Vector__next_capacity(this));
+  } 
+  this->data[this->size] = val;
+  this->size += 1;
+}
+
+static __attribute__((unused)) void Vector__push_front(Vector *this, void *val) {
+  if (this->size == this->capacity) {
+    Vector__resize(this, Vector__next_capacity(this));
+  } 
+  memmove((this->data + 1), this->data, (this->size * sizeof(void *)));
+  this->data[0] = val;
+  this->size += 1;
+}
+
+static __attribute__((unused)) void *Vector__pop(Vector *this) {
+  (__builtin_expect(!!((this->size > 0)), 1) ? (void)0 : panic("pop on empty vector"));
+  this->size -= 1;
+  return this->data[this->size];
+}
+
+static inline __attribute__((unused)) __attribute__((always_inline)) void *Vector__back(Vector *this) {
+  (__builtin_expect(!!((this->size > 0)), 1) ? (void)0 : panic("back on empty vector"));
+  return this->data[(this->size - 1)];
+}
+
+static inline __attribute__((unused)) __attribute__((always_inline)) void *Vector__at(Vector *this, i32 i) {
+  (__builtin_expect(!!(((i >= 0) && (i < this->size))), 1) ? (void)0 : panic("at out of bounds in vector"));
+  return this->data[i];
+}
+
+static inline __attribute__((unused)) __attribute__((always_inline)) bool Vector__empty(Vector *this) {
+  return this->size == 0;
+}
+
+static __attribute__((unused)) void Vector__free(Vector *this) {
+  if ((!this->is_inline)) 
+  free(this->data);
+  
+  free(this);
+}
+
+static __attribute__((unused)) u64 HashMap__hash(char *s) {
+  u64 hash = 0xcbf29ce484222325ULL;
+  for (i32 i = 0; (s[i] != '\0'); i += 1) {
+    hash = ((hash ^ ((u64)((u8)s[i]))) * 0x100000001b3ULL);
+  } 
+  hash = (hash ^ (hash >> 32ULL));
+  hash *= 0xd6e8feb86659fd93ULL;
+  hash = (hash ^ (hash >> 32ULL));
+  return hash;
+}
+
+static __attribute__((unused)) u64 hashmap_match_byte(u64 group, u8 byte) {
+  u64 x = (group ^ (HASHMAP_LSBS * ((u64)byte)));
+  return (((x - HASHMAP_LSBS) & (~x)) & HASHMAP_MSBS);
+}
+
+static __attribute__((unused)) u64 hashmap_match_empty(u64 group) {
+  return ((group & (~(group << 6ULL))) & HASHMAP_MSBS);
+}
+
+static __attribute__((unused)) u64 hashmap_match_free(u64 group) {
+  return (group & HASHMAP_MSBS);
+}
+
+static inline __attribute__((unused)) __attribute__((always_inline)) u8 hashmap_h2(u64 hash) {
+  return ((u8)(hash & 0x7FULL));
+}
+
+static inline __attribute__((unused)) __attribute__((always_inline)) i32 hashmap_start(u64 hash, i32 capacity) {
+  return ((((i32)(hash >> 7ULL)) & (capacity - 1)) & (~(HASHMAP_GROUP - 1)));
+}
+
+static __attribute__((unused)) i32 hashmap_resize_capacity(i32 num_items, i32 capacity) {
+  return (((num_items * 16) <= (capacity * 7)) ? capacity : (capacity * 2));
+}
+
+static __attribute__((unused)) u64 HashMapSlot__hash_of(HashMapSlot *slot) {
+  return slot->hash;
+}
+
+static __attribute__((unused)) bool HashMapSlot__matches(HashMapSlot *slot, char *key, u64 hash) {
+  return (slot->hash == hash && string__eq(slot->key, key));
+}
+
+static __attribute__((unused)) HashMap *HashMap__new_sized(i32 capacity) {
+  HashMap *map = ((HashMap *)calloc(1, sizeof(HashMap)));
+  hashmap_alloc__HashMap_HashMapSlot(map, capacity, 0);
+  return map;
+}
+
+static __attribute__((unused)) HashMap *HashMap__new(void) {
+  return HashMap__new_sized(HASHMAP_GROUP);
+}
+
+static __attribute__((unused)) i32 HashMap__find(HashMap *this, char *key, u64 hash) {
+  return hashmap_find__HashMap_HashMapSlot_ptr_char(this, key, hash);
+}
+
+static __attribute__((unused)) void *HashMap__get(HashMap *this, char *key) {
+  i32 index = HashMap__find(this, key, HashMap__hash(key));
+  if ((index < 0)) 
+  return NULL;
+  
+  return this->slots[index].value;
+}
+
+static __attribute__((unused)) bool HashMap__exists(HashMap *this, char *key) {
+  return (HashMap__find(this, key, HashMap__hash(key)) >= 0);
+}
+
+static __attribute__((unused)) void HashMap__insert(HashMap *this, char *key, void *value) {
+  u64 hash = HashMap__hash(key);
+  i32 index = HashMap__find(this, key, hash);
+  if ((index >= 0)) {
+    this->slots[index].value = value;
+    return;
+  } 
+  index = hashmap_claim__HashMap(this, hash);
+  if ((index < 0)) {
+    HashMap__resize(this);
+    index = hashmap_claim__HashMap(this, hash);
+  } 
+  this->slots[index] = (HashMapSlot){hash, key, value};
+  this->ctrl[index] = hashmap_h2(hash);
+  this->num_items += 1;
+}
+
+static __attribute__((unused)) void *HashMap__remove(HashMap *this, char *key) {
+  i32 index = HashMap__find(this, key, HashMap__hash(key));
+  if ((index < 0)) 
+  return NULL;
+  
+  void *value = this->slots[index].value;
+  this->num_items -= 1;
+  hashmap_erase__HashMap(this, index);
+  return value;
+}
+
+static __attribute__((unused)) void HashMap__resize(HashMap *this) {
+  hashmap_resize__HashMap_HashMapSlot(this, this->num_items);
+}
+
+static __attribute__((unused)) void HashMap__print_keys(HashMap *this) {
+  for (HashMapIterator iter = HashMap__iter(this); ((bool)iter.cur); HashMapIterator__next((&iter))) {
+    printf("- '%s'\n""\n", HashMapIterator__key((&iter)));
+  } 
+}
+
+static __attribute__((unused)) void HashMap__push_keys(HashMap *this, Vector *vec) {
+  for (HashMapIterator iter = HashMap__iter(this); ((bool)iter.cur); HashMapIterator__next((&iter))) {
+    Vector__push(vec, HashMapIterator__key((&iter)));
+  } 
+}
+
+static __attribute__((unused)) void HashMap__free(HashMap *this) {
+  free(this->ctrl);
+  free(this->slots);
+}
+
+static __attribute__((unused)) HashMapIterator HashMap__iter(HashMap *this) {
+  return HashMapIterator__make(this);
+}
+
+static __attribute__((unused)) char *HashMapIterator__key(HashMapIterator *this) {
+  return this->cur->key;
+}
+
+static __attribute__((unused)) void *HashMapIterator__value(HashMapIterator *this) {
+  return this->cur->value;
+}
+
+static __attribute__((unused)) HashMapIterator HashMapIterator__make(HashMap *map) {
+  HashMapIterator it = (HashMapIterator){.idx = (-1), .cur = NULL, map};
+  HashMapIterator__next((&it));
+  return it;
+}
+
+static __attribute__((unused)) void HashMapIterator__next(HashMapIterator *this) {
+  this->idx = hashmap_next_item__HashMap(this->map, (this->idx + 1));
+  this->cur = ((this->idx < this->map->capacity) ? (&this->map->slots[this->idx]) : NULL);
+}
+
+static __attribute__((unused)) pthread_t *Thread__spawn(void *(*func)(void *), void *arg) {
+  aecor_multithreaded = true;
+  pthread_t *thread = ((pthread_t *)calloc(1, sizeof(pthread_t)));
+  if ((pthread_create(thread, NULL, func, arg) != 0)) {
+    printf("Failed to create thread: %s""\n", strerror(errno));
+    exit(1);
+  } 
+  return thread;
+}
+
+static __attribute__((unused)) void *Thread__join(pthread_t *this) {
+  void *result = ((void *)NULL);
+  pthread_join((*this), (&result));
+  free(this);
+  return result;
+}
+
+static __attribute__((unused)) void Mutex__init(pthread_mutex_t *this) {
+  pthread_mutex_init(this, NULL);
+}
+
+static __attribute__((unused)) ConcurrentTable *ConcurrentTable__new(i32 capacity, i32 num_items) {
+  ConcurrentTable *table = ((ConcurrentTable *)calloc(1, sizeof(ConcurrentTable)));
+  hashmap_alloc__ConcurrentTable_HashMapSlot(table, capacity, num_items);
+  memset(table->slots, 0, (table->capacity * sizeof(HashMapSlot)));
+  return table;
+}
+
+static __attribute__((unused)) i32 ConcurrentTable__find(ConcurrentTable *this, char *key, u64 hash) {
+  i32 mask = (this->capacity - 1);
+  u8 h2 = hashmap_h2(hash);
+  i32 pos = hashmap_start(hash, this->capacity);
+  for (i32 step = HASHMAP_GROUP; (step <= this->capacity); step += HASHMAP_GROUP) {
+    u64 group = hashmap_group__ConcurrentTable(this, pos);
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    for (u64 matches = hashmap_match_byte(group, h2); (matches != 0); matches = (matches & (matches - 1))) {
+      i32 index = (pos + (__builtin_ctzll(matches) / 8));
+      HashMapSlot *slot = (&this->slots[index]);
+      if (((slot->hash == hash && ((bool)slot->key)) && string__eq(slot->key, key))) 
+      return index;
+      
+    } 
+    if ((hashmap_match_empty(group) != 0)) 
+    return (-1);
+    
+    pos = ((pos + step) & mask);
+  } 
+  return (-1);
+}
+
+static __attribute__((unused)) void ConcurrentTable__put(ConcurrentTable *this, i32 index, HashMapSlot slot) {
+  this->slots[index] = slot;
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  this->ctrl[index] = hashmap_h2(slot.hash);
+}
+
+static __attribute__((unused)) void ConcurrentTable__free(ConcurrentTable *this) {
+  ConcurrentTable *table = this;
+  while (((bool)table)) {
+    ConcurrentTable *next = table->retired;
+    free(table->ctrl);
+    free(table->slots);
+    free(table);
+    table = next;
+  } 
+}
+
+static __attribute__((unused)) void ConcurrentTable__clear_deleted(ConcurrentTable *this, i32 num_items) {
+  u8 *old_ctrl = ((u8 *)malloc(this->capacity));
+  HashMapSlot *old_slots = ((HashMapSlot *)malloc((this->capacity * sizeof(HashMapSlot))));
+  memcpy(old_ctrl, this->ctrl, this->capacity);
+  memcpy(old_slots, this->slots, (this->capacity * sizeof(HashMapSlot)));
+  memset(this->ctrl, ((u8)HASHMAP_EMPTY), this->capacity);
+  this->growth_left = ((this->capacity - (this->capacity / 8)) - num_items);
+  hashmap_rehash__ConcurrentTable_HashMapSlot(this, old_ctrl, old_slots, this->capacity);
+  free(old_ctrl);
+  free(old_slots);
+}
+
+static __attribute__((unused)) void MapShard__begin_write(MapShard *this) {
+  pthread_mutex_lock((&this->lock));
+  __atomic_add_fetch((&this->seq), 1, __ATOMIC_SEQ_CST);
+}
+
+static __attribute__((unused)) void MapShard__end_write(MapShard *this) {
+  __atomic_add_fetch((&this->seq), 1, __ATOMIC_SEQ_CST);
+  pthread_mutex_unlock((&this->lock));
+}
+
+static __attribute__((unused)) void MapShard__resize(MapShard *this) {
+  ConcurrentTable *old = this->table;
+  i32 capacity = hashmap_resize_capacity(this->num_items, old->capacity);
+  if (capacity == old->capacity) {
+    ConcurrentTable__clear_deleted(old, this->num_items);
+    return;
+  } 
+  ConcurrentTable *table = ConcurrentTable__new(capacity, this->num_items);
+  hashmap_rehash__ConcurrentTable_HashMapSlot(table, old->ctrl, old->slots, old->capacity);
+  table->retired = old;
+  __atomic_store_n((&this->table), table, __ATOMIC_RELEASE);
+}
+
+static __attribute__((unused)) ConcurrentMap *ConcurrentMap__new(i32 num_shards) {
+  ConcurrentMap *map = ((ConcurrentMap *)calloc(1, sizeof(ConcurrentMap)));
+  map->num_shards = 1;
+  while ((map->num_shards < num_shards)) {
+    map->num_shards *= 2;
+  } 
+  map->shards = ((MapShard **)calloc(map->num_shards, sizeof(MapShard *)));
+  i32 line = CONCURRENT_MAP_CACHE_LINE;
+  i32 size = ((((sizeof(MapShard) + line) - 1) / line) * line);
+  for (i32 i = 0; (i < map->num_shards); i += 1) {
+    MapShard *shard = ((MapShard *)aligned_alloc(line, size));
+    memset(shard, 0, size);
+    Mutex__init((&shard->lock));
+    shard->table = ConcurrentTable__new(HASHMAP_GROUP, 0);
+    map->shards[i] = shard;
+  } 
+  return map;
+}
+
+static __attribute__((unused)) MapShard *ConcurrentMap__shard(ConcurrentMap *this, u64 hash) {
+  return this->shards[(((i32)(hash >> 56ULL)) & (this->num_shards - 1))];
+}
+
+static __attribute__((unused)) void *ConcurrentMap__lookup(ConcurrentMap *this, char *key, bool *found) {
+  u64 hash = HashMap__hash(key);
+  MapShard *shard = ConcurrentMap__shard(this, hash);
+  for (i32 attempt = 0; (attempt < CONCURRENT_MAP_READ_RETRIES); attempt += 1) {
+    u32 seq = __atomic_load_n((&shard->seq), __ATOMIC_ACQUIRE);
+    if (((seq & 1U) != 0)) 
+    continue;
+    
+    ConcurrentTable *table = ((ConcurrentTable *)__atomic_load_n((&shard->table), __ATOMIC_ACQUIRE));
+    i32 index = ConcurrentTable__find(table, key, hash);
+    void *value = ((index >= 0) ? table->slots[index].value : NULL);
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    if (__atomic_load_n((&shard->seq), __ATOMIC_RELAXED) == seq) {
+      (*found) = (index >= 0);
+      return value;
+    } 
+  } 
+  pthread_mutex_lock((&shard->lock));
+  i32 index = ConcurrentTable__find(shard->table, key, hash);
+  void *value = ((index >= 0) ? shard->table->slots[index].value : NULL);
+  pthread_mutex_unlock((&shard->lock));
+  (*found) = (index >= 0);
+  return value;
+}
+
+static __attribute__((unused)) void *ConcurrentMap__get(ConcurrentMap *this, char *key) {
+  bool found = false;
+  return ConcurrentMap__lookup(this, key, (&found));
+}
+
+static __attribute__((unused)) bool ConcurrentMap__exists(ConcurrentMap *this, char *key) {
+  bool found = false;
+  ConcurrentMap__lookup(this, key, (&found));
+  return found;
+}
+
+static __attribute__((unused)) void ConcurrentMap__insert(ConcurrentMap *this, char *key, void *value) {
+  u64 hash = HashMap__hash(key);
+  MapShard *shard = ConcurrentMap__shard(this, hash);
+  MapShard__begin_write(shard);
+  ConcurrentTable *table = shard->table;
+  i32 index = ConcurrentTable__find(table, key, hash);
+  if ((index >= 0)) {
+    table->slots[index].value = value;
+  }  else {
+    index = hashmap_claim__ConcurrentTable(table, hash);
+    if ((index < 0)) {
+      MapShard__resize(shard);
+      table = shard->table;
+      index = hashmap_claim__ConcurrentTable(table, hash);
+    } 
+    ConcurrentTable__put(table, index, (HashMapSlot){hash, key, value});
+    shard->num_items += 1;
+  } 
+  MapShard__end_write(shard);
+}
+
+static __attribute__((unused)) void *ConcurrentMap__remove(ConcurrentMap *this, char *key) {
+  u64 hash = HashMap__hash(key);
+  MapShard *shard = ConcurrentMap__shard(this, hash);
+  MapShard__begin_write(shard);
+  ConcurrentTable *table = shard->table;
+  i32 index = ConcurrentTable__find(table, key, hash);
+  void *value = ((void *)NULL);
+  if ((index >= 0)) {
+    value = table->slots[index].value;
+    shard->num_items -= 1;
+    hashmap_erase__ConcurrentTable(table, index);
+  } 
+  MapShard__end_write(shard);
+  return value;
+}
+
+static __attribute__((unused)) i32 ConcurrentMap__num_items(ConcurrentMap *this) {
+  i32 total = 0;
+  for (i32 i = 0; (i < this->num_shards); i += 1) {
+    MapShard *shard = this->shards[i];
+    pthread_mutex_lock((&shard->lock));
+    total += shard->num_items;
+    pthread_mutex_unlock((&shard->lock));
+  } 
+  return total;
+}
+
+static __attribute__((unused)) i32 ConcurrentMap__num_retired(ConcurrentMap *this) {
+  i32 total = 0;
+  for (i32 i = 0; (i < this->num_shards); i += 1) {
+    MapShard *shard = this->shards[i];
+    pthread_mutex_lock((&shard->lock));
+    for (ConcurrentTable *table = shard->table->retired; ((bool)table); table = table->retired) {
+      total += 1;
+    } 
+    pthread_mutex_unlock((&shard->lock));
+  } 
+  return total;
+}
+
+static __attribute__((unused)) void ConcurrentMap__push_keys(ConcurrentMap *this, Vector *vec) {
+  for (i32 i = 0; (i < this->num_shards); i += 1) {
+    MapShard *shard = this->shards[i];
+    pthread_mutex_lock((&shard->lock));
+    ConcurrentTable *table = shard->table;
+    for (i32 j = 0; (j < table->capacity); j += 1) {
+      if ((table->ctrl[j] & 0x80) == 0) 
+      Vector__push(vec, table->slots[j].key);
+      
+    } 
+    pthread_mutex_unlock((&shard->lock));
+  } 
+}
+
+static __attribute__((unused)) void ConcurrentMap__free(ConcurrentMap *this) {
+  for (i32 i = 0; (i < this->num_shards); i += 1) {
+    MapShard *shard = this->shards[i];
+    ConcurrentTable__free(shard->table);
+    pthread_mutex_destroy((&shard->lock));
+    free(shard);
+  } 
+  free(this->shards);
+}
+
+static __attribute__((unused)) void *writer(void *arg) {
+  Worker *worker = ((Worker *)arg);
+  i32 base = (worker->id * KEYS_PER_WRITER);
+  for (i32 i = 0; (i < KEYS_PER_WRITER); i += 1) {
+    char *key = worker->keys[(base + i)];
+    ConcurrentMap__insert(worker->map, key, key);
+  } 
+  for (i32 i = 0; (i < KEYS_PER_WRITER); i += 2) {
+    ConcurrentMap__remove(worker->map, worker->keys[(base + i)]);
+  } 
+  return NULL;
+}
+
+static __attribute__((unused)) void *reader(void *arg) {
+  Worker *worker = ((Worker *)arg);
+  i32 total = (NUM_WRITERS * KEYS_PER_WRITER);
+  for (i32 round = 0; (round < 5); round += 1) {
+    for (i32 i = worker->id; (i < total); i += 7) {
+      char *key = worker->keys[i];
+      void *value = ConcurrentMap__get(worker->map, key);
+      if ((((bool)value) && (value != ((void *)key)))) 
+      worker->errors += 1;
+      
+    } 
+  } 
+  return NULL;
+}
+
+i32 main(void) {
+  ConcurrentMap *map = ConcurrentMap__new(16);
+  i32 total = (NUM_WRITERS * KEYS_PER_WRITER);
+  char **keys = ((char **)calloc(total, sizeof(char *)));
+  for (i32 i = 0; (i < total); i += 1) {
+    keys[i] = format_string("key%d", i);
+  } 
+  Vector__ptr_Thread *threads = Vector__ptr_Thread__new();
+  Worker *workers = ((Worker *)calloc((NUM_WRITERS + NUM_READERS), sizeof(Worker)));
+  for (i32 i = 0; (i < (NUM_WRITERS + NUM_READERS)); i += 1) {
+    workers[i] = (Worker){map, keys, .id = (i % NUM_WRITERS), .errors = 0};
+    void *(*func)(void *arg) = ((i < NUM_WRITERS) ? writer : reader);
+    Vector__ptr_Thread__push(threads, Thread__spawn(func, (&workers[i])));
+  } 
+  {
+    Vector__ptr_Thread *__it_source = threads;
+    pthread_t **__it_cursor = __it_source->data;
+    pthread_t **__it_limit = __it_cursor + __it_source->size;
+    for (; __it_cursor != __it_limit; __it_cursor++) {
+      pthread_t *thread = *__it_cursor;
+      {
+        Thread__join(thread);
+      }
+    }
+  }
+  i32 errors = 0;
+  for (i32 i = 0; (i < (NUM_WRITERS + NUM_READERS)); i += 1) {
+    errors += workers[i].errors;
+  } 
+  for (i32 i = 0; (i < total); i += 1) {
+    bool expected = (i % 2) == 1;
+    if ((ConcurrentMap__exists(map, keys[i]) != expected)) 
+    errors += 1;
+    
+    if ((expected && (ConcurrentMap__get(map, keys[i]) != ((void *)keys[i])))) 
+    errors += 1;
+    
+  } 
+  printf("inserted %d, removed %d, left %d, read errors %d\n", total, (total / 2), ConcurrentMap__num_items(map), errors);
+  ConcurrentMap__free(map);
+}
+
+static __attribute__((unused)) Vector__ptr_Thread *Vector__ptr_Thread__new_sized(i32 capacity) {
+  Vector__ptr_Thread *vec = ((Vector__ptr_Thread *)calloc(1, sizeof(Vector__ptr_Thread)));
+  vec->size = 0;
+  vec->capacity = capacity;
+  vec->data = ((pthread_t **)calloc(vec->capacity, sizeof(pthread_t *)));
+  return vec;
+}
+
+static __attribute__((unused)) Vector__ptr_Thread *Vector__ptr_Thread__new(void) {
+  return Vector__ptr_Thread__new_sized(16);
+}
+
+static __attribute__((unused)) void Vector__ptr_Thread__resize(Vector__ptr_Thread *this, i32 new_capacity) {
+  this->capacity = new_capacity;
+  this->data = ((pthread_t **)realloc(this->data, (this->capacity * sizeof(pthread_t *))));
+}
+
+static inline __attribute__((unused)) __attribute__((always_inline)) void Vector__ptr_Thread__push(Vector__ptr_Thread *this, pthread_t *val) {
+  if (this->size == this->capacity) {
+    Vector__ptr_Thread__resize(this, (this->capacity * 2));
+  } 
+  this->data[this->size] = val;
+  this->size += 1;
+}
+
+static __attribute__((unused)) pthread_t *Vector__ptr_Thread__pop(Vector__ptr_Thread *this) {
+  (__builtin_expect(!!((this->size > 0)), 1) ? (void)0 : panic("pop on empty vector"));
+  this->size -= 1;
+  return this->data[this->size];
+}
+
+static inline __attribute__((unused)) __attribute__((always_inline)) pthread_t *Vector__ptr_Thread__back(Vector__ptr_Thread *this) {
+  (__builtin_expect(!!((this->size > 0)), 1) ? (void)0 : panic("back on empty vector"));
+  return this->data[(this->size - 1)];
+}
+
+static inline __attribute__((unused)) __attribute__((always_inline)) pthread_t *Vector__ptr_Thread__at(Vector__ptr_Thread *this, i32 i) {
+  (__builtin_expect(!!(((i >= 0) && (i < this->size))), 1) ? (void)0 : panic("at out of bounds in vector"));
+  return this->data[i];
+}
+
+static inline __attribute__((unused)) __attribute__((always_inline)) pthread_t **Vector__ptr_Thread__at_ptr(Vector__ptr_Thread *this, i32 i) {
+  (__builtin_expect(!!(((i >= 0) && (i < this->size))), 1) ? (void)0 : panic("at_ptr out of bounds in vector"));
+  return (&this->data[i]);
+}
+
+static inline __attribute__((unused)) __attribute__((always_inline)) bool Vector__ptr_Thread__empty(Vector__ptr_Thread *this) {
+  return this->size == 0;
+}
+
+static __attribute__((unused)) void Vector__ptr_Thread__free(Vector__ptr_Thread *this) {
+  free(this->data);
+  free(this);
+}
+
+static __attribute__((unused)) void hashmap_erase__ConcurrentTable(ConcurrentTable *map, i32 index) {
+  i32 group_start = (index & (~(HASHMAP_GROUP - 1)));
+  if ((hashmap_match_empty(hashmap_group__ConcurrentTable(map, group_start)) != 0)) {
+    map->ctrl[index] = ((u8)HASHMAP_EMPTY);
+    map->growth_left += 1;
+  }  else {
+    map->ctrl[index] = ((u8)HASHMAP_DELETED);
+  } 
+}
+
+static __attribute__((unused)) i32 hashmap_claim__ConcurrentTable(ConcurrentTable *map, u64 hash) {
+  i32 index = hashmap_find_free__ConcurrentTable(map, hash);
+  if (map->ctrl[index] == ((u8)HASHMAP_EMPTY)) {
+    if (map->growth_left == 0) 
+    return (-1);
+    
+    map->growth_left -= 1;
+  } 
+  return index;
+}
+
+static __attribute__((unused)) i32 hashmap_find_free__ConcurrentTable(ConcurrentTable *map, u64 hash) {
+  i32 mask = (map->capacity - 1);
+  i32 pos = hashmap_start(hash, map->capacity);
+  for (i32 step = HASHMAP_GROUP; true; step += HASHMAP_GROUP) {
+    u64 free = hashmap_match_free(hashmap_group__ConcurrentTable(map, pos));
+    if ((free != 0)) 
+    return (pos + (__builtin_ctzll(free) / 8));
+    
+    pos = ((pos + step) & mask);
+  } 
+  return (-1);
+}
+
+static __attribute__((unused)) void hashmap_rehash__ConcurrentTable_HashMapSlot(ConcurrentTable *map, u8 *old_ctrl, HashMapSlot *old_slots, i32 old_capacity) {
+  for (i32 i = 0; (i < old_capacity); i += 1) {
+    if (((old_ctrl[i] & 0x80) != 0)) 
+    continue;
+    
+    i32 index = hashmap_find_free__ConcurrentTable(map, HashMapSlot__hash_of((&old_slots[i])));
+    map->ctrl[index] = old_ctrl[i];
+    map->slots[index] = old_slots[i];
+  } 
+}
+
+static inline __attribute__((unused)) __attribute__((always_inline)) u64 hashmap_group__ConcurrentTable(ConcurrentTable *map, i32 index) {
+  return (*((u64 *)(map->ctrl + index)));
+}
+
+static __attribute__((unused)) void hashmap_alloc__ConcurrentTable_HashMapSlot(ConcurrentTable *map, i32 min_capacity, i32 num_items) {
+  i32 capacity = HASHMAP_GROUP;
+  while ((capacity < min_capacity)) {
+    capacity *= 2;
+  } 
+  map->capacity = capacity;
+  map->ctrl = ((u8 *)malloc(capacity));
+  memset(map->ctrl, ((u8)HASHMAP_EMPTY), capacity);
+  map->slots = ((HashMapSlot *)malloc((capacity * sizeof(HashMapSlot))));
+  map->growth_left = ((capacity - (capacity / 8)) - num_items);
+}
+
+static __attribute__((unused)) i32 hashmap_next_item__HashMap(HashMap *map, i32 index) {
+  while (((index < map->capacity) && ((map->ctrl[index] & 0x80) != 0))) {
+    index += 1;
+  } 
+  return index;
+}
+
+static __attribute__((unused)) void hashmap_resize__HashMap_HashMapSlot(HashMap *map, i32 num_items) {
+  u8 *old_ctrl = map->ctrl;
+  HashMapSlot *old_slots = map->slots;
+  i32 old_capacity = map->capacity;
+  hashmap_alloc__HashMap_HashMapSlot(map, hashmap_resize_capacity(num_items, old_capacity), num_items);
+  hashmap_rehash__HashMap_HashMapSlot(map, old_ctrl, old_slots, old_capacity);
+  free(old_ctrl);
+  free(old_slots);
+}
+
+static __attribute__((unused)) void hashmap_rehash__HashMap_HashMapSlot(HashMap *map, u8 *old_ctrl, HashMapSlot *old_slots, i32 old_capacity) {
+  for (i32 i = 0; (i < old_capacity); i += 1) {
+    if (((old_ctrl[i] & 0x80) != 0)) 
+    continue;
+    
+    i32 index = hashmap_find_free__HashMap(map, HashMapSlot__hash_of((&old_slots[i])));
+    map->ctrl[index] = old_ctrl[i];
+    map->slots[index] = old_slots[i];
+  } 
+}
+
+static __attribute__((unused)) i32 hashmap_find_free__HashMap(HashMap *map, u64 hash) {
+  i32 mask = (map->capacity - 1);
+  i32 pos = hashmap_start(hash, map->capacity);
+  for (i32 step = HASHMAP_GROUP; true; step += HASHMAP_GROUP) {
+    u64 free = hashmap_match_free(hashmap_group__HashMap(map, pos));
+    if ((free != 0)) 
+    return (pos + (__builtin_ctzll(free) / 8));
+    
+    pos = ((pos + step) & mask);
+  } 
+  return (-1);
+}
+
+static inline __attribute__((unused)) __attribute__((always_inline)) u64 hashmap_group__HashMap(HashMap *map, i32 index) {
+  return (*((u64 *)(map->ctrl + index)));
+}
+
+static __attribute__((unused)) void hashmap_erase__HashMap(HashMap *map, i32 index) {
+  i32 group_start = (index & (~(HASHMAP_GROUP - 1)));
+  if ((hashmap_match_empty(hashmap_group__HashMap(map, group_start)) != 0)) {
+    map->ctrl[index] = ((u8)HASHMAP_EMPTY);
+    map->growth_left += 1;
+  }  else {
+    map->ctrl[index] = ((u8)HASHMAP_DELETED);
+  } 
+}
+
+static __attribute__((unused)) i32 hashmap_claim__HashMap(HashMap *map, u64 hash) {
+  i32 index = hashmap_find_free__HashMap(map, hash);
+  if (map->ctrl[index] == ((u8)HASHMAP_EMPTY)) {
+    if (map->growth_left == 0) 
+    return (-1);
+    
+    map->growth_left -= 1;
+  } 
+  return index;
+}
+
+static __attribute__((unused)) i32 hashmap_find__HashMap_HashMapSlot_ptr_char(HashMap *map, char *key, u64 hash) {
+  i32 mask = (map->capacity - 1);
+  u8 h2 = hashmap_h2(hash);
+  i32 pos = hashmap_start(hash, map->capacity);
+  for (i32 step = HASHMAP_GROUP; true; step += HASHMAP_GROUP) {
+    u64 group = hashmap_group__HashMap(map, pos);
+    for (u64 matches = hashmap_match_byte(group, h2); (matches != 0); matches = (matches & (matches - 1))) {
+      i32 index = (pos + (__builtin_ctzll(matches) / 8));
+      if (HashMapSlot__matches((&map->slots[index]), key, hash)) 
+      return index;
+      
+    } 
+    if ((hashmap_match_empty(group) != 0)) 
+    return (-1);
+    
+    pos = ((pos + step) & mask);
+  } 
+  return (-1);
+}
+
+static __attribute__((unused)) void hashmap_alloc__HashMap_HashMapSlot(HashMap *map, i32 min_capacity, i32 num_items) {
+  i32 capacity = HASHMAP_GROUP;
+  while ((capacity < min_capacity)) {
+    capacity *= 2;
+  } 
+  map->capacity = capacity;
+  map->ctrl = ((u8 *)malloc(capacity));
+  memset(map->ctrl, ((u8)HASHMAP_EMPTY), capacity);
+  map->slots = ((HashMapSlot *)malloc((capacity * sizeof(HashMapSlot))));
+  map->growth_left = ((capacity - (capacity / 8)) - num_items);
+}
+
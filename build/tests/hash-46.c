@@ -0,0 +1,1279 @@
+#include "stdio.h"
+#include "stdlib.h"
+#include "stdbool.h"
+#include "stdint.h"
+#include "string.h"
+#include "errno.h"
+#include "ctype.h"
+#include "pthread.h"
+#include "sched.h"
+
+/***************** embed './lib/prelude.h' *****************/
+#include "stdarg.h"
+
+typedef int8_t i8;
+typedef int16_t i16;
+typedef int32_t i32;
+typedef int64_t i64;
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+
+typedef float f32;
+typedef double f64;
+
+// SIMD vector types, such as `f32x4`, using GCC's vector extensions
+#define AECOR_SIMD_TYPE(T, lanes) \
+  typedef T aecor_##T##x##lanes __attribute__((vector_size(sizeof(T) * lanes)));
+#define AECOR_SIMD_TYPES(T) \
+  AECOR_SIMD_TYPE(T, 2) AECOR_SIMD_TYPE(T, 4) AECOR_SIMD_TYPE(T, 8) \
+  AECOR_SIMD_TYPE(T, 16) AECOR_SIMD_TYPE(T, 32) AECOR_SIMD_TYPE(T, 64)
+
+AECOR_SIMD_TYPES(i8) AECOR_SIMD_TYPES(i16) AECOR_SIMD_TYPES(i32) AECOR_SIMD_TYPES(i64)
+AECOR_SIMD_TYPES(u8) AECOR_SIMD_TYPES(u16) AECOR_SIMD_TYPES(u32) AECOR_SIMD_TYPES(u64)
+AECOR_SIMD_TYPES(f32) AECOR_SIMD_TYPES(f64)
+
+#ifdef AECOR_TRACK_ALLOC
+// Allocation tracking for `--track-alloc`. Calls to `malloc`, `calloc`,
+// `realloc`, `free` and `strdup` in aecor code go through the functions
+// below, each with a static `aecor_alloc_site` for the call site. Live
+// blocks are kept in a side table keyed by pointer, so `free` still works
+// on memory allocated by C code, which is just not counted.
+//
+// Like `--instrument`, this is not synchronized between threads.
+typedef struct aecor_alloc_site {
+  const char* location;
+  u64 allocs;
+  u64 bytes;
+  u64 live;
+  u64 live_bytes;
+  struct aecor_alloc_site* next;
+} aecor_alloc_site;
+
+typedef struct {
+  void* ptr;
+  size_t size;
+  aecor_alloc_site* site;
+} aecor_alloc_block;
+
+static aecor_alloc_site* aecor_alloc_sites = NULL;
+static aecor_alloc_block* aecor_alloc_blocks = NULL;
+static size_t aecor_alloc_capacity = 0;  // Always a power of two
+static size_t aecor_alloc_count = 0;
+static u64 aecor_alloc_live_bytes = 0;
+static u64 aecor_alloc_peak_bytes = 0;
+
+// Site of the format string being built, set by the generated code
+static aecor_alloc_site aecor_alloc_unknown_format = {"<format string>"};
+static aecor_alloc_site* aecor_alloc_format_site = &aecor_alloc_unknown_format;
+
+static inline size_t aecor_alloc_slot(void* ptr) {
+  return ((uintptr_t)ptr >> 4) * 0x9e3779b97f4a7c15ull & (aecor_alloc_capacity - 1);
+}
+
+static void aecor_alloc_insert(aecor_alloc_block block) {
+  if ((aecor_alloc_count + 1) * 2 > aecor_alloc_capacity) {
+    aecor_alloc_block* old = aecor_alloc_blocks;
+    size_t old_capacity = aecor_alloc_capacity;
+    aecor_alloc_capacity = old_capacity ? old_capacity * 2 : 1024;
+    aecor_alloc_blocks = calloc(aecor_alloc_capacity, sizeof(aecor_alloc_block));
+    aecor_alloc_count = 0;
+    for (size_t i = 0; i < old_capacity; i++) {
+      if (old[i].ptr) aecor_alloc_insert(old[i]);
+    }
+    free(old);
+  }
+  size_t i = aecor_alloc_slot(block.ptr);
+  while (aecor_alloc_blocks[i].ptr) i = (i + 1) & (aecor_alloc_capacity - 1);
+  aecor_alloc_blocks[i] = block;
+  aecor_alloc_count++;
+}
+
+// Removes the block for `ptr` using backward-shift deletion, returning
+// false if it wasn't allocated by tracked code.
+static bool aecor_alloc_remove(void* ptr, aecor_alloc_block* out) {
+  if (!aecor_alloc_capacity) return false;
+  size_t mask = aecor_alloc_capacity - 1;
+  size_t i = aecor_alloc_slot(ptr);
+  while (aecor_alloc_blocks[i].ptr != ptr) {
+    if (!aecor_alloc_blocks[i].ptr) return false;
+    i = (i + 1) & mask;
+  }
+  *out = aecor_alloc_blocks[i];
+  for (size_t j = (i + 1) & mask; aecor_alloc_blocks[j].ptr; j = (j + 1) & mask) {
+    size_t home = aecor_alloc_slot(aecor_alloc_blocks[j].ptr);
+    // Move the entry into the hole unless its home slot is after the hole
+    if (((j - home) & mask) >= ((j - i) & mask)) {
+      aecor_alloc_blocks[i] = aecor_alloc_blocks[j];
+      i = j;
+    }
+  }
+  aecor_alloc_blocks[i].ptr = NULL;
+  aecor_alloc_count--;
+  return true;
+}
+
+static void aecor_alloc_record(void* ptr, size_t size, aecor_alloc_site* site) {
+  if (!ptr) return;
+  if (!site->allocs) {
+    site->next = aecor_alloc_sites;
+    aecor_alloc_sites = site;
+  }
+  site->allocs++;
+  site->bytes += size;
+  site->live++;
+  site->live_bytes += size;
+  aecor_alloc_live_bytes += size;
+  if (aecor_alloc_live_bytes > aecor_alloc_peak_bytes) {
+    aecor_alloc_peak_bytes = aecor_alloc_live_bytes;
+  }
+  aecor_alloc_insert((aecor_alloc_block){ptr, size, site});
+}
+
+static void aecor_alloc_forget(void* ptr) {
+  aecor_alloc_block block;
+  if (!ptr || !aecor_alloc_remove(ptr, &block)) return;
+  block.site->live--;
+  block.site->live_bytes -= block.size;
+  aecor_alloc_live_bytes -= block.size;
+}
+
+void* aecor_track_malloc(size_t size, aecor_alloc_site* site) {
+  void* ptr = malloc(size);
+  aecor_alloc_record(ptr, size, site);
+  return ptr;
+}
+
+void* aecor_track_calloc(size_t count, size_t size, aecor_alloc_site* site) {
+  void* ptr = calloc(count, size);
+  aecor_alloc_record(ptr, count * size, site);
+  return ptr;
+}
+
+void* aecor_track_realloc(void* old, size_t size, aecor_alloc_site* site) {
+  void* ptr = realloc(old, size);
+  if (!ptr && size) return ptr;
+  aecor_alloc_forget(old);
+  aecor_alloc_record(ptr, size, site);
+  return ptr;
+}
+
+char* aecor_track_strdup(const char* s, aecor_alloc_site* site) {
+  char* copy = strdup(s);
+  aecor_alloc_record(copy, strlen(s) + 1, site);
+  return copy;
+}
+
+void aecor_track_free(void* ptr) {
+  aecor_alloc_forget(ptr);
+  free(ptr);
+}
+
+static void* aecor_track_format_alloc(size_t size) {
+  aecor_alloc_site* site = aecor_alloc_format_site;
+  aecor_alloc_format_site = &aecor_alloc_unknown_format;
+  return aecor_track_malloc(size, site);
+}
+
+// Ties are broken by location, so reports from different runs can be diffed
+static int aecor_alloc_compare_bytes(const void* a, const void* b) {
+  aecor_alloc_site* sa = *(aecor_alloc_site**)a;
+  aecor_alloc_site* sb = *(aecor_alloc_site**)b;
+  if (sa->bytes != sb->bytes) return sa->bytes < sb->bytes ? 1 : -1;
+  return strcmp(sa->location, sb->location);
+}
+
+static int aecor_alloc_compare_live(const void* a, const void* b) {
+  aecor_alloc_site* sa = *(aecor_alloc_site**)a;
+  aecor_alloc_site* sb = *(aecor_alloc_site**)b;
+  if (sa->live_bytes != sb->live_bytes) return sa->live_bytes < sb->live_bytes ? 1 : -1;
+  return strcmp(sa->location, sb->location);
+}
+
+// Writes the sites that allocated the most bytes, followed by the ones
+// with memory that was never freed.
+static void aecor_alloc_report(void) {
+  const char* path = getenv("AECOR_ALLOC_REPORT");
+  if (!path) path = "aecor_alloc.txt";
+  FILE* file = fopen(path, "w");
+  if (!file) {
+    fprintf(stderr, "Could not write allocation report to %s\n", path);
+    return;
+  }
+
+  size_t count = 0;
+  u64 allocs = 0, bytes = 0, live = 0;
+  for (aecor_alloc_site* site = aecor_alloc_sites; site; site = site->next) {
+    count++;
+    allocs += site->allocs;
+    bytes += site->bytes;
+    live += site->live;
+  }
+  aecor_alloc_site** sites = malloc((count + 1) * sizeof(aecor_alloc_site*));
+  size_t n = 0;
+  for (aecor_alloc_site* site = aecor_alloc_sites; site; site = site->next) sites[n++] = site;
+
+  fprintf(file, "# %llu allocations, %llu bytes, peak %llu bytes live\n",
+          (unsigned long long)allocs, (unsigned long long)bytes,
+          (unsigned long long)aecor_alloc_peak_bytes);
+  fprintf(file, "# %llu blocks, %llu bytes never freed\n",
+          (unsigned long long)live, (unsigned long long)aecor_alloc_live_bytes);
+
+  const char* header = "# %12s %14s %12s %14s  %s\n";
+  const char* row = "%14llu %14llu %12llu %14llu  %s\n";
+  fprintf(file, "\n# Top allocators\n");
+  fprintf(file, header, "allocs", "bytes", "live", "live_bytes", "site");
+  qsort(sites, n, sizeof(aecor_alloc_site*), aecor_alloc_compare_bytes);
+  for (size_t i = 0; i < n; i++) {
+    aecor_alloc_site* site = sites[i];
+    fprintf(file, row, (unsigned long long)site->allocs, (unsigned long long)site->bytes,
+            (unsigned long long)site->live, (unsigned long long)site->live_bytes, site->location);
+  }
+
+  fprintf(file, "\n# Leaks\n");
+  fprintf(file, header, "allocs", "bytes", "live", "live_bytes", "site");
+  qsort(sites, n, sizeof(aecor_alloc_site*), aecor_alloc_compare_live);
+  for (size_t i = 0; i < n && sites[i]->live; i++) {
+    aecor_alloc_site* site = sites[i];
+    fprintf(file, row, (unsigned long long)site->allocs, (unsigned long long)site->bytes,
+            (unsigned long long)site->live, (unsigned long long)site->live_bytes, site->location);
+  }
+  free(sites);
+  fclose(file);
+}
+
+__attribute__((constructor)) static void aecor_alloc_init(void) {
+  atexit(aecor_alloc_report);
+}
+
+#define AECOR_FORMAT_ALLOC aecor_track_format_alloc
+#else
+#define AECOR_FORMAT_ALLOC malloc
+#endif
+
+// Formats into `stack` if the result fits in `capacity` bytes, otherwise
+// returns a new heap-allocated string that the caller needs to free.
+char* format_string_into(char* stack, int capacity, const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  int size = vsnprintf(stack, capacity, format, args);
+  va_end(args);
+  if (size < capacity) return stack;
+  char* s = malloc(size + 1);
+  va_start(args, format);
+  vsnprintf(s, size + 1, format, args);
+  va_end(args);
+  return s;
+}
+
+// Formats into a stack buffer first since most formatted strings are short,
+// which saves a separate pass just to compute the size.
+static char* aecor_vformat(void* (*alloc)(size_t), const char* format, va_list args) {
+  char stack[256];
+  va_list copy;
+  va_copy(copy, args);
+  int size = vsnprintf(stack, sizeof(stack), format, copy);
+  va_end(copy);
+  char* s = alloc(size + 1);
+  if (size < (int)sizeof(stack)) {
+    memcpy(s, stack, size + 1);
+  } else {
+    vsnprintf(s, size + 1, format, args);
+  }
+  return s;
+}
+
+char* format_string(const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  char* s = aecor_vformat(AECOR_FORMAT_ALLOC, format, args);
+  va_end(args);
+  return s;
+}
+
+// Scratch arena backing `scratch { ... }` blocks. Memory is handed out from a
+// list of chunks with a bump pointer, and everything allocated inside a block
+// is released at once when it ends by restoring the position saved on entry.
+// Chunks past the current one are kept around to be reused. Each thread has
+// its own arena.
+//
+// Format strings built inside a block come from the arena as well, so they
+// must not be passed to `free` or to anything that frees them, such as
+// `Buffer::putsf`, and must be copied to outlive the block.
+#define AECOR_SCRATCH_CHUNK_SIZE (64 * 1024)
+
+typedef struct aecor_scratch_chunk {
+  struct aecor_scratch_chunk* next;
+  size_t capacity;
+  size_t used;
+  char data[];
+} aecor_scratch_chunk;
+
+typedef struct {
+  aecor_scratch_chunk* chunk;
+  size_t used;
+} aecor_scratch_mark;
+
+static __thread aecor_scratch_chunk* aecor_scratch_first = NULL;
+static __thread aecor_scratch_chunk* aecor_scratch_current = NULL;
+
+void* scratch_alloc(size_t size) {
+  size = (size + 15) & ~(size_t)15;
+  aecor_scratch_chunk* chunk = aecor_scratch_current;
+  if (!chunk || chunk->used + size > chunk->capacity) {
+    aecor_scratch_chunk** link = chunk ? &chunk->next : &aecor_scratch_first;
+    if (!*link || (*link)->capacity < size) {
+      size_t capacity = size > AECOR_SCRATCH_CHUNK_SIZE ? size : AECOR_SCRATCH_CHUNK_SIZE;
+      aecor_scratch_chunk* fresh = malloc(sizeof(aecor_scratch_chunk) + capacity);
+      if (!fresh) {
+        printf("Out of memory!\n");
+        exit(1);
+      }
+      fresh->capacity = capacity;
+      fresh->next = *link;
+      *link = fresh;
+    }
+    chunk = *link;
+    chunk->used = 0;
+    aecor_scratch_current = chunk;
+  }
+  void* ptr = chunk->data + chunk->used;
+  chunk->used += size;
+  return ptr;
+}
+
+aecor_scratch_mark aecor_scratch_save() {
+  aecor_scratch_chunk* chunk = aecor_scratch_current;
+  return (aecor_scratch_mark){chunk, chunk ? chunk->used : 0};
+}
+
+void aecor_scratch_restore(aecor_scratch_mark* mark) {
+  aecor_scratch_current = mark->chunk;
+  if (mark->chunk) mark->chunk->used = mark->used;
+}
+
+char* format_string_scratch(const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  char* s = aecor_vformat(scratch_alloc, format, args);
+  va_end(args);
+  return s;
+}
+
+// Output buffer for `print` / `println` when compiling with `-b`. Writes are
+// collected here and handed to stdio in large chunks, which avoids paying
+// for `printf`'s locking and format parsing on every call.
+//
+// Once a second thread has been started (see `Thread::spawn`), the buffer is
+// guarded by a spinlock. It is only held for a `memcpy` or a flush, once per
+// `print`, and single-threaded programs don't pay for it at all.
+#define AECOR_STDOUT_BUFFER_SIZE (64 * 1024)
+
+static char aecor_stdout_buffer[AECOR_STDOUT_BUFFER_SIZE];
+static size_t aecor_stdout_size = 0;
+static char aecor_stdout_locked = 0;
+
+// Set before the first thread is created, so that thread sees it too
+bool aecor_multithreaded = false;
+
+static inline void aecor_stdout_lock(void) {
+  if (!aecor_multithreaded) return;
+  while (__atomic_test_and_set(&aecor_stdout_locked, __ATOMIC_ACQUIRE)) {
+    while (__atomic_load_n(&aecor_stdout_locked, __ATOMIC_RELAXED)) {}
+  }
+}
+
+static inline void aecor_stdout_unlock(void) {
+  if (!aecor_multithreaded) return;
+  __atomic_clear(&aecor_stdout_locked, __ATOMIC_RELEASE);
+}
+
+// Must be called with the lock held
+static void aecor_stdout_flush_locked(void) {
+  fwrite(aecor_stdout_buffer, 1, aecor_stdout_size, stdout);
+  fflush(stdout);
+  aecor_stdout_size = 0;
+}
+
+void aecor_stdout_flush(void) {
+  aecor_stdout_lock();
+  aecor_stdout_flush_locked();
+  aecor_stdout_unlock();
+}
+
+__attribute__((constructor)) static void aecor_stdout_init(void) {
+  atexit(aecor_stdout_flush);
+}
+
+static inline void aecor_stdout_write(const char* s, size_t len) {
+  aecor_stdout_lock();
+  if (aecor_stdout_size + len > AECOR_STDOUT_BUFFER_SIZE) {
+    aecor_stdout_flush_locked();
+    if (len > AECOR_STDOUT_BUFFER_SIZE) {
+      fwrite(s, 1, len, stdout);
+      aecor_stdout_unlock();
+      return;
+    }
+  }
+  memcpy(aecor_stdout_buffer + aecor_stdout_size, s, len);
+  aecor_stdout_size += len;
+  aecor_stdout_unlock();
+}
+
+// The pieces of one `print` with a format string are collected in a line on
+// the stack and added to the buffer at once, so lines printed by different
+// threads never interleave. Arguments are evaluated outside the lock, so
+// they can print too.
+typedef struct {
+  char* data;
+  size_t size;
+  size_t capacity;
+  char stack[256];
+} aecor_stdout_line;
+
+static inline void aecor_stdout_line_init(aecor_stdout_line* line) {
+  line->data = line->stack;
+  line->size = 0;
+  line->capacity = sizeof(line->stack);
+}
+
+static void aecor_stdout_line_grow(aecor_stdout_line* line, size_t min_capacity) {
+  size_t capacity = line->capacity * 2;
+  if (capacity < min_capacity) capacity = min_capacity;
+  if (line->data == line->stack) {
+    line->data = malloc(capacity);
+    memcpy(line->data, line->stack, line->size);
+  } else {
+    line->data = realloc(line->data, capacity);
+  }
+  line->capacity = capacity;
+}
+
+static inline void aecor_stdout_write_line(aecor_stdout_line* line, const char* s, size_t len) {
+  if (line->size + len > line->capacity) aecor_stdout_line_grow(line, line->size + len);
+  memcpy(line->data + line->size, s, len);
+  line->size += len;
+}
+
+void aecor_stdout_line_finish(aecor_stdout_line* line) {
+  aecor_stdout_write(line->data, line->size);
+  if (line->data != line->stack) free(line->data);
+}
+
+void aecor_stdout_puts(aecor_stdout_line* line, const char* s) {
+  aecor_stdout_write_line(line, s, strlen(s));
+}
+
+// Prints "(null)" for a null string, like `printf` does
+void aecor_stdout_put_str(aecor_stdout_line* line, const char* s) {
+  aecor_stdout_puts(line, s ? s : "(null)");
+}
+
+static inline void aecor_stdout_putc(aecor_stdout_line* line, char c) {
+  if (line->size == line->capacity) aecor_stdout_line_grow(line, line->size + 1);
+  line->data[line->size++] = c;
+}
+
+void aecor_stdout_put_u64(aecor_stdout_line* line, u64 value) {
+  char digits[20];
+  int len = 0;
+  do {
+    digits[sizeof(digits) - ++len] = '0' + value % 10;
+    value /= 10;
+  } while (value);
+  aecor_stdout_write_line(line, digits + sizeof(digits) - len, len);
+}
+
+void aecor_stdout_put_i64(aecor_stdout_line* line, i64 value) {
+  if (value < 0) {
+    aecor_stdout_putc(line, '-');
+    aecor_stdout_put_u64(line, -(u64)value);
+  } else {
+    aecor_stdout_put_u64(line, value);
+  }
+}
+
+void aecor_stdout_put_f64(aecor_stdout_line* line, f64 value) {
+  char stack[64];
+  char* s = format_string_into(stack, sizeof(stack), "%f", value);
+  aecor_stdout_puts(line, s);
+  if (s != stack) free(s);
+}
+
+void aecor_stdout_put_ptr(aecor_stdout_line* line, void* value) {
+  char stack[32];
+  aecor_stdout_puts(line, format_string_into(stack, sizeof(stack), "%p", value));
+}
+
+// Used for anything that isn't a format string literal, which is printed
+// with a single write.
+int aecor_stdout_printf(const char* format, ...) {
+  char stack[256];
+  va_list args;
+  va_start(args, format);
+  int size = vsnprintf(stack, sizeof(stack), format, args);
+  va_end(args);
+  if (size < (int)sizeof(stack)) {
+    aecor_stdout_write(stack, size);
+  } else {
+    char* s = malloc(size + 1);
+    va_start(args, format);
+    vsnprintf(s, size + 1, format, args);
+    va_end(args);
+    aecor_stdout_write(s, size);
+    free(s);
+  }
+  return size;
+}
+
+// FNV-1a with a murmur3 finalizer, used for hashed dispatch on strings.
+// Must be kept in sync with `hash_string` in `compiler/utils.ae`.
+u32 aecor_hash_str(const char* s, u32 seed) {
+  u32 hash = seed;
+  for (; *s; s++) {
+    hash = (hash ^ (u8)*s) * 16777619u;
+  }
+  hash = (hash ^ (hash >> 16)) * 0x85ebca6bu;
+  hash = (hash ^ (hash >> 13)) * 0xc2b2ae35u;
+  return hash ^ (hash >> 16);
+}
+
+#ifdef AECOR_INSTRUMENT
+#include <time.h>
+
+// Per-function profiling for `--instrument`. Every instrumented function
+// pushes a frame on entry, which is popped by a `cleanup` handler whenever
+// the function returns. Time spent in instrumented callees is subtracted
+// from the caller's exclusive time. Recursive calls only count towards
+// inclusive time once, for the outermost call.
+//
+// Counters are not synchronized, so this is only accurate for programs
+// that call instrumented functions from a single thread.
+typedef struct {
+  const char* name;
+  const char* location;
+  u64 calls;
+  u64 inclusive_ns;
+  u64 exclusive_ns;
+  u32 active;
+} aecor_prof_entry;
+
+typedef struct aecor_prof_frame {
+  aecor_prof_entry* entry;
+  struct aecor_prof_frame* parent;
+  u64 start;
+  u64 children;
+} aecor_prof_frame;
+
+// Defined at the end of the generated code, one entry per function
+extern aecor_prof_entry aecor_prof_table[];
+extern u32 aecor_prof_count;
+
+static __thread aecor_prof_frame* aecor_prof_current = NULL;
+
+static inline u64 aecor_prof_now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (u64)ts.tv_sec * 1000000000ull + (u64)ts.tv_nsec;
+}
+
+static inline void aecor_prof_enter(aecor_prof_frame* frame, u32 id) {
+  frame->entry = &aecor_prof_table[id];
+  frame->entry->calls++;
+  frame->entry->active++;
+  frame->parent = aecor_prof_current;
+  frame->children = 0;
+  aecor_prof_current = frame;
+  frame->start = aecor_prof_now();
+}
+
+static inline void aecor_prof_exit(aecor_prof_frame* frame) {
+  u64 elapsed = aecor_prof_now() - frame->start;
+  aecor_prof_entry* entry = frame->entry;
+  entry->active--;
+  if (entry->active == 0) entry->inclusive_ns += elapsed;
+  entry->exclusive_ns += elapsed - frame->children;
+  if (frame->parent) frame->parent->children += elapsed;
+  aecor_prof_current = frame->parent;
+}
+
+// Writes one line per function that was called, in declaration order so
+// that reports from different runs can be diffed directly. The output is
+// whitespace separated for `sort -k`, e.g. `sort -k3 -n -r` for the
+// functions with the most exclusive time.
+static void aecor_prof_report(void) {
+  // Functions still running when `exit()` was called end here
+  while (aecor_prof_current) aecor_prof_exit(aecor_prof_current);
+
+  const char* path = getenv("AECOR_PROFILE");
+  if (!path) path = "aecor_profile.txt";
+  FILE* file = fopen(path, "w");
+  if (!file) {
+    fprintf(stderr, "Could not write profile to %s\n", path);
+    return;
+  }
+  fprintf(file, "# %12s %16s %16s  %s  %s\n",
+          "calls", "inclusive_ns", "exclusive_ns", "function", "location");
+  for (u32 i = 0; i < aecor_prof_count; i++) {
+    aecor_prof_entry* entry = &aecor_prof_table[i];
+    if (entry->calls == 0) continue;
+    fprintf(file, "%14llu %16llu %16llu  %s  %s\n",
+            (unsigned long long)entry->calls,
+            (unsigned long long)entry->inclusive_ns,
+            (unsigned long long)entry->exclusive_ns,
+            entry->name, entry->location);
+  }
+  fclose(file);
+}
+
+__attribute__((constructor)) static void aecor_prof_init(void) {
+  atexit(aecor_prof_report);
+}
+#endif
+
+
+/***************** embed './lib/hash/crc32c.h' *****************/
+// Hardware CRC32C for `lib/hash/crc32c.ae`, using the SSE4.2 `crc32`
+// instruction. It is compiled for SSE4.2 regardless of the flags the program
+// is built with, so callers must check `aecor_crc32c_has_hw()` first.
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+
+static int aecor_crc32c_has_hw() {
+  static int has_hw = -1;
+  if (has_hw < 0) has_hw = __builtin_cpu_supports("sse4.2");
+  return has_hw;
+}
+
+__attribute__((target("sse4.2")))
+static u32 aecor_crc32c_hw(u32 crc, const u8* data, i64 size) {
+  u64 crc64 = crc;
+  while (size > 0 && ((uintptr_t)data & 7)) {
+    crc64 = __builtin_ia32_crc32qi((u32)crc64, *data++);
+    size--;
+  }
+  for (; size >= 8; size -= 8, data += 8) {
+    u64 word;
+    memcpy(&word, data, 8);
+    crc64 = __builtin_ia32_crc32di(crc64, word);
+  }
+  for (; size > 0; size--) {
+    crc64 = __builtin_ia32_crc32qi((u32)crc64, *data++);
+  }
+  return (u32)crc64;
+}
+
+#else
+
+static int aecor_crc32c_has_hw() { return 0; }
+static u32 aecor_crc32c_hw(u32 crc, const u8* data, i64 size) { return crc; }
+
+#endif
+
+
+/* constants */
+const u64 XXH_PRIME64_1 = 0x9E3779B185EBCA87ULL;
+const u64 XXH_PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+const u64 XXH_PRIME64_3 = 0x165667B19E3779F9ULL;
+const u64 XXH_PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+const u64 XXH_PRIME64_5 = 0x27D4EB2F165667C5ULL;
+const u32 CRC32C_POLY = 0x82F63B78U;
+
+/* struct declarations */
+typedef struct Buffer Buffer;
+typedef struct XXH64 XXH64;
+typedef struct CRC32C CRC32C;
+
+struct Buffer {
+  u8 *data;
+  i32 size;
+  i32 capacity;
+};
+
+struct XXH64 {
+  u64 acc[4];
+  u64 total;
+  u8 buf[32];
+  i32 buf_size;
+  u64 seed;
+};
+
+struct CRC32C {
+  u32 crc;
+};
+
+/* function declarations */
+static __attribute__((unused)) FILE *File__open(char *path, char *mode);
+static __attribute__((unused)) bool File__exists(char *path);
+static __attribute__((unused)) i32 File__size(FILE *this);
+static __attribute__((unused)) char *File__slurp(FILE *this);
+static __attribute__((unused)) i32 File__read(FILE *this, void *buf, i32 size);
+static __attribute__((unused)) i32 File__write(FILE *this, void *buf, i32 size);
+static __attribute__((unused)) void File__puts(FILE *this, char *str);
+static __attribute__((unused)) __attribute__((noreturn)) __attribute__((cold)) void panic(char *msg);
+static __attribute__((unused)) bool string__starts_with(char *this, char *prefix);
+static __attribute__((unused)) bool string__ends_with(char *this, char *suffix);
+static __attribute__((unused)) void string__remove_last_n(char *this, i32 n);
+static __attribute__((unused)) bool string__eq(char *this, char *str2);
+static __attribute__((unused)) char *string__substring(char *this, i32 start, i32 len);
+static __attribute__((unused)) void string__strip_trailing_whitespace(char *this);
+static __attribute__((unused)) i32 min(i32 a, i32 b);
+static __attribute__((unused)) i32 max(i32 a, i32 b);
+static __attribute__((unused)) Buffer Buffer__make(void);
+static __attribute__((unused)) Buffer Buffer__from_string(char *s);
+static __attribute__((unused)) Buffer Buffer__from_sized_string(char *s, i32 size);
+static __attribute__((unused)) void Buffer__resize_if_necessary(Buffer *this, i32 new_size);
+static __attribute__((unused)) void Buffer__hex_dump(Buffer *this);
+static __attribute__((unused)) void Buffer__putb(Buffer *this, Buffer *buf);
+static __attribute__((unused)) void Buffer__putbf(Buffer *this, Buffer *buf);
+static __attribute__((unused)) void Buffer__puts(Buffer *this, char *s);
+static __attribute__((unused)) void Buffer__put_str(Buffer *this, char *s);
+static inline __attribute__((unused)) __attribute__((always_inline)) void Buffer__putc(Buffer *this, char c);
+static __attribute__((unused)) void Buffer__put_u64(Buffer *this, u64 value);
+static __attribute__((unused)) void Buffer__put_i64(Buffer *this, i64 value);
+static __attribute__((unused)) void Buffer__put_f64(Buffer *this, f64 value);
+static __attribute__((unused)) void Buffer__put_ptr(Buffer *this, void *value);
+static __attribute__((unused)) void Buffer__putsf(Buffer *this, char *s);
+static __attribute__((unused)) char *Buffer__str(Buffer *this);
+static __attribute__((unused)) char *Buffer__new_str(Buffer *this);
+static __attribute__((unused)) void Buffer__free(Buffer *this);
+static __attribute__((unused)) u64 xxh_rotl64(u64 x, u64 bits);
+static __attribute__((unused)) u64 xxh_read64(u8 *data);
+static __attribute__((unused)) u64 xxh_read32(u8 *data);
+static __attribute__((unused)) u64 xxh64_round(u64 acc, u64 input);
+static __attribute__((unused)) u64 xxh64_merge_round(u64 acc, u64 val);
+static __attribute__((unused)) XXH64 XXH64__make(u64 seed);
+static __attribute__((unused)) void XXH64__consume_stripe(XXH64 *this, u8 *data);
+static __attribute__((unused)) void XXH64__update_bytes(XXH64 *this, u8 *data, i64 size);
+static __attribute__((unused)) void XXH64__update(XXH64 *this, Buffer *input);
+static __attribute__((unused)) u64 xxh64_finalize(u64 hash, u8 *data, i32 size);
+static __attribute__((unused)) u64 xxh64_merge_accs(u64 a0, u64 a1, u64 a2, u64 a3);
+static __attribute__((unused)) u64 XXH64__digest(XXH64 *this);
+static __attribute__((unused)) u64 XXH64__hash_bytes(u8 *data, i64 size, u64 seed);
+static __attribute__((unused)) u64 XXH64__hash(Buffer *input, u64 seed);
+static __attribute__((unused)) u64 XXH64__hash_string(char *s, u64 seed);
+static __attribute__((unused)) pthread_t *Thread__spawn(void *(*func)(void *), void *arg);
+static __attribute__((unused)) void *Thread__join(pthread_t *this);
+static __attribute__((unused)) void Mutex__init(pthread_mutex_t *this);
+static __attribute__((unused)) u32 *crc32c_build_table(void);
+static __attribute__((unused)) u32 *crc32c_get_table(void);
+static __attribute__((unused)) u32 CRC32C__update_sw(u32 crc, u8 *data, i64 size);
+static __attribute__((unused)) CRC32C CRC32C__make(void);
+static __attribute__((unused)) void CRC32C__update_bytes(CRC32C *this, u8 *data, i64 size);
+static __attribute__((unused)) void CRC32C__update(CRC32C *this, Buffer *input);
+static __attribute__((unused)) u32 CRC32C__digest(CRC32C *this);
+static __attribute__((unused)) u32 CRC32C__hash(Buffer *input);
+i32 main(void);
+
+/* global variables */
+u32 *crc32c_table = NULL;
+
+static __attribute__((unused)) FILE *File__open(char *path, char *mode) {
+  FILE *file = fopen(path, mode);
+  if ((!((bool)file))) {
+    printf("Error opening file '%s': %s""\n", path, strerror(errno));
+    exit(1);
+  } 
+  return file;
+}
+
+static __attribute__((unused)) bool File__exists(char *path) {
+  FILE *file = fopen(path, "r");
+  if ((!((bool)file))) {
+    return false;
+  } 
+  fclose(file);
+  return true;
+}
+
+static __attribute__((unused)) i32 File__size(FILE *this) {
+  i32 pos = ftell(this);
+  fseek(this, 0, SEEK_END);
+  i32 size = ftell(this);
+  fseek(this, pos, SEEK_SET);
+  return size;
+}
+
+static __attribute__((unused)) char *File__slurp(FILE *this) {
+  i32 pos = ftell(this);
+  fseek(this, 0, SEEK_END);
+  i32 size = ftell(this);
+  fseek(this, pos, SEEK_SET);
+  void *buf = calloc((size + 1), sizeof(char));
+  fread(buf, 1, size, this);
+  fseek(this, pos, SEEK_SET);
+  return ((char *)buf);
+}
+
+static __attribute__((unused)) i32 File__read(FILE *this, void *buf, i32 size) {
+  return fread(buf, 1, size, this);
+}
+
+static __attribute__((unused)) i32 File__write(FILE *this, void *buf, i32 size) {
+  return fwrite(buf, 1, size, this);
+}
+
+static __attribute__((unused)) void File__puts(FILE *this, char *str) {
+  fwrite(str, 1, strlen(str), this);
+}
+
+static __attribute__((unused)) __attribute__((noreturn)) __attribute__((cold)) void panic(char *msg) {
+  printf("%s""\n", msg);
+  aecor_stdout_flush();
+  exit(1);
+}
+
+static __attribute__((unused)) bool string__starts_with(char *this, char *prefix) {
+  i32 prefix_len = strlen(prefix);
+  if ((strlen(this) < prefix_len)) {
+    return false;
+  } 
+  return strncmp(this, prefix, prefix_len) == 0;
+}
+
+static __attribute__((unused)) bool string__ends_with(char *this, char *suffix) {
+  i32 suffix_len = strlen(suffix);
+  if ((strlen(this) < suffix_len)) {
+    return false;
+  } 
+  return strncmp(this, suffix, suffix_len) == 0;
+}
+
+static __attribute__((unused)) void string__remove_last_n(char *this, i32 n) {
+  this[(strlen(this) - n)] = '\0';
+}
+
+static __attribute__((unused)) bool string__eq(char *this, char *str2) {
+  return strcmp(this, str2) == 0;
+}
+
+static __attribute__((unused)) char *string__substring(char *this, i32 start, i32 len) {
+  char *new_str = ((char *)calloc((len + 1), sizeof(char)));
+  memcpy(new_str, (this + start), len);
+  return new_str;
+}
+
+static __attribute__((unused)) void string__strip_trailing_whitespace(char *this) {
+  for (i32 i = (strlen(this) - 1); (i >= 0); i -= 1) {
+    if ((this[i] != ' ')) 
+    break;
+    
+    this[i] = '\0';
+  } 
+}
+
+static __attribute__((unused)) i32 min(i32 a, i32 b) {
+  return ((a < b) ? a : b);
+}
+
+static __attribute__((unused)) i32 max(i32 a, i32 b) {
+  return ((a > b) ? a : b);
+}
+
+static __attribute__((unused)) Buffer Buffer__make(void) {
+  i32 initial_capacity = 16;
+  return (Buffer){.data = calloc(initial_capacity, 1), .size = 0, .capacity = initial_capacity};
+}
+
+static __attribute__((unused)) Buffer Buffer__from_string(char *s) {
+  return (Buffer){.data = ((u8 *)s), .size = strlen(s), .capacity = strlen(s)};
+}
+
+static __attribute__((unused)) Buffer Buffer__from_sized_string(char *s, i32 size) {
+  return (Buffer){.data = ((u8 *)s), .size = ((i32)size), .capacity = strlen(s)};
+}
+
+static __attribute__((unused)) void Buffer__resize_if_necessary(Buffer *this, i32 new_size) {
+  if ((new_size >= this->capacity)) {
+    i32 new_capacity = max((this->capacity * 2), new_size);
+    this->data = ((u8 *)realloc(this->data, new_capacity));
+    if (this->data == NULL) {
+      printf("Out of memory!""\n");
+      exit(1);
+    } 
+    this->capacity = new_capacity;
+  } 
+}
+
+static __attribute__((unused)) void Buffer__hex_dump(Buffer *this) {
+  printf("(%d bytes): ", this->size);
+  for (i32 i = 0; (i < this->size); i += 1) {
+    if (((i % 4) == 0 && (i > 0))) 
+    printf("_");
+    
+    printf("%02x", this->data[i]);
+  } 
+  printf("""\n");
+}
+
+static __attribute__((unused)) void Buffer__putb(Buffer *this, Buffer *buf) {
+  Buffer__resize_if_necessary(this, ((this->size + buf->size) + 1));
+  memcpy((this->data + this->size), buf->data, buf->size);
+  this->data[(this->size + buf->size)] = ((u8)'\0');
+  this->size += buf->size;
+}
+
+static __attribute__((unused)) void Buffer__putbf(Buffer *this, Buffer *buf) {
+  Buffer__putb(this, buf);
+  Buffer__free(buf);
+}
+
+static __attribute__((unused)) void Buffer__puts(Buffer *this, char *s) {
+  i32 len = strlen(s);
+  Buffer__resize_if_necessary(this, ((this->size + len) + 1));
+  memcpy((this->data + this->size), s, (len + 1));
+  this->size += len;
+}
+
+static __attribute__((unused)) void Buffer__put_str(Buffer *this, char *s) {
+  Buffer__puts(this, (((bool)s) ? s : "(null)"));
+}
+
+static inline __attribute__((unused)) __attribute__((always_inline)) void Buffer__putc(Buffer *this, char c) {
+  Buffer__resize_if_necessary(this, (this->size + 2));
+  this->data[this->size] = ((u8)c);
+  this->size += 1;
+  this->data[this->size] = ((u8)'\0');
+}
+
+static __attribute__((unused)) void Buffer__put_u64(Buffer *this, u64 value) {
+  u8 digits[20];
+  i32 len = 0;
+  while (true) {
+    digits[len] = (((u8)(value % 10)) + ((u8)'0'));
+    len += 1;
+    value = (value / 10);
+    if (value == 0) 
+    break;
+    
+  } 
+  Buffer__resize_if_necessary(this, ((this->size + len) + 1));
+  for (i32 i = 0; (i < len); i += 1) {
+    this->data[(this->size + i)] = digits[((len - i) - 1)];
+  } 
+  this->size += len;
+  this->data[this->size] = ((u8)'\0');
+}
+
+static __attribute__((unused)) void Buffer__put_i64(Buffer *this, i64 value) {
+  if ((value < 0)) {
+    Buffer__putc(this, '-');
+    Buffer__put_u64(this, (-((u64)value)));
+  }  else {
+    Buffer__put_u64(this, ((u64)value));
+  } 
+}
+
+static __attribute__((unused)) void Buffer__put_f64(Buffer *this, f64 value) {
+  char stack[64];
+  char *s = format_string_into(stack, 64, "%f", value);
+  Buffer__puts(this, s);
+  if ((s != ((char *)stack))) 
+  free(s);
+  
+}
+
+static __attribute__((unused)) void Buffer__put_ptr(Buffer *this, void *value) {
+  char stack[32];
+  Buffer__puts(this, format_string_into(stack, 32, "%p", value));
+}
+
+static __attribute__((unused)) void Buffer__putsf(Buffer *this, char *s) {
+  Buffer__puts(this, s);
+  free(s);
+}
+
+static __attribute__((unused)) char *Buffer__str(Buffer *this) {
+  return ((char *)this->data);
+}
+
+static __attribute__((unused)) char *Buffer__new_str(Buffer *this) {
+  return strdup(((char *)this->data));
+}
+
+static __attribute__((unused)) void Buffer__free(Buffer *this) {
+  free(this->data);
+}
+
+static __attribute__((unused)) u64 xxh_rotl64(u64 x, u64 bits) {
+  return ((x << bits) | (x >> (64ULL - bits)));
+}
+
+static __attribute__((unused)) u64 xxh_read64(u8 *data) {
+  u64 value;
+  memcpy((&value), data, 8);
+  return value;
+}
+
+static __attribute__((unused)) u64 xxh_read32(u8 *data) {
+  u32 value;
+  memcpy((&value), data, 4);
+  return ((u64)value);
+}
+
+static __attribute__((unused)) u64 xxh64_round(u64 acc, u64 input) {
+  acc += (input * XXH_PRIME64_2);
+  acc = xxh_rotl64(acc, 31);
+  return (acc * XXH_PRIME64_1);
+}
+
+static __attribute__((unused)) u64 xxh64_merge_round(u64 acc, u64 val) {
+  acc = (acc ^ xxh64_round(0, val));
+  return ((acc * XXH_PRIME64_1) + XXH_PRIME64_4);
+}
+
+static __attribute__((unused)) XXH64 XXH64__make(u64 seed) {
+  XXH64 h = {0};
+  h.acc[0] = ((seed + XXH_PRIME64_1) + XXH_PRIME64_2);
+  h.acc[1] = (seed + XXH_PRIME64_2);
+  h.acc[2] = seed;
+  h.acc[3] = (seed - XXH_PRIME64_1);
+  h.total = 0;
+  h.buf_size = 0;
+  h.seed = seed;
+  return h;
+}
+
+static __attribute__((unused)) void XXH64__consume_stripe(XXH64 *this, u8 *data) {
+  this->acc[0] = xxh64_round(this->acc[0], xxh_read64(data));
+  this->acc[1] = xxh64_round(this->acc[1], xxh_read64((data + 8)));
+  this->acc[2] = xxh64_round(this->acc[2], xxh_read64((data + 16)));
+  this->acc[3] = xxh64_round(this->acc[3], xxh_read64((data + 24)));
+}
+
+static __attribute__((unused)) void XXH64__update_bytes(XXH64 *this, u8 *data, i64 size) {
+  this->total += ((u64)size);
+  i64 i = 0LL;
+  if ((this->buf_size > 0)) {
+    i32 take = min((32 - this->buf_size), ((i32)size));
+    memcpy((this->buf + this->buf_size), data, take);
+    this->buf_size += take;
+    i = ((i64)take);
+    if ((this->buf_size < 32)) 
+    return;
+    
+    XXH64__consume_stripe(this, this->buf);
+    this->buf_size = 0;
+  } 
+  u64 a0 = this->acc[0];
+  u64 a1 = this->acc[1];
+  u64 a2 = this->acc[2];
+  u64 a3 = this->acc[3];
+  for (; ((i + 32) <= size); i += 32) {
+    a0 = xxh64_round(a0, xxh_read64((data + i)));
+    a1 = xxh64_round(a1, xxh_read64(((data + i) + 8)));
+    a2 = xxh64_round(a2, xxh_read64(((data + i) + 16)));
+    a3 = xxh64_round(a3, xxh_read64(((data + i) + 24)));
+  } 
+  this->acc[0] = a0;
+  this->acc[1] = a1;
+  this->acc[2] = a2;
+  this->acc[3] = a3;
+  if ((i < size)) {
+    this->buf_size = ((i32)(size - i));
+    memcpy(this->buf, (data + i), this->buf_size);
+  } 
+}
+
+static __attribute__((unused)) void XXH64__update(XXH64 *this, Buffer *input) {
+  XXH64__update_bytes(this, input->data, ((i64)input->size));
+}
+
+static __attribute__((unused)) u64 xxh64_finalize(u64 hash, u8 *data, i32 size) {
+  i32 i = 0;
+  for (; ((i + 8) <= size); i += 8) {
+    hash = (hash ^ xxh64_round(0, xxh_read64((data + i))));
+    hash = ((xxh_rotl64(hash, 27) * XXH_PRIME64_1) + XXH_PRIME64_4);
+  } 
+  if (((i + 4) <= size)) {
+    hash = (hash ^ (xxh_read32((data + i)) * XXH_PRIME64_1));
+    hash = ((xxh_rotl64(hash, 23) * XXH_PRIME64_2) + XXH_PRIME64_3);
+    i += 4;
+  } 
+  for (; (i < size); i += 1) {
+    hash = (hash ^ (((u64)data[i]) * XXH_PRIME64_5));
+    hash = (xxh_rotl64(hash, 11) * XXH_PRIME64_1);
+  } 
+  hash = (hash ^ (hash >> 33ULL));
+  hash *= XXH_PRIME64_2;
+  hash = (hash ^ (hash >> 29ULL));
+  hash *= XXH_PRIME64_3;
+  hash = (hash ^ (hash >> 32ULL));
+  return hash;
+}
+
+static __attribute__((unused)) u64 xxh64_merge_accs(u64 a0, u64 a1, u64 a2, u64 a3) {
+  u64 hash = (((xxh_rotl64(a0, 1) + xxh_rotl64(a1, 7)) + xxh_rotl64(a2, 12)) + xxh_rotl64(a3, 18));
+  hash = xxh64_merge_round(hash, a0);
+  hash = xxh64_merge_round(hash, a1);
+  hash = xxh64_merge_round(hash, a2);
+  return xxh64_merge_round(hash, a3);
+}
+
+static __attribute__((unused)) u64 XXH64__digest(XXH64 *this) {
+  u64 hash = ({ u64 __yield_0;
+  if ((this->total >= 32)) {
+    __yield_0 = xxh64_merge_accs(this->acc[0], this->acc[1], this->acc[2], this->acc[3]);
+  }  else {
+    __yield_0 = (this->seed + XXH_PRIME64_5);
+  } 
+;__yield_0; });
+  return xxh64_finalize((hash + this->total), this->buf, this->buf_size);
+}
+
+static __attribute__((unused)) u64 XXH64__hash_bytes(u8 *data, i64 size, u64 seed) {
+  i64 i = 0LL;
+  u64 hash = (seed + XXH_PRIME64_5);
+  if ((size >= 32)) {
+    u64 a0 = ((seed + XXH_PRIME64_1) + XXH_PRIME64_2);
+    u64 a1 = (seed + XXH_PRIME64_2);
+    u64 a2 = seed;
+    u64 a3 = (seed - XXH_PRIME64_1);
+    for (; ((i + 32) <= size); i += 32) {
+      a0 = xxh64_round(a0, xxh_read64((data + i)));
+      a1 = xxh64_round(a1, xxh_read64(((data + i) + 8)));
+      a2 = xxh64_round(a2, xxh_read64(((data + i) + 16)));
+      a3 = xxh64_round(a3, xxh_read64(((data + i) + 24)));
+    } 
+    hash = xxh64_merge_accs(a0, a1, a2, a3);
+  } 
+  return xxh64_finalize((hash + ((u64)size)), (data + i), ((i32)(size - i)));
+}
+
+static __attribute__((unused)) u64 XXH64__hash(Buffer *input, u64 seed) {
+  return XXH64__hash_bytes(input->data, ((i64)input->size), seed);
+}
+
+static __attribute__((unused)) u64 XXH64__hash_string(char *s, u64 seed) {
+  return XXH64__hash_bytes(((u8 *)s), ((i64)strlen(s)), seed);
+}
+
+static __attribute__((unused)) pthread_t *Thread__spawn(void *(*func)(void *), void *arg) {
+  aecor_multithreaded = true;
+  pthread_t *thread = ((pthread_t *)calloc(1, sizeof(pthread_t)));
+  if ((pthread_create(thread, NULL, func, arg) != 0)) {
+    printf("Failed to create thread: %s""\n", strerror(errno));
+    exit(1);
+  } 
+  return thread;
+}
+
+static __attribute__((unused)) void *Thread__join(pthread_t *this) {
+  void *result = ((void *)NULL);
+  pthread_join((*this), (&result));
+  free(this);
+  return result;
+}
+
+static __attribute__((unused)) void Mutex__init(pthread_mutex_t *this) {
+  pthread_mutex_init(this, NULL);
+}
+
+static __attribute__((unused)) u32 *crc32c_build_table(void) {
+  u32 *table = ((u32 *)calloc((8 * 256), sizeof(u32)));
+  for (i32 b = 0; (b < 256); b += 1) {
+    u32 crc = ((u32)b);
+    for (i32 k = 0; (k < 8); k += 1) {
+      crc = ((crc >> 1U) ^ (CRC32C_POLY & (0U - (crc & 1U))));
+    } 
+    table[b] = crc;
+  } 
+  for (i32 b = 0; (b < 256); b += 1) {
+    for (i32 k = 1; (k < 8); k += 1) {
+      u32 prev = table[(((k - 1) * 256) + b)];
+      table[((k * 256) + b)] = ((prev >> 8U) ^ table[((i32)(prev & 0xFFU))]);
+    } 
+  } 
+  return table;
+}
+
+static __attribute__((unused)) u32 *crc32c_get_table(void) {
+  u32 *table = ((u32 *)__atomic_load_n((&crc32c_table), __ATOMIC_ACQUIRE));
+  if (((bool)table)) 
+  return table;
+  
+  void *expected = ((void *)NULL);
+  table = crc32c_build_table();
+  if ((!__atomic_compare_exchange_n((&crc32c_table), (&expected), table, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))) {
+    free(table);
+    table = ((u32 *)expected);
+  } 
+  return table;
+}
+
+static __attribute__((unused)) u32 CRC32C__update_sw(u32 crc, u8 *data, i64 size) {
+  u32 *t = crc32c_get_table();
+  i64 i = 0LL;
+  for (; ((i + 8) <= size); i += 8) {
+    u32 lo;
+    u32 hi;
+    memcpy((&lo), (data + i), 4);
+    memcpy((&hi), ((data + i) + 4), 4);
+    lo = (lo ^ crc);
+    crc = (((((((t[((7 * 256) + ((i32)(lo & 0xFFU)))] ^ t[((6 * 256) + ((i32)((lo >> 8U) & 0xFFU)))]) ^ t[((5 * 256) + ((i32)((lo >> 16U) & 0xFFU)))]) ^ t[((4 * 256) + ((i32)(lo >> 24U)))]) ^ t[((3 * 256) + ((i32)(hi & 0xFFU)))]) ^ t[((2 * 256) + ((i32)((hi >> 8U) & 0xFFU)))]) ^ t[((1 * 256) + ((i32)((hi >> 16U) & 0xFFU)))]) ^ t[((i32)(hi >> 24U))]);
+  } 
+  for (; (i < size); i += 1) {
+    crc = ((crc >> 8U) ^ t[((i32)((crc ^ ((u32)data[i])) & 0xFFU))]);
+  } 
+  return crc;
+}
+
+static __attribute__((unused)) CRC32C CRC32C__make(void) {
+  return (CRC32C){0xFFFFFFFFU};
+}
+
+static __attribute__((unused)) void CRC32C__update_bytes(CRC32C *this, u8 *data, i64 size) {
+  if (aecor_crc32c_has_hw()) {
+    this->crc = aecor_crc32c_hw(this->crc, data, size);
+  }  else {
+    this->crc = CRC32C__update_sw(this->crc, data, size);
+  } 
+}
+
+static __attribute__((unused)) void CRC32C__update(CRC32C *this, Buffer *input) {
+  CRC32C__update_bytes(this, input->data, ((i64)input->size));
+}
+
+static __attribute__((unused)) u32 CRC32C__digest(CRC32C *this) {
+  return (this->crc ^ 0xFFFFFFFFU);
+}
+
+static __attribute__((unused)) u32 CRC32C__hash(Buffer *input) {
+  CRC32C crc = CRC32C__make();
+  CRC32C__update((&crc), input);
+  return CRC32C__digest((&crc));
+}
+
+i32 main(void) {
+  Buffer empty = Buffer__from_string("");
+  Buffer abc = Buffer__from_string("abc");
+  Buffer spam = Buffer__from_string("Nobody inspects the spammish repetition");
+  printf("%lx %lx %lx | ", XXH64__hash((&empty), 0), XXH64__hash((&abc), 0), XXH64__hash((&spam), 0));
+  Buffer check = Buffer__from_string("123456789");
+  printf("%x %x | ", CRC32C__hash((&check)), CRC32C__hash((&empty)));
+  Buffer data = Buffer__make();
+  for (i32 i = 0; (i < 1000); i += 1) {
+    ({ Buffer *__fmt_buf = (&data); Buffer__put_i64(__fmt_buf, (i * 31)); Buffer__puts(__fmt_buf, ","); });
+  } 
+  u64 expected = XXH64__hash((&data), 42);
+  u32 expected_crc = CRC32C__hash((&data));
+  u32 sw_crc = (CRC32C__update_sw(0xFFFFFFFFU, data.data, ((i64)data.size)) ^ 0xFFFFFFFFU);
+  bool ok = sw_crc == expected_crc;
+  for (i32 step = 1; (step < 100); step += 7) {
+    XXH64 h = XXH64__make(42);
+    CRC32C crc = CRC32C__make();
+    for (i32 i = 0; (i < data.size); i += step) {
+      i32 size = min(step, (data.size - i));
+      XXH64__update_bytes((&h), (data.data + i), ((i64)size));
+      CRC32C__update_bytes((&crc), (data.data + i), ((i64)size));
+    } 
+    if (((XXH64__digest((&h)) != expected) || (CRC32C__digest((&crc)) != expected_crc))) 
+    ok = false;
+    
+  } 
+  char *result = (ok ? "ok" : "FAILED");
+  printf("streaming %s\n", result);
+}
+
@@ -0,0 +1,36 @@
+// Hardware CRC32C for `lib/hash/crc32c.ae`, using the SSE4.2 `crc32`
+// instruction. It is compiled for SSE4.2 regardless of the flags the program
+// is built with, so callers must check `aecor_crc32c_has_hw()` first.
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+
+static int aecor_crc32c_has_hw() {
+  static int has_hw = -1;
+  if (has_hw < 0) has_hw = __builtin_cpu_supports("sse4.2");
+  return has_hw;
+}
+
+__attribute__((target("sse4.2")))
+static u32 aecor_crc32c_hw(u32 crc, const u8* data, i64 size) {
+  u64 crc64 = crc;
+  while (size > 0 && ((uintptr_t)data & 7)) {
+    crc64 = __builtin_ia32_crc32qi((u32)crc64, *data++);
+    size--;
+  }
+  for (; size >= 8; size -= 8, data += 8) {
+    u64 word;
+    memcpy(&word, data, 8);
+    crc64 = __builtin_ia32_crc32di(crc64, word);
+  }
+  for (; size > 0; size--) {
+    crc64 = __builtin_ia32_crc32qi((u32)crc64, *data++);
+  }
+  return (u32)crc64;
+}
+
+#else
+
+static int aecor_crc32c_has_hw() { return 0; }
+static u32 aecor_crc32c_hw(u32 crc, const u8* data, i64 size) { return crc; }
+
+#endif
@@ -0,0 +1,26 @@
+#!/bin/bash
+# Builds and runs benchmarks from `bench/` with the given compiler.
+#   ./meta/bench.sh [-c ./bootstrap/aecor] [bench/foo.ae ...]
+# With no files, all the benchmarks are run.
+
+compiler=./bootstrap/aecor
+if [ "$1" == "-c" ]; then
+    compiler=$2
+    shift 2
+fi
+
+files=("$@")
+if [ ${#files[@]} -eq 0 ]; then
+    files=($(ls bench/*.ae | grep -v bench/bench.ae))
+fi
+
+mkdir -p build/bench
+set -e
+
+for file in "${files[@]}"; do
+    name=$(basename "$file" .ae)
+    echo "[+] $name"
+    $compiler -s "$file" -o "build/bench/$name"
+    "./build/bench/$name"
+    echo
+done
@@ -0,0 +1,38 @@
+#!/bin/bash
+# Compares debug builds against `--release` builds (which remove the
+# `debug_assert` checks) for the compiler itself and the raytracer.
+#   ./meta/bench_release.sh [-c ./bootstrap/aecor]
+
+compiler=./bootstrap/aecor
+if [ "$1" == "-c" ]; then
+    compiler=$2
+    shift 2
+fi
+
+mkdir -p build/bench
+set -e
+TIMEFORMAT="%R s"
+
+for mode in debug release; do
+    flags=""
+    if [ $mode == "release" ]; then
+        flags="--release"
+    fi
+    $compiler -s $flags compiler/main.ae -o build/bench/aecor-$mode -n
+    gcc -O2 -o build/bench/aecor-$mode build/bench/aecor-$mode.c
+    $compiler -s $flags examples/raytrace.ae -o build/bench/raytrace-$mode
+done
+
+for mode in debug release; do
+    echo "[+] compiler ($mode), 20 runs"
+    time (for i in $(seq 20); do
+        ./build/bench/aecor-$mode -s -n compiler/main.ae -o build/bench/self
+    done)
+done
+
+# The raytracer writes its image to the working directory
+cd build/bench
+for mode in debug release; do
+    echo "[+] raytrace ($mode)"
+    time ./raytrace-$mode > /dev/null
+done
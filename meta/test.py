@@ -25,9 +25,11 @@ class Result(Enum):
 class Expected:
     type: Result
     value: Union[int, str, None]
+    flags: Tuple[str, ...] = ()
 
 
 def get_expected(filename) -> Optional[Expected]:
+    flags = ()
     with open(filename) as file:
         for line in file:
             if not line.startswith("///"):
@@ -39,7 +41,7 @@ def get_expected(filename) -> Optional[Expected]:
             if line == "skip":
                 return Expected(Result.SKIP_SILENTLY, None)
             if line == "compile":
-                return Expected(Result.COMPILE_SUCCESS, None)
+                return Expected(Result.COMPILE_SUCCESS, None, flags)
             if line == "":
                 continue
 
@@ -50,12 +52,16 @@ def get_expected(filename) -> Optional[Expected]:
             # Commands with arguments
             name, value = map(str.strip, line.split(":", 1))
 
+            # Extra compiler flags, needs to come before the expected result
+            if name == "flags":
+                flags = tuple(value.split())
+                continue
             if name == "exit":
-                return Expected(Result.EXIT_WITH_CODE, int(value))
+                return Expected(Result.EXIT_WITH_CODE, int(value), flags)
             if name == "out":
-                return Expected(Result.EXIT_WITH_OUTPUT, value)
+                return Expected(Result.EXIT_WITH_OUTPUT, value, flags)
             if name == "fail":
-                return Expected(Result.COMPILE_FAIL, value)
+                return Expected(Result.COMPILE_FAIL, value, flags)
 
             print(f'[-] Invalid parameter in {filename}: {line}')
             break
@@ -65,7 +71,7 @@ def get_expected(filename) -> Optional[Expected]:
 def handle_test(compiler: str, num: int, path: Path, expected: Expected) -> Tuple[bool, str, Path]:
     exec_name = f'./build/tests/{path.stem}-{num}'
     process = run(
-        [compiler, str(path), '-o', exec_name],
+        [compiler, str(path), *expected.flags, '-o', exec_name],
         stdout=PIPE,
         stderr=PIPE
     )